@@ -0,0 +1,315 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/cloudwatch-logging/CloudWatchLogsSink.h>
+#include <aws/cloudwatch-logging/CloudWatchLogSystem.h>
+#include <aws/core/auth/AWSCredentials.h>
+#include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/utils/StringUtils.h>
+#include <aws/core/utils/json/JsonSerializer.h>
+#include <aws/core/utils/logging/LogLevel.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/logs/CloudWatchLogsClient.h>
+#include <aws/logs/model/PutLogEventsRequest.h>
+#include <aws/logs/model/CreateLogStreamRequest.h>
+#include <thread>
+
+using namespace Aws::CloudWatchLogging;
+using namespace Aws::CloudWatchLogs;
+using namespace Aws::CloudWatchLogs::Model;
+using namespace Aws::Client;
+
+static const char ALLOCATION_TAG[] = "CloudWatchLogsSinkTest";
+static const char LOG_GROUP[] = "test-log-group";
+static const char LOG_STREAM[] = "test-log-stream";
+
+namespace
+{
+    class TestCloudWatchLogsError : public CloudWatchLogsError
+    {
+    public:
+        TestCloudWatchLogsError(CloudWatchLogsErrors errorType, const char* exceptionName, const char* message, bool retryable, const char* jsonPayload = nullptr) :
+            CloudWatchLogsError(AWSError<CloudWatchLogsErrors>(errorType, exceptionName, message, retryable))
+        {
+            SetJsonPayload(Aws::Utils::Json::JsonValue(jsonPayload ? jsonPayload : "{}"));
+        }
+    };
+
+    class MockCloudWatchLogsClient : public CloudWatchLogsClient
+    {
+    public:
+        MockCloudWatchLogsClient() : CloudWatchLogsClient(Aws::Auth::AWSCredentials("", ""), ClientConfiguration()), m_createLogStreamCalls(0) {}
+
+        PutLogEventsOutcome PutLogEvents(const PutLogEventsRequest& request) const override
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_requests.push_back(request);
+            if (!m_errors.empty())
+            {
+                CloudWatchLogsError error = m_errors.front();
+                m_errors.erase(m_errors.begin());
+                return error;
+            }
+
+            PutLogEventsResult result;
+            result.SetNextSequenceToken("token-" + Aws::Utils::StringUtils::to_string(m_requests.size()));
+            return result;
+        }
+
+        CreateLogStreamOutcome CreateLogStream(const CreateLogStreamRequest&) const override
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            ++m_createLogStreamCalls;
+            return CreateLogStreamOutcome(Aws::NoResult());
+        }
+
+        void AddError(const CloudWatchLogsError& error)
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_errors.push_back(error);
+        }
+
+        Aws::Vector<PutLogEventsRequest> GetRequests() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_requests;
+        }
+
+        size_t GetCreateLogStreamCalls() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_createLogStreamCalls;
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+        mutable Aws::Vector<PutLogEventsRequest> m_requests;
+        mutable Aws::Vector<CloudWatchLogsError> m_errors;
+        mutable size_t m_createLogStreamCalls;
+    };
+
+    CloudWatchLogsSinkConfiguration MakeConfiguration(const std::shared_ptr<MockCloudWatchLogsClient>& client)
+    {
+        CloudWatchLogsSinkConfiguration config;
+        config.client = client;
+        config.logGroupName = LOG_GROUP;
+        // Tests drive sending explicitly through Flush.
+        config.flushIntervalMs = 60000;
+        return config;
+    }
+
+    size_t CountEvents(const Aws::Vector<PutLogEventsRequest>& requests)
+    {
+        size_t count = 0;
+        for (const auto& request : requests)
+        {
+            count += request.GetLogEvents().size();
+        }
+        return count;
+    }
+}
+
+TEST(CloudWatchLogsSinkTest, TestBatchesAreSortedAndSplitByEventCount)
+{
+    auto client = Aws::MakeShared<MockCloudWatchLogsClient>(ALLOCATION_TAG);
+    auto config = MakeConfiguration(client);
+    config.maxBatchEvents = 10;
+    CloudWatchLogsSink sink(config);
+
+    const long long base = 1600000000000LL;
+    for (int i = 0; i < 25; ++i)
+    {
+        ASSERT_TRUE(sink.Append(LOG_STREAM, "message " + Aws::Utils::StringUtils::to_string(i), base - i));
+    }
+    sink.Flush();
+
+    auto requests = client->GetRequests();
+    ASSERT_EQ(3u, requests.size());
+    ASSERT_EQ(10u, requests[0].GetLogEvents().size());
+    ASSERT_EQ(10u, requests[1].GetLogEvents().size());
+    ASSERT_EQ(5u, requests[2].GetLogEvents().size());
+
+    long long previous = 0;
+    for (const auto& request : requests)
+    {
+        ASSERT_EQ(LOG_GROUP, request.GetLogGroupName());
+        ASSERT_EQ(LOG_STREAM, request.GetLogStreamName());
+        for (const auto& event : request.GetLogEvents())
+        {
+            ASSERT_LE(previous, event.GetTimestamp());
+            previous = event.GetTimestamp();
+        }
+    }
+    ASSERT_EQ("message 24", requests[0].GetLogEvents()[0].GetMessage());
+
+    // Each call carries the token returned by the previous one.
+    ASSERT_FALSE(requests[0].SequenceTokenHasBeenSet());
+    ASSERT_EQ("token-1", requests[1].GetSequenceToken());
+    ASSERT_EQ("token-2", requests[2].GetSequenceToken());
+
+    auto statistics = sink.GetStatistics();
+    ASSERT_EQ(25u, statistics.eventsAppended);
+    ASSERT_EQ(25u, statistics.eventsSent);
+    ASSERT_EQ(3u, statistics.batchesSent);
+}
+
+TEST(CloudWatchLogsSinkTest, TestBatchesAreSplitByBytesAndTimeSpan)
+{
+    auto client = Aws::MakeShared<MockCloudWatchLogsClient>(ALLOCATION_TAG);
+    auto config = MakeConfiguration(client);
+    config.maxBatchBytes = 3 * (100 + 26);
+    CloudWatchLogsSink sink(config);
+
+    const long long base = 1600000000000LL;
+    for (int i = 0; i < 7; ++i)
+    {
+        ASSERT_TRUE(sink.Append(LOG_STREAM, Aws::String(100, 'a'), base + i));
+    }
+    sink.Flush();
+
+    auto requests = client->GetRequests();
+    ASSERT_EQ(3u, requests.size());
+    ASSERT_EQ(3u, requests[0].GetLogEvents().size());
+    ASSERT_EQ(3u, requests[1].GetLogEvents().size());
+    ASSERT_EQ(1u, requests[2].GetLogEvents().size());
+
+    const long long hour = 60LL * 60 * 1000;
+    ASSERT_TRUE(sink.Append(LOG_STREAM, "first", base));
+    ASSERT_TRUE(sink.Append(LOG_STREAM, "within a day", base + 23 * hour));
+    ASSERT_TRUE(sink.Append(LOG_STREAM, "next day", base + 25 * hour));
+    sink.Flush();
+
+    requests = client->GetRequests();
+    ASSERT_EQ(5u, requests.size());
+    ASSERT_EQ(2u, requests[3].GetLogEvents().size());
+    ASSERT_EQ(1u, requests[4].GetLogEvents().size());
+    ASSERT_EQ("next day", requests[4].GetLogEvents()[0].GetMessage());
+}
+
+TEST(CloudWatchLogsSinkTest, TestInvalidSequenceTokenIsResolvedFromError)
+{
+    auto client = Aws::MakeShared<MockCloudWatchLogsClient>(ALLOCATION_TAG);
+    client->AddError(TestCloudWatchLogsError(CloudWatchLogsErrors::INVALID_SEQUENCE_TOKEN, "InvalidSequenceTokenException",
+        "The given sequenceToken is invalid.", false, "{\"expectedSequenceToken\":\"expected-token\"}"));
+    CloudWatchLogsSink sink(MakeConfiguration(client));
+
+    ASSERT_TRUE(sink.Append(LOG_STREAM, "hello"));
+    sink.Flush();
+
+    auto requests = client->GetRequests();
+    ASSERT_EQ(2u, requests.size());
+    ASSERT_EQ("expected-token", requests[1].GetSequenceToken());
+    ASSERT_EQ("hello", requests[1].GetLogEvents()[0].GetMessage());
+    ASSERT_EQ(1u, sink.GetStatistics().eventsSent);
+}
+
+TEST(CloudWatchLogsSinkTest, TestMissingLogStreamIsCreated)
+{
+    auto client = Aws::MakeShared<MockCloudWatchLogsClient>(ALLOCATION_TAG);
+    client->AddError(TestCloudWatchLogsError(CloudWatchLogsErrors::RESOURCE_NOT_FOUND, "ResourceNotFoundException",
+        "The specified log stream does not exist.", false));
+    CloudWatchLogsSink sink(MakeConfiguration(client));
+
+    ASSERT_TRUE(sink.Append(LOG_STREAM, "hello"));
+    sink.Flush();
+
+    ASSERT_EQ(1u, client->GetCreateLogStreamCalls());
+    ASSERT_EQ(2u, client->GetRequests().size());
+    ASSERT_EQ(1u, sink.GetStatistics().eventsSent);
+}
+
+TEST(CloudWatchLogsSinkTest, TestRetryableErrorKeepsEventsForNextFlush)
+{
+    auto client = Aws::MakeShared<MockCloudWatchLogsClient>(ALLOCATION_TAG);
+    client->AddError(TestCloudWatchLogsError(CloudWatchLogsErrors::THROTTLING, "ThrottlingException", "Rate exceeded", true));
+    CloudWatchLogsSink sink(MakeConfiguration(client));
+
+    ASSERT_TRUE(sink.Append(LOG_STREAM, "first"));
+    ASSERT_TRUE(sink.Append(LOG_STREAM, "second"));
+    sink.Flush();
+    ASSERT_EQ(0u, sink.GetStatistics().eventsSent);
+
+    sink.Flush();
+    auto requests = client->GetRequests();
+    ASSERT_EQ(2u, requests.size());
+    ASSERT_EQ(2u, requests[1].GetLogEvents().size());
+    ASSERT_EQ(2u, sink.GetStatistics().eventsSent);
+    ASSERT_EQ(0u, sink.GetStatistics().eventsFailed);
+}
+
+TEST(CloudWatchLogsSinkTest, TestBufferIsBoundedAndDropsAreCounted)
+{
+    auto client = Aws::MakeShared<MockCloudWatchLogsClient>(ALLOCATION_TAG);
+    auto config = MakeConfiguration(client);
+    config.maxBufferedBytes = 10 * (10 + 26);
+    CloudWatchLogsSink sink(config);
+
+    size_t accepted = 0;
+    for (int i = 0; i < 20; ++i)
+    {
+        accepted += sink.Append(LOG_STREAM, Aws::String(10, 'x')) ? 1 : 0;
+    }
+    ASSERT_EQ(10u, accepted);
+
+    auto statistics = sink.GetStatistics();
+    ASSERT_EQ(10u, statistics.eventsAppended);
+    ASSERT_EQ(10u, statistics.eventsDropped);
+
+    // Sending frees the buffer again.
+    sink.Flush();
+    ASSERT_TRUE(sink.Append(LOG_STREAM, Aws::String(10, 'x')));
+}
+
+TEST(CloudWatchLogsSinkTest, TestConcurrentProducersLoseNothing)
+{
+    auto client = Aws::MakeShared<MockCloudWatchLogsClient>(ALLOCATION_TAG);
+    auto config = MakeConfiguration(client);
+    config.flushIntervalMs = 5;
+    config.maxBatchEvents = 500;
+    CloudWatchLogsSink sink(config);
+
+    static const int PRODUCERS = 4;
+    static const int EVENTS_PER_PRODUCER = 2000;
+    Aws::Vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p)
+    {
+        producers.emplace_back([&sink, p]()
+        {
+            Aws::String stream = "stream-" + Aws::Utils::StringUtils::to_string(p % 2);
+            for (int i = 0; i < EVENTS_PER_PRODUCER; ++i)
+            {
+                sink.Append(stream, "event " + Aws::Utils::StringUtils::to_string(i));
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    sink.Flush();
+
+    ASSERT_EQ(static_cast<size_t>(PRODUCERS * EVENTS_PER_PRODUCER), CountEvents(client->GetRequests()));
+    ASSERT_EQ(static_cast<uint64_t>(PRODUCERS * EVENTS_PER_PRODUCER), sink.GetStatistics().eventsSent);
+}
+
+TEST(CloudWatchLogsSinkTest, TestLogSystemForwardsFormattedStatements)
+{
+    auto client = Aws::MakeShared<MockCloudWatchLogsClient>(ALLOCATION_TAG);
+    auto sink = Aws::MakeShared<CloudWatchLogsSink>(ALLOCATION_TAG, MakeConfiguration(client));
+    CloudWatchLogSystem logSystem(Aws::Utils::Logging::LogLevel::Info, sink, LOG_STREAM);
+
+    Aws::OStringStream message;
+    message << "statement for cloudwatch";
+    logSystem.LogStream(Aws::Utils::Logging::LogLevel::Info, "Tag", message);
+    logSystem.Flush();
+
+    auto requests = client->GetRequests();
+    ASSERT_EQ(1u, requests.size());
+    ASSERT_EQ(1u, requests[0].GetLogEvents().size());
+    const auto& statement = requests[0].GetLogEvents()[0].GetMessage();
+    ASSERT_NE(Aws::String::npos, statement.find("statement for cloudwatch"));
+    ASSERT_NE('\n', statement.back());
+}
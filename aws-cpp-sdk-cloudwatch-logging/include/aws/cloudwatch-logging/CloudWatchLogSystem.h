@@ -0,0 +1,44 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/cloudwatch-logging/CloudWatchLogging_EXPORTS.h>
+#include <aws/core/utils/logging/FormattedLogSystem.h>
+#include <memory>
+
+namespace Aws
+{
+    namespace CloudWatchLogging
+    {
+        class CloudWatchLogsSink;
+
+        /**
+         * Log system that sends formatted SDK and application statements to a log stream through a CloudWatchLogsSink.
+         * Install it with Aws::Utils::Logging::InitializeAWSLogging or SDKOptions::loggingOptions.logger_create_fn.
+         * Statements issued by the sink's own background thread are discarded, so the SDK logging its PutLogEvents calls
+         * does not feed back into the stream.
+         */
+        class AWS_CLOUDWATCH_LOGGING_API CloudWatchLogSystem : public Aws::Utils::Logging::FormattedLogSystem
+        {
+        public:
+            using Base = FormattedLogSystem;
+
+            CloudWatchLogSystem(Aws::Utils::Logging::LogLevel logLevel, const std::shared_ptr<CloudWatchLogsSink>& sink, const Aws::String& logStreamName);
+
+            /**
+             * Blocks until the statements logged so far have been sent.
+             */
+            void Flush() override;
+
+        protected:
+            void ProcessFormattedStatement(Aws::String&& statement) override;
+
+        private:
+            std::shared_ptr<CloudWatchLogsSink> m_sink;
+            Aws::String m_logStreamName;
+        };
+    }
+}
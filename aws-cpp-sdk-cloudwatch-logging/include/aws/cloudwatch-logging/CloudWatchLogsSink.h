@@ -0,0 +1,201 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/cloudwatch-logging/CloudWatchLogging_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Aws
+{
+    namespace CloudWatchLogs
+    {
+        class CloudWatchLogsClient;
+    }
+
+    namespace CloudWatchLogging
+    {
+        /**
+         * Configuration for use with CloudWatchLogsSink. The data here will be copied directly to CloudWatchLogsSink.
+         */
+        struct CloudWatchLogsSinkConfiguration
+        {
+            CloudWatchLogsSinkConfiguration() :
+                createLogGroup(false), createLogStreams(true), maxBufferedBytes(16 * 1024 * 1024),
+                maxBatchEvents(10000), maxBatchBytes(1024 * 1024), flushIntervalMs(1000)
+            {
+            }
+
+            /**
+             * Client used to send events. You are responsible for setting this.
+             * Calls are only ever made from the sink's background thread.
+             */
+            std::shared_ptr<Aws::CloudWatchLogs::CloudWatchLogsClient> client;
+            /**
+             * Log group every stream of this sink belongs to. You are responsible for setting this.
+             */
+            Aws::String logGroupName;
+            /**
+             * Create the log group if PutLogEvents reports it missing.
+             */
+            bool createLogGroup;
+            /**
+             * Create log streams if PutLogEvents reports them missing.
+             */
+            bool createLogStreams;
+            /**
+             * Upper bound, in CloudWatch Logs accounting (message size + 26 bytes), of the events held by the sink at any time.
+             * Events appended while the sink is full are dropped and counted in CloudWatchLogsSinkStatistics::eventsDropped.
+             */
+            size_t maxBufferedBytes;
+            /**
+             * Maximum number of events per PutLogEvents call. The service maximum is 10,000.
+             */
+            size_t maxBatchEvents;
+            /**
+             * Maximum batch size, in CloudWatch Logs accounting, per PutLogEvents call. The service maximum is 1,048,576 bytes.
+             */
+            size_t maxBatchBytes;
+            /**
+             * How often buffered events are sent. Batches are also sent early once maxBatchBytes worth of events is waiting.
+             * Failed batches are retried on the next interval.
+             */
+            long flushIntervalMs;
+        };
+
+        /**
+         * Point in time counters of a CloudWatchLogsSink.
+         */
+        struct CloudWatchLogsSinkStatistics
+        {
+            CloudWatchLogsSinkStatistics() :
+                eventsAppended(0), eventsSent(0), eventsDropped(0), eventsRejected(0), eventsFailed(0), batchesSent(0)
+            {
+            }
+
+            /** Events accepted by Append. */
+            uint64_t eventsAppended;
+            /** Events accepted by CloudWatch Logs. */
+            uint64_t eventsSent;
+            /** Events discarded by Append because the buffer was full. */
+            uint64_t eventsDropped;
+            /** Events CloudWatch Logs reported as too old, too new or expired. */
+            uint64_t eventsRejected;
+            /** Events discarded after a non retryable PutLogEvents error. */
+            uint64_t eventsFailed;
+            /** Successful PutLogEvents calls. */
+            uint64_t batchesSent;
+        };
+
+        /**
+         * Ships log events to CloudWatch Logs in the background.
+         *
+         * Append never blocks: events are pushed onto a lock-free list and memory is bounded by maxBufferedBytes.
+         * A single background thread drains that list into per stream batchers which sort events by timestamp and split them
+         * at the PutLogEvents limits (maxBatchEvents, maxBatchBytes and a 24 hour span). Sequence tokens are tracked per
+         * stream by the background thread only; an InvalidSequenceTokenException or DataAlreadyAcceptedException is resolved
+         * from the token returned by the service without involving producers.
+         */
+        class AWS_CLOUDWATCH_LOGGING_API CloudWatchLogsSink
+        {
+        public:
+            CloudWatchLogsSink(const CloudWatchLogsSinkConfiguration& config);
+
+            /**
+             * Sends whatever is still buffered, then stops the background thread.
+             */
+            ~CloudWatchLogsSink();
+
+            CloudWatchLogsSink(const CloudWatchLogsSink&) = delete;
+            CloudWatchLogsSink& operator=(const CloudWatchLogsSink&) = delete;
+
+            /**
+             * Queues message for logStreamName with the current time. Returns false if the event was dropped.
+             */
+            bool Append(const Aws::String& logStreamName, Aws::String&& message);
+
+            /**
+             * Queues message for logStreamName with timestamp, in milliseconds since the epoch. Returns false if the event was dropped.
+             */
+            bool Append(const Aws::String& logStreamName, Aws::String&& message, long long timestampMs);
+
+            /**
+             * Blocks until every event appended before the call has been sent or given up on for this flush interval.
+             */
+            void Flush();
+
+            CloudWatchLogsSinkStatistics GetStatistics() const;
+
+            /**
+             * Returns true when called from the sink's background thread. Log systems feeding this sink use it to discard
+             * statements the SDK emits while the sink itself is calling CloudWatch Logs.
+             */
+            bool IsSinkThread() const;
+
+            inline const CloudWatchLogsSinkConfiguration& GetConfiguration() const { return m_config; }
+
+        private:
+            struct QueuedEvent
+            {
+                QueuedEvent* next;
+                Aws::String logStreamName;
+                Aws::String message;
+                long long timestamp;
+            };
+
+            struct LogEvent
+            {
+                long long timestamp;
+                Aws::String message;
+            };
+
+            struct StreamBatcher
+            {
+                StreamBatcher() : hasSequenceToken(false) {}
+
+                Aws::Vector<LogEvent> events;
+                Aws::String sequenceToken;
+                bool hasSequenceToken;
+            };
+
+            void Run();
+            void DrainQueue();
+            bool SendPending(const Aws::String& logStreamName, StreamBatcher& batcher);
+            bool EnsureLogStream(const Aws::String& logStreamName);
+            void Release(size_t bytes);
+
+            CloudWatchLogsSinkConfiguration m_config;
+
+            std::atomic<QueuedEvent*> m_queueHead;
+            std::atomic<size_t> m_bufferedBytes;
+
+            std::atomic<uint64_t> m_eventsAppended;
+            std::atomic<uint64_t> m_eventsSent;
+            std::atomic<uint64_t> m_eventsDropped;
+            std::atomic<uint64_t> m_eventsRejected;
+            std::atomic<uint64_t> m_eventsFailed;
+            std::atomic<uint64_t> m_batchesSent;
+
+            // Only touched by the background thread.
+            Aws::Map<Aws::String, StreamBatcher> m_batchers;
+
+            std::mutex m_signalMutex;
+            std::condition_variable m_signal;
+            std::condition_variable m_flushed;
+            bool m_batchReady;
+            uint64_t m_flushRequested;
+            uint64_t m_flushCompleted;
+            bool m_stopping;
+            std::thread m_thread;
+        };
+    }
+}
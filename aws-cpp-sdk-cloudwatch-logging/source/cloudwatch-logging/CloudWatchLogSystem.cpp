@@ -0,0 +1,43 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/cloudwatch-logging/CloudWatchLogSystem.h>
+#include <aws/cloudwatch-logging/CloudWatchLogsSink.h>
+
+using namespace Aws::Utils::Logging;
+
+namespace Aws
+{
+    namespace CloudWatchLogging
+    {
+        CloudWatchLogSystem::CloudWatchLogSystem(LogLevel logLevel, const std::shared_ptr<CloudWatchLogsSink>& sink, const Aws::String& logStreamName) :
+            Base(logLevel),
+            m_sink(sink),
+            m_logStreamName(logStreamName)
+        {
+        }
+
+        void CloudWatchLogSystem::Flush()
+        {
+            m_sink->Flush();
+        }
+
+        void CloudWatchLogSystem::ProcessFormattedStatement(Aws::String&& statement)
+        {
+            // The SDK logs the sink's own PutLogEvents calls; forwarding those would keep the sink busy forever.
+            if (m_sink->IsSinkThread())
+            {
+                return;
+            }
+
+            // Every CloudWatch Logs event is already a line of its own.
+            if (!statement.empty() && statement.back() == '\n')
+            {
+                statement.pop_back();
+            }
+            m_sink->Append(m_logStreamName, std::move(statement));
+        }
+    }
+}
@@ -0,0 +1,432 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/cloudwatch-logging/CloudWatchLogsSink.h>
+#include <aws/core/utils/DateTime.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/logs/CloudWatchLogsClient.h>
+#include <aws/logs/model/PutLogEventsRequest.h>
+#include <aws/logs/model/CreateLogStreamRequest.h>
+#include <aws/logs/model/CreateLogGroupRequest.h>
+#include <aws/logs/model/InvalidSequenceTokenException.h>
+#include <aws/logs/model/DataAlreadyAcceptedException.h>
+#include <algorithm>
+#include <cassert>
+
+using namespace Aws::CloudWatchLogs;
+using namespace Aws::CloudWatchLogs::Model;
+
+namespace Aws
+{
+    namespace CloudWatchLogging
+    {
+        static const char CLASS_TAG[] = "CloudWatchLogsSink";
+
+        // CloudWatch Logs counts every event as its UTF-8 message size plus 26 bytes.
+        static const size_t EVENT_OVERHEAD_BYTES = 26;
+        static const size_t MAX_EVENT_BYTES = 256 * 1024;
+        static const long long MAX_BATCH_SPAN_MS = 24LL * 60 * 60 * 1000;
+        // PutLogEvents attempts per batch while fixing up sequence tokens or creating the log stream.
+        static const int MAX_ATTEMPTS_PER_BATCH = 3;
+
+        static void TruncateMessage(Aws::String& message)
+        {
+            size_t maxMessageBytes = MAX_EVENT_BYTES - EVENT_OVERHEAD_BYTES;
+            if (message.size() <= maxMessageBytes)
+            {
+                return;
+            }
+
+            // Don't cut a multi-byte UTF-8 sequence in half.
+            size_t length = maxMessageBytes;
+            while (length > 0 && (static_cast<unsigned char>(message[length]) & 0xC0) == 0x80)
+            {
+                --length;
+            }
+            message.resize(length);
+        }
+
+        // The expected token is modeled, but older endpoints only put it in the message: "... sequenceToken is: <token>".
+        template<typename MODELED_ERROR>
+        static Aws::String GetExpectedSequenceToken(const MODELED_ERROR& modeledError, const Aws::String& message)
+        {
+            Aws::String token = modeledError.GetExpectedSequenceToken();
+            if (token.empty())
+            {
+                static const char TOKEN_PREFIX[] = "sequenceToken is: ";
+                auto pos = message.rfind(TOKEN_PREFIX);
+                if (pos != Aws::String::npos)
+                {
+                    token = message.substr(pos + sizeof(TOKEN_PREFIX) - 1);
+                }
+            }
+            return token == "null" ? Aws::String() : token;
+        }
+
+        CloudWatchLogsSink::CloudWatchLogsSink(const CloudWatchLogsSinkConfiguration& config) :
+            m_config(config), m_queueHead(nullptr), m_bufferedBytes(0),
+            m_eventsAppended(0), m_eventsSent(0), m_eventsDropped(0), m_eventsRejected(0), m_eventsFailed(0), m_batchesSent(0),
+            m_batchReady(false), m_flushRequested(0), m_flushCompleted(0), m_stopping(false)
+        {
+            assert(m_config.client);
+            m_config.maxBatchEvents = (std::max)((std::min)(m_config.maxBatchEvents, static_cast<size_t>(10000)), static_cast<size_t>(1));
+            m_config.maxBatchBytes = (std::min)(m_config.maxBatchBytes, static_cast<size_t>(1024 * 1024));
+
+            // Run starts by taking this lock, so m_thread is set before the sink thread's own Flush calls check it.
+            std::lock_guard<std::mutex> locker(m_signalMutex);
+            m_thread = std::thread(&CloudWatchLogsSink::Run, this);
+        }
+
+        CloudWatchLogsSink::~CloudWatchLogsSink()
+        {
+            {
+                std::lock_guard<std::mutex> locker(m_signalMutex);
+                m_stopping = true;
+            }
+            m_signal.notify_one();
+            if (m_thread.joinable())
+            {
+                m_thread.join();
+            }
+
+            // Events appended after the final drain have nowhere to go.
+            QueuedEvent* head = m_queueHead.exchange(nullptr);
+            while (head)
+            {
+                QueuedEvent* next = head->next;
+                ++m_eventsDropped;
+                Aws::Delete(head);
+                head = next;
+            }
+        }
+
+        bool CloudWatchLogsSink::Append(const Aws::String& logStreamName, Aws::String&& message)
+        {
+            return Append(logStreamName, std::move(message), Aws::Utils::DateTime::CurrentTimeMillis());
+        }
+
+        bool CloudWatchLogsSink::Append(const Aws::String& logStreamName, Aws::String&& message, long long timestampMs)
+        {
+            TruncateMessage(message);
+            size_t eventBytes = message.size() + EVENT_OVERHEAD_BYTES;
+
+            size_t buffered = m_bufferedBytes.load(std::memory_order_relaxed);
+            do
+            {
+                if (buffered + eventBytes > m_config.maxBufferedBytes)
+                {
+                    ++m_eventsDropped;
+                    return false;
+                }
+            } while (!m_bufferedBytes.compare_exchange_weak(buffered, buffered + eventBytes, std::memory_order_relaxed));
+
+            QueuedEvent* event = Aws::New<QueuedEvent>(CLASS_TAG);
+            event->logStreamName = logStreamName;
+            event->message = std::move(message);
+            event->timestamp = timestampMs;
+            event->next = m_queueHead.load(std::memory_order_relaxed);
+            while (!m_queueHead.compare_exchange_weak(event->next, event, std::memory_order_release, std::memory_order_relaxed));
+            ++m_eventsAppended;
+
+            // Wake the sender early once a full batch is waiting rather than letting the buffer fill up until the next interval.
+            if (buffered < m_config.maxBatchBytes && buffered + eventBytes >= m_config.maxBatchBytes)
+            {
+                {
+                    std::lock_guard<std::mutex> locker(m_signalMutex);
+                    m_batchReady = true;
+                }
+                m_signal.notify_one();
+            }
+            return true;
+        }
+
+        void CloudWatchLogsSink::Flush()
+        {
+            if (IsSinkThread())
+            {
+                return;
+            }
+
+            std::unique_lock<std::mutex> locker(m_signalMutex);
+            if (m_stopping)
+            {
+                return;
+            }
+            uint64_t target = ++m_flushRequested;
+            m_signal.notify_one();
+            m_flushed.wait(locker, [&]() { return m_flushCompleted >= target; });
+        }
+
+        CloudWatchLogsSinkStatistics CloudWatchLogsSink::GetStatistics() const
+        {
+            CloudWatchLogsSinkStatistics statistics;
+            statistics.eventsAppended = m_eventsAppended.load();
+            statistics.eventsSent = m_eventsSent.load();
+            statistics.eventsDropped = m_eventsDropped.load();
+            statistics.eventsRejected = m_eventsRejected.load();
+            statistics.eventsFailed = m_eventsFailed.load();
+            statistics.batchesSent = m_batchesSent.load();
+            return statistics;
+        }
+
+        bool CloudWatchLogsSink::IsSinkThread() const
+        {
+            return std::this_thread::get_id() == m_thread.get_id();
+        }
+
+        void CloudWatchLogsSink::Run()
+        {
+            for (;;)
+            {
+                uint64_t flushTarget = 0;
+                bool stopping = false;
+                {
+                    std::unique_lock<std::mutex> locker(m_signalMutex);
+                    m_signal.wait_for(locker, std::chrono::milliseconds(m_config.flushIntervalMs), [this]()
+                    {
+                        return m_stopping || m_flushRequested != m_flushCompleted || m_batchReady;
+                    });
+                    flushTarget = m_flushRequested;
+                    stopping = m_stopping;
+                    m_batchReady = false;
+                }
+
+                DrainQueue();
+                for (auto& batcher : m_batchers)
+                {
+                    SendPending(batcher.first, batcher.second);
+                }
+
+                {
+                    std::lock_guard<std::mutex> locker(m_signalMutex);
+                    m_flushCompleted = flushTarget;
+                }
+                m_flushed.notify_all();
+
+                if (stopping)
+                {
+                    for (const auto& batcher : m_batchers)
+                    {
+                        if (!batcher.second.events.empty())
+                        {
+                            AWS_LOGSTREAM_WARN(CLASS_TAG, "Discarding " << batcher.second.events.size()
+                                    << " unsent events for log stream " << batcher.first);
+                            m_eventsFailed += batcher.second.events.size();
+                        }
+                    }
+                    return;
+                }
+            }
+        }
+
+        void CloudWatchLogsSink::DrainQueue()
+        {
+            QueuedEvent* head = m_queueHead.exchange(nullptr, std::memory_order_acquire);
+
+            // The list was built by pushing to the front; reverse it to restore append order.
+            QueuedEvent* ordered = nullptr;
+            while (head)
+            {
+                QueuedEvent* next = head->next;
+                head->next = ordered;
+                ordered = head;
+                head = next;
+            }
+
+            while (ordered)
+            {
+                QueuedEvent* next = ordered->next;
+                LogEvent event;
+                event.timestamp = ordered->timestamp;
+                event.message = std::move(ordered->message);
+                m_batchers[ordered->logStreamName].events.push_back(std::move(event));
+                Aws::Delete(ordered);
+                ordered = next;
+            }
+        }
+
+        bool CloudWatchLogsSink::SendPending(const Aws::String& logStreamName, StreamBatcher& batcher)
+        {
+            auto& events = batcher.events;
+            if (events.empty())
+            {
+                return true;
+            }
+
+            // PutLogEvents requires chronological order; stable so that events sharing a timestamp keep their order.
+            std::stable_sort(events.begin(), events.end(), [](const LogEvent& a, const LogEvent& b) { return a.timestamp < b.timestamp; });
+
+            size_t sent = 0;
+            bool succeeded = true;
+            while (succeeded && sent < events.size())
+            {
+                size_t end = sent;
+                size_t batchBytes = 0;
+                while (end < events.size() && end - sent < m_config.maxBatchEvents)
+                {
+                    size_t eventBytes = events[end].message.size() + EVENT_OVERHEAD_BYTES;
+                    if (end > sent && (batchBytes + eventBytes > m_config.maxBatchBytes || events[end].timestamp - events[sent].timestamp > MAX_BATCH_SPAN_MS))
+                    {
+                        break;
+                    }
+                    batchBytes += eventBytes;
+                    ++end;
+                }
+                size_t batchCount = end - sent;
+
+                Aws::Vector<InputLogEvent> logEvents;
+                logEvents.reserve(batchCount);
+                for (size_t i = sent; i < end; ++i)
+                {
+                    logEvents.push_back(InputLogEvent().WithTimestamp(events[i].timestamp).WithMessage(events[i].message));
+                }
+
+                bool done = false;
+                for (int attempt = 0; attempt < MAX_ATTEMPTS_PER_BATCH && !done; ++attempt)
+                {
+                    PutLogEventsRequest request;
+                    request.SetLogGroupName(m_config.logGroupName);
+                    request.SetLogStreamName(logStreamName);
+                    request.SetLogEvents(logEvents);
+                    if (batcher.hasSequenceToken)
+                    {
+                        request.SetSequenceToken(batcher.sequenceToken);
+                    }
+
+                    auto outcome = m_config.client->PutLogEvents(request);
+                    if (outcome.IsSuccess())
+                    {
+                        const auto& result = outcome.GetResult();
+                        batcher.sequenceToken = result.GetNextSequenceToken();
+                        batcher.hasSequenceToken = !batcher.sequenceToken.empty();
+
+                        const auto& rejected = result.GetRejectedLogEventsInfo();
+                        size_t rejectedCount = 0;
+                        size_t tooOld = 0;
+                        if (rejected.TooOldLogEventEndIndexHasBeenSet())
+                        {
+                            tooOld = static_cast<size_t>(rejected.GetTooOldLogEventEndIndex()) + 1;
+                        }
+                        if (rejected.ExpiredLogEventEndIndexHasBeenSet())
+                        {
+                            tooOld = (std::max)(tooOld, static_cast<size_t>(rejected.GetExpiredLogEventEndIndex()) + 1);
+                        }
+                        rejectedCount += (std::min)(tooOld, batchCount);
+                        if (rejected.TooNewLogEventStartIndexHasBeenSet() && static_cast<size_t>(rejected.GetTooNewLogEventStartIndex()) < batchCount)
+                        {
+                            rejectedCount += batchCount - (std::max)(static_cast<size_t>(rejected.GetTooNewLogEventStartIndex()), tooOld);
+                        }
+
+                        m_eventsRejected += rejectedCount;
+                        m_eventsSent += batchCount - rejectedCount;
+                        ++m_batchesSent;
+                        done = true;
+                        continue;
+                    }
+
+                    const auto& error = outcome.GetError();
+                    switch (error.GetErrorType())
+                    {
+                        case CloudWatchLogsErrors::INVALID_SEQUENCE_TOKEN:
+                            // Another writer advanced the stream; adopt its token and try again.
+                            batcher.sequenceToken = GetExpectedSequenceToken(CloudWatchLogsError(error).GetModeledError<InvalidSequenceTokenException>(), error.GetMessage());
+                            batcher.hasSequenceToken = !batcher.sequenceToken.empty();
+                            AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Sequence token for log stream " << logStreamName << " was stale, retrying.");
+                            break;
+                        case CloudWatchLogsErrors::DATA_ALREADY_ACCEPTED:
+                            // A previous attempt of this batch went through even though its response was lost.
+                            batcher.sequenceToken = GetExpectedSequenceToken(CloudWatchLogsError(error).GetModeledError<DataAlreadyAcceptedException>(), error.GetMessage());
+                            batcher.hasSequenceToken = !batcher.sequenceToken.empty();
+                            m_eventsSent += batchCount;
+                            ++m_batchesSent;
+                            done = true;
+                            break;
+                        case CloudWatchLogsErrors::RESOURCE_NOT_FOUND:
+                            // A new stream starts without a sequence token.
+                            batcher.sequenceToken.clear();
+                            batcher.hasSequenceToken = false;
+                            if (!EnsureLogStream(logStreamName))
+                            {
+                                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Log stream " << logStreamName << " is not available, discarding "
+                                        << batchCount << " events: " << error.GetMessage());
+                                m_eventsFailed += batchCount;
+                                done = true;
+                            }
+                            break;
+                        default:
+                            if (error.ShouldRetry())
+                            {
+                                AWS_LOGSTREAM_WARN(CLASS_TAG, "PutLogEvents failed for log stream " << logStreamName << ", retrying next interval: "
+                                        << error.GetExceptionName() << " " << error.GetMessage());
+                                attempt = MAX_ATTEMPTS_PER_BATCH;
+                            }
+                            else
+                            {
+                                AWS_LOGSTREAM_ERROR(CLASS_TAG, "PutLogEvents failed for log stream " << logStreamName << ", discarding "
+                                        << batchCount << " events: " << error.GetExceptionName() << " " << error.GetMessage());
+                                m_eventsFailed += batchCount;
+                                done = true;
+                            }
+                            break;
+                    }
+                }
+
+                if (!done)
+                {
+                    // Out of attempts or retryable failure: keep the batch for the next interval.
+                    succeeded = false;
+                    break;
+                }
+
+                Release(batchBytes);
+                sent = end;
+            }
+
+            events.erase(events.begin(), events.begin() + sent);
+            return succeeded;
+        }
+
+        bool CloudWatchLogsSink::EnsureLogStream(const Aws::String& logStreamName)
+        {
+            if (!m_config.createLogStreams)
+            {
+                return false;
+            }
+
+            CreateLogStreamRequest streamRequest;
+            streamRequest.SetLogGroupName(m_config.logGroupName);
+            streamRequest.SetLogStreamName(logStreamName);
+            auto streamOutcome = m_config.client->CreateLogStream(streamRequest);
+            if (streamOutcome.IsSuccess() || streamOutcome.GetError().GetErrorType() == CloudWatchLogsErrors::RESOURCE_ALREADY_EXISTS)
+            {
+                return true;
+            }
+
+            if (streamOutcome.GetError().GetErrorType() != CloudWatchLogsErrors::RESOURCE_NOT_FOUND || !m_config.createLogGroup)
+            {
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Failed to create log stream " << logStreamName << ": " << streamOutcome.GetError().GetMessage());
+                return false;
+            }
+
+            CreateLogGroupRequest groupRequest;
+            groupRequest.SetLogGroupName(m_config.logGroupName);
+            auto groupOutcome = m_config.client->CreateLogGroup(groupRequest);
+            if (!groupOutcome.IsSuccess() && groupOutcome.GetError().GetErrorType() != CloudWatchLogsErrors::RESOURCE_ALREADY_EXISTS)
+            {
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Failed to create log group " << m_config.logGroupName << ": " << groupOutcome.GetError().GetMessage());
+                return false;
+            }
+
+            streamOutcome = m_config.client->CreateLogStream(streamRequest);
+            return streamOutcome.IsSuccess() || streamOutcome.GetError().GetErrorType() == CloudWatchLogsErrors::RESOURCE_ALREADY_EXISTS;
+        }
+
+        void CloudWatchLogsSink::Release(size_t bytes)
+        {
+            m_bufferedBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+    }
+}
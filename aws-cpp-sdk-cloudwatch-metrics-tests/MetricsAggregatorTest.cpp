@@ -0,0 +1,338 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/cloudwatch-metrics/MetricsAggregator.h>
+#include <aws/cloudwatch-metrics/HttpClientMetricsPublisher.h>
+#include <aws/core/auth/AWSCredentials.h>
+#include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/monitoring/HttpClientMetrics.h>
+#include <aws/core/utils/StringUtils.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/monitoring/CloudWatchClient.h>
+#include <aws/monitoring/model/PutMetricDataRequest.h>
+#include <thread>
+
+using namespace Aws::CloudWatchMetrics;
+using namespace Aws::CloudWatch;
+using namespace Aws::CloudWatch::Model;
+using namespace Aws::Client;
+
+static const char ALLOCATION_TAG[] = "MetricsAggregatorTest";
+static const char METRIC_NAMESPACE[] = "Test/Namespace";
+
+namespace
+{
+    class MockCloudWatchClient : public CloudWatchClient
+    {
+    public:
+        MockCloudWatchClient() : CloudWatchClient(Aws::Auth::AWSCredentials("", ""), ClientConfiguration()), m_failRequests(false) {}
+
+        PutMetricDataOutcome PutMetricData(const PutMetricDataRequest& request) const override
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_requests.push_back(request);
+            if (m_failRequests)
+            {
+                return CloudWatchError(AWSError<CloudWatchErrors>(CloudWatchErrors::INTERNAL_FAILURE, "InternalServiceError", "failed", false));
+            }
+            return PutMetricDataOutcome(Aws::NoResult());
+        }
+
+        void SetFailRequests(bool failRequests)
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_failRequests = failRequests;
+        }
+
+        Aws::Vector<PutMetricDataRequest> GetRequests() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_requests;
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+        mutable Aws::Vector<PutMetricDataRequest> m_requests;
+        bool m_failRequests;
+    };
+
+    MetricsAggregatorConfiguration MakeConfiguration(const std::shared_ptr<MockCloudWatchClient>& client)
+    {
+        MetricsAggregatorConfiguration config;
+        config.client = client;
+        config.metricNamespace = METRIC_NAMESPACE;
+        config.shardCount = 1;
+        // Tests drive publishing explicitly through Flush.
+        config.flushIntervalMs = 60000;
+        return config;
+    }
+
+    Aws::Vector<MetricDatum> GetDatums(const Aws::Vector<PutMetricDataRequest>& requests)
+    {
+        Aws::Vector<MetricDatum> datums;
+        for (const auto& request : requests)
+        {
+            datums.insert(datums.end(), request.GetMetricData().begin(), request.GetMetricData().end());
+        }
+        return datums;
+    }
+}
+
+TEST(MetricsAggregatorTest, TestCounterIsSummedAcrossThreads)
+{
+    auto client = Aws::MakeShared<MockCloudWatchClient>(ALLOCATION_TAG);
+    auto config = MakeConfiguration(client);
+    config.shardCount = 4;
+    MetricsAggregator aggregator(config);
+
+    MetricId requests = aggregator.RegisterMetric("Requests", MetricKind::Counter, Aws::Vector<Dimension>(), StandardUnit::Count);
+    ASSERT_NE(INVALID_METRIC_ID, requests);
+
+    Aws::Vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i)
+    {
+        threads.emplace_back([&]()
+        {
+            for (int j = 0; j < 1000; ++j)
+            {
+                aggregator.Record(requests, 1);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    aggregator.Flush();
+
+    auto requestsSent = client->GetRequests();
+    ASSERT_EQ(1u, requestsSent.size());
+    ASSERT_EQ(METRIC_NAMESPACE, requestsSent[0].GetNamespace());
+    ASSERT_EQ(1u, requestsSent[0].GetMetricData().size());
+    const MetricDatum& datum = requestsSent[0].GetMetricData()[0];
+    ASSERT_EQ("Requests", datum.GetMetricName());
+    ASSERT_EQ(StandardUnit::Count, datum.GetUnit());
+    ASSERT_EQ(60, datum.GetStorageResolution());
+    ASSERT_DOUBLE_EQ(8000, datum.GetValue());
+
+    // Nothing was recorded since, so there is nothing to publish.
+    aggregator.Flush();
+    ASSERT_EQ(1u, client->GetRequests().size());
+}
+
+TEST(MetricsAggregatorTest, TestGaugeAndSummary)
+{
+    auto client = Aws::MakeShared<MockCloudWatchClient>(ALLOCATION_TAG);
+    MetricsAggregator aggregator(MakeConfiguration(client));
+
+    MetricId queueDepth = aggregator.RegisterMetric("QueueDepth", MetricKind::Gauge);
+    MetricId payloadSize = aggregator.RegisterMetric("PayloadSize", MetricKind::Summary, Aws::Vector<Dimension>(), StandardUnit::Bytes);
+    aggregator.Record(queueDepth, 10);
+    aggregator.Record(queueDepth, 3);
+    aggregator.Record(payloadSize, 100);
+    aggregator.Record(payloadSize, 20);
+    aggregator.Record(payloadSize, 300);
+    aggregator.Flush();
+
+    auto datums = GetDatums(client->GetRequests());
+    ASSERT_EQ(2u, datums.size());
+
+    ASSERT_EQ("QueueDepth", datums[0].GetMetricName());
+    ASSERT_DOUBLE_EQ(3, datums[0].GetValue());
+    ASSERT_FALSE(datums[0].StatisticValuesHasBeenSet());
+
+    ASSERT_EQ("PayloadSize", datums[1].GetMetricName());
+    ASSERT_FALSE(datums[1].ValueHasBeenSet());
+    const StatisticSet& statistics = datums[1].GetStatisticValues();
+    ASSERT_DOUBLE_EQ(3, statistics.GetSampleCount());
+    ASSERT_DOUBLE_EQ(420, statistics.GetSum());
+    ASSERT_DOUBLE_EQ(20, statistics.GetMinimum());
+    ASSERT_DOUBLE_EQ(300, statistics.GetMaximum());
+}
+
+TEST(MetricsAggregatorTest, TestHistogramValuesAreSplitAndBounded)
+{
+    auto client = Aws::MakeShared<MockCloudWatchClient>(ALLOCATION_TAG);
+    auto config = MakeConfiguration(client);
+    config.maxDistinctValues = 3;
+    config.maxValuesPerDatum = 2;
+    MetricsAggregator aggregator(config);
+
+    MetricId latency = aggregator.RegisterMetric("Latency", MetricKind::Histogram, Aws::Vector<Dimension>(), StandardUnit::Milliseconds);
+    for (double value : {2.0, 1.0, 1.0, 3.0, 5.0, 4.0, 2.0})
+    {
+        aggregator.Record(latency, value);
+    }
+    aggregator.Flush();
+
+    auto datums = GetDatums(client->GetRequests());
+    ASSERT_EQ(3u, datums.size());
+
+    ASSERT_EQ(Aws::Vector<double>({1.0, 2.0}), datums[0].GetValues());
+    ASSERT_EQ(Aws::Vector<double>({2.0, 2.0}), datums[0].GetCounts());
+    ASSERT_EQ(Aws::Vector<double>({3.0}), datums[1].GetValues());
+    ASSERT_EQ(Aws::Vector<double>({1.0}), datums[1].GetCounts());
+
+    // 5 and 4 arrived once three distinct values were already held.
+    ASSERT_FALSE(datums[2].ValuesHasBeenSet());
+    ASSERT_DOUBLE_EQ(2, datums[2].GetStatisticValues().GetSampleCount());
+    ASSERT_DOUBLE_EQ(9, datums[2].GetStatisticValues().GetSum());
+    ASSERT_DOUBLE_EQ(4, datums[2].GetStatisticValues().GetMinimum());
+    ASSERT_DOUBLE_EQ(5, datums[2].GetStatisticValues().GetMaximum());
+    ASSERT_EQ(2u, aggregator.GetStatistics().valuesOverflowed);
+    for (const auto& datum : datums)
+    {
+        ASSERT_EQ("Latency", datum.GetMetricName());
+        ASSERT_EQ(StandardUnit::Milliseconds, datum.GetUnit());
+    }
+}
+
+TEST(MetricsAggregatorTest, TestDatumsArePackedIntoRequests)
+{
+    auto client = Aws::MakeShared<MockCloudWatchClient>(ALLOCATION_TAG);
+    auto config = MakeConfiguration(client);
+    config.maxDatumsPerRequest = 10;
+    MetricsAggregator aggregator(config);
+
+    for (int i = 0; i < 25; ++i)
+    {
+        aggregator.Record(aggregator.RegisterMetric("Metric" + Aws::Utils::StringUtils::to_string(i), MetricKind::Counter), 1);
+    }
+    aggregator.Flush();
+
+    auto requests = client->GetRequests();
+    ASSERT_EQ(3u, requests.size());
+    ASSERT_EQ(10u, requests[0].GetMetricData().size());
+    ASSERT_EQ(10u, requests[1].GetMetricData().size());
+    ASSERT_EQ(5u, requests[2].GetMetricData().size());
+
+    auto statistics = aggregator.GetStatistics();
+    ASSERT_EQ(3u, statistics.requestsSent);
+    ASSERT_EQ(25u, statistics.datumsSent);
+}
+
+TEST(MetricsAggregatorTest, TestRequestsAreSplitBySize)
+{
+    auto client = Aws::MakeShared<MockCloudWatchClient>(ALLOCATION_TAG);
+    auto config = MakeConfiguration(client);
+    config.maxRequestBytes = 8 * 1024;
+    MetricsAggregator aggregator(config);
+
+    Aws::String longValue(1024, 'v');
+    for (int i = 0; i < 20; ++i)
+    {
+        Aws::Vector<Dimension> dimensions;
+        dimensions.push_back(Dimension().WithName("Host").WithValue(longValue + Aws::Utils::StringUtils::to_string(i)));
+        aggregator.Record(aggregator.RegisterMetric("Metric", MetricKind::Gauge, dimensions), i);
+    }
+    aggregator.Flush();
+
+    auto requests = client->GetRequests();
+    ASSERT_LT(1u, requests.size());
+    ASSERT_EQ(20u, GetDatums(requests).size());
+    for (const auto& request : requests)
+    {
+        size_t bytes = 0;
+        for (const auto& datum : request.GetMetricData())
+        {
+            bytes += datum.GetDimensions()[0].GetValue().size();
+        }
+        ASSERT_GT(config.maxRequestBytes, bytes);
+    }
+}
+
+TEST(MetricsAggregatorTest, TestMetricsAreInterned)
+{
+    auto client = Aws::MakeShared<MockCloudWatchClient>(ALLOCATION_TAG);
+    auto config = MakeConfiguration(client);
+    config.maxSeries = 2;
+    MetricsAggregator aggregator(config);
+
+    Aws::Vector<Dimension> dimensions;
+    dimensions.push_back(Dimension().WithName("Service").WithValue("S3"));
+    dimensions.push_back(Dimension().WithName("Operation").WithValue("GetObject"));
+    Aws::Vector<Dimension> reversed(dimensions.rbegin(), dimensions.rend());
+
+    MetricId first = aggregator.RegisterMetric("Calls", MetricKind::Counter, dimensions);
+    ASSERT_NE(INVALID_METRIC_ID, first);
+    ASSERT_EQ(first, aggregator.RegisterMetric("Calls", MetricKind::Counter, reversed));
+    ASSERT_EQ(INVALID_METRIC_ID, aggregator.RegisterMetric("Calls", MetricKind::Gauge, dimensions));
+
+    MetricId second = aggregator.RegisterMetric("Calls", MetricKind::Counter);
+    ASSERT_NE(INVALID_METRIC_ID, second);
+    ASSERT_NE(first, second);
+    ASSERT_EQ(INVALID_METRIC_ID, aggregator.RegisterMetric("Errors", MetricKind::Counter));
+
+    aggregator.Record(first, 2);
+    aggregator.Record(INVALID_METRIC_ID, 5);
+    aggregator.Flush();
+
+    auto datums = GetDatums(client->GetRequests());
+    ASSERT_EQ(1u, datums.size());
+    ASSERT_DOUBLE_EQ(2, datums[0].GetValue());
+    ASSERT_EQ(2u, datums[0].GetDimensions().size());
+    ASSERT_EQ("Operation", datums[0].GetDimensions()[0].GetName());
+    ASSERT_EQ("Service", datums[0].GetDimensions()[1].GetName());
+
+    auto statistics = aggregator.GetStatistics();
+    ASSERT_EQ(2u, statistics.seriesRegistered);
+    ASSERT_EQ(1u, statistics.seriesRejected);
+}
+
+TEST(MetricsAggregatorTest, TestFailedRequestsAreCounted)
+{
+    auto client = Aws::MakeShared<MockCloudWatchClient>(ALLOCATION_TAG);
+    client->SetFailRequests(true);
+    MetricsAggregator aggregator(MakeConfiguration(client));
+
+    aggregator.Record(aggregator.RegisterMetric("Requests", MetricKind::Counter), 1);
+    aggregator.Record(aggregator.RegisterMetric("Errors", MetricKind::Counter), 1);
+    aggregator.Flush();
+
+    auto statistics = aggregator.GetStatistics();
+    ASSERT_EQ(0u, statistics.requestsSent);
+    ASSERT_EQ(1u, statistics.requestsFailed);
+    ASSERT_EQ(2u, statistics.datumsFailed);
+}
+
+TEST(MetricsAggregatorTest, TestHttpClientMetricsArePublished)
+{
+    auto client = Aws::MakeShared<MockCloudWatchClient>(ALLOCATION_TAG);
+    auto aggregator = Aws::MakeShared<MetricsAggregator>(ALLOCATION_TAG, MakeConfiguration(client));
+    HttpClientMetricsPublisherFactory factory(aggregator);
+    auto publisher = factory.CreateMonitoringInstance();
+
+    using namespace Aws::Monitoring;
+    CoreMetricsCollection metrics;
+    metrics.httpClientMetrics[GetHttpClientMetricNameByType(HttpClientMetricsType::RequestLatency)] = 12;
+    metrics.httpClientMetrics[GetHttpClientMetricNameByType(HttpClientMetricsType::DestinationIp)] = 0;
+    HttpResponseOutcome outcome;
+
+    void* context = publisher->OnRequestStarted("s3", "GetObject", nullptr);
+    publisher->OnRequestSucceeded("s3", "GetObject", nullptr, outcome, metrics, context);
+    publisher->OnFinish("s3", "GetObject", nullptr, context);
+    context = publisher->OnRequestStarted("s3", "GetObject", nullptr);
+    publisher->OnRequestFailed("s3", "GetObject", nullptr, outcome, metrics, context);
+    publisher->OnFinish("s3", "GetObject", nullptr, context);
+    aggregator->Flush();
+
+    auto datums = GetDatums(client->GetRequests());
+    ASSERT_EQ(2u, datums.size());
+
+    const MetricDatum& latency = datums[0];
+    ASSERT_EQ(GetHttpClientMetricNameByType(HttpClientMetricsType::RequestLatency), latency.GetMetricName());
+    ASSERT_EQ(StandardUnit::Milliseconds, latency.GetUnit());
+    ASSERT_EQ(Aws::Vector<double>({12.0}), latency.GetValues());
+    ASSERT_EQ(Aws::Vector<double>({2.0}), latency.GetCounts());
+    ASSERT_EQ(2u, latency.GetDimensions().size());
+    ASSERT_EQ("Operation", latency.GetDimensions()[0].GetName());
+    ASSERT_EQ("GetObject", latency.GetDimensions()[0].GetValue());
+    ASSERT_EQ("Service", latency.GetDimensions()[1].GetName());
+    ASSERT_EQ("s3", latency.GetDimensions()[1].GetValue());
+
+    ASSERT_EQ("RequestFailures", datums[1].GetMetricName());
+    ASSERT_DOUBLE_EQ(1, datums[1].GetValue());
+}
@@ -0,0 +1,69 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/cloudwatch-metrics/CloudWatchMetrics_EXPORTS.h>
+#include <aws/cloudwatch-metrics/MetricsAggregator.h>
+#include <aws/core/monitoring/MonitoringInterface.h>
+#include <aws/core/monitoring/MonitoringFactory.h>
+#include <memory>
+
+namespace Aws
+{
+    namespace CloudWatchMetrics
+    {
+        /**
+         * Monitoring implementation recording the HttpClientMetrics the SDK collects for every request (request, DNS,
+         * connect and SSL latencies) as histograms in a MetricsAggregator, with Service and Operation dimensions.
+         * A failure counter, RequestFailures, is kept per service and operation as well.
+         *
+         * Register it through HttpClientMetricsPublisherFactory in SDKOptions::monitoringOptions. The aggregator's own
+         * PutMetricData calls are not recorded.
+         */
+        class AWS_CLOUDWATCH_METRICS_API HttpClientMetricsPublisher : public Aws::Monitoring::MonitoringInterface
+        {
+        public:
+            HttpClientMetricsPublisher(const std::shared_ptr<MetricsAggregator>& aggregator);
+
+            void* OnRequestStarted(const Aws::String& serviceName, const Aws::String& requestName,
+                const std::shared_ptr<const Aws::Http::HttpRequest>& request) const override;
+
+            void OnRequestSucceeded(const Aws::String& serviceName, const Aws::String& requestName,
+                const std::shared_ptr<const Aws::Http::HttpRequest>& request, const Aws::Client::HttpResponseOutcome& outcome,
+                const Aws::Monitoring::CoreMetricsCollection& metricsFromCore, void* context) const override;
+
+            void OnRequestFailed(const Aws::String& serviceName, const Aws::String& requestName,
+                const std::shared_ptr<const Aws::Http::HttpRequest>& request, const Aws::Client::HttpResponseOutcome& outcome,
+                const Aws::Monitoring::CoreMetricsCollection& metricsFromCore, void* context) const override;
+
+            void OnRequestRetry(const Aws::String& serviceName, const Aws::String& requestName,
+                const std::shared_ptr<const Aws::Http::HttpRequest>& request, void* context) const override;
+
+            void OnFinish(const Aws::String& serviceName, const Aws::String& requestName,
+                const std::shared_ptr<const Aws::Http::HttpRequest>& request, void* context) const override;
+
+        private:
+            void RecordHttpClientMetrics(const Aws::String& serviceName, const Aws::String& requestName,
+                const Aws::Monitoring::CoreMetricsCollection& metricsFromCore) const;
+
+            std::shared_ptr<MetricsAggregator> m_aggregator;
+        };
+
+        /**
+         * Creates HttpClientMetricsPublisher instances feeding aggregator.
+         */
+        class AWS_CLOUDWATCH_METRICS_API HttpClientMetricsPublisherFactory : public Aws::Monitoring::MonitoringFactory
+        {
+        public:
+            HttpClientMetricsPublisherFactory(const std::shared_ptr<MetricsAggregator>& aggregator);
+
+            Aws::UniquePtr<Aws::Monitoring::MonitoringInterface> CreateMonitoringInstance() const override;
+
+        private:
+            std::shared_ptr<MetricsAggregator> m_aggregator;
+        };
+    }
+}
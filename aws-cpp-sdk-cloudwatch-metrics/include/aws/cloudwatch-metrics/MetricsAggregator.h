@@ -0,0 +1,259 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/cloudwatch-metrics/CloudWatchMetrics_EXPORTS.h>
+#include <aws/monitoring/model/Dimension.h>
+#include <aws/monitoring/model/MetricDatum.h>
+#include <aws/monitoring/model/StandardUnit.h>
+#include <aws/core/utils/threading/ReaderWriterLock.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Aws
+{
+    namespace CloudWatch
+    {
+        class CloudWatchClient;
+    }
+
+    namespace CloudWatchMetrics
+    {
+        /**
+         * How values recorded against a metric are aggregated over a flush interval.
+         */
+        enum class MetricKind
+        {
+            /** Values are summed and published as a single value. */
+            Counter,
+            /** The most recently recorded value is published. */
+            Gauge,
+            /** Values are published as a StatisticSet (sample count, sum, minimum and maximum). */
+            Summary,
+            /** Values are published as Values/Counts arrays so CloudWatch can compute percentiles. */
+            Histogram
+        };
+
+        typedef size_t MetricId;
+
+        /**
+         * Returned by MetricsAggregator::RegisterMetric when the metric could not be registered.
+         * Recording against it is a no-op.
+         */
+        static const MetricId INVALID_METRIC_ID = static_cast<MetricId>(-1);
+
+        /**
+         * Configuration for use with MetricsAggregator. The data here will be copied directly to MetricsAggregator.
+         */
+        struct MetricsAggregatorConfiguration
+        {
+            MetricsAggregatorConfiguration() :
+                storageResolution(60), shardCount(0), maxSeries(4096), maxDistinctValues(150),
+                maxDatumsPerRequest(1000), maxRequestBytes(1024 * 1024), maxValuesPerDatum(150), flushIntervalMs(60000)
+            {
+            }
+
+            /**
+             * Client used to call PutMetricData. You are responsible for setting this.
+             * Calls are only ever made from the aggregator's background thread.
+             */
+            std::shared_ptr<Aws::CloudWatch::CloudWatchClient> client;
+            /**
+             * CloudWatch namespace every metric of this aggregator is published to. You are responsible for setting this.
+             */
+            Aws::String metricNamespace;
+            /**
+             * StorageResolution of the published datums: 60 for standard resolution, 1 for high resolution.
+             */
+            int storageResolution;
+            /**
+             * Number of shards values are recorded into. Threads are spread over the shards by thread id so that
+             * concurrent writers rarely share a lock. 0 means one shard per hardware thread.
+             */
+            size_t shardCount;
+            /**
+             * Maximum number of distinct metrics (name, dimensions) the aggregator will track.
+             * RegisterMetric returns INVALID_METRIC_ID once the limit is reached.
+             */
+            size_t maxSeries;
+            /**
+             * Maximum number of distinct values a histogram keeps per shard and flush interval. Values beyond that are
+             * still accounted for, but are published as an additional StatisticSet datum instead of Values/Counts.
+             */
+            size_t maxDistinctValues;
+            /**
+             * Maximum number of MetricData entries per PutMetricData call. The service maximum is 1,000.
+             */
+            size_t maxDatumsPerRequest;
+            /**
+             * Upper bound on the estimated size of a PutMetricData request. The service maximum is 1 MB.
+             */
+            size_t maxRequestBytes;
+            /**
+             * Maximum number of entries in the Values/Counts arrays of a single datum. The service maximum is 150.
+             */
+            size_t maxValuesPerDatum;
+            /**
+             * How often aggregated metrics are published.
+             */
+            long flushIntervalMs;
+        };
+
+        /**
+         * Point in time counters of a MetricsAggregator.
+         */
+        struct MetricsAggregatorStatistics
+        {
+            MetricsAggregatorStatistics() :
+                seriesRegistered(0), seriesRejected(0), valuesOverflowed(0), datumsSent(0), datumsFailed(0), requestsSent(0), requestsFailed(0)
+            {
+            }
+
+            /** Distinct metrics currently tracked. */
+            uint64_t seriesRegistered;
+            /** RegisterMetric calls refused because maxSeries was reached. */
+            uint64_t seriesRejected;
+            /** Histogram values published through the overflow StatisticSet because maxDistinctValues was reached. */
+            uint64_t valuesOverflowed;
+            /** Datums accepted by CloudWatch. */
+            uint64_t datumsSent;
+            /** Datums discarded after a failed PutMetricData call. */
+            uint64_t datumsFailed;
+            /** Successful PutMetricData calls. */
+            uint64_t requestsSent;
+            /** Failed PutMetricData calls. */
+            uint64_t requestsFailed;
+        };
+
+        /**
+         * Aggregates metrics client side and publishes them to CloudWatch with as few PutMetricData calls as possible.
+         *
+         * Metrics are registered once; the name, dimensions and unit are interned and identified by a MetricId from then on,
+         * so recording a value involves no string handling. Values are recorded into per thread shards, each guarded by its
+         * own lock, and folded together by a background thread every flush interval. The resulting datums are packed into
+         * requests up to maxDatumsPerRequest entries and maxRequestBytes. Memory is bounded by maxSeries and maxDistinctValues.
+         */
+        class AWS_CLOUDWATCH_METRICS_API MetricsAggregator
+        {
+        public:
+            MetricsAggregator(const MetricsAggregatorConfiguration& config);
+
+            /**
+             * Publishes whatever is still aggregated, then stops the background thread.
+             */
+            ~MetricsAggregator();
+
+            MetricsAggregator(const MetricsAggregator&) = delete;
+            MetricsAggregator& operator=(const MetricsAggregator&) = delete;
+
+            /**
+             * Returns the id of the metric identified by metricName and dimensions, registering it if needed.
+             * The order of dimensions does not matter. Returns INVALID_METRIC_ID if maxSeries metrics are already registered,
+             * or if the metric was registered before with a different kind or unit.
+             */
+            MetricId RegisterMetric(const Aws::String& metricName, MetricKind kind,
+                const Aws::Vector<Aws::CloudWatch::Model::Dimension>& dimensions = Aws::Vector<Aws::CloudWatch::Model::Dimension>(),
+                Aws::CloudWatch::Model::StandardUnit unit = Aws::CloudWatch::Model::StandardUnit::None);
+
+            /**
+             * Records value against metricId according to the kind the metric was registered with.
+             */
+            void Record(MetricId metricId, double value);
+
+            /**
+             * Blocks until everything recorded before the call has been published.
+             */
+            void Flush();
+
+            MetricsAggregatorStatistics GetStatistics() const;
+
+            /**
+             * Returns true when called from the aggregator's background thread. Monitoring implementations feeding this
+             * aggregator use it to leave out the aggregator's own PutMetricData calls.
+             */
+            bool IsAggregatorThread() const;
+
+            inline const MetricsAggregatorConfiguration& GetConfiguration() const { return m_config; }
+
+        private:
+            struct SeriesDefinition
+            {
+                Aws::String metricName;
+                std::shared_ptr<const Aws::Vector<Aws::CloudWatch::Model::Dimension>> dimensions;
+                Aws::CloudWatch::Model::StandardUnit unit;
+                MetricKind kind;
+            };
+
+            struct SeriesState
+            {
+                SeriesState() :
+                    sum(0), minimum(0), maximum(0), count(0), last(0), lastSequence(0),
+                    overflowSum(0), overflowMinimum(0), overflowMaximum(0), overflowCount(0)
+                {
+                }
+
+                void Merge(SeriesState&& other);
+
+                double sum;
+                double minimum;
+                double maximum;
+                double count;
+                double last;
+                uint64_t lastSequence;
+                Aws::Map<double, double> values;
+                double overflowSum;
+                double overflowMinimum;
+                double overflowMaximum;
+                double overflowCount;
+            };
+
+            struct Shard
+            {
+                std::mutex mutex;
+                Aws::Map<MetricId, SeriesState> series;
+            };
+
+            void Run();
+            void Publish();
+            void BuildDatums(const SeriesDefinition& definition, const SeriesState& state, const Aws::Utils::DateTime& timestamp,
+                Aws::Vector<Aws::CloudWatch::Model::MetricDatum>& datums) const;
+            void Send(Aws::Vector<Aws::CloudWatch::Model::MetricDatum>&& datums);
+            Shard& GetShard();
+
+            MetricsAggregatorConfiguration m_config;
+
+            // Sized to maxSeries up front and never resized, so recording threads can read a definition without locking.
+            Aws::Vector<Aws::UniquePtr<SeriesDefinition>> m_series;
+            Aws::Map<Aws::String, MetricId> m_seriesIds;
+            Aws::Map<Aws::String, std::shared_ptr<const Aws::Vector<Aws::CloudWatch::Model::Dimension>>> m_dimensionSets;
+            mutable Aws::Utils::Threading::ReaderWriterLock m_seriesLock;
+
+            Aws::Vector<Aws::UniquePtr<Shard>> m_shards;
+            std::atomic<uint64_t> m_gaugeSequence;
+
+            std::atomic<uint64_t> m_seriesRejected;
+            std::atomic<uint64_t> m_valuesOverflowed;
+            std::atomic<uint64_t> m_datumsSent;
+            std::atomic<uint64_t> m_datumsFailed;
+            std::atomic<uint64_t> m_requestsSent;
+            std::atomic<uint64_t> m_requestsFailed;
+
+            std::mutex m_signalMutex;
+            std::condition_variable m_signal;
+            std::condition_variable m_flushed;
+            uint64_t m_flushRequested;
+            uint64_t m_flushCompleted;
+            bool m_stopping;
+            std::thread m_thread;
+        };
+    }
+}
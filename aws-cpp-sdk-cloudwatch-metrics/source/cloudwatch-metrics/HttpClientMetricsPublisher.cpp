@@ -0,0 +1,111 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/cloudwatch-metrics/HttpClientMetricsPublisher.h>
+#include <aws/core/monitoring/HttpClientMetrics.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+
+using namespace Aws::Monitoring;
+using namespace Aws::CloudWatch::Model;
+
+namespace Aws
+{
+    namespace CloudWatchMetrics
+    {
+        static const char CLASS_TAG[] = "HttpClientMetricsPublisher";
+        static const char SERVICE_DIMENSION[] = "Service";
+        static const char OPERATION_DIMENSION[] = "Operation";
+        static const char REQUEST_FAILURES_METRIC[] = "RequestFailures";
+
+        static Aws::Vector<Dimension> MakeDimensions(const Aws::String& serviceName, const Aws::String& requestName)
+        {
+            Aws::Vector<Dimension> dimensions;
+            dimensions.push_back(Dimension().WithName(SERVICE_DIMENSION).WithValue(serviceName));
+            dimensions.push_back(Dimension().WithName(OPERATION_DIMENSION).WithValue(requestName));
+            return dimensions;
+        }
+
+        HttpClientMetricsPublisher::HttpClientMetricsPublisher(const std::shared_ptr<MetricsAggregator>& aggregator) :
+            m_aggregator(aggregator)
+        {
+        }
+
+        void* HttpClientMetricsPublisher::OnRequestStarted(const Aws::String&, const Aws::String&,
+            const std::shared_ptr<const Aws::Http::HttpRequest>&) const
+        {
+            return nullptr;
+        }
+
+        void HttpClientMetricsPublisher::OnRequestSucceeded(const Aws::String& serviceName, const Aws::String& requestName,
+            const std::shared_ptr<const Aws::Http::HttpRequest>&, const Aws::Client::HttpResponseOutcome&,
+            const CoreMetricsCollection& metricsFromCore, void*) const
+        {
+            RecordHttpClientMetrics(serviceName, requestName, metricsFromCore);
+        }
+
+        void HttpClientMetricsPublisher::OnRequestFailed(const Aws::String& serviceName, const Aws::String& requestName,
+            const std::shared_ptr<const Aws::Http::HttpRequest>&, const Aws::Client::HttpResponseOutcome&,
+            const CoreMetricsCollection& metricsFromCore, void*) const
+        {
+            if (m_aggregator->IsAggregatorThread())
+            {
+                return;
+            }
+
+            RecordHttpClientMetrics(serviceName, requestName, metricsFromCore);
+            m_aggregator->Record(m_aggregator->RegisterMetric(REQUEST_FAILURES_METRIC, MetricKind::Counter,
+                    MakeDimensions(serviceName, requestName), StandardUnit::Count), 1);
+        }
+
+        void HttpClientMetricsPublisher::OnRequestRetry(const Aws::String&, const Aws::String&,
+            const std::shared_ptr<const Aws::Http::HttpRequest>&, void*) const
+        {
+        }
+
+        void HttpClientMetricsPublisher::OnFinish(const Aws::String&, const Aws::String&,
+            const std::shared_ptr<const Aws::Http::HttpRequest>&, void*) const
+        {
+        }
+
+        void HttpClientMetricsPublisher::RecordHttpClientMetrics(const Aws::String& serviceName, const Aws::String& requestName,
+            const CoreMetricsCollection& metricsFromCore) const
+        {
+            // Recording the aggregator's own PutMetricData calls would keep it publishing forever.
+            if (m_aggregator->IsAggregatorThread() || metricsFromCore.httpClientMetrics.empty())
+            {
+                return;
+            }
+
+            Aws::Vector<Dimension> dimensions = MakeDimensions(serviceName, requestName);
+            for (const auto& metric : metricsFromCore.httpClientMetrics)
+            {
+                switch (GetHttpClientMetricTypeByName(metric.first))
+                {
+                    case HttpClientMetricsType::AcquireConnectionLatency:
+                    case HttpClientMetricsType::ConnectLatency:
+                    case HttpClientMetricsType::RequestLatency:
+                    case HttpClientMetricsType::DnsLatency:
+                    case HttpClientMetricsType::TcpLatency:
+                    case HttpClientMetricsType::SslLatency:
+                        m_aggregator->Record(m_aggregator->RegisterMetric(metric.first, MetricKind::Histogram, dimensions,
+                                StandardUnit::Milliseconds), static_cast<double>(metric.second));
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        HttpClientMetricsPublisherFactory::HttpClientMetricsPublisherFactory(const std::shared_ptr<MetricsAggregator>& aggregator) :
+            m_aggregator(aggregator)
+        {
+        }
+
+        Aws::UniquePtr<MonitoringInterface> HttpClientMetricsPublisherFactory::CreateMonitoringInstance() const
+        {
+            return Aws::MakeUnique<HttpClientMetricsPublisher>(CLASS_TAG, m_aggregator);
+        }
+    }
+}
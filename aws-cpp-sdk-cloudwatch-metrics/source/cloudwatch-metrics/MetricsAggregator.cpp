@@ -0,0 +1,444 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/cloudwatch-metrics/MetricsAggregator.h>
+#include <aws/core/utils/DateTime.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/monitoring/CloudWatchClient.h>
+#include <aws/monitoring/model/PutMetricDataRequest.h>
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+using namespace Aws::CloudWatch;
+using namespace Aws::CloudWatch::Model;
+using namespace Aws::Utils::Threading;
+
+namespace Aws
+{
+    namespace CloudWatchMetrics
+    {
+        static const char CLASS_TAG[] = "MetricsAggregator";
+
+        static const size_t MAX_DATUMS_PER_REQUEST = 1000;
+        static const size_t MAX_REQUEST_BYTES = 1024 * 1024;
+        static const size_t MAX_VALUES_PER_DATUM = 150;
+
+        // PutMetricData is a query protocol call, so every field is sent as "MetricData.member.N.<Field>=<value>&".
+        // These are generous upper bounds for the key and value of each kind of field, excluding user supplied strings.
+        static const size_t REQUEST_OVERHEAD_BYTES = 128;
+        static const size_t DATUM_OVERHEAD_BYTES = 512;
+        static const size_t DIMENSION_OVERHEAD_BYTES = 128;
+        static const size_t VALUE_OVERHEAD_BYTES = 128;
+
+        static size_t EstimateDatumBytes(const MetricDatum& datum)
+        {
+            size_t bytes = DATUM_OVERHEAD_BYTES + datum.GetMetricName().size();
+            for (const auto& dimension : datum.GetDimensions())
+            {
+                bytes += DIMENSION_OVERHEAD_BYTES + dimension.GetName().size() + dimension.GetValue().size();
+            }
+            return bytes + datum.GetValues().size() * VALUE_OVERHEAD_BYTES;
+        }
+
+        static bool DimensionLess(const Dimension& lhs, const Dimension& rhs)
+        {
+            return lhs.GetName() < rhs.GetName() || (lhs.GetName() == rhs.GetName() && lhs.GetValue() < rhs.GetValue());
+        }
+
+        void MetricsAggregator::SeriesState::Merge(SeriesState&& other)
+        {
+            if (other.count > 0)
+            {
+                minimum = count > 0 ? (std::min)(minimum, other.minimum) : other.minimum;
+                maximum = count > 0 ? (std::max)(maximum, other.maximum) : other.maximum;
+                sum += other.sum;
+                count += other.count;
+            }
+
+            if (other.lastSequence > lastSequence)
+            {
+                last = other.last;
+                lastSequence = other.lastSequence;
+            }
+
+            if (values.empty())
+            {
+                values.swap(other.values);
+            }
+            else
+            {
+                for (const auto& value : other.values)
+                {
+                    values[value.first] += value.second;
+                }
+            }
+
+            if (other.overflowCount > 0)
+            {
+                overflowMinimum = overflowCount > 0 ? (std::min)(overflowMinimum, other.overflowMinimum) : other.overflowMinimum;
+                overflowMaximum = overflowCount > 0 ? (std::max)(overflowMaximum, other.overflowMaximum) : other.overflowMaximum;
+                overflowSum += other.overflowSum;
+                overflowCount += other.overflowCount;
+            }
+        }
+
+        MetricsAggregator::MetricsAggregator(const MetricsAggregatorConfiguration& config) :
+            m_config(config), m_gaugeSequence(0),
+            m_seriesRejected(0), m_valuesOverflowed(0), m_datumsSent(0), m_datumsFailed(0), m_requestsSent(0), m_requestsFailed(0),
+            m_flushRequested(0), m_flushCompleted(0), m_stopping(false)
+        {
+            assert(m_config.client);
+            m_config.maxDatumsPerRequest = (std::max)((std::min)(m_config.maxDatumsPerRequest, MAX_DATUMS_PER_REQUEST), static_cast<size_t>(1));
+            m_config.maxRequestBytes = (std::min)(m_config.maxRequestBytes, MAX_REQUEST_BYTES);
+            m_config.maxValuesPerDatum = (std::max)((std::min)(m_config.maxValuesPerDatum, MAX_VALUES_PER_DATUM), static_cast<size_t>(1));
+            m_config.maxDistinctValues = (std::max)(m_config.maxDistinctValues, static_cast<size_t>(1));
+            if (m_config.shardCount == 0)
+            {
+                m_config.shardCount = (std::max)(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1));
+            }
+
+            m_series.resize(m_config.maxSeries);
+            m_shards.reserve(m_config.shardCount);
+            for (size_t i = 0; i < m_config.shardCount; ++i)
+            {
+                m_shards.push_back(Aws::MakeUnique<Shard>(CLASS_TAG));
+            }
+
+            // Run takes this lock first, so IsAggregatorThread sees m_thread set on the aggregator thread.
+            std::lock_guard<std::mutex> locker(m_signalMutex);
+            m_thread = std::thread(&MetricsAggregator::Run, this);
+        }
+
+        MetricsAggregator::~MetricsAggregator()
+        {
+            {
+                std::lock_guard<std::mutex> locker(m_signalMutex);
+                m_stopping = true;
+            }
+            m_signal.notify_one();
+            if (m_thread.joinable())
+            {
+                m_thread.join();
+            }
+        }
+
+        MetricId MetricsAggregator::RegisterMetric(const Aws::String& metricName, MetricKind kind,
+            const Aws::Vector<Dimension>& dimensions, StandardUnit unit)
+        {
+            Aws::Vector<Dimension> sortedDimensions(dimensions);
+            std::sort(sortedDimensions.begin(), sortedDimensions.end(), DimensionLess);
+
+            // Control characters can't appear in metric names or dimensions, so they make unambiguous separators.
+            Aws::String dimensionsKey;
+            for (const auto& dimension : sortedDimensions)
+            {
+                dimensionsKey.append(dimension.GetName()).append(1, '\x1f').append(dimension.GetValue()).append(1, '\x1e');
+            }
+            Aws::String seriesKey(metricName);
+            seriesKey.append(1, '\x1d').append(dimensionsKey);
+
+            ReaderLockGuard guard(m_seriesLock);
+            auto found = m_seriesIds.find(seriesKey);
+            if (found == m_seriesIds.end())
+            {
+                guard.UpgradeToWriterLock();
+                found = m_seriesIds.find(seriesKey);
+            }
+
+            if (found != m_seriesIds.end())
+            {
+                const SeriesDefinition& definition = *m_series[found->second];
+                if (definition.kind != kind || definition.unit != unit)
+                {
+                    AWS_LOGSTREAM_ERROR(CLASS_TAG, "Metric " << metricName << " is already registered with a different kind or unit.");
+                    return INVALID_METRIC_ID;
+                }
+                return found->second;
+            }
+
+            if (m_seriesIds.size() >= m_config.maxSeries)
+            {
+                ++m_seriesRejected;
+                AWS_LOGSTREAM_WARN(CLASS_TAG, "Not registering metric " << metricName << ": the limit of "
+                        << m_config.maxSeries << " metrics has been reached.");
+                return INVALID_METRIC_ID;
+            }
+
+            auto& dimensionSet = m_dimensionSets[dimensionsKey];
+            if (!dimensionSet)
+            {
+                dimensionSet = Aws::MakeShared<Aws::Vector<Dimension>>(CLASS_TAG, std::move(sortedDimensions));
+            }
+
+            MetricId metricId = m_seriesIds.size();
+            auto definition = Aws::MakeUnique<SeriesDefinition>(CLASS_TAG);
+            definition->metricName = metricName;
+            definition->dimensions = dimensionSet;
+            definition->unit = unit;
+            definition->kind = kind;
+            m_series[metricId] = std::move(definition);
+            m_seriesIds.emplace(std::move(seriesKey), metricId);
+            return metricId;
+        }
+
+        void MetricsAggregator::Record(MetricId metricId, double value)
+        {
+            if (metricId >= m_series.size() || !m_series[metricId])
+            {
+                return;
+            }
+            MetricKind kind = m_series[metricId]->kind;
+
+            Shard& shard = GetShard();
+            std::lock_guard<std::mutex> locker(shard.mutex);
+            SeriesState& state = shard.series[metricId];
+            switch (kind)
+            {
+                case MetricKind::Counter:
+                    state.sum += value;
+                    state.count += 1;
+                    break;
+                case MetricKind::Gauge:
+                    state.last = value;
+                    state.lastSequence = ++m_gaugeSequence;
+                    break;
+                case MetricKind::Summary:
+                    state.minimum = state.count > 0 ? (std::min)(state.minimum, value) : value;
+                    state.maximum = state.count > 0 ? (std::max)(state.maximum, value) : value;
+                    state.sum += value;
+                    state.count += 1;
+                    break;
+                case MetricKind::Histogram:
+                    if (state.values.size() < m_config.maxDistinctValues || state.values.find(value) != state.values.end())
+                    {
+                        state.values[value] += 1;
+                    }
+                    else
+                    {
+                        state.overflowMinimum = state.overflowCount > 0 ? (std::min)(state.overflowMinimum, value) : value;
+                        state.overflowMaximum = state.overflowCount > 0 ? (std::max)(state.overflowMaximum, value) : value;
+                        state.overflowSum += value;
+                        state.overflowCount += 1;
+                        ++m_valuesOverflowed;
+                    }
+                    break;
+            }
+        }
+
+        void MetricsAggregator::Flush()
+        {
+            if (IsAggregatorThread())
+            {
+                return;
+            }
+
+            std::unique_lock<std::mutex> locker(m_signalMutex);
+            if (m_stopping)
+            {
+                return;
+            }
+            uint64_t target = ++m_flushRequested;
+            m_signal.notify_one();
+            m_flushed.wait(locker, [&]() { return m_flushCompleted >= target; });
+        }
+
+        MetricsAggregatorStatistics MetricsAggregator::GetStatistics() const
+        {
+            MetricsAggregatorStatistics statistics;
+            {
+                ReaderLockGuard guard(m_seriesLock);
+                statistics.seriesRegistered = m_seriesIds.size();
+            }
+            statistics.seriesRejected = m_seriesRejected.load();
+            statistics.valuesOverflowed = m_valuesOverflowed.load();
+            statistics.datumsSent = m_datumsSent.load();
+            statistics.datumsFailed = m_datumsFailed.load();
+            statistics.requestsSent = m_requestsSent.load();
+            statistics.requestsFailed = m_requestsFailed.load();
+            return statistics;
+        }
+
+        bool MetricsAggregator::IsAggregatorThread() const
+        {
+            return std::this_thread::get_id() == m_thread.get_id();
+        }
+
+        MetricsAggregator::Shard& MetricsAggregator::GetShard()
+        {
+            // Thread ids are often aligned addresses; mix the bits so that the low ones are usable.
+            uint64_t hash = static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdULL;
+            hash ^= hash >> 33;
+            return *m_shards[static_cast<size_t>(hash % m_shards.size())];
+        }
+
+        void MetricsAggregator::Run()
+        {
+            for (;;)
+            {
+                uint64_t flushTarget = 0;
+                bool stopping = false;
+                {
+                    std::unique_lock<std::mutex> locker(m_signalMutex);
+                    m_signal.wait_for(locker, std::chrono::milliseconds(m_config.flushIntervalMs), [this]()
+                    {
+                        return m_stopping || m_flushRequested != m_flushCompleted;
+                    });
+                    flushTarget = m_flushRequested;
+                    stopping = m_stopping;
+                }
+
+                Publish();
+
+                {
+                    std::lock_guard<std::mutex> locker(m_signalMutex);
+                    m_flushCompleted = flushTarget;
+                }
+                m_flushed.notify_all();
+
+                if (stopping)
+                {
+                    return;
+                }
+            }
+        }
+
+        void MetricsAggregator::Publish()
+        {
+            // Swap each shard out under its lock and fold it in afterwards, so recording threads only ever wait for a swap.
+            Aws::Map<MetricId, SeriesState> merged;
+            for (auto& shard : m_shards)
+            {
+                Aws::Map<MetricId, SeriesState> series;
+                {
+                    std::lock_guard<std::mutex> locker(shard->mutex);
+                    series.swap(shard->series);
+                }
+
+                if (merged.empty())
+                {
+                    merged.swap(series);
+                    continue;
+                }
+                for (auto& state : series)
+                {
+                    merged[state.first].Merge(std::move(state.second));
+                }
+            }
+
+            if (merged.empty())
+            {
+                return;
+            }
+
+            Aws::Utils::DateTime timestamp = Aws::Utils::DateTime::Now();
+            Aws::Vector<MetricDatum> datums;
+            datums.reserve(merged.size());
+            for (const auto& state : merged)
+            {
+                BuildDatums(*m_series[state.first], state.second, timestamp, datums);
+            }
+            Send(std::move(datums));
+        }
+
+        void MetricsAggregator::BuildDatums(const SeriesDefinition& definition, const SeriesState& state,
+            const Aws::Utils::DateTime& timestamp, Aws::Vector<MetricDatum>& datums) const
+        {
+            MetricDatum datum;
+            datum.SetMetricName(definition.metricName);
+            if (!definition.dimensions->empty())
+            {
+                datum.SetDimensions(*definition.dimensions);
+            }
+            datum.SetTimestamp(timestamp);
+            datum.SetUnit(definition.unit);
+            datum.SetStorageResolution(m_config.storageResolution);
+
+            switch (definition.kind)
+            {
+                case MetricKind::Counter:
+                    datum.SetValue(state.sum);
+                    datums.push_back(std::move(datum));
+                    return;
+                case MetricKind::Gauge:
+                    datum.SetValue(state.last);
+                    datums.push_back(std::move(datum));
+                    return;
+                case MetricKind::Summary:
+                    datum.SetStatisticValues(StatisticSet().WithSampleCount(state.count).WithSum(state.sum)
+                            .WithMinimum(state.minimum).WithMaximum(state.maximum));
+                    datums.push_back(std::move(datum));
+                    return;
+                case MetricKind::Histogram:
+                    break;
+            }
+
+            auto value = state.values.begin();
+            while (value != state.values.end())
+            {
+                MetricDatum histogram(datum);
+                Aws::Vector<double> values;
+                Aws::Vector<double> counts;
+                for (; value != state.values.end() && values.size() < m_config.maxValuesPerDatum; ++value)
+                {
+                    values.push_back(value->first);
+                    counts.push_back(value->second);
+                }
+                histogram.SetValues(std::move(values));
+                histogram.SetCounts(std::move(counts));
+                datums.push_back(std::move(histogram));
+            }
+
+            if (state.overflowCount > 0)
+            {
+                datum.SetStatisticValues(StatisticSet().WithSampleCount(state.overflowCount).WithSum(state.overflowSum)
+                        .WithMinimum(state.overflowMinimum).WithMaximum(state.overflowMaximum));
+                datums.push_back(std::move(datum));
+            }
+        }
+
+        void MetricsAggregator::Send(Aws::Vector<MetricDatum>&& datums)
+        {
+            auto datum = datums.begin();
+            while (datum != datums.end())
+            {
+                PutMetricDataRequest request;
+                request.SetNamespace(m_config.metricNamespace);
+
+                Aws::Vector<MetricDatum> batch;
+                size_t requestBytes = REQUEST_OVERHEAD_BYTES + m_config.metricNamespace.size();
+                for (; datum != datums.end() && batch.size() < m_config.maxDatumsPerRequest; ++datum)
+                {
+                    size_t datumBytes = EstimateDatumBytes(*datum);
+                    if (!batch.empty() && requestBytes + datumBytes > m_config.maxRequestBytes)
+                    {
+                        break;
+                    }
+                    requestBytes += datumBytes;
+                    batch.push_back(std::move(*datum));
+                }
+
+                size_t batchSize = batch.size();
+                request.SetMetricData(std::move(batch));
+                auto outcome = m_config.client->PutMetricData(request);
+                if (outcome.IsSuccess())
+                {
+                    ++m_requestsSent;
+                    m_datumsSent += batchSize;
+                }
+                else
+                {
+                    AWS_LOGSTREAM_ERROR(CLASS_TAG, "Failed to publish " << batchSize << " metric datums to namespace "
+                            << m_config.metricNamespace << ": " << outcome.GetError().GetMessage());
+                    ++m_requestsFailed;
+                    m_datumsFailed += batchSize;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,253 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/benchmarks/Benchmark.h>
+#include <aws/core/Aws.h>
+#include <aws/core/Version.h>
+#include <aws/core/platform/OSVersionInfo.h>
+#include <aws/core/utils/DateTime.h>
+#include <aws/core/utils/json/JsonSerializer.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+
+using namespace Aws::Benchmark;
+using namespace Aws::Utils;
+using namespace Aws::Utils::Json;
+
+static const uint64_t MAX_ITERATIONS = 1000000000;
+
+namespace Aws
+{
+    namespace Benchmark
+    {
+        std::vector<BenchmarkDefinition>& GetRegisteredBenchmarks()
+        {
+            static std::vector<BenchmarkDefinition> s_benchmarks;
+            return s_benchmarks;
+        }
+
+#if defined(_MSC_VER)
+        void UseCharPointer(const volatile char*)
+        {
+        }
+#endif
+    } // namespace Benchmark
+} // namespace Aws
+
+struct RunOptions
+{
+    RunOptions() : minTimeMs(500), repetitions(5), list(false) {}
+
+    std::string filter;
+    long minTimeMs;
+    long repetitions;
+    std::string jsonPath;
+    std::string label;
+    bool list;
+};
+
+struct BenchmarkResult
+{
+    std::string name;
+    uint64_t iterations;
+    std::vector<double> nanosPerOp;
+    uint64_t bytesPerIteration;
+};
+
+static void PrintUsage(const char* program)
+{
+    printf("Usage: %s [options]\n"
+           "  --filter=<text>       Only run benchmarks whose name contains text, e.g. --filter=Json/\n"
+           "  --min-time-ms=<ms>    Minimum duration of each repetition. Defaults to 500.\n"
+           "  --repetitions=<n>     Timed repetitions of each benchmark; the median is reported. Defaults to 5.\n"
+           "  --json=<path>         Also write the results as JSON to path, for comparison across commits.\n"
+           "  --label=<text>        Free-form label recorded in the JSON output, e.g. a commit id.\n"
+           "  --list                List the benchmarks and exit.\n", program);
+}
+
+static bool ParseOptions(int argc, char** argv, RunOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const size_t equals = arg.find('=');
+        const std::string name = arg.substr(0, equals);
+        const std::string value = equals == std::string::npos ? std::string() : arg.substr(equals + 1);
+        if (name == "--filter")
+        {
+            options.filter = value;
+        }
+        else if (name == "--min-time-ms")
+        {
+            options.minTimeMs = std::strtol(value.c_str(), nullptr, 10);
+        }
+        else if (name == "--repetitions")
+        {
+            options.repetitions = std::strtol(value.c_str(), nullptr, 10);
+        }
+        else if (name == "--json")
+        {
+            options.jsonPath = value;
+        }
+        else if (name == "--label")
+        {
+            options.label = value;
+        }
+        else if (name == "--list")
+        {
+            options.list = true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return options.minTimeMs > 0 && options.repetitions > 0;
+}
+
+static BenchmarkResult Measure(const BenchmarkDefinition& benchmark, const RunOptions& options)
+{
+    const double minTimeNs = options.minTimeMs * 1e6;
+
+    // Grow the iteration count until one run lasts minTime; the last calibration run doubles as warm-up.
+    uint64_t iterations = 1;
+    for (;;)
+    {
+        BenchmarkState state(iterations);
+        benchmark.function(state);
+        const double elapsedNs = static_cast<double>(state.GetElapsed().count());
+        if (elapsedNs >= minTimeNs || iterations >= MAX_ITERATIONS)
+        {
+            break;
+        }
+        double multiplier = elapsedNs > 0 ? 1.4 * minTimeNs / elapsedNs : 10.0;
+        multiplier = (std::min)((std::max)(multiplier, 2.0), 10.0);
+        iterations = (std::min)(static_cast<uint64_t>(static_cast<double>(iterations) * multiplier), MAX_ITERATIONS);
+    }
+
+    BenchmarkResult result;
+    result.name = benchmark.name;
+    result.iterations = iterations;
+    result.bytesPerIteration = 0;
+    for (long repetition = 0; repetition < options.repetitions; ++repetition)
+    {
+        BenchmarkState state(iterations);
+        benchmark.function(state);
+        result.nanosPerOp.push_back(static_cast<double>(state.GetElapsed().count()) / static_cast<double>(iterations));
+        result.bytesPerIteration = state.GetBytesPerIteration();
+    }
+    std::sort(result.nanosPerOp.begin(), result.nanosPerOp.end());
+    return result;
+}
+
+static double Median(const std::vector<double>& sorted)
+{
+    const size_t middle = sorted.size() / 2;
+    return sorted.size() % 2 ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2;
+}
+
+static double BytesPerSecond(const BenchmarkResult& result)
+{
+    return result.bytesPerIteration * 1e9 / Median(result.nanosPerOp);
+}
+
+static void WriteJson(const std::vector<BenchmarkResult>& results, const RunOptions& options)
+{
+    JsonValue context;
+    context.WithString("sdkVersion", Aws::Version::GetVersionString())
+           .WithString("compiler", Aws::Version::GetCompilerVersionString())
+           .WithString("os", Aws::OSVersionInfo::ComputeOSVersionString())
+           .WithInteger("hardwareConcurrency", static_cast<int>(std::thread::hardware_concurrency()))
+#ifdef NDEBUG
+           .WithString("buildType", "Release")
+#else
+           .WithString("buildType", "Debug")
+#endif
+           .WithString("date", DateTime::Now().ToGmtString(DateFormat::ISO_8601))
+           .WithString("label", options.label.c_str())
+           .WithInt64("minTimeMs", options.minTimeMs)
+           .WithInt64("repetitions", options.repetitions);
+
+    Array<JsonValue> benchmarks(results.size());
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchmarkResult& result = results[i];
+        benchmarks[i].WithString("name", result.name.c_str())
+                     .WithInt64("iterations", static_cast<long long>(result.iterations))
+                     .WithDouble("nsPerOp", Median(result.nanosPerOp))
+                     .WithDouble("nsPerOpMin", result.nanosPerOp.front())
+                     .WithDouble("nsPerOpMax", result.nanosPerOp.back());
+        if (result.bytesPerIteration)
+        {
+            benchmarks[i].WithDouble("bytesPerSecond", BytesPerSecond(result));
+        }
+    }
+
+    JsonValue report;
+    report.WithObject("context", std::move(context)).WithArray("benchmarks", std::move(benchmarks));
+
+    std::ofstream output(options.jsonPath.c_str(), std::ios::out | std::ios::trunc);
+    output << report.View().WriteReadable() << std::endl;
+}
+
+static int RunBenchmarks(const RunOptions& options)
+{
+    std::vector<BenchmarkResult> results;
+    printf("%-48s %14s %12s %12s\n", "Benchmark", "Iterations", "ns/op", "MB/s");
+    for (const auto& benchmark : GetRegisteredBenchmarks())
+    {
+        if (benchmark.name.find(options.filter) == std::string::npos)
+        {
+            continue;
+        }
+        BenchmarkResult result = Measure(benchmark, options);
+        if (result.bytesPerIteration)
+        {
+            printf("%-48s %14llu %12.1f %12.1f\n", result.name.c_str(), static_cast<unsigned long long>(result.iterations),
+                   Median(result.nanosPerOp), BytesPerSecond(result) / (1024 * 1024));
+        }
+        else
+        {
+            printf("%-48s %14llu %12.1f %12s\n", result.name.c_str(), static_cast<unsigned long long>(result.iterations),
+                   Median(result.nanosPerOp), "");
+        }
+        fflush(stdout);
+        results.push_back(result);
+    }
+
+    if (!options.jsonPath.empty())
+    {
+        WriteJson(results, options);
+    }
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    RunOptions runOptions;
+    if (!ParseOptions(argc, argv, runOptions))
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    if (runOptions.list)
+    {
+        for (const auto& benchmark : GetRegisteredBenchmarks())
+        {
+            printf("%s\n", benchmark.name.c_str());
+        }
+        return 0;
+    }
+
+    Aws::SDKOptions options;
+    Aws::InitAPI(options);
+    int exitCode = RunBenchmarks(runOptions);
+    Aws::ShutdownAPI(options);
+    return exitCode;
+}
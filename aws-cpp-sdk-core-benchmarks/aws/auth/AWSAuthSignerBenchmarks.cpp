@@ -0,0 +1,56 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/benchmarks/Benchmark.h>
+#include <aws/core/auth/AWSAuthSigner.h>
+#include <aws/core/auth/AWSCredentialsProvider.h>
+#include <aws/core/http/HttpClientFactory.h>
+#include <aws/core/http/HttpRequest.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+
+using namespace Aws::Auth;
+using namespace Aws::Client;
+using namespace Aws::Http;
+using namespace Aws::Benchmark;
+
+static const char ALLOCATION_TAG[] = "AWSAuthSignerBenchmarks";
+
+static std::shared_ptr<AWSCredentialsProvider> CreateCredentialsProvider()
+{
+    return Aws::MakeShared<SimpleAWSCredentialsProvider>(ALLOCATION_TAG, "AKIDEXAMPLE", "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY");
+}
+
+AWS_BENCHMARK(SigV4, SignGetRequest)
+{
+    AWSAuthV4Signer signer(CreateCredentialsProvider(), "s3", "us-west-2", AWSAuthV4Signer::PayloadSigningPolicy::Never, false);
+    auto request = CreateHttpRequest(Aws::String("https://examplebucket.s3.us-west-2.amazonaws.com/photos/2021/03/photo.jpg?versionId=3HL4kqtJlcpXroDTDmJ"),
+                                     HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    request->SetHeaderValue("x-amz-request-payer", "requester");
+    request->SetHeaderValue("range", "bytes=0-1048575");
+
+    while (state.KeepRunning())
+    {
+        DoNotOptimize(signer.SignRequest(*request));
+    }
+}
+
+AWS_BENCHMARK(SigV4, SignPostRequestWithBody)
+{
+    AWSAuthV4Signer signer(CreateCredentialsProvider(), "dynamodb", "us-east-1", AWSAuthV4Signer::PayloadSigningPolicy::Always);
+    auto request = CreateHttpRequest(Aws::String("https://dynamodb.us-east-1.amazonaws.com/"),
+                                     HttpMethod::HTTP_POST, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    auto body = Aws::MakeShared<Aws::StringStream>(ALLOCATION_TAG);
+    *body << "{\"TableName\":\"Music\",\"Item\":{\"Artist\":{\"S\":\"No One You Know\"},\"SongTitle\":{\"S\":\"Call Me Today\"},\"Payload\":{\"S\":\""
+          << Aws::String(1024, 'x') << "\"}}}";
+    request->AddContentBody(body);
+    request->SetContentType("application/x-amz-json-1.0");
+    request->SetHeaderValue("x-amz-target", "DynamoDB_20120810.PutItem");
+    state.SetBytesPerIteration(body->str().size());
+
+    while (state.KeepRunning())
+    {
+        DoNotOptimize(signer.SignRequest(*request));
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/benchmarks/Benchmark.h>
+#include <aws/core/http/URI.h>
+#include <aws/core/utils/StringUtils.h>
+
+using namespace Aws::Http;
+using namespace Aws::Utils;
+using namespace Aws::Benchmark;
+
+static const char S3_URI[] = "https://examplebucket.s3.us-west-2.amazonaws.com/photos/2021/03/my%20holiday%20photo.jpg"
+                             "?versionId=3HL4kqtJlcpXroDTDmJ&response-content-type=image%2Fjpeg&partNumber=2";
+
+AWS_BENCHMARK(URI, Parse)
+{
+    while (state.KeepRunning())
+    {
+        URI uri(S3_URI);
+        DoNotOptimize(uri.GetPort());
+    }
+}
+
+AWS_BENCHMARK(URI, ParseAndWrite)
+{
+    while (state.KeepRunning())
+    {
+        URI uri(S3_URI);
+        Aws::String uriString = uri.GetURIString();
+        DoNotOptimize(uriString.data());
+    }
+}
+
+AWS_BENCHMARK(URI, URLEncodePath)
+{
+    const Aws::String path = "/photos/2021/03/my holiday photo (1) + copy & more ~ stuff.jpg";
+    state.SetBytesPerIteration(path.size());
+
+    while (state.KeepRunning())
+    {
+        Aws::String encoded = URI::URLEncodePath(path);
+        DoNotOptimize(encoded.data());
+    }
+}
+
+AWS_BENCHMARK(URI, URLEncodeQueryValue)
+{
+    const Aws::String value = "arn:aws:sns:us-east-1:123456789012:my-topic/with spaces?and=reserved&characters";
+    state.SetBytesPerIteration(value.size());
+
+    while (state.KeepRunning())
+    {
+        Aws::String encoded = StringUtils::URLEncode(value.c_str());
+        DoNotOptimize(encoded.data());
+    }
+}
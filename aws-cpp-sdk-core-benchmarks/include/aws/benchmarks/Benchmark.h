@@ -0,0 +1,128 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Aws
+{
+    namespace Benchmark
+    {
+        /**
+         * Passed to a benchmark function, which repeats the operation it measures while KeepRunning returns true:
+         *
+         *     AWS_BENCHMARK(Group, Name)
+         *     {
+         *         // setup, not timed
+         *         while (state.KeepRunning())
+         *         {
+         *             // operation
+         *         }
+         *     }
+         *
+         * The clock starts at the first call to KeepRunning and stops at the call that returns false.
+         */
+        class BenchmarkState
+        {
+        public:
+            explicit BenchmarkState(uint64_t iterations) :
+                m_iterations(iterations), m_remaining(iterations), m_started(false), m_bytesPerIteration(0), m_elapsed(0)
+            {
+            }
+
+            inline bool KeepRunning()
+            {
+                if (!m_started)
+                {
+                    m_started = true;
+                    m_start = std::chrono::steady_clock::now();
+                }
+                if (m_remaining > 0)
+                {
+                    --m_remaining;
+                    return true;
+                }
+                m_elapsed = std::chrono::steady_clock::now() - m_start;
+                return false;
+            }
+
+            uint64_t GetIterations() const { return m_iterations; }
+
+            /**
+             * Bytes the operation processes each time, for reporting throughput. Optional.
+             */
+            void SetBytesPerIteration(uint64_t bytes) { m_bytesPerIteration = bytes; }
+            uint64_t GetBytesPerIteration() const { return m_bytesPerIteration; }
+
+            std::chrono::nanoseconds GetElapsed() const { return std::chrono::duration_cast<std::chrono::nanoseconds>(m_elapsed); }
+
+        private:
+            uint64_t m_iterations;
+            uint64_t m_remaining;
+            bool m_started;
+            uint64_t m_bytesPerIteration;
+            std::chrono::steady_clock::time_point m_start;
+            std::chrono::steady_clock::duration m_elapsed;
+        };
+
+        typedef void (*BenchmarkFunction)(BenchmarkState&);
+
+        struct BenchmarkDefinition
+        {
+            std::string name;
+            BenchmarkFunction function;
+        };
+
+        /**
+         * Benchmarks registered so far, in registration order. Registration happens during static initialization,
+         * before InitAPI, so this uses the standard allocator rather than the SDK's.
+         */
+        std::vector<BenchmarkDefinition>& GetRegisteredBenchmarks();
+
+        struct BenchmarkRegistrar
+        {
+            BenchmarkRegistrar(const char* name, BenchmarkFunction function)
+            {
+                BenchmarkDefinition definition;
+                definition.name = name;
+                definition.function = function;
+                GetRegisteredBenchmarks().push_back(definition);
+            }
+        };
+
+        /**
+         * Keeps the compiler from discarding the computation of value as dead code.
+         */
+#if defined(_MSC_VER)
+        void UseCharPointer(const volatile char*);
+
+        template<typename T>
+        inline void DoNotOptimize(const T& value)
+        {
+            UseCharPointer(&reinterpret_cast<const volatile char&>(value));
+            _ReadWriteBarrier();
+        }
+#else
+        template<typename T>
+        inline void DoNotOptimize(const T& value)
+        {
+            asm volatile("" : : "r,m"(value) : "memory");
+        }
+#endif
+    } // namespace Benchmark
+} // namespace Aws
+
+#define AWS_BENCHMARK(group, name) \
+    static void AwsBenchmark_##group##_##name(Aws::Benchmark::BenchmarkState& state); \
+    static Aws::Benchmark::BenchmarkRegistrar s_awsBenchmarkRegistrar_##group##_##name(#group "/" #name, &AwsBenchmark_##group##_##name); \
+    static void AwsBenchmark_##group##_##name(Aws::Benchmark::BenchmarkState& state)
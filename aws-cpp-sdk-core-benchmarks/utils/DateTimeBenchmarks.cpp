@@ -0,0 +1,54 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/benchmarks/Benchmark.h>
+#include <aws/core/utils/DateTime.h>
+
+using namespace Aws::Utils;
+using namespace Aws::Benchmark;
+
+AWS_BENCHMARK(DateTime, ParseISO8601)
+{
+    const Aws::String date = "2021-03-04T05:06:07.123Z";
+
+    while (state.KeepRunning())
+    {
+        DateTime dateTime(date, DateFormat::ISO_8601);
+        DoNotOptimize(dateTime.Millis());
+    }
+}
+
+AWS_BENCHMARK(DateTime, ParseRFC822)
+{
+    const Aws::String date = "Thu, 04 Mar 2021 05:06:07 GMT";
+
+    while (state.KeepRunning())
+    {
+        DateTime dateTime(date, DateFormat::RFC822);
+        DoNotOptimize(dateTime.Millis());
+    }
+}
+
+AWS_BENCHMARK(DateTime, ParseAutoDetect)
+{
+    const Aws::String date = "Thu, 04 Mar 2021 05:06:07 GMT";
+
+    while (state.KeepRunning())
+    {
+        DateTime dateTime(date, DateFormat::AutoDetect);
+        DoNotOptimize(dateTime.Millis());
+    }
+}
+
+AWS_BENCHMARK(DateTime, FormatISO8601)
+{
+    const DateTime dateTime(static_cast<int64_t>(1614834367123));
+
+    while (state.KeepRunning())
+    {
+        Aws::String date = dateTime.ToGmtString(DateFormat::ISO_8601);
+        DoNotOptimize(date.data());
+    }
+}
@@ -0,0 +1,140 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/benchmarks/Benchmark.h>
+#include <aws/core/utils/HashingUtils.h>
+
+using namespace Aws::Utils;
+using namespace Aws::Benchmark;
+
+static const size_t SMALL_SIZE = 64;
+static const size_t LARGE_SIZE = 1024 * 1024;
+
+static ByteBuffer CreateBuffer(size_t size)
+{
+    ByteBuffer buffer(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        buffer[i] = static_cast<unsigned char>(i * 31 + 7);
+    }
+    return buffer;
+}
+
+static void Base64EncodeBenchmark(BenchmarkState& state, size_t size)
+{
+    const ByteBuffer buffer = CreateBuffer(size);
+    state.SetBytesPerIteration(size);
+
+    while (state.KeepRunning())
+    {
+        Aws::String encoded = HashingUtils::Base64Encode(buffer);
+        DoNotOptimize(encoded.data());
+    }
+}
+
+static void Base64DecodeBenchmark(BenchmarkState& state, size_t size)
+{
+    const Aws::String encoded = HashingUtils::Base64Encode(CreateBuffer(size));
+    state.SetBytesPerIteration(size);
+
+    while (state.KeepRunning())
+    {
+        ByteBuffer decoded = HashingUtils::Base64Decode(encoded);
+        DoNotOptimize(decoded.GetUnderlyingData());
+    }
+}
+
+AWS_BENCHMARK(Base64, EncodeSmall)
+{
+    Base64EncodeBenchmark(state, SMALL_SIZE);
+}
+
+AWS_BENCHMARK(Base64, EncodeLarge)
+{
+    Base64EncodeBenchmark(state, LARGE_SIZE);
+}
+
+AWS_BENCHMARK(Base64, DecodeSmall)
+{
+    Base64DecodeBenchmark(state, SMALL_SIZE);
+}
+
+AWS_BENCHMARK(Base64, DecodeLarge)
+{
+    Base64DecodeBenchmark(state, LARGE_SIZE);
+}
+
+AWS_BENCHMARK(Hex, EncodeLarge)
+{
+    const ByteBuffer buffer = CreateBuffer(LARGE_SIZE);
+    state.SetBytesPerIteration(LARGE_SIZE);
+
+    while (state.KeepRunning())
+    {
+        Aws::String encoded = HashingUtils::HexEncode(buffer);
+        DoNotOptimize(encoded.data());
+    }
+}
+
+AWS_BENCHMARK(Hashing, SHA256Small)
+{
+    const Aws::String data(SMALL_SIZE, 'a');
+    state.SetBytesPerIteration(SMALL_SIZE);
+
+    while (state.KeepRunning())
+    {
+        ByteBuffer digest = HashingUtils::CalculateSHA256(data);
+        DoNotOptimize(digest.GetUnderlyingData());
+    }
+}
+
+AWS_BENCHMARK(Hashing, SHA256Large)
+{
+    const Aws::String data(LARGE_SIZE, 'a');
+    state.SetBytesPerIteration(LARGE_SIZE);
+
+    while (state.KeepRunning())
+    {
+        ByteBuffer digest = HashingUtils::CalculateSHA256(data);
+        DoNotOptimize(digest.GetUnderlyingData());
+    }
+}
+
+AWS_BENCHMARK(Hashing, SHA256HMAC)
+{
+    const ByteBuffer data = CreateBuffer(SMALL_SIZE);
+    const ByteBuffer secret = CreateBuffer(32);
+    state.SetBytesPerIteration(SMALL_SIZE);
+
+    while (state.KeepRunning())
+    {
+        ByteBuffer digest = HashingUtils::CalculateSHA256HMAC(data, secret);
+        DoNotOptimize(digest.GetUnderlyingData());
+    }
+}
+
+AWS_BENCHMARK(Hashing, MD5Large)
+{
+    const Aws::String data(LARGE_SIZE, 'a');
+    state.SetBytesPerIteration(LARGE_SIZE);
+
+    while (state.KeepRunning())
+    {
+        ByteBuffer digest = HashingUtils::CalculateMD5(data);
+        DoNotOptimize(digest.GetUnderlyingData());
+    }
+}
+
+AWS_BENCHMARK(Hashing, CRC32CLarge)
+{
+    const Aws::String data(LARGE_SIZE, 'a');
+    state.SetBytesPerIteration(LARGE_SIZE);
+
+    while (state.KeepRunning())
+    {
+        ByteBuffer digest = HashingUtils::CalculateCRC32C(data);
+        DoNotOptimize(digest.GetUnderlyingData());
+    }
+}
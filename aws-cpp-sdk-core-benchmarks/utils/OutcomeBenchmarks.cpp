@@ -0,0 +1,44 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/benchmarks/Benchmark.h>
+#include <aws/core/client/AWSClient.h>
+#include <aws/core/client/AWSError.h>
+#include <aws/core/client/CoreErrors.h>
+#include <aws/core/utils/Outcome.h>
+#include <aws/core/utils/json/JsonSerializer.h>
+
+using namespace Aws;
+using namespace Aws::Client;
+using namespace Aws::Benchmark;
+
+// What a successful JSON call does with its outcome: builds it, moves it out of the client, and copies it once, as
+// async handlers and Callable futures do.
+AWS_BENCHMARK(Outcome, SuccessMoveAndCopy)
+{
+    Http::HeaderValueCollection headers;
+    headers["x-amzn-requestid"] = "0123456789ABCDEF";
+
+    while (state.KeepRunning())
+    {
+        JsonOutcome outcome(AmazonWebServiceResult<Utils::Json::JsonValue>(Utils::Json::JsonValue(), headers));
+        JsonOutcome moved(std::move(outcome));
+        JsonOutcome copy(moved);
+        DoNotOptimize(copy.IsSuccess());
+    }
+}
+
+AWS_BENCHMARK(Outcome, FailureMoveAndCopy)
+{
+    const AWSError<CoreErrors> error(CoreErrors::THROTTLING, "ThrottlingException", "Rate exceeded", true);
+
+    while (state.KeepRunning())
+    {
+        JsonOutcome outcome(error);
+        JsonOutcome moved(std::move(outcome));
+        JsonOutcome copy(moved);
+        DoNotOptimize(copy.IsSuccess());
+    }
+}
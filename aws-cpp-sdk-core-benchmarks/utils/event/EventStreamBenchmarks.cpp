@@ -0,0 +1,78 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/benchmarks/Benchmark.h>
+#include <aws/core/auth/AWSAuthSigner.h>
+#include <aws/core/auth/AWSCredentialsProvider.h>
+#include <aws/core/utils/event/EventMessage.h>
+#include <aws/core/utils/event/EventStreamDecoder.h>
+#include <aws/core/utils/event/EventStreamEncoder.h>
+#include <aws/core/utils/event/EventStreamHandler.h>
+
+using namespace Aws::Client;
+using namespace Aws::Utils;
+using namespace Aws::Utils::Event;
+using namespace Aws::Benchmark;
+
+static const char ALLOCATION_TAG[] = "EventStreamBenchmarks";
+static const size_t PAYLOAD_SIZE = 1024;
+
+static Message CreateAudioEvent()
+{
+    Message message;
+    message.InsertEventHeader(":message-type", EventHeaderValue(Aws::String("event")));
+    message.InsertEventHeader(":event-type", EventHeaderValue(Aws::String("AudioEvent")));
+    message.InsertEventHeader(":content-type", EventHeaderValue(Aws::String("application/octet-stream")));
+    message.WriteEventPayload(Aws::String(PAYLOAD_SIZE, 'a'));
+    return message;
+}
+
+class CountingHandler : public EventStreamHandler
+{
+public:
+    CountingHandler() : m_events(0) {}
+
+    void OnEvent() override { ++m_events; }
+
+    size_t GetEvents() const { return m_events; }
+
+private:
+    size_t m_events;
+};
+
+// Encoding always signs each frame, as event-stream requests do.
+AWS_BENCHMARK(EventStream, EncodeAndSign)
+{
+    AWSAuthEventStreamV4Signer signer(Aws::MakeShared<Aws::Auth::SimpleAWSCredentialsProvider>(ALLOCATION_TAG,
+        "AKIDEXAMPLE", "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY"), "transcribe", "us-east-1");
+    EventStreamEncoder encoder(&signer);
+    encoder.SetSignatureSeed("7c8b8b5e0b1d6f2f1a9f3c2d4e5f60718293a4b5c6d7e8f90a1b2c3d4e5f6071");
+    const Message message = CreateAudioEvent();
+    state.SetBytesPerIteration(PAYLOAD_SIZE);
+
+    while (state.KeepRunning())
+    {
+        Aws::Vector<unsigned char> encoded = encoder.EncodeAndSign(message);
+        DoNotOptimize(encoded.data());
+    }
+}
+
+AWS_BENCHMARK(EventStream, Decode)
+{
+    AWSAuthEventStreamV4Signer signer(Aws::MakeShared<Aws::Auth::SimpleAWSCredentialsProvider>(ALLOCATION_TAG,
+        "AKIDEXAMPLE", "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY"), "transcribe", "us-east-1");
+    EventStreamEncoder encoder(&signer);
+    const Aws::Vector<unsigned char> encoded = encoder.EncodeAndSign(CreateAudioEvent());
+    const ByteBuffer frame(encoded.data(), encoded.size());
+    CountingHandler handler;
+    EventStreamDecoder decoder(&handler);
+    state.SetBytesPerIteration(encoded.size());
+
+    while (state.KeepRunning())
+    {
+        decoder.Pump(frame);
+    }
+    DoNotOptimize(handler.GetEvents());
+}
@@ -0,0 +1,79 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/benchmarks/Benchmark.h>
+#include <aws/core/utils/json/JsonSerializer.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+
+using namespace Aws::Utils::Json;
+using namespace Aws::Benchmark;
+
+// A DynamoDB Query response with itemCount items, the shape of a typical JSON protocol payload.
+static Aws::String CreateQueryResponse(size_t itemCount)
+{
+    Aws::StringStream ss;
+    ss << "{\"Count\":" << itemCount << ",\"ScannedCount\":" << itemCount << ",\"Items\":[";
+    for (size_t i = 0; i < itemCount; ++i)
+    {
+        ss << (i ? "," : "")
+           << "{\"Artist\":{\"S\":\"Artist " << i << "\"},"
+           << "\"SongTitle\":{\"S\":\"Song title number " << i << " with some \\\"escaped\\\" text\"},"
+           << "\"Year\":{\"N\":\"" << 1950 + i % 70 << "\"},"
+           << "\"Price\":{\"N\":\"" << i * 0.99 << "\"},"
+           << "\"Tags\":{\"SS\":[\"rock\",\"live\",\"remastered\"]},"
+           << "\"Available\":{\"BOOL\":" << (i % 2 ? "true" : "false") << "}}";
+    }
+    ss << "],\"LastEvaluatedKey\":{\"Artist\":{\"S\":\"Artist " << itemCount << "\"}}}";
+    return ss.str();
+}
+
+static void ParseBenchmark(BenchmarkState& state, size_t itemCount)
+{
+    const Aws::String json = CreateQueryResponse(itemCount);
+    state.SetBytesPerIteration(json.size());
+
+    while (state.KeepRunning())
+    {
+        JsonValue value(json);
+        DoNotOptimize(value.WasParseSuccessful());
+    }
+}
+
+AWS_BENCHMARK(Json, ParseSmall)
+{
+    ParseBenchmark(state, 1);
+}
+
+AWS_BENCHMARK(Json, ParseLarge)
+{
+    ParseBenchmark(state, 200);
+}
+
+AWS_BENCHMARK(Json, WriteCompact)
+{
+    const JsonValue value(CreateQueryResponse(200));
+    state.SetBytesPerIteration(value.View().WriteCompact().size());
+
+    while (state.KeepRunning())
+    {
+        Aws::String json = value.View().WriteCompact();
+        DoNotOptimize(json.data());
+    }
+}
+
+AWS_BENCHMARK(Json, BuildAndWrite)
+{
+    while (state.KeepRunning())
+    {
+        JsonValue item;
+        item.WithString("TableName", "Music")
+            .WithObject("Key", JsonValue().WithObject("Artist", JsonValue().WithString("S", "No One You Know"))
+                                          .WithObject("SongTitle", JsonValue().WithString("S", "Call Me Today")))
+            .WithString("ConsistentRead", "true")
+            .WithInteger("Limit", 25);
+        Aws::String json = item.View().WriteCompact();
+        DoNotOptimize(json.data());
+    }
+}
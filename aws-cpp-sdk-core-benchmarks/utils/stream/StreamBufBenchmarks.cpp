@@ -0,0 +1,120 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/benchmarks/Benchmark.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/stream/ConcurrentStreamBuf.h>
+#include <aws/core/utils/stream/PooledStreamBuf.h>
+#include <aws/core/utils/stream/SimpleStreamBuf.h>
+#include <thread>
+
+using namespace Aws::Utils::Stream;
+using namespace Aws::Benchmark;
+
+static const size_t CHUNK_SIZE = 4 * 1024;
+static const size_t TRANSFER_SIZE = 1024 * 1024;
+
+// Each iteration writes TRANSFER_SIZE bytes into a fresh stream in CHUNK_SIZE writes, then reads them back.
+AWS_BENCHMARK(StreamBuf, SimpleStreamBufWriteRead)
+{
+    const Aws::String chunk(CHUNK_SIZE, 'x');
+    char readBuffer[CHUNK_SIZE];
+    state.SetBytesPerIteration(TRANSFER_SIZE);
+
+    while (state.KeepRunning())
+    {
+        SimpleStreamBuf buf;
+        Aws::IOStream stream(&buf);
+        for (size_t written = 0; written < TRANSFER_SIZE; written += CHUNK_SIZE)
+        {
+            stream.write(chunk.data(), CHUNK_SIZE);
+        }
+        while (stream.read(readBuffer, CHUNK_SIZE))
+        {
+            DoNotOptimize(readBuffer[0]);
+        }
+    }
+}
+
+// Writes TRANSFER_SIZE bytes into buf in CHUNK_SIZE writes, the way the http client writes a response body, then
+// reads them back, the way a response parser does.
+static void WriteThenRead(std::streambuf& buf)
+{
+    static const Aws::String chunk(CHUNK_SIZE, 'x');
+    char readBuffer[CHUNK_SIZE];
+    Aws::IOStream stream(&buf);
+    for (size_t written = 0; written < TRANSFER_SIZE; written += CHUNK_SIZE)
+    {
+        stream.write(chunk.data(), CHUNK_SIZE);
+    }
+    while (stream.read(readBuffer, CHUNK_SIZE))
+    {
+        DoNotOptimize(readBuffer[0]);
+    }
+}
+
+// The buffer of response bodies before PooledStreamBuf.
+AWS_BENCHMARK(StreamBuf, StringBufWriteRead)
+{
+    state.SetBytesPerIteration(TRANSFER_SIZE);
+    while (state.KeepRunning())
+    {
+        Aws::StringBuf buf;
+        WriteThenRead(buf);
+    }
+}
+
+AWS_BENCHMARK(StreamBuf, PooledStreamBufWriteRead)
+{
+    state.SetBytesPerIteration(TRANSFER_SIZE);
+    while (state.KeepRunning())
+    {
+        PooledStreamBuf buf;
+        WriteThenRead(buf);
+    }
+}
+
+// As when the response has a Content-Length.
+AWS_BENCHMARK(StreamBuf, PooledStreamBufReservedWriteRead)
+{
+    state.SetBytesPerIteration(TRANSFER_SIZE);
+    while (state.KeepRunning())
+    {
+        PooledStreamBuf buf;
+        buf.Reserve(TRANSFER_SIZE);
+        WriteThenRead(buf);
+    }
+}
+
+// Each iteration streams TRANSFER_SIZE bytes from a writer thread to the benchmark thread, the way event-stream
+// requests hand their payload to the http client.
+AWS_BENCHMARK(StreamBuf, ConcurrentStreamBufProducerConsumer)
+{
+    const Aws::String chunk(CHUNK_SIZE, 'x');
+    char readBuffer[CHUNK_SIZE];
+    state.SetBytesPerIteration(TRANSFER_SIZE);
+
+    while (state.KeepRunning())
+    {
+        ConcurrentStreamBuf buf;
+        Aws::IOStream writer(&buf);
+        Aws::IOStream reader(&buf);
+        std::thread producer([&]()
+        {
+            for (size_t written = 0; written < TRANSFER_SIZE; written += CHUNK_SIZE)
+            {
+                writer.write(chunk.data(), CHUNK_SIZE);
+            }
+            writer.flush();
+            buf.SetEof();
+        });
+        while (reader.read(readBuffer, CHUNK_SIZE))
+        {
+            DoNotOptimize(readBuffer[0]);
+        }
+        producer.join();
+    }
+}
@@ -0,0 +1,57 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/benchmarks/Benchmark.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <atomic>
+#include <thread>
+
+using namespace Aws::Utils::Threading;
+using namespace Aws::Benchmark;
+
+static const size_t TASKS_PER_ITERATION = 64;
+
+// Each iteration submits a batch of empty tasks and waits until all of them ran, so the time covers the
+// submission, the hand-off to the workers and the completion.
+static void SubmitBenchmark(BenchmarkState& state, Executor& executor)
+{
+    std::atomic<size_t> completed(0);
+    size_t submitted = 0;
+
+    while (state.KeepRunning())
+    {
+        for (size_t i = 0; i < TASKS_PER_ITERATION; ++i)
+        {
+            if (executor.Submit([&completed]() { completed.fetch_add(1, std::memory_order_relaxed); }))
+            {
+                ++submitted;
+            }
+        }
+        while (completed.load() < submitted)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+AWS_BENCHMARK(Executor, PooledThreadExecutorSubmit64)
+{
+    PooledThreadExecutor executor(4);
+    SubmitBenchmark(state, executor);
+}
+
+AWS_BENCHMARK(Executor, SharedThreadPoolSubmit64)
+{
+    // Same thread count as the PooledThreadExecutor, and room for a whole batch.
+    SharedThreadPool pool(4, TASKS_PER_ITERATION);
+    auto executor = pool.CreateExecutor();
+    SubmitBenchmark(state, *executor);
+}
+
+AWS_BENCHMARK(Executor, DefaultExecutorSubmit64)
+{
+    DefaultExecutor executor;
+    SubmitBenchmark(state, executor);
+}
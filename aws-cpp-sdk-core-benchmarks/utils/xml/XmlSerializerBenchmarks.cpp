@@ -0,0 +1,70 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/benchmarks/Benchmark.h>
+#include <aws/core/utils/xml/XmlSerializer.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+
+using namespace Aws::Utils::Xml;
+using namespace Aws::Benchmark;
+
+// An S3 ListObjectsV2 response with keyCount keys, the shape of a typical REST-XML payload.
+static Aws::String CreateListObjectsResponse(size_t keyCount)
+{
+    Aws::StringStream ss;
+    ss << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+       << "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+       << "<Name>examplebucket</Name><Prefix>photos/</Prefix><KeyCount>" << keyCount << "</KeyCount>"
+       << "<MaxKeys>1000</MaxKeys><IsTruncated>false</IsTruncated>";
+    for (size_t i = 0; i < keyCount; ++i)
+    {
+        ss << "<Contents><Key>photos/2021/03/photo-" << i << ".jpg</Key>"
+           << "<LastModified>2021-03-04T05:06:07.000Z</LastModified>"
+           << "<ETag>&quot;599bab3ed2c697f1d26842727561fd9" << i % 10 << "&quot;</ETag>"
+           << "<Size>" << 1024 * i << "</Size><StorageClass>STANDARD</StorageClass></Contents>";
+    }
+    ss << "</ListBucketResult>";
+    return ss.str();
+}
+
+static void ParseBenchmark(BenchmarkState& state, size_t keyCount)
+{
+    const Aws::String xml = CreateListObjectsResponse(keyCount);
+    state.SetBytesPerIteration(xml.size());
+
+    while (state.KeepRunning())
+    {
+        XmlDocument document = XmlDocument::CreateFromXmlString(xml);
+        DoNotOptimize(document.WasParseSuccessful());
+    }
+}
+
+AWS_BENCHMARK(Xml, ParseSmall)
+{
+    ParseBenchmark(state, 1);
+}
+
+AWS_BENCHMARK(Xml, ParseLarge)
+{
+    ParseBenchmark(state, 200);
+}
+
+AWS_BENCHMARK(Xml, ParseAndReadKeys)
+{
+    const Aws::String xml = CreateListObjectsResponse(200);
+    state.SetBytesPerIteration(xml.size());
+
+    while (state.KeepRunning())
+    {
+        XmlDocument document = XmlDocument::CreateFromXmlString(xml);
+        XmlNode contents = document.GetRootElement().FirstChild("Contents");
+        while (!contents.IsNull())
+        {
+            Aws::String key = contents.FirstChild("Key").GetText();
+            DoNotOptimize(key.data());
+            contents = contents.NextNode("Contents");
+        }
+    }
+}
@@ -7,6 +7,10 @@
 #include <aws/core/http/standard/StandardHttpRequest.h>
 #include <aws/core/http/standard/StandardHttpResponse.h>
 #include <aws/core/http/HttpClientFactory.h>
+#include <aws/core/client/HedgingPolicy.h>
+#include <aws/core/client/ResponseCache.h>
+#include <aws/core/utils/ratelimiter/AdaptiveRateLimiter.h>
+#include <aws/core/utils/threading/Executor.h>
 #include <aws/core/utils/HashingUtils.h>
 #include <aws/core/utils/Outcome.h>
 #include <aws/core/Globals.h>
@@ -18,7 +22,10 @@
 #include <aws/core/auth/AWSCredentialsProvider.h>
 #include <aws/core/platform/Environment.h>
 #include <aws/core/auth/AWSCredentialsProvider.h>
+#include <atomic>
 #include <fstream>
+#include <limits>
+#include <mutex>
 #include <thread>
 #include <aws/core/utils/logging/LogMacros.h>
 
@@ -58,6 +65,105 @@ protected:
     }
 };
 
+/**
+ * Answers requests at once, except the one after StallNextRequest(), which waits until it is cancelled or for up to
+ * maxStall, after sending an early chunk of its response if one is given. Bodies are reported to the data received
+ * handler of the request. Safe to call from several threads, unlike MockHttpClient.
+ */
+class StallingHttpClient : public MockHttpClient
+{
+public:
+    StallingHttpClient(std::chrono::milliseconds maxStall) :
+        m_maxStall(maxStall), m_stallNext(false), m_earlyCode(HttpResponseCode::OK), m_cancelledRequests(0) {}
+
+    std::shared_ptr<HttpResponse> MakeRequest(const std::shared_ptr<HttpRequest>& request,
+        Aws::Utils::RateLimits::RateLimiterInterface*, Aws::Utils::RateLimits::RateLimiterInterface*) const override
+    {
+        bool stall = false;
+        Aws::String earlyChunk;
+        HttpResponseCode earlyCode = HttpResponseCode::OK;
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            std::swap(stall, m_stallNext);
+            if (stall)
+            {
+                std::swap(earlyChunk, m_earlyChunk);
+                earlyCode = m_earlyCode;
+            }
+        }
+
+        auto response = Aws::MakeShared<StandardHttpResponse>(ALLOCATION_TAG, request);
+        if (stall)
+        {
+            if (!earlyChunk.empty())
+            {
+                response->SetResponseCode(earlyCode);
+                WriteBody(*request, *response, earlyChunk);
+            }
+            auto stallUntil = std::chrono::steady_clock::now() + m_maxStall;
+            while (ContinueRequest(*request) && std::chrono::steady_clock::now() < stallUntil)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            if (!ContinueRequest(*request))
+            {
+                response->SetClientErrorType(CoreErrors::USER_CANCELLED);
+                m_cancelledRequests++;
+                return response;
+            }
+        }
+        response->SetResponseCode(stall && !earlyChunk.empty() ? earlyCode : HttpResponseCode::OK);
+        WriteBody(*request, *response, stall ? "stalled" : "prompt");
+        return response;
+    }
+
+    void StallNextRequest(const Aws::String& earlyChunk = "", HttpResponseCode earlyCode = HttpResponseCode::OK)
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        m_stallNext = true;
+        m_earlyChunk = earlyChunk;
+        m_earlyCode = earlyCode;
+    }
+
+    size_t GetCancelledRequests() const { return m_cancelledRequests; }
+
+private:
+    static void WriteBody(const HttpRequest& request, HttpResponse& response, const Aws::String& body)
+    {
+        response.GetResponseBody() << body;
+        if (request.GetDataReceivedEventHandler())
+        {
+            request.GetDataReceivedEventHandler()(&request, &response, static_cast<long long>(body.size()));
+        }
+    }
+
+    std::chrono::milliseconds m_maxStall;
+    mutable std::mutex m_lock;
+    mutable bool m_stallNext;
+    mutable Aws::String m_earlyChunk;
+    mutable HttpResponseCode m_earlyCode;
+    mutable std::atomic<size_t> m_cancelledRequests;
+};
+
+/**
+ * Clears a response cache just before each request is answered, as if other requests had evicted its entries.
+ */
+class CacheClearingHttpClient : public MockHttpClient
+{
+public:
+    CacheClearingHttpClient(const std::shared_ptr<ResponseCache>& responseCache) : m_responseCache(responseCache) {}
+
+    std::shared_ptr<HttpResponse> MakeRequest(const std::shared_ptr<HttpRequest>& request,
+        Aws::Utils::RateLimits::RateLimiterInterface* readLimiter, Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const override
+    {
+        m_responseCache->Clear();
+        return MockHttpClient::MakeRequest(request, readLimiter, writeLimiter);
+    }
+
+private:
+    std::shared_ptr<ResponseCache> m_responseCache;
+};
+
 class AWSClientTestSuite : public ::testing::Test
 {
 protected:
@@ -91,14 +197,14 @@ protected:
         InitHttp();
     }
 
-    void QueueMockResponse(HttpResponseCode code, const HeaderValueCollection& headers)
+    void QueueMockResponse(HttpResponseCode code, const HeaderValueCollection& headers, const Aws::String& body = "")
     {
         auto httpRequest = CreateHttpRequest(URI("http://www.uri.com/path/to/res"),
                 HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
         httpRequest->SetResolvedRemoteHost("127.0.0.1");
         auto httpResponse = Aws::MakeShared<StandardHttpResponse>(ALLOCATION_TAG, httpRequest);
         httpResponse->SetResponseCode(code);
-        httpResponse->GetResponseBody() << "";
+        httpResponse->GetResponseBody() << body;
         for(auto&& header : headers)
         {
             httpResponse->AddHeader(header.first, header.second);
@@ -121,6 +227,33 @@ protected:
         mockHttpClient->AddResponseToReturn(httpResponse);
     }
 
+    Aws::UniquePtr<MockAWSClient> CreateClientWithResponseCache(const std::shared_ptr<ResponseCache>& responseCache)
+    {
+        ClientConfiguration config;
+        config.scheme = Scheme::HTTP;
+        config.retryStrategy = Aws::MakeShared<CountedRetryStrategy>(ALLOCATION_TAG);
+        config.responseCache = responseCache;
+        return Aws::MakeUnique<MockAWSClient>(ALLOCATION_TAG, config);
+    }
+
+    Aws::UniquePtr<MockAWSClient> CreateClientWithHedgingPolicy(const std::shared_ptr<HedgingPolicy>& hedgingPolicy,
+        const std::shared_ptr<StallingHttpClient>& httpClient)
+    {
+        ClientConfiguration config;
+        config.scheme = Scheme::HTTP;
+        config.retryStrategy = Aws::MakeShared<CountedRetryStrategy>(ALLOCATION_TAG);
+        config.hedgingPolicy = hedgingPolicy;
+        mockHttpClientFactory->SetClient(httpClient);
+        return Aws::MakeUnique<MockAWSClient>(ALLOCATION_TAG, config);
+    }
+
+    static Aws::String ReadBody(const HttpResponseOutcome& outcome)
+    {
+        Aws::StringStream ss;
+        ss << outcome.GetResult()->GetResponseBody().rdbuf();
+        return ss.str();
+    }
+
     Aws::String ExtractFromRequestInfo(const Aws::String& requestInfo, const Aws::String& key)
     {
         auto iter = requestInfo.find(key + "=");
@@ -196,6 +329,45 @@ TEST_F(AWSClientTestSuite, TestValidateInvalidURI)
     ASSERT_EQ(CoreErrors::VALIDATION, outcome.GetError().GetErrorType());
 }
 
+TEST_F(AWSClientTestSuite, TestWarmUpConnectionsUsesEndpointOfConfiguration)
+{
+    ClientConfiguration config;
+    config.scheme = Scheme::HTTP;
+    config.region = Aws::Region::EU_WEST_1;
+    config.retryStrategy = Aws::MakeShared<CountedRetryStrategy>(ALLOCATION_TAG);
+    auto regionalClient = Aws::MakeUnique<MockAWSClient>(ALLOCATION_TAG, config);
+    ASSERT_EQ(1u, regionalClient->WarmUpConnections(1));
+    ASSERT_EQ(HttpMethod::HTTP_HEAD, mockHttpClient->GetMostRecentHttpRequest().GetMethod());
+    // Named after the service the client signs for.
+    ASSERT_EQ("http://service.eu-west-1.amazonaws.com", mockHttpClient->GetMostRecentHttpRequest().GetUri().GetURIString());
+
+    config.endpointOverride = "localhost:8000";
+    auto overriddenClient = Aws::MakeUnique<MockAWSClient>(ALLOCATION_TAG, config);
+    ASSERT_EQ(1u, overriddenClient->WarmUpConnections(1));
+    ASSERT_EQ("http://localhost:8000", mockHttpClient->GetMostRecentHttpRequest().GetUri().GetURIString());
+}
+
+TEST_F(AWSClientTestSuite, TestRequestInRejectedTaskFailsWithoutBeingSent)
+{
+    AmazonWebServiceRequestMock request;
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection());
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection());
+    Aws::Utils::Threading::RunRejectedTask([&]
+    {
+        auto outcome = client->MakeRequest(request);
+        ASSERT_FALSE(outcome.IsSuccess());
+        ASSERT_EQ(CoreErrors::THROTTLING, outcome.GetError().GetErrorType());
+        ASSERT_EQ(0u, mockHttpClient->GetAllRequestsMade().size());
+
+        // Only the rejected call fails, not the calls its handler makes.
+        ASSERT_TRUE(client->MakeRequest(request).IsSuccess());
+    });
+    ASSERT_EQ(1u, mockHttpClient->GetAllRequestsMade().size());
+
+    ASSERT_TRUE(client->MakeRequest(request).IsSuccess());
+    ASSERT_EQ(2u, mockHttpClient->GetAllRequestsMade().size());
+}
+
 TEST_F(AWSClientTestSuite, TestClockSkewOutsideAcceptableRange)
 {
     HeaderValueCollection responseHeaders;
@@ -406,6 +578,428 @@ TEST_F(AWSClientTestSuite, TestStandardRetryStrategy)
     ASSERT_EQ(3, clientWithStandardRetryStrategy.GetRetryQuotaContainer()->GetRetryQuota());
 }
 
+TEST_F(AWSClientTestSuite, TestResponseCacheHitSkipsService)
+{
+    ResponseCacheConfiguration cacheConfig;
+    cacheConfig.operationTimeToLive["AmazonWebServiceRequestMock"] = std::chrono::hours(1);
+    auto responseCache = Aws::MakeShared<ResponseCache>(ALLOCATION_TAG, cacheConfig);
+    auto cachingClient = CreateClientWithResponseCache(responseCache);
+
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection{std::make_pair("ETag", "\"v1\"")}, "first body");
+    AmazonWebServiceRequestMock request;
+    auto outcome = cachingClient->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ("first body", ReadBody(outcome));
+
+    // Served from the cache: no response is queued for a second call.
+    outcome = cachingClient->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(HttpResponseCode::OK, outcome.GetResult()->GetResponseCode());
+    ASSERT_EQ("\"v1\"", outcome.GetResult()->GetHeader("etag"));
+    ASSERT_EQ("first body", ReadBody(outcome));
+    ASSERT_EQ(1u, mockHttpClient->GetAllRequestsMade().size());
+
+    // A different URI is a different key.
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection{}, "other body");
+    outcome = cachingClient->MakeRequest("domain.com/other", request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ("other body", ReadBody(outcome));
+    ASSERT_EQ(2u, mockHttpClient->GetAllRequestsMade().size());
+
+    auto stats = responseCache->GetStatistics();
+    ASSERT_EQ(1u, stats.hits);
+    ASSERT_EQ(2u, stats.misses);
+    ASSERT_EQ(2u, stats.entries);
+}
+
+TEST_F(AWSClientTestSuite, TestResponseCacheRevalidatesWithETag)
+{
+    ResponseCacheConfiguration cacheConfig;
+    cacheConfig.operationTimeToLive["AmazonWebServiceRequestMock"] = std::chrono::milliseconds(0);
+    auto responseCache = Aws::MakeShared<ResponseCache>(ALLOCATION_TAG, cacheConfig);
+    auto cachingClient = CreateClientWithResponseCache(responseCache);
+
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection{std::make_pair("ETag", "\"v1\"")}, "first body");
+    AmazonWebServiceRequestMock request;
+    auto outcome = cachingClient->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_FALSE(mockHttpClient->GetMostRecentHttpRequest().HasHeader("if-none-match"));
+
+    // Not modified: the cached response is returned as if the service had sent it.
+    QueueMockResponse(HttpResponseCode::NOT_MODIFIED, HeaderValueCollection{});
+    outcome = cachingClient->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(HttpResponseCode::OK, outcome.GetResult()->GetResponseCode());
+    ASSERT_EQ("first body", ReadBody(outcome));
+    ASSERT_EQ("\"v1\"", mockHttpClient->GetMostRecentHttpRequest().GetHeaderValue("if-none-match"));
+    ASSERT_EQ(0, cachingClient->GetRequestAttemptedRetries());
+
+    // Modified: the new response replaces the cached one.
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection{std::make_pair("ETag", "\"v2\"")}, "second body");
+    outcome = cachingClient->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ("second body", ReadBody(outcome));
+
+    QueueMockResponse(HttpResponseCode::NOT_MODIFIED, HeaderValueCollection{});
+    outcome = cachingClient->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ("second body", ReadBody(outcome));
+    ASSERT_EQ("\"v2\"", mockHttpClient->GetMostRecentHttpRequest().GetHeaderValue("if-none-match"));
+    ASSERT_EQ(4u, mockHttpClient->GetAllRequestsMade().size());
+
+    auto stats = responseCache->GetStatistics();
+    ASSERT_EQ(0u, stats.hits);
+    ASSERT_EQ(2u, stats.revalidations);
+    ASSERT_EQ(1u, stats.entries);
+}
+
+TEST_F(AWSClientTestSuite, TestResponseCacheServesLocalCopyWhenEvictedDuringRevalidation)
+{
+    ResponseCacheConfiguration cacheConfig;
+    cacheConfig.operationTimeToLive["AmazonWebServiceRequestMock"] = std::chrono::milliseconds(0);
+    auto responseCache = Aws::MakeShared<ResponseCache>(ALLOCATION_TAG, cacheConfig);
+    auto cachingClient = CreateClientWithResponseCache(responseCache);
+
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection{std::make_pair("ETag", "\"v1\"")}, "first body");
+    AmazonWebServiceRequestMock request;
+    ASSERT_TRUE(cachingClient->MakeRequest(request).IsSuccess());
+    ASSERT_EQ(1u, responseCache->GetStatistics().entries);
+
+    // The entry is gone by the time the 304 arrives.
+    mockHttpClient = Aws::MakeShared<CacheClearingHttpClient>(ALLOCATION_TAG, responseCache);
+    mockHttpClientFactory->SetClient(mockHttpClient);
+    cachingClient = CreateClientWithResponseCache(responseCache);
+    QueueMockResponse(HttpResponseCode::NOT_MODIFIED, HeaderValueCollection{});
+    auto outcome = cachingClient->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(HttpResponseCode::OK, outcome.GetResult()->GetResponseCode());
+    ASSERT_EQ("first body", ReadBody(outcome));
+    ASSERT_EQ("\"v1\"", mockHttpClient->GetMostRecentHttpRequest().GetHeaderValue("if-none-match"));
+    ASSERT_EQ(0, cachingClient->GetRequestAttemptedRetries());
+
+    // And it is stored again for the next caller.
+    CachedResponse found;
+    ASSERT_EQ(1u, responseCache->GetStatistics().entries);
+    ASSERT_EQ(ResponseCacheLookup::Stale, responseCache->Lookup(ResponseCache::ComputeKey(
+        URI("domain.com/something"), HttpMethod::HTTP_GET, request), found));
+    ASSERT_EQ("first body", found.body);
+}
+
+TEST_F(AWSClientTestSuite, TestResponseCacheSkipsUnlistedAndConditionalRequests)
+{
+    ResponseCacheConfiguration cacheConfig;
+    cacheConfig.operationTimeToLive["SomeOtherOperation"] = std::chrono::hours(1);
+    auto responseCache = Aws::MakeShared<ResponseCache>(ALLOCATION_TAG, cacheConfig);
+    auto cachingClient = CreateClientWithResponseCache(responseCache);
+
+    AmazonWebServiceRequestMock request;
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection{std::make_pair("ETag", "\"v1\"")}, "body");
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection{std::make_pair("ETag", "\"v1\"")}, "body");
+    ASSERT_TRUE(cachingClient->MakeRequest(request).IsSuccess());
+    ASSERT_TRUE(cachingClient->MakeRequest(request).IsSuccess());
+    ASSERT_EQ(2u, mockHttpClient->GetAllRequestsMade().size());
+    ASSERT_EQ(0u, responseCache->GetStatistics().entries);
+
+    // Requests with conditions of their own expect the service to evaluate them.
+    cacheConfig.operationTimeToLive["AmazonWebServiceRequestMock"] = std::chrono::hours(1);
+    responseCache = Aws::MakeShared<ResponseCache>(ALLOCATION_TAG, cacheConfig);
+    cachingClient = CreateClientWithResponseCache(responseCache);
+    request.SetHeaders(HeaderValueCollection{std::make_pair("If-None-Match", "\"v0\"")});
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection{std::make_pair("ETag", "\"v1\"")}, "body");
+    ASSERT_TRUE(cachingClient->MakeRequest(request).IsSuccess());
+    ASSERT_EQ(0u, responseCache->GetStatistics().entries);
+}
+
+TEST_F(AWSClientTestSuite, TestRequestRateLimiterLearnsFromThrottling)
+{
+    ClientConfiguration config;
+    config.scheme = Scheme::HTTP;
+    config.retryStrategy = Aws::MakeShared<CountedRetryStrategy>(ALLOCATION_TAG);
+    config.requestRateLimiter = Aws::MakeShared<Aws::Utils::RateLimits::AdaptiveRateLimiter>(ALLOCATION_TAG);
+    MockAWSClient limitedClient(config);
+
+    AmazonWebServiceRequestMock request;
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection{});
+    QueueMockResponse(HttpResponseCode::INTERNAL_SERVER_ERROR, HeaderValueCollection{});
+    ASSERT_TRUE(limitedClient.MakeRequest(request).IsSuccess());
+    ASSERT_FALSE(limitedClient.MakeRequest(request).IsSuccess());
+    ASSERT_FALSE(config.requestRateLimiter->GetSendRateState("domain.com").limiting);
+
+    QueueMockResponse(HttpResponseCode::TOO_MANY_REQUESTS, HeaderValueCollection{});
+    ASSERT_FALSE(limitedClient.MakeRequest(request).IsSuccess());
+    ASSERT_TRUE(config.requestRateLimiter->GetSendRateState("domain.com").limiting);
+    ASSERT_FALSE(config.requestRateLimiter->GetSendRateState("other.com").limiting);
+}
+
+TEST_F(AWSClientTestSuite, TestHedgingPolicyHedgesSlowAttempts)
+{
+    HedgingPolicyConfiguration hedgingConfig;
+    hedgingConfig.operations.insert("AmazonWebServiceRequestMock");
+    hedgingConfig.minLatencySamples = 5;
+    hedgingConfig.budgetPercent = 50;
+    // Long enough for the executor to have sent the first attempt, which gets the stall, before the hedge.
+    hedgingConfig.minDelay = std::chrono::milliseconds(50);
+    auto hedgingPolicy = Aws::MakeShared<HedgingPolicy>(ALLOCATION_TAG, hedgingConfig);
+    auto httpClient = Aws::MakeShared<StallingHttpClient>(ALLOCATION_TAG, std::chrono::seconds(10));
+    auto hedgingClient = CreateClientWithHedgingPolicy(hedgingPolicy, httpClient);
+
+    // Nothing is hedged until enough latencies are known.
+    AmazonWebServiceRequestMock request;
+    for (int i = 0; i < 5; ++i)
+    {
+        ASSERT_TRUE(hedgingClient->MakeRequest(request).IsSuccess());
+    }
+    ASSERT_EQ(0u, hedgingPolicy->GetStatistics().hedges);
+
+    // The hedge answers while the first attempt stalls, which is then cancelled.
+    httpClient->StallNextRequest();
+    auto outcome = hedgingClient->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ("prompt", ReadBody(outcome));
+    for (int i = 0; i < 1000 && httpClient->GetCancelledRequests() == 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(1u, httpClient->GetCancelledRequests());
+
+    auto stats = hedgingPolicy->GetStatistics();
+    ASSERT_EQ(6u, stats.attempts);
+    ASSERT_EQ(1u, stats.hedges);
+    ASSERT_EQ(1u, stats.hedgesWon);
+    ASSERT_EQ(0, hedgingClient->GetRequestAttemptedRetries());
+}
+
+TEST_F(AWSClientTestSuite, TestHedgingPolicyPassesOnlyTheWinnersData)
+{
+    HedgingPolicyConfiguration hedgingConfig;
+    hedgingConfig.operations.insert("AmazonWebServiceRequestMock");
+    hedgingConfig.minLatencySamples = 1;
+    hedgingConfig.budgetPercent = 100;
+    hedgingConfig.minDelay = std::chrono::milliseconds(50);
+    auto hedgingPolicy = Aws::MakeShared<HedgingPolicy>(ALLOCATION_TAG, hedgingConfig);
+    auto httpClient = Aws::MakeShared<StallingHttpClient>(ALLOCATION_TAG, std::chrono::seconds(10));
+    auto hedgingClient = CreateClientWithHedgingPolicy(hedgingPolicy, httpClient);
+
+    AmazonWebServiceRequestMock request;
+    ASSERT_TRUE(hedgingClient->MakeRequest(request).IsSuccess());
+    std::atomic<long long> bytesReceived(0);
+    request.SetDataReceivedEventHandler([&bytesReceived](const HttpRequest*, HttpResponse*, long long amount) { bytesReceived += amount; });
+
+    // The first attempt starts an error response, then stalls: the hedge wins, and only its body is reported.
+    httpClient->StallNextRequest("error", HttpResponseCode::INTERNAL_SERVER_ERROR);
+    auto outcome = hedgingClient->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ("prompt", ReadBody(outcome));
+    for (int i = 0; i < 1000 && httpClient->GetCancelledRequests() == 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(1u, httpClient->GetCancelledRequests());
+    ASSERT_EQ(static_cast<long long>(sizeof("prompt") - 1), bytesReceived.load());
+    ASSERT_EQ(1u, hedgingPolicy->GetStatistics().hedgesWon);
+}
+
+TEST_F(AWSClientTestSuite, TestHedgingPolicyKeepsAttemptThatStartedAnswering)
+{
+    HedgingPolicyConfiguration hedgingConfig;
+    hedgingConfig.operations.insert("AmazonWebServiceRequestMock");
+    hedgingConfig.minLatencySamples = 1;
+    hedgingConfig.budgetPercent = 100;
+    hedgingConfig.minDelay = std::chrono::milliseconds(50);
+    auto hedgingPolicy = Aws::MakeShared<HedgingPolicy>(ALLOCATION_TAG, hedgingConfig);
+    auto httpClient = Aws::MakeShared<StallingHttpClient>(ALLOCATION_TAG, std::chrono::milliseconds(200));
+    auto hedgingClient = CreateClientWithHedgingPolicy(hedgingPolicy, httpClient);
+
+    AmazonWebServiceRequestMock request;
+    ASSERT_TRUE(hedgingClient->MakeRequest(request).IsSuccess());
+
+    // A successful response is arriving, slowly, so it isn't hedged.
+    httpClient->StallNextRequest("early ");
+    auto outcome = hedgingClient->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ("early stalled", ReadBody(outcome));
+    ASSERT_EQ(0u, hedgingPolicy->GetStatistics().hedges);
+    ASSERT_EQ(0u, httpClient->GetCancelledRequests());
+}
+
+TEST_F(AWSClientTestSuite, TestHedgingPolicyStopsWhenBudgetIsSpent)
+{
+    HedgingPolicyConfiguration hedgingConfig;
+    hedgingConfig.operations.insert("AmazonWebServiceRequestMock");
+    hedgingConfig.minLatencySamples = 1;
+    hedgingConfig.budgetPercent = 0;
+    auto hedgingPolicy = Aws::MakeShared<HedgingPolicy>(ALLOCATION_TAG, hedgingConfig);
+    auto httpClient = Aws::MakeShared<StallingHttpClient>(ALLOCATION_TAG, std::chrono::milliseconds(50));
+    auto hedgingClient = CreateClientWithHedgingPolicy(hedgingPolicy, httpClient);
+
+    AmazonWebServiceRequestMock request;
+    ASSERT_TRUE(hedgingClient->MakeRequest(request).IsSuccess());
+    httpClient->StallNextRequest();
+    auto outcome = hedgingClient->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ("stalled", ReadBody(outcome));
+
+    auto stats = hedgingPolicy->GetStatistics();
+    ASSERT_EQ(0u, stats.hedges);
+    ASSERT_EQ(1u, stats.hedgesDenied);
+    ASSERT_EQ(0u, httpClient->GetCancelledRequests());
+}
+
+TEST_F(AWSClientTestSuite, TestHedgingPolicySkipsRequestsWithCustomResponseStream)
+{
+    HedgingPolicyConfiguration hedgingConfig;
+    hedgingConfig.operations.insert("AmazonWebServiceRequestMock");
+    hedgingConfig.minLatencySamples = 1;
+    hedgingConfig.budgetPercent = 100;
+    auto hedgingPolicy = Aws::MakeShared<HedgingPolicy>(ALLOCATION_TAG, hedgingConfig);
+    auto httpClient = Aws::MakeShared<StallingHttpClient>(ALLOCATION_TAG, std::chrono::milliseconds(50));
+    auto hedgingClient = CreateClientWithHedgingPolicy(hedgingPolicy, httpClient);
+
+    AmazonWebServiceRequestMock request;
+    ASSERT_TRUE(hedgingClient->MakeRequest(request).IsSuccess());
+
+    // Both attempts would write their responses to streams of the caller's factory.
+    request.SetResponseStreamFactory(Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    httpClient->StallNextRequest();
+    auto outcome = hedgingClient->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ("stalled", ReadBody(outcome));
+
+    auto stats = hedgingPolicy->GetStatistics();
+    ASSERT_EQ(0u, stats.hedges);
+    ASSERT_EQ(0u, stats.hedgesDenied);
+    ASSERT_EQ(0u, httpClient->GetCancelledRequests());
+}
+
+TEST(HedgingPolicyTest, TestHedgeDelayTracksLatencyPercentile)
+{
+    HedgingPolicyConfiguration hedgingConfig;
+    hedgingConfig.operations.insert("GetItem");
+    hedgingConfig.latencySamples = 100;
+    hedgingConfig.minLatencySamples = 100;
+    hedgingConfig.minDelay = std::chrono::milliseconds(5);
+    hedgingConfig.maxDelay = std::chrono::milliseconds(200);
+    HedgingPolicy hedgingPolicy(hedgingConfig);
+    ASSERT_TRUE(hedgingPolicy.IsHedged("GetItem"));
+    ASSERT_FALSE(hedgingPolicy.IsHedged("PutItem"));
+
+    std::chrono::microseconds hedgeDelay(0);
+    for (int i = 0; i < 80; ++i)
+    {
+        hedgingPolicy.RecordLatency("GetItem", std::chrono::milliseconds(10));
+    }
+    ASSERT_FALSE(hedgingPolicy.StartAttempt("GetItem", hedgeDelay));
+    for (int i = 0; i < 20; ++i)
+    {
+        hedgingPolicy.RecordLatency("GetItem", std::chrono::milliseconds(150));
+    }
+
+    // The 95th percentile, 150 ms, is within the bounds.
+    ASSERT_TRUE(hedgingPolicy.StartAttempt("GetItem", hedgeDelay));
+    ASSERT_EQ(std::chrono::milliseconds(150), hedgeDelay);
+    ASSERT_FALSE(hedgingPolicy.StartAttempt("Query", hedgeDelay));
+
+    // Faster latencies replace the oldest ones, and the delay follows, down to minDelay.
+    for (int i = 0; i < 100; ++i)
+    {
+        hedgingPolicy.RecordLatency("GetItem", std::chrono::milliseconds(2));
+    }
+    ASSERT_TRUE(hedgingPolicy.StartAttempt("GetItem", hedgeDelay));
+    ASSERT_EQ(std::chrono::milliseconds(5), hedgeDelay);
+}
+
+TEST(HedgingPolicyTest, TestHedgeBudgetIsEarnedByAttempts)
+{
+    HedgingPolicyConfiguration hedgingConfig;
+    hedgingConfig.operations.insert("GetItem");
+    hedgingConfig.budgetPercent = 25;
+    hedgingConfig.maxBudget = 2;
+    HedgingPolicy hedgingPolicy(hedgingConfig);
+    std::chrono::microseconds hedgeDelay(0);
+
+    ASSERT_FALSE(hedgingPolicy.AcquireHedge());
+    for (int i = 0; i < 4; ++i)
+    {
+        hedgingPolicy.StartAttempt("GetItem", hedgeDelay);
+    }
+    ASSERT_TRUE(hedgingPolicy.AcquireHedge());
+    ASSERT_FALSE(hedgingPolicy.AcquireHedge());
+
+    // No more than maxBudget hedges are saved up.
+    for (int i = 0; i < 100; ++i)
+    {
+        hedgingPolicy.StartAttempt("GetItem", hedgeDelay);
+    }
+    ASSERT_TRUE(hedgingPolicy.AcquireHedge());
+    ASSERT_TRUE(hedgingPolicy.AcquireHedge());
+    ASSERT_FALSE(hedgingPolicy.AcquireHedge());
+
+    auto stats = hedgingPolicy.GetStatistics();
+    ASSERT_EQ(104u, stats.attempts);
+    ASSERT_EQ(3u, stats.hedges);
+    ASSERT_EQ(3u, stats.hedgesDenied);
+}
+
+TEST(ResponseCacheTest, TestEvictsLeastRecentlyUsedBeyondMaxBytes)
+{
+    ResponseCacheConfiguration cacheConfig;
+    cacheConfig.maxBytes = 300;
+    cacheConfig.maxEntryBytes = 150;
+    ResponseCache cache(cacheConfig);
+
+    auto makeResponse = [](size_t bodySize)
+    {
+        CachedResponse response;
+        response.responseCode = HttpResponseCode::OK;
+        response.body = Aws::String(bodySize, 'x');
+        response.freshUntil = (std::numeric_limits<int64_t>::max)();
+        return response;
+    };
+
+    cache.Put("a", makeResponse(99));
+    cache.Put("b", makeResponse(99));
+    cache.Put("c", makeResponse(99));
+    ASSERT_EQ(3u, cache.GetStatistics().entries);
+    ASSERT_EQ(300u, cache.GetStatistics().bytes);
+
+    // "a" becomes the most recently used, so adding "d" evicts "b".
+    CachedResponse found;
+    ASSERT_EQ(ResponseCacheLookup::Fresh, cache.Lookup("a", found));
+    cache.Put("d", makeResponse(99));
+    ASSERT_EQ(ResponseCacheLookup::Fresh, cache.Lookup("a", found));
+    ASSERT_EQ(ResponseCacheLookup::Miss, cache.Lookup("b", found));
+    ASSERT_EQ(ResponseCacheLookup::Fresh, cache.Lookup("c", found));
+    ASSERT_EQ(ResponseCacheLookup::Fresh, cache.Lookup("d", found));
+
+    // Larger than maxEntryBytes: not cached, nothing evicted.
+    cache.Put("e", makeResponse(200));
+    ASSERT_EQ(ResponseCacheLookup::Miss, cache.Lookup("e", found));
+
+    auto stats = cache.GetStatistics();
+    ASSERT_EQ(1u, stats.evictions);
+    ASSERT_EQ(3u, stats.entries);
+    ASSERT_EQ(300u, stats.bytes);
+
+    // Stale entries without validators cannot be revalidated, so they are misses.
+    CachedResponse stale = makeResponse(10);
+    stale.freshUntil = 0;
+    cache.Put("f", std::move(stale));
+    ASSERT_EQ(ResponseCacheLookup::Miss, cache.Lookup("f", found));
+
+    stale = makeResponse(10);
+    stale.freshUntil = 0;
+    stale.headers.emplace("etag", "\"v1\"");
+    cache.Put("g", std::move(stale));
+    ASSERT_EQ(ResponseCacheLookup::Stale, cache.Lookup("g", found));
+    ASSERT_EQ("\"v1\"", found.GetETag());
+    ASSERT_TRUE(cache.Refresh("g", std::chrono::hours(1), found));
+    ASSERT_EQ(ResponseCacheLookup::Fresh, cache.Lookup("g", found));
+
+    cache.Clear();
+    ASSERT_EQ(0u, cache.GetStatistics().entries);
+    ASSERT_EQ(0u, cache.GetStatistics().bytes);
+}
+
 TEST(AWSClientTest, TestBuildHttpRequestWithHeadersOnly)
 {
     HeaderValueCollection headerValues;
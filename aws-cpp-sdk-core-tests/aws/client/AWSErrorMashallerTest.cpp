@@ -721,3 +721,25 @@ TEST(AWSErrorMashallerTest, TestErrorsWithoutPrefixParse)
     ASSERT_EQ(requestId, error.GetRequestId());
     ASSERT_FALSE(error.ShouldRetry());
 }
+
+TEST(AWSErrorMashallerTest, TestIsThrottlingError)
+{
+    JsonErrorMarshaller awsErrorMarshaller;
+    ASSERT_TRUE(IsThrottlingError(awsErrorMarshaller.Marshall(*BuildHttpResponse("ThrottlingException", "Rate exceeded", "Request Id"))));
+    ASSERT_TRUE(IsThrottlingError(awsErrorMarshaller.Marshall(*BuildHttpResponse("SlowDown", "Please reduce your request rate", "Request Id"))));
+    ASSERT_FALSE(IsThrottlingError(awsErrorMarshaller.Marshall(*BuildHttpResponse("AccessDeniedException", "Denied", "Request Id"))));
+
+    // Service specific throttling errors are recognized by name.
+    AWSError<CoreErrors> serviceError(static_cast<CoreErrors>(static_cast<int>(CoreErrors::SERVICE_EXTENSION_START_RANGE) + 1),
+        "ProvisionedThroughputExceededException", "The level of configured provisioned throughput for the table was exceeded.", true);
+    ASSERT_TRUE(IsThrottlingError(serviceError));
+    serviceError.SetExceptionName("ConditionalCheckFailedException");
+    ASSERT_FALSE(IsThrottlingError(serviceError));
+
+    // As are responses that only carry the status code.
+    ASSERT_TRUE(IsThrottlingError(CoreErrorsMapper::GetErrorForHttpResponseCode(Aws::Http::HttpResponseCode::TOO_MANY_REQUESTS)));
+    AWSError<CoreErrors> unknownError(CoreErrors::UNKNOWN, false);
+    unknownError.SetResponseCode(Aws::Http::HttpResponseCode::TOO_MANY_REQUESTS);
+    ASSERT_TRUE(IsThrottlingError(unknownError));
+    ASSERT_FALSE(IsThrottlingError(CoreErrorsMapper::GetErrorForHttpResponseCode(Aws::Http::HttpResponseCode::INTERNAL_SERVER_ERROR)));
+}
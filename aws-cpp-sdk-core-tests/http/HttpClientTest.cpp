@@ -11,6 +11,22 @@
 #include <aws/core/http/standard/StandardHttpRequest.h>
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/core/utils/logging/LogMacros.h>
+#if ENABLE_CURL_CLIENT
+#include <aws/core/http/curl/CurlShareHandle.h>
+#include <aws/core/http/curl/CurlMultiplexer.h>
+#include <aws/core/platform/FileSystem.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
 #include <future>
 #include <chrono>
 
@@ -80,6 +96,364 @@ TEST(HttpClientTest, TestRandomURLMultiThreaded)
     }
     ASSERT_FALSE(hasPendingTasks);
 }
+
+TEST(HttpClientTest, TestCurlShareHandleSharedBetweenCompatibleConfigurations)
+{
+    Aws::Client::ClientConfiguration config;
+    auto share = CurlShareHandle::Acquire(config);
+    ASSERT_NE(nullptr, share);
+    ASSERT_NE(nullptr, share->GetHandle());
+
+    Aws::Client::ClientConfiguration otherRegionConfig;
+    otherRegionConfig.region = Aws::Region::EU_WEST_1;
+    ASSERT_EQ(share, CurlShareHandle::Acquire(otherRegionConfig));
+
+    Aws::Client::ClientConfiguration noVerifyConfig;
+    noVerifyConfig.verifySSL = false;
+    ASSERT_NE(share, CurlShareHandle::Acquire(noVerifyConfig));
+
+    Aws::Client::ClientConfiguration proxyConfig;
+    proxyConfig.proxyHost = "127.0.0.1";
+    proxyConfig.proxyPort = 8080;
+    auto proxyShare = CurlShareHandle::Acquire(proxyConfig);
+    ASSERT_NE(share, proxyShare);
+    ASSERT_EQ(proxyShare, CurlShareHandle::Acquire(proxyConfig));
+
+    // Clients authenticating differently to the proxy don't share TLS sessions.
+    for (auto setting : { &Aws::Client::ClientConfiguration::proxyPassword, &Aws::Client::ClientConfiguration::proxySSLCertType,
+        &Aws::Client::ClientConfiguration::proxySSLKeyType, &Aws::Client::ClientConfiguration::proxySSLKeyPassword })
+    {
+        Aws::Client::ClientConfiguration otherProxyConfig(proxyConfig);
+        otherProxyConfig.*setting = "other";
+        ASSERT_NE(proxyShare, CurlShareHandle::Acquire(otherProxyConfig));
+    }
+}
+
+// Transfers of a file:// url through a CurlMultiplexer, recording the order in which they receive their data.
+class MultiplexedTransfer
+{
+public:
+    MultiplexedTransfer(const Aws::String& url, Aws::Vector<Aws::String>& completed, std::mutex& completedLock) :
+        m_handle(curl_easy_init()), m_url(url), m_completed(completed), m_completedLock(completedLock), m_block(false)
+    {
+        curl_easy_setopt(m_handle, CURLOPT_URL, m_url.c_str());
+        curl_easy_setopt(m_handle, CURLOPT_WRITEFUNCTION, &MultiplexedTransfer::Write);
+        curl_easy_setopt(m_handle, CURLOPT_WRITEDATA, this);
+    }
+
+    ~MultiplexedTransfer() { curl_easy_cleanup(m_handle); }
+
+    // Blocks the first write of the transfer, and with it the multiplexer, until Release is called.
+    void Block() { m_block = true; }
+    void WaitUntilBlocked() { m_blocked.get_future().wait(); }
+    void Release() { m_release.set_value(); }
+
+    CURLcode Perform(CurlMultiplexer& multiplexer, long weight)
+    {
+        size_t streamsPerConnection = 0;
+        CURLcode result = multiplexer.Perform(m_handle, "localhost", weight, false, streamsPerConnection);
+        EXPECT_LE(1u, streamsPerConnection);
+        return result;
+    }
+
+    const Aws::String& GetBody() const { return m_body; }
+
+private:
+    static size_t Write(char* ptr, size_t size, size_t nmemb, void* userData)
+    {
+        MultiplexedTransfer* transfer = static_cast<MultiplexedTransfer*>(userData);
+        if (transfer->m_block)
+        {
+            transfer->m_block = false;
+            transfer->m_blocked.set_value();
+            transfer->m_release.get_future().wait();
+        }
+        if (transfer->m_body.empty())
+        {
+            std::lock_guard<std::mutex> locker(transfer->m_completedLock);
+            transfer->m_completed.push_back(transfer->m_url);
+        }
+        transfer->m_body.append(ptr, size * nmemb);
+        return size * nmemb;
+    }
+
+    CURL* m_handle;
+    Aws::String m_url;
+    Aws::String m_body;
+    Aws::Vector<Aws::String>& m_completed;
+    std::mutex& m_completedLock;
+    bool m_block;
+    std::promise<void> m_blocked;
+    std::promise<void> m_release;
+};
+
+static Aws::String CreateMultiplexedFile(const Aws::String& content)
+{
+    Aws::String path = Aws::FileSystem::Join(Aws::FileSystem::GetExecutableDirectory(), Aws::FileSystem::CreateTempFilePath());
+    std::ofstream file(path.c_str(), std::ios::binary);
+    file << content;
+    return path;
+}
+
+TEST(HttpClientTest, TestCurlMultiplexerPerformsConcurrentTransfers)
+{
+    if (!CurlMultiplexer::IsSupported())
+    {
+        return;
+    }
+
+    CurlMultiplexer multiplexer(2, 4);
+    Aws::Vector<Aws::String> paths;
+    for (int i = 0; i < 8; ++i)
+    {
+        Aws::StringStream content;
+        content << "transfer " << i;
+        paths.push_back(CreateMultiplexedFile(content.str()));
+    }
+
+    Aws::Vector<Aws::String> completed;
+    std::mutex completedLock;
+    std::vector<std::future<Aws::String>> futures;
+    for (const auto& path : paths)
+    {
+        futures.push_back(std::async(std::launch::async, [&, path]() {
+            MultiplexedTransfer transfer("file://" + path, completed, completedLock);
+            EXPECT_EQ(CURLE_OK, transfer.Perform(multiplexer, 16));
+            return transfer.GetBody();
+        }));
+    }
+    for (size_t i = 0; i < futures.size(); ++i)
+    {
+        Aws::StringStream content;
+        content << "transfer " << i;
+        ASSERT_EQ(content.str(), futures[i].get());
+        Aws::FileSystem::RemoveFileIfExists(paths[i].c_str());
+    }
+
+    auto statistics = multiplexer.GetStatistics();
+    ASSERT_EQ(0u, statistics.streams);
+    ASSERT_EQ(0u, statistics.queuedStreams);
+}
+
+TEST(HttpClientTest, TestCurlMultiplexerStartsHeaviestQueuedTransferFirst)
+{
+    if (!CurlMultiplexer::IsSupported())
+    {
+        return;
+    }
+
+    CurlMultiplexer multiplexer(1, 1);
+    Aws::String blockingPath = CreateMultiplexedFile("blocking");
+    Aws::String lightPath = CreateMultiplexedFile("light");
+    Aws::String heavyPath = CreateMultiplexedFile("heavy");
+    Aws::Vector<Aws::String> completed;
+    std::mutex completedLock;
+
+    MultiplexedTransfer blocking("file://" + blockingPath, completed, completedLock);
+    blocking.Block();
+    auto blockingResult = std::async(std::launch::async, [&]() { return blocking.Perform(multiplexer, 16); });
+    blocking.WaitUntilBlocked();
+
+    MultiplexedTransfer light("file://" + lightPath, completed, completedLock);
+    auto lightResult = std::async(std::launch::async, [&]() { return light.Perform(multiplexer, 1); });
+    while (multiplexer.GetStatistics().queuedStreams < 1)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    MultiplexedTransfer heavy("file://" + heavyPath, completed, completedLock);
+    auto heavyResult = std::async(std::launch::async, [&]() { return heavy.Perform(multiplexer, 256); });
+    while (multiplexer.GetStatistics().queuedStreams < 2)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    blocking.Release();
+    ASSERT_EQ(CURLE_OK, blockingResult.get());
+    ASSERT_EQ(CURLE_OK, lightResult.get());
+    ASSERT_EQ(CURLE_OK, heavyResult.get());
+    ASSERT_EQ(3u, completed.size());
+    ASSERT_EQ("file://" + blockingPath, completed[0]);
+    ASSERT_EQ("file://" + heavyPath, completed[1]);
+    ASSERT_EQ("file://" + lightPath, completed[2]);
+
+    Aws::FileSystem::RemoveFileIfExists(blockingPath.c_str());
+    Aws::FileSystem::RemoveFileIfExists(lightPath.c_str());
+    Aws::FileSystem::RemoveFileIfExists(heavyPath.c_str());
+}
+
+TEST(HttpClientTest, TestCurlMultiplexerReturnsTransferErrors)
+{
+    if (!CurlMultiplexer::IsSupported())
+    {
+        return;
+    }
+
+    CurlMultiplexer multiplexer(2, 4);
+    Aws::Vector<Aws::String> completed;
+    std::mutex completedLock;
+    MultiplexedTransfer transfer("file:///nonexistent/multiplexed/transfer", completed, completedLock);
+    ASSERT_EQ(CURLE_FILE_COULDNT_READ_FILE, transfer.Perform(multiplexer, 16));
+    ASSERT_TRUE(completed.empty());
+}
+
+// HTTP/1.1 server on a local port that answers every request with an empty 200 after responseDelay, and keeps its
+// connections open until CloseConnections is called.
+class KeepAliveServer
+{
+public:
+    explicit KeepAliveServer(std::chrono::milliseconds responseDelay = std::chrono::milliseconds(0)) :
+        m_listener(socket(AF_INET, SOCK_STREAM, 0)), m_responseDelay(responseDelay), m_connections(0)
+    {
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addressLength = sizeof(address);
+        EXPECT_EQ(0, bind(m_listener, reinterpret_cast<sockaddr*>(&address), addressLength));
+        EXPECT_EQ(0, listen(m_listener, 16));
+        EXPECT_EQ(0, getsockname(m_listener, reinterpret_cast<sockaddr*>(&address), &addressLength));
+        Aws::StringStream url;
+        url << "http://127.0.0.1:" << ntohs(address.sin_port) << "/";
+        m_url = url.str();
+        m_acceptor = std::thread(&KeepAliveServer::Accept, this);
+    }
+
+    ~KeepAliveServer()
+    {
+        shutdown(m_listener, SHUT_RDWR);
+        m_acceptor.join();
+        close(m_listener);
+        CloseConnections();
+        for (auto& connection : m_connectionThreads)
+        {
+            connection.join();
+        }
+    }
+
+    const Aws::String& GetUrl() const { return m_url; }
+
+    // Connections accepted so far.
+    size_t GetConnectionCount() const { return m_connections.load(); }
+
+    void CloseConnections()
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        for (int connection : m_openConnections)
+        {
+            shutdown(connection, SHUT_RDWR);
+        }
+    }
+
+private:
+    void Accept()
+    {
+        int connection;
+        while ((connection = accept(m_listener, nullptr, nullptr)) >= 0)
+        {
+            ++m_connections;
+            std::lock_guard<std::mutex> locker(m_lock);
+            m_openConnections.push_back(connection);
+            m_connectionThreads.emplace_back(&KeepAliveServer::Serve, this, connection);
+        }
+    }
+
+    void Serve(int connection)
+    {
+        static const char RESPONSE[] = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n";
+        Aws::String received;
+        char buffer[1024];
+        ssize_t bytesRead;
+        while ((bytesRead = recv(connection, buffer, sizeof(buffer), 0)) > 0)
+        {
+            received.append(buffer, static_cast<size_t>(bytesRead));
+            size_t requestEnd;
+            while ((requestEnd = received.find("\r\n\r\n")) != Aws::String::npos)
+            {
+                received.erase(0, requestEnd + 4);
+                std::this_thread::sleep_for(m_responseDelay);
+                send(connection, RESPONSE, sizeof(RESPONSE) - 1, 0);
+            }
+        }
+
+        std::lock_guard<std::mutex> locker(m_lock);
+        m_openConnections.erase(std::find(m_openConnections.begin(), m_openConnections.end(), connection));
+        close(connection);
+    }
+
+    int m_listener;
+    std::chrono::milliseconds m_responseDelay;
+    Aws::String m_url;
+    std::atomic<size_t> m_connections;
+    std::mutex m_lock;
+    Aws::Vector<int> m_openConnections;
+    Aws::Vector<std::thread> m_connectionThreads;
+    std::thread m_acceptor;
+};
+
+static int64_t MakeRequestAndGetWarmConnections(const std::shared_ptr<HttpClient>& httpClient, const Aws::String& url)
+{
+    auto request = CreateHttpRequest(url, HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    auto response = httpClient->MakeRequest(request);
+    EXPECT_EQ(HttpResponseCode::OK, response->GetResponseCode());
+    const auto& metrics = request->GetRequestMetrics();
+    auto warmConnections = metrics.find("WarmConnections");
+    EXPECT_NE(metrics.end(), warmConnections);
+    return warmConnections == metrics.end() ? -1 : warmConnections->second;
+}
+
+TEST(HttpClientTest, TestCurlWarmUpConnectionsOpensConnectionsAheadOfRequests)
+{
+    // More connections than warm-up threads, and capped at maxConnections.
+    KeepAliveServer server;
+    Aws::Client::ClientConfiguration config;
+    config.maxConnections = 12;
+    auto httpClient = CreateHttpClient(config);
+
+    ASSERT_EQ(12u, httpClient->WarmUpConnections(server.GetUrl(), 16));
+    ASSERT_EQ(12u, server.GetConnectionCount());
+
+    ASSERT_EQ(12, MakeRequestAndGetWarmConnections(httpClient, server.GetUrl()));
+    ASSERT_EQ(12u, server.GetConnectionCount());
+}
+
+TEST(HttpClientTest, TestCurlConnectionsRecycledAfterMaxRequests)
+{
+    KeepAliveServer server;
+    Aws::Client::ClientConfiguration config;
+    config.connectionMaxRequests = 2;
+    auto httpClient = CreateHttpClient(config);
+
+    ASSERT_EQ(0, MakeRequestAndGetWarmConnections(httpClient, server.GetUrl()));
+    ASSERT_EQ(1, MakeRequestAndGetWarmConnections(httpClient, server.GetUrl()));
+    ASSERT_EQ(1u, server.GetConnectionCount());
+    // The connection carried its two requests and was closed.
+    ASSERT_EQ(0, MakeRequestAndGetWarmConnections(httpClient, server.GetUrl()));
+    ASSERT_EQ(2u, server.GetConnectionCount());
+}
+
+TEST(HttpClientTest, TestCurlHealthCheckDropsClosedAndExpiredConnections)
+{
+    KeepAliveServer server;
+    Aws::Client::ClientConfiguration config;
+    config.connectionHealthCheckIntervalMs = 10;
+    auto httpClient = CreateHttpClient(config);
+
+    MakeRequestAndGetWarmConnections(httpClient, server.GetUrl());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_EQ(1, MakeRequestAndGetWarmConnections(httpClient, server.GetUrl()));
+
+    server.CloseConnections();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_EQ(0, MakeRequestAndGetWarmConnections(httpClient, server.GetUrl()));
+    ASSERT_EQ(2u, server.GetConnectionCount());
+
+    config.connectionMaxAgeMs = 50;
+    auto expiringHttpClient = CreateHttpClient(config);
+    MakeRequestAndGetWarmConnections(expiringHttpClient, server.GetUrl());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ASSERT_EQ(0, MakeRequestAndGetWarmConnections(expiringHttpClient, server.GetUrl()));
+    ASSERT_EQ(4u, server.GetConnectionCount());
+}
 #endif // ENABLE_CURL_CLIENT
 
 // Test Http Client timeout
@@ -316,6 +316,9 @@ TEST_F(MonitoringTestSuite, TestHttpClientMetrics)
     ASSERT_EQ(HttpClientMetricsType::DnsLatency, GetHttpClientMetricTypeByName("DnsLatency"));
     ASSERT_EQ(HttpClientMetricsType::TcpLatency, GetHttpClientMetricTypeByName("TcpLatency"));
     ASSERT_EQ(HttpClientMetricsType::SslLatency, GetHttpClientMetricTypeByName("SslLatency"));
+    ASSERT_EQ(HttpClientMetricsType::SslHandshakes, GetHttpClientMetricTypeByName("SslHandshakes"));
+    ASSERT_EQ(HttpClientMetricsType::StreamsPerConnection, GetHttpClientMetricTypeByName("StreamsPerConnection"));
+    ASSERT_EQ(HttpClientMetricsType::WarmConnections, GetHttpClientMetricTypeByName("WarmConnections"));
     ASSERT_EQ(HttpClientMetricsType::Unknown, GetHttpClientMetricTypeByName("Unknown"));
     ASSERT_EQ(HttpClientMetricsType::Unknown, GetHttpClientMetricTypeByName("RandomMetricsUnknown"));
 
@@ -327,5 +330,8 @@ TEST_F(MonitoringTestSuite, TestHttpClientMetrics)
     ASSERT_STREQ("DnsLatency", GetHttpClientMetricNameByType(HttpClientMetricsType::DnsLatency).c_str());
     ASSERT_STREQ("TcpLatency", GetHttpClientMetricNameByType(HttpClientMetricsType::TcpLatency).c_str());
     ASSERT_STREQ("SslLatency", GetHttpClientMetricNameByType(HttpClientMetricsType::SslLatency).c_str());
+    ASSERT_STREQ("SslHandshakes", GetHttpClientMetricNameByType(HttpClientMetricsType::SslHandshakes).c_str());
+    ASSERT_STREQ("StreamsPerConnection", GetHttpClientMetricNameByType(HttpClientMetricsType::StreamsPerConnection).c_str());
+    ASSERT_STREQ("WarmConnections", GetHttpClientMetricNameByType(HttpClientMetricsType::WarmConnections).c_str());
     ASSERT_STREQ("Unknown", GetHttpClientMetricNameByType(HttpClientMetricsType::Unknown).c_str());
 }
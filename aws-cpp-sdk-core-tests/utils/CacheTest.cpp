@@ -6,9 +6,11 @@
 #include <aws/external/gtest.h>
 #include <aws/core/utils/Cache.h>
 #include <aws/core/utils/ConcurrentCache.h>
+#include <aws/core/utils/ShardedCache.h>
 
 #include <thread>
 #include <array>
+#include <chrono>
 
 using namespace Aws::Utils;
 
@@ -134,3 +136,136 @@ TEST(ConcurrentCacheTest, TestPutAndGetConcurrently)
     putter.join();
     getter.join();
 }
+
+TEST(ShardedCacheTest, TestGetCachedEntry)
+{
+    ShardedCache<Aws::String, Aws::String> cache(10, 4);
+    Aws::String answer;
+    ASSERT_FALSE(cache.Get("answer", answer));
+    cache.Put("answer", "42", std::chrono::minutes(1));
+    ASSERT_TRUE(cache.Get("answer", answer));
+    ASSERT_STREQ("42", answer.c_str());
+
+    auto stats = cache.GetStatistics();
+    ASSERT_EQ(1u, stats.hits);
+    ASSERT_EQ(1u, stats.misses);
+    ASSERT_EQ(1u, stats.size);
+}
+
+TEST(ShardedCacheTest, TestExpiredEntriesAreDropped)
+{
+    ShardedCache<Aws::String, int> cache(10, 1);
+    cache.Put("past", 1, std::chrono::minutes(-1));
+    cache.Put("soon", 2, std::chrono::milliseconds(1));
+    cache.Put("later", 3, std::chrono::minutes(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    int out;
+    ASSERT_FALSE(cache.Get("past", out));
+    ASSERT_FALSE(cache.Get("soon", out));
+    ASSERT_TRUE(cache.Get("later", out));
+    ASSERT_EQ(3, out);
+
+    auto stats = cache.GetStatistics();
+    ASSERT_EQ(2u, stats.expirations);
+    ASSERT_EQ(1u, stats.size);
+}
+
+TEST(ShardedCacheTest, TestPutEvictsLeastRecentlyUsed)
+{
+    ShardedCache<Aws::String, int> cache(2, 1);
+    cache.Put("one", 1, std::chrono::minutes(5));
+    cache.Put("two", 2, std::chrono::minutes(5));
+    int out;
+    ASSERT_TRUE(cache.Get("one", out)); // "two" is now the least recently used
+    cache.Put("three", 3, std::chrono::minutes(5));
+
+    ASSERT_TRUE(cache.Get("one", out));
+    ASSERT_FALSE(cache.Get("two", out));
+    ASSERT_TRUE(cache.Get("three", out));
+    ASSERT_EQ(1u, cache.GetStatistics().evictions);
+}
+
+TEST(ShardedCacheTest, TestPutWithSameKey)
+{
+    ShardedCache<Aws::String, float> cache(2, 1);
+    cache.Put("one", 1.0f, std::chrono::minutes(5));
+    cache.Put("two", 2.0f, std::chrono::minutes(5));
+    cache.Put("one", 1.1f, std::chrono::minutes(5)); // refreshes "one", so "two" goes first
+    cache.Put("three", 3.0f, std::chrono::minutes(5));
+
+    float out;
+    ASSERT_TRUE(cache.Get("one", out));
+    ASSERT_EQ(1.1f, out);
+    ASSERT_FALSE(cache.Get("two", out));
+
+    cache.Put("one", 1.2f, std::chrono::seconds(-1));
+    ASSERT_FALSE(cache.Get("one", out));
+}
+
+TEST(ShardedCacheTest, TestEraseAndClear)
+{
+    ShardedCache<int, int> cache(100, 8);
+    for (int i = 0; i < 50; i++)
+    {
+        cache.Put(i, i * i, std::chrono::minutes(1));
+    }
+    ASSERT_EQ(50u, cache.GetStatistics().size);
+    ASSERT_TRUE(cache.Erase(7));
+    ASSERT_FALSE(cache.Erase(7));
+    int out;
+    ASSERT_FALSE(cache.Get(7, out));
+    ASSERT_TRUE(cache.Get(8, out));
+    ASSERT_EQ(64, out);
+
+    cache.Clear();
+    ASSERT_EQ(0u, cache.GetStatistics().size);
+    ASSERT_FALSE(cache.Get(8, out));
+}
+
+TEST(ShardedCacheTest, TestCapacityIsBounded)
+{
+    ShardedCache<int, int> cache(64, 4);
+    for (int i = 0; i < 1000; i++)
+    {
+        cache.Put(i, i, std::chrono::minutes(1));
+    }
+    auto stats = cache.GetStatistics();
+    ASSERT_LE(stats.size, 64u);
+    ASSERT_EQ(1000u, stats.size + stats.evictions);
+}
+
+TEST(ShardedCacheTest, TestPutAndGetConcurrently)
+{
+    ShardedCache<Aws::String, Aws::String> cache(64, 8);
+    const std::array<const char*, 8> words {{ "The", "brown", "Fox", "Jumped", "Over", "the", "lazy", "dog" }};
+    auto DoWork = [&](size_t offset)
+    {
+        Aws::String out;
+        for (size_t i = 0; i < 10000; i++)
+        {
+            const char* word = words[(i + offset) & 0x7];
+            if (i % 4 == 0)
+            {
+                cache.Put(word, word, std::chrono::minutes(1));
+            }
+            else if (cache.Get(word, out))
+            {
+                ASSERT_STREQ(word, out.c_str());
+            }
+        }
+    };
+
+    std::array<std::thread, 4> threads;
+    for (size_t i = 0; i < threads.size(); i++)
+    {
+        threads[i] = std::thread(DoWork, i);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto stats = cache.GetStatistics();
+    ASSERT_EQ(30000u, stats.hits + stats.misses);
+}
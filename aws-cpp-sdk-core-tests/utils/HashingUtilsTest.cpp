@@ -6,10 +6,17 @@
 #include <aws/external/gtest.h>
 
 #include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/CpuFeatures.h>
+#include <aws/core/utils/base64/Base64.h>
+#include <aws/core/utils/crypto/CRC32.h>
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <chrono>
+#include <functional>
 
 
 using namespace Aws::Utils;
+using namespace Aws::Utils::Crypto;
 
 TEST(HashingUtilsTest, TestBase64Encoding)
 {
@@ -81,6 +88,145 @@ TEST(HashingUtilsTest, TestHexEncodingDecoding)
     ASSERT_EQ(hexBuffer, HashingUtils::HexDecode(afterEncoding));
 }
 
+static Aws::Vector<SimdLevel> GetSupportedSimdLevels()
+{
+    Aws::Vector<SimdLevel> levels;
+    levels.push_back(SimdLevel::Scalar);
+    if (CpuFeatures::HasSSSE3())
+    {
+        levels.push_back(SimdLevel::SSSE3);
+    }
+    if (CpuFeatures::HasAVX2() && CpuFeatures::HasSSSE3())
+    {
+        levels.push_back(SimdLevel::AVX2);
+    }
+    if (CpuFeatures::HasNEON())
+    {
+        levels.push_back(SimdLevel::NEON);
+    }
+    return levels;
+}
+
+static ByteBuffer MakePatternBuffer(size_t length)
+{
+    ByteBuffer buffer(length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        buffer[i] = static_cast<unsigned char>((i * 131 + 7) ^ (i >> 8));
+    }
+    return buffer;
+}
+
+TEST(HashingUtilsTest, TestSimdCodecsMatchScalar)
+{
+    Aws::Vector<size_t> lengths;
+    // HexDecode rejects empty input.
+    for (size_t length = 1; length <= 200; ++length)
+    {
+        lengths.push_back(length);
+    }
+    lengths.push_back(1024 * 1024 + 1);
+
+    for (size_t length : lengths)
+    {
+        ByteBuffer data = MakePatternBuffer(length);
+        CpuFeatures::SetMaxSimdLevel(SimdLevel::Scalar);
+        Aws::String base64 = HashingUtils::Base64Encode(data);
+        Aws::String hex = HashingUtils::HexEncode(data);
+
+        for (SimdLevel level : GetSupportedSimdLevels())
+        {
+            CpuFeatures::SetMaxSimdLevel(level);
+            ASSERT_EQ(base64, HashingUtils::Base64Encode(data)) << "length " << length;
+            ASSERT_EQ(data, HashingUtils::Base64Decode(base64)) << "length " << length;
+            ASSERT_EQ(hex, HashingUtils::HexEncode(data)) << "length " << length;
+            ASSERT_EQ(data, HashingUtils::HexDecode(hex)) << "length " << length;
+        }
+    }
+    CpuFeatures::SetMaxSimdLevel(SimdLevel::NEON);
+}
+
+TEST(HashingUtilsTest, TestSimdCodecsFallBackToScalarOnUnexpectedInput)
+{
+    Aws::String base64 = HashingUtils::Base64Encode(MakePatternBuffer(300));
+    // Characters outside the alphabet and padding in the middle must decode the same as they always have.
+    Aws::String invalid = base64;
+    invalid[70] = '*';
+    invalid[133] = '=';
+    invalid[250] = static_cast<char>(0xC3);
+    Aws::String hex = HashingUtils::HexEncode(MakePatternBuffer(100));
+    Aws::String upperHex = hex;
+    for (auto& c : upperHex)
+    {
+        c = static_cast<char>(toupper(c));
+    }
+
+    CpuFeatures::SetMaxSimdLevel(SimdLevel::Scalar);
+    ByteBuffer expected = HashingUtils::Base64Decode(invalid);
+    for (SimdLevel level : GetSupportedSimdLevels())
+    {
+        CpuFeatures::SetMaxSimdLevel(level);
+        ASSERT_EQ(expected, HashingUtils::Base64Decode(invalid));
+        ASSERT_EQ(MakePatternBuffer(100), HashingUtils::HexDecode(upperHex));
+        ASSERT_EQ(MakePatternBuffer(100), HashingUtils::HexDecode("0x" + hex));
+    }
+    CpuFeatures::SetMaxSimdLevel(SimdLevel::NEON);
+}
+
+TEST(HashingUtilsTest, TestCodecsWriteIntoPreallocatedBuffers)
+{
+    ByteBuffer data = MakePatternBuffer(1000);
+    Base64::Base64 base64;
+    Aws::Vector<char> encoded(Base64::Base64::CalculateBase64EncodedLength(data.GetLength()));
+    ASSERT_EQ(encoded.size(), base64.Encode(data.GetUnderlyingData(), data.GetLength(), encoded.data()));
+    ASSERT_EQ(HashingUtils::Base64Encode(data), Aws::String(encoded.data(), encoded.size()));
+
+    Aws::Vector<unsigned char> decoded(Base64::Base64::CalculateBase64DecodedLength(encoded.data(), encoded.size()));
+    ASSERT_EQ(data.GetLength(), base64.Decode(encoded.data(), encoded.size(), decoded.data()));
+    ASSERT_EQ(data, ByteBuffer(decoded.data(), decoded.size()));
+
+    Aws::Vector<char> hex(2 * data.GetLength());
+    ASSERT_EQ(hex.size(), HashingUtils::HexEncode(data.GetUnderlyingData(), data.GetLength(), hex.data()));
+    ASSERT_EQ(data.GetLength(), HashingUtils::HexDecode(hex.data(), hex.size(), decoded.data()));
+    ASSERT_EQ(data, ByteBuffer(decoded.data(), decoded.size()));
+}
+
+TEST(HashingUtilsTest, BenchmarkCodecThroughput)
+{
+    static const size_t BENCHMARK_LENGTH = 4 * 1024 * 1024;
+    static const int ITERATIONS = 8;
+    ByteBuffer data = MakePatternBuffer(BENCHMARK_LENGTH);
+    Base64::Base64 base64;
+    Aws::Vector<char> encoded(Base64::Base64::CalculateBase64EncodedLength(BENCHMARK_LENGTH));
+    Aws::Vector<char> hex(2 * BENCHMARK_LENGTH);
+    Aws::Vector<unsigned char> decoded(BENCHMARK_LENGTH);
+
+    for (SimdLevel level : GetSupportedSimdLevels())
+    {
+        CpuFeatures::SetMaxSimdLevel(level);
+        auto measure = [&](const char* name, const std::function<void()>& codec)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < ITERATIONS; ++i)
+            {
+                codec();
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            const double megabytesPerSecond = ITERATIONS * BENCHMARK_LENGTH / (1024.0 * 1024.0) / (std::max)(elapsed.count(), 1e-9);
+            Aws::StringStream key;
+            key << name << "-level" << static_cast<int>(level) << "-MBps";
+            RecordProperty(key.str().c_str(), static_cast<int>(megabytesPerSecond));
+        };
+
+        measure("base64-encode", [&]() { base64.Encode(data.GetUnderlyingData(), BENCHMARK_LENGTH, encoded.data()); });
+        measure("base64-decode", [&]() { base64.Decode(encoded.data(), encoded.size(), decoded.data()); });
+        measure("hex-encode", [&]() { HashingUtils::HexEncode(data.GetUnderlyingData(), BENCHMARK_LENGTH, hex.data()); });
+        measure("hex-decode", [&]() { HashingUtils::HexDecode(hex.data(), hex.size(), decoded.data()); });
+        ASSERT_EQ(data, ByteBuffer(decoded.data(), decoded.size()));
+    }
+    CpuFeatures::SetMaxSimdLevel(SimdLevel::NEON);
+}
+
 TEST(HashingUtilsTest, TestSHA256HMAC)
 {
     const char* toHash = "TestHash";
@@ -287,6 +433,27 @@ TEST(HashingUtilsTest, TestSHA256TreeHashFromStreamWhenSizeMoreThanOneMB)
     EXPECT_STREQ("ff9ea39186cb33cd5ade7aca078e297a1622f8c1abdd4cc47bcbf66dc5877e1f", HashingUtils::HexEncode(HashingUtils::CalculateSHA256TreeHash(EightMBStream)).c_str());
 }
 
+TEST(HashingUtilsTest, TestCombineSHA256TreeHashes)
+{
+    EXPECT_STREQ(HashingUtils::HexEncode(HashingUtils::CalculateSHA256("")).c_str(),
+        HashingUtils::HexEncode(HashingUtils::CombineSHA256TreeHashes(Aws::Vector<ByteBuffer>())).c_str());
+
+    // 5.5MB, combined from 2MB parts and from 1MB parts
+    Aws::Vector<ByteBuffer> twoMBParts;
+    twoMBParts.push_back(HashingUtils::CalculateSHA256TreeHash(Aws::String(1024 * 1024 * 2, '0')));
+    twoMBParts.push_back(HashingUtils::CalculateSHA256TreeHash(Aws::String(1024 * 1024 * 2, '0')));
+    twoMBParts.push_back(HashingUtils::CalculateSHA256TreeHash(Aws::String(1024 * 1024 + 512 * 1024, '0')));
+    EXPECT_STREQ("154e26c78fd74d0c2c9b3cc4644191619dc4f2cd539ae2a74d5fd07957a3ee6a", HashingUtils::HexEncode(HashingUtils::CombineSHA256TreeHashes(twoMBParts)).c_str());
+
+    Aws::Vector<ByteBuffer> oneMBParts(5, HashingUtils::CalculateSHA256(Aws::String(1024 * 1024, '0')));
+    oneMBParts.push_back(HashingUtils::CalculateSHA256(Aws::String(512 * 1024, '0')));
+    EXPECT_STREQ("154e26c78fd74d0c2c9b3cc4644191619dc4f2cd539ae2a74d5fd07957a3ee6a", HashingUtils::HexEncode(HashingUtils::CombineSHA256TreeHashes(oneMBParts)).c_str());
+
+    // 8MB, combined from 4MB parts
+    Aws::Vector<ByteBuffer> fourMBParts(2, HashingUtils::CalculateSHA256TreeHash(Aws::String(1024 * 1024 * 4, '0')));
+    EXPECT_STREQ("ff9ea39186cb33cd5ade7aca078e297a1622f8c1abdd4cc47bcbf66dc5877e1f", HashingUtils::HexEncode(HashingUtils::CombineSHA256TreeHashes(fourMBParts)).c_str());
+}
+
 static void TestMD5FromString(const char* value, const char* expectedBase64Hash)
 {
     Aws::String source(value);
@@ -358,3 +525,72 @@ TEST(HashingUtilsTest, TestMD5FromStream)
     TestMD5FromStream( "12345678901234567890123456789012345678901234567890123456789012345678901234567890", "V+30oivjyVWsSdouIQe2eg==" );
 }
 
+TEST(HashingUtilsTest, TestCRC32FromString)
+{
+    unsigned char crc32[] = { 0xCB, 0xF4, 0x39, 0x26 };
+    ASSERT_EQ(ByteBuffer(crc32, 4), HashingUtils::CalculateCRC32("123456789"));
+    unsigned char crc32c[] = { 0xE3, 0x06, 0x92, 0x83 };
+    ASSERT_EQ(ByteBuffer(crc32c, 4), HashingUtils::CalculateCRC32C("123456789"));
+
+    unsigned char empty[] = { 0x00, 0x00, 0x00, 0x00 };
+    ASSERT_EQ(ByteBuffer(empty, 4), HashingUtils::CalculateCRC32(""));
+    ASSERT_EQ(ByteBuffer(empty, 4), HashingUtils::CalculateCRC32C(""));
+}
+
+TEST(HashingUtilsTest, TestCRC32FromStream)
+{
+    Aws::StringStream stream("The quick brown fox jumps over the lazy dog");
+    stream.seekg(10);
+    unsigned char crc32[] = { 0x41, 0x4F, 0xA3, 0x39 };
+    ASSERT_EQ(ByteBuffer(crc32, 4), HashingUtils::CalculateCRC32(stream));
+    unsigned char crc32c[] = { 0x22, 0x62, 0x04, 0x04 };
+    ASSERT_EQ(ByteBuffer(crc32c, 4), HashingUtils::CalculateCRC32C(stream));
+    // The stream is left where it was.
+    ASSERT_EQ(10, stream.tellg());
+}
+
+TEST(HashingUtilsTest, TestCRC32AcceleratedMatchesScalar)
+{
+    ByteBuffer data = MakePatternBuffer(1024 * 1024 + 13);
+    for (size_t length : { 0, 1, 7, 15, 16, 63, 64, 65, 127, 128, 200, 4096, 1024 * 1024 + 13 })
+    {
+        CpuFeatures::SetMaxSimdLevel(SimdLevel::Scalar);
+        const uint32_t crc32 = CRC32::Checksum(data.GetUnderlyingData(), length);
+        const uint32_t crc32c = CRC32C::Checksum(data.GetUnderlyingData(), length);
+        CpuFeatures::SetMaxSimdLevel(SimdLevel::NEON);
+        ASSERT_EQ(crc32, CRC32::Checksum(data.GetUnderlyingData(), length)) << "length " << length;
+        ASSERT_EQ(crc32c, CRC32C::Checksum(data.GetUnderlyingData(), length)) << "length " << length;
+    }
+}
+
+TEST(HashingUtilsTest, TestCRC32StreamingAndCombine)
+{
+    ByteBuffer data = MakePatternBuffer(100000);
+    const uint32_t whole = CRC32::Checksum(data.GetUnderlyingData(), data.GetLength());
+    const uint32_t wholeC = CRC32C::Checksum(data.GetUnderlyingData(), data.GetLength());
+
+    CRC32 crc32;
+    CRC32C crc32c;
+    for (size_t offset = 0, piece = 1; offset < data.GetLength(); offset += piece, piece = piece * 3 + 1)
+    {
+        const size_t length = (std::min)(piece, data.GetLength() - offset);
+        crc32.Update(data.GetUnderlyingData() + offset, length);
+        crc32c.Update(data.GetUnderlyingData() + offset, length);
+    }
+    ASSERT_EQ(whole, crc32.GetChecksum());
+    ASSERT_EQ(wholeC, crc32c.GetChecksum());
+    ASSERT_EQ(crc32.Calculate(Aws::String(reinterpret_cast<char*>(data.GetUnderlyingData()), data.GetLength())).GetResult(), crc32.GetHash().GetResult());
+    crc32.Reset();
+    ASSERT_EQ(0u, crc32.GetChecksum());
+
+    for (size_t split : { 0, 1, 64, 5000, 99999, 100000 })
+    {
+        const uint32_t first = CRC32::Checksum(data.GetUnderlyingData(), split);
+        const uint32_t second = CRC32::Checksum(data.GetUnderlyingData() + split, data.GetLength() - split);
+        ASSERT_EQ(whole, CRC32::Combine(first, second, data.GetLength() - split)) << "split " << split;
+
+        const uint32_t firstC = CRC32C::Checksum(data.GetUnderlyingData(), split);
+        const uint32_t secondC = CRC32C::Checksum(data.GetUnderlyingData() + split, data.GetLength() - split);
+        ASSERT_EQ(wholeC, CRC32C::Combine(firstC, secondC, data.GetLength() - split)) << "split " << split;
+    }
+}
@@ -99,7 +99,7 @@ enum class ServiceErrors
 class XmlServiceOperationResult
 {
 public:
-    XmlServiceOperationResult();
+    XmlServiceOperationResult() {}
     XmlServiceOperationResult(const Aws::AmazonWebServiceResult<Aws::Utils::Xml::XmlDocument>& result) { *this = result; };
     XmlServiceOperationResult& operator=(const Aws::AmazonWebServiceResult<Aws::Utils::Xml::XmlDocument>& result)
     {
@@ -184,7 +184,7 @@ public:
 class JsonServiceOperationResult
 {
 public:
-    JsonServiceOperationResult();
+    JsonServiceOperationResult() {}
     JsonServiceOperationResult(const Aws::AmazonWebServiceResult<Aws::Utils::Json::JsonValue>& result) { *this = result; }
     JsonServiceOperationResult& operator=(const Aws::AmazonWebServiceResult<Aws::Utils::Json::JsonValue>& result)
     {
@@ -462,4 +462,113 @@ TEST(JsonServiceNoResultOperationOutcomeTest, TestMoveFromJsonOutcome)
     ASSERT_STREQ("ServiceSpecificException", serviceError.GetExceptionName().c_str());
     ASSERT_STREQ("Error message", serviceError.GetMessage().c_str());
     ASSERT_STREQ("Detailed info", jsonServiceNoResultOperationOutcome.GetError<JsonServiceSpecificException>().GetExceptionInfo().c_str());
-}
\ No newline at end of file
+}
+
+// Counts the live instances of a result or error type, to check that an outcome only holds the one it was given.
+template<int TAG>
+class CountedValue
+{
+public:
+    CountedValue() : m_value() { ++s_liveCount; }
+    CountedValue(const Aws::String& value) : m_value(value) { ++s_liveCount; }
+    CountedValue(const CountedValue& other) : m_value(other.m_value) { ++s_liveCount; }
+    CountedValue(CountedValue&& other) : m_value(std::move(other.m_value)) { ++s_liveCount; }
+    CountedValue& operator=(const CountedValue&) = default;
+    CountedValue& operator=(CountedValue&&) = default;
+    ~CountedValue() { --s_liveCount; }
+
+    const Aws::String& GetValue() const { return m_value; }
+
+    static int s_liveCount;
+
+private:
+    Aws::String m_value;
+};
+
+template<int TAG>
+int CountedValue<TAG>::s_liveCount = 0;
+
+typedef CountedValue<0> CountedResult;
+typedef CountedValue<1> CountedError;
+typedef Outcome<CountedResult, CountedError> CountedOutcome;
+
+TEST(OutcomeTest, TestHoldsOnlyResultOrError)
+{
+    const int results = CountedResult::s_liveCount;
+    const int errors = CountedError::s_liveCount;
+    {
+        CountedOutcome success(CountedResult("result"));
+        ASSERT_EQ(results + 1, CountedResult::s_liveCount);
+        ASSERT_EQ(errors, CountedError::s_liveCount);
+
+        CountedOutcome failure(CountedError("error"));
+        ASSERT_EQ(results + 1, CountedResult::s_liveCount);
+        ASSERT_EQ(errors + 1, CountedError::s_liveCount);
+
+        CountedOutcome copy(success);
+        CountedOutcome moved(std::move(failure));
+        ASSERT_EQ(results + 2, CountedResult::s_liveCount);
+        ASSERT_EQ(errors + 2, CountedError::s_liveCount);
+        ASSERT_TRUE(copy.IsSuccess());
+        ASSERT_STREQ("result", copy.GetResult().GetValue().c_str());
+        ASSERT_FALSE(moved.IsSuccess());
+        ASSERT_STREQ("error", moved.GetError().GetValue().c_str());
+    }
+    ASSERT_EQ(results, CountedResult::s_liveCount);
+    ASSERT_EQ(errors, CountedError::s_liveCount);
+}
+
+TEST(OutcomeTest, TestAssignmentSwitchesAlternative)
+{
+    const int results = CountedResult::s_liveCount;
+    const int errors = CountedError::s_liveCount;
+    {
+        CountedOutcome outcome(CountedResult("result"));
+        outcome = CountedOutcome(CountedError("error"));
+        ASSERT_FALSE(outcome.IsSuccess());
+        ASSERT_STREQ("error", outcome.GetError().GetValue().c_str());
+        ASSERT_EQ(results, CountedResult::s_liveCount);
+        ASSERT_EQ(errors + 1, CountedError::s_liveCount);
+
+        const CountedOutcome success(CountedResult("other result"));
+        outcome = success;
+        ASSERT_TRUE(outcome.IsSuccess());
+        ASSERT_STREQ("other result", outcome.GetResult().GetValue().c_str());
+        ASSERT_EQ(results + 2, CountedResult::s_liveCount);
+        ASSERT_EQ(errors, CountedError::s_liveCount);
+
+        outcome = CountedOutcome(CountedResult("last result"));
+        ASSERT_STREQ("last result", outcome.GetResult().GetValue().c_str());
+        ASSERT_EQ(results + 2, CountedResult::s_liveCount);
+    }
+    ASSERT_EQ(results, CountedResult::s_liveCount);
+    ASSERT_EQ(errors, CountedError::s_liveCount);
+}
+
+TEST(OutcomeTest, TestDefaultOutcomeIsFailure)
+{
+    CountedOutcome defaultOutcome;
+    ASSERT_FALSE(defaultOutcome.IsSuccess());
+    ASSERT_STREQ("", defaultOutcome.GetError().GetValue().c_str());
+}
+
+TEST(OutcomeTest, TestAccessingAlternativeNotHeld)
+{
+    const int results = CountedResult::s_liveCount;
+    const int errors = CountedError::s_liveCount;
+    {
+        CountedOutcome success(CountedResult("result"));
+        ASSERT_STREQ("", success.GetError().GetValue().c_str());
+        ASSERT_EQ(errors + 1, CountedError::s_liveCount);
+
+        // The default instance belongs to the outcome: taking it doesn't affect other outcomes.
+        CountedOutcome failure(CountedError("error"));
+        CountedOutcome otherFailure(CountedError("error"));
+        CountedResult taken = failure.GetResultWithOwnership();
+        failure.GetResult() = CountedResult("changed");
+        ASSERT_STREQ("", otherFailure.GetResult().GetValue().c_str());
+        ASSERT_EQ(&failure.GetResult(), &failure.GetResult());
+    }
+    ASSERT_EQ(results, CountedResult::s_liveCount);
+    ASSERT_EQ(errors, CountedError::s_liveCount);
+}
@@ -220,6 +220,8 @@ TEST(JsonSerializerTest, TestJsonBoolValue)
     JsonValue value;
     value.WithBool("testKey", false);
     ASSERT_FALSE(value.View().GetBool("testKey"));
+    value.WithBool("testKey", true);
+    ASSERT_TRUE(value.View().GetBool("testKey"));
 
     value.AsBool(true);
     ASSERT_TRUE(value.View().AsBool());
@@ -0,0 +1,131 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+
+#include <aws/core/utils/ratelimiter/AdaptiveRateLimiter.h>
+
+using namespace Aws::Utils::RateLimits;
+
+static const char HOST[] = "dynamodb.us-east-1.amazonaws.com";
+static const char OTHER_HOST[] = "kinesis.us-east-1.amazonaws.com";
+
+class AdaptiveRateLimiterTest : public ::testing::Test
+{
+public:
+    static AdaptiveRateLimiter::InternalTimePointType m_currentTime;
+
+    static AdaptiveRateLimiter::InternalTimePointType GetTestTime() { return m_currentTime; }
+
+    static void AdvanceMilliseconds(int64_t milliseconds) { m_currentTime += std::chrono::milliseconds(milliseconds); }
+
+protected:
+    void SetUp()
+    {
+        m_currentTime = AdaptiveRateLimiter::InternalTimePointType();
+    }
+
+    // Sends requests to host at requestsPerSecond for the given time, all of them succeeding.
+    static void SendSuccessfully(AdaptiveRateLimiter& limiter, const Aws::String& host, int requestsPerSecond, int64_t milliseconds)
+    {
+        for (int64_t elapsed = 0; elapsed < milliseconds; elapsed += 1000 / requestsPerSecond)
+        {
+            limiter.AcquireSendToken(host);
+            AdvanceMilliseconds(1000 / requestsPerSecond);
+            limiter.UpdateSendRate(host, false);
+        }
+    }
+};
+
+AdaptiveRateLimiter::InternalTimePointType AdaptiveRateLimiterTest::m_currentTime;
+
+TEST_F(AdaptiveRateLimiterTest, TestNoDelayUntilThrottled)
+{
+    AdaptiveRateLimiter limiter(AdaptiveRateLimiterTest::GetTestTime);
+    ASSERT_FALSE(limiter.GetSendRateState(HOST).limiting);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(0, limiter.AcquireSendToken(HOST).count());
+        limiter.UpdateSendRate(HOST, false);
+    }
+    SendSuccessfully(limiter, HOST, 20, 3000);
+
+    auto state = limiter.GetSendRateState(HOST);
+    ASSERT_FALSE(state.limiting);
+    ASSERT_EQ(0, state.sendRate);
+    ASSERT_GT(state.measuredSendRate, 0);
+}
+
+TEST_F(AdaptiveRateLimiterTest, TestThrottlingLowersSendRate)
+{
+    AdaptiveRateLimiter limiter(AdaptiveRateLimiterTest::GetTestTime);
+    SendSuccessfully(limiter, HOST, 10, 5000);
+    ASSERT_NEAR(10, limiter.GetSendRateState(HOST).measuredSendRate, 0.5);
+
+    limiter.UpdateSendRate(HOST, true);
+    auto state = limiter.GetSendRateState(HOST);
+    ASSERT_TRUE(state.limiting);
+    ASSERT_NEAR(10, state.lastMaxRate, 0.5);
+    ASSERT_NEAR(7, state.sendRate, 0.5);
+
+    // At most a second's worth of requests at the new rate goes out at once.
+    int burst = 0;
+    for (; limiter.AcquireSendToken(HOST).count() == 0; ++burst)
+    {
+        ASSERT_LE(burst, 7);
+    }
+
+    // Past that, tokens are handed out at the new rate: each caller waits for the ones taken before it.
+    auto second = limiter.AcquireSendToken(HOST);
+    auto third = limiter.AcquireSendToken(HOST);
+    ASSERT_NEAR(1000 / state.sendRate, static_cast<double>(third.count() - second.count()), 1);
+
+    // Every further throttle cuts the rate again.
+    AdvanceMilliseconds(third.count());
+    limiter.UpdateSendRate(HOST, true);
+    ASSERT_LT(limiter.GetSendRateState(HOST).sendRate, state.sendRate);
+}
+
+TEST_F(AdaptiveRateLimiterTest, TestSendRateRecoversAfterThrottling)
+{
+    AdaptiveRateLimiter limiter(AdaptiveRateLimiterTest::GetTestTime);
+    SendSuccessfully(limiter, HOST, 10, 5000);
+    limiter.UpdateSendRate(HOST, true);
+    const double throttledRate = limiter.GetSendRateState(HOST).sendRate;
+
+    // The rate climbs back towards where it was throttled, then probes beyond it.
+    double previousRate = throttledRate;
+    for (int second = 0; second < 4; ++second)
+    {
+        SendSuccessfully(limiter, HOST, 10, 1000);
+        const double rate = limiter.GetSendRateState(HOST).sendRate;
+        ASSERT_GE(rate, previousRate);
+        previousRate = rate;
+    }
+    ASSERT_GT(previousRate, 10);
+    // It never runs ahead of twice what is actually being sent.
+    ASSERT_LE(previousRate, 2 * limiter.GetSendRateState(HOST).measuredSendRate);
+    ASSERT_TRUE(limiter.GetSendRateState(HOST).limiting);
+}
+
+TEST_F(AdaptiveRateLimiterTest, TestHostsAreLimitedIndependently)
+{
+    AdaptiveRateLimiter limiter(AdaptiveRateLimiterTest::GetTestTime);
+    SendSuccessfully(limiter, HOST, 10, 2000);
+    SendSuccessfully(limiter, OTHER_HOST, 10, 2000);
+
+    limiter.UpdateSendRate(HOST, true);
+    ASSERT_TRUE(limiter.GetSendRateState(HOST).limiting);
+    ASSERT_FALSE(limiter.GetSendRateState(OTHER_HOST).limiting);
+    AdaptiveRateLimiter::DelayType delay(0);
+    for (int i = 0; i < 20; ++i)
+    {
+        ASSERT_EQ(0, limiter.AcquireSendToken(OTHER_HOST).count());
+        delay = limiter.AcquireSendToken(HOST);
+    }
+    ASSERT_GT(delay.count(), 0);
+    ASSERT_FALSE(limiter.GetSendRateState("unknown.amazonaws.com").limiting);
+}
@@ -0,0 +1,33 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/stream/ConcurrentStreamBuf.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+
+using namespace Aws::Utils::Stream;
+
+TEST(ConcurrentStreamBufTest, TestDataAvailableHandlerRunsWhenReaderHasMore)
+{
+    ConcurrentStreamBuf streamBuf;
+    Aws::IOStream stream(&streamBuf);
+    size_t calls = 0;
+    streamBuf.SetDataAvailableHandler([&calls]() { calls++; });
+
+    // Writes stay in the writer's buffer until flushed.
+    stream << "event";
+    ASSERT_EQ(0u, calls);
+    ASSERT_EQ(0, stream.rdbuf()->in_avail());
+    stream.flush();
+    ASSERT_EQ(1u, calls);
+    ASSERT_EQ(5, stream.rdbuf()->in_avail());
+
+    streamBuf.SetEof();
+    ASSERT_EQ(2u, calls);
+
+    streamBuf.SetDataAvailableHandler(nullptr);
+    streamBuf.SetEof();
+    ASSERT_EQ(2u, calls);
+}
@@ -0,0 +1,184 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/stream/PooledStreamBuf.h>
+#include <aws/core/utils/stream/ResponseStream.h>
+#include <aws/core/utils/stream/StreamBufferPool.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <limits>
+
+using namespace Aws::Utils::Stream;
+
+static const char ALLOCATION_TAG[] = "PooledStreamBufTest";
+static const char bufferStr[] = "This is an internal buffer.";
+
+TEST(PooledStreamBufTest, TestWriteThenRead)
+{
+    PooledStreamBuf streamBuf;
+    Aws::IOStream ioStream(&streamBuf);
+    ioStream << bufferStr;
+    ASSERT_STREQ(bufferStr, streamBuf.str().c_str());
+
+    Aws::String word;
+    ioStream >> word;
+    ASSERT_STREQ("This", word.c_str());
+
+    // Data written after a read is visible to later reads.
+    ioStream.clear();
+    ioStream << " More";
+    Aws::String rest;
+    std::getline(ioStream, rest);
+    ASSERT_STREQ(" is an internal buffer. More", rest.c_str());
+    ASSERT_TRUE(ioStream.eof());
+}
+
+TEST(PooledStreamBufTest, TestEmptyBuffer)
+{
+    PooledStreamBuf streamBuf;
+    Aws::IOStream ioStream(&streamBuf);
+    ASSERT_EQ(0u, streamBuf.GetCapacity());
+    ASSERT_EQ(EOF, ioStream.get());
+
+    ioStream.clear();
+    ioStream.seekg(0, std::ios_base::end);
+    ASSERT_EQ(0, static_cast<int>(ioStream.tellg()));
+    ASSERT_STREQ("", streamBuf.str().c_str());
+}
+
+TEST(PooledStreamBufTest, TestSeek)
+{
+    PooledStreamBuf streamBuf;
+    Aws::IOStream ioStream(&streamBuf);
+    ioStream.write(bufferStr, sizeof(bufferStr) - 1);
+
+    ioStream.seekg(0, std::ios_base::end);
+    ASSERT_EQ(static_cast<std::streamoff>(sizeof(bufferStr) - 1), static_cast<std::streamoff>(ioStream.tellg()));
+
+    ioStream.seekg(5, std::ios_base::beg);
+    ioStream.seekg(3, std::ios_base::cur);
+    char read[6] = {};
+    ioStream.read(read, 5);
+    ASSERT_STREQ("an in", read);
+
+    ioStream.seekg(-7, std::ios_base::end);
+    ioStream.read(read, 5);
+    ASSERT_STREQ("buffe", read);
+
+    // Out of range seeks fail and leave the position alone.
+    ioStream.seekg(sizeof(bufferStr), std::ios_base::beg);
+    ASSERT_TRUE(ioStream.fail());
+    ioStream.clear();
+    ASSERT_EQ(static_cast<std::streamoff>(sizeof(bufferStr) - 3), static_cast<std::streamoff>(ioStream.tellg()));
+
+    // Overwrite in place.
+    ioStream.seekp(0, std::ios_base::beg);
+    ioStream.write("That", 4);
+    ASSERT_STREQ("That is an internal buffer.", streamBuf.str().c_str());
+}
+
+TEST(PooledStreamBufTest, TestReserveKeepsContentAndAvoidsGrowth)
+{
+    auto pool = Aws::MakeShared<StreamBufferPool>(ALLOCATION_TAG, 1024 * 1024, 1024 * 1024);
+    PooledStreamBuf streamBuf(pool);
+    Aws::IOStream ioStream(&streamBuf);
+    ioStream.write(bufferStr, sizeof(bufferStr) - 1);
+    ASSERT_EQ(StreamBufferPool::MIN_BUFFER_SIZE, streamBuf.GetCapacity());
+
+    ASSERT_TRUE(streamBuf.Reserve(100000));
+    ASSERT_EQ(131072u, streamBuf.GetCapacity());
+    ASSERT_STREQ(bufferStr, streamBuf.str().c_str());
+
+    const Aws::String chunk(1000, 'x');
+    for (int i = 0; i < 99; ++i)
+    {
+        ioStream.write(chunk.data(), chunk.size());
+    }
+    ASSERT_EQ(131072u, streamBuf.GetCapacity());
+    ASSERT_EQ(sizeof(bufferStr) - 1 + 99000, streamBuf.str().size());
+}
+
+TEST(PooledStreamBufTest, TestGrowthPastMaxBufferSize)
+{
+    auto pool = Aws::MakeShared<StreamBufferPool>(ALLOCATION_TAG, 1024 * 1024, 8192);
+    {
+        PooledStreamBuf streamBuf(pool);
+        Aws::IOStream ioStream(&streamBuf);
+        const Aws::String chunk(3000, 'y');
+        for (int i = 0; i < 10; ++i)
+        {
+            ioStream.write(chunk.data(), chunk.size());
+        }
+        ASSERT_EQ(Aws::String(30000, 'y'), streamBuf.str());
+    }
+    // The buffers of 4 and 8 KB went back to the pool; the larger ones were freed.
+    ASSERT_EQ(4096u + 8192u, pool->GetPooledBytes());
+}
+
+TEST(PooledStreamBufTest, TestPoolRecyclesBuffers)
+{
+    auto pool = Aws::MakeShared<StreamBufferPool>(ALLOCATION_TAG, 3 * 16384, 1024 * 1024);
+    size_t capacity = 0;
+    char* buffer = pool->Acquire(10000, capacity);
+    ASSERT_NE(nullptr, buffer);
+    ASSERT_EQ(16384u, capacity);
+    pool->Release(buffer, capacity);
+    ASSERT_EQ(16384u, pool->GetPooledBytes());
+
+    size_t reusedCapacity = 0;
+    ASSERT_EQ(buffer, pool->Acquire(16384, reusedCapacity));
+    ASSERT_EQ(16384u, reusedCapacity);
+    ASSERT_EQ(0u, pool->GetPooledBytes());
+    pool->Release(buffer, reusedCapacity);
+
+    // The pool holds at most maxPooledBytes.
+    char* buffers[4];
+    for (auto& acquired : buffers)
+    {
+        acquired = pool->Acquire(16384, capacity);
+    }
+    for (auto acquired : buffers)
+    {
+        pool->Release(acquired, capacity);
+    }
+    ASSERT_EQ(3u * 16384u, pool->GetPooledBytes());
+}
+
+TEST(PooledStreamBufTest, TestReserveBodyOnlyAppliesToDefaultStream)
+{
+    DefaultUnderlyingStream defaultStream;
+    ASSERT_TRUE(DefaultUnderlyingStream::ReserveBody(defaultStream, 50000));
+
+    defaultStream.write(bufferStr, sizeof(bufferStr) - 1);
+    Aws::String word;
+    defaultStream >> word;
+    ASSERT_STREQ("This", word.c_str());
+
+    Aws::StringStream stringStream;
+    ASSERT_FALSE(DefaultUnderlyingStream::ReserveBody(stringStream, 50000));
+
+    // Formatting state, copied along with the stream's storage, doesn't make another buffer reservable.
+    stringStream.copyfmt(defaultStream);
+    ASSERT_FALSE(DefaultUnderlyingStream::ReserveBody(stringStream, 50000));
+}
+
+TEST(PooledStreamBufTest, TestReserveBodyIsCapped)
+{
+    // A bogus Content-Length doesn't allocate its size upfront; the buffer still grows past the cap when written to.
+    DefaultUnderlyingStream stream;
+    ASSERT_TRUE(DefaultUnderlyingStream::ReserveBody(stream, (std::numeric_limits<size_t>::max)() / 2));
+    auto buf = static_cast<PooledStreamBuf*>(stream.rdbuf());
+    const size_t reserved = buf->GetCapacity();
+    ASSERT_GE(reserved, 8u * 1024 * 1024);
+    ASSERT_LE(reserved, 16u * 1024 * 1024);
+
+    Aws::String chunk(1024 * 1024, 'x');
+    for (size_t written = 0; written <= reserved; written += chunk.size())
+    {
+        stream.write(chunk.c_str(), static_cast<std::streamsize>(chunk.size()));
+    }
+    ASSERT_TRUE(stream.good());
+    ASSERT_GT(buf->GetCapacity(), reserved);
+}
@@ -6,8 +6,12 @@
 #include <aws/external/gtest.h>
 #include <aws/core/utils/threading/Executor.h>
 #include <aws/core/utils/threading/Semaphore.h>
+#include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
 #include <atomic>
 #include <chrono>
+#include <mutex>
+#include <thread>
 
 using namespace Aws::Utils::Threading;
 
@@ -38,3 +42,127 @@ TEST(DefaultExecutor, ThreadsDetachIfNotShuttingDown)
     i = i * 10;
     ASSERT_EQ(20, i.load());
 }
+
+TEST(SharedThreadPool, RunsQueuedTasksBeforeShutdown)
+{
+    std::atomic<int> count(0);
+    SharedThreadPool pool(2, 100);
+    auto executor = pool.CreateExecutor();
+    for (int i = 0; i < 50; ++i)
+    {
+        ASSERT_TRUE(executor->Submit([&] { count++; }));
+    }
+    pool.Shutdown();
+    ASSERT_EQ(50, count.load());
+
+    // Rejected after shutdown, so run on this thread instead.
+    bool rejected = false;
+    bool rejectedAgain = true;
+    ASSERT_FALSE(executor->Submit([&] { rejected = ClaimTaskRejection(); rejectedAgain = ClaimTaskRejection(); count++; }));
+    ASSERT_TRUE(rejected);
+    ASSERT_FALSE(rejectedAgain);
+    ASSERT_EQ(51, count.load());
+    ASSERT_FALSE(ClaimTaskRejection());
+}
+
+TEST(SharedThreadPool, ExecutorsTakeTurns)
+{
+    SharedThreadPool pool(1, 100);
+    auto busyExecutor = pool.CreateExecutor();
+    auto otherExecutor = pool.CreateExecutor();
+    Semaphore blocker(0, 1);
+    std::atomic<bool> started(false);
+    std::mutex orderLock;
+    Aws::Vector<int> order;
+    auto record = [&](int id) { std::lock_guard<std::mutex> locker(orderLock); order.push_back(id); };
+
+    busyExecutor->Submit([&] { started = true; blocker.WaitOne(); });
+    while (!started)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (int i = 0; i < 10; ++i)
+    {
+        busyExecutor->Submit(record, 0);
+    }
+    otherExecutor->Submit(record, 1);
+    blocker.Release();
+    pool.Shutdown();
+
+    ASSERT_EQ(11u, order.size());
+    // The single task of the other executor runs right after the first queued task of the busy one, not after all ten.
+    ASSERT_EQ(1, order[1]);
+}
+
+TEST(SharedThreadPool, FullQueueQueuesRejectsOrWaits)
+{
+    for (auto policy : {OverflowPolicy::QUEUE_TASKS_EVENLY_ACCROSS_THREADS, OverflowPolicy::REJECT_IMMEDIATELY,
+        OverflowPolicy::BLOCK_WHEN_QUEUE_FULL})
+    {
+        SharedThreadPool pool(1, 2, policy);
+        auto executor = pool.CreateExecutor();
+        Semaphore blocker(0, 1);
+        std::atomic<bool> started(false);
+        ASSERT_TRUE(executor->Submit([&] { started = true; blocker.WaitOne(); }));
+        while (!started)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ASSERT_TRUE(executor->Submit([] {}));
+        ASSERT_TRUE(executor->Submit([] {}));
+
+        if (policy == OverflowPolicy::QUEUE_TASKS_EVENLY_ACCROSS_THREADS)
+        {
+            ASSERT_TRUE(executor->Submit([] {}));
+            blocker.Release();
+            continue;
+        }
+
+        // TrySubmit neither waits for room nor runs the task on this thread.
+        bool ranHere = false;
+        ASSERT_FALSE(executor->TrySubmit([&] { ranHere = true; }));
+        ASSERT_FALSE(ranHere);
+
+        if (policy == OverflowPolicy::REJECT_IMMEDIATELY)
+        {
+            const auto submitterId = std::this_thread::get_id();
+            std::thread::id runnerId;
+            ASSERT_FALSE(executor->Submit([&] { runnerId = std::this_thread::get_id(); }));
+            ASSERT_EQ(submitterId, runnerId);
+            blocker.Release();
+            continue;
+        }
+
+        std::atomic<bool> submitted(false);
+        std::thread submitter([&] { executor->Submit([] {}); submitted = true; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        ASSERT_FALSE(submitted.load());
+        blocker.Release();
+        submitter.join();
+        ASSERT_TRUE(submitted.load());
+    }
+}
+
+TEST(SharedThreadPool, ClientConfigurationUsesSharedPoolOnlyWhenEnabled)
+{
+    ASSERT_EQ(nullptr, GetSharedThreadPool());
+    {
+        Aws::Client::ClientConfiguration config;
+        ASSERT_NE(nullptr, std::dynamic_pointer_cast<DefaultExecutor>(config.executor));
+    }
+
+    InitSharedThreadPool(2, 16, OverflowPolicy::BLOCK_WHEN_QUEUE_FULL);
+    {
+        ASSERT_NE(nullptr, GetSharedThreadPool());
+        Aws::Client::ClientConfiguration config;
+        ASSERT_EQ(nullptr, std::dynamic_pointer_cast<DefaultExecutor>(config.executor));
+
+        Semaphore done(0, 1);
+        std::atomic<bool> ran(false);
+        ASSERT_TRUE(config.executor->Submit([&] { ran = true; done.Release(); }));
+        done.WaitOne();
+        ASSERT_TRUE(ran.load());
+    }
+    CleanupSharedThreadPool();
+    ASSERT_EQ(nullptr, GetSharedThreadPool());
+}
@@ -68,6 +68,7 @@ namespace Aws
 
         /**
          * Defaults to false, if this is set to true in derived class, it's an event stream request, which means the payload is consisted by multiple structured events.
+         * GetBody() of an event stream request must return an Aws::Utils::Event::EventEncoderStream.
          */
         inline virtual bool IsEventStreamRequest() const { return false; }
         /**
@@ -96,7 +97,11 @@ namespace Aws
         /**
          * Set the response stream factory.
          */
-        void SetResponseStreamFactory(const Aws::IOStreamFactory& factory) { m_responseStreamFactory = factory; }
+        void SetResponseStreamFactory(const Aws::IOStreamFactory& factory) { m_responseStreamFactory = factory; m_customResponseStreamFactory = true; }
+        /**
+         * Whether SetResponseStreamFactory was called, replacing the default factory.
+         */
+        bool HasCustomResponseStreamFactory() const { return m_customResponseStreamFactory; }
         /**
          * Register closure for data received event.
          */
@@ -161,6 +166,7 @@ namespace Aws
 
     private:
         Aws::IOStreamFactory m_responseStreamFactory;
+        bool m_customResponseStreamFactory;
 
         Aws::Http::DataReceivedEventHandler m_onDataReceived;
         Aws::Http::DataSentEventHandler m_onDataSent;
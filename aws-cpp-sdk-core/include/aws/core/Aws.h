@@ -10,6 +10,7 @@
 #include <aws/core/utils/crypto/Factories.h>
 #include <aws/core/http/HttpClientFactory.h>
 #include <aws/core/monitoring/MonitoringManager.h>
+#include <aws/core/utils/threading/Executor.h>
 #include <aws/core/Core_EXPORTS.h>
 
 namespace Aws
@@ -62,7 +63,8 @@ namespace Aws
      */
     struct HttpOptions
     {
-        HttpOptions() : initAndCleanupCurl(true), installSigPipeHandler(false)
+        HttpOptions() : initAndCleanupCurl(true), installSigPipeHandler(false),
+            responseBufferPoolSize(32 * 1024 * 1024), maxPooledResponseBufferSize(8 * 1024 * 1024)
         { }
 
         /**
@@ -82,6 +84,15 @@ namespace Aws
          * NOTE: CURLOPT_NOSIGNAL is already being set.
          */
         bool installSigPipeHandler;
+        /**
+         * Bytes of response buffers kept for reuse by later responses once the results holding them are destroyed.
+         * Defaults to 32 MB. Set to 0 to allocate every response buffer afresh.
+         */
+        size_t responseBufferPoolSize;
+        /**
+         * Largest response buffer kept for reuse. Defaults to 8 MB; larger bodies are allocated and freed directly.
+         */
+        size_t maxPooledResponseBufferSize;
     };
 
     /**
@@ -136,6 +147,38 @@ namespace Aws
         bool initAndCleanupOpenSSL;
     };
 
+    /**
+     * SDK wide options for the threads running the Async and Callable operations of service clients
+     */
+    struct ExecutorOptions
+    {
+        ExecutorOptions() : useSharedThreadPool(false), poolSize(0), maxQueuedTasksPerClient(1024),
+            overflowPolicy(Aws::Utils::Threading::OverflowPolicy::BLOCK_WHEN_QUEUE_FULL)
+        { }
+
+        /**
+         * Defaults to false: every ClientConfiguration gets a DefaultExecutor, which starts a thread per call.
+         * If set to true, a thread pool is started with the SDK and every ClientConfiguration gets an executor of it,
+         * unless its executor is replaced. Async handlers then run on the pool's fixed set of threads, and must not wait
+         * on the future of a Callable call, see Aws::Utils::Threading::SharedThreadPool.
+         */
+        bool useSharedThreadPool;
+        /**
+         * Number of threads of the pool. Defaults to 0, which means twice the number of cores, and at least 4.
+         */
+        size_t poolSize;
+        /**
+         * Calls queued per client configuration before the overflow policy applies. Defaults to 1024.
+         */
+        size_t maxQueuedTasksPerClient;
+        /**
+         * What an Async or Callable call does when its client's queue is full. Defaults to BLOCK_WHEN_QUEUE_FULL, which waits
+         * for room in the queue; QUEUE_TASKS_EVENLY_ACCROSS_THREADS queues it anyway, and REJECT_IMMEDIATELY fails the call,
+         * calling its handler with an error on the calling thread.
+         */
+        Aws::Utils::Threading::OverflowPolicy overflowPolicy;
+    };
+
     /**
     * MonitoringOptions is used to set up monitoring functionalities globally and(or) for users to customize monitoring listeners.
     */
@@ -216,6 +259,10 @@ namespace Aws
          * Basic usage can be found in aws-cpp-sdk-core-tests/monitoring/MonitoringTest.cpp
          */
         MonitoringOptions monitoringOptions;
+        /**
+         * SDK wide options for the threads running asynchronous operations
+         */
+        ExecutorOptions executorOptions;
     };
 
     /*
@@ -143,6 +143,11 @@ namespace Aws
              */
             virtual const char* GetName() const = 0;
 
+            /**
+             * Return the name of the service the signer signs for, empty if it isn't tied to one.
+             */
+            virtual Aws::String GetServiceName() const { return Aws::String(); }
+
             /**
              * This handles detection of clock skew between clients and the server and adjusts the clock so that the next request will not
              * fail on the timestamp check.
@@ -271,7 +276,7 @@ namespace Aws
             */
             bool PresignRequest(Aws::Http::HttpRequest& request, const char* region, const char* serviceName, long long expirationInSeconds = 0) const override;
 
-            Aws::String GetServiceName() const { return m_serviceName; }
+            Aws::String GetServiceName() const override { return m_serviceName; }
             Aws::String GetRegion() const { return m_region; }
             Aws::String GenerateSignature(const Aws::Auth::AWSCredentials& credentials,
                     const Aws::String& stringToSign, const Aws::String& simpleDate) const;
@@ -8,12 +8,14 @@
 #include <aws/core/Core_EXPORTS.h>
 #include <aws/core/client/CoreErrors.h>
 #include <aws/core/http/HttpTypes.h>
+#include <aws/core/http/Scheme.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
 #include <aws/core/AmazonWebServiceResult.h>
 #include <aws/core/utils/crypto/Hash.h>
 #include <aws/core/auth/AWSAuthSignerProvider.h>
 #include <memory>
 #include <atomic>
+#include <chrono>
 
 struct aws_array_list;
 
@@ -37,12 +39,18 @@ namespace Aws
         namespace RateLimits
         {
             class RateLimiterInterface;
+            class AdaptiveRateLimiter;
         } // namespace RateLimits
 
         namespace Crypto
         {
             class MD5;
         } // namespace Crypto
+
+        namespace Threading
+        {
+            class Executor;
+        } // namespace Threading
     } // namespace Utils
 
     namespace Http
@@ -58,6 +66,11 @@ namespace Aws
         class URI;
     } // namespace Http
 
+    namespace Monitoring
+    {
+        struct CoreMetricsCollection;
+    } // namespace Monitoring
+
     namespace Auth
     {
         AWS_CORE_API extern const char SIGV4_SIGNER[];
@@ -75,6 +88,9 @@ namespace Aws
         class AWSAuthSigner;
         struct ClientConfiguration;
         class RetryStrategy;
+        class ResponseCache;
+        struct CachedResponse;
+        class HedgingPolicy;
 
         typedef Utils::Outcome<std::shared_ptr<Aws::Http::HttpResponse>, AWSError<CoreErrors>> HttpResponseOutcome;
         typedef Utils::Outcome<AmazonWebServiceResult<Utils::Stream::ResponseStream>, AWSError<CoreErrors>> StreamOutcome;
@@ -161,6 +177,14 @@ namespace Aws
              */
             void EnableRequestProcessing();
 
+            /**
+             * Opens up to connections connections to the endpoint of the client configuration before traffic arrives, and returns
+             * the number opened. That is endpointOverride if set, otherwise the regional endpoint named after the service the client
+             * signs for, e.g. "https://dynamodb.us-east-1.amazonaws.com"; set endpointOverride for services whose endpoint is named
+             * otherwise. See HttpClient::WarmUpConnections.
+             */
+            size_t WarmUpConnections(size_t connections);
+
             inline virtual const char* GetServiceClientName() const { return m_serviceName.c_str(); }
             /**
              * service client name is part of userAgent.
@@ -295,6 +319,32 @@ namespace Aws
                                          bool needsContentMd5 = false, bool isChunked = false) const;
             void AddCommonHeaders(Aws::Http::HttpRequest& httpRequest) const;
             void InitializeGlobalStatics();
+            std::shared_ptr<Aws::Http::HttpResponse> CreateResponseFromCache(const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest,
+                const CachedResponse& cachedResponse) const;
+            void StoreInResponseCache(const Aws::String& cacheKey, std::chrono::milliseconds timeToLive,
+                const std::shared_ptr<Aws::Http::HttpResponse>& response) const;
+            /**
+             * Waits for a send token from the request rate limiter, if any, before an attempt.
+             */
+            void AcquireSendToken(const Aws::Http::HttpRequest& httpRequest, Aws::Monitoring::CoreMetricsCollection& coreMetrics) const;
+            /**
+             * Feeds the outcome of an attempt back to the request rate limiter, if any.
+             */
+            void UpdateSendRate(const Aws::Http::HttpRequest& httpRequest, const HttpResponseOutcome& outcome,
+                Aws::Monitoring::CoreMetricsCollection& coreMetrics) const;
+            /**
+             * Builds httpRequest from request and signs it. Returns false if signing failed.
+             */
+            bool PrepareAttempt(const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest, const Aws::AmazonWebServiceRequest& request,
+                const char* signerName, const char* signerRegionOverride, const char* signerServiceNameOverride) const;
+            /**
+             * Same as AttemptOneRequest, but sends httpRequest from the client's executor and, if it is slow to answer as the
+             * hedging policy decides, sends a copy of it from the calling thread. On return, httpRequest is the copy whose
+             * response was returned.
+             */
+            HttpResponseOutcome AttemptHedged(std::shared_ptr<Aws::Http::HttpRequest>& httpRequest, const Aws::AmazonWebServiceRequest& request,
+                const char* signerName, const char* signerRegionOverride, const char* signerServiceNameOverride,
+                Aws::Monitoring::CoreMetricsCollection& coreMetrics) const;
             std::shared_ptr<Aws::Http::HttpRequest> ConvertToRequestForPresigning(const Aws::AmazonWebServiceRequest& request, Aws::Http::URI& uri,
                 Aws::Http::HttpMethod method, const Aws::Http::QueryStringParameterCollection& extraParams) const;
 
@@ -309,6 +359,13 @@ namespace Aws
             std::shared_ptr<Aws::Utils::Crypto::Hash> m_hash;
             long m_requestTimeoutMs;
             bool m_enableClockSkewAdjustment;
+            std::shared_ptr<ResponseCache> m_responseCache;
+            std::shared_ptr<Aws::Utils::RateLimits::AdaptiveRateLimiter> m_requestRateLimiter;
+            std::shared_ptr<HedgingPolicy> m_hedgingPolicy;
+            std::shared_ptr<Aws::Utils::Threading::Executor> m_executor;
+            Aws::Http::Scheme m_scheme;
+            Aws::String m_endpointOverride;
+            bool m_useDualStack;
             Aws::String m_serviceName;
         };
 
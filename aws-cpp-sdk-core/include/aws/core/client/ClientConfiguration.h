@@ -24,11 +24,14 @@ namespace Aws
         namespace RateLimits
         {
             class RateLimiterInterface;
+            class AdaptiveRateLimiter;
         } // namespace RateLimits
     } // namespace Utils
     namespace Client
     {
         class RetryStrategy; // forward declare
+        class ResponseCache;
+        class HedgingPolicy;
 
         /**
          * Sets the behaviors of the underlying HTTP clients handling response with 30x status code.
@@ -165,7 +168,8 @@ namespace Aws
             */
             Aws::String proxySSLKeyPassword;
             /**
-            * Threading Executor implementation. Default uses std::thread::detach()
+            * Threading Executor implementation. Defaults to one detaching a std::thread per call, or to an executor of the
+            * thread pool the SDK shares between clients if that pool is enabled, see Aws::ExecutorOptions.
             */
             std::shared_ptr<Aws::Utils::Threading::Executor> executor;
             /**
@@ -213,6 +217,65 @@ namespace Aws
              */
             bool disableExpectHeader;
 
+            /**
+             * Only works for Curl http client.
+             * If set to true, the client shares its DNS cache and TLS sessions with every other client that has this option
+             * set and the same TLS and proxy settings, so that the connections a new client opens skip the DNS lookup and
+             * resume a TLS session instead of doing a full handshake. Each client still has its own connections.
+             * Connection reuse and handshakes are reported through the ConnectionReused and SslHandshakes http client metrics.
+             * The default value will be false.
+             */
+            bool shareConnections;
+
+            /**
+             * Only works for Curl http client, with libcurl 7.68 or later.
+             * If set to true, requests are sent as HTTP/2 streams multiplexed over at most http2MaxConnectionsPerHost
+             * connections to each host, each carrying up to http2MaxStreamsPerConnection concurrent streams. Requests beyond
+             * that wait in a queue ordered by HttpRequest::GetStreamWeight(). Hosts that do not speak HTTP/2 get one request
+             * per connection as usual. maxConnections still bounds the number of concurrent requests of the client.
+             * Requests made with a read or write rate limiter are not multiplexed.
+             * The number of requests sharing a connection is reported through the StreamsPerConnection http client metric.
+             * The default value will be false.
+             */
+            bool enableHttp2Multiplexing;
+
+            /**
+             * Most connections opened to a host when enableHttp2Multiplexing is set. Defaults to 2.
+             */
+            unsigned http2MaxConnectionsPerHost;
+
+            /**
+             * Most concurrent streams on one connection when enableHttp2Multiplexing is set; the server may allow fewer.
+             * Defaults to 100.
+             */
+            unsigned http2MaxStreamsPerConnection;
+
+            /**
+             * Only works for Curl http client.
+             * Connections are closed and replaced once they have been open this long, so that traffic moves to new hosts
+             * behind the endpoint. 0 means no limit. Not applied when enableHttp2Multiplexing is set.
+             * The default value will be 0.
+             */
+            unsigned long connectionMaxAgeMs;
+
+            /**
+             * Only works for Curl http client.
+             * Connections are closed and replaced once they have carried this many requests. 0 means no limit. Not applied
+             * when enableHttp2Multiplexing is set.
+             * The default value will be 0.
+             */
+            unsigned connectionMaxRequests;
+
+            /**
+             * Only works for Curl http client.
+             * If not 0, idle connections are checked this often: HTTP/2 connections are pinged to keep them open, and
+             * connections the server closed or past connectionMaxAgeMs are dropped, so that requests don't find them dead.
+             * Connections open and idle when a request starts are reported through the WarmConnections http client metric,
+             * see HttpClient::WarmUpConnections to open them ahead of traffic.
+             * The default value will be 0.
+             */
+            unsigned long connectionHealthCheckIntervalMs;
+
             /**
              * If set to true clock skew will be adjusted after each http attempt, default to true.
              */
@@ -239,6 +302,25 @@ namespace Aws
              */
             Aws::String profileName;
 
+            /**
+             * Cache of responses to idempotent read operations, which can be shared by several clients.
+             * Defaults to nullptr, no caching. See ResponseCache for the operations it applies to.
+             */
+            std::shared_ptr<ResponseCache> responseCache;
+
+            /**
+             * Request rate limiter that slows down requests to an endpoint once it starts throttling them, and speeds
+             * them up again as it stops. Share one between clients to share what each endpoint tolerates.
+             * Defaults to nullptr, no limiting. Its state is reported in CoreMetricsCollection::sendRateState.
+             */
+            std::shared_ptr<Aws::Utils::RateLimits::AdaptiveRateLimiter> requestRateLimiter;
+
+            /**
+             * Policy that sends a second copy of an attempt of an idempotent read when it is slower than usual, and returns
+             * whichever answers first. Defaults to nullptr, no hedging. See HedgingPolicy for the operations it applies to.
+             */
+            std::shared_ptr<HedgingPolicy> hedgingPolicy;
+
         };
 
     } // namespace Client
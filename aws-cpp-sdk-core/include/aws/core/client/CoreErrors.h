@@ -75,5 +75,11 @@ namespace Aws
              */
             AWS_CORE_API AWSError<CoreErrors> GetErrorForHttpResponseCode(Aws::Http::HttpResponseCode code);
         } // namespace CoreErrorsMapper
+
+        /**
+         * Returns true if the error means the service is throttling the client, either by its type, its exception name
+         * (which covers service specific errors such as ProvisionedThroughputExceededException) or a 429 response code.
+         */
+        AWS_CORE_API bool IsThrottlingError(const AWSError<CoreErrors>& error);
     } // namespace Client
 } // namespace Aws
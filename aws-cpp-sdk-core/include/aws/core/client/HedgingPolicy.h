@@ -0,0 +1,151 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSSet.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace Aws
+{
+    namespace Client
+    {
+        /**
+         * Settings of a HedgingPolicy.
+         */
+        struct AWS_CORE_API HedgingPolicyConfiguration
+        {
+            HedgingPolicyConfiguration();
+
+            /**
+             * Operations that are hedged, by request name (e.g. "GetItem"). Only list idempotent reads: the hedge is a
+             * second copy of the request. Requests with a streaming body or a custom response stream factory are never
+             * hedged, since both attempts would share the same stream.
+             */
+            Aws::Set<Aws::String> operations;
+
+            /**
+             * An attempt still unanswered after this percentile of the operation's recent latencies is hedged. Defaults to 95.
+             */
+            double delayPercentile;
+
+            /**
+             * Bounds of the hedge delay. Default to 1 ms and 10 seconds.
+             */
+            std::chrono::milliseconds minDelay;
+            std::chrono::milliseconds maxDelay;
+
+            /**
+             * Number of recent latencies kept per operation. Defaults to 1024.
+             */
+            size_t latencySamples;
+
+            /**
+             * An operation is not hedged until this many of its latencies are known. Defaults to 100.
+             */
+            size_t minLatencySamples;
+
+            /**
+             * Hedges allowed, as a percentage of the attempts of hedged operations, which bounds the extra load they cause.
+             * Defaults to 5.
+             */
+            double budgetPercent;
+
+            /**
+             * Most hedges the budget can save up for a burst. Defaults to 10.
+             */
+            double maxBudget;
+        };
+
+        /**
+         * Counters of a HedgingPolicy.
+         */
+        struct AWS_CORE_API HedgingStatistics
+        {
+            HedgingStatistics() : attempts(0), hedges(0), hedgesWon(0), hedgesDenied(0) {}
+
+            /** Attempts of hedged operations. */
+            uint64_t attempts;
+            /** Hedges sent. */
+            uint64_t hedges;
+            /** Hedges answered successfully before the attempt they hedged. */
+            uint64_t hedgesWon;
+            /** Hedges not sent because the budget was spent. */
+            uint64_t hedgesDenied;
+        };
+
+        /**
+         * Opt-in hedging of slow attempts, shared by every client whose ClientConfiguration::hedgingPolicy points to it.
+         *
+         * When an attempt of a listed operation takes longer than a percentile of that operation's recent latencies, the
+         * client sends a second copy of it. Both run concurrently, each on a connection of its own, and the first attempt to
+         * receive a successful response wins; the other attempt is cancelled through its continuation handler. Only the
+         * winner's data reaches the request's data received handler. A budget earned by the attempts bounds the number of hedges.
+         * The first attempt is sent from the client's executor (ClientConfiguration::executor) while the calling thread waits
+         * out the hedge delay, then sends the hedge itself. If the executor can't take the first attempt right away, it is sent
+         * from the calling thread and not hedged.
+         * Thread safe.
+         */
+        class AWS_CORE_API HedgingPolicy
+        {
+        public:
+            explicit HedgingPolicy(const HedgingPolicyConfiguration& configuration = HedgingPolicyConfiguration());
+
+            HedgingPolicy(const HedgingPolicy&) = delete;
+            HedgingPolicy& operator=(const HedgingPolicy&) = delete;
+
+            bool IsHedged(const Aws::String& requestName) const;
+
+            /**
+             * Starts an attempt of requestName: earns the budget its share of a hedge and gets how long the attempt may
+             * take before it is hedged. Returns false, and the attempt should not be hedged, while too few latencies of the
+             * operation are known.
+             */
+            bool StartAttempt(const Aws::String& requestName, std::chrono::microseconds& hedgeDelay);
+
+            /**
+             * Records the latency of a successful attempt. For a hedged request, that is the latency of the first attempt,
+             * whichever attempt won.
+             */
+            void RecordLatency(const Aws::String& requestName, std::chrono::microseconds latency);
+
+            /**
+             * Takes a hedge from the budget, right before it is sent. Returns false if it is spent.
+             */
+            bool AcquireHedge();
+
+            void RecordHedgeWon();
+
+            HedgingStatistics GetStatistics() const;
+
+            const HedgingPolicyConfiguration& GetConfiguration() const { return m_configuration; }
+
+        private:
+            struct OperationLatencies
+            {
+                OperationLatencies() : next(0), samplesSinceUpdate(0), hedgeDelay(0) {}
+
+                Aws::Vector<int64_t> samples;
+                size_t next;
+                size_t samplesSinceUpdate;
+                std::chrono::microseconds hedgeDelay;
+            };
+
+            void UpdateHedgeDelay(OperationLatencies& latencies) const;
+
+            HedgingPolicyConfiguration m_configuration;
+            mutable std::mutex m_lock;
+            Aws::Map<Aws::String, OperationLatencies> m_latencies;
+            double m_budget;
+            HedgingStatistics m_statistics;
+        };
+    } // namespace Client
+} // namespace Aws
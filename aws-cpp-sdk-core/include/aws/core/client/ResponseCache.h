@@ -0,0 +1,205 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/http/HttpTypes.h>
+#include <aws/core/http/HttpResponse.h>
+#include <aws/core/utils/memory/stl/AWSList.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <chrono>
+#include <mutex>
+
+namespace Aws
+{
+    class AmazonWebServiceRequest;
+
+    namespace Http
+    {
+        class HttpRequest;
+        class URI;
+    } // namespace Http
+
+    namespace Client
+    {
+        /**
+         * Settings of a ResponseCache.
+         */
+        struct AWS_CORE_API ResponseCacheConfiguration
+        {
+            ResponseCacheConfiguration();
+
+            /**
+             * Upper bound on the total size of the cached bodies and headers. Least recently used entries are evicted beyond it.
+             * Defaults to 32 MB.
+             */
+            size_t maxBytes;
+
+            /**
+             * Responses larger than this are never cached. Defaults to 1 MB.
+             */
+            size_t maxEntryBytes;
+
+            /**
+             * Operations whose responses are cached, by request name (e.g. "GetObject"), with how long a cached response is
+             * served without contacting the service. Once that time has passed, a response carrying an ETag or Last-Modified
+             * header is revalidated with a conditional request; a time to live of zero revalidates on every call.
+             * Only list operations that are idempotent reads: the cache does not know which operations modify what.
+             */
+            Aws::Map<Aws::String, std::chrono::milliseconds> operationTimeToLive;
+        };
+
+        /**
+         * A response kept by ResponseCache.
+         */
+        struct AWS_CORE_API CachedResponse
+        {
+            CachedResponse();
+
+            Aws::String GetETag() const;
+            Aws::String GetLastModified() const;
+
+            /**
+             * Whether the service can tell if this response is still current, i.e. it has an ETag or Last-Modified header.
+             */
+            bool HasValidators() const { return !GetETag().empty() || !GetLastModified().empty(); }
+
+            /**
+             * Sets If-None-Match and If-Modified-Since on request from the ETag and Last-Modified of this response.
+             */
+            void AddValidatorsTo(Aws::Http::HttpRequest& request) const;
+
+            /**
+             * Writes the response code, headers and body into response, whose body stream must be empty.
+             */
+            void WriteTo(Aws::Http::HttpResponse& response) const;
+
+            Aws::Http::HttpResponseCode responseCode;
+            Aws::Http::HeaderValueCollection headers;
+            Aws::String body;
+            /**
+             * CoarseClock time, in milliseconds, until which the response is served without revalidation.
+             */
+            int64_t freshUntil;
+        };
+
+        /**
+         * Outcome of looking a request up in a ResponseCache.
+         */
+        enum class ResponseCacheLookup
+        {
+            /** Nothing usable is cached; the request is sent as is. */
+            Miss,
+            /** A fresh response is cached and can be returned without contacting the service. */
+            Fresh,
+            /** A stale response with validators is cached; the request is sent conditionally. */
+            Stale
+        };
+
+        /**
+         * Counters of a ResponseCache.
+         */
+        struct AWS_CORE_API ResponseCacheStatistics
+        {
+            ResponseCacheStatistics() : hits(0), misses(0), revalidations(0), evictions(0), entries(0), bytes(0) {}
+
+            /** Lookups answered from memory without contacting the service. */
+            uint64_t hits;
+            /** Lookups that could not be answered from memory, including those of stale entries sent for revalidation. */
+            uint64_t misses;
+            /** Stale entries the service confirmed were still current. */
+            uint64_t revalidations;
+            /** Entries removed to stay within maxBytes. */
+            uint64_t evictions;
+            /** Entries currently held. */
+            size_t entries;
+            /** Bytes currently held. */
+            size_t bytes;
+        };
+
+        /**
+         * Opt-in, in-memory cache of raw HTTP responses for idempotent read operations, shared by every client whose
+         * ClientConfiguration::responseCache points to it.
+         *
+         * Responses are keyed by the canonical form of the request (method, URI with query string, headers set by the
+         * request and a digest of the body), so two calls that would send the same request share an entry.
+         * Only successful responses are cached. The cache is bounded by bytes and evicts the least recently used entries.
+         * Keys do not include credentials, so only share a cache between clients acting as the same identity.
+         * Thread safe.
+         */
+        class AWS_CORE_API ResponseCache
+        {
+        public:
+            explicit ResponseCache(const ResponseCacheConfiguration& configuration = ResponseCacheConfiguration());
+
+            ResponseCache(const ResponseCache&) = delete;
+            ResponseCache& operator=(const ResponseCache&) = delete;
+
+            /**
+             * Returns whether responses of the operation requestName are cached, and if so sets timeToLive.
+             */
+            bool GetTimeToLive(const Aws::String& requestName, std::chrono::milliseconds& timeToLive) const;
+
+            /**
+             * Whether request sets conditional headers of its own, in which case it bypasses the cache.
+             */
+            static bool IsConditional(const Aws::AmazonWebServiceRequest& request);
+
+            /**
+             * Canonical form of request sent with method to uri, used as its cache key. The position of the body stream is
+             * left unchanged.
+             */
+            static Aws::String ComputeKey(const Aws::Http::URI& uri, Aws::Http::HttpMethod method, const Aws::AmazonWebServiceRequest& request);
+
+            /**
+             * Looks key up. Unless the result is Miss, response receives the cached entry.
+             */
+            ResponseCacheLookup Lookup(const Aws::String& key, CachedResponse& response);
+
+            /**
+             * Adds or replaces the entry for key. Responses larger than maxEntryBytes are ignored.
+             */
+            void Put(const Aws::String& key, CachedResponse&& response);
+
+            /**
+             * Marks the entry for key fresh for timeToLive more, after the service confirmed it is still current.
+             * Returns false, leaving response untouched, if the entry was evicted in the meantime.
+             */
+            bool Refresh(const Aws::String& key, std::chrono::milliseconds timeToLive, CachedResponse& response);
+
+            /**
+             * Removes the entry for key, if any. Returns whether there was one.
+             */
+            bool Erase(const Aws::String& key);
+
+            /**
+             * Removes every entry. Counters are kept.
+             */
+            void Clear();
+
+            ResponseCacheStatistics GetStatistics() const;
+
+            const ResponseCacheConfiguration& GetConfiguration() const { return m_configuration; }
+
+        private:
+            struct Entry
+            {
+                Aws::String key;
+                CachedResponse response;
+                size_t size;
+            };
+
+            void EvictIfNeeded();
+
+            ResponseCacheConfiguration m_configuration;
+            mutable std::mutex m_mutex;
+            Aws::List<Entry> m_entries;
+            Aws::Map<Aws::String, Aws::List<Entry>::iterator> m_index;
+            ResponseCacheStatistics m_statistics;
+        };
+    } // namespace Client
+} // namespace Aws
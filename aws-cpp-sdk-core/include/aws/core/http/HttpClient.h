@@ -6,9 +6,11 @@
 #pragma once
 
 #include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
 
 #include <memory>
 #include <atomic>
+#include <functional>
 #include <mutex>
 #include <condition_variable>
 
@@ -48,6 +50,17 @@ namespace Aws
              */
             virtual bool SupportsChunkedTransferEncoding() const { return true; }
 
+            /**
+             * Opens up to connections connections to endpoint, e.g. "https://dynamodb.us-east-1.amazonaws.com", ahead of
+             * traffic, so that the first requests don't pay for DNS resolution, connecting and the TLS handshake.
+             * Sends that many HEAD requests to endpoint and returns how many of them were answered. connections is capped at 64.
+             * By default the requests are sent from at most 8 threads at once, so that at most 8 connections are opened;
+             * CurlHttpClient opens them all.
+             * The connections are only kept by clients that pool them, see ClientConfiguration::connectionHealthCheckIntervalMs
+             * to keep them open while idle.
+             */
+            virtual size_t WarmUpConnections(const Aws::String& endpoint, size_t connections) const;
+
             /**
              * Stops all requests in progress and prevents any others from initiating.
              */
@@ -67,6 +80,15 @@ namespace Aws
 
             bool ContinueRequest(const Aws::Http::HttpRequest&) const;
 
+        protected:
+            static const size_t MAX_WARM_UP_CONNECTIONS = 64;
+
+            /**
+             * Calls warmUp with each index below count, from a fixed set of threads the calling one included, and returns how
+             * many of the calls returned true.
+             */
+            static size_t RunWarmUpWorkers(size_t count, const std::function<bool(size_t)>& warmUp);
+
         private:
 
             std::atomic< bool > m_disableRequestProcessing;
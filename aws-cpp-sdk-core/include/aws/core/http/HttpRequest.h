@@ -69,7 +69,7 @@ namespace Aws
              * Initializes an HttpRequest object with uri and http method.
              */
             HttpRequest(const URI& uri, HttpMethod method) :
-                m_uri(uri), m_method(method), m_isEvenStreamRequest(false)
+                m_uri(uri), m_method(method), m_isEvenStreamRequest(false), m_streamWeight(DEFAULT_STREAM_WEIGHT)
             {}
 
             virtual ~HttpRequest() {}
@@ -525,10 +525,24 @@ namespace Aws
 
             bool IsEventStreamRequest() { return m_isEvenStreamRequest; }
             void SetEventStreamRequest(bool eventStreamRequest) { m_isEvenStreamRequest = eventStreamRequest; }
+
+            /**
+             * Gets the weight, from 1 to 256, of this request against the other requests multiplexed with it, see
+             * ClientConfiguration::enableHttp2Multiplexing. Heavier requests get a larger share of their connection, and leave
+             * the queue first when every stream is in use. Defaults to 16.
+             */
+            inline long GetStreamWeight() const { return m_streamWeight; }
+            /**
+             * Sets the weight, from 1 to 256, of this request against the other requests multiplexed with it.
+             */
+            inline void SetStreamWeight(long weight) { m_streamWeight = weight; }
+
+            static const long DEFAULT_STREAM_WEIGHT = 16;
         private:
             URI m_uri;
             HttpMethod m_method;
             bool m_isEvenStreamRequest;
+            long m_streamWeight;
             DataReceivedEventHandler m_onDataReceived;
             DataSentEventHandler m_onDataSent;
             ContinueRequestHandler m_continueRequest;
@@ -6,7 +6,12 @@
 #pragma once
 
 #include <aws/core/utils/ResourceManager.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
 #include <utility>
 #include <curl/curl.h>
 
@@ -20,6 +25,9 @@ namespace Http
   * can call into acquire a handle, then put it back when finished. It is assumed that reusing an already
   * initialized handle is preferable (especially for synchronous clients). The pool doubles in capacity as
   * needed up to the maximum amount of connections.
+  * Each handle keeps the connection of its last request open for the next one. That connection is closed once it is
+  * maxConnectionAgeMs old or has carried maxConnectionRequests requests, and, if healthCheckIntervalMs is set, idle
+  * connections are checked that often so that dead ones are dropped and HTTP/2 ones kept alive.
   */
 class CurlHandleContainer
 {
@@ -29,7 +37,8 @@ public:
       * then a small size is best. For async support, a good value would be 6 * number of Processors.   *
       */
     CurlHandleContainer(unsigned maxSize = 50, long httpRequestTimeout = 0, long connectTimeout = 1000, bool tcpKeepAlive = true,
-                        unsigned long tcpKeepAliveIntervalMs = 30000, long lowSpeedTime = 3000, unsigned long lowSpeedLimit = 1);
+                        unsigned long tcpKeepAliveIntervalMs = 30000, long lowSpeedTime = 3000, unsigned long lowSpeedLimit = 1,
+                        unsigned long maxConnectionAgeMs = 0, unsigned maxConnectionRequests = 0, unsigned long healthCheckIntervalMs = 0);
     ~CurlHandleContainer();
 
     /**
@@ -47,7 +56,27 @@ public:
      */
     void DestroyCurlHandle(CURL* handle);
 
+    /**
+     * Number of handles not in use whose connection is open.
+     */
+    size_t GetWarmConnectionCount() const;
+
+    /**
+     * Most handles the pool grows to.
+     */
+    unsigned GetMaxPoolSize() const { return m_maxPoolSize; }
+
 private:
+    struct HandleState
+    {
+        HandleState() : inUse(false), warm(false), requests(0) {}
+
+        bool inUse;
+        bool warm;
+        unsigned requests;
+        std::chrono::steady_clock::time_point connectedAt;
+    };
+
     CurlHandleContainer(const CurlHandleContainer&) = delete;
     const CurlHandleContainer& operator = (const CurlHandleContainer&) = delete;
     CurlHandleContainer(const CurlHandleContainer&&) = delete;
@@ -56,6 +85,12 @@ private:
     CURL* CreateCurlHandleInPool();
     bool CheckAndGrowPool();
     void SetDefaultOptionsOnHandle(CURL* handle);
+    bool IsExpired(const HandleState& state) const;
+    void RunHealthChecks();
+    void CheckIdleConnection(CURL* handle);
+
+    static bool IsConnected(CURL* handle);
+    static bool IsConnectionAlive(CURL* handle);
 
     Aws::Utils::ExclusiveOwnershipResourceManager<CURL*> m_handleContainer;
     unsigned m_maxPoolSize;
@@ -65,8 +100,18 @@ private:
     unsigned long m_tcpKeepAliveIntervalMs;
     unsigned long m_lowSpeedTime;
     unsigned long m_lowSpeedLimit;
+    std::chrono::milliseconds m_maxConnectionAge;
+    unsigned m_maxConnectionRequests;
+    std::chrono::milliseconds m_healthCheckInterval;
     unsigned m_poolSize;
     std::mutex m_containerLock;
+    Aws::Map<CURL*, HandleState> m_handleStates;
+    // Handles of m_handleStates warm and not in use, kept as they change so that it can be read without the lock.
+    std::atomic<size_t> m_warmIdleConnections;
+    std::condition_variable m_healthCheckSignal;
+    bool m_shuttingDown;
+    std::atomic<size_t> m_handlesInHealthCheck;
+    std::thread m_healthCheckThread;
 };
 
 } // namespace Http
@@ -9,6 +9,8 @@
 #include <aws/core/Core_EXPORTS.h>
 #include <aws/core/http/HttpClient.h>
 #include <aws/core/http/curl/CurlHandleContainer.h>
+#include <aws/core/http/curl/CurlMultiplexer.h>
+#include <aws/core/http/curl/CurlShareHandle.h>
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
 #include <atomic>
@@ -37,6 +39,12 @@ public:
         Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
         Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const override;
 
+    /**
+     * Holds that many pooled handles, at most ClientConfiguration::maxConnections, and connects each of them to endpoint
+     * with a HEAD request, sent from a few threads in turn.
+     */
+    size_t WarmUpConnections(const Aws::String& endpoint, size_t connections) const override;
+
     static void InitGlobalState();
     static void CleanupGlobalState();
 
@@ -48,7 +56,14 @@ protected:
     virtual void OverrideOptionsOnConnectionHandle(CURL*) const {}
 
 private:
+    // Sets the TLS, proxy, redirect and share options of the client on connectionHandle.
+    void SetConnectionOptions(CURL* connectionHandle) const;
+
+    // Declared before the handle container: curl handles must be cleaned up before the share they use.
+    std::shared_ptr<CurlShareHandle> m_shareHandle;
     mutable CurlHandleContainer m_curlHandleContainer;
+    // Declared after the handle container: the multi handle is cleaned up before the easy handles it drove.
+    std::shared_ptr<CurlMultiplexer> m_multiplexer;
     bool m_isUsingProxy;
     Aws::String m_proxyUserName;
     Aws::String m_proxyPassword;
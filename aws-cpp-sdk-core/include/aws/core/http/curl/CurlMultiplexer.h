@@ -0,0 +1,132 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <curl/curl.h>
+
+namespace Aws
+{
+namespace Http
+{
+
+/**
+  * Counters of a CurlMultiplexer.
+  */
+struct AWS_CORE_API CurlMultiplexerStatistics
+{
+    CurlMultiplexerStatistics() : connections(0), streams(0), queuedStreams(0), peakStreamsPerConnection(0) {}
+
+    /** Connections open. */
+    size_t connections;
+    /** Transfers in flight. */
+    size_t streams;
+    /** Transfers waiting for a stream. */
+    size_t queuedStreams;
+    /** Most transfers in flight per connection to a host so far. */
+    size_t peakStreamsPerConnection;
+};
+
+/**
+  * Drives the transfers of a CurlHttpClient through one curl multi handle, so that concurrent requests to a host are
+  * multiplexed as HTTP/2 streams over a few connections instead of each taking a connection of its own.
+  *
+  * Callers hand their prepared easy handle to Perform, which blocks until the transfer completes, as curl_easy_perform does;
+  * the transfer itself runs on the multiplexer's thread. The callbacks of all its transfers are serialized on that one
+  * thread, so they must not block: one that does stalls every other transfer. A transfer whose read callback has nothing
+  * to send yet returns CURL_READFUNC_PAUSE instead; if it was performed as resumable, call Resume once it has more, e.g.
+  * from a handler of its body stream. Paused transfers are also resumed about once a second, so that their callbacks can
+  * see a cancelled request.
+  *
+  * At most maxConnectionsPerHost connections are opened to a host, and at most maxConnectionsPerHost * maxStreamsPerConnection
+  * of its transfers are in flight. Further transfers wait in a queue, heaviest stream weight first.
+  * Requires libcurl 7.68 or later, see IsSupported.
+  */
+class AWS_CORE_API CurlMultiplexer
+{
+public:
+    CurlMultiplexer(unsigned maxConnectionsPerHost, unsigned maxStreamsPerConnection);
+    ~CurlMultiplexer();
+
+    CurlMultiplexer(const CurlMultiplexer&) = delete;
+    CurlMultiplexer& operator =(const CurlMultiplexer&) = delete;
+
+    /**
+      * Runs the transfer of handle, to host, and returns its result once complete. weight, from 1 to 256, is the share of
+      * the connection given to the transfer, and its priority in the queue. On return, streamsPerConnection is the most
+      * transfers in flight per connection to host while this one was, itself included.
+      */
+    CURLcode Perform(CURL* handle, const Aws::String& host, long weight, bool resumable, size_t& streamsPerConnection);
+
+    /**
+      * Resumes the transfer of handle, performed as resumable, if its read callback paused it. Wakes the multiplexer up
+      * rather than waiting for it to poll. Can be called from any thread, the transfer's callbacks included.
+      */
+    void Resume(CURL* handle);
+
+    CurlMultiplexerStatistics GetStatistics() const;
+
+    /**
+      * Whether the linked libcurl can multiplex transfers.
+      */
+    static bool IsSupported();
+
+private:
+    struct Transfer
+    {
+        CurlMultiplexer* multiplexer;
+        CURL* handle;
+        Aws::String host;
+        long weight;
+        bool resumable;
+        // Set by Resume, cleared once resumed.
+        bool resume;
+        bool done;
+        CURLcode result;
+        size_t peakStreamsPerConnection;
+        std::condition_variable signal;
+    };
+
+    struct HostState
+    {
+        HostState() : connections(0), streams(0) {}
+
+        size_t connections;
+        size_t streams;
+    };
+
+    void Run();
+    void StartQueuedTransfers();
+    bool CompleteTransfers();
+    void ResumeTransfers(bool all);
+    void UpdateStreamsPerConnection();
+    void Complete(Transfer* transfer, CURLcode result);
+
+    static curl_socket_t OpenSocket(void* userData, curlsocktype purpose, struct curl_sockaddr* address);
+    static int CloseSocket(void* userData, curl_socket_t socket);
+
+    unsigned m_maxConnectionsPerHost;
+    unsigned m_maxStreamsPerConnection;
+    CURLM* m_multi;
+    mutable std::mutex m_lock;
+    Aws::Vector<Transfer*> m_queued;
+    Aws::Map<CURL*, Transfer*> m_running;
+    Aws::Map<Aws::String, HostState> m_hosts;
+    Aws::Map<curl_socket_t, Aws::String> m_socketHosts;
+    size_t m_peakStreamsPerConnection;
+    bool m_shuttingDown;
+    std::thread m_thread;
+};
+
+} // namespace Http
+} // namespace Aws
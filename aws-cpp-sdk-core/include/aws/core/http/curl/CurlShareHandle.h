@@ -0,0 +1,58 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+
+#include <memory>
+#include <mutex>
+#include <curl/curl.h>
+
+namespace Aws
+{
+namespace Client
+{
+    struct ClientConfiguration;
+}
+
+namespace Http
+{
+
+/**
+  * Wraps a curl share handle, through which the curl handles of several CurlHttpClients share their DNS cache and TLS
+  * sessions. Each kind of shared data has its own lock. Connections are not shared: each client keeps its own, so that
+  * its maxConnections, connection recycling and multiplexing settings hold.
+  *
+  * Clients get one through Acquire when ClientConfiguration::shareConnections is set. Clients whose TLS and proxy settings,
+  * credentials included, all match get the same share; it lives as long as one of them does.
+  */
+class AWS_CORE_API CurlShareHandle
+{
+public:
+    CurlShareHandle();
+    ~CurlShareHandle();
+
+    CurlShareHandle(const CurlShareHandle&) = delete;
+    CurlShareHandle& operator =(const CurlShareHandle&) = delete;
+
+    CURLSH* GetHandle() const { return m_share; }
+
+    /**
+      * Returns the share used by clients configured like clientConfig, creating it if there is none.
+      */
+    static std::shared_ptr<CurlShareHandle> Acquire(const Aws::Client::ClientConfiguration& clientConfig);
+
+private:
+    static void Lock(CURL* handle, curl_lock_data data, curl_lock_access access, void* userData);
+    static void Unlock(CURL* handle, curl_lock_data data, void* userData);
+
+    CURLSH* m_share;
+    std::mutex m_locks[CURL_LOCK_DATA_LAST];
+};
+
+} // namespace Http
+} // namespace Aws
@@ -6,21 +6,75 @@
 #pragma once
 #include <aws/core/Core_EXPORTS.h>
 #include <aws/core/monitoring/HttpClientMetrics.h>
+#include <aws/core/utils/ratelimiter/AdaptiveRateLimiter.h>
+#include <chrono>
 
 namespace Aws
 {
     namespace Monitoring
     {
+        /**
+         * How a request was served with regard to the client's response cache, see Aws::Client::ResponseCache.
+         */
+        enum class ResponseCacheResult
+        {
+            /** The client has no response cache, or does not cache this operation. */
+            NotCached,
+            /** Nothing usable was cached; the response came from the service. */
+            Miss,
+            /** A fresh cached response was returned without contacting the service. */
+            Hit,
+            /** A stale cached response was returned after the service confirmed it was still current. */
+            Revalidated
+        };
+
+        /**
+         * Whether the request was hedged, see Aws::Client::HedgingPolicy.
+         */
+        enum class HedgeResult
+        {
+            /** No attempt of the request was hedged. */
+            NotHedged,
+            /** An attempt was hedged, and its response was returned. */
+            Hedged,
+            /** An attempt was hedged, and the response to the hedge was returned. */
+            HedgeWon
+        };
+
         /**
          * Metrics collected from AWS SDK Core include Http Client Metrics and other types of metrics.
          */
         struct AWS_CORE_API CoreMetricsCollection
         {
+            CoreMetricsCollection() : responseCacheResult(ResponseCacheResult::NotCached), sendRateDelay(0),
+                hedgeResult(HedgeResult::NotHedged) {}
+
             /**
              * Metrics collected from underlying http client during execution of a request
              */
             HttpClientMetricsCollection httpClientMetrics;
 
+            /**
+             * Whether the response was served from the response cache.
+             */
+            ResponseCacheResult responseCacheResult;
+
+            /**
+             * State of the client's request rate limiter for the endpoint of the last attempt, updated with its response.
+             * Left at its defaults if the client has no request rate limiter, see ClientConfiguration::requestRateLimiter.
+             */
+            Aws::Utils::RateLimits::SendRateState sendRateState;
+
+            /**
+             * Time the request waited for send tokens from the request rate limiter, over all its attempts.
+             */
+            std::chrono::milliseconds sendRateDelay;
+
+            /**
+             * Whether the last attempt was hedged, and which of its copies answered.
+             */
+            HedgeResult hedgeResult;
+
             // Add Other types of metrics here.
         };
     }
@@ -69,6 +69,23 @@ namespace Aws
              */
             SslLatency,
 
+            /**
+             * Requires the SDK to know how many new connections were opened to make the request,
+             * contains the number of TLS handshakes performed during the request attempt; 0 for plain http or a reused connection.
+             */
+            SslHandshakes,
+
+            /**
+             * Requires the SDK to multiplex requests over shared connections,
+             * contains the most requests in flight per open connection to the request's host while the request was in flight, this one included.
+             */
+            StreamsPerConnection,
+
+            /**
+             * Contains the number of open connections idle in the pool when the request started.
+             */
+            WarmConnections,
+
             /**
              * Unknow Metrics Type
              */
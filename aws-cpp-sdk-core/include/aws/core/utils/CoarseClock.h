@@ -0,0 +1,27 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <stdint.h>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        /**
+         * Monotonic millisecond clock for hot paths that only compare against deadlines, such as cache expiry.
+         * Where the platform offers a coarse monotonic clock (CLOCK_MONOTONIC_COARSE on Linux) it is read instead of
+         * std::chrono::steady_clock; it is several times cheaper to read and is accurate to a few milliseconds.
+         * Values are only meaningful relative to each other within the same process.
+         */
+        class AWS_CORE_API CoarseClock
+        {
+        public:
+            static int64_t NowMillis();
+        };
+    }
+}
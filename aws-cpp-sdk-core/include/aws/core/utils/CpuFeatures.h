@@ -0,0 +1,64 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define AWS_CORE_SIMD_X86 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define AWS_CORE_SIMD_NEON 1
+#endif
+
+// Lets a function use instructions the whole translation unit is not compiled for; callers check CpuFeatures first.
+// MSVC allows intrinsics of any instruction set without it.
+#if defined(AWS_CORE_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define AWS_CORE_TARGET(instructionSets) __attribute__((target(instructionSets)))
+#else
+#define AWS_CORE_TARGET(instructionSets)
+#endif
+
+namespace Aws
+{
+    namespace Utils
+    {
+        /**
+         * Vector instruction sets the codecs in Aws::Utils pick from, in increasing order of width.
+         */
+        enum class SimdLevel
+        {
+            Scalar,
+            SSSE3,
+            AVX2,
+            NEON
+        };
+
+        /**
+         * Instruction set extensions of the CPU the process runs on, detected on first use.
+         */
+        class AWS_CORE_API CpuFeatures
+        {
+        public:
+            static bool HasSSSE3();
+            static bool HasSSE42();
+            static bool HasPCLMULQDQ();
+            static bool HasAVX2();
+            static bool HasNEON();
+            static bool HasARMCRC32();
+
+            /**
+             * Widest SIMD level the codecs may use: the best one the CPU supports, capped by SetMaxSimdLevel.
+             */
+            static SimdLevel GetSimdLevel();
+
+            /**
+             * Caps the SIMD level returned by GetSimdLevel, for instance to compare code paths in tests and benchmarks.
+             * A cap above what the CPU supports has no effect.
+             */
+            static void SetMaxSimdLevel(SimdLevel level);
+        };
+    }
+}
@@ -9,6 +9,7 @@
 
 #include <aws/core/utils/memory/stl/AWSStreamFwd.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
 #include <aws/core/utils/Array.h>
 
 namespace Aws
@@ -37,11 +38,23 @@ namespace Aws
             */
             static Aws::String HexEncode(const ByteBuffer& byteBuffer);
 
+            /**
+            * Hex encodes length bytes of input into output, which must hold 2 * length characters.
+            * No null terminator is written. Returns the number of characters written.
+            */
+            static size_t HexEncode(const unsigned char* input, size_t length, char* output);
+
             /**
             * Hex encodes string
             */
             static ByteBuffer HexDecode(const Aws::String& str);
 
+            /**
+            * Hex decodes an even number of characters, without a "0x" prefix, into output, which must hold length / 2 bytes.
+            * Returns the number of bytes written.
+            */
+            static size_t HexDecode(const char* input, size_t length, unsigned char* output);
+
             /**
             * Calculates a SHA256 HMAC digest (not hex encoded)
             */
@@ -67,6 +80,12 @@ namespace Aws
             */
             static ByteBuffer CalculateSHA256TreeHash(Aws::IOStream& stream);
 
+            /**
+            * Combines the SHA256 Tree Hash digests of consecutive ranges of data into the Tree Hash digest of the whole.
+            * Every range but the last must be a power of two number of megabytes, e.g. the parts of a Glacier multipart upload.
+            */
+            static ByteBuffer CombineSHA256TreeHashes(const Aws::Vector<ByteBuffer>& treeHashes);
+
             /**
             * Calculates a SHA1 Hash digest (not hex encoded)
             */
@@ -87,6 +106,26 @@ namespace Aws
             */
             static ByteBuffer CalculateMD5(Aws::IOStream& stream);
 
+            /**
+            * Calculates a CRC32 checksum (4 bytes, big-endian). See Crypto::CRC32 for streaming and combining checksums.
+            */
+            static ByteBuffer CalculateCRC32(const Aws::String& str);
+
+            /**
+            * Calculates a CRC32 checksum on a stream (the entire stream is read)
+            */
+            static ByteBuffer CalculateCRC32(Aws::IOStream& stream);
+
+            /**
+            * Calculates a CRC32C checksum (4 bytes, big-endian). See Crypto::CRC32C for streaming and combining checksums.
+            */
+            static ByteBuffer CalculateCRC32C(const Aws::String& str);
+
+            /**
+            * Calculates a CRC32C checksum on a stream (the entire stream is read)
+            */
+            static ByteBuffer CalculateCRC32C(Aws::IOStream& stream);
+
             static int HashString(const char* strToHash);
 
         };
@@ -6,8 +6,12 @@
 #pragma once
 
 #include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/AWSMemory.h>
 
+#include <atomic>
 #include <cassert>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 namespace Aws
@@ -20,32 +24,41 @@ namespace Aws
          * either a successful result or the failure error.  The caller must check
          * whether the outcome of the request was a success before attempting to access
          *  the result or the error.
+         *
+         * Only the one that was set is stored, as with a variant: a successful outcome doesn't construct, copy or move
+         * an error, and a failed one doesn't do so with a result. Accessing the one that isn't held returns a
+         * default-constructed instance, as it did when both were stored; it is created on first access and owned by the outcome.
          */
         template<typename R, typename E> // Result, Error
         class Outcome
         {
         public:
 
-            Outcome() : success(false)
+            Outcome() : error(), success(false), missing(nullptr)
             {
             }
-            Outcome(const R& r) : result(r), success(true)
+            Outcome(const R& r) : result(r), success(true), missing(nullptr)
             {
             }
-            Outcome(const E& e) : error(e), success(false)
+            Outcome(const E& e) : error(e), success(false), missing(nullptr)
             {
             }
-            Outcome(R&& r) : result(std::forward<R>(r)), success(true)
+            Outcome(R&& r) : result(std::forward<R>(r)), success(true), missing(nullptr)
             {
             }
-            Outcome(E&& e) : error(std::forward<E>(e)), success(false)
+            Outcome(E&& e) : error(std::forward<E>(e)), success(false), missing(nullptr)
             {
             }
-            Outcome(const Outcome& o) :
-                result(o.result),
-                error(o.error),
-                success(o.success)
+            Outcome(const Outcome& o) : success(o.success), missing(nullptr)
             {
+                if (success)
+                {
+                    new (&result) R(o.result);
+                }
+                else
+                {
+                    new (&error) E(o.error);
+                }
             }
 
             template<typename RT, typename ET>
@@ -59,67 +72,130 @@ namespace Aws
             using enable_if_t = typename std::enable_if<B,T>::type;
 #endif
 
-            // Move both result and error from other type of outcome
+            // Move result or error from other type of outcome
             template<typename RT, typename ET, enable_if_t<std::is_convertible<RT, R>::value &&
                                                            std::is_convertible<ET, E>::value, int> = 0>
-            Outcome(Outcome<RT, ET>&& o) :
-                result(std::move(o.result)),
-                error(std::move(o.error)),
-                success(o.success)
+            Outcome(Outcome<RT, ET>&& o) : success(o.success), missing(nullptr)
             {
+                if (success)
+                {
+                    new (&result) R(std::move(o.result));
+                }
+                else
+                {
+                    new (&error) E(std::move(o.error));
+                }
             }
 
             // Move result from other type of outcome
             template<typename RT, typename ET, enable_if_t<std::is_convertible<RT, R>::value &&
                                                           !std::is_convertible<ET, E>::value, int> = 0>
-            Outcome(Outcome<RT, ET>&& o) :
-                result(std::move(o.result)),
-                success(o.success)
+            Outcome(Outcome<RT, ET>&& o) : success(o.success), missing(nullptr)
             {
                 assert(o.success);
+                if (success)
+                {
+                    new (&result) R(std::move(o.result));
+                }
+                else
+                {
+                    new (&error) E();
+                }
             }
 
             // Move error from other type of outcome
             template<typename RT, typename ET, enable_if_t<!std::is_convertible<RT, R>::value &&
                                                             std::is_convertible<ET, E>::value, int> = 0>
-            Outcome(Outcome<RT, ET>&& o) :
-                error(std::move(o.error)),
-                success(o.success)
+            Outcome(Outcome<RT, ET>&& o) : success(o.success), missing(nullptr)
             {
                 assert(!o.success);
+                if (success)
+                {
+                    new (&result) R();
+                }
+                else
+                {
+                    new (&error) E(std::move(o.error));
+                }
             }
 
             template<typename ET, enable_if_t<std::is_convertible<ET, E>::value, int> = 0>
-            Outcome(ET&& e) : error(std::forward<ET>(e)), success(false)
+            Outcome(ET&& e) : error(std::forward<ET>(e)), success(false), missing(nullptr)
+            {
+            }
+
+            ~Outcome()
             {
+                Destroy();
             }
 
             Outcome& operator=(const Outcome& o)
             {
                 if (this != &o)
                 {
-                    result = o.result;
-                    error = o.error;
-                    success = o.success;
+                    if (success && o.success)
+                    {
+                        result = o.result;
+                    }
+                    else if (!success && !o.success)
+                    {
+                        error = o.error;
+                    }
+                    else
+                    {
+                        Destroy();
+                        success = o.success;
+                        if (success)
+                        {
+                            new (&result) R(o.result);
+                        }
+                        else
+                        {
+                            new (&error) E(o.error);
+                        }
+                    }
                 }
 
                 return *this;
             }
 
-            Outcome(Outcome&& o) : // Required to force Move Constructor
-                result(std::move(o.result)),
-                error(std::move(o.error)),
-                success(o.success)
+            Outcome(Outcome&& o) : success(o.success), missing(nullptr) // Required to force Move Constructor
             {
+                if (success)
+                {
+                    new (&result) R(std::move(o.result));
+                }
+                else
+                {
+                    new (&error) E(std::move(o.error));
+                }
             }
 
             Outcome& operator=(Outcome&& o)
             {
                 if (this != &o)
                 {
-                    result = std::move(o.result);
-                    error = std::move(o.error);
-                    success = o.success;
+                    if (success && o.success)
+                    {
+                        result = std::move(o.result);
+                    }
+                    else if (!success && !o.success)
+                    {
+                        error = std::move(o.error);
+                    }
+                    else
+                    {
+                        Destroy();
+                        success = o.success;
+                        if (success)
+                        {
+                            new (&result) R(std::move(o.result));
+                        }
+                        else
+                        {
+                            new (&error) E(std::move(o.error));
+                        }
+                    }
                 }
 
                 return *this;
@@ -127,12 +203,12 @@ namespace Aws
 
             inline const R& GetResult() const
             {
-                return result;
+                return success ? result : GetMissing<R>();
             }
 
             inline R& GetResult()
             {
-                return result;
+                return success ? result : GetMissing<R>();
             }
 
             /**
@@ -141,18 +217,18 @@ namespace Aws
              */
             inline R&& GetResultWithOwnership()
             {
-                return std::move(result);
+                return std::move(GetResult());
             }
 
             inline const E& GetError() const
             {
-                return error;
+                return success ? GetMissing<E>() : error;
             }
 
             template<typename T>
             inline T GetError()
             {
-                return error.template GetModeledError<T>();
+                return (success ? GetMissing<E>() : error).template GetModeledError<T>();
             }
 
             inline bool IsSuccess() const
@@ -161,9 +237,49 @@ namespace Aws
             }
 
         private:
-            R result;
-            E error;
+            void Destroy()
+            {
+                void* created = missing.exchange(nullptr);
+                if (success)
+                {
+                    result.~R();
+                    Aws::Delete(static_cast<E*>(created));
+                }
+                else
+                {
+                    error.~E();
+                    Aws::Delete(static_cast<R*>(created));
+                }
+            }
+
+            // T is the type of the member not held.
+            template<typename T>
+            T& GetMissing() const
+            {
+                void* current = missing.load();
+                if (!current)
+                {
+                    T* created = Aws::New<T>("Outcome");
+                    if (missing.compare_exchange_strong(current, created))
+                    {
+                        current = created;
+                    }
+                    else
+                    {
+                        Aws::Delete(created);
+                    }
+                }
+                return *static_cast<T*>(current);
+            }
+
+            union
+            {
+                R result;
+                E error;
+            };
             bool success;
+            // Default instance of the member not held, only created if it is accessed.
+            mutable std::atomic<void*> missing;
         };
 
     } // namespace Utils
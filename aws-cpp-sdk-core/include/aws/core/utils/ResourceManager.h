@@ -50,6 +50,24 @@ namespace Aws
                 return resource;
             }
 
+            /**
+             * Acquires a resource only if one is available right away, without blocking.
+             *
+             * @return true if resource now holds an acquired resource, that must be released as one from Acquire().
+             */
+            bool TryAcquire(RESOURCE_TYPE& resource)
+            {
+                std::lock_guard<std::mutex> locker(m_queueLock);
+                if (m_shutdown.load() || m_resources.size() == 0)
+                {
+                    return false;
+                }
+
+                resource = m_resources.back();
+                m_resources.pop_back();
+                return true;
+            }
+
             /**
              * Returns whether or not resources are currently available for acquisition
              *
@@ -0,0 +1,267 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/utils/CoarseClock.h>
+#include <aws/core/utils/memory/stl/AWSList.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        /**
+         * Hash used by ShardedCache for its keys. std::hash for everything but Aws::String, which std::hash does not cover when
+         * the SDK's memory management is enabled.
+         */
+        template <typename TKey>
+        struct CacheKeyHash : public std::hash<TKey>
+        {
+        };
+
+        template <>
+        struct CacheKeyHash<Aws::String>
+        {
+            size_t operator()(const Aws::String& key) const
+            {
+                // FNV-1a
+                uint64_t hash = 14695981039346656037ULL;
+                for (char c : key)
+                {
+                    hash ^= static_cast<unsigned char>(c);
+                    hash *= 1099511628211ULL;
+                }
+                return static_cast<size_t>(hash);
+            }
+        };
+
+        /**
+         * Counters of a ShardedCache, summed over its shards.
+         */
+        struct CacheStatistics
+        {
+            CacheStatistics() : hits(0), misses(0), evictions(0), expirations(0), size(0) {}
+
+            /** Get calls that found a live entry. */
+            uint64_t hits;
+            /** Get calls that found no entry, or an expired one. */
+            uint64_t misses;
+            /** Live entries removed to make room for new ones. */
+            uint64_t evictions;
+            /** Expired entries removed, either when looked up or when making room. */
+            uint64_t expirations;
+            /** Entries currently held, including expired ones not removed yet. */
+            size_t size;
+        };
+
+        /**
+         * In-memory, thread safe cache with a time to live per entry and least recently used eviction.
+         *
+         * Keys are spread over a number of shards, each with its own lock, so threads working on different keys rarely
+         * contend. Within a shard, entries are kept in a hash map and a recency list, which makes Get, Put and eviction
+         * constant time. Expired entries are dropped lazily, when they are looked up or reach the end of the recency list.
+         * Expiry is checked against CoarseClock, so an entry can outlive its duration by a few milliseconds.
+         *
+         * The capacity is split evenly over the shards, so the cache starts evicting once any one shard is full.
+         */
+        template <typename TKey, typename TValue, typename THash = CacheKeyHash<TKey>>
+        class ShardedCache
+        {
+        public:
+            /**
+             * Initialize the cache with a capacity and a number of shards. Neither changes over time.
+             */
+            explicit ShardedCache(size_t maxSize = 1000, size_t shardCount = 16) :
+                m_shards((std::max)(static_cast<size_t>(1), (std::min)(shardCount, maxSize)))
+            {
+                const size_t shardSize = (maxSize + m_shards.size() - 1) / m_shards.size();
+                for (auto& shard : m_shards)
+                {
+                    shard.maxSize = (std::max)(shardSize, static_cast<size_t>(1));
+                }
+            }
+
+            ShardedCache(const ShardedCache&) = delete;
+            ShardedCache& operator=(const ShardedCache&) = delete;
+
+            /**
+             * Retrieves the value associated with the given key if it exists and has not expired, and returns true.
+             * Otherwise, returns false.
+             * @param key The key of the entry to retrieve.
+             * @param value The retrieved value in case the key exists in the cache.
+             */
+            bool Get(const TKey& key, TValue& value) const
+            {
+                Shard& shard = GetShard(key);
+                std::lock_guard<std::mutex> locker(shard.mutex);
+                auto it = shard.index.find(key);
+                if (it == shard.index.end())
+                {
+                    ++shard.stats.misses;
+                    return false;
+                }
+
+                if (IsExpired(*it->second, CoarseClock::NowMillis()))
+                {
+                    shard.entries.erase(it->second);
+                    shard.index.erase(it);
+                    ++shard.stats.expirations;
+                    ++shard.stats.misses;
+                    return false;
+                }
+
+                shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+                value = it->second->value;
+                ++shard.stats.hits;
+                return true;
+            }
+
+            /**
+             * Add or update a cache entry. When the entry's shard is full, its least recently used entry is evicted.
+             * @param key The key of the entry that will be used to retrieve it.
+             * @param val The value of the entry to associate with the given key.
+             * @param duration The duration after which the entry expires.
+             */
+            template<typename UValue>
+            void Put(const TKey& key, UValue&& val, std::chrono::milliseconds duration)
+            {
+                TKey copy(key);
+                Put(std::move(copy), std::forward<UValue>(val), duration);
+            }
+
+            template<typename UValue>
+            void Put(TKey&& key, UValue&& val, std::chrono::milliseconds duration)
+            {
+                const int64_t now = CoarseClock::NowMillis();
+                const int64_t expiration = now + static_cast<int64_t>(duration.count());
+                Shard& shard = GetShard(key);
+                std::lock_guard<std::mutex> locker(shard.mutex);
+                auto it = shard.index.find(key);
+                if (it != shard.index.end())
+                {
+                    it->second->value = std::forward<UValue>(val);
+                    it->second->expiration = expiration;
+                    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+                    return;
+                }
+
+                if (shard.entries.size() >= shard.maxSize)
+                {
+                    Entry& oldest = shard.entries.back();
+                    if (IsExpired(oldest, now))
+                    {
+                        ++shard.stats.expirations;
+                    }
+                    else
+                    {
+                        ++shard.stats.evictions;
+                    }
+                    shard.index.erase(oldest.key);
+                    shard.entries.pop_back();
+                }
+
+                shard.entries.emplace_front(key, std::forward<UValue>(val), expiration);
+                shard.index.emplace(std::move(key), shard.entries.begin());
+            }
+
+            /**
+             * Removes the entry for key, if any. Returns whether there was one.
+             */
+            bool Erase(const TKey& key)
+            {
+                Shard& shard = GetShard(key);
+                std::lock_guard<std::mutex> locker(shard.mutex);
+                auto it = shard.index.find(key);
+                if (it == shard.index.end())
+                {
+                    return false;
+                }
+                shard.entries.erase(it->second);
+                shard.index.erase(it);
+                return true;
+            }
+
+            /**
+             * Removes every entry. Counters are kept.
+             */
+            void Clear()
+            {
+                for (auto& shard : m_shards)
+                {
+                    std::lock_guard<std::mutex> locker(shard.mutex);
+                    shard.index.clear();
+                    shard.entries.clear();
+                }
+            }
+
+            CacheStatistics GetStatistics() const
+            {
+                CacheStatistics total;
+                for (auto& shard : m_shards)
+                {
+                    std::lock_guard<std::mutex> locker(shard.mutex);
+                    total.hits += shard.stats.hits;
+                    total.misses += shard.stats.misses;
+                    total.evictions += shard.stats.evictions;
+                    total.expirations += shard.stats.expirations;
+                    total.size += shard.entries.size();
+                }
+                return total;
+            }
+
+            inline size_t GetShardCount() const { return m_shards.size(); }
+
+        private:
+            struct Entry
+            {
+                template<typename UValue>
+                Entry(const TKey& k, UValue&& v, int64_t e) : key(k), value(std::forward<UValue>(v)), expiration(e) {}
+
+                TKey key;
+                TValue value;
+                int64_t expiration;
+            };
+
+            typedef typename Aws::List<Entry>::iterator EntryIterator;
+
+            struct Shard
+            {
+                Shard() : maxSize(0) {}
+
+                std::mutex mutex;
+                Aws::List<Entry> entries; // most recently used first
+                std::unordered_map<TKey, EntryIterator, THash, std::equal_to<TKey>, Aws::Allocator<std::pair<const TKey, EntryIterator>>> index;
+                size_t maxSize;
+                CacheStatistics stats;
+            };
+
+            static bool IsExpired(const Entry& entry, int64_t now)
+            {
+                return now >= entry.expiration;
+            }
+
+            Shard& GetShard(const TKey& key) const
+            {
+                // Mix the hash so that shards and the buckets of each shard's map do not pick the same bits.
+                uint64_t hash = static_cast<uint64_t>(THash()(key));
+                hash ^= hash >> 33;
+                hash *= 0xff51afd7ed558ccdULL;
+                hash ^= hash >> 33;
+                return m_shards[static_cast<size_t>(hash % m_shards.size())];
+            }
+
+            mutable Aws::Vector<Shard> m_shards;
+        };
+    }
+}
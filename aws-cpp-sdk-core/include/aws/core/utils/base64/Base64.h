@@ -43,24 +43,40 @@ namespace Aws
                 */
                 Aws::String Encode(const ByteBuffer&) const;
 
+                /**
+                * Encode length bytes of input into output, which must hold CalculateBase64EncodedLength(length) characters.
+                * No null terminator is written. Returns the number of characters written.
+                */
+                size_t Encode(const unsigned char* input, size_t length, char* output) const;
+
                 /**
                 * Decode a base64 string into a byte buffer.
                 */
                 ByteBuffer Decode(const Aws::String&) const;
 
+                /**
+                * Decode length characters of input into output, which must hold CalculateBase64DecodedLength(input, length) bytes.
+                * Returns the number of bytes written.
+                */
+                size_t Decode(const char* input, size_t length, unsigned char* output) const;
+
                 /**
                 * Calculates the required length of a base64 buffer after decoding the
                 * input string.
                 */
                 static size_t CalculateBase64DecodedLength(const Aws::String& b64input);
+                static size_t CalculateBase64DecodedLength(const char* b64input, size_t length);
                 /**
                 * Calculates the length of an encoded base64 string based on the buffer being encoded
                 */
                 static size_t CalculateBase64EncodedLength(const ByteBuffer& buffer);
+                static size_t CalculateBase64EncodedLength(size_t length);
 
             private:
                 char m_mimeBase64EncodingTable[64];
                 uint8_t m_mimeBase64DecodingTable[256];
+                // SIMD code paths only implement the standard alphabet.
+                bool m_isMimeTable;
 
             };
 
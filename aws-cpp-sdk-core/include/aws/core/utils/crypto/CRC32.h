@@ -0,0 +1,100 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/crypto/Hash.h>
+#include <aws/core/utils/Outcome.h>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Crypto
+        {
+            /**
+             * CRC32 checksum, with the polynomial used by zlib and gzip. Computed with PCLMULQDQ or the ARMv8 CRC32 instructions
+             * when the CPU has them, with table lookups otherwise.
+             *
+             * Besides the Hash interface, data can be fed in pieces through Update as it streams by; GetHash then returns the
+             * checksum of everything seen since construction or the last Reset. Digests are the 4-byte big-endian checksum.
+             */
+            class AWS_CORE_API CRC32 : public Hash
+            {
+            public:
+                CRC32();
+
+                /**
+                * Calculates the checksum of str, independently of any data passed to Update.
+                */
+                HashResult Calculate(const Aws::String& str) override;
+
+                /**
+                * Calculates the checksum of a stream (the entire stream is read), independently of any data passed to Update.
+                */
+                HashResult Calculate(Aws::IStream& stream) override;
+
+                /**
+                * Adds length bytes of buffer to the running checksum.
+                */
+                void Update(const unsigned char* buffer, size_t length);
+
+                /**
+                * Digest of the data passed to Update so far.
+                */
+                HashResult GetHash() const;
+
+                uint32_t GetChecksum() const { return m_checksum; }
+
+                void Reset() { m_checksum = 0; }
+
+                /**
+                * Extends checksum, the checksum of some preceding data, with length bytes of buffer.
+                */
+                static uint32_t Checksum(const unsigned char* buffer, size_t length, uint32_t checksum = 0);
+
+                /**
+                * Given the checksums of two consecutive ranges of data, returns the checksum of both ranges together without
+                * reading them again. secondLength is the length of the second range in bytes.
+                */
+                static uint32_t Combine(uint32_t first, uint32_t second, uint64_t secondLength);
+
+            private:
+                uint32_t m_checksum;
+            };
+
+            /**
+             * CRC32C checksum, with the Castagnoli polynomial. Computed with the SSE4.2 or ARMv8 CRC32C instructions when the CPU
+             * has them, with table lookups otherwise. Same interface as CRC32.
+             */
+            class AWS_CORE_API CRC32C : public Hash
+            {
+            public:
+                CRC32C();
+
+                HashResult Calculate(const Aws::String& str) override;
+
+                HashResult Calculate(Aws::IStream& stream) override;
+
+                void Update(const unsigned char* buffer, size_t length);
+
+                HashResult GetHash() const;
+
+                uint32_t GetChecksum() const { return m_checksum; }
+
+                void Reset() { m_checksum = 0; }
+
+                static uint32_t Checksum(const unsigned char* buffer, size_t length, uint32_t checksum = 0);
+
+                static uint32_t Combine(uint32_t first, uint32_t second, uint64_t secondLength);
+
+            private:
+                uint32_t m_checksum;
+            };
+
+        } // namespace Crypto
+    } // namespace Utils
+} // namespace Aws
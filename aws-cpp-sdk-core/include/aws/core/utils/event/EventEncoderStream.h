@@ -60,6 +60,12 @@ namespace Aws
                  */
                 void Close() { m_streambuf.SetEof(); setstate(eofbit); }
 
+                /**
+                 * Sets a handler called whenever written events can be read from the stream, or it is closed.
+                 * See ConcurrentStreamBuf::SetDataAvailableHandler.
+                 */
+                void SetDataAvailableHandler(const std::function<void()>& handler) { m_streambuf.SetDataAvailableHandler(handler); }
+
             private:
                 Stream::ConcurrentStreamBuf m_streambuf;
                 EventStreamEncoder m_encoder;
@@ -0,0 +1,114 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace RateLimits
+        {
+            /**
+             * Send rate of one endpoint, as seen by an AdaptiveRateLimiter.
+             */
+            struct AWS_CORE_API SendRateState
+            {
+                SendRateState() : limiting(false), sendRate(0), measuredSendRate(0), lastMaxRate(0) {}
+
+                /**
+                 * False until the endpoint throttles a request; requests are sent without delay until then.
+                 */
+                bool limiting;
+
+                /**
+                 * Requests per second allowed to the endpoint while limiting.
+                 */
+                double sendRate;
+
+                /**
+                 * Smoothed rate, in requests per second, at which responses are received from the endpoint.
+                 */
+                double measuredSendRate;
+
+                /**
+                 * Send rate at the last throttling response, the rate the limiter recovers towards.
+                 */
+                double lastMaxRate;
+            };
+
+            /**
+             * Client side request rate limiter that adapts to throttling, for one or several clients.
+             *
+             * Each endpoint (host) gets a token bucket that stays disabled until the endpoint throttles a request. From then on,
+             * the bucket's fill rate is cut multiplicatively on each throttling response and grows back along a cubic curve
+             * (as in TCP CUBIC) on other responses, so that all the threads sending to a throttling endpoint slow down together
+             * instead of spending their retries on it.
+             *
+             * Unlike RateLimiterInterface, which limits bytes at a fixed rate, this limits requests at a rate learnt from responses.
+             */
+            class AWS_CORE_API AdaptiveRateLimiter
+            {
+            public:
+                using DelayType = std::chrono::milliseconds;
+                using InternalTimePointType = std::chrono::steady_clock::time_point;
+                using ElapsedTimeFunctionType = std::function< InternalTimePointType() >;
+
+                AdaptiveRateLimiter(ElapsedTimeFunctionType elapsedTimeFunction = std::chrono::steady_clock::now);
+
+                /**
+                 * Takes a send token for a request to host and returns how long the caller should wait before sending it.
+                 * The token is taken even if the caller does not wait, so concurrent callers are spaced out.
+                 */
+                DelayType AcquireSendToken(const Aws::String& host);
+
+                /**
+                 * Updates the send rate of host from the response to a request sent to it.
+                 */
+                void UpdateSendRate(const Aws::String& host, bool throttled);
+
+                SendRateState GetSendRateState(const Aws::String& host) const;
+
+            private:
+                struct TokenBucket
+                {
+                    TokenBucket(double now);
+
+                    bool enabled;
+                    double fillRate;
+                    double maxCapacity;
+                    double currentCapacity;
+                    double lastTimestamp;
+                    double measuredTxRate;
+                    double lastTxRateBucket;
+                    double requestCount;
+                    double lastMaxRate;
+                    double lastThrottleTime;
+                    double timeWindow;
+                };
+
+                // Seconds since the limiter was created.
+                double Now() const;
+                TokenBucket& GetBucket(const Aws::String& host, double now);
+                static void Refill(TokenBucket& bucket, double now);
+                static void UpdateMeasuredRate(TokenBucket& bucket, double now);
+                static void UpdateFillRate(TokenBucket& bucket, double newRate, double now);
+
+                ElapsedTimeFunctionType m_elapsedTimeFunction;
+                InternalTimePointType m_startTime;
+                mutable std::mutex m_bucketsLock;
+                Aws::Map<Aws::String, TokenBucket> m_buckets;
+            };
+        } // namespace RateLimits
+    } // namespace Utils
+} // namespace Aws
@@ -8,6 +8,7 @@
 #include <aws/core/auth/AWSAuthSigner.h>
 #include <aws/common/array_list.h>
 
+#include <functional>
 #include <mutex>
 #include <condition_variable>
 #include <streambuf>
@@ -34,6 +35,13 @@ namespace Aws
 
                 void SetEof();
 
+                /**
+                 * Sets a handler called whenever written data is handed to the reader, or the end of the stream is set, so
+                 * that a reader that doesn't block on the stream learns it has more to read. It is called with the buffer
+                 * locked and must not use it. Pass nullptr to remove it; once this returns, the old handler isn't running.
+                 */
+                void SetDataAvailableHandler(const std::function<void()>& handler);
+
             protected:
                 std::streampos seekoff(std::streamoff off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
                 std::streampos seekpos(std::streampos pos, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
@@ -51,6 +59,7 @@ namespace Aws
                 Aws::Vector<unsigned char> m_backbuf; // used to shuttle data from the put area to the get area
                 std::mutex m_lock; // synchronize access to the common backbuffer
                 std::condition_variable m_signal;
+                std::function<void()> m_dataAvailableHandler;
                 bool m_eof;
             };
         }
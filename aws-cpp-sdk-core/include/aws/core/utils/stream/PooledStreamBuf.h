@@ -0,0 +1,76 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/stream/StreamBufferPool.h>
+#include <memory>
+#include <streambuf>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Stream
+        {
+            /**
+             * In-memory read/write stream buffer, with the semantics of a std::stringbuf opened for in and out, that
+             * draws its storage from a StreamBufferPool and gives it back when destroyed. This is the buffer of the
+             * default response stream.
+             *
+             * Its capacity can be reserved upfront, so that writing a body of known length copies it exactly once.
+             */
+            class AWS_CORE_API PooledStreamBuf : public std::streambuf
+            {
+            public:
+                /**
+                 * Uses the process wide pool, or plain allocations if there is none.
+                 */
+                PooledStreamBuf();
+                explicit PooledStreamBuf(const std::shared_ptr<StreamBufferPool>& pool);
+                ~PooledStreamBuf();
+
+                PooledStreamBuf(const PooledStreamBuf&) = delete;
+                PooledStreamBuf& operator=(const PooledStreamBuf&) = delete;
+
+                /**
+                 * Makes room for at least capacity bytes in total, so that writes up to that size don't reallocate.
+                 * Returns false if the memory can't be allocated; the buffer is left as it was.
+                 */
+                bool Reserve(size_t capacity);
+
+                size_t GetCapacity() const { return m_capacity; }
+
+                /**
+                 * Everything written so far.
+                 */
+                Aws::String str() const;
+
+            protected:
+                std::streampos seekoff(std::streamoff off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+                std::streampos seekpos(std::streampos pos, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+
+                int overflow(int c = EOF) override;
+                int underflow() override;
+                std::streamsize showmanyc() override;
+                std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+            private:
+                // Size of the data: the furthest position written to.
+                size_t GetSize() const;
+                void SetPutPosition(size_t position);
+                bool Reallocate(size_t capacity);
+                void ReleaseBuffer();
+
+                std::shared_ptr<StreamBufferPool> m_pool;
+                char* m_buffer;
+                size_t m_capacity;
+                size_t m_size;
+            };
+        } // namespace Stream
+    } // namespace Utils
+} // namespace Aws
@@ -62,9 +62,20 @@ namespace Aws
             public:
                 using Base = Aws::IOStream;
 
+                /**
+                 * Backed by a PooledStreamBuf.
+                 */
                 DefaultUnderlyingStream();
                 DefaultUnderlyingStream(Aws::UniquePtr<std::streambuf> buf);
                 virtual ~DefaultUnderlyingStream();
+
+                /**
+                 * If stream is a DefaultUnderlyingStream backed by a PooledStreamBuf, makes room in it for size bytes,
+                 * e.g. for a response body of known Content-Length. Does nothing for any other stream, since a custom
+                 * response stream may not be able to hold the body in memory. Returns whether room was made.
+                 * At most 8 MB are reserved; a larger body grows the buffer as it is written.
+                 */
+                static bool ReserveBody(Aws::IOStream& stream, size_t size);
             };
 
             AWS_CORE_API Aws::IOStream* DefaultResponseStreamFactoryMethod();
@@ -0,0 +1,86 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <memory>
+#include <mutex>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Stream
+        {
+            /**
+             * Pool of the buffers backing PooledStreamBuf, so that response bodies reuse the memory of previous
+             * responses instead of allocating and growing a fresh buffer each time.
+             *
+             * Buffers come in power of two size classes from MIN_BUFFER_SIZE up to the largest class not above
+             * maxBufferSize; larger requests are allocated and freed directly. At most maxPooledBytes bytes are kept
+             * in the pool, across all classes; buffers released beyond that are freed. Thread safe.
+             */
+            class AWS_CORE_API StreamBufferPool
+            {
+            public:
+                static const size_t MIN_BUFFER_SIZE = 4096;
+
+                StreamBufferPool(size_t maxPooledBytes, size_t maxBufferSize);
+                ~StreamBufferPool();
+
+                StreamBufferPool(const StreamBufferPool&) = delete;
+                StreamBufferPool& operator=(const StreamBufferPool&) = delete;
+
+                /**
+                 * Returns a buffer of at least size bytes and sets capacity to its actual size, or returns nullptr if
+                 * the allocation fails.
+                 */
+                char* Acquire(size_t size, size_t& capacity);
+
+                /**
+                 * Gives back a buffer returned by Acquire, with the capacity Acquire reported.
+                 */
+                void Release(char* buffer, size_t capacity);
+
+                /**
+                 * Bytes currently held by the pool, waiting to be acquired.
+                 */
+                size_t GetPooledBytes() const;
+
+                /**
+                 * Capacity of the buffers Acquire returns for size bytes.
+                 */
+                size_t GetCapacityFor(size_t size) const;
+
+            private:
+                size_t GetClassIndex(size_t capacity) const;
+
+                size_t m_maxPooledBytes;
+                size_t m_maxBufferSize;
+                size_t m_pooledBytes;
+                Aws::Vector<Aws::Vector<char*>> m_freeBuffers;
+                mutable std::mutex m_lock;
+            };
+
+            /**
+             * Creates the process wide pool used by PooledStreamBuf. Called by Aws::InitAPI.
+             */
+            AWS_CORE_API void InitStreamBufferPool(size_t maxPooledBytes, size_t maxBufferSize);
+
+            /**
+             * Releases the process wide pool; buffers still in use are freed when their stream buffer is destroyed.
+             * Called by Aws::ShutdownAPI.
+             */
+            AWS_CORE_API void CleanupStreamBufferPool();
+
+            /**
+             * The process wide pool, or nullptr outside of InitAPI/ShutdownAPI or when disabled in SDKOptions.
+             */
+            AWS_CORE_API std::shared_ptr<StreamBufferPool> GetStreamBufferPool();
+        } // namespace Stream
+    } // namespace Utils
+} // namespace Aws
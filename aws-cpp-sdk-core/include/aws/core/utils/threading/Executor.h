@@ -14,6 +14,8 @@
 #include <future>
 #include <mutex>
 #include <atomic>
+#include <memory>
+#include <thread>
 
 namespace Aws
 {
@@ -42,11 +44,28 @@ namespace Aws
                     return SubmitToThread(std::move(callable));
                 }
 
+                /**
+                 * Same as Submit, but neither waits for room in a full queue nor runs a rejected task on the calling thread:
+                 * returns false, and fn is not run, if the executor can't take it right away.
+                 */
+                template<class Fn, class ... Args>
+                bool TrySubmit(Fn&& fn, Args&& ... args)
+                {
+                    std::function<void()> callable{ std::bind(std::forward<Fn>(fn), std::forward<Args>(args)...) };
+                    return TrySubmitToThread(std::move(callable));
+                }
+
             protected:
                 /**
                 * To implement your own executor implementation, then simply subclass Executor and implement this method.
                 */
                 virtual bool SubmitToThread(std::function<void()>&&) = 0;
+
+                /**
+                * Called by TrySubmit. Defaults to SubmitToThread; executors whose SubmitToThread may wait, or run the task on the
+                * calling thread, should override it.
+                */
+                virtual bool TrySubmitToThread(std::function<void()>&& fn) { return SubmitToThread(std::move(fn)); }
             };
 
 
@@ -69,10 +88,18 @@ namespace Aws
                 Aws::UnorderedMap<std::thread::id, std::thread> m_threads;
             };
 
+            /**
+            * What an executor with a bounded queue does with a task submitted while its queue is full.
+            * PooledThreadExecutor treats BLOCK_WHEN_QUEUE_FULL as QUEUE_TASKS_EVENLY_ACCROSS_THREADS.
+            */
             enum class OverflowPolicy
             {
+                /** Queue the task anyway, the queue is unbounded. */
                 QUEUE_TASKS_EVENLY_ACCROSS_THREADS,
-                REJECT_IMMEDIATELY
+                /** Reject the task. */
+                REJECT_IMMEDIATELY,
+                /** Wait for room in the queue (back-pressure). */
+                BLOCK_WHEN_QUEUE_FULL
             };
 
             /**
@@ -113,6 +140,96 @@ namespace Aws
                 friend class ThreadTask;
             };
 
+            /**
+            * Fixed size thread pool shared by many clients, e.g. every service client of the process (see Aws::InitAPI).
+            *
+            * Each client submits through its own executor, obtained from CreateExecutor. What happens when the queue of an executor
+            * holds maxQueuedTasksPerExecutor tasks depends on the OverflowPolicy: the task is queued anyway, Submit waits for room
+            * (pool threads never wait, they go over the limit), or the task is rejected. A rejected task, as well as any task
+            * submitted after Shutdown, is run right away on the submitting thread through RunRejectedTask, and Submit returns false;
+            * the SDK call run that way fails without being sent, so its handler still runs, with an error.
+            * Threads pick tasks from the executors with pending work in turn, so a burst of calls from one client does not
+            * hold up the others.
+            *
+            * Since the pool has a fixed number of threads, a task must not wait for another task of the pool, e.g. on the future of
+            * an SDK *Callable call made from an async handler: once every thread waits that way, nothing runs the tasks they wait for.
+            */
+            class AWS_CORE_API SharedThreadPool
+            {
+            public:
+                /**
+                * poolSize threads are started right away. At most maxQueuedTasksPerExecutor tasks wait in the queue of each executor.
+                */
+                SharedThreadPool(size_t poolSize, size_t maxQueuedTasksPerExecutor,
+                    OverflowPolicy overflowPolicy = OverflowPolicy::BLOCK_WHEN_QUEUE_FULL);
+                ~SharedThreadPool();
+
+                SharedThreadPool(const SharedThreadPool&) = delete;
+                SharedThreadPool& operator =(const SharedThreadPool&) = delete;
+                SharedThreadPool(SharedThreadPool&&) = delete;
+                SharedThreadPool& operator =(SharedThreadPool&&) = delete;
+
+                /**
+                * Creates an executor with its own queue, running its tasks on this pool.
+                * Once the pool is shut down, tasks submitted to the executor are rejected.
+                */
+                std::shared_ptr<Executor> CreateExecutor();
+
+                /**
+                * Runs the tasks already queued, then stops the threads. Tasks submitted afterwards are rejected.
+                */
+                void Shutdown();
+
+                size_t GetPoolSize() const { return m_poolSize; }
+
+                /**
+                * Pool size used when none is given: twice the number of cores, since the tasks are mostly blocking I/O, and at least 4.
+                */
+                static size_t GetDefaultPoolSize();
+
+            private:
+                struct State;
+                class QueueExecutor;
+
+                std::shared_ptr<State> m_state;
+                Aws::Vector<std::thread> m_threads;
+                size_t m_poolSize;
+            };
+
+            /**
+            * Starts the process wide pool behind CreateDefaultExecutor. Called by Aws::InitAPI.
+            */
+            AWS_CORE_API void InitSharedThreadPool(size_t poolSize, size_t maxQueuedTasksPerExecutor, OverflowPolicy overflowPolicy);
+
+            /**
+            * Runs the tasks queued on the process wide pool and stops it. Called by Aws::ShutdownAPI.
+            */
+            AWS_CORE_API void CleanupSharedThreadPool();
+
+            /**
+            * The process wide pool, or nullptr outside of InitAPI/ShutdownAPI or unless enabled in SDKOptions.
+            */
+            AWS_CORE_API std::shared_ptr<SharedThreadPool> GetSharedThreadPool();
+
+            /**
+            * Executor that ClientConfiguration installs by default: an executor of the process wide pool if there is one,
+            * a DefaultExecutor otherwise.
+            */
+            AWS_CORE_API std::shared_ptr<Executor> CreateDefaultExecutor(const char* allocationTag);
+
+            /**
+            * Runs a task that an executor rejected on the calling thread, so that it still completes. The first SDK call the task
+            * makes, i.e. the Async or Callable call that was rejected, fails without being sent (see ClaimTaskRejection), so its
+            * handler still runs, with an error. Calls made after it, e.g. by that handler, are sent as usual.
+            * Custom executors may call it for the tasks they reject.
+            */
+            AWS_CORE_API void RunRejectedTask(const std::function<void()>& fn);
+
+            /**
+            * Called by SDK calls before they are sent. Returns true, once per task, when the calling thread is running a task through
+            * RunRejectedTask that has not made an SDK call yet; the caller then fails instead of being sent.
+            */
+            AWS_CORE_API bool ClaimTaskRejection();
 
         } // namespace Threading
     } // namespace Utils
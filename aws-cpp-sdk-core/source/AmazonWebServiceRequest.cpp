@@ -10,6 +10,7 @@ using namespace Aws;
 
 AmazonWebServiceRequest::AmazonWebServiceRequest() :
     m_responseStreamFactory(Aws::Utils::Stream::DefaultResponseStreamFactoryMethod),
+    m_customResponseStreamFactory(false),
     m_onDataReceived(nullptr),
     m_onDataSent(nullptr),
     m_continueRequest(nullptr),
@@ -14,6 +14,7 @@
 #include <aws/core/net/Net.h>
 #include <aws/core/config/AWSProfileConfigLoader.h>
 #include <aws/core/internal/AWSHttpResourceClient.h>
+#include <aws/core/utils/stream/StreamBufferPool.h>
 
 namespace Aws
 {
@@ -101,6 +102,10 @@ namespace Aws
         Aws::Http::SetInitCleanupCurlFlag(options.httpOptions.initAndCleanupCurl);
         Aws::Http::SetInstallSigPipeHandlerFlag(options.httpOptions.installSigPipeHandler);
         Aws::Http::InitHttp();
+        if (options.httpOptions.responseBufferPoolSize > 0)
+        {
+            Aws::Utils::Stream::InitStreamBufferPool(options.httpOptions.responseBufferPoolSize, options.httpOptions.maxPooledResponseBufferSize);
+        }
         Aws::InitializeEnumOverflowContainer();
         cJSON_Hooks hooks;
         hooks.malloc_fn = [](size_t sz) { return Aws::Malloc("cJSON_Tag", sz); };
@@ -109,15 +114,28 @@ namespace Aws
         Aws::Net::InitNetwork();
         Aws::Internal::InitEC2MetadataClient();
         Aws::Monitoring::InitMonitoring(options.monitoringOptions.customizedMonitoringFactory_create_fn);
+
+        if (options.executorOptions.useSharedThreadPool)
+        {
+            size_t poolSize = options.executorOptions.poolSize;
+            if (poolSize == 0)
+            {
+                poolSize = Aws::Utils::Threading::SharedThreadPool::GetDefaultPoolSize();
+            }
+            Aws::Utils::Threading::InitSharedThreadPool(poolSize, options.executorOptions.maxQueuedTasksPerClient, options.executorOptions.overflowPolicy);
+        }
     }
 
     void ShutdownAPI(const SDKOptions& options)
     {
+        // Let queued asynchronous calls finish while everything they rely on is still up.
+        Aws::Utils::Threading::CleanupSharedThreadPool();
         Aws::Monitoring::CleanupMonitoring();
         Aws::Internal::CleanupEC2MetadataClient();
         Aws::Net::CleanupNetwork();
         Aws::CleanupEnumOverflowContainer();
         Aws::Http::CleanupHttp();
+        Aws::Utils::Stream::CleanupStreamBufferPool();
         Aws::Utils::Crypto::CleanupCrypto();
 
         Aws::Config::CleanupConfigAndCredentialsCacheManager();
@@ -11,6 +11,8 @@
 #include <aws/core/client/AWSErrorMarshaller.h>
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/core/client/CoreErrors.h>
+#include <aws/core/client/HedgingPolicy.h>
+#include <aws/core/client/ResponseCache.h>
 #include <aws/core/client/RetryStrategy.h>
 #include <aws/core/http/HttpClient.h>
 #include <aws/core/http/HttpClientFactory.h>
@@ -18,11 +20,13 @@
 #include <aws/core/http/standard/StandardHttpResponse.h>
 #include <aws/core/http/URI.h>
 #include <aws/core/utils/stream/ResponseStream.h>
+#include <aws/core/utils/threading/Executor.h>
 #include <aws/core/utils/json/JsonSerializer.h>
 #include <aws/core/utils/Outcome.h>
 #include <aws/core/utils/StringUtils.h>
 #include <aws/core/utils/xml/XmlSerializer.h>
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/ratelimiter/AdaptiveRateLimiter.h>
 #include <aws/core/utils/logging/LogMacros.h>
 #include <aws/core/Globals.h>
 #include <aws/core/utils/EnumParseOverflowContainer.h>
@@ -34,11 +38,15 @@
 #include <aws/core/monitoring/MonitoringManager.h>
 #include <aws/core/Region.h>
 #include <aws/core/utils/DNS.h>
+#include <aws/core/utils/CoarseClock.h>
 #include <aws/core/Version.h>
 #include <aws/core/platform/OSVersionInfo.h>
 
 #include <cstring>
 #include <cassert>
+#include <atomic>
+#include <condition_variable>
+#include <thread>
 
 using namespace Aws;
 using namespace Aws::Client;
@@ -107,7 +115,14 @@ AWSClient::AWSClient(const Aws::Client::ClientConfiguration& configuration,
     m_customizedUserAgent(!m_userAgent.empty()),
     m_hash(Aws::Utils::Crypto::CreateMD5Implementation()),
     m_requestTimeoutMs(configuration.requestTimeoutMs),
-    m_enableClockSkewAdjustment(configuration.enableClockSkewAdjustment)
+    m_enableClockSkewAdjustment(configuration.enableClockSkewAdjustment),
+    m_responseCache(configuration.responseCache),
+    m_requestRateLimiter(configuration.requestRateLimiter),
+    m_hedgingPolicy(configuration.hedgingPolicy),
+    m_executor(configuration.executor),
+    m_scheme(configuration.scheme),
+    m_endpointOverride(configuration.endpointOverride),
+    m_useDualStack(configuration.useDualStack)
 {
     SetServiceClientName("AWSBaseClient");
 }
@@ -126,7 +141,14 @@ AWSClient::AWSClient(const Aws::Client::ClientConfiguration& configuration,
     m_customizedUserAgent(!m_userAgent.empty()),
     m_hash(Aws::Utils::Crypto::CreateMD5Implementation()),
     m_requestTimeoutMs(configuration.requestTimeoutMs),
-    m_enableClockSkewAdjustment(configuration.enableClockSkewAdjustment)
+    m_enableClockSkewAdjustment(configuration.enableClockSkewAdjustment),
+    m_responseCache(configuration.responseCache),
+    m_requestRateLimiter(configuration.requestRateLimiter),
+    m_hedgingPolicy(configuration.hedgingPolicy),
+    m_executor(configuration.executor),
+    m_scheme(configuration.scheme),
+    m_endpointOverride(configuration.endpointOverride),
+    m_useDualStack(configuration.useDualStack)
 {
     SetServiceClientName("AWSBaseClient");
 }
@@ -153,6 +175,32 @@ void AWSClient::EnableRequestProcessing()
     m_httpClient->EnableRequestProcessing();
 }
 
+size_t AWSClient::WarmUpConnections(size_t connections)
+{
+    Aws::String endpoint = m_endpointOverride;
+    if (endpoint.empty())
+    {
+        const auto signer = GetSignerByName(Aws::Auth::SIGV4_SIGNER);
+        const Aws::String serviceName = signer ? signer->GetServiceName() : Aws::String();
+        if (serviceName.empty())
+        {
+            AWS_LOGSTREAM_WARN(AWS_CLIENT_LOG_TAG, "No endpoint to warm up connections to, set ClientConfiguration::endpointOverride.");
+            return 0;
+        }
+        // The generated endpoint providers fall back to us-east-1 the same way.
+        const Aws::String region = m_region == Aws::Region::AWS_GLOBAL ? Aws::String(Aws::Region::US_EAST_1) : m_region;
+        Aws::StringStream ss;
+        ss << serviceName << "." << (m_useDualStack ? "dualstack." : "") << region
+            << (region == Aws::Region::CN_NORTH_1 || region == Aws::Region::CN_NORTHWEST_1 ? ".amazonaws.com.cn" : ".amazonaws.com");
+        endpoint = ss.str();
+    }
+    if (endpoint.find("://") == Aws::String::npos)
+    {
+        endpoint = Aws::String(SchemeMapper::ToString(m_scheme)) + "://" + endpoint;
+    }
+    return m_httpClient->WarmUpConnections(endpoint, connections);
+}
+
 Aws::Client::AWSAuthSigner* AWSClient::GetSignerByName(const char* name) const
 {
     const auto& signer =  m_signerProvider->GetSigner(name);
@@ -213,6 +261,23 @@ bool AWSClient::AdjustClockSkew(HttpResponseOutcome& outcome, const char* signer
     return false;
 }
 
+// Checks made before a request is attempted. Returns false, with the error in outcome, if it must not be sent.
+static bool CanAttempt(const Aws::Http::URI& uri, HttpResponseOutcome& outcome)
+{
+    if (!Aws::Utils::IsValidHost(uri.GetAuthority()))
+    {
+        outcome = HttpResponseOutcome(AWSError<CoreErrors>(CoreErrors::VALIDATION, "", "Invalid DNS Label found in URI host", false/*retryable*/));
+        return false;
+    }
+    if (Aws::Utils::Threading::ClaimTaskRejection())
+    {
+        // The Async or Callable call its executor couldn't take: fail it here so that its handler still runs.
+        outcome = HttpResponseOutcome(AWSError<CoreErrors>(CoreErrors::THROTTLING, "", "Request rejected by the client executor, its queue is full or the SDK is shut down", true/*retryable*/));
+        return false;
+    }
+    return true;
+}
+
 HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri,
     const Aws::AmazonWebServiceRequest& request,
     HttpMethod method,
@@ -220,18 +285,39 @@ HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri,
     const char* signerRegionOverride,
     const char* signerServiceNameOverride) const
 {
-    if (!Aws::Utils::IsValidHost(uri.GetAuthority()))
+    HttpResponseOutcome outcome;
+    if (!CanAttempt(uri, outcome))
     {
-        return HttpResponseOutcome(AWSError<CoreErrors>(CoreErrors::VALIDATION, "", "Invalid DNS Label found in URI host", false/*retryable*/));
+        return outcome;
     }
     std::shared_ptr<HttpRequest> httpRequest(CreateHttpRequest(uri, method, request.GetResponseStreamFactory()));
-    HttpResponseOutcome outcome;
     AWSError<CoreErrors> lastError;
     Aws::Monitoring::CoreMetricsCollection coreMetrics;
     auto contexts = Aws::Monitoring::OnRequestStarted(this->GetServiceClientName(), request.GetServiceRequestName(), httpRequest);
     const char* signerRegion = signerRegionOverride;
     Aws::String regionFromResponse;
 
+    Aws::String cacheKey;
+    std::chrono::milliseconds cacheTimeToLive(0);
+    CachedResponse cachedResponse;
+    ResponseCacheLookup cacheLookup = ResponseCacheLookup::Miss;
+    if (m_responseCache && !request.IsEventStreamRequest() && m_responseCache->GetTimeToLive(request.GetServiceRequestName(), cacheTimeToLive) &&
+        !ResponseCache::IsConditional(request))
+    {
+        cacheKey = ResponseCache::ComputeKey(uri, method, request);
+        cacheLookup = m_responseCache->Lookup(cacheKey, cachedResponse);
+        coreMetrics.responseCacheResult = Aws::Monitoring::ResponseCacheResult::Miss;
+        if (cacheLookup == ResponseCacheLookup::Fresh)
+        {
+            AWS_LOGSTREAM_TRACE(AWS_CLIENT_LOG_TAG, "Returning cached response for " << request.GetServiceRequestName());
+            outcome = HttpResponseOutcome(CreateResponseFromCache(httpRequest, cachedResponse));
+            coreMetrics.responseCacheResult = Aws::Monitoring::ResponseCacheResult::Hit;
+            Aws::Monitoring::OnRequestSucceeded(this->GetServiceClientName(), request.GetServiceRequestName(), httpRequest, outcome, coreMetrics, contexts);
+            Aws::Monitoring::OnFinish(this->GetServiceClientName(), request.GetServiceRequestName(), httpRequest, contexts);
+            return outcome;
+        }
+    }
+
     Aws::String invocationId = UUID::RandomUUID();
     RequestInfo requestInfo;
     requestInfo.attempt = 1;
@@ -242,9 +328,37 @@ HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri,
     for (long retries = 0;; retries++)
     {
         m_retryStrategy->GetSendToken();
+        AcquireSendToken(*httpRequest, coreMetrics);
         httpRequest->SetEventStreamRequest(request.IsEventStreamRequest());
+        if (cacheLookup == ResponseCacheLookup::Stale)
+        {
+            cachedResponse.AddValidatorsTo(*httpRequest);
+        }
 
-        outcome = AttemptOneRequest(httpRequest, request, signerName, signerRegion, signerServiceNameOverride);
+        if (m_hedgingPolicy && !request.IsEventStreamRequest() && m_hedgingPolicy->IsHedged(request.GetServiceRequestName()))
+        {
+            outcome = AttemptHedged(httpRequest, request, signerName, signerRegion, signerServiceNameOverride, coreMetrics);
+        }
+        else
+        {
+            outcome = AttemptOneRequest(httpRequest, request, signerName, signerRegion, signerServiceNameOverride);
+        }
+        if (cacheLookup == ResponseCacheLookup::Stale && !outcome.IsSuccess() &&
+            outcome.GetError().GetResponseCode() == HttpResponseCode::NOT_MODIFIED)
+        {
+            if (!m_responseCache->Refresh(cacheKey, cacheTimeToLive, cachedResponse))
+            {
+                // Evicted since Lookup: the 304 still vouches for the copy Lookup gave us, so serve it and store it again.
+                cachedResponse.freshUntil = CoarseClock::NowMillis() + static_cast<int64_t>(cacheTimeToLive.count());
+                m_responseCache->Put(cacheKey, CachedResponse(cachedResponse));
+            }
+            outcome = HttpResponseOutcome(CreateResponseFromCache(httpRequest, cachedResponse));
+            coreMetrics.responseCacheResult = Aws::Monitoring::ResponseCacheResult::Revalidated;
+        }
+        else if (coreMetrics.responseCacheResult == Aws::Monitoring::ResponseCacheResult::Miss && outcome.IsSuccess())
+        {
+            StoreInResponseCache(cacheKey, cacheTimeToLive, outcome.GetResult());
+        }
         if (retries == 0)
         {
             m_retryStrategy->RequestBookkeeping(outcome);
@@ -253,6 +367,7 @@ HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri,
         {
             m_retryStrategy->RequestBookkeeping(outcome, lastError);
         }
+        UpdateSendRate(*httpRequest, outcome, coreMetrics);
         coreMetrics.httpClientMetrics = httpRequest->GetRequestMetrics();
         if (outcome.IsSuccess())
         {
@@ -345,13 +460,13 @@ HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri,
     const char* signerRegionOverride,
     const char* signerServiceNameOverride) const
 {
-    if (!Aws::Utils::IsValidHost(uri.GetAuthority()))
+    HttpResponseOutcome outcome;
+    if (!CanAttempt(uri, outcome))
     {
-        return HttpResponseOutcome(AWSError<CoreErrors>(CoreErrors::VALIDATION, "", "Invalid DNS Label found in URI host", false/*retryable*/));
+        return outcome;
     }
 
     std::shared_ptr<HttpRequest> httpRequest(CreateHttpRequest(uri, method, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod));
-    HttpResponseOutcome outcome;
     AWSError<CoreErrors> lastError;
     Aws::Monitoring::CoreMetricsCollection coreMetrics;
     auto contexts = Aws::Monitoring::OnRequestStarted(this->GetServiceClientName(), requestName, httpRequest);
@@ -368,6 +483,7 @@ HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri,
     for (long retries = 0;; retries++)
     {
         m_retryStrategy->GetSendToken();
+        AcquireSendToken(*httpRequest, coreMetrics);
         outcome = AttemptOneRequest(httpRequest, signerName, requestName, signerRegion, signerServiceNameOverride);
         if (retries == 0)
         {
@@ -377,6 +493,7 @@ HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri,
         {
             m_retryStrategy->RequestBookkeeping(outcome, lastError);
         }
+        UpdateSendRate(*httpRequest, outcome, coreMetrics);
         coreMetrics.httpClientMetrics = httpRequest->GetRequestMetrics();
         if (outcome.IsSuccess())
         {
@@ -452,16 +569,160 @@ HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri,
     return outcome;
 }
 
+static bool IsSuccessfulResponse(const HttpResponse& response)
+{
+    const int responseCode = static_cast<int>(response.GetResponseCode());
+    return !response.HasClientError() && responseCode >= SUCCESS_RESPONSE_MIN && responseCode <= SUCCESS_RESPONSE_MAX;
+}
+
 static bool DoesResponseGenerateError(const std::shared_ptr<HttpResponse>& response)
 {
-    if (response->HasClientError()) return true;
+    return !IsSuccessfulResponse(*response);
+}
+
+/**
+ * The attempts of a hedged request: the first one, then its hedge if it was sent.
+ * The first attempt to start receiving a successful response, or to complete with one, is the winner; the other one is
+ * cancelled by its continuation handler, and only the winner's data reaches the data received handler of the request.
+ */
+struct HedgeRace
+{
+    struct Attempt
+    {
+        Attempt() : latency(0), done(false) {}
+
+        std::shared_ptr<HttpRequest> request;
+        std::shared_ptr<HttpResponse> response;
+        std::chrono::microseconds latency;
+        bool done;
+    };
+
+    HedgeRace() : winner(nullptr), firstAttemptTaken(false) {}
+
+    // Whether the attempt sending request is, or may still become, the winner.
+    bool MayWin(const HttpRequest* request) const
+    {
+        const HttpRequest* current = winner.load();
+        return !current || current == request;
+    }
 
-    int responseCode = static_cast<int>(response->GetResponseCode());
-    return responseCode < SUCCESS_RESPONSE_MIN || responseCode > SUCCESS_RESPONSE_MAX;
+    std::mutex lock;
+    std::condition_variable signal;
+    std::atomic<const HttpRequest*> winner;
+    Attempt attempts[2];
+    // Whether a thread, of the executor or the caller, took the first attempt to send it.
+    bool firstAttemptTaken;
+};
 
+static void JoinHedgeRace(HttpRequest& httpRequest, const std::shared_ptr<HedgeRace>& race)
+{
+    // The race owns the request, so it is only referenced weakly here.
+    std::weak_ptr<HedgeRace> weakRace(race);
+    ContinueRequestHandler continueRequest = httpRequest.GetContinueRequestHandler();
+    httpRequest.SetContinueRequestHandle([weakRace, continueRequest](const HttpRequest* request)
+    {
+        auto race = weakRace.lock();
+        if (race && !race->MayWin(request))
+        {
+            return false;
+        }
+        return !continueRequest || continueRequest(request);
+    });
+
+    DataReceivedEventHandler dataReceived = httpRequest.GetDataReceivedEventHandler();
+    httpRequest.SetDataReceivedEventHandler([weakRace, dataReceived](const HttpRequest* request, HttpResponse* response, long long amount)
+    {
+        auto race = weakRace.lock();
+        if (!race)
+        {
+            return;
+        }
+        if (IsSuccessfulResponse(*response))
+        {
+            const HttpRequest* noWinner = nullptr;
+            race->winner.compare_exchange_strong(noWinner, request);
+        }
+        if (race->winner.load() == request && dataReceived)
+        {
+            dataReceived(request, response, amount);
+        }
+    });
 }
 
-HttpResponseOutcome AWSClient::AttemptOneRequest(const std::shared_ptr<HttpRequest>& httpRequest, const Aws::AmazonWebServiceRequest& request,
+std::shared_ptr<HttpResponse> AWSClient::CreateResponseFromCache(const std::shared_ptr<HttpRequest>& httpRequest, const CachedResponse& cachedResponse) const
+{
+    auto response = Aws::MakeShared<Standard::StandardHttpResponse>(AWS_CLIENT_LOG_TAG, httpRequest);
+    cachedResponse.WriteTo(*response);
+    return response;
+}
+
+void AWSClient::StoreInResponseCache(const Aws::String& cacheKey, std::chrono::milliseconds timeToLive, const std::shared_ptr<HttpResponse>& response) const
+{
+    if (response->GetResponseCode() != HttpResponseCode::OK && response->GetResponseCode() != HttpResponseCode::PARTIAL_CONTENT)
+    {
+        return;
+    }
+    const size_t maxEntryBytes = m_responseCache->GetConfiguration().maxEntryBytes;
+    if (response->HasHeader(CONTENT_LENGTH_HEADER) &&
+        StringUtils::ConvertToInt64(response->GetHeader(CONTENT_LENGTH_HEADER).c_str()) > static_cast<long long>(maxEntryBytes))
+    {
+        return;
+    }
+
+    // Stop reading as soon as the body is known not to fit, then rewind for the caller.
+    Aws::IOStream& body = response->GetResponseBody();
+    Aws::String content;
+    char chunk[4096];
+    body.seekg(0);
+    while (content.size() <= maxEntryBytes && (body.read(chunk, sizeof(chunk)) || body.gcount() > 0))
+    {
+        content.append(chunk, static_cast<size_t>(body.gcount()));
+    }
+    const bool readable = !body.bad();
+    body.clear();
+    body.seekg(0);
+    if (!readable || content.size() > maxEntryBytes)
+    {
+        return;
+    }
+
+    CachedResponse cachedResponse;
+    cachedResponse.responseCode = response->GetResponseCode();
+    cachedResponse.headers = response->GetHeaders();
+    cachedResponse.body = std::move(content);
+    cachedResponse.freshUntil = CoarseClock::NowMillis() + static_cast<int64_t>(timeToLive.count());
+    m_responseCache->Put(cacheKey, std::move(cachedResponse));
+}
+
+void AWSClient::AcquireSendToken(const HttpRequest& httpRequest, Aws::Monitoring::CoreMetricsCollection& coreMetrics) const
+{
+    if (!m_requestRateLimiter)
+    {
+        return;
+    }
+    auto delay = m_requestRateLimiter->AcquireSendToken(httpRequest.GetUri().GetAuthority());
+    if (delay.count() > 0)
+    {
+        AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Endpoint " << httpRequest.GetUri().GetAuthority() << " is throttling, waiting "
+            << delay.count() << " ms for a send token.");
+        coreMetrics.sendRateDelay += delay;
+        m_httpClient->RetryRequestSleep(delay);
+    }
+}
+
+void AWSClient::UpdateSendRate(const HttpRequest& httpRequest, const HttpResponseOutcome& outcome,
+    Aws::Monitoring::CoreMetricsCollection& coreMetrics) const
+{
+    if (!m_requestRateLimiter)
+    {
+        return;
+    }
+    const Aws::String& host = httpRequest.GetUri().GetAuthority();
+    m_requestRateLimiter->UpdateSendRate(host, !outcome.IsSuccess() && IsThrottlingError(outcome.GetError()));
+    coreMetrics.sendRateState = m_requestRateLimiter->GetSendRateState(host);
+}
+
+bool AWSClient::PrepareAttempt(const std::shared_ptr<HttpRequest>& httpRequest, const Aws::AmazonWebServiceRequest& request,
     const char* signerName, const char* signerRegionOverride, const char* signerServiceNameOverride) const
 {
     BuildHttpRequest(request, httpRequest);
@@ -469,7 +730,7 @@ HttpResponseOutcome AWSClient::AttemptOneRequest(const std::shared_ptr<HttpReque
     if (!signer->SignRequest(*httpRequest, signerRegionOverride, signerServiceNameOverride, request.SignBody()))
     {
         AWS_LOGSTREAM_ERROR(AWS_CLIENT_LOG_TAG, "Request signing failed. Returning error.");
-        return HttpResponseOutcome(AWSError<CoreErrors>(CoreErrors::CLIENT_SIGNING_FAILURE, "", "SDK failed to sign the request", false/*retryable*/));
+        return false;
     }
 
     if (request.GetRequestSignedHandler())
@@ -478,6 +739,17 @@ HttpResponseOutcome AWSClient::AttemptOneRequest(const std::shared_ptr<HttpReque
     }
 
     AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Request Successfully signed");
+    return true;
+}
+
+HttpResponseOutcome AWSClient::AttemptOneRequest(const std::shared_ptr<HttpRequest>& httpRequest, const Aws::AmazonWebServiceRequest& request,
+    const char* signerName, const char* signerRegionOverride, const char* signerServiceNameOverride) const
+{
+    if (!PrepareAttempt(httpRequest, request, signerName, signerRegionOverride, signerServiceNameOverride))
+    {
+        return HttpResponseOutcome(AWSError<CoreErrors>(CoreErrors::CLIENT_SIGNING_FAILURE, "", "SDK failed to sign the request", false/*retryable*/));
+    }
+
     std::shared_ptr<HttpResponse> httpResponse(
         m_httpClient->MakeRequest(httpRequest, m_readRateLimiter.get(), m_writeRateLimiter.get()));
 
@@ -493,6 +765,180 @@ HttpResponseOutcome AWSClient::AttemptOneRequest(const std::shared_ptr<HttpReque
     return HttpResponseOutcome(std::move(httpResponse));
 }
 
+HttpResponseOutcome AWSClient::AttemptHedged(std::shared_ptr<HttpRequest>& httpRequest, const Aws::AmazonWebServiceRequest& request,
+    const char* signerName, const char* signerRegionOverride, const char* signerServiceNameOverride,
+    Aws::Monitoring::CoreMetricsCollection& coreMetrics) const
+{
+    // Both attempts would read the same body stream, or write their responses to streams of the same custom factory.
+    if (request.IsStreaming() || request.HasCustomResponseStreamFactory() || !m_executor)
+    {
+        return AttemptOneRequest(httpRequest, request, signerName, signerRegionOverride, signerServiceNameOverride);
+    }
+
+    const Aws::String requestName = request.GetServiceRequestName();
+    std::chrono::microseconds hedgeDelay(0);
+    if (!m_hedgingPolicy->StartAttempt(requestName, hedgeDelay))
+    {
+        auto start = std::chrono::steady_clock::now();
+        HttpResponseOutcome outcome = AttemptOneRequest(httpRequest, request, signerName, signerRegionOverride, signerServiceNameOverride);
+        if (outcome.IsSuccess())
+        {
+            m_hedgingPolicy->RecordLatency(requestName,
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+        }
+        return outcome;
+    }
+
+    // The hedge is sent with the same headers, and with a body serialized from the request again, as for a retry.
+    const URI uri = httpRequest->GetUri();
+    const HttpMethod method = httpRequest->GetMethod();
+    const HeaderValueCollection presetHeaders = httpRequest->GetHeaders();
+    if (!PrepareAttempt(httpRequest, request, signerName, signerRegionOverride, signerServiceNameOverride))
+    {
+        return HttpResponseOutcome(AWSError<CoreErrors>(CoreErrors::CLIENT_SIGNING_FAILURE, "", "SDK failed to sign the request", false/*retryable*/));
+    }
+
+    auto race = Aws::MakeShared<HedgeRace>(AWS_CLIENT_LOG_TAG);
+    // The first attempt may outlive this call, so the attempts hold on to what they use rather than to the client.
+    auto httpClient = m_httpClient;
+    auto readLimiter = m_readRateLimiter;
+    auto writeLimiter = m_writeRateLimiter;
+    auto sendAttempt = [race, httpClient, readLimiter, writeLimiter](size_t index)
+    {
+        HedgeRace::Attempt& attempt = race->attempts[index];
+        auto start = std::chrono::steady_clock::now();
+        std::shared_ptr<HttpResponse> response(httpClient->MakeRequest(attempt.request, readLimiter.get(), writeLimiter.get()));
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        std::lock_guard<std::mutex> locker(race->lock);
+        if (IsSuccessfulResponse(*response))
+        {
+            const HttpRequest* noWinner = nullptr;
+            race->winner.compare_exchange_strong(noWinner, attempt.request.get());
+        }
+        attempt.response = response;
+        attempt.latency = latency;
+        attempt.done = true;
+        race->signal.notify_all();
+    };
+
+    race->attempts[0].request = httpRequest;
+    JoinHedgeRace(*httpRequest, race);
+
+    // The first attempt is sent from the executor, which leaves this thread to wait out the hedge delay and send the hedge.
+    // Its latency is recorded whichever attempt wins, so that hedges don't hide the slow answers from the percentile. If
+    // the hedge won, the first attempt was cancelled and its latency is how long it had been waiting, a lower bound.
+    auto hedgingPolicy = m_hedgingPolicy;
+    auto runFirstAttempt = [race, sendAttempt, hedgingPolicy, requestName]()
+    {
+        sendAttempt(0);
+        std::unique_lock<std::mutex> locker(race->lock);
+        const HedgeRace::Attempt& attempt = race->attempts[0];
+        const bool answered = IsSuccessfulResponse(*attempt.response);
+        const bool overtaken = !race->MayWin(attempt.request.get());
+        const std::chrono::microseconds latency = attempt.latency;
+        locker.unlock();
+        if (answered || overtaken)
+        {
+            hedgingPolicy->RecordLatency(requestName, latency);
+        }
+    };
+    auto sendFirstAttempt = [race, runFirstAttempt]()
+    {
+        {
+            std::lock_guard<std::mutex> locker(race->lock);
+            if (race->firstAttemptTaken)
+            {
+                return;
+            }
+            race->firstAttemptTaken = true;
+        }
+        runFirstAttempt();
+    };
+
+    bool hedged = false;
+    // If the executor can't take the first attempt, it is sent from here, and not hedged.
+    bool sendFirstAttemptHere = !m_executor->TrySubmit(sendFirstAttempt);
+    if (!sendFirstAttemptHere)
+    {
+        std::unique_lock<std::mutex> locker(race->lock);
+        const bool late = !race->signal.wait_for(locker, hedgeDelay, [&race]() { return race->attempts[0].done || race->winner.load(); });
+        if (late && !race->firstAttemptTaken)
+        {
+            // Neither is it hedged if the executor hasn't started it yet: with all of its threads waiting, as this one may be
+            // one of them, it might never do so.
+            race->firstAttemptTaken = true;
+            sendFirstAttemptHere = true;
+        }
+        else if (late)
+        {
+            locker.unlock();
+            AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, requestName << " got no response within " << hedgeDelay.count() << " us, hedging it.");
+            auto hedge = CreateHttpRequest(uri, method, request.GetResponseStreamFactory());
+            for (const auto& header : presetHeaders)
+            {
+                hedge->SetHeaderValue(header.first, header.second);
+            }
+            const bool prepared = PrepareAttempt(hedge, request, signerName, signerRegionOverride, signerServiceNameOverride);
+            if (prepared)
+            {
+                JoinHedgeRace(*hedge, race);
+            }
+
+            locker.lock();
+            // The budget is only charged for a hedge that is sent.
+            hedged = prepared && !race->attempts[0].done && !race->winner.load() && m_hedgingPolicy->AcquireHedge();
+            if (hedged)
+            {
+                race->attempts[1].request = hedge;
+            }
+            locker.unlock();
+            if (hedged)
+            {
+                sendAttempt(1);
+            }
+        }
+    }
+    if (sendFirstAttemptHere)
+    {
+        runFirstAttempt();
+    }
+
+    // Wait for the winner to complete, or for every attempt sent to fail.
+    std::unique_lock<std::mutex> locker(race->lock);
+    race->signal.wait(locker, [&race, hedged]()
+    {
+        const HttpRequest* winner = race->winner.load();
+        if (winner)
+        {
+            return race->attempts[winner == race->attempts[0].request.get() ? 0 : 1].done;
+        }
+        return race->attempts[0].done && (!hedged || race->attempts[1].done);
+    });
+
+    const size_t chosen = hedged && race->winner.load() == race->attempts[1].request.get() ? 1 : 0;
+    httpRequest = race->attempts[chosen].request;
+    std::shared_ptr<HttpResponse> httpResponse = race->attempts[chosen].response;
+    locker.unlock();
+
+    coreMetrics.hedgeResult = !hedged ? Aws::Monitoring::HedgeResult::NotHedged :
+        chosen == 1 ? Aws::Monitoring::HedgeResult::HedgeWon : Aws::Monitoring::HedgeResult::Hedged;
+    if (chosen == 1)
+    {
+        m_hedgingPolicy->RecordHedgeWon();
+    }
+
+    if (DoesResponseGenerateError(httpResponse))
+    {
+        AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Request returned error. Attempting to generate appropriate error codes from response");
+        auto error = BuildAWSError(httpResponse);
+        return HttpResponseOutcome(std::move(error));
+    }
+
+    AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Request returned successful response.");
+    return HttpResponseOutcome(std::move(httpResponse));
+}
+
 HttpResponseOutcome AWSClient::AttemptOneRequest(const std::shared_ptr<HttpRequest>& httpRequest,
     const char* signerName, const char* requestName, const char* signerRegionOverride, const char* signerServiceNameOverride) const
 {
@@ -47,13 +47,20 @@ ClientConfiguration::ClientConfiguration() :
     lowSpeedLimit(1),
     proxyScheme(Aws::Http::Scheme::HTTP),
     proxyPort(0),
-    executor(Aws::MakeShared<Aws::Utils::Threading::DefaultExecutor>(CLIENT_CONFIG_TAG)),
+    executor(Aws::Utils::Threading::CreateDefaultExecutor(CLIENT_CONFIG_TAG)),
     verifySSL(true),
     writeRateLimiter(nullptr),
     readRateLimiter(nullptr),
     httpLibOverride(Aws::Http::TransferLibType::DEFAULT_CLIENT),
     followRedirects(FollowRedirectsPolicy::DEFAULT),
     disableExpectHeader(false),
+    shareConnections(false),
+    enableHttp2Multiplexing(false),
+    http2MaxConnectionsPerHost(2),
+    http2MaxStreamsPerConnection(100),
+    connectionMaxAgeMs(0),
+    connectionMaxRequests(0),
+    connectionHealthCheckIntervalMs(0),
     enableClockSkewAdjustment(true),
     enableHostPrefixInjection(true),
     enableEndpointDiscovery(false),
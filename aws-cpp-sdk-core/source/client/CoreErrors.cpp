@@ -149,3 +149,39 @@ AWS_CORE_API AWSError<CoreErrors> CoreErrorsMapper::GetErrorForHttpResponseCode(
     error.SetResponseCode(code);
     return error;
 }
+
+static const char* const THROTTLING_EXCEPTION_NAMES[] =
+{
+    "Throttling",
+    "ThrottlingException",
+    "ThrottledException",
+    "RequestThrottledException",
+    "RequestThrottled",
+    "TooManyRequestsException",
+    "ProvisionedThroughputExceededException",
+    "TransactionInProgressException",
+    "RequestLimitExceeded",
+    "BandwidthLimitExceeded",
+    "LimitExceededException",
+    "SlowDown",
+    "PriorRequestNotComplete",
+    "EC2ThrottledException"
+};
+
+AWS_CORE_API bool Aws::Client::IsThrottlingError(const AWSError<CoreErrors>& error)
+{
+    if (error.GetErrorType() == CoreErrors::THROTTLING || error.GetErrorType() == CoreErrors::SLOW_DOWN ||
+        error.GetResponseCode() == HttpResponseCode::TOO_MANY_REQUESTS)
+    {
+        return true;
+    }
+
+    for (const char* exceptionName : THROTTLING_EXCEPTION_NAMES)
+    {
+        if (error.GetExceptionName() == exceptionName)
+        {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,119 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/client/HedgingPolicy.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Aws::Client;
+
+// The hedge delay of an operation is recomputed every this many latencies, rather than on each of them.
+static const size_t SAMPLES_PER_DELAY_UPDATE = 16;
+
+HedgingPolicyConfiguration::HedgingPolicyConfiguration() :
+    delayPercentile(95),
+    minDelay(1),
+    maxDelay(10000),
+    latencySamples(1024),
+    minLatencySamples(100),
+    budgetPercent(5),
+    maxBudget(10)
+{
+}
+
+HedgingPolicy::HedgingPolicy(const HedgingPolicyConfiguration& configuration) :
+    m_configuration(configuration),
+    m_budget(0)
+{
+    m_configuration.latencySamples = (std::max)(m_configuration.latencySamples, static_cast<size_t>(1));
+    m_configuration.minLatencySamples = (std::min)((std::max)(m_configuration.minLatencySamples, static_cast<size_t>(1)),
+        m_configuration.latencySamples);
+    m_configuration.delayPercentile = (std::min)((std::max)(m_configuration.delayPercentile, 0.0), 100.0);
+}
+
+bool HedgingPolicy::IsHedged(const Aws::String& requestName) const
+{
+    return m_configuration.operations.find(requestName) != m_configuration.operations.end();
+}
+
+bool HedgingPolicy::StartAttempt(const Aws::String& requestName, std::chrono::microseconds& hedgeDelay)
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    m_statistics.attempts++;
+    m_budget = (std::min)(m_budget + m_configuration.budgetPercent / 100, m_configuration.maxBudget);
+
+    auto iter = m_latencies.find(requestName);
+    if (iter == m_latencies.end() || iter->second.samples.size() < m_configuration.minLatencySamples)
+    {
+        return false;
+    }
+    hedgeDelay = iter->second.hedgeDelay;
+    return true;
+}
+
+void HedgingPolicy::RecordLatency(const Aws::String& requestName, std::chrono::microseconds latency)
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    OperationLatencies& latencies = m_latencies[requestName];
+    if (latencies.samples.size() < m_configuration.latencySamples)
+    {
+        latencies.samples.push_back(latency.count());
+    }
+    else
+    {
+        latencies.samples[latencies.next] = latency.count();
+        latencies.next = (latencies.next + 1) % latencies.samples.size();
+    }
+
+    latencies.samplesSinceUpdate++;
+    if (latencies.hedgeDelay.count() == 0 || latencies.samplesSinceUpdate >= SAMPLES_PER_DELAY_UPDATE)
+    {
+        UpdateHedgeDelay(latencies);
+    }
+}
+
+void HedgingPolicy::UpdateHedgeDelay(OperationLatencies& latencies) const
+{
+    latencies.samplesSinceUpdate = 0;
+    if (latencies.samples.size() < m_configuration.minLatencySamples)
+    {
+        return;
+    }
+
+    Aws::Vector<int64_t> sorted(latencies.samples);
+    const size_t rank = static_cast<size_t>(std::ceil(m_configuration.delayPercentile / 100 * sorted.size()));
+    auto nth = sorted.begin() + (rank == 0 ? 0 : (std::min)(rank, sorted.size()) - 1);
+    std::nth_element(sorted.begin(), nth, sorted.end());
+
+    const std::chrono::microseconds minDelay(m_configuration.minDelay);
+    const std::chrono::microseconds maxDelay(m_configuration.maxDelay);
+    latencies.hedgeDelay = (std::min)((std::max)(std::chrono::microseconds(*nth), minDelay), maxDelay);
+}
+
+bool HedgingPolicy::AcquireHedge()
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    if (m_budget < 1)
+    {
+        m_statistics.hedgesDenied++;
+        return false;
+    }
+    m_budget -= 1;
+    m_statistics.hedges++;
+    return true;
+}
+
+void HedgingPolicy::RecordHedgeWon()
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    m_statistics.hedgesWon++;
+}
+
+HedgingStatistics HedgingPolicy::GetStatistics() const
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    return m_statistics;
+}
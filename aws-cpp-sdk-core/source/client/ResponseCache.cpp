@@ -0,0 +1,244 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/client/ResponseCache.h>
+#include <aws/core/AmazonWebServiceRequest.h>
+#include <aws/core/http/HttpRequest.h>
+#include <aws/core/http/URI.h>
+#include <aws/core/utils/CoarseClock.h>
+#include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/StringUtils.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+
+using namespace Aws::Client;
+using namespace Aws::Http;
+using namespace Aws::Utils;
+
+static const char ETAG_HEADER[] = "etag";
+static const char LAST_MODIFIED_HEADER[] = "last-modified";
+static const char IF_NONE_MATCH_HEADER[] = "if-none-match";
+static const char IF_MODIFIED_SINCE_HEADER[] = "if-modified-since";
+
+ResponseCacheConfiguration::ResponseCacheConfiguration() :
+    maxBytes(32 * 1024 * 1024),
+    maxEntryBytes(1024 * 1024)
+{
+}
+
+CachedResponse::CachedResponse() :
+    responseCode(HttpResponseCode::REQUEST_NOT_MADE),
+    freshUntil(0)
+{
+}
+
+Aws::String CachedResponse::GetETag() const
+{
+    auto it = headers.find(ETAG_HEADER);
+    return it == headers.end() ? Aws::String() : it->second;
+}
+
+Aws::String CachedResponse::GetLastModified() const
+{
+    auto it = headers.find(LAST_MODIFIED_HEADER);
+    return it == headers.end() ? Aws::String() : it->second;
+}
+
+void CachedResponse::AddValidatorsTo(HttpRequest& request) const
+{
+    const Aws::String eTag = GetETag();
+    if (!eTag.empty())
+    {
+        request.SetHeaderValue(IF_NONE_MATCH_HEADER, eTag);
+    }
+    const Aws::String lastModified = GetLastModified();
+    if (!lastModified.empty())
+    {
+        request.SetHeaderValue(IF_MODIFIED_SINCE_HEADER, lastModified);
+    }
+}
+
+void CachedResponse::WriteTo(HttpResponse& response) const
+{
+    response.SetResponseCode(responseCode);
+    for (const auto& header : headers)
+    {
+        response.AddHeader(header.first, header.second);
+    }
+    response.GetResponseBody().write(body.data(), static_cast<std::streamsize>(body.size()));
+    response.GetResponseBody().seekg(0);
+}
+
+static size_t EntrySize(const Aws::String& key, const CachedResponse& response)
+{
+    size_t size = key.size() + response.body.size();
+    for (const auto& header : response.headers)
+    {
+        size += header.first.size() + header.second.size();
+    }
+    return size;
+}
+
+ResponseCache::ResponseCache(const ResponseCacheConfiguration& configuration) :
+    m_configuration(configuration)
+{
+}
+
+bool ResponseCache::GetTimeToLive(const Aws::String& requestName, std::chrono::milliseconds& timeToLive) const
+{
+    auto it = m_configuration.operationTimeToLive.find(requestName);
+    if (it == m_configuration.operationTimeToLive.end())
+    {
+        return false;
+    }
+    timeToLive = it->second;
+    return true;
+}
+
+bool ResponseCache::IsConditional(const Aws::AmazonWebServiceRequest& request)
+{
+    for (const auto& header : request.GetHeaders())
+    {
+        const Aws::String name = StringUtils::ToLower(header.first.c_str());
+        if (name == IF_NONE_MATCH_HEADER || name == IF_MODIFIED_SINCE_HEADER)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+Aws::String ResponseCache::ComputeKey(const URI& uri, HttpMethod method, const Aws::AmazonWebServiceRequest& request)
+{
+    URI requestUri(uri);
+    request.AddQueryStringParameters(requestUri);
+
+    Aws::StringStream ss;
+    ss << HttpMethodMapper::GetNameForHttpMethod(method) << ' ' << requestUri.GetURIString() << '\n';
+    // HeaderValueCollection is ordered, so equal header sets give equal keys.
+    for (const auto& header : request.GetHeaders())
+    {
+        ss << header.first << ':' << header.second << '\n';
+    }
+    const auto body = request.GetBody();
+    if (body)
+    {
+        ss << HashingUtils::HexEncode(HashingUtils::CalculateSHA256(*body));
+    }
+    return ss.str();
+}
+
+ResponseCacheLookup ResponseCache::Lookup(const Aws::String& key, CachedResponse& response)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    auto it = m_index.find(key);
+    if (it == m_index.end())
+    {
+        ++m_statistics.misses;
+        return ResponseCacheLookup::Miss;
+    }
+
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    if (CoarseClock::NowMillis() < it->second->response.freshUntil)
+    {
+        response = it->second->response;
+        ++m_statistics.hits;
+        return ResponseCacheLookup::Fresh;
+    }
+
+    ++m_statistics.misses;
+    if (!it->second->response.HasValidators())
+    {
+        return ResponseCacheLookup::Miss;
+    }
+    response = it->second->response;
+    return ResponseCacheLookup::Stale;
+}
+
+void ResponseCache::Put(const Aws::String& key, CachedResponse&& response)
+{
+    const size_t size = EntrySize(key, response);
+    if (size > m_configuration.maxEntryBytes || size > m_configuration.maxBytes)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> locker(m_mutex);
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+    {
+        m_statistics.bytes -= it->second->size;
+        it->second->response = std::move(response);
+        it->second->size = size;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+    }
+    else
+    {
+        Entry entry;
+        entry.key = key;
+        entry.response = std::move(response);
+        entry.size = size;
+        m_entries.push_front(std::move(entry));
+        m_index.emplace(key, m_entries.begin());
+    }
+    m_statistics.bytes += size;
+    EvictIfNeeded();
+}
+
+bool ResponseCache::Refresh(const Aws::String& key, std::chrono::milliseconds timeToLive, CachedResponse& response)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    auto it = m_index.find(key);
+    if (it == m_index.end())
+    {
+        return false;
+    }
+    it->second->response.freshUntil = CoarseClock::NowMillis() + static_cast<int64_t>(timeToLive.count());
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    response = it->second->response;
+    ++m_statistics.revalidations;
+    return true;
+}
+
+bool ResponseCache::Erase(const Aws::String& key)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    auto it = m_index.find(key);
+    if (it == m_index.end())
+    {
+        return false;
+    }
+    m_statistics.bytes -= it->second->size;
+    m_entries.erase(it->second);
+    m_index.erase(it);
+    return true;
+}
+
+void ResponseCache::Clear()
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    m_entries.clear();
+    m_index.clear();
+    m_statistics.bytes = 0;
+}
+
+ResponseCacheStatistics ResponseCache::GetStatistics() const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    ResponseCacheStatistics statistics = m_statistics;
+    statistics.entries = m_index.size();
+    return statistics;
+}
+
+void ResponseCache::EvictIfNeeded()
+{
+    while (m_statistics.bytes > m_configuration.maxBytes && !m_entries.empty())
+    {
+        const Entry& oldest = m_entries.back();
+        m_statistics.bytes -= oldest.size;
+        m_index.erase(oldest.key);
+        m_entries.pop_back();
+        ++m_statistics.evictions;
+    }
+}
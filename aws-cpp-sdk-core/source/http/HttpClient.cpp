@@ -4,11 +4,23 @@
  */
 
 #include <aws/core/http/HttpClient.h>
+#include <aws/core/http/HttpClientFactory.h>
 #include <aws/core/http/HttpRequest.h>
+#include <aws/core/http/HttpResponse.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <aws/core/utils/stream/ResponseStream.h>
+
+#include <algorithm>
+#include <thread>
 
 using namespace Aws;
 using namespace Aws::Http;
 
+// Warm-up requests are sent from at most that many threads at once.
+static const size_t MAX_WARM_UP_WORKERS = 8;
+
+const size_t HttpClient::MAX_WARM_UP_CONNECTIONS;
+
 HttpClient::HttpClient() :
     m_disableRequestProcessing( false ),
     m_requestProcessingSignalLock(),
@@ -38,6 +50,45 @@ void HttpClient::RetryRequestSleep(std::chrono::milliseconds sleepTime)
     m_requestProcessingSignal.wait_for(signalLocker, sleepTime, [this](){ return m_disableRequestProcessing.load() == true; });
 }
 
+size_t HttpClient::WarmUpConnections(const Aws::String& endpoint, size_t connections) const
+{
+    connections = (std::min)(connections, MAX_WARM_UP_CONNECTIONS);
+    return RunWarmUpWorkers(connections, [this, &endpoint](size_t)
+    {
+        auto request = CreateHttpRequest(endpoint, HttpMethod::HTTP_HEAD, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+        auto response = MakeRequest(request);
+        return response && !response->HasClientError();
+    });
+}
+
+size_t HttpClient::RunWarmUpWorkers(size_t count, const std::function<bool(size_t)>& warmUp)
+{
+    std::atomic<size_t> next(0);
+    std::atomic<size_t> succeeded(0);
+    auto work = [count, &warmUp, &next, &succeeded]()
+    {
+        for (size_t index = next++; index < count; index = next++)
+        {
+            succeeded += warmUp(index) ? 1 : 0;
+        }
+    };
+
+    Aws::Vector<std::thread> workers;
+    const size_t workerCount = (std::min)(count, MAX_WARM_UP_WORKERS);
+    workers.reserve(workerCount);
+    for (size_t i = 1; i < workerCount; ++i)
+    {
+        workers.emplace_back(work);
+    }
+    // The calling thread is one of the workers.
+    work();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    return succeeded.load();
+}
+
 bool HttpClient::ContinueRequest(const Aws::Http::HttpRequest& request) const
 {
     if (request.GetContinueRequestHandler())
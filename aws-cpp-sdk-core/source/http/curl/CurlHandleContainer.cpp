@@ -4,10 +4,17 @@
  */
 
 #include <aws/core/http/curl/CurlHandleContainer.h>
+#include <aws/core/utils/UnreferencedParam.h>
 #include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
 
 #include <algorithm>
 
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#endif
+
 using namespace Aws::Utils::Logging;
 using namespace Aws::Http;
 
@@ -15,16 +22,33 @@ static const char* CURL_HANDLE_CONTAINER_TAG = "CurlHandleContainer";
 
 
 CurlHandleContainer::CurlHandleContainer(unsigned maxSize, long httpRequestTimeout, long connectTimeout, bool enableTcpKeepAlive,
-                                        unsigned long tcpKeepAliveIntervalMs, long lowSpeedTime, unsigned long lowSpeedLimit) :
+                                        unsigned long tcpKeepAliveIntervalMs, long lowSpeedTime, unsigned long lowSpeedLimit,
+                                        unsigned long maxConnectionAgeMs, unsigned maxConnectionRequests, unsigned long healthCheckIntervalMs) :
                 m_maxPoolSize(maxSize), m_httpRequestTimeout(httpRequestTimeout), m_connectTimeout(connectTimeout), m_enableTcpKeepAlive(enableTcpKeepAlive),
-                m_tcpKeepAliveIntervalMs(tcpKeepAliveIntervalMs), m_lowSpeedTime(lowSpeedTime), m_lowSpeedLimit(lowSpeedLimit), m_poolSize(0)
+                m_tcpKeepAliveIntervalMs(tcpKeepAliveIntervalMs), m_lowSpeedTime(lowSpeedTime), m_lowSpeedLimit(lowSpeedLimit),
+                m_maxConnectionAge(maxConnectionAgeMs), m_maxConnectionRequests(maxConnectionRequests), m_healthCheckInterval(healthCheckIntervalMs),
+                m_poolSize(0), m_warmIdleConnections(0), m_shuttingDown(false), m_handlesInHealthCheck(0)
 {
     AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Initializing CurlHandleContainer with size " << maxSize);
+    if (m_healthCheckInterval.count() > 0)
+    {
+        m_healthCheckThread = std::thread(&CurlHandleContainer::RunHealthChecks, this);
+    }
 }
 
 CurlHandleContainer::~CurlHandleContainer()
 {
     AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Cleaning up CurlHandleContainer.");
+    if (m_healthCheckThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_containerLock);
+            m_shuttingDown = true;
+        }
+        m_healthCheckSignal.notify_one();
+        m_healthCheckThread.join();
+    }
+
     for (CURL* handle : m_handleContainer.ShutdownAndWait(m_poolSize))
     {
         AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Cleaning up " << handle);
@@ -36,13 +60,20 @@ CURL* CurlHandleContainer::AcquireCurlHandle()
 {
     AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Attempting to acquire curl connection.");
 
-    if(!m_handleContainer.HasResourcesAvailable())
+    // Handles being checked are back in the pool in a moment, they are waited for rather than new ones created.
+    if(!m_handleContainer.HasResourcesAvailable() && m_handlesInHealthCheck.load() == 0)
     {
         AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "No current connections available in pool. Attempting to create new connections.");
         CheckAndGrowPool();
     }
 
     CURL* handle = m_handleContainer.Acquire();
+    {
+        std::lock_guard<std::mutex> locker(m_containerLock);
+        HandleState& state = m_handleStates[handle];
+        state.inUse = true;
+        m_warmIdleConnections -= state.warm ? 1 : 0;
+    }
     AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Connection has been released. Continuing.");
     AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Returning connection handle " << handle);
     return handle;
@@ -52,6 +83,29 @@ void CurlHandleContainer::ReleaseCurlHandle(CURL* handle)
 {
     if (handle)
     {
+        const bool connected = IsConnected(handle);
+        bool expired = false;
+        {
+            std::lock_guard<std::mutex> locker(m_containerLock);
+            HandleState& state = m_handleStates[handle];
+            state.inUse = false;
+            if (connected && !state.warm)
+            {
+                state.connectedAt = std::chrono::steady_clock::now();
+                state.requests = 0;
+            }
+            state.warm = connected;
+            state.requests += connected ? 1 : 0;
+            expired = connected && IsExpired(state);
+            m_warmIdleConnections += connected ? 1 : 0;
+        }
+        if (expired)
+        {
+            AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Recycling curl handle " << handle << ", its connection reached its maximum age or requests.");
+            DestroyCurlHandle(handle);
+            return;
+        }
+
         curl_easy_reset(handle);
         SetDefaultOptionsOnHandle(handle);
         AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Releasing curl handle " << handle);
@@ -67,6 +121,15 @@ void CurlHandleContainer::DestroyCurlHandle(CURL* handle)
         return;
     }
 
+    {
+        std::lock_guard<std::mutex> locker(m_containerLock);
+        auto state = m_handleStates.find(handle);
+        if (state != m_handleStates.end())
+        {
+            m_warmIdleConnections -= state->second.warm && !state->second.inUse ? 1 : 0;
+            m_handleStates.erase(state);
+        }
+    }
     curl_easy_cleanup(handle);
     AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Destroy curl handle: " << handle);
     {
@@ -90,6 +153,7 @@ CURL* CurlHandleContainer::CreateCurlHandleInPool()
     if (curlHandle)
     {
         SetDefaultOptionsOnHandle(curlHandle);
+        m_handleStates[curlHandle] = HandleState();
         m_handleContainer.Release(curlHandle);
     }
     else
@@ -150,4 +214,115 @@ void CurlHandleContainer::SetDefaultOptionsOnHandle(CURL* handle)
 #ifdef CURL_HAS_H2
     curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2_0);
 #endif
+#if LIBCURL_VERSION_NUM >= 0x073E00 // 7.62.0
+    if (m_healthCheckInterval.count() > 0)
+    {
+        // Half the check interval, so that every check pings the HTTP/2 connections idle since the previous one.
+        curl_easy_setopt(handle, CURLOPT_UPKEEP_INTERVAL_MS, static_cast<long>(m_healthCheckInterval.count() / 2));
+    }
+#endif
+}
+
+size_t CurlHandleContainer::GetWarmConnectionCount() const
+{
+    return m_warmIdleConnections.load();
+}
+
+bool CurlHandleContainer::IsExpired(const HandleState& state) const
+{
+    if (m_maxConnectionRequests > 0 && state.requests >= m_maxConnectionRequests)
+    {
+        return true;
+    }
+    return m_maxConnectionAge.count() > 0 && std::chrono::steady_clock::now() - state.connectedAt >= m_maxConnectionAge;
+}
+
+void CurlHandleContainer::RunHealthChecks()
+{
+    std::unique_lock<std::mutex> locker(m_containerLock);
+    while (!m_healthCheckSignal.wait_for(locker, m_healthCheckInterval, [this]() { return m_shuttingDown; }))
+    {
+        locker.unlock();
+        // The handles idle right now are checked, each going back to the pool as soon as it is.
+        CURL* handle = nullptr;
+        Aws::Vector<CURL*> idleHandles;
+        while (m_handleContainer.TryAcquire(handle))
+        {
+            ++m_handlesInHealthCheck;
+            idleHandles.push_back(handle);
+        }
+        // Released in the reverse order, so that the most recently used handles, the warmest, are still acquired first.
+        for (auto idleHandle = idleHandles.rbegin(); idleHandle != idleHandles.rend(); ++idleHandle)
+        {
+            CheckIdleConnection(*idleHandle);
+            --m_handlesInHealthCheck;
+        }
+        locker.lock();
+    }
+}
+
+void CurlHandleContainer::CheckIdleConnection(CURL* handle)
+{
+    bool warm = false;
+    bool expired = false;
+    {
+        std::lock_guard<std::mutex> locker(m_containerLock);
+        const HandleState& state = m_handleStates[handle];
+        warm = state.warm;
+        expired = warm && IsExpired(state);
+    }
+
+    if (warm && (expired || !IsConnectionAlive(handle)))
+    {
+        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Recycling idle curl handle " << handle << (expired ? ", its connection reached its maximum age." :
+            ", its connection was closed."));
+        DestroyCurlHandle(handle);
+        return;
+    }
+
+#if LIBCURL_VERSION_NUM >= 0x073E00 // 7.62.0
+    if (warm)
+    {
+        curl_easy_upkeep(handle);
+    }
+#endif
+    m_handleContainer.Release(handle);
+}
+
+bool CurlHandleContainer::IsConnected(CURL* handle)
+{
+#if LIBCURL_VERSION_NUM >= 0x072D00 // 7.45.0
+    curl_socket_t socket = CURL_SOCKET_BAD;
+    return curl_easy_getinfo(handle, CURLINFO_ACTIVESOCKET, &socket) == CURLE_OK && socket != CURL_SOCKET_BAD;
+#else
+    AWS_UNREFERENCED_PARAM(handle);
+    return false;
+#endif
+}
+
+bool CurlHandleContainer::IsConnectionAlive(CURL* handle)
+{
+#if LIBCURL_VERSION_NUM >= 0x072D00 // 7.45.0
+    curl_socket_t socket = CURL_SOCKET_BAD;
+    if (curl_easy_getinfo(handle, CURLINFO_ACTIVESOCKET, &socket) != CURLE_OK || socket == CURL_SOCKET_BAD)
+    {
+        return false;
+    }
+#ifndef _WIN32
+    // An idle connection has nothing to read, unless the server closed it or sent something like a TLS session ticket.
+    struct pollfd descriptor;
+    descriptor.fd = socket;
+    descriptor.events = POLLIN;
+    descriptor.revents = 0;
+    if (poll(&descriptor, 1, 0) > 0)
+    {
+        char byte;
+        return recv(socket, &byte, 1, MSG_PEEK) > 0;
+    }
+#endif
+    return true;
+#else
+    AWS_UNREFERENCED_PARAM(handle);
+    return false;
+#endif
 }
@@ -9,6 +9,8 @@
 #include <aws/core/utils/StringUtils.h>
 #include <aws/core/utils/logging/LogMacros.h>
 #include <aws/core/utils/ratelimiter/RateLimiterInterface.h>
+#include <aws/core/utils/event/EventEncoderStream.h>
+#include <aws/core/utils/stream/ResponseStream.h>
 #include <aws/core/utils/DateTime.h>
 #include <aws/core/monitoring/HttpClientMetrics.h>
 #include <cassert>
@@ -20,6 +22,7 @@ using namespace Aws::Http;
 using namespace Aws::Http::Standard;
 using namespace Aws::Utils;
 using namespace Aws::Utils::Logging;
+using namespace Aws::Utils::Stream;
 using namespace Aws::Monitoring;
 
 #ifdef AWS_CUSTOM_MEMORY_MANAGEMENT
@@ -145,13 +148,16 @@ struct CurlReadCallbackContext
     CurlReadCallbackContext(const CurlHttpClient* client, HttpRequest* request, Aws::Utils::RateLimits::RateLimiterInterface* limiter) :
         m_client(client),
         m_rateLimiter(limiter),
-        m_request(request)
+        m_request(request),
+        m_multiplexed(false)
     {}
 
     const CurlHttpClient* m_client;
     CURL* m_curlHandle;
     Aws::Utils::RateLimits::RateLimiterInterface* m_rateLimiter;
     HttpRequest* m_request;
+    // Set when the transfer runs on the multiplexer's thread, which must not block waiting for the body.
+    bool m_multiplexed;
 };
 
 static const char* CURL_HTTP_CLIENT_TAG = "CurlHttpClient";
@@ -175,6 +181,17 @@ static size_t WriteData(char* ptr, size_t size, size_t nmemb, void* userdata)
             context->m_rateLimiter->ApplyAndPayForCost(static_cast<int64_t>(sizeToWrite));
         }
 
+        if (context->m_numBytesResponseReceived == 0 && response->HasHeader(CONTENT_LENGTH_HEADER))
+        {
+            // The length of the body is known before its first bytes arrive: size the response buffer once rather than
+            // growing it chunk by chunk. ReserveBody caps what a Content-Length header alone allocates.
+            long long contentLength = StringUtils::ConvertToInt64(response->GetHeader(CONTENT_LENGTH_HEADER).c_str());
+            if (contentLength > 0)
+            {
+                DefaultUnderlyingStream::ReserveBody(response->GetResponseBody(), static_cast<size_t>(contentLength));
+            }
+        }
+
         response->GetResponseBody().write(ptr, static_cast<std::streamsize>(sizeToWrite));
         if (context->m_request->IsEventStreamRequest())
         {
@@ -213,6 +230,18 @@ static size_t WriteHeader(char* ptr, size_t size, size_t nmemb, void* userdata)
     return 0;
 }
 
+// Lets a continuation handler cancel a request that is still waiting for the server, when no data callback would run.
+#if LIBCURL_VERSION_NUM >= 0x072000 // 7.32.0
+static int CheckContinueRequest(void* userdata, curl_off_t, curl_off_t, curl_off_t, curl_off_t)
+#else
+static int CheckContinueRequest(void* userdata, double, double, double, double)
+#endif
+{
+    CurlWriteCallbackContext* context = reinterpret_cast<CurlWriteCallbackContext*>(userdata);
+    const CurlHttpClient* client = context->m_client;
+    return client->ContinueRequest(*context->m_request) && client->IsRequestProcessingEnabled() ? 0 : 1;
+}
+
 
 static size_t ReadBody(char* ptr, size_t size, size_t nmemb, void* userdata)
 {
@@ -234,7 +263,16 @@ static size_t ReadBody(char* ptr, size_t size, size_t nmemb, void* userdata)
     const size_t amountToRead = size * nmemb;
     if (ioStream != nullptr && amountToRead > 0)
     {
-        if (request->IsEventStreamRequest())
+        if (request->IsEventStreamRequest() && context->m_multiplexed)
+        {
+            // Pause the stream until more of the body is written, which resumes it through the multiplexer.
+            if (ioStream->rdbuf()->in_avail() == 0)
+            {
+                return CURL_READFUNC_PAUSE;
+            }
+            ioStream->readsome(ptr, amountToRead);
+        }
+        else if (request->IsEventStreamRequest())
         {
             // Waiting for next available character to read.
             // Without peek(), readsome() will keep reading 0 byte from the stream.
@@ -434,10 +472,19 @@ int CurlDebugCallback(CURL *handle, curl_infotype type, char *data, size_t size,
 }
 
 
+// Pooled handles keep connections of their own, and can recycle them, unless the connections are multiplexed.
+static bool HandlesOwnConnections(const ClientConfiguration& clientConfig)
+{
+    return !clientConfig.enableHttp2Multiplexing;
+}
+
 CurlHttpClient::CurlHttpClient(const ClientConfiguration& clientConfig) :
     Base(),
     m_curlHandleContainer(clientConfig.maxConnections, clientConfig.httpRequestTimeoutMs, clientConfig.connectTimeoutMs, clientConfig.enableTcpKeepAlive,
-                          clientConfig.tcpKeepAliveIntervalMs, clientConfig.requestTimeoutMs, clientConfig.lowSpeedLimit),
+                          clientConfig.tcpKeepAliveIntervalMs, clientConfig.requestTimeoutMs, clientConfig.lowSpeedLimit,
+                          HandlesOwnConnections(clientConfig) ? clientConfig.connectionMaxAgeMs : 0,
+                          HandlesOwnConnections(clientConfig) ? clientConfig.connectionMaxRequests : 0,
+                          clientConfig.connectionHealthCheckIntervalMs),
     m_isUsingProxy(!clientConfig.proxyHost.empty()), m_proxyUserName(clientConfig.proxyUserName),
     m_proxyPassword(clientConfig.proxyPassword), m_proxyScheme(SchemeMapper::ToString(clientConfig.proxyScheme)), m_proxyHost(clientConfig.proxyHost),
     m_proxySSLCertPath(clientConfig.proxySSLCertPath), m_proxySSLCertType(clientConfig.proxySSLCertType),
@@ -456,6 +503,25 @@ CurlHttpClient::CurlHttpClient(const ClientConfiguration& clientConfig) :
     {
         m_allowRedirects = true;
     }
+
+    if (clientConfig.enableHttp2Multiplexing)
+    {
+        if (CurlMultiplexer::IsSupported())
+        {
+            m_multiplexer = Aws::MakeShared<CurlMultiplexer>(CURL_HTTP_CLIENT_TAG, clientConfig.http2MaxConnectionsPerHost,
+                clientConfig.http2MaxStreamsPerConnection);
+        }
+        else
+        {
+            AWS_LOGSTREAM_WARN(CURL_HTTP_CLIENT_TAG, "HTTP/2 multiplexing was enabled but libcurl doesn't support it, "
+                "requests will be sent one per connection.");
+        }
+    }
+
+    if (clientConfig.shareConnections)
+    {
+        m_shareHandle = CurlShareHandle::Acquire(clientConfig);
+    }
 }
 
 
@@ -509,11 +575,13 @@ std::shared_ptr<HttpResponse> CurlHttpClient::MakeRequest(const std::shared_ptr<
         headers = curl_slist_append(headers, "Expect:");
     }
 
+    const size_t warmConnections = m_curlHandleContainer.GetWarmConnectionCount();
     CURL* connectionHandle = m_curlHandleContainer.AcquireCurlHandle();
 
     if (connectionHandle)
     {
         AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Obtained connection handle " << connectionHandle);
+        request->AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::WarmConnections), static_cast<int64_t>(warmConnections));
 
         if (headers)
         {
@@ -530,102 +598,58 @@ std::shared_ptr<HttpResponse> CurlHttpClient::MakeRequest(const std::shared_ptr<
         curl_easy_setopt(connectionHandle, CURLOPT_WRITEDATA, &writeContext);
         curl_easy_setopt(connectionHandle, CURLOPT_HEADERFUNCTION, WriteHeader);
         curl_easy_setopt(connectionHandle, CURLOPT_HEADERDATA, &writeContext);
-
-        //we only want to override the default path if someone has explicitly told us to.
-        if(!m_caPath.empty())
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, m_caPath.c_str());
-        }
-        if(!m_caFile.empty())
+        if (request->GetContinueRequestHandler())
         {
-            curl_easy_setopt(connectionHandle, CURLOPT_CAINFO, m_caFile.c_str());
+#if LIBCURL_VERSION_NUM >= 0x072000 // 7.32.0
+            curl_easy_setopt(connectionHandle, CURLOPT_XFERINFOFUNCTION, CheckContinueRequest);
+            curl_easy_setopt(connectionHandle, CURLOPT_XFERINFODATA, &writeContext);
+#else
+            curl_easy_setopt(connectionHandle, CURLOPT_PROGRESSFUNCTION, CheckContinueRequest);
+            curl_easy_setopt(connectionHandle, CURLOPT_PROGRESSDATA, &writeContext);
+#endif
+            curl_easy_setopt(connectionHandle, CURLOPT_NOPROGRESS, 0L);
         }
 
-	// only set by android test builds because the emulator is missing a cert needed for aws services
-#ifdef TEST_CERT_PATH
-	curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, TEST_CERT_PATH);
-#endif // TEST_CERT_PATH
+        SetConnectionOptions(connectionHandle);
 
-        if (m_verifySSL)
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 1L);
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 2L);
-
-#if LIBCURL_VERSION_MAJOR >= 7
-#if LIBCURL_VERSION_MINOR >= 34
-            curl_easy_setopt(connectionHandle, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1);
-#endif //LIBCURL_VERSION_MINOR
-#endif //LIBCURL_VERSION_MAJOR
-        }
-        else
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 0L);
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 0L);
-        }
-
-        if (m_allowRedirects)
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 1L);
-        }
-        else
+        if (request->GetContentBody())
         {
-            curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 0L);
+            curl_easy_setopt(connectionHandle, CURLOPT_READFUNCTION, ReadBody);
+            curl_easy_setopt(connectionHandle, CURLOPT_READDATA, &readContext);
+            curl_easy_setopt(connectionHandle, CURLOPT_SEEKFUNCTION, SeekBody);
+            curl_easy_setopt(connectionHandle, CURLOPT_SEEKDATA, &readContext);
         }
 
-#ifdef ENABLE_CURL_LOGGING
-        curl_easy_setopt(connectionHandle, CURLOPT_VERBOSE, 1);
-        curl_easy_setopt(connectionHandle, CURLOPT_DEBUGFUNCTION, CurlDebugCallback);
-#endif
-        if (m_isUsingProxy)
+        OverrideOptionsOnConnectionHandle(connectionHandle);
+        Aws::Utils::DateTime startTransmissionTime = Aws::Utils::DateTime::Now();
+        CURLcode curlResponseCode;
+        // Rate limiters block in the transfer callbacks, which would stall every other stream of the multiplexer.
+        if (m_multiplexer && readLimiter == nullptr && writeLimiter == nullptr)
         {
-            Aws::StringStream ss;
-            ss << m_proxyScheme << "://" << m_proxyHost;
-            curl_easy_setopt(connectionHandle, CURLOPT_PROXY, ss.str().c_str());
-            curl_easy_setopt(connectionHandle, CURLOPT_PROXYPORT, (long) m_proxyPort);
-            if (!m_proxyUserName.empty() || !m_proxyPassword.empty())
-            {
-                curl_easy_setopt(connectionHandle, CURLOPT_PROXYUSERNAME, m_proxyUserName.c_str());
-                curl_easy_setopt(connectionHandle, CURLOPT_PROXYPASSWORD, m_proxyPassword.c_str());
-            }
-#ifdef CURL_HAS_TLS_PROXY
-            if (!m_proxySSLCertPath.empty())
+            readContext.m_multiplexed = true;
+            // The body of an event-stream request is an EventEncoderStream, see AmazonWebServiceRequest::IsEventStreamRequest.
+            Aws::Utils::Event::EventEncoderStream* eventStream = nullptr;
+            if (request->IsEventStreamRequest() && request->GetContentBody())
             {
-                curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLCERT, m_proxySSLCertPath.c_str());
-                if (!m_proxySSLCertType.empty())
-                {
-                    curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLCERTTYPE, m_proxySSLCertType.c_str());
-                }
+                eventStream = static_cast<Aws::Utils::Event::EventEncoderStream*>(request->GetContentBody().get());
+                CurlMultiplexer* multiplexer = m_multiplexer.get();
+                eventStream->SetDataAvailableHandler([multiplexer, connectionHandle]() { multiplexer->Resume(connectionHandle); });
             }
-            if (!m_proxySSLKeyPath.empty())
+            size_t streamsPerConnection = 1;
+            curlResponseCode = m_multiplexer->Perform(connectionHandle,
+                uri.GetAuthority() + ":" + StringUtils::to_string(uri.GetPort()), request->GetStreamWeight(),
+                request->IsEventStreamRequest(), streamsPerConnection);
+            if (eventStream)
             {
-                curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLKEY, m_proxySSLKeyPath.c_str());
-                if (!m_proxySSLKeyType.empty())
-                {
-                    curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLKEYTYPE, m_proxySSLKeyType.c_str());
-                }
-                if (!m_proxyKeyPasswd.empty())
-                {
-                    curl_easy_setopt(connectionHandle, CURLOPT_PROXY_KEYPASSWD, m_proxyKeyPasswd.c_str());
-                }
+                eventStream->SetDataAvailableHandler(nullptr);
             }
-#endif //CURL_HAS_TLS_PROXY
+            request->AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::StreamsPerConnection),
+                static_cast<int64_t>(streamsPerConnection));
         }
         else
         {
-            curl_easy_setopt(connectionHandle, CURLOPT_PROXY, "");
-        }
-
-        if (request->GetContentBody())
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_READFUNCTION, ReadBody);
-            curl_easy_setopt(connectionHandle, CURLOPT_READDATA, &readContext);
-            curl_easy_setopt(connectionHandle, CURLOPT_SEEKFUNCTION, SeekBody);
-            curl_easy_setopt(connectionHandle, CURLOPT_SEEKDATA, &readContext);
+            curlResponseCode = curl_easy_perform(connectionHandle);
         }
-
-        OverrideOptionsOnConnectionHandle(connectionHandle);
-        Aws::Utils::DateTime startTransmissionTime = Aws::Utils::DateTime::Now();
-        CURLcode curlResponseCode = curl_easy_perform(connectionHandle);
         bool shouldContinueRequest = ContinueRequest(*request);
         if (curlResponseCode != CURLE_OK && shouldContinueRequest)
         {
@@ -694,6 +718,15 @@ std::shared_ptr<HttpResponse> CurlHttpClient::MakeRequest(const std::shared_ptr<
             request->AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::SslLatency), static_cast<int64_t>(timep * 1000));
         }
 
+        long numConnects;
+        ret = curl_easy_getinfo(connectionHandle, CURLINFO_NUM_CONNECTS, &numConnects); // New connections opened for this request
+        if (ret == CURLE_OK)
+        {
+            request->AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::ConnectionReused), numConnects == 0 ? 1 : 0);
+            request->AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::SslHandshakes),
+                    uri.GetScheme() == Scheme::HTTPS ? static_cast<int64_t>(numConnects) : 0);
+        }
+
         const char* ip = nullptr;
         auto curlGetInfoResult = curl_easy_getinfo(connectionHandle, CURLINFO_PRIMARY_IP, &ip); // Get the IP address of the remote endpoint
         if (curlGetInfoResult == CURLE_OK && ip)
@@ -720,3 +753,139 @@ std::shared_ptr<HttpResponse> CurlHttpClient::MakeRequest(const std::shared_ptr<
 
     return response;
 }
+
+size_t CurlHttpClient::WarmUpConnections(const Aws::String& endpoint, size_t connections) const
+{
+    // The connections of multiplexed transfers belong to the multiplexer's multi handle, not to the pooled handles.
+    if (m_multiplexer)
+    {
+        return Base::WarmUpConnections(endpoint, connections);
+    }
+
+    // The handles are all held until each has connected, so that none of them reuses the connection of another.
+    connections = (std::min)(connections, (std::min)(MAX_WARM_UP_CONNECTIONS, static_cast<size_t>(m_curlHandleContainer.GetMaxPoolSize())));
+    Aws::Vector<CURL*> connectionHandles;
+    connectionHandles.reserve(connections);
+    for (size_t i = 0; i < connections; ++i)
+    {
+        connectionHandles.push_back(m_curlHandleContainer.AcquireCurlHandle());
+    }
+
+    Aws::Vector<CURLcode> results(connections, CURLE_OK);
+    const size_t answered = RunWarmUpWorkers(connections, [this, &endpoint, &connectionHandles, &results](size_t index)
+    {
+        CURL* connectionHandle = connectionHandles[index];
+        SetConnectionOptions(connectionHandle);
+        curl_easy_setopt(connectionHandle, CURLOPT_URL, endpoint.c_str());
+        curl_easy_setopt(connectionHandle, CURLOPT_HTTPGET, 1L);
+        curl_easy_setopt(connectionHandle, CURLOPT_NOBODY, 1L);
+        OverrideOptionsOnConnectionHandle(connectionHandle);
+        results[index] = curl_easy_perform(connectionHandle);
+        return results[index] == CURLE_OK;
+    });
+
+    for (size_t i = 0; i < connections; ++i)
+    {
+        if (results[i] != CURLE_OK)
+        {
+            m_curlHandleContainer.DestroyCurlHandle(connectionHandles[i]);
+        }
+        else
+        {
+            m_curlHandleContainer.ReleaseCurlHandle(connectionHandles[i]);
+        }
+    }
+    return answered;
+}
+
+void CurlHttpClient::SetConnectionOptions(CURL* connectionHandle) const
+{
+    //we only want to override the default path if someone has explicitly told us to.
+    if(!m_caPath.empty())
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, m_caPath.c_str());
+    }
+    if(!m_caFile.empty())
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_CAINFO, m_caFile.c_str());
+    }
+
+	// only set by android test builds because the emulator is missing a cert needed for aws services
+#ifdef TEST_CERT_PATH
+	curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, TEST_CERT_PATH);
+#endif // TEST_CERT_PATH
+
+    if (m_verifySSL)
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 1L);
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 2L);
+
+#if LIBCURL_VERSION_MAJOR >= 7
+#if LIBCURL_VERSION_MINOR >= 34
+        curl_easy_setopt(connectionHandle, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1);
+#endif //LIBCURL_VERSION_MINOR
+#endif //LIBCURL_VERSION_MAJOR
+    }
+    else
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 0L);
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 0L);
+    }
+
+    if (m_allowRedirects)
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 1L);
+    }
+    else
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 0L);
+    }
+
+#ifdef ENABLE_CURL_LOGGING
+    curl_easy_setopt(connectionHandle, CURLOPT_VERBOSE, 1);
+    curl_easy_setopt(connectionHandle, CURLOPT_DEBUGFUNCTION, CurlDebugCallback);
+#endif
+    if (m_isUsingProxy)
+    {
+        Aws::StringStream ss;
+        ss << m_proxyScheme << "://" << m_proxyHost;
+        curl_easy_setopt(connectionHandle, CURLOPT_PROXY, ss.str().c_str());
+        curl_easy_setopt(connectionHandle, CURLOPT_PROXYPORT, (long) m_proxyPort);
+        if (!m_proxyUserName.empty() || !m_proxyPassword.empty())
+        {
+            curl_easy_setopt(connectionHandle, CURLOPT_PROXYUSERNAME, m_proxyUserName.c_str());
+            curl_easy_setopt(connectionHandle, CURLOPT_PROXYPASSWORD, m_proxyPassword.c_str());
+        }
+#ifdef CURL_HAS_TLS_PROXY
+        if (!m_proxySSLCertPath.empty())
+        {
+            curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLCERT, m_proxySSLCertPath.c_str());
+            if (!m_proxySSLCertType.empty())
+            {
+                curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLCERTTYPE, m_proxySSLCertType.c_str());
+            }
+        }
+        if (!m_proxySSLKeyPath.empty())
+        {
+            curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLKEY, m_proxySSLKeyPath.c_str());
+            if (!m_proxySSLKeyType.empty())
+            {
+                curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLKEYTYPE, m_proxySSLKeyType.c_str());
+            }
+            if (!m_proxyKeyPasswd.empty())
+            {
+                curl_easy_setopt(connectionHandle, CURLOPT_PROXY_KEYPASSWD, m_proxyKeyPasswd.c_str());
+            }
+        }
+#endif //CURL_HAS_TLS_PROXY
+    }
+    else
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_PROXY, "");
+    }
+
+    if (m_shareHandle)
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_SHARE, m_shareHandle->GetHandle());
+    }
+}
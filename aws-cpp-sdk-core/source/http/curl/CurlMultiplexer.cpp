@@ -0,0 +1,343 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/http/curl/CurlMultiplexer.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/UnreferencedParam.h>
+
+#include <algorithm>
+#include <chrono>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace Aws::Http;
+
+static const char* CURL_MULTIPLEXER_TAG = "CurlMultiplexer";
+
+// How long the multiplexer waits for socket activity or a wakeup before looking at its queue again, and how often every
+// paused transfer is resumed anyway, so that a cancelled one finds out.
+static const int IDLE_POLL_MS = 1000;
+
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+#define CURL_HAS_MULTIPLEXER
+#endif
+
+CurlMultiplexer::CurlMultiplexer(unsigned maxConnectionsPerHost, unsigned maxStreamsPerConnection) :
+    m_maxConnectionsPerHost((std::max)(maxConnectionsPerHost, 1u)),
+    m_maxStreamsPerConnection((std::max)(maxStreamsPerConnection, 1u)),
+    m_multi(nullptr),
+    m_peakStreamsPerConnection(0),
+    m_shuttingDown(false)
+{
+#ifdef CURL_HAS_MULTIPLEXER
+    if (!IsSupported())
+    {
+        AWS_LOGSTREAM_WARN(CURL_MULTIPLEXER_TAG, "libcurl can't multiplex HTTP/2 streams, requests will be sent one per connection.");
+        return;
+    }
+
+    m_multi = curl_multi_init();
+    curl_multi_setopt(m_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    curl_multi_setopt(m_multi, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(m_maxConnectionsPerHost));
+    curl_multi_setopt(m_multi, CURLMOPT_MAX_CONCURRENT_STREAMS, static_cast<long>(m_maxStreamsPerConnection));
+    m_thread = std::thread(&CurlMultiplexer::Run, this);
+    AWS_LOGSTREAM_INFO(CURL_MULTIPLEXER_TAG, "Initialized curl multi handle " << m_multi << " for up to " << m_maxConnectionsPerHost
+        << " connections per host and " << m_maxStreamsPerConnection << " streams per connection");
+#endif
+}
+
+CurlMultiplexer::~CurlMultiplexer()
+{
+#ifdef CURL_HAS_MULTIPLEXER
+    if (!m_multi)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        m_shuttingDown = true;
+    }
+    curl_multi_wakeup(m_multi);
+    m_thread.join();
+    curl_multi_cleanup(m_multi);
+#endif
+}
+
+bool CurlMultiplexer::IsSupported()
+{
+#ifdef CURL_HAS_MULTIPLEXER
+    const curl_version_info_data* versionInfo = curl_version_info(CURLVERSION_NOW);
+    return versionInfo->version_num >= 0x074400 && (versionInfo->features & CURL_VERSION_HTTP2) != 0;
+#else
+    return false;
+#endif
+}
+
+CURLcode CurlMultiplexer::Perform(CURL* handle, const Aws::String& host, long weight, bool resumable, size_t& streamsPerConnection)
+{
+    streamsPerConnection = 1;
+    if (!m_multi)
+    {
+        return curl_easy_perform(handle);
+    }
+
+    Transfer transfer;
+    transfer.multiplexer = this;
+    transfer.handle = handle;
+    transfer.host = host;
+    transfer.weight = (std::min)((std::max)(weight, 1L), 256L);
+    transfer.resumable = resumable;
+    transfer.resume = false;
+    transfer.done = false;
+    transfer.result = CURLE_OK;
+    transfer.peakStreamsPerConnection = 0;
+
+    // Wait for a connection that can take another stream rather than opening one more.
+    curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+    curl_easy_setopt(handle, CURLOPT_STREAM_WEIGHT, transfer.weight);
+    curl_easy_setopt(handle, CURLOPT_OPENSOCKETFUNCTION, &CurlMultiplexer::OpenSocket);
+    curl_easy_setopt(handle, CURLOPT_OPENSOCKETDATA, &transfer);
+    curl_easy_setopt(handle, CURLOPT_CLOSESOCKETFUNCTION, &CurlMultiplexer::CloseSocket);
+    curl_easy_setopt(handle, CURLOPT_CLOSESOCKETDATA, this);
+
+    std::unique_lock<std::mutex> locker(m_lock);
+    // Heaviest first; transfers of the same weight keep their order.
+    auto position = std::upper_bound(m_queued.begin(), m_queued.end(), &transfer,
+        [](const Transfer* left, const Transfer* right) { return left->weight > right->weight; });
+    m_queued.insert(position, &transfer);
+#ifdef CURL_HAS_MULTIPLEXER
+    curl_multi_wakeup(m_multi);
+#endif
+    transfer.signal.wait(locker, [&transfer]() { return transfer.done; });
+
+    streamsPerConnection = (std::max)(transfer.peakStreamsPerConnection, static_cast<size_t>(1));
+    return transfer.result;
+}
+
+void CurlMultiplexer::Resume(CURL* handle)
+{
+#ifdef CURL_HAS_MULTIPLEXER
+    if (!m_multi)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        auto running = m_running.find(handle);
+        // A transfer still queued hasn't read anything yet, so it isn't paused.
+        if (running == m_running.end() || !running->second->resumable)
+        {
+            return;
+        }
+        running->second->resume = true;
+    }
+    curl_multi_wakeup(m_multi);
+#else
+    AWS_UNREFERENCED_PARAM(handle);
+#endif
+}
+
+CurlMultiplexerStatistics CurlMultiplexer::GetStatistics() const
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    CurlMultiplexerStatistics statistics;
+    statistics.connections = m_socketHosts.size();
+    statistics.streams = m_running.size();
+    statistics.queuedStreams = m_queued.size();
+    statistics.peakStreamsPerConnection = m_peakStreamsPerConnection;
+    return statistics;
+}
+
+void CurlMultiplexer::Run()
+{
+#ifdef CURL_HAS_MULTIPLEXER
+    auto lastResumedAll = std::chrono::steady_clock::now();
+    for (;;)
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            if (m_shuttingDown && m_queued.empty() && m_running.empty())
+            {
+                return;
+            }
+        }
+
+        StartQueuedTransfers();
+        const auto now = std::chrono::steady_clock::now();
+        const bool resumeAll = now - lastResumedAll >= std::chrono::milliseconds(IDLE_POLL_MS);
+        if (resumeAll)
+        {
+            lastResumedAll = now;
+        }
+        ResumeTransfers(resumeAll);
+        int runningTransfers = 0;
+        CURLMcode code = curl_multi_perform(m_multi, &runningTransfers);
+        if (code != CURLM_OK)
+        {
+            AWS_LOGSTREAM_ERROR(CURL_MULTIPLEXER_TAG, "curl_multi_perform failed: " << curl_multi_strerror(code));
+        }
+        // Before the transfers that just finished are removed, so that they are counted.
+        UpdateStreamsPerConnection();
+        // Transfers that completed make room for queued ones, which are started without waiting.
+        const bool completed = CompleteTransfers();
+        // Returns early on curl_multi_wakeup, from Perform, Resume or the destructor.
+        curl_multi_poll(m_multi, nullptr, 0, completed ? 0 : IDLE_POLL_MS, nullptr);
+    }
+#endif
+}
+
+void CurlMultiplexer::StartQueuedTransfers()
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    const size_t maxStreamsPerHost = static_cast<size_t>(m_maxConnectionsPerHost) * m_maxStreamsPerConnection;
+    for (auto iter = m_queued.begin(); iter != m_queued.end();)
+    {
+        Transfer* transfer = *iter;
+        HostState& host = m_hosts[transfer->host];
+        if (host.streams >= maxStreamsPerHost)
+        {
+            ++iter;
+            continue;
+        }
+
+        iter = m_queued.erase(iter);
+        CURLMcode code = curl_multi_add_handle(m_multi, transfer->handle);
+        if (code != CURLM_OK)
+        {
+            AWS_LOGSTREAM_ERROR(CURL_MULTIPLEXER_TAG, "Failed to add handle " << transfer->handle << " to the multi handle: "
+                << curl_multi_strerror(code));
+            Complete(transfer, CURLE_FAILED_INIT);
+            continue;
+        }
+        host.streams++;
+        m_running.emplace(transfer->handle, transfer);
+    }
+}
+
+void CurlMultiplexer::ResumeTransfers(bool all)
+{
+    Aws::Vector<CURL*> resumed;
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        for (const auto& running : m_running)
+        {
+            Transfer* transfer = running.second;
+            if (transfer->resumable && (all || transfer->resume))
+            {
+                transfer->resume = false;
+                resumed.push_back(running.first);
+            }
+        }
+    }
+    // Without the lock, since resuming runs the read callback, which may call Resume. Only this thread removes transfers.
+    for (CURL* handle : resumed)
+    {
+        curl_easy_pause(handle, CURLPAUSE_CONT);
+    }
+}
+
+bool CurlMultiplexer::CompleteTransfers()
+{
+    bool completed = false;
+    CURLMsg* message = nullptr;
+    int messagesLeft = 0;
+    while ((message = curl_multi_info_read(m_multi, &messagesLeft)) != nullptr)
+    {
+        if (message->msg != CURLMSG_DONE)
+        {
+            continue;
+        }
+
+        CURL* handle = message->easy_handle;
+        const CURLcode result = message->data.result;
+        curl_multi_remove_handle(m_multi, handle);
+
+        std::lock_guard<std::mutex> locker(m_lock);
+        auto running = m_running.find(handle);
+        if (running == m_running.end())
+        {
+            continue;
+        }
+        Transfer* transfer = running->second;
+        m_running.erase(running);
+        auto host = m_hosts.find(transfer->host);
+        if (--host->second.streams == 0 && host->second.connections == 0)
+        {
+            m_hosts.erase(host);
+        }
+        Complete(transfer, result);
+        completed = true;
+    }
+    return completed;
+}
+
+void CurlMultiplexer::UpdateStreamsPerConnection()
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    for (const auto& running : m_running)
+    {
+        Transfer* transfer = running.second;
+        const HostState& host = m_hosts[transfer->host];
+        // Streams of a host still connecting aren't on any connection yet.
+        if (host.connections == 0)
+        {
+            continue;
+        }
+        // Streams beyond what the connections can carry wait inside curl for another connection.
+        const size_t streamsPerConnection = (std::min)((host.streams + host.connections - 1) / host.connections,
+            static_cast<size_t>(m_maxStreamsPerConnection));
+        transfer->peakStreamsPerConnection = (std::max)(transfer->peakStreamsPerConnection, streamsPerConnection);
+        m_peakStreamsPerConnection = (std::max)(m_peakStreamsPerConnection, streamsPerConnection);
+    }
+}
+
+void CurlMultiplexer::Complete(Transfer* transfer, CURLcode result)
+{
+    transfer->result = result;
+    transfer->done = true;
+    transfer->signal.notify_one();
+}
+
+curl_socket_t CurlMultiplexer::OpenSocket(void* userData, curlsocktype purpose, struct curl_sockaddr* address)
+{
+    Transfer* transfer = static_cast<Transfer*>(userData);
+    curl_socket_t socketHandle = socket(address->family, address->socktype, address->protocol);
+    if (socketHandle != CURL_SOCKET_BAD && purpose == CURLSOCKTYPE_IPCXN)
+    {
+        CurlMultiplexer* multiplexer = transfer->multiplexer;
+        std::lock_guard<std::mutex> locker(multiplexer->m_lock);
+        multiplexer->m_socketHosts[socketHandle] = transfer->host;
+        multiplexer->m_hosts[transfer->host].connections++;
+    }
+    return socketHandle;
+}
+
+int CurlMultiplexer::CloseSocket(void* userData, curl_socket_t socketHandle)
+{
+    CurlMultiplexer* multiplexer = static_cast<CurlMultiplexer*>(userData);
+    {
+        std::lock_guard<std::mutex> locker(multiplexer->m_lock);
+        auto socketHost = multiplexer->m_socketHosts.find(socketHandle);
+        if (socketHost != multiplexer->m_socketHosts.end())
+        {
+            auto host = multiplexer->m_hosts.find(socketHost->second);
+            if (host != multiplexer->m_hosts.end() && --host->second.connections == 0 && host->second.streams == 0)
+            {
+                multiplexer->m_hosts.erase(host);
+            }
+            multiplexer->m_socketHosts.erase(socketHost);
+        }
+    }
+#ifdef _WIN32
+    return closesocket(socketHandle);
+#else
+    return close(socketHandle);
+#endif
+}
@@ -0,0 +1,97 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/http/curl/CurlShareHandle.h>
+#include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/http/Scheme.h>
+#include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+
+using namespace Aws::Client;
+using namespace Aws::Http;
+using namespace Aws::Utils;
+
+static const char* CURL_SHARE_HANDLE_TAG = "CurlShareHandle";
+
+CurlShareHandle::CurlShareHandle() :
+    m_share(curl_share_init())
+{
+    curl_share_setopt(m_share, CURLSHOPT_LOCKFUNC, &CurlShareHandle::Lock);
+    curl_share_setopt(m_share, CURLSHOPT_UNLOCKFUNC, &CurlShareHandle::Unlock);
+    curl_share_setopt(m_share, CURLSHOPT_USERDATA, this);
+    curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    AWS_LOGSTREAM_INFO(CURL_SHARE_HANDLE_TAG, "Initialized curl share handle " << m_share);
+}
+
+CurlShareHandle::~CurlShareHandle()
+{
+    AWS_LOGSTREAM_INFO(CURL_SHARE_HANDLE_TAG, "Cleaning up curl share handle " << m_share);
+    CURLSHcode code = curl_share_cleanup(m_share);
+    if (code != CURLSHE_OK)
+    {
+        AWS_LOGSTREAM_ERROR(CURL_SHARE_HANDLE_TAG, "Failed to clean up curl share handle: " << curl_share_strerror(code));
+    }
+}
+
+void CurlShareHandle::Lock(CURL* handle, curl_lock_data data, curl_lock_access access, void* userData)
+{
+    AWS_UNREFERENCED_PARAM(handle);
+    AWS_UNREFERENCED_PARAM(access);
+    static_cast<CurlShareHandle*>(userData)->m_locks[data].lock();
+}
+
+void CurlShareHandle::Unlock(CURL* handle, curl_lock_data data, void* userData)
+{
+    AWS_UNREFERENCED_PARAM(handle);
+    static_cast<CurlShareHandle*>(userData)->m_locks[data].unlock();
+}
+
+// Settings that decide whether a TLS session of one client is acceptable to another, hashed so that the proxy credentials
+// among them aren't kept around in the clear.
+static Aws::String GetCompatibilityKey(const ClientConfiguration& clientConfig)
+{
+    Aws::StringStream ss;
+    ss << clientConfig.verifySSL << '|' << clientConfig.caPath << '|' << clientConfig.caFile << '|';
+    if (!clientConfig.proxyHost.empty())
+    {
+        ss << SchemeMapper::ToString(clientConfig.proxyScheme) << "://" << clientConfig.proxyUserName << ':' << clientConfig.proxyPassword
+           << '@' << clientConfig.proxyHost << ':' << clientConfig.proxyPort << '|' << clientConfig.proxySSLCertPath << '|'
+           << clientConfig.proxySSLCertType << '|' << clientConfig.proxySSLKeyPath << '|' << clientConfig.proxySSLKeyType << '|'
+           << clientConfig.proxySSLKeyPassword;
+    }
+    return HashingUtils::HexEncode(HashingUtils::CalculateSHA256(ss.str()));
+}
+
+std::shared_ptr<CurlShareHandle> CurlShareHandle::Acquire(const ClientConfiguration& clientConfig)
+{
+    static std::mutex s_sharesLock;
+    static Aws::Map<Aws::String, std::weak_ptr<CurlShareHandle>> s_shares;
+
+    const Aws::String key = GetCompatibilityKey(clientConfig);
+    std::lock_guard<std::mutex> locker(s_sharesLock);
+    for (auto it = s_shares.begin(); it != s_shares.end();)
+    {
+        if (it->second.expired())
+        {
+            it = s_shares.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    auto& share = s_shares[key];
+    std::shared_ptr<CurlShareHandle> handle = share.lock();
+    if (!handle)
+    {
+        handle = Aws::MakeShared<CurlShareHandle>(CURL_SHARE_HANDLE_TAG);
+        share = handle;
+    }
+    return handle;
+}
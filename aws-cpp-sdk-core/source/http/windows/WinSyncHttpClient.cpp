@@ -13,6 +13,7 @@
 #include <aws/core/utils/memory/AWSMemory.h>
 #include <aws/core/utils/memory/stl/AWSStreamFwd.h>
 #include <aws/core/utils/ratelimiter/RateLimiterInterface.h>
+#include <aws/core/utils/stream/ResponseStream.h>
 
 #include <Windows.h>
 #include <sstream>
@@ -208,6 +209,15 @@ bool WinSyncHttpClient::BuildSuccessResponse(const std::shared_ptr<HttpRequest>&
 
         bool success = ContinueRequest(*request);
 
+        if (response->HasHeader(Aws::Http::CONTENT_LENGTH_HEADER))
+        {
+            long long contentLength = StringUtils::ConvertToInt64(response->GetHeader(Aws::Http::CONTENT_LENGTH_HEADER).c_str());
+            if (contentLength > 0)
+            {
+                Aws::Utils::Stream::DefaultUnderlyingStream::ReserveBody(response->GetResponseBody(), static_cast<size_t>(contentLength));
+            }
+        }
+
         while (DoReadData(hHttpRequest, body, bodySize, read) && read > 0 && success)
         {
             response->GetResponseBody().write(body, read);
@@ -187,6 +187,38 @@ namespace Aws
             ExportHttpMetricsToJson(json, metricsFromCore.httpClientMetrics, HttpClientMetricsType::RequestLatency);
             ExportHttpMetricsToJson(json, metricsFromCore.httpClientMetrics, HttpClientMetricsType::SslLatency);
             ExportHttpMetricsToJson(json, metricsFromCore.httpClientMetrics, HttpClientMetricsType::TcpLatency);
+            ExportHttpMetricsToJson(json, metricsFromCore.httpClientMetrics, HttpClientMetricsType::StreamsPerConnection);
+            ExportHttpMetricsToJson(json, metricsFromCore.httpClientMetrics, HttpClientMetricsType::WarmConnections);
+
+            // Optional request rate limiter state, while it limits the endpoint.
+            if (metricsFromCore.sendRateState.limiting)
+            {
+                json.WithDouble("SendRate", metricsFromCore.sendRateState.sendRate)
+                    .WithDouble("MeasuredSendRate", metricsFromCore.sendRateState.measuredSendRate)
+                    .WithInt64("SendRateDelay", metricsFromCore.sendRateDelay.count());
+            }
+
+            // Optional response cache outcome, for operations the client caches.
+            switch (metricsFromCore.responseCacheResult)
+            {
+                case ResponseCacheResult::Miss:
+                    json.WithString("ResponseCache", "Miss");
+                    break;
+                case ResponseCacheResult::Hit:
+                    json.WithString("ResponseCache", "Hit");
+                    break;
+                case ResponseCacheResult::Revalidated:
+                    json.WithString("ResponseCache", "Revalidated");
+                    break;
+                case ResponseCacheResult::NotCached:
+                    break;
+            }
+
+            // Optional hedging outcome, for hedged attempts.
+            if (metricsFromCore.hedgeResult != HedgeResult::NotHedged)
+            {
+                json.WithBool("HedgeWon", metricsFromCore.hedgeResult == HedgeResult::HedgeWon);
+            }
         }
 
         DefaultMonitoring::DefaultMonitoring(const Aws::String& clientId, const Aws::String& host, unsigned short port):
@@ -18,6 +18,9 @@ namespace Aws
         static const char HTTP_CLIENT_METRICS_DNS_LATENCY[] = "DnsLatency";
         static const char HTTP_CLIENT_METRICS_TCP_LATENCY[] = "TcpLatency";
         static const char HTTP_CLIENT_METRICS_SSL_LATENCY[] = "SslLatency";
+        static const char HTTP_CLIENT_METRICS_SSL_HANDSHAKES[] = "SslHandshakes";
+        static const char HTTP_CLIENT_METRICS_STREAMS_PER_CONNECTION[] = "StreamsPerConnection";
+        static const char HTTP_CLIENT_METRICS_WARM_CONNECTIONS[] = "WarmConnections";
         static const char HTTP_CLIENT_METRICS_UNKNOWN[] = "Unknown";
 
         using namespace Aws::Utils;
@@ -32,7 +35,10 @@ namespace Aws
                 std::pair<int, HttpClientMetricsType>(HashingUtils::HashString(HTTP_CLIENT_METRICS_REQUEST_LATENCY), HttpClientMetricsType::RequestLatency),
                 std::pair<int, HttpClientMetricsType>(HashingUtils::HashString(HTTP_CLIENT_METRICS_DNS_LATENCY), HttpClientMetricsType::DnsLatency),
                 std::pair<int, HttpClientMetricsType>(HashingUtils::HashString(HTTP_CLIENT_METRICS_TCP_LATENCY), HttpClientMetricsType::TcpLatency),
-                std::pair<int, HttpClientMetricsType>(HashingUtils::HashString(HTTP_CLIENT_METRICS_SSL_LATENCY), HttpClientMetricsType::SslLatency)
+                std::pair<int, HttpClientMetricsType>(HashingUtils::HashString(HTTP_CLIENT_METRICS_SSL_LATENCY), HttpClientMetricsType::SslLatency),
+                std::pair<int, HttpClientMetricsType>(HashingUtils::HashString(HTTP_CLIENT_METRICS_SSL_HANDSHAKES), HttpClientMetricsType::SslHandshakes),
+                std::pair<int, HttpClientMetricsType>(HashingUtils::HashString(HTTP_CLIENT_METRICS_STREAMS_PER_CONNECTION), HttpClientMetricsType::StreamsPerConnection),
+                std::pair<int, HttpClientMetricsType>(HashingUtils::HashString(HTTP_CLIENT_METRICS_WARM_CONNECTIONS), HttpClientMetricsType::WarmConnections)
             };
 
             int nameHash = HashingUtils::HashString(name.c_str());
@@ -56,6 +62,9 @@ namespace Aws
                 std::pair<int, std::string>(static_cast<int>(HttpClientMetricsType::DnsLatency), HTTP_CLIENT_METRICS_DNS_LATENCY),
                 std::pair<int, std::string>(static_cast<int>(HttpClientMetricsType::TcpLatency), HTTP_CLIENT_METRICS_TCP_LATENCY),
                 std::pair<int, std::string>(static_cast<int>(HttpClientMetricsType::SslLatency), HTTP_CLIENT_METRICS_SSL_LATENCY),
+                std::pair<int, std::string>(static_cast<int>(HttpClientMetricsType::SslHandshakes), HTTP_CLIENT_METRICS_SSL_HANDSHAKES),
+                std::pair<int, std::string>(static_cast<int>(HttpClientMetricsType::StreamsPerConnection), HTTP_CLIENT_METRICS_STREAMS_PER_CONNECTION),
+                std::pair<int, std::string>(static_cast<int>(HttpClientMetricsType::WarmConnections), HTTP_CLIENT_METRICS_WARM_CONNECTIONS),
                 std::pair<int, std::string>(static_cast<int>(HttpClientMetricsType::Unknown), HTTP_CLIENT_METRICS_UNKNOWN)
             };
 
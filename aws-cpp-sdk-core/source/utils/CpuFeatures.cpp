@@ -0,0 +1,126 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/CpuFeatures.h>
+#include <atomic>
+
+#if defined(AWS_CORE_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#elif defined(AWS_CORE_SIMD_NEON) && defined(__linux__)
+#include <sys/auxv.h>
+#endif
+
+using namespace Aws::Utils;
+
+namespace
+{
+    struct DetectedFeatures
+    {
+        DetectedFeatures() : ssse3(false), sse42(false), pclmulqdq(false), avx2(false), neon(false), armCrc32(false)
+        {
+#if defined(AWS_CORE_SIMD_X86) && defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            const int maxLeaf = info[0];
+            __cpuid(info, 1);
+            ssse3 = (info[2] & (1 << 9)) != 0;
+            sse42 = (info[2] & (1 << 20)) != 0;
+            pclmulqdq = (info[2] & (1 << 1)) != 0;
+            // AVX registers are only usable if the OS saves them on context switches.
+            const bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+            if (osSavesAvx && maxLeaf >= 7)
+            {
+                __cpuidex(info, 7, 0);
+                avx2 = (info[1] & (1 << 5)) != 0;
+            }
+#elif defined(AWS_CORE_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+            __builtin_cpu_init();
+            ssse3 = __builtin_cpu_supports("ssse3") != 0;
+            sse42 = __builtin_cpu_supports("sse4.2") != 0;
+            pclmulqdq = __builtin_cpu_supports("pclmul") != 0;
+            avx2 = __builtin_cpu_supports("avx2") != 0;
+#elif defined(AWS_CORE_SIMD_NEON)
+            // Advanced SIMD is part of every AArch64 CPU.
+            neon = true;
+#if defined(__linux__)
+            // HWCAP_CRC32 from asm/hwcap.h.
+            armCrc32 = (getauxval(AT_HWCAP) & (1 << 7)) != 0;
+#elif defined(__APPLE__)
+            armCrc32 = true;
+#endif
+#endif
+        }
+
+        bool ssse3;
+        bool sse42;
+        bool pclmulqdq;
+        bool avx2;
+        bool neon;
+        bool armCrc32;
+    };
+
+    const DetectedFeatures& GetDetectedFeatures()
+    {
+        static const DetectedFeatures features;
+        return features;
+    }
+
+    std::atomic<int> s_maxSimdLevel(static_cast<int>(SimdLevel::NEON));
+}
+
+bool CpuFeatures::HasSSSE3()
+{
+    return GetDetectedFeatures().ssse3;
+}
+
+bool CpuFeatures::HasSSE42()
+{
+    return GetDetectedFeatures().sse42;
+}
+
+bool CpuFeatures::HasPCLMULQDQ()
+{
+    return GetDetectedFeatures().pclmulqdq;
+}
+
+bool CpuFeatures::HasAVX2()
+{
+    return GetDetectedFeatures().avx2;
+}
+
+bool CpuFeatures::HasNEON()
+{
+    return GetDetectedFeatures().neon;
+}
+
+bool CpuFeatures::HasARMCRC32()
+{
+    return GetDetectedFeatures().armCrc32;
+}
+
+SimdLevel CpuFeatures::GetSimdLevel()
+{
+    const DetectedFeatures& features = GetDetectedFeatures();
+    const int maxLevel = s_maxSimdLevel.load(std::memory_order_relaxed);
+    if (features.neon && maxLevel >= static_cast<int>(SimdLevel::NEON))
+    {
+        return SimdLevel::NEON;
+    }
+    if (features.avx2 && features.ssse3 && maxLevel >= static_cast<int>(SimdLevel::AVX2))
+    {
+        return SimdLevel::AVX2;
+    }
+    if (features.ssse3 && maxLevel >= static_cast<int>(SimdLevel::SSSE3))
+    {
+        return SimdLevel::SSSE3;
+    }
+    return SimdLevel::Scalar;
+}
+
+void CpuFeatures::SetMaxSimdLevel(SimdLevel level)
+{
+    s_maxSimdLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
@@ -11,12 +11,20 @@
 #include <aws/core/utils/crypto/Sha256HMAC.h>
 #include <aws/core/utils/crypto/Sha1.h>
 #include <aws/core/utils/crypto/MD5.h>
+#include <aws/core/utils/crypto/CRC32.h>
 #include <aws/core/utils/Outcome.h>
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
-#include <aws/core/utils/memory/stl/AWSList.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <aws/core/utils/CpuFeatures.h>
 
 #include <iomanip>
 
+#if defined(AWS_CORE_SIMD_X86)
+#include <immintrin.h>
+#elif defined(AWS_CORE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
 using namespace Aws::Utils;
 using namespace Aws::Utils::Base64;
 using namespace Aws::Utils::Crypto;
@@ -27,6 +35,161 @@ static Aws::Utils::Base64::Base64 s_base64;
 // Aws Glacier Tree Hash calculates hash value for each 1MB data
 const static size_t TREE_HASH_ONE_MB = 1024 * 1024;
 
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+/*
+ * Vectorized hex codecs. Each one handles as many whole vectors as it can from the start of its input and returns the
+ * number of input bytes consumed; the scalar code finishes the rest. Decoders stop at the first vector holding anything
+ * but hex digits, so that the scalar decoder handles it exactly as before.
+ */
+#if defined(AWS_CORE_SIMD_X86)
+
+AWS_CORE_TARGET("ssse3")
+static size_t HexEncodeSsse3(const unsigned char* input, size_t length, char* output)
+{
+    const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(HEX_DIGITS));
+    const __m128i lowMask = _mm_set1_epi8(0x0f);
+
+    size_t consumed = 0;
+    for (; consumed + 16 <= length; consumed += 16, output += 32)
+    {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed));
+        const __m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(in, 4), lowMask));
+        const __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(in, lowMask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16), _mm_unpackhi_epi8(high, low));
+    }
+    return consumed;
+}
+
+AWS_CORE_TARGET("avx2")
+static size_t HexEncodeAvx2(const unsigned char* input, size_t length, char* output)
+{
+    const __m256i digits = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(HEX_DIGITS)));
+    const __m256i lowMask = _mm256_set1_epi8(0x0f);
+
+    size_t consumed = 0;
+    for (; consumed + 32 <= length; consumed += 32, output += 64)
+    {
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + consumed));
+        const __m256i high = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(in, 4), lowMask));
+        const __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(in, lowMask));
+        // Unpacking works within 128-bit lanes, so the halves come out as bytes 0-7 and 16-23, then 8-15 and 24-31.
+        const __m256i first = _mm256_unpacklo_epi8(high, low);
+        const __m256i second = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    return consumed;
+}
+
+// Maps hex digits of either case to their values; valid is set to all ones for hex digits and to zero for anything else.
+AWS_CORE_TARGET("ssse3")
+static inline __m128i HexValuesSsse3(__m128i in, __m128i& valid)
+{
+    const __m128i digit = _mm_sub_epi8(in, _mm_set1_epi8('0'));
+    const __m128i letter = _mm_sub_epi8(_mm_or_si128(in, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i isDigit = _mm_cmpeq_epi8(_mm_max_epu8(digit, _mm_set1_epi8(9)), _mm_set1_epi8(9));
+    const __m128i isLetter = _mm_cmpeq_epi8(_mm_max_epu8(letter, _mm_set1_epi8(5)), _mm_set1_epi8(5));
+    valid = _mm_or_si128(isDigit, isLetter);
+    return _mm_or_si128(_mm_and_si128(isDigit, digit), _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+AWS_CORE_TARGET("ssse3")
+static size_t HexDecodeSsse3(const char* input, size_t length, unsigned char* output)
+{
+    size_t consumed = 0;
+    for (; consumed + 16 <= length; consumed += 16, output += 8)
+    {
+        __m128i valid;
+        const __m128i values = HexValuesSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed)), valid);
+        if (_mm_movemask_epi8(valid) != 0xFFFF)
+        {
+            break;
+        }
+        // Combines each pair of nibbles into high * 16 + low.
+        const __m128i bytes = _mm_maddubs_epi16(values, _mm_set1_epi16(0x0110));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(output), _mm_packus_epi16(bytes, bytes));
+    }
+    return consumed;
+}
+
+AWS_CORE_TARGET("avx2")
+static size_t HexDecodeAvx2(const char* input, size_t length, unsigned char* output)
+{
+    size_t consumed = 0;
+    for (; consumed + 32 <= length; consumed += 32, output += 16)
+    {
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + consumed));
+        const __m256i digit = _mm256_sub_epi8(in, _mm256_set1_epi8('0'));
+        const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(in, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+        const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_max_epu8(digit, _mm256_set1_epi8(9)), _mm256_set1_epi8(9));
+        const __m256i isLetter = _mm256_cmpeq_epi8(_mm256_max_epu8(letter, _mm256_set1_epi8(5)), _mm256_set1_epi8(5));
+        if (_mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter)) != -1)
+        {
+            break;
+        }
+        const __m256i values = _mm256_or_si256(_mm256_and_si256(isDigit, digit),
+            _mm256_and_si256(isLetter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+        const __m256i bytes = _mm256_maddubs_epi16(values, _mm256_set1_epi16(0x0110));
+        // Packing works within 128-bit lanes; the results are the first 64 bits of each lane.
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(bytes, bytes), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm256_castsi256_si128(packed));
+    }
+    return consumed;
+}
+
+#elif defined(AWS_CORE_SIMD_NEON)
+
+static size_t HexEncodeNeon(const unsigned char* input, size_t length, char* output)
+{
+    const uint8x16_t digits = vld1q_u8(reinterpret_cast<const uint8_t*>(HEX_DIGITS));
+    const uint8x16_t lowMask = vdupq_n_u8(0x0f);
+
+    size_t consumed = 0;
+    for (; consumed + 16 <= length; consumed += 16, output += 32)
+    {
+        const uint8x16_t in = vld1q_u8(input + consumed);
+        uint8x16x2_t characters;
+        characters.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(in, 4));
+        characters.val[1] = vqtbl1q_u8(digits, vandq_u8(in, lowMask));
+        vst2q_u8(reinterpret_cast<uint8_t*>(output), characters);
+    }
+    return consumed;
+}
+
+static inline uint8x16_t HexValuesNeon(uint8x16_t in, uint8x16_t& valid)
+{
+    const uint8x16_t digit = vsubq_u8(in, vdupq_n_u8('0'));
+    const uint8x16_t letter = vsubq_u8(vorrq_u8(in, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const uint8x16_t isDigit = vcleq_u8(digit, vdupq_n_u8(9));
+    const uint8x16_t isLetter = vcleq_u8(letter, vdupq_n_u8(5));
+    valid = vorrq_u8(isDigit, isLetter);
+    return vbslq_u8(isDigit, digit, vaddq_u8(letter, vdupq_n_u8(10)));
+}
+
+static size_t HexDecodeNeon(const char* input, size_t length, unsigned char* output)
+{
+    size_t consumed = 0;
+    for (; consumed + 32 <= length; consumed += 32, output += 16)
+    {
+        // vld2q splits the characters into the high and the low digit of each byte.
+        const uint8x16x2_t in = vld2q_u8(reinterpret_cast<const uint8_t*>(input + consumed));
+        uint8x16_t highValid;
+        uint8x16_t lowValid;
+        const uint8x16_t high = HexValuesNeon(in.val[0], highValid);
+        const uint8x16_t low = HexValuesNeon(in.val[1], lowValid);
+        if (vminvq_u8(vandq_u8(highValid, lowValid)) == 0)
+        {
+            break;
+        }
+        vst1q_u8(output, vorrq_u8(vshlq_n_u8(high, 4), low));
+    }
+    return consumed;
+}
+
+#endif
+
 Aws::String HashingUtils::Base64Encode(const ByteBuffer& message)
 {
     return s_base64.Encode(message);
@@ -56,36 +219,37 @@ ByteBuffer HashingUtils::CalculateSHA256(Aws::IOStream& stream)
 }
 
 /**
- * This function is only used by HashingUtils::CalculateSHA256TreeHash() in this cpp file
+ * This function is only used by the HashingUtils::CalculateSHA256TreeHash() overloads and CombineSHA256TreeHashes() in this cpp file
  * It's a helper function be used to compute the TreeHash defined at:
  * http://docs.aws.amazon.com/amazonglacier/latest/dev/checksum-calculations.html
  */
-static ByteBuffer TreeHashFinalCompute(Aws::List<ByteBuffer>& input)
+static ByteBuffer TreeHashFinalCompute(Aws::Vector<ByteBuffer>& input)
 {
     Sha256 hash;
     assert(input.size() != 0);
 
     // O(n) time complexity of merging (n + n/2 + n/4 + n/8 +...+ 1)
+    // Each level is built in place at the front of the vector: neighbouring pairs are hashed together
+    // and an odd element at the end is carried up to the next level as is.
+    Aws::String concatenated;
     while (input.size() > 1)
     {
-        auto iter = input.begin();
-        // if only one element left, just left it there
-        while (std::next(iter) != input.end())
+        size_t levelSize = 0;
+        for (size_t i = 0; i < input.size(); i += 2)
         {
-            // if >= two elements
-            Aws::String str(reinterpret_cast<char*>(iter->GetUnderlyingData()), iter->GetLength());
-            // list erase returns iterator of next element next to the erased element or end() if erased the last one
-            // list insert inserts element before pos, here we erase two elements, and insert a new element
-            iter = input.erase(iter);
-            str.append(reinterpret_cast<char*>(iter->GetUnderlyingData()), iter->GetLength());
-            iter = input.erase(iter);
-            input.insert(iter, hash.Calculate(str).GetResult());
-
-            if (iter == input.end()) break;
-        } // while process to the last element
-    } // while the list has only one element left
+            if (i + 1 == input.size())
+            {
+                input[levelSize++] = std::move(input[i]);
+                break;
+            }
+            concatenated.assign(reinterpret_cast<char*>(input[i].GetUnderlyingData()), input[i].GetLength());
+            concatenated.append(reinterpret_cast<char*>(input[i + 1].GetUnderlyingData()), input[i + 1].GetLength());
+            input[levelSize++] = hash.Calculate(concatenated).GetResult();
+        }
+        input.resize(levelSize);
+    }
 
-    return *(input.begin());
+    return input.front();
 }
 
 ByteBuffer HashingUtils::CalculateSHA256TreeHash(const Aws::String& str)
@@ -96,7 +260,8 @@ ByteBuffer HashingUtils::CalculateSHA256TreeHash(const Aws::String& str)
         return hash.Calculate(str).GetResult();
     }
 
-    Aws::List<ByteBuffer> input;
+    Aws::Vector<ByteBuffer> input;
+    input.reserve((str.size() + TREE_HASH_ONE_MB - 1) / TREE_HASH_ONE_MB);
     size_t pos = 0;
     while (pos < str.size())
     {
@@ -110,7 +275,7 @@ ByteBuffer HashingUtils::CalculateSHA256TreeHash(const Aws::String& str)
 ByteBuffer HashingUtils::CalculateSHA256TreeHash(Aws::IOStream& stream)
 {
     Sha256 hash;
-    Aws::List<ByteBuffer> input;
+    Aws::Vector<ByteBuffer> input;
     auto currentPos = stream.tellg();
     if (currentPos == std::ios::pos_type(-1))
     {
@@ -138,18 +303,54 @@ ByteBuffer HashingUtils::CalculateSHA256TreeHash(Aws::IOStream& stream)
     return TreeHashFinalCompute(input);
 }
 
+ByteBuffer HashingUtils::CombineSHA256TreeHashes(const Aws::Vector<ByteBuffer>& treeHashes)
+{
+    if (treeHashes.empty())
+    {
+        Sha256 hash;
+        return hash.Calculate("").GetResult();
+    }
+
+    Aws::Vector<ByteBuffer> input(treeHashes);
+    return TreeHashFinalCompute(input);
+}
+
 Aws::String HashingUtils::HexEncode(const ByteBuffer& message)
 {
-    Aws::String encoded;
-    encoded.reserve(2 * message.GetLength());
+    Aws::String encoded(2 * message.GetLength(), '\0');
+    HexEncode(message.GetUnderlyingData(), message.GetLength(), &encoded[0]);
+    return encoded;
+}
 
-    for (unsigned i = 0; i < message.GetLength(); ++i)
+size_t HashingUtils::HexEncode(const unsigned char* input, size_t length, char* output)
+{
+    size_t consumed = 0;
+    const SimdLevel simdLevel = CpuFeatures::GetSimdLevel();
+#if defined(AWS_CORE_SIMD_X86)
+    if (simdLevel == SimdLevel::AVX2)
+    {
+        consumed = HexEncodeAvx2(input, length, output);
+    }
+    if (simdLevel == SimdLevel::AVX2 || simdLevel == SimdLevel::SSSE3)
     {
-        encoded.push_back("0123456789abcdef"[message[i] >> 4]);
-        encoded.push_back("0123456789abcdef"[message[i] & 0x0f]);
+        consumed += HexEncodeSsse3(input + consumed, length - consumed, output + 2 * consumed);
     }
+#elif defined(AWS_CORE_SIMD_NEON)
+    if (simdLevel == SimdLevel::NEON)
+    {
+        consumed = HexEncodeNeon(input, length, output);
+    }
+#else
+    AWS_UNREFERENCED_PARAM(simdLevel);
+#endif
 
-    return encoded;
+    for (size_t i = consumed; i < length; ++i)
+    {
+        output[2 * i] = HEX_DIGITS[input[i] >> 4];
+        output[2 * i + 1] = HEX_DIGITS[input[i] & 0x0f];
+    }
+
+    return 2 * length;
 }
 
 ByteBuffer HashingUtils::HexDecode(const Aws::String& str)
@@ -173,17 +374,44 @@ ByteBuffer HashingUtils::HexDecode(const Aws::String& str)
     }
 
     ByteBuffer hexBuffer(strLength / 2);
-    size_t bufferIndex = 0;
+    HexDecode(str.c_str() + readIndex, strLength, hexBuffer.GetUnderlyingData());
+    return hexBuffer;
+}
+
+size_t HashingUtils::HexDecode(const char* input, size_t length, unsigned char* output)
+{
+    assert(length % 2 == 0);
 
-    for (size_t i = readIndex; i < str.length(); i += 2)
+    size_t consumed = 0;
+    const SimdLevel simdLevel = CpuFeatures::GetSimdLevel();
+#if defined(AWS_CORE_SIMD_X86)
+    if (simdLevel == SimdLevel::AVX2)
+    {
+        consumed = HexDecodeAvx2(input, length, output);
+    }
+    if (simdLevel == SimdLevel::AVX2 || simdLevel == SimdLevel::SSSE3)
     {
-        if(!StringUtils::IsAlnum(str[i]) || !StringUtils::IsAlnum(str[i + 1]))
+        consumed += HexDecodeSsse3(input + consumed, length - consumed, output + consumed / 2);
+    }
+#elif defined(AWS_CORE_SIMD_NEON)
+    if (simdLevel == SimdLevel::NEON)
+    {
+        consumed = HexDecodeNeon(input, length, output);
+    }
+#else
+    AWS_UNREFERENCED_PARAM(simdLevel);
+#endif
+
+    size_t bufferIndex = consumed / 2;
+    for (size_t i = consumed; i + 1 < length; i += 2)
+    {
+        if(!StringUtils::IsAlnum(input[i]) || !StringUtils::IsAlnum(input[i + 1]))
         {
             //contains non-hex characters
             assert(0);
         }
 
-        char firstChar = str[i];
+        char firstChar = input[i];
         uint8_t distance = firstChar - '0';
 
         if(isalpha(firstChar))
@@ -194,7 +422,7 @@ ByteBuffer HashingUtils::HexDecode(const Aws::String& str)
 
         unsigned char val = distance * 16;
 
-        char secondChar = str[i + 1];
+        char secondChar = input[i + 1];
         distance = secondChar - '0';
 
         if(isalpha(secondChar))
@@ -204,10 +432,10 @@ ByteBuffer HashingUtils::HexDecode(const Aws::String& str)
         }
 
         val += distance;
-        hexBuffer[bufferIndex++] = val;
+        output[bufferIndex++] = val;
     }
 
-    return hexBuffer;
+    return bufferIndex;
 }
 
 ByteBuffer HashingUtils::CalculateSHA1(const Aws::String& str)
@@ -234,6 +462,30 @@ ByteBuffer HashingUtils::CalculateMD5(Aws::IOStream& stream)
     return hash.Calculate(stream).GetResult();
 }
 
+ByteBuffer HashingUtils::CalculateCRC32(const Aws::String& str)
+{
+    CRC32 hash;
+    return hash.Calculate(str).GetResult();
+}
+
+ByteBuffer HashingUtils::CalculateCRC32(Aws::IOStream& stream)
+{
+    CRC32 hash;
+    return hash.Calculate(stream).GetResult();
+}
+
+ByteBuffer HashingUtils::CalculateCRC32C(const Aws::String& str)
+{
+    CRC32C hash;
+    return hash.Calculate(str).GetResult();
+}
+
+ByteBuffer HashingUtils::CalculateCRC32C(Aws::IOStream& stream)
+{
+    CRC32C hash;
+    return hash.Calculate(stream).GetResult();
+}
+
 int HashingUtils::HashString(const char* strToHash)
 {
     if (!strToHash)
@@ -4,13 +4,255 @@
  */
 
 #include <aws/core/utils/base64/Base64.h>
+#include <aws/core/utils/CpuFeatures.h>
 #include <cstring>
 
+#if defined(AWS_CORE_SIMD_X86)
+#include <immintrin.h>
+#elif defined(AWS_CORE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
 using namespace Aws::Utils::Base64;
 
 static const uint8_t SENTINEL_VALUE = 255;
 static const char BASE64_ENCODING_TABLE_MIME[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
+/*
+ * Vectorized codecs for the MIME alphabet. Each one handles as many whole blocks as it can from the start of its input and
+ * returns the number of input bytes consumed; the scalar code finishes the rest. Decoders stop at the first vector holding
+ * anything but alphabet characters, padding included, so that the scalar decoder handles it exactly as before.
+ */
+#if defined(AWS_CORE_SIMD_X86)
+
+AWS_CORE_TARGET("ssse3")
+static inline __m128i LookupBase64Ssse3(__m128i indices)
+{
+    // Maps 0..25 to 13, 26..51 to 0, 52..61 to 1..10, 62 to 11 and 63 to 12, then adds the offset to the character.
+    const __m128i shiftLut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    __m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+    return _mm_add_epi8(_mm_shuffle_epi8(shiftLut, result), indices);
+}
+
+AWS_CORE_TARGET("ssse3")
+static inline __m128i SplitBase64Ssse3(__m128i in)
+{
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
+
+AWS_CORE_TARGET("ssse3")
+static size_t EncodeBase64Ssse3(const unsigned char* input, size_t length, char* output)
+{
+    size_t consumed = 0;
+    // Reads 16 bytes to encode 12.
+    for (; consumed + 16 <= length; consumed += 12, output += 16)
+    {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), LookupBase64Ssse3(SplitBase64Ssse3(in)));
+    }
+    return consumed;
+}
+
+AWS_CORE_TARGET("avx2")
+static size_t EncodeBase64Avx2(const unsigned char* input, size_t length, char* output)
+{
+    const __m256i shuffle = _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+        10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m256i shiftLut = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+    size_t consumed = 0;
+    // Reads 12 bytes into each 128-bit lane, 28 bytes in all, to encode 24.
+    for (; consumed + 28 <= length; consumed += 24, output += 32)
+    {
+        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed + 12));
+        __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+        in = _mm256_shuffle_epi8(in, shuffle);
+        const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+        const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+        const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        const __m256i indices = _mm256_or_si256(t1, t3);
+
+        __m256i result = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        result = _mm256_or_si256(result, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+        result = _mm256_add_epi8(_mm256_shuffle_epi8(shiftLut, result), indices);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), result);
+    }
+    return consumed;
+}
+
+AWS_CORE_TARGET("ssse3")
+static size_t DecodeBase64Ssse3(const char* input, size_t length, unsigned char* output, size_t outputLength)
+{
+    // A character is valid if the bits its low and high nibbles map to do not intersect.
+    const __m128i lutLow = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lutHigh = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    size_t consumed = 0;
+    size_t written = 0;
+    // Writes 16 bytes to decode 12.
+    for (; consumed + 16 <= length && written + 16 <= outputLength; consumed += 16, written += 12)
+    {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed));
+        const __m128i highNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), _mm_set1_epi8(0x0f));
+        const __m128i lowNibbles = _mm_and_si128(in, _mm_set1_epi8(0x0f));
+        const __m128i low = _mm_shuffle_epi8(lutLow, lowNibbles);
+        const __m128i high = _mm_shuffle_epi8(lutHigh, highNibbles);
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(low, high), _mm_setzero_si128())) != 0)
+        {
+            break;
+        }
+
+        const __m128i isSlash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+        const __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(isSlash, highNibbles));
+        const __m128i values = _mm_add_epi8(in, roll);
+        const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        const __m128i words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + written), _mm_shuffle_epi8(words, pack));
+    }
+    return consumed;
+}
+
+AWS_CORE_TARGET("avx2")
+static size_t DecodeBase64Avx2(const char* input, size_t length, unsigned char* output, size_t outputLength)
+{
+    const __m256i lutLow = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lutHigh = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i joinLanes = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+
+    size_t consumed = 0;
+    size_t written = 0;
+    // Writes 32 bytes to decode 24.
+    for (; consumed + 32 <= length && written + 32 <= outputLength; consumed += 32, written += 24)
+    {
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + consumed));
+        const __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), _mm256_set1_epi8(0x0f));
+        const __m256i lowNibbles = _mm256_and_si256(in, _mm256_set1_epi8(0x0f));
+        const __m256i low = _mm256_shuffle_epi8(lutLow, lowNibbles);
+        const __m256i high = _mm256_shuffle_epi8(lutHigh, highNibbles);
+        if (_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_and_si256(low, high), _mm256_setzero_si256())) != 0)
+        {
+            break;
+        }
+
+        const __m256i isSlash = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('/'));
+        const __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(isSlash, highNibbles));
+        const __m256i values = _mm256_add_epi8(in, roll);
+        const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        const __m256i words = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(words, pack), joinLanes);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + written), packed);
+    }
+    return consumed;
+}
+
+#elif defined(AWS_CORE_SIMD_NEON)
+
+static const uint8_t BASE64_DECODING_TABLE_MIME[128] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255, 255, 255,  63,
+     52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255, 255, 255, 255,
+    255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+     15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255, 255,
+    255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+     41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255,
+};
+
+static inline uint8x16x4_t LoadTable64(const uint8_t* table)
+{
+    uint8x16x4_t result;
+    result.val[0] = vld1q_u8(table);
+    result.val[1] = vld1q_u8(table + 16);
+    result.val[2] = vld1q_u8(table + 32);
+    result.val[3] = vld1q_u8(table + 48);
+    return result;
+}
+
+static size_t EncodeBase64Neon(const unsigned char* input, size_t length, char* output)
+{
+    const uint8x16x4_t table = LoadTable64(reinterpret_cast<const uint8_t*>(BASE64_ENCODING_TABLE_MIME));
+    const uint8x16_t mask6 = vdupq_n_u8(0x3F);
+
+    size_t consumed = 0;
+    // vld3q splits 48 bytes into the first, second and third byte of each group of 3.
+    for (; consumed + 48 <= length; consumed += 48, output += 64)
+    {
+        const uint8x16x3_t in = vld3q_u8(input + consumed);
+        uint8x16x4_t indices;
+        indices.val[0] = vshrq_n_u8(in.val[0], 2);
+        indices.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask6);
+        indices.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask6);
+        indices.val[3] = vandq_u8(in.val[2], mask6);
+
+        uint8x16x4_t characters;
+        characters.val[0] = vqtbl4q_u8(table, indices.val[0]);
+        characters.val[1] = vqtbl4q_u8(table, indices.val[1]);
+        characters.val[2] = vqtbl4q_u8(table, indices.val[2]);
+        characters.val[3] = vqtbl4q_u8(table, indices.val[3]);
+        vst4q_u8(reinterpret_cast<uint8_t*>(output), characters);
+    }
+    return consumed;
+}
+
+static size_t DecodeBase64Neon(const char* input, size_t length, unsigned char* output, size_t outputLength)
+{
+    const uint8x16x4_t tableLow = LoadTable64(BASE64_DECODING_TABLE_MIME);
+    const uint8x16x4_t tableHigh = LoadTable64(BASE64_DECODING_TABLE_MIME + 64);
+    const uint8x16_t offset = vdupq_n_u8(64);
+    const uint8x16_t nonAscii = vdupq_n_u8(128);
+
+    size_t consumed = 0;
+    size_t written = 0;
+    for (; consumed + 64 <= length && written + 48 <= outputLength; consumed += 64, written += 48)
+    {
+        const uint8x16x4_t in = vld4q_u8(reinterpret_cast<const uint8_t*>(input + consumed));
+        uint8x16x4_t values;
+        for (int i = 0; i < 4; ++i)
+        {
+            // Characters 0..63 come from the low table, 64..127 from the high one; anything else maps to 255.
+            uint8x16_t value = vqtbl4q_u8(tableLow, in.val[i]);
+            value = vqtbx4q_u8(value, tableHigh, vsubq_u8(in.val[i], offset));
+            values.val[i] = vorrq_u8(value, vcgeq_u8(in.val[i], nonAscii));
+        }
+        const uint8x16_t any = vorrq_u8(vorrq_u8(values.val[0], values.val[1]), vorrq_u8(values.val[2], values.val[3]));
+        if (vmaxvq_u8(any) > 63)
+        {
+            break;
+        }
+
+        uint8x16x3_t bytes;
+        bytes.val[0] = vorrq_u8(vshlq_n_u8(values.val[0], 2), vshrq_n_u8(values.val[1], 4));
+        bytes.val[1] = vorrq_u8(vshlq_n_u8(values.val[1], 4), vshrq_n_u8(values.val[2], 2));
+        bytes.val[2] = vorrq_u8(vshlq_n_u8(values.val[2], 6), values.val[3]);
+        vst3q_u8(output + written, bytes);
+    }
+    return consumed;
+}
+
+#endif
+
 namespace Aws
 {
 namespace Utils
@@ -33,6 +275,7 @@ Base64::Base64(const char *encodingTable)
     }
 
     memcpy(m_mimeBase64EncodingTable, encodingTable, encodingTableLength);
+    m_isMimeTable = memcmp(m_mimeBase64EncodingTable, BASE64_ENCODING_TABLE_MIME, 64) == 0;
 
     memset((void *)m_mimeBase64DecodingTable, 0, 256);
 
@@ -47,82 +290,134 @@ Base64::Base64(const char *encodingTable)
 
 Aws::String Base64::Encode(const Aws::Utils::ByteBuffer& buffer) const
 {
-    size_t bufferLength = buffer.GetLength();
-    size_t blockCount = (bufferLength + 2) / 3;
-    size_t remainderCount = (bufferLength % 3);
-
-    Aws::String outputString;
-    outputString.reserve(CalculateBase64EncodedLength(buffer));
+    Aws::String outputString(CalculateBase64EncodedLength(buffer), '\0');
+    Encode(buffer.GetUnderlyingData(), buffer.GetLength(), &outputString[0]);
+    return outputString;
+}
 
-    for(size_t i = 0; i < bufferLength; i += 3 )
+size_t Base64::Encode(const unsigned char* input, size_t length, char* output) const
+{
+    size_t consumed = 0;
+    if (m_isMimeTable)
     {
-        uint32_t block = buffer[ i ];
-
-        block <<= 8;
-        if (i + 1 < bufferLength)
+        const SimdLevel simdLevel = CpuFeatures::GetSimdLevel();
+#if defined(AWS_CORE_SIMD_X86)
+        if (simdLevel == SimdLevel::AVX2)
         {
-            block = block | buffer[ i + 1 ];
+            consumed = EncodeBase64Avx2(input, length, output);
         }
-
-        block <<= 8;
-        if (i + 2 < bufferLength)
+        if (simdLevel == SimdLevel::AVX2 || simdLevel == SimdLevel::SSSE3)
+        {
+            consumed += EncodeBase64Ssse3(input + consumed, length - consumed, output + consumed / 3 * 4);
+        }
+#elif defined(AWS_CORE_SIMD_NEON)
+        if (simdLevel == SimdLevel::NEON)
         {
-            block = block | buffer[ i + 2 ];
+            consumed = EncodeBase64Neon(input, length, output);
         }
+#else
+        AWS_UNREFERENCED_PARAM(simdLevel);
+#endif
+    }
 
-        outputString.push_back(m_mimeBase64EncodingTable[(block >> 18) & 0x3F]);
-        outputString.push_back(m_mimeBase64EncodingTable[(block >> 12) & 0x3F]);
-        outputString.push_back(m_mimeBase64EncodingTable[(block >> 6) & 0x3F]);
-        outputString.push_back(m_mimeBase64EncodingTable[block & 0x3F]);
+    char* out = output + consumed / 3 * 4;
+    for (; consumed + 3 <= length; consumed += 3)
+    {
+        const uint32_t block = (uint32_t(input[consumed]) << 16) | (uint32_t(input[consumed + 1]) << 8) | input[consumed + 2];
+        *out++ = m_mimeBase64EncodingTable[(block >> 18) & 0x3F];
+        *out++ = m_mimeBase64EncodingTable[(block >> 12) & 0x3F];
+        *out++ = m_mimeBase64EncodingTable[(block >> 6) & 0x3F];
+        *out++ = m_mimeBase64EncodingTable[block & 0x3F];
     }
 
-    if(remainderCount > 0)
+    const size_t remainderCount = length - consumed;
+    if (remainderCount > 0)
     {
-        outputString[blockCount * 4 - 1] = '=';
-        if(remainderCount == 1)
+        uint32_t block = uint32_t(input[consumed]) << 16;
+        if (remainderCount == 2)
         {
-            outputString[blockCount * 4 - 2] = '=';
+            block |= uint32_t(input[consumed + 1]) << 8;
         }
+        *out++ = m_mimeBase64EncodingTable[(block >> 18) & 0x3F];
+        *out++ = m_mimeBase64EncodingTable[(block >> 12) & 0x3F];
+        *out++ = remainderCount == 2 ? m_mimeBase64EncodingTable[(block >> 6) & 0x3F] : '=';
+        *out++ = '=';
     }
 
-    return outputString;
+    return static_cast<size_t>(out - output);
 }
 
 Aws::Utils::ByteBuffer Base64::Decode(const Aws::String& str) const
 {
-    size_t decodedLength = CalculateBase64DecodedLength(str);
+    Aws::Utils::ByteBuffer buffer(CalculateBase64DecodedLength(str));
+    Decode(str.c_str(), str.length(), buffer.GetUnderlyingData());
+    return buffer;
+}
 
-    Aws::Utils::ByteBuffer buffer(decodedLength);
+size_t Base64::Decode(const char* input, size_t length, unsigned char* output) const
+{
+    const size_t decodedLength = CalculateBase64DecodedLength(input, length);
+    size_t consumed = 0;
+    if (m_isMimeTable)
+    {
+        const SimdLevel simdLevel = CpuFeatures::GetSimdLevel();
+#if defined(AWS_CORE_SIMD_X86)
+        if (simdLevel == SimdLevel::AVX2)
+        {
+            consumed = DecodeBase64Avx2(input, length, output, decodedLength);
+        }
+        if (simdLevel == SimdLevel::AVX2 || simdLevel == SimdLevel::SSSE3)
+        {
+            const size_t written = consumed / 4 * 3;
+            consumed += DecodeBase64Ssse3(input + consumed, length - consumed, output + written, decodedLength - written);
+        }
+#elif defined(AWS_CORE_SIMD_NEON)
+        if (simdLevel == SimdLevel::NEON)
+        {
+            consumed = DecodeBase64Neon(input, length, output, decodedLength);
+        }
+#else
+        AWS_UNREFERENCED_PARAM(simdLevel);
+#endif
+    }
 
-    const char* rawString = str.c_str();
-    size_t blockCount = str.length() / 4;
-    for(size_t i = 0; i < blockCount; ++i)
+    const size_t blockCount = length / 4;
+    for(size_t i = consumed / 4; i < blockCount; ++i)
     {
         size_t stringIndex = i * 4;
 
-        uint32_t value1 = m_mimeBase64DecodingTable[uint32_t(rawString[stringIndex])];
-        uint32_t value2 = m_mimeBase64DecodingTable[uint32_t(rawString[++stringIndex])];
-        uint32_t value3 = m_mimeBase64DecodingTable[uint32_t(rawString[++stringIndex])];
-        uint32_t value4 = m_mimeBase64DecodingTable[uint32_t(rawString[++stringIndex])];
+        uint32_t value1 = m_mimeBase64DecodingTable[static_cast<unsigned char>(input[stringIndex])];
+        uint32_t value2 = m_mimeBase64DecodingTable[static_cast<unsigned char>(input[++stringIndex])];
+        uint32_t value3 = m_mimeBase64DecodingTable[static_cast<unsigned char>(input[++stringIndex])];
+        uint32_t value4 = m_mimeBase64DecodingTable[static_cast<unsigned char>(input[++stringIndex])];
 
+        // Malformed input can have more blocks than decodedLength accounts for.
         size_t bufferIndex = i * 3;
-        buffer[bufferIndex] = static_cast<uint8_t>((value1 << 2) | ((value2 >> 4) & 0x03));
-        if(value3 != SENTINEL_VALUE)
+        if (bufferIndex >= decodedLength)
+        {
+            break;
+        }
+        output[bufferIndex] = static_cast<uint8_t>((value1 << 2) | ((value2 >> 4) & 0x03));
+        if(value3 != SENTINEL_VALUE && ++bufferIndex < decodedLength)
         {
-            buffer[++bufferIndex] = static_cast<uint8_t>(((value2 << 4) & 0xF0) | ((value3 >> 2) & 0x0F));
-            if(value4 != SENTINEL_VALUE)
+            output[bufferIndex] = static_cast<uint8_t>(((value2 << 4) & 0xF0) | ((value3 >> 2) & 0x0F));
+            if(value4 != SENTINEL_VALUE && ++bufferIndex < decodedLength)
             {
-                buffer[++bufferIndex] = static_cast<uint8_t>((value3 & 0x03) << 6 | value4);
+                output[bufferIndex] = static_cast<uint8_t>((value3 & 0x03) << 6 | value4);
             }
         }
     }
 
-    return buffer;
+    return decodedLength;
 }
 
 size_t Base64::CalculateBase64DecodedLength(const Aws::String& b64input)
 {
-    const size_t len = b64input.length();
+    return CalculateBase64DecodedLength(b64input.c_str(), b64input.length());
+}
+
+size_t Base64::CalculateBase64DecodedLength(const char* b64input, size_t len)
+{
     if(len < 2)
     {
         return 0;
@@ -140,9 +435,14 @@ size_t Base64::CalculateBase64DecodedLength(const Aws::String& b64input)
 
 size_t Base64::CalculateBase64EncodedLength(const Aws::Utils::ByteBuffer& buffer)
 {
-    return 4 * ((buffer.GetLength() + 2) / 3);
+    return CalculateBase64EncodedLength(buffer.GetLength());
+}
+
+size_t Base64::CalculateBase64EncodedLength(size_t length)
+{
+    return 4 * ((length + 2) / 3);
 }
 
 } // namespace Base64
 } // namespace Utils
-} // namespace Aws
\ No newline at end of file
+} // namespace Aws
@@ -0,0 +1,403 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/crypto/CRC32.h>
+#include <aws/core/utils/CpuFeatures.h>
+#include <cstring>
+
+#if defined(AWS_CORE_SIMD_X86)
+#include <immintrin.h>
+#elif defined(AWS_CORE_SIMD_NEON) && defined(__ARM_FEATURE_CRC32)
+// The CRC32 instructions are optional in ARMv8.0, so they are only used when the compiler targets them.
+#include <arm_acle.h>
+#define AWS_CORE_ARM_CRC32 1
+#endif
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Crypto;
+
+namespace
+{
+    // Bit-reflected polynomials, as the checksums are computed least significant bit first.
+    const uint32_t CRC32_POLYNOMIAL = 0xEDB88320;
+    const uint32_t CRC32C_POLYNOMIAL = 0x82F63B78;
+
+    typedef uint32_t (*UpdateFunction)(uint32_t, const unsigned char*, size_t);
+
+    /**
+     * Multiplies two polynomials modulo the CRC polynomial, in the reflected bit order where 1 << 31 represents x^0.
+     */
+    uint32_t MultiplyModP(uint32_t a, uint32_t b, uint32_t polynomial)
+    {
+        uint32_t product = 0;
+        for (uint32_t mask = 1u << 31; mask != 0; mask >>= 1)
+        {
+            if (a & mask)
+            {
+                product ^= b;
+            }
+            b = (b & 1) ? (b >> 1) ^ polynomial : b >> 1;
+        }
+        return product;
+    }
+
+    struct CrcTables
+    {
+        explicit CrcTables(uint32_t crcPolynomial) : polynomial(crcPolynomial)
+        {
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = (crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1;
+                }
+                slices[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                for (int slice = 1; slice < 8; ++slice)
+                {
+                    slices[slice][i] = (slices[slice - 1][i] >> 8) ^ slices[0][slices[slice - 1][i] & 0xFF];
+                }
+            }
+
+            // powersOfX[n] is x^(2^n) mod P, so that shifting a checksum by any number of bits takes a handful of multiplications.
+            uint32_t power = 1u << 30;
+            for (size_t n = 0; n < sizeof(powersOfX) / sizeof(powersOfX[0]); ++n)
+            {
+                powersOfX[n] = power;
+                power = MultiplyModP(power, power, polynomial);
+            }
+        }
+
+        uint32_t polynomial;
+        // Slicing-by-8 lookup tables.
+        uint32_t slices[8][256];
+        // Enough to shift by 8 * UINT64_MAX bits.
+        uint32_t powersOfX[67];
+    };
+
+    const CrcTables& GetCrc32Tables()
+    {
+        static const CrcTables tables(CRC32_POLYNOMIAL);
+        return tables;
+    }
+
+    const CrcTables& GetCrc32cTables()
+    {
+        static const CrcTables tables(CRC32C_POLYNOMIAL);
+        return tables;
+    }
+
+    inline uint32_t LoadLittleEndian32(const unsigned char* buffer)
+    {
+        return uint32_t(buffer[0]) | (uint32_t(buffer[1]) << 8) | (uint32_t(buffer[2]) << 16) | (uint32_t(buffer[3]) << 24);
+    }
+
+    uint32_t UpdateWithTables(const CrcTables& tables, uint32_t crc, const unsigned char* buffer, size_t length)
+    {
+        for (; length >= 8; buffer += 8, length -= 8)
+        {
+            const uint32_t low = LoadLittleEndian32(buffer) ^ crc;
+            const uint32_t high = LoadLittleEndian32(buffer + 4);
+            crc = tables.slices[7][low & 0xFF] ^ tables.slices[6][(low >> 8) & 0xFF] ^
+                tables.slices[5][(low >> 16) & 0xFF] ^ tables.slices[4][low >> 24] ^
+                tables.slices[3][high & 0xFF] ^ tables.slices[2][(high >> 8) & 0xFF] ^
+                tables.slices[1][(high >> 16) & 0xFF] ^ tables.slices[0][high >> 24];
+        }
+        for (; length > 0; ++buffer, --length)
+        {
+            crc = (crc >> 8) ^ tables.slices[0][(crc ^ *buffer) & 0xFF];
+        }
+        return crc;
+    }
+
+    uint32_t CombineWithTables(const CrcTables& tables, uint32_t first, uint32_t second, uint64_t secondLength)
+    {
+        // Appending secondLength bytes multiplies the first checksum by x^(8 * secondLength); the initial and final
+        // inversions of the two checksums cancel out.
+        uint32_t shift = 1u << 31;
+        for (size_t n = 3; secondLength != 0; secondLength >>= 1, ++n)
+        {
+            if (secondLength & 1)
+            {
+                shift = MultiplyModP(tables.powersOfX[n], shift, tables.polynomial);
+            }
+        }
+        return MultiplyModP(shift, first, tables.polynomial) ^ second;
+    }
+
+#if defined(AWS_CORE_SIMD_X86)
+
+    /**
+     * Folds 16-byte blocks with carry-less multiplication, then reduces to 32 bits, as described in Intel's "Fast CRC
+     * Computation for Generic Polynomials Using PCLMULQDQ Instruction". length must be at least 64 and a multiple of 16.
+     */
+    AWS_CORE_TARGET("pclmul,sse4.1")
+    uint32_t UpdateCrc32Pclmul(uint32_t crc, const unsigned char* buffer, size_t length)
+    {
+        const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+        const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+        const __m128i k5 = _mm_set_epi64x(0, 0x0163cd6124);
+        const __m128i polynomial = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+        const __m128i low32Mask = _mm_setr_epi32(~0, 0, ~0, 0);
+
+        __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer));
+        __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 16));
+        __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 32));
+        __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 48));
+        x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+        buffer += 64;
+        length -= 64;
+
+        // Fold four blocks at a time to keep the multiplier busy.
+        for (; length >= 64; buffer += 64, length -= 64)
+        {
+            const __m128i x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+            const __m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+            const __m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+            const __m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+            x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+            x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+            x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer)));
+            x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 16)));
+            x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 32)));
+            x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 48)));
+        }
+
+        // Fold the four blocks into one, then any remaining blocks one at a time.
+        __m128i x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x2), x5);
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x3), x5);
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x4), x5);
+        for (; length >= 16; buffer += 16, length -= 16)
+        {
+            x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer))), x5);
+        }
+
+        // Fold 128 bits to 64.
+        x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+        x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+        x2 = _mm_srli_si128(x1, 4);
+        x1 = _mm_and_si128(x1, low32Mask);
+        x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5, 0x00), x2);
+
+        // Barrett reduction to 32 bits.
+        x2 = _mm_and_si128(x1, low32Mask);
+        x2 = _mm_clmulepi64_si128(x2, polynomial, 0x10);
+        x2 = _mm_and_si128(x2, low32Mask);
+        x2 = _mm_clmulepi64_si128(x2, polynomial, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+        return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+    }
+
+    AWS_CORE_TARGET("sse4.2")
+    uint32_t UpdateCrc32cSse42(uint32_t crc, const unsigned char* buffer, size_t length)
+    {
+#if defined(__x86_64__) || defined(_M_X64)
+        uint64_t crc64 = crc;
+        for (; length >= 8; buffer += 8, length -= 8)
+        {
+            uint64_t value;
+            memcpy(&value, buffer, sizeof(value));
+            crc64 = _mm_crc32_u64(crc64, value);
+        }
+        crc = static_cast<uint32_t>(crc64);
+#endif
+        for (; length >= 4; buffer += 4, length -= 4)
+        {
+            uint32_t value;
+            memcpy(&value, buffer, sizeof(value));
+            crc = _mm_crc32_u32(crc, value);
+        }
+        for (; length > 0; ++buffer, --length)
+        {
+            crc = _mm_crc32_u8(crc, *buffer);
+        }
+        return crc;
+    }
+
+#elif defined(AWS_CORE_ARM_CRC32)
+
+    uint32_t UpdateCrc32Arm(uint32_t crc, const unsigned char* buffer, size_t length)
+    {
+        for (; length >= 8; buffer += 8, length -= 8)
+        {
+            uint64_t value;
+            memcpy(&value, buffer, sizeof(value));
+            crc = __crc32d(crc, value);
+        }
+        for (; length > 0; ++buffer, --length)
+        {
+            crc = __crc32b(crc, *buffer);
+        }
+        return crc;
+    }
+
+    uint32_t UpdateCrc32cArm(uint32_t crc, const unsigned char* buffer, size_t length)
+    {
+        for (; length >= 8; buffer += 8, length -= 8)
+        {
+            uint64_t value;
+            memcpy(&value, buffer, sizeof(value));
+            crc = __crc32cd(crc, value);
+        }
+        for (; length > 0; ++buffer, --length)
+        {
+            crc = __crc32cb(crc, *buffer);
+        }
+        return crc;
+    }
+
+#endif
+
+    // Both work on the inverted checksum, as the hardware instructions do. A capped SIMD level also disables the instructions.
+    uint32_t UpdateCrc32(uint32_t crc, const unsigned char* buffer, size_t length)
+    {
+#if defined(AWS_CORE_SIMD_X86)
+        if (length >= 64 && CpuFeatures::HasPCLMULQDQ() && CpuFeatures::HasSSE42() && CpuFeatures::GetSimdLevel() != SimdLevel::Scalar)
+        {
+            const size_t foldedLength = length & ~static_cast<size_t>(15);
+            crc = UpdateCrc32Pclmul(crc, buffer, foldedLength);
+            buffer += foldedLength;
+            length -= foldedLength;
+        }
+#elif defined(AWS_CORE_ARM_CRC32)
+        if (CpuFeatures::HasARMCRC32() && CpuFeatures::GetSimdLevel() != SimdLevel::Scalar)
+        {
+            return UpdateCrc32Arm(crc, buffer, length);
+        }
+#endif
+        return UpdateWithTables(GetCrc32Tables(), crc, buffer, length);
+    }
+
+    uint32_t UpdateCrc32c(uint32_t crc, const unsigned char* buffer, size_t length)
+    {
+#if defined(AWS_CORE_SIMD_X86)
+        if (CpuFeatures::HasSSE42() && CpuFeatures::GetSimdLevel() != SimdLevel::Scalar)
+        {
+            return UpdateCrc32cSse42(crc, buffer, length);
+        }
+#elif defined(AWS_CORE_ARM_CRC32)
+        if (CpuFeatures::HasARMCRC32() && CpuFeatures::GetSimdLevel() != SimdLevel::Scalar)
+        {
+            return UpdateCrc32cArm(crc, buffer, length);
+        }
+#endif
+        return UpdateWithTables(GetCrc32cTables(), crc, buffer, length);
+    }
+
+    HashResult ToDigest(uint32_t checksum)
+    {
+        ByteBuffer digest(4);
+        digest[0] = static_cast<unsigned char>(checksum >> 24);
+        digest[1] = static_cast<unsigned char>(checksum >> 16);
+        digest[2] = static_cast<unsigned char>(checksum >> 8);
+        digest[3] = static_cast<unsigned char>(checksum);
+        return HashResult(std::move(digest));
+    }
+
+    uint32_t ChecksumStream(UpdateFunction update, Aws::IStream& stream)
+    {
+        auto currentPos = stream.tellg();
+        if (currentPos == -1)
+        {
+            currentPos = 0;
+            stream.clear();
+        }
+        stream.seekg(0, stream.beg);
+
+        uint32_t crc = ~0u;
+        unsigned char streamBuffer[Hash::INTERNAL_HASH_STREAM_BUFFER_SIZE];
+        while (stream.good())
+        {
+            stream.read(reinterpret_cast<char*>(streamBuffer), Hash::INTERNAL_HASH_STREAM_BUFFER_SIZE);
+            auto bytesRead = stream.gcount();
+            if (bytesRead > 0)
+            {
+                crc = update(crc, streamBuffer, static_cast<size_t>(bytesRead));
+            }
+        }
+
+        stream.clear();
+        stream.seekg(currentPos, stream.beg);
+        return ~crc;
+    }
+}
+
+CRC32::CRC32() : m_checksum(0)
+{
+}
+
+HashResult CRC32::Calculate(const Aws::String& str)
+{
+    return ToDigest(Checksum(reinterpret_cast<const unsigned char*>(str.c_str()), str.size()));
+}
+
+HashResult CRC32::Calculate(Aws::IStream& stream)
+{
+    return ToDigest(ChecksumStream(UpdateCrc32, stream));
+}
+
+void CRC32::Update(const unsigned char* buffer, size_t length)
+{
+    m_checksum = Checksum(buffer, length, m_checksum);
+}
+
+HashResult CRC32::GetHash() const
+{
+    return ToDigest(m_checksum);
+}
+
+uint32_t CRC32::Checksum(const unsigned char* buffer, size_t length, uint32_t checksum)
+{
+    return ~UpdateCrc32(~checksum, buffer, length);
+}
+
+uint32_t CRC32::Combine(uint32_t first, uint32_t second, uint64_t secondLength)
+{
+    return CombineWithTables(GetCrc32Tables(), first, second, secondLength);
+}
+
+CRC32C::CRC32C() : m_checksum(0)
+{
+}
+
+HashResult CRC32C::Calculate(const Aws::String& str)
+{
+    return ToDigest(Checksum(reinterpret_cast<const unsigned char*>(str.c_str()), str.size()));
+}
+
+HashResult CRC32C::Calculate(Aws::IStream& stream)
+{
+    return ToDigest(ChecksumStream(UpdateCrc32c, stream));
+}
+
+void CRC32C::Update(const unsigned char* buffer, size_t length)
+{
+    m_checksum = Checksum(buffer, length, m_checksum);
+}
+
+HashResult CRC32C::GetHash() const
+{
+    return ToDigest(m_checksum);
+}
+
+uint32_t CRC32C::Checksum(const unsigned char* buffer, size_t length, uint32_t checksum)
+{
+    return ~UpdateCrc32c(~checksum, buffer, length);
+}
+
+uint32_t CRC32C::Combine(uint32_t first, uint32_t second, uint64_t secondLength)
+{
+    return CombineWithTables(GetCrc32cTables(), first, second, secondLength);
+}
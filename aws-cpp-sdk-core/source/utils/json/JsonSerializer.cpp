@@ -424,7 +424,8 @@ bool JsonView::GetBool(const Aws::String& key) const
     assert(m_value);
     auto item = cJSON_GetObjectItemCaseSensitive(m_value, key.c_str());
     assert(item);
-    return item->valueint != 0;
+    // valueint is only set on parsed values, not on ones created by WithBool.
+    return cJSON_IsTrue(item) != 0;
 }
 
 bool JsonView::AsBool() const
@@ -0,0 +1,150 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/ratelimiter/AdaptiveRateLimiter.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+using namespace Aws::Utils::RateLimits;
+
+// Lowest send rate, in requests per second, and smallest burst while limiting.
+static const double MIN_FILL_RATE = 0.5;
+static const double MIN_CAPACITY = 1;
+// Weight of the latest half second in the measured rate.
+static const double SMOOTH = 0.8;
+// Multiplicative decrease on throttling, and the scale of the cubic recovery.
+static const double BETA = 0.7;
+static const double SCALE_CONSTANT = 0.4;
+// Buckets of hosts that never throttled are dropped beyond this many hosts.
+static const size_t MAX_TRACKED_HOSTS = 256;
+
+AdaptiveRateLimiter::TokenBucket::TokenBucket(double now) :
+    enabled(false),
+    fillRate(0),
+    maxCapacity(0),
+    currentCapacity(0),
+    lastTimestamp(now),
+    measuredTxRate(0),
+    lastTxRateBucket(std::floor(now * 2) / 2),
+    requestCount(0),
+    lastMaxRate(0),
+    lastThrottleTime(now),
+    timeWindow(0)
+{
+}
+
+AdaptiveRateLimiter::AdaptiveRateLimiter(ElapsedTimeFunctionType elapsedTimeFunction) :
+    m_elapsedTimeFunction(elapsedTimeFunction),
+    m_startTime(elapsedTimeFunction())
+{
+}
+
+double AdaptiveRateLimiter::Now() const
+{
+    return std::chrono::duration<double>(m_elapsedTimeFunction() - m_startTime).count();
+}
+
+AdaptiveRateLimiter::TokenBucket& AdaptiveRateLimiter::GetBucket(const Aws::String& host, double now)
+{
+    auto iter = m_buckets.find(host);
+    if (iter != m_buckets.end())
+    {
+        return iter->second;
+    }
+
+    if (m_buckets.size() >= MAX_TRACKED_HOSTS)
+    {
+        for (auto bucket = m_buckets.begin(); bucket != m_buckets.end();)
+        {
+            bucket = bucket->second.enabled ? std::next(bucket) : m_buckets.erase(bucket);
+        }
+    }
+    return m_buckets.emplace(host, TokenBucket(now)).first->second;
+}
+
+void AdaptiveRateLimiter::Refill(TokenBucket& bucket, double now)
+{
+    bucket.currentCapacity = (std::min)(bucket.maxCapacity, bucket.currentCapacity + (now - bucket.lastTimestamp) * bucket.fillRate);
+    bucket.lastTimestamp = now;
+}
+
+void AdaptiveRateLimiter::UpdateMeasuredRate(TokenBucket& bucket, double now)
+{
+    const double timeBucket = std::floor(now * 2) / 2;
+    bucket.requestCount += 1;
+    if (timeBucket > bucket.lastTxRateBucket)
+    {
+        const double currentRate = bucket.requestCount / (timeBucket - bucket.lastTxRateBucket);
+        bucket.measuredTxRate = currentRate * SMOOTH + bucket.measuredTxRate * (1 - SMOOTH);
+        bucket.requestCount = 0;
+        bucket.lastTxRateBucket = timeBucket;
+    }
+}
+
+void AdaptiveRateLimiter::UpdateFillRate(TokenBucket& bucket, double newRate, double now)
+{
+    Refill(bucket, now);
+    bucket.fillRate = (std::max)(newRate, MIN_FILL_RATE);
+    bucket.maxCapacity = (std::max)(newRate, MIN_CAPACITY);
+    bucket.currentCapacity = (std::min)(bucket.currentCapacity, bucket.maxCapacity);
+}
+
+AdaptiveRateLimiter::DelayType AdaptiveRateLimiter::AcquireSendToken(const Aws::String& host)
+{
+    std::lock_guard<std::mutex> locker(m_bucketsLock);
+    const double now = Now();
+    TokenBucket& bucket = GetBucket(host, now);
+    if (!bucket.enabled)
+    {
+        return DelayType(0);
+    }
+
+    Refill(bucket, now);
+    // The capacity may go negative: later callers then wait for the tokens taken ahead of them.
+    const double waitSeconds = bucket.currentCapacity >= 1 ? 0 : (1 - bucket.currentCapacity) / bucket.fillRate;
+    bucket.currentCapacity -= 1;
+    return DelayType(static_cast<DelayType::rep>(std::ceil(waitSeconds * 1000)));
+}
+
+void AdaptiveRateLimiter::UpdateSendRate(const Aws::String& host, bool throttled)
+{
+    std::lock_guard<std::mutex> locker(m_bucketsLock);
+    const double now = Now();
+    TokenBucket& bucket = GetBucket(host, now);
+    UpdateMeasuredRate(bucket, now);
+
+    double newRate = 0;
+    if (throttled)
+    {
+        const double rateToUse = bucket.enabled ? (std::min)(bucket.measuredTxRate, bucket.fillRate) : bucket.measuredTxRate;
+        bucket.lastMaxRate = rateToUse;
+        bucket.timeWindow = std::cbrt(bucket.lastMaxRate * (1 - BETA) / SCALE_CONSTANT);
+        bucket.lastThrottleTime = now;
+        bucket.enabled = true;
+        newRate = rateToUse * BETA;
+    }
+    else
+    {
+        newRate = SCALE_CONSTANT * std::pow(now - bucket.lastThrottleTime - bucket.timeWindow, 3) + bucket.lastMaxRate;
+    }
+    UpdateFillRate(bucket, (std::min)(newRate, 2 * bucket.measuredTxRate), now);
+}
+
+SendRateState AdaptiveRateLimiter::GetSendRateState(const Aws::String& host) const
+{
+    std::lock_guard<std::mutex> locker(m_bucketsLock);
+    SendRateState state;
+    auto iter = m_buckets.find(host);
+    if (iter != m_buckets.end())
+    {
+        state.limiting = iter->second.enabled;
+        state.sendRate = iter->second.enabled ? iter->second.fillRate : 0;
+        state.measuredSendRate = iter->second.measuredTxRate;
+        state.lastMaxRate = iter->second.lastMaxRate;
+    }
+    return state;
+}
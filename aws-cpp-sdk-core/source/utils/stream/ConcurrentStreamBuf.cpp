@@ -30,10 +30,20 @@ namespace Aws
                 {
                     std::unique_lock<std::mutex> lock(m_lock);
                     m_eof = true;
+                    if (m_dataAvailableHandler)
+                    {
+                        m_dataAvailableHandler();
+                    }
                 }
                 m_signal.notify_all();
             }
 
+            void ConcurrentStreamBuf::SetDataAvailableHandler(const std::function<void()>& handler)
+            {
+                std::unique_lock<std::mutex> lock(m_lock);
+                m_dataAvailableHandler = handler;
+            }
+
             void ConcurrentStreamBuf::FlushPutArea()
             {
                 const size_t bitslen = pptr() - pbase();
@@ -48,6 +58,10 @@ namespace Aws
                             return;
                         }
                         std::copy(pbase(), pptr(), std::back_inserter(m_backbuf));
+                        if (m_dataAvailableHandler)
+                        {
+                            m_dataAvailableHandler();
+                        }
                     }
                     m_signal.notify_one();
                     char* pbegin = reinterpret_cast<char*>(&m_putArea[0]);
@@ -90,6 +104,11 @@ namespace Aws
             {
                 std::unique_lock<std::mutex> lock(m_lock);
                 AWS_LOGSTREAM_TRACE(TAG, "stream how many character? " << m_backbuf.size());
+                // -1 tells readers that nothing more will come, rather than nothing yet.
+                if (m_eof && m_backbuf.empty())
+                {
+                    return -1;
+                }
                 return m_backbuf.size();
             }
 
@@ -0,0 +1,200 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/stream/PooledStreamBuf.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+using namespace Aws::Utils::Stream;
+
+static const char POOLED_STREAMBUF_TAG[] = "PooledStreamBuf";
+
+PooledStreamBuf::PooledStreamBuf() : PooledStreamBuf(GetStreamBufferPool())
+{
+}
+
+PooledStreamBuf::PooledStreamBuf(const std::shared_ptr<StreamBufferPool>& pool) :
+    m_pool(pool),
+    m_buffer(nullptr),
+    m_capacity(0),
+    m_size(0)
+{
+}
+
+PooledStreamBuf::~PooledStreamBuf()
+{
+    ReleaseBuffer();
+}
+
+void PooledStreamBuf::ReleaseBuffer()
+{
+    if (m_pool)
+    {
+        m_pool->Release(m_buffer, m_capacity);
+    }
+    else if (m_buffer)
+    {
+        Aws::Free(m_buffer);
+    }
+    m_buffer = nullptr;
+    m_capacity = 0;
+}
+
+size_t PooledStreamBuf::GetSize() const
+{
+    return (std::max)(m_size, static_cast<size_t>(pptr() - pbase()));
+}
+
+void PooledStreamBuf::SetPutPosition(size_t position)
+{
+    setp(m_buffer, m_buffer + m_capacity);
+    // pbump only takes an int.
+    while (position > static_cast<size_t>(INT_MAX))
+    {
+        pbump(INT_MAX);
+        position -= INT_MAX;
+    }
+    pbump(static_cast<int>(position));
+}
+
+bool PooledStreamBuf::Reallocate(size_t capacity)
+{
+    size_t newCapacity = capacity;
+    char* newBuffer = m_pool ? m_pool->Acquire(capacity, newCapacity) :
+        static_cast<char*>(Aws::Malloc(POOLED_STREAMBUF_TAG, capacity));
+    if (!newBuffer)
+    {
+        return false;
+    }
+
+    const size_t size = GetSize();
+    const size_t getPosition = static_cast<size_t>(gptr() - eback());
+    const size_t putPosition = static_cast<size_t>(pptr() - pbase());
+    if (size)
+    {
+        std::memcpy(newBuffer, m_buffer, size);
+    }
+    ReleaseBuffer();
+
+    m_buffer = newBuffer;
+    m_capacity = newCapacity;
+    m_size = size;
+    setg(m_buffer, m_buffer + getPosition, m_buffer + m_size);
+    SetPutPosition(putPosition);
+    return true;
+}
+
+bool PooledStreamBuf::Reserve(size_t capacity)
+{
+    return capacity <= m_capacity || Reallocate(capacity);
+}
+
+Aws::String PooledStreamBuf::str() const
+{
+    return m_buffer ? Aws::String(m_buffer, GetSize()) : Aws::String();
+}
+
+std::streampos PooledStreamBuf::seekoff(std::streamoff off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    const bool in = (which & std::ios_base::in) != 0;
+    const bool out = (which & std::ios_base::out) != 0;
+    // As with std::stringbuf, moving both positions relative to the current one is ambiguous.
+    if ((!in && !out) || (in && out && dir == std::ios_base::cur))
+    {
+        return std::streamoff(-1);
+    }
+
+    m_size = GetSize();
+    std::streamoff base = 0;
+    if (dir == std::ios_base::end)
+    {
+        base = static_cast<std::streamoff>(m_size);
+    }
+    else if (dir == std::ios_base::cur)
+    {
+        base = in ? gptr() - eback() : pptr() - pbase();
+    }
+
+    const std::streamoff position = base + off;
+    if (position < 0 || position > static_cast<std::streamoff>(m_size))
+    {
+        return std::streamoff(-1);
+    }
+
+    if (in)
+    {
+        setg(m_buffer, m_buffer + position, m_buffer + m_size);
+    }
+    if (out)
+    {
+        SetPutPosition(static_cast<size_t>(position));
+    }
+    return position;
+}
+
+std::streampos PooledStreamBuf::seekpos(std::streampos pos, std::ios_base::openmode which)
+{
+    return seekoff(std::streamoff(pos), std::ios_base::beg, which);
+}
+
+int PooledStreamBuf::overflow(int c)
+{
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        return traits_type::not_eof(c);
+    }
+
+    if (pptr() == epptr() && !Reallocate((std::max)(m_capacity * 2, static_cast<size_t>(StreamBufferPool::MIN_BUFFER_SIZE))))
+    {
+        return traits_type::eof();
+    }
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+    return c;
+}
+
+std::streamsize PooledStreamBuf::xsputn(const char* s, std::streamsize n)
+{
+    if (n <= 0)
+    {
+        return 0;
+    }
+
+    size_t count = static_cast<size_t>(n);
+    const size_t putPosition = static_cast<size_t>(pptr() - pbase());
+    if (count > static_cast<size_t>(epptr() - pptr()))
+    {
+        const size_t required = putPosition + count;
+        if (!Reallocate((std::max)(required, m_capacity * 2)))
+        {
+            count = static_cast<size_t>(epptr() - pptr());
+        }
+    }
+
+    if (count)
+    {
+        std::memcpy(pptr(), s, count);
+        SetPutPosition(putPosition + count);
+    }
+    return static_cast<std::streamsize>(count);
+}
+
+int PooledStreamBuf::underflow()
+{
+    m_size = GetSize();
+    if (gptr() < m_buffer + m_size)
+    {
+        setg(m_buffer, gptr(), m_buffer + m_size);
+        return traits_type::to_int_type(*gptr());
+    }
+    return traits_type::eof();
+}
+
+std::streamsize PooledStreamBuf::showmanyc()
+{
+    return static_cast<std::streamsize>(GetSize() - static_cast<size_t>(gptr() - eback()));
+}
@@ -4,14 +4,9 @@
  */
 
 #include <aws/core/utils/stream/ResponseStream.h>
-#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/stream/PooledStreamBuf.h>
 
-#if defined(_GLIBCXX_FULLY_DYNAMIC_STRING) && _GLIBCXX_FULLY_DYNAMIC_STRING == 0 && defined(__ANDROID__)
-#include <aws/core/utils/stream/SimpleStreamBuf.h>
-using DefaultStreamBufType = Aws::Utils::Stream::SimpleStreamBuf;
-#else
-using DefaultStreamBufType = Aws::StringBuf;
-#endif
+#include <algorithm>
 
 using namespace Aws::Utils::Stream;
 
@@ -67,9 +62,19 @@ void ResponseStream::ReleaseStream()
 
 static const char *DEFAULT_STREAM_TAG = "DefaultUnderlyingStream";
 
+// Index of the stream's storage in which a DefaultUnderlyingStream records its PooledStreamBuf. Without relying on
+// RTTI, this tells ReserveBody whether the buffer of a stream is one it can reserve capacity in.
+static int GetPooledStreamBufIndex()
+{
+    static const int s_index = std::ios_base::xalloc();
+    return s_index;
+}
+
 DefaultUnderlyingStream::DefaultUnderlyingStream() :
-    Base( Aws::New< DefaultStreamBufType >( DEFAULT_STREAM_TAG ) )
-{}
+    Base( Aws::New< PooledStreamBuf >( DEFAULT_STREAM_TAG ) )
+{
+    pword(GetPooledStreamBufIndex()) = rdbuf();
+}
 
 DefaultUnderlyingStream::DefaultUnderlyingStream(Aws::UniquePtr<std::streambuf> buf) :
     Base(buf.release())
@@ -83,6 +88,21 @@ DefaultUnderlyingStream::~DefaultUnderlyingStream()
     }
 }
 
+// Most room ReserveBody makes upfront, the default size of the largest pooled response buffer: a Content-Length header
+// alone, which a server may set to anything, doesn't allocate more than that before the body arrives.
+static const size_t MAX_RESERVED_BODY_SIZE = 8 * 1024 * 1024;
+
+bool DefaultUnderlyingStream::ReserveBody(Aws::IOStream& stream, size_t size)
+{
+    // The buffer recorded may have been replaced since, or copied to another stream along with the formatting flags.
+    std::streambuf* buf = stream.rdbuf();
+    if (buf == nullptr || stream.pword(GetPooledStreamBufIndex()) != buf)
+    {
+        return false;
+    }
+    return static_cast<PooledStreamBuf*>(buf)->Reserve((std::min)(size, MAX_RESERVED_BODY_SIZE));
+}
+
 static const char* RESPONSE_STREAM_FACTORY_TAG = "ResponseStreamFactory";
 
 Aws::IOStream* Aws::Utils::Stream::DefaultResponseStreamFactoryMethod() 
@@ -0,0 +1,124 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/stream/StreamBufferPool.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+
+using namespace Aws::Utils::Stream;
+
+static const char STREAM_BUFFER_POOL_TAG[] = "StreamBufferPool";
+
+const size_t StreamBufferPool::MIN_BUFFER_SIZE;
+
+StreamBufferPool::StreamBufferPool(size_t maxPooledBytes, size_t maxBufferSize) :
+    m_maxPooledBytes(maxPooledBytes),
+    m_maxBufferSize(MIN_BUFFER_SIZE),
+    m_pooledBytes(0)
+{
+    while (m_maxBufferSize * 2 <= maxBufferSize)
+    {
+        m_maxBufferSize *= 2;
+    }
+    m_freeBuffers.resize(GetClassIndex(m_maxBufferSize) + 1);
+}
+
+StreamBufferPool::~StreamBufferPool()
+{
+    for (auto& buffers : m_freeBuffers)
+    {
+        for (char* buffer : buffers)
+        {
+            Aws::Free(buffer);
+        }
+    }
+}
+
+size_t StreamBufferPool::GetCapacityFor(size_t size) const
+{
+    if (size > m_maxBufferSize)
+    {
+        return size;
+    }
+    size_t capacity = MIN_BUFFER_SIZE;
+    while (capacity < size)
+    {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+size_t StreamBufferPool::GetClassIndex(size_t capacity) const
+{
+    size_t index = 0;
+    for (size_t classSize = MIN_BUFFER_SIZE; classSize < capacity; classSize *= 2)
+    {
+        ++index;
+    }
+    return index;
+}
+
+char* StreamBufferPool::Acquire(size_t size, size_t& capacity)
+{
+    capacity = GetCapacityFor(size);
+    if (capacity <= m_maxBufferSize)
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        auto& buffers = m_freeBuffers[GetClassIndex(capacity)];
+        if (!buffers.empty())
+        {
+            char* buffer = buffers.back();
+            buffers.pop_back();
+            m_pooledBytes -= capacity;
+            return buffer;
+        }
+    }
+    return static_cast<char*>(Aws::Malloc(STREAM_BUFFER_POOL_TAG, capacity));
+}
+
+void StreamBufferPool::Release(char* buffer, size_t capacity)
+{
+    if (!buffer)
+    {
+        return;
+    }
+    if (capacity <= m_maxBufferSize && capacity == GetCapacityFor(capacity))
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        if (m_pooledBytes + capacity <= m_maxPooledBytes)
+        {
+            m_freeBuffers[GetClassIndex(capacity)].push_back(buffer);
+            m_pooledBytes += capacity;
+            return;
+        }
+    }
+    Aws::Free(buffer);
+}
+
+size_t StreamBufferPool::GetPooledBytes() const
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    return m_pooledBytes;
+}
+
+static std::shared_ptr<StreamBufferPool>& GetStreamBufferPoolStorage()
+{
+    static std::shared_ptr<StreamBufferPool> s_streamBufferPool(nullptr);
+    return s_streamBufferPool;
+}
+
+void Aws::Utils::Stream::InitStreamBufferPool(size_t maxPooledBytes, size_t maxBufferSize)
+{
+    GetStreamBufferPoolStorage() = Aws::MakeShared<StreamBufferPool>(STREAM_BUFFER_POOL_TAG, maxPooledBytes, maxBufferSize);
+}
+
+void Aws::Utils::Stream::CleanupStreamBufferPool()
+{
+    GetStreamBufferPoolStorage() = nullptr;
+}
+
+std::shared_ptr<StreamBufferPool> Aws::Utils::Stream::GetStreamBufferPool()
+{
+    return GetStreamBufferPoolStorage();
+}
@@ -5,10 +5,14 @@
 
 #include <aws/core/utils/threading/Executor.h>
 #include <aws/core/utils/threading/ThreadTask.h>
+#include <aws/core/utils/memory/stl/AWSDeque.h>
 #include <thread>
+#include <algorithm>
+#include <condition_variable>
 #include <cassert>
 
 static const char* POOLED_CLASS_TAG = "PooledThreadExecutor";
+static const char* SHARED_POOL_CLASS_TAG = "SharedThreadPool";
 
 using namespace Aws::Utils::Threading;
 
@@ -153,3 +157,287 @@ bool PooledThreadExecutor::HasTasks()
     std::lock_guard<std::mutex> locker(m_queueLock);
     return m_tasks.size() > 0;
 }
+
+struct SharedThreadPool::State
+{
+    struct TaskQueue
+    {
+        TaskQueue() : scheduled(false) {}
+
+        Aws::Queue<std::function<void()>> tasks;
+        // Whether the queue is in scheduledQueues.
+        bool scheduled;
+    };
+
+    State(size_t maxQueued, OverflowPolicy policy) :
+        maxQueuedTasksPerExecutor(maxQueued), overflowPolicy(policy), shutdown(false)
+    {
+    }
+
+    bool Enqueue(const std::shared_ptr<TaskQueue>& queue, std::function<void()>&& fn, bool mayWait)
+    {
+        std::unique_lock<std::mutex> locker(mutex);
+        if (queue->tasks.size() >= maxQueuedTasksPerExecutor)
+        {
+            if (overflowPolicy == OverflowPolicy::REJECT_IMMEDIATELY ||
+                (overflowPolicy == OverflowPolicy::BLOCK_WHEN_QUEUE_FULL && !mayWait))
+            {
+                return false;
+            }
+            // A pool thread waiting for room in a queue only pool threads drain could wait forever, so it goes over the limit.
+            if (overflowPolicy == OverflowPolicy::BLOCK_WHEN_QUEUE_FULL && !IsPoolThread())
+            {
+                spaceAvailable.wait(locker, [&] { return shutdown || queue->tasks.size() < maxQueuedTasksPerExecutor; });
+            }
+        }
+        if (shutdown)
+        {
+            return false;
+        }
+
+        queue->tasks.push(std::move(fn));
+        if (!queue->scheduled)
+        {
+            queue->scheduled = true;
+            scheduledQueues.push_back(queue);
+        }
+        locker.unlock();
+        taskAvailable.notify_one();
+        return true;
+    }
+
+    bool IsPoolThread() const
+    {
+        return std::find(threadIds.begin(), threadIds.end(), std::this_thread::get_id()) != threadIds.end();
+    }
+
+    // Takes the state by shared_ptr so that a thread detached by Shutdown can still finish its task safely.
+    static void RunTasks(std::shared_ptr<State> state)
+    {
+        std::unique_lock<std::mutex> locker(state->mutex);
+        for (;;)
+        {
+            state->taskAvailable.wait(locker, [&] { return state->shutdown || !state->scheduledQueues.empty(); });
+            if (state->scheduledQueues.empty())
+            {
+                return;
+            }
+
+            // Take one task from the queue at the front, and send that queue to the back if it has more.
+            std::shared_ptr<TaskQueue> queue = std::move(state->scheduledQueues.front());
+            state->scheduledQueues.pop_front();
+            std::function<void()> fn = std::move(queue->tasks.front());
+            queue->tasks.pop();
+            if (queue->tasks.empty())
+            {
+                queue->scheduled = false;
+            }
+            else
+            {
+                state->scheduledQueues.push_back(std::move(queue));
+            }
+
+            locker.unlock();
+            state->spaceAvailable.notify_all();
+            fn();
+            fn = nullptr;
+            locker.lock();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable spaceAvailable;
+    Aws::Deque<std::shared_ptr<TaskQueue>> scheduledQueues;
+    Aws::Vector<std::thread::id> threadIds;
+    const size_t maxQueuedTasksPerExecutor;
+    const OverflowPolicy overflowPolicy;
+    bool shutdown;
+};
+
+class SharedThreadPool::QueueExecutor : public Executor
+{
+public:
+    QueueExecutor(const std::shared_ptr<State>& state) :
+        m_state(state), m_queue(Aws::MakeShared<State::TaskQueue>(SHARED_POOL_CLASS_TAG))
+    {
+    }
+
+protected:
+    bool SubmitToThread(std::function<void()>&& fn) override
+    {
+        if (m_state->Enqueue(m_queue, std::move(fn), true/*mayWait*/))
+        {
+            return true;
+        }
+        // Enqueue leaves fn alone when it doesn't take it.
+        RunRejectedTask(fn);
+        return false;
+    }
+
+    bool TrySubmitToThread(std::function<void()>&& fn) override
+    {
+        return m_state->Enqueue(m_queue, std::move(fn), false/*mayWait*/);
+    }
+
+private:
+    std::shared_ptr<State> m_state;
+    std::shared_ptr<State::TaskQueue> m_queue;
+};
+
+SharedThreadPool::SharedThreadPool(size_t poolSize, size_t maxQueuedTasksPerExecutor, OverflowPolicy overflowPolicy) :
+    m_state(Aws::MakeShared<State>(SHARED_POOL_CLASS_TAG, (std::max)(maxQueuedTasksPerExecutor, static_cast<size_t>(1)), overflowPolicy)),
+    m_poolSize((std::max)(poolSize, static_cast<size_t>(1)))
+{
+    std::lock_guard<std::mutex> locker(m_state->mutex);
+    m_threads.reserve(m_poolSize);
+    for (size_t index = 0; index < m_poolSize; ++index)
+    {
+        m_threads.emplace_back(&State::RunTasks, m_state);
+        m_state->threadIds.push_back(m_threads.back().get_id());
+    }
+}
+
+SharedThreadPool::~SharedThreadPool()
+{
+    Shutdown();
+}
+
+std::shared_ptr<Executor> SharedThreadPool::CreateExecutor()
+{
+    return Aws::MakeShared<QueueExecutor>(SHARED_POOL_CLASS_TAG, m_state);
+}
+
+void SharedThreadPool::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> locker(m_state->mutex);
+        if (m_state->shutdown)
+        {
+            return;
+        }
+        m_state->shutdown = true;
+    }
+    m_state->taskAvailable.notify_all();
+    m_state->spaceAvailable.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        // A task may be what shuts the pool down.
+        if (thread.get_id() == std::this_thread::get_id())
+        {
+            thread.detach();
+        }
+        else
+        {
+            thread.join();
+        }
+    }
+    m_threads.clear();
+}
+
+size_t SharedThreadPool::GetDefaultPoolSize()
+{
+    return (std::max)(static_cast<size_t>(std::thread::hardware_concurrency()) * 2, static_cast<size_t>(4));
+}
+
+// Rejected tasks being run, innermost last for each thread, and whether each has made its SDK call yet. The list only
+// exists while it isn't empty, so that nothing allocated outlives the memory system; the count spares other threads the lock.
+namespace
+{
+    struct RejectedTask
+    {
+        std::thread::id threadId;
+        size_t serial;
+        bool claimed;
+    };
+}
+static std::mutex s_rejectedTasksLock;
+static Aws::Vector<RejectedTask>* s_rejectedTasks = nullptr;
+static size_t s_rejectedTaskSerial = 0;
+static std::atomic<size_t> s_rejectedTasksRunning(0);
+
+static std::shared_ptr<SharedThreadPool>& GetSharedThreadPoolStorage()
+{
+    static std::shared_ptr<SharedThreadPool> s_sharedThreadPool(nullptr);
+    return s_sharedThreadPool;
+}
+
+void Aws::Utils::Threading::InitSharedThreadPool(size_t poolSize, size_t maxQueuedTasksPerExecutor, OverflowPolicy overflowPolicy)
+{
+    GetSharedThreadPoolStorage() = Aws::MakeShared<SharedThreadPool>(SHARED_POOL_CLASS_TAG, poolSize, maxQueuedTasksPerExecutor, overflowPolicy);
+}
+
+void Aws::Utils::Threading::CleanupSharedThreadPool()
+{
+    auto& pool = GetSharedThreadPoolStorage();
+    if (pool)
+    {
+        pool->Shutdown();
+        pool = nullptr;
+    }
+}
+
+std::shared_ptr<SharedThreadPool> Aws::Utils::Threading::GetSharedThreadPool()
+{
+    return GetSharedThreadPoolStorage();
+}
+
+std::shared_ptr<Executor> Aws::Utils::Threading::CreateDefaultExecutor(const char* allocationTag)
+{
+    auto pool = GetSharedThreadPool();
+    if (pool)
+    {
+        return pool->CreateExecutor();
+    }
+    return Aws::MakeShared<DefaultExecutor>(allocationTag);
+}
+
+void Aws::Utils::Threading::RunRejectedTask(const std::function<void()>& fn)
+{
+    size_t serial = 0;
+    {
+        std::lock_guard<std::mutex> locker(s_rejectedTasksLock);
+        if (!s_rejectedTasks)
+        {
+            s_rejectedTasks = Aws::New<Aws::Vector<RejectedTask>>(SHARED_POOL_CLASS_TAG);
+        }
+        serial = ++s_rejectedTaskSerial;
+        s_rejectedTasks->push_back(RejectedTask{std::this_thread::get_id(), serial, false});
+        ++s_rejectedTasksRunning;
+    }
+
+    fn();
+
+    std::lock_guard<std::mutex> locker(s_rejectedTasksLock);
+    s_rejectedTasks->erase(std::find_if(s_rejectedTasks->begin(), s_rejectedTasks->end(),
+        [serial](const RejectedTask& task) { return task.serial == serial; }));
+    --s_rejectedTasksRunning;
+    if (s_rejectedTasks->empty())
+    {
+        Aws::Delete(s_rejectedTasks);
+        s_rejectedTasks = nullptr;
+    }
+}
+
+bool Aws::Utils::Threading::ClaimTaskRejection()
+{
+    if (s_rejectedTasksRunning.load() == 0)
+    {
+        return false;
+    }
+    std::lock_guard<std::mutex> locker(s_rejectedTasksLock);
+    if (!s_rejectedTasks)
+    {
+        return false;
+    }
+    const auto threadId = std::this_thread::get_id();
+    auto innermost = std::find_if(s_rejectedTasks->rbegin(), s_rejectedTasks->rend(),
+        [threadId](const RejectedTask& task) { return task.threadId == threadId; });
+    if (innermost == s_rejectedTasks->rend() || innermost->claimed)
+    {
+        return false;
+    }
+    innermost->claimed = true;
+    return true;
+}
@@ -0,0 +1,411 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/dynamodb-bulk/BatchOperations.h>
+#include <aws/core/auth/AWSCredentials.h>
+#include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/StringUtils.h>
+#include <aws/dynamodb/DynamoDBClient.h>
+#include <aws/dynamodb/model/BatchWriteItemRequest.h>
+#include <aws/dynamodb/model/BatchGetItemRequest.h>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+using namespace Aws::DynamoDBBulk;
+using namespace Aws::DynamoDB;
+using namespace Aws::DynamoDB::Model;
+using namespace Aws::Client;
+
+static const char ALLOCATION_TAG[] = "BatchOperationsTest";
+static const char TABLE[] = "test-table";
+static const char OTHER_TABLE[] = "other-test-table";
+
+namespace
+{
+    typedef Aws::Map<Aws::String, AttributeValue> Item;
+
+    /**
+     * Local stand-in for DynamoDB: records every call and answers through optional handlers, after an optional simulated
+     * round trip. By default every entry is processed and one capacity unit is consumed per entry.
+     */
+    class MockDynamoDBClient : public DynamoDBClient
+    {
+    public:
+        typedef std::function<BatchWriteItemOutcome(const BatchWriteItemRequest&, size_t)> WriteHandler;
+        typedef std::function<BatchGetItemOutcome(const BatchGetItemRequest&, size_t)> GetHandler;
+
+        MockDynamoDBClient() : DynamoDBClient(Aws::Auth::AWSCredentials("", ""), ClientConfiguration()),
+            m_latencyMs(0), m_inFlight(0), m_maxInFlight(0), m_calls(0)
+        {
+        }
+
+        BatchWriteItemOutcome BatchWriteItem(const BatchWriteItemRequest& request) const override
+        {
+            size_t callIndex = BeginCall(request.GetRequestItems());
+            BatchWriteItemOutcome outcome = m_writeHandler ? m_writeHandler(request, callIndex) : SucceedWrite(request);
+            EndCall();
+            return outcome;
+        }
+
+        BatchGetItemOutcome BatchGetItem(const BatchGetItemRequest& request) const override
+        {
+            Aws::Map<Aws::String, Aws::Vector<Item>> keys;
+            for (const auto& table : request.GetRequestItems())
+            {
+                keys[table.first] = table.second.GetKeys();
+            }
+            size_t callIndex = BeginCall(keys);
+            {
+                std::lock_guard<std::mutex> locker(m_mutex);
+                m_getRequests.push_back(request.GetRequestItems());
+            }
+            BatchGetItemOutcome outcome = m_getHandler ? m_getHandler(request, callIndex) : SucceedGet(request);
+            EndCall();
+            return outcome;
+        }
+
+        static ConsumedCapacity Capacity(const Aws::String& table, double units)
+        {
+            return ConsumedCapacity().WithTableName(table).WithCapacityUnits(units);
+        }
+
+        static BatchWriteItemOutcome SucceedWrite(const BatchWriteItemRequest& request)
+        {
+            BatchWriteItemResult result;
+            for (const auto& table : request.GetRequestItems())
+            {
+                result.AddConsumedCapacity(Capacity(table.first, static_cast<double>(table.second.size())));
+            }
+            return result;
+        }
+
+        // Every key found, with the item being the key itself.
+        static BatchGetItemOutcome SucceedGet(const BatchGetItemRequest& request)
+        {
+            BatchGetItemResult result;
+            Aws::Map<Aws::String, Aws::Vector<Item>> responses;
+            for (const auto& table : request.GetRequestItems())
+            {
+                responses[table.first] = table.second.GetKeys();
+                result.AddConsumedCapacity(Capacity(table.first, static_cast<double>(table.second.GetKeys().size())));
+            }
+            result.SetResponses(std::move(responses));
+            return result;
+        }
+
+        void SetWriteHandler(const WriteHandler& handler) { m_writeHandler = handler; }
+        void SetGetHandler(const GetHandler& handler) { m_getHandler = handler; }
+        void SetLatencyMs(long latencyMs) { m_latencyMs = latencyMs; }
+
+        Aws::Vector<size_t> GetEntriesPerCall() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_entriesPerCall;
+        }
+
+        Aws::Vector<Aws::Map<Aws::String, KeysAndAttributes>> GetGetRequests() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_getRequests;
+        }
+
+        size_t GetMaxInFlight() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_maxInFlight;
+        }
+
+    private:
+        template<typename Entries>
+        size_t BeginCall(const Aws::Map<Aws::String, Entries>& entries) const
+        {
+            size_t count = 0;
+            for (const auto& table : entries)
+            {
+                count += table.second.size();
+            }
+            size_t callIndex = 0;
+            {
+                std::lock_guard<std::mutex> locker(m_mutex);
+                callIndex = m_calls++;
+                m_entriesPerCall.push_back(count);
+                m_maxInFlight = (std::max)(m_maxInFlight, ++m_inFlight);
+            }
+            if (m_latencyMs > 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(m_latencyMs));
+            }
+            return callIndex;
+        }
+
+        void EndCall() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            --m_inFlight;
+        }
+
+        WriteHandler m_writeHandler;
+        GetHandler m_getHandler;
+        long m_latencyMs;
+        mutable std::mutex m_mutex;
+        mutable Aws::Vector<size_t> m_entriesPerCall;
+        mutable Aws::Vector<Aws::Map<Aws::String, KeysAndAttributes>> m_getRequests;
+        mutable size_t m_inFlight;
+        mutable size_t m_maxInFlight;
+        mutable size_t m_calls;
+    };
+
+    Item MakeKey(size_t id)
+    {
+        Item key;
+        key["id"] = AttributeValue(Aws::Utils::StringUtils::to_string(id));
+        return key;
+    }
+
+    Aws::Vector<WriteRequest> MakePuts(size_t count)
+    {
+        Aws::Vector<WriteRequest> puts;
+        for (size_t i = 0; i < count; ++i)
+        {
+            puts.push_back(WriteRequest().WithPutRequest(PutRequest().WithItem(MakeKey(i))));
+        }
+        return puts;
+    }
+
+    Aws::Vector<Item> MakeKeys(size_t count)
+    {
+        Aws::Vector<Item> keys;
+        for (size_t i = 0; i < count; ++i)
+        {
+            keys.push_back(MakeKey(i));
+        }
+        return keys;
+    }
+
+    double TotalCapacity(const Aws::Vector<ConsumedCapacity>& consumedCapacity, const Aws::String& table)
+    {
+        for (const auto& capacity : consumedCapacity)
+        {
+            if (capacity.GetTableName() == table)
+            {
+                return capacity.GetCapacityUnits();
+            }
+        }
+        return 0;
+    }
+
+    class BatchOperationsTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_client = Aws::MakeShared<MockDynamoDBClient>(ALLOCATION_TAG);
+            m_config.client = m_client;
+            m_config.retryBaseDelayMs = 1;
+            m_config.retryMaxDelayMs = 4;
+        }
+
+        std::shared_ptr<MockDynamoDBClient> m_client;
+        BatchOperationsConfiguration m_config;
+    };
+}
+
+TEST_F(BatchOperationsTest, TestWritesAreSplitIntoServiceSizedBatches)
+{
+    BatchOperations operations(m_config);
+    Aws::Map<Aws::String, Aws::Vector<WriteRequest>> items;
+    items[TABLE] = MakePuts(60);
+    items[OTHER_TABLE] = MakePuts(7);
+
+    auto result = operations.BatchWriteAll(items);
+
+    ASSERT_TRUE(result.IsComplete());
+    ASSERT_TRUE(result.errors.empty());
+    auto entriesPerCall = m_client->GetEntriesPerCall();
+    ASSERT_EQ(3u, entriesPerCall.size());
+    ASSERT_EQ(3u, result.requestsSent);
+    size_t total = 0;
+    for (size_t entries : entriesPerCall)
+    {
+        ASSERT_LE(entries, 25u);
+        total += entries;
+    }
+    ASSERT_EQ(67u, total);
+    ASSERT_DOUBLE_EQ(60, TotalCapacity(result.consumedCapacity, TABLE));
+    ASSERT_DOUBLE_EQ(7, TotalCapacity(result.consumedCapacity, OTHER_TABLE));
+}
+
+TEST_F(BatchOperationsTest, TestInFlightRequestsAreBounded)
+{
+    m_client->SetLatencyMs(20);
+    m_config.maxInFlightRequests = 3;
+    BatchOperations operations(m_config);
+    Aws::Map<Aws::String, Aws::Vector<WriteRequest>> items;
+    items[TABLE] = MakePuts(250);
+
+    auto result = operations.BatchWriteAll(items);
+
+    ASSERT_TRUE(result.IsComplete());
+    ASSERT_EQ(10u, m_client->GetEntriesPerCall().size());
+    ASSERT_LE(m_client->GetMaxInFlight(), 3u);
+    ASSERT_GT(m_client->GetMaxInFlight(), 1u);
+}
+
+TEST_F(BatchOperationsTest, TestUnprocessedItemsAreRetriedTogether)
+{
+    // Every first attempt leaves its last five writes unprocessed.
+    m_client->SetWriteHandler([](const BatchWriteItemRequest& request, size_t callIndex) -> BatchWriteItemOutcome
+    {
+        if (callIndex >= 4)
+        {
+            return MockDynamoDBClient::SucceedWrite(request);
+        }
+        const auto& writes = request.GetRequestItems().at(TABLE);
+        BatchWriteItemResult result;
+        result.AddUnprocessedItems(TABLE, Aws::Vector<WriteRequest>(writes.end() - 5, writes.end()));
+        result.AddConsumedCapacity(MockDynamoDBClient::Capacity(TABLE, static_cast<double>(writes.size() - 5)));
+        return result;
+    });
+    m_config.maxInFlightRequests = 4;
+    BatchOperations operations(m_config);
+    Aws::Map<Aws::String, Aws::Vector<WriteRequest>> items;
+    items[TABLE] = MakePuts(100);
+
+    auto result = operations.BatchWriteAll(items);
+
+    ASSERT_TRUE(result.IsComplete());
+    ASSERT_DOUBLE_EQ(100, TotalCapacity(result.consumedCapacity, TABLE));
+    auto entriesPerCall = m_client->GetEntriesPerCall();
+    size_t retried = 0;
+    for (size_t i = 4; i < entriesPerCall.size(); ++i)
+    {
+        retried += entriesPerCall[i];
+    }
+    ASSERT_EQ(20u, retried);
+    // Retries that are ready at the same time share a request.
+    ASSERT_LT(entriesPerCall.size(), 8u);
+}
+
+TEST_F(BatchOperationsTest, TestItemsAreGivenUpAfterMaxAttempts)
+{
+    m_client->SetWriteHandler([](const BatchWriteItemRequest& request, size_t) -> BatchWriteItemOutcome
+    {
+        BatchWriteItemResult result;
+        result.SetUnprocessedItems(request.GetRequestItems());
+        return result;
+    });
+    m_config.maxAttempts = 3;
+    BatchOperations operations(m_config);
+    Aws::Map<Aws::String, Aws::Vector<WriteRequest>> items;
+    items[TABLE] = MakePuts(10);
+
+    auto result = operations.BatchWriteAll(items);
+
+    ASSERT_FALSE(result.IsComplete());
+    ASSERT_EQ(10u, result.unprocessedItems[TABLE].size());
+    ASSERT_EQ(3u, result.requestsSent);
+    ASSERT_TRUE(result.errors.empty());
+}
+
+TEST_F(BatchOperationsTest, TestThrottledRequestsAreRetried)
+{
+    m_client->SetWriteHandler([](const BatchWriteItemRequest& request, size_t callIndex) -> BatchWriteItemOutcome
+    {
+        if (callIndex < 2)
+        {
+            return DynamoDBError(Aws::Client::AWSError<Aws::Client::CoreErrors>(Aws::Client::CoreErrors::THROTTLING, "ThrottlingException", "Rate exceeded", true));
+        }
+        return MockDynamoDBClient::SucceedWrite(request);
+    });
+    m_config.maxInFlightRequests = 1;
+    BatchOperations operations(m_config);
+    Aws::Map<Aws::String, Aws::Vector<WriteRequest>> items;
+    items[TABLE] = MakePuts(20);
+
+    auto result = operations.BatchWriteAll(items);
+
+    ASSERT_TRUE(result.IsComplete());
+    ASSERT_TRUE(result.errors.empty());
+    ASSERT_EQ(3u, result.requestsSent);
+}
+
+TEST_F(BatchOperationsTest, TestNonRetryableErrorsAreReported)
+{
+    m_client->SetWriteHandler([](const BatchWriteItemRequest& request, size_t) -> BatchWriteItemOutcome
+    {
+        if (request.GetRequestItems().count(OTHER_TABLE))
+        {
+            return DynamoDBError(Aws::Client::AWSError<Aws::Client::CoreErrors>(Aws::Client::CoreErrors::VALIDATION, "ValidationException", "Bad item", false));
+        }
+        return MockDynamoDBClient::SucceedWrite(request);
+    });
+    BatchOperations operations(m_config);
+    Aws::Map<Aws::String, Aws::Vector<WriteRequest>> items;
+    items[TABLE] = MakePuts(25);
+    items[OTHER_TABLE] = MakePuts(5);
+
+    auto result = operations.BatchWriteAll(items);
+
+    ASSERT_FALSE(result.IsComplete());
+    ASSERT_EQ(1u, result.errors.size());
+    ASSERT_EQ("Bad item", result.errors[0].GetMessage());
+    // Tables are packed together in order, so the failed request also carried the first 20 writes to TABLE.
+    ASSERT_EQ(5u, result.unprocessedItems[OTHER_TABLE].size());
+    ASSERT_EQ(20u, result.unprocessedItems[TABLE].size());
+    ASSERT_EQ(2u, result.requestsSent);
+}
+
+TEST_F(BatchOperationsTest, TestGetsAreSplitAndKeepTheirProjection)
+{
+    BatchOperations operations(m_config);
+    Aws::Map<Aws::String, KeysAndAttributes> items;
+    items[TABLE] = KeysAndAttributes().WithKeys(MakeKeys(250)).WithProjectionExpression("id").WithConsistentRead(true);
+
+    auto result = operations.BatchGetAll(items);
+
+    ASSERT_TRUE(result.IsComplete());
+    ASSERT_EQ(250u, result.responses[TABLE].size());
+    ASSERT_DOUBLE_EQ(250, TotalCapacity(result.consumedCapacity, TABLE));
+    auto requests = m_client->GetGetRequests();
+    ASSERT_EQ(3u, requests.size());
+    for (const auto& request : requests)
+    {
+        const auto& keysAndAttributes = request.at(TABLE);
+        ASSERT_LE(keysAndAttributes.GetKeys().size(), 100u);
+        ASSERT_EQ("id", keysAndAttributes.GetProjectionExpression());
+        ASSERT_TRUE(keysAndAttributes.GetConsistentRead());
+    }
+}
+
+TEST_F(BatchOperationsTest, TestUnprocessedKeysAreRetried)
+{
+    m_client->SetGetHandler([](const BatchGetItemRequest& request, size_t callIndex) -> BatchGetItemOutcome
+    {
+        if (callIndex > 0)
+        {
+            return MockDynamoDBClient::SucceedGet(request);
+        }
+        const auto& keys = request.GetRequestItems().at(TABLE).GetKeys();
+        BatchGetItemResult result;
+        Aws::Map<Aws::String, Aws::Vector<Item>> responses;
+        responses[TABLE] = Aws::Vector<Item>(keys.begin(), keys.begin() + 30);
+        result.SetResponses(std::move(responses));
+        result.AddUnprocessedKeys(TABLE, KeysAndAttributes().WithKeys(Aws::Vector<Item>(keys.begin() + 30, keys.end())));
+        return result;
+    });
+    BatchOperations operations(m_config);
+    Aws::Map<Aws::String, KeysAndAttributes> items;
+    items[TABLE] = KeysAndAttributes().WithKeys(MakeKeys(40));
+
+    auto result = operations.BatchGetAll(items);
+
+    ASSERT_TRUE(result.IsComplete());
+    ASSERT_EQ(40u, result.responses[TABLE].size());
+    ASSERT_EQ(2u, result.requestsSent);
+    ASSERT_EQ(10u, m_client->GetEntriesPerCall()[1]);
+}
@@ -0,0 +1,265 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/dynamodb-bulk/ParallelScan.h>
+#include <aws/core/auth/AWSCredentials.h>
+#include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSSet.h>
+#include <aws/core/utils/StringUtils.h>
+#include <aws/dynamodb/DynamoDBClient.h>
+#include <chrono>
+#include <thread>
+
+using namespace Aws::DynamoDBBulk;
+using namespace Aws::DynamoDB;
+using namespace Aws::DynamoDB::Model;
+using namespace Aws::Client;
+using Aws::Utils::StringUtils;
+
+static const char ALLOCATION_TAG[] = "ParallelScanTest";
+static const char TABLE[] = "test-table";
+
+namespace
+{
+    typedef Aws::Map<Aws::String, AttributeValue> Item;
+
+    /**
+     * Local stand-in for DynamoDB. Every Scan segment, and every Query partition, holds itemsPerSegment items with ids
+     * "<segment or partition>-<n>", returned pageSize at a time.
+     */
+    class MockDynamoDBClient : public DynamoDBClient
+    {
+    public:
+        MockDynamoDBClient(size_t itemsPerSegment, size_t pageSize) : DynamoDBClient(Aws::Auth::AWSCredentials("", ""), ClientConfiguration()),
+            m_itemsPerSegment(itemsPerSegment), m_pageSize(pageSize), m_capacityPerPage(1), m_latencyMs(0), m_failingSegment(-1),
+            m_inFlight(0), m_maxInFlight(0), m_calls(0)
+        {
+        }
+
+        ScanOutcome Scan(const ScanRequest& request) const override
+        {
+            if (!request.SegmentHasBeenSet() || request.GetTotalSegments() < 1)
+            {
+                return DynamoDBError(AWSError<CoreErrors>(CoreErrors::VALIDATION, "ValidationException", "No segment", false));
+            }
+            Aws::Vector<Item> items;
+            Item lastKey;
+            if (!ServePage(StringUtils::to_string(request.GetSegment()), request.GetExclusiveStartKey(), items, lastKey))
+            {
+                return DynamoDBError(AWSError<CoreErrors>(CoreErrors::INTERNAL_FAILURE, "InternalServerError", "Segment failed", false));
+            }
+            ScanResult result;
+            result.SetItems(std::move(items));
+            result.SetLastEvaluatedKey(std::move(lastKey));
+            result.SetConsumedCapacity(ConsumedCapacity().WithTableName(TABLE).WithCapacityUnits(m_capacityPerPage));
+            return result;
+        }
+
+        QueryOutcome Query(const QueryRequest& request) const override
+        {
+            Aws::Vector<Item> items;
+            Item lastKey;
+            ServePage(request.GetExpressionAttributeValues().at(":p").GetS(), request.GetExclusiveStartKey(), items, lastKey);
+            QueryResult result;
+            result.SetItems(std::move(items));
+            result.SetLastEvaluatedKey(std::move(lastKey));
+            result.SetConsumedCapacity(ConsumedCapacity().WithTableName(TABLE).WithCapacityUnits(m_capacityPerPage));
+            return result;
+        }
+
+        void SetCapacityPerPage(double capacityPerPage) { m_capacityPerPage = capacityPerPage; }
+        void SetLatencyMs(long latencyMs) { m_latencyMs = latencyMs; }
+        void SetFailingSegment(int segment) { m_failingSegment = segment; }
+
+        size_t GetCalls() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_calls;
+        }
+
+        size_t GetMaxInFlight() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_maxInFlight;
+        }
+
+    private:
+        bool ServePage(const Aws::String& segment, const Item& startKey, Aws::Vector<Item>& items, Item& lastKey) const
+        {
+            {
+                std::lock_guard<std::mutex> locker(m_mutex);
+                ++m_calls;
+                m_maxInFlight = (std::max)(m_maxInFlight, ++m_inFlight);
+            }
+            if (m_latencyMs > 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(m_latencyMs));
+            }
+            {
+                std::lock_guard<std::mutex> locker(m_mutex);
+                --m_inFlight;
+            }
+            if (segment == StringUtils::to_string(m_failingSegment))
+            {
+                return false;
+            }
+
+            size_t start = startKey.empty() ? 0 : static_cast<size_t>(StringUtils::ConvertToInt64(startKey.at("n").GetN().c_str())) + 1;
+            size_t end = (std::min)(start + m_pageSize, m_itemsPerSegment);
+            for (size_t n = start; n < end; ++n)
+            {
+                Item item;
+                item["id"] = AttributeValue(segment + "-" + StringUtils::to_string(n));
+                items.push_back(std::move(item));
+            }
+            if (end < m_itemsPerSegment)
+            {
+                lastKey["n"] = AttributeValue().SetN(StringUtils::to_string(end - 1));
+            }
+            return true;
+        }
+
+        size_t m_itemsPerSegment;
+        size_t m_pageSize;
+        double m_capacityPerPage;
+        long m_latencyMs;
+        int m_failingSegment;
+        mutable std::mutex m_mutex;
+        mutable size_t m_inFlight;
+        mutable size_t m_maxInFlight;
+        mutable size_t m_calls;
+    };
+
+    size_t ReadAll(ParallelScan& scan, Aws::Set<Aws::String>& ids)
+    {
+        size_t items = 0;
+        ScanPage page;
+        while (scan.NextPage(page))
+        {
+            for (const auto& item : page.items)
+            {
+                ids.insert(item.at("id").GetS());
+                ++items;
+            }
+        }
+        return items;
+    }
+}
+
+TEST(ParallelScanTest, TestScanReadsEverySegmentOnce)
+{
+    auto client = Aws::MakeShared<MockDynamoDBClient>(ALLOCATION_TAG, 95, 10);
+    client->SetLatencyMs(5);
+    ParallelScanConfiguration config;
+    config.client = client;
+    config.totalSegments = 4;
+    ParallelScan scan(config, ScanRequest().WithTableName(TABLE));
+
+    Aws::Set<Aws::String> ids;
+    ASSERT_EQ(380u, ReadAll(scan, ids));
+    ASSERT_EQ(380u, ids.size());
+    ASSERT_TRUE(ids.count("3-94"));
+    ASSERT_FALSE(scan.HasError());
+    ASSERT_EQ(40u, client->GetCalls());
+    ASSERT_GT(client->GetMaxInFlight(), 1u);
+    ASSERT_LE(client->GetMaxInFlight(), 4u);
+}
+
+TEST(ParallelScanTest, TestQueriesRunAsSegments)
+{
+    auto client = Aws::MakeShared<MockDynamoDBClient>(ALLOCATION_TAG, 25, 10);
+    ParallelScanConfiguration config;
+    config.client = client;
+    Aws::Vector<QueryRequest> queries;
+    for (int partition = 0; partition < 3; ++partition)
+    {
+        queries.push_back(QueryRequest().WithTableName(TABLE).WithKeyConditionExpression("pk = :p")
+                .AddExpressionAttributeValues(":p", AttributeValue(StringUtils::to_string(partition))));
+    }
+    ParallelScan scan(config, queries);
+
+    Aws::Set<Aws::String> ids;
+    ASSERT_EQ(75u, ReadAll(scan, ids));
+    ASSERT_EQ(75u, ids.size());
+    ASSERT_TRUE(ids.count("2-24"));
+    ASSERT_EQ(9u, client->GetCalls());
+}
+
+TEST(ParallelScanTest, TestFetchingStopsWhenBufferIsFull)
+{
+    auto client = Aws::MakeShared<MockDynamoDBClient>(ALLOCATION_TAG, 1000, 10);
+    ParallelScanConfiguration config;
+    config.client = client;
+    config.totalSegments = 3;
+    config.maxBufferedPages = 2;
+    ParallelScan scan(config, ScanRequest().WithTableName(TABLE));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    // The buffer, plus one page held back by each segment.
+    ASSERT_EQ(5u, client->GetCalls());
+
+    ScanPage page;
+    ASSERT_TRUE(scan.NextPage(page));
+    ASSERT_EQ(10u, page.items.size());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ASSERT_EQ(6u, client->GetCalls());
+}
+
+TEST(ParallelScanTest, TestReadCapacityIsThrottled)
+{
+    auto client = Aws::MakeShared<MockDynamoDBClient>(ALLOCATION_TAG, 50, 10);
+    client->SetCapacityPerPage(50);
+    ParallelScanConfiguration config;
+    config.client = client;
+    config.totalSegments = 4;
+    config.readCapacityUnitsPerSecond = 500;
+
+    auto start = std::chrono::steady_clock::now();
+    ParallelScan scan(config, ScanRequest().WithTableName(TABLE));
+    Aws::Set<Aws::String> ids;
+    ASSERT_EQ(200u, ReadAll(scan, ids));
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    // 1000 units at 500 per second, less the first second's allowance and the last page of each segment, which no later
+    // request waits for.
+    ASSERT_GE(elapsed.count(), 500);
+}
+
+TEST(ParallelScanTest, TestErrorStopsTheScan)
+{
+    auto client = Aws::MakeShared<MockDynamoDBClient>(ALLOCATION_TAG, 1000, 10);
+    client->SetFailingSegment(1);
+    ParallelScanConfiguration config;
+    config.client = client;
+    config.totalSegments = 2;
+    ParallelScan scan(config, ScanRequest().WithTableName(TABLE));
+
+    Aws::Set<Aws::String> ids;
+    ReadAll(scan, ids);
+    ASSERT_TRUE(scan.HasError());
+    ASSERT_EQ("Segment failed", scan.GetError().GetMessage());
+    ASSERT_LT(ids.size(), 1000u);
+}
+
+TEST(ParallelScanTest, TestCancelWithPagesInFlight)
+{
+    auto client = Aws::MakeShared<MockDynamoDBClient>(ALLOCATION_TAG, 1000, 10);
+    client->SetLatencyMs(20);
+    ParallelScanConfiguration config;
+    config.client = client;
+    config.totalSegments = 4;
+    {
+        ParallelScan scan(config, ScanRequest().WithTableName(TABLE));
+        ScanPage page;
+        ASSERT_TRUE(scan.NextPage(page));
+        scan.Cancel();
+        ASSERT_FALSE(scan.NextPage(page));
+    }
+    size_t calls = client->GetCalls();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(calls, client->GetCalls());
+}
@@ -0,0 +1,151 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/dynamodb-bulk/DynamoDBBulk_EXPORTS.h>
+#include <aws/dynamodb/DynamoDBErrors.h>
+#include <aws/dynamodb/model/AttributeValue.h>
+#include <aws/dynamodb/model/ConsumedCapacity.h>
+#include <aws/dynamodb/model/KeysAndAttributes.h>
+#include <aws/dynamodb/model/ReturnConsumedCapacity.h>
+#include <aws/dynamodb/model/WriteRequest.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <memory>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Threading
+        {
+            class Executor;
+        }
+    }
+
+    namespace DynamoDB
+    {
+        class DynamoDBClient;
+    }
+
+    namespace DynamoDBBulk
+    {
+        /**
+         * Configuration for use with BatchOperations. The data here will be copied directly to BatchOperations.
+         */
+        struct BatchOperationsConfiguration
+        {
+            BatchOperationsConfiguration() :
+                maxInFlightRequests(8), maxAttempts(10), retryBaseDelayMs(50), retryMaxDelayMs(5000),
+                returnConsumedCapacity(Aws::DynamoDB::Model::ReturnConsumedCapacity::TOTAL)
+            {
+            }
+
+            /**
+             * Client used to call BatchWriteItem and BatchGetItem. You are responsible for setting this.
+             */
+            std::shared_ptr<Aws::DynamoDB::DynamoDBClient> client;
+            /**
+             * Executor requests are run on. It must not run tasks on the submitting thread.
+             * If not set, a PooledThreadExecutor with maxInFlightRequests threads is created.
+             */
+            std::shared_ptr<Aws::Utils::Threading::Executor> executor;
+            /**
+             * Number of requests a single BatchWriteAll or BatchGetAll call keeps outstanding at any time.
+             */
+            size_t maxInFlightRequests;
+            /**
+             * Number of times an item or key is sent before it is given up on and reported as unprocessed.
+             */
+            unsigned maxAttempts;
+            /**
+             * Bounds of the delay before unprocessed items are sent again. The delay adapts to the table: it doubles, starting
+             * from retryBaseDelayMs, every time a response comes back with unprocessed entries or a request is throttled, and
+             * halves every time a response comes back complete.
+             */
+            long retryBaseDelayMs;
+            long retryMaxDelayMs;
+            /**
+             * Level of consumed capacity requested from the service and aggregated into the results. NONE disables it.
+             */
+            Aws::DynamoDB::Model::ReturnConsumedCapacity returnConsumedCapacity;
+        };
+
+        /**
+         * Result of BatchOperations::BatchWriteAll.
+         */
+        struct BatchWriteAllResult
+        {
+            BatchWriteAllResult() : requestsSent(0) {}
+
+            /** Whether every write request was processed. */
+            inline bool IsComplete() const { return unprocessedItems.empty(); }
+
+            /** Write requests given up on, by table, either after maxAttempts or because their request failed. */
+            Aws::Map<Aws::String, Aws::Vector<Aws::DynamoDB::Model::WriteRequest>> unprocessedItems;
+            /** Capacity consumed by all requests, summed per table. */
+            Aws::Vector<Aws::DynamoDB::Model::ConsumedCapacity> consumedCapacity;
+            /** Errors of the requests that failed and were not retried, or failed on their last attempt. */
+            Aws::Vector<Aws::DynamoDB::DynamoDBError> errors;
+            /** BatchWriteItem calls made, including retries. */
+            size_t requestsSent;
+        };
+
+        /**
+         * Result of BatchOperations::BatchGetAll.
+         */
+        struct BatchGetAllResult
+        {
+            BatchGetAllResult() : requestsSent(0) {}
+
+            /** Whether every key was processed. */
+            inline bool IsComplete() const { return unprocessedKeys.empty(); }
+
+            /** Items read, by table, in no particular order. Keys that match no item have no entry. */
+            Aws::Map<Aws::String, Aws::Vector<Aws::Map<Aws::String, Aws::DynamoDB::Model::AttributeValue>>> responses;
+            /** Keys given up on, by table, either after maxAttempts or because their request failed. */
+            Aws::Map<Aws::String, Aws::DynamoDB::Model::KeysAndAttributes> unprocessedKeys;
+            /** Capacity consumed by all requests, summed per table. */
+            Aws::Vector<Aws::DynamoDB::Model::ConsumedCapacity> consumedCapacity;
+            /** Errors of the requests that failed and were not retried, or failed on their last attempt. */
+            Aws::Vector<Aws::DynamoDB::DynamoDBError> errors;
+            /** BatchGetItem calls made, including retries. */
+            size_t requestsSent;
+        };
+
+        /**
+         * Runs BatchWriteItem and BatchGetItem over inputs of any size.
+         *
+         * The input is split into requests of at most 25 write requests or 100 keys, the service limits, and up to
+         * maxInFlightRequests of them are sent concurrently on the executor. Entries returned as unprocessed, and the entries of
+         * requests that failed with a retryable error, are sent again after an adaptive backoff, packed together into full
+         * requests where possible. Both calls block until every entry has been processed or given up on.
+         */
+        class AWS_DYNAMODB_BULK_API BatchOperations
+        {
+        public:
+            BatchOperations(const BatchOperationsConfiguration& config);
+
+            /**
+             * Writes requestItems, a map of table name to the write requests for that table.
+             */
+            BatchWriteAllResult BatchWriteAll(const Aws::Map<Aws::String, Aws::Vector<Aws::DynamoDB::Model::WriteRequest>>& requestItems) const;
+
+            /**
+             * Reads requestItems, a map of table name to the keys to read from that table. Everything but the keys of each
+             * KeysAndAttributes (projection, consistency) is applied to every request for that table.
+             */
+            BatchGetAllResult BatchGetAll(const Aws::Map<Aws::String, Aws::DynamoDB::Model::KeysAndAttributes>& requestItems) const;
+
+            inline const BatchOperationsConfiguration& GetConfiguration() const { return m_config; }
+
+        private:
+            BatchOperationsConfiguration m_config;
+            std::shared_ptr<Aws::Utils::Threading::Executor> m_executor;
+        };
+    }
+}
@@ -0,0 +1,163 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/dynamodb-bulk/DynamoDBBulk_EXPORTS.h>
+#include <aws/dynamodb/DynamoDBErrors.h>
+#include <aws/dynamodb/model/AttributeValue.h>
+#include <aws/dynamodb/model/QueryRequest.h>
+#include <aws/dynamodb/model/ScanRequest.h>
+#include <aws/core/utils/memory/stl/AWSDeque.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Threading
+        {
+            class Executor;
+        }
+
+        namespace RateLimits
+        {
+            class RateLimiterInterface;
+        }
+    }
+
+    namespace DynamoDB
+    {
+        class DynamoDBClient;
+    }
+
+    namespace DynamoDBBulk
+    {
+        /**
+         * Configuration for use with ParallelScan. The data here will be copied directly to ParallelScan.
+         */
+        struct ParallelScanConfiguration
+        {
+            ParallelScanConfiguration() : totalSegments(4), maxBufferedPages(8), readCapacityUnitsPerSecond(0)
+            {
+            }
+
+            /**
+             * Client used to call Scan or Query. You are responsible for setting this.
+             */
+            std::shared_ptr<Aws::DynamoDB::DynamoDBClient> client;
+            /**
+             * Executor pages are fetched on. If not set, a PooledThreadExecutor with one thread per segment is created.
+             */
+            std::shared_ptr<Aws::Utils::Threading::Executor> executor;
+            /**
+             * Number of segments a Scan is split into. Ignored for Query, where every request is a segment of its own.
+             */
+            int totalSegments;
+            /**
+             * Number of fetched pages held for the caller. Once that many are waiting, a segment that fetches another page
+             * holds on to it and stops until the caller catches up, so at most maxBufferedPages plus one page per segment are in
+             * memory at any time.
+             */
+            size_t maxBufferedPages;
+            /**
+             * Read capacity units per second all segments together stay under, measured from the ConsumedCapacity of each
+             * response. 0 disables throttling.
+             */
+            double readCapacityUnitsPerSecond;
+        };
+
+        /**
+         * One page of items returned by ParallelScan::NextPage.
+         */
+        struct ScanPage
+        {
+            ScanPage() : segment(0), consumedCapacityUnits(0) {}
+
+            Aws::Vector<Aws::Map<Aws::String, Aws::DynamoDB::Model::AttributeValue>> items;
+            /** Segment the page belongs to: the Scan segment, or the index of the QueryRequest. */
+            size_t segment;
+            double consumedCapacityUnits;
+        };
+
+        /**
+         * Reads a whole Scan, or a set of Query requests, with one pipeline per segment running on the executor.
+         *
+         * Each segment follows LastEvaluatedKey on its own and fetches its next page as soon as the previous one has been
+         * handed over, so the next page is usually ready by the time the caller asks for it. Pages come out of NextPage in
+         * the order they arrive, so pages of different segments interleave. Fetching starts on construction.
+         */
+        class AWS_DYNAMODB_BULK_API ParallelScan
+        {
+        public:
+            /**
+             * Scans in config.totalSegments segments. Segment and TotalSegments of request are set for each segment.
+             */
+            ParallelScan(const ParallelScanConfiguration& config, const Aws::DynamoDB::Model::ScanRequest& request);
+
+            /**
+             * Runs every query to completion, each as a segment of its own.
+             */
+            ParallelScan(const ParallelScanConfiguration& config, const Aws::Vector<Aws::DynamoDB::Model::QueryRequest>& requests);
+
+            /**
+             * Cancels, and waits for the requests in flight to finish.
+             */
+            ~ParallelScan();
+
+            ParallelScan(const ParallelScan&) = delete;
+            ParallelScan& operator=(const ParallelScan&) = delete;
+
+            /**
+             * Blocks until a page is available and moves it into page. Returns false once every segment has been read, or
+             * after an error or Cancel(); pages fetched before an error are still returned first.
+             */
+            bool NextPage(ScanPage& page);
+
+            /**
+             * Stops fetching and drops buffered pages. NextPage returns false from then on.
+             */
+            void Cancel();
+
+            /**
+             * Whether a request failed, in which case the read is incomplete.
+             */
+            bool HasError() const;
+
+            /**
+             * The first error a request failed with.
+             */
+            Aws::DynamoDB::DynamoDBError GetError() const;
+
+            inline const ParallelScanConfiguration& GetConfiguration() const { return m_config; }
+
+        private:
+            struct Segment;
+
+            void Start();
+            void Fetch(const std::shared_ptr<Segment>& segment);
+            void Submit(const std::shared_ptr<Segment>& segment);
+
+            ParallelScanConfiguration m_config;
+            std::shared_ptr<Aws::Utils::Threading::Executor> m_executor;
+            std::shared_ptr<Aws::Utils::RateLimits::RateLimiterInterface> m_readLimiter;
+            Aws::Vector<std::shared_ptr<Segment>> m_segments;
+
+            mutable std::mutex m_mutex;
+            std::condition_variable m_signal;
+            Aws::Deque<ScanPage> m_pages;
+            size_t m_activeTasks;
+            size_t m_nextParked;
+            bool m_cancelled;
+            bool m_hasError;
+            Aws::DynamoDB::DynamoDBError m_error;
+        };
+    }
+}
@@ -0,0 +1,425 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/dynamodb-bulk/BatchOperations.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSMultiMap.h>
+#include <aws/core/utils/memory/stl/AWSDeque.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <aws/dynamodb/DynamoDBClient.h>
+#include <aws/dynamodb/model/BatchWriteItemRequest.h>
+#include <aws/dynamodb/model/BatchGetItemRequest.h>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+using namespace Aws::DynamoDB;
+using namespace Aws::DynamoDB::Model;
+
+namespace Aws
+{
+    namespace DynamoDBBulk
+    {
+        static const char CLASS_TAG[] = "BatchOperations";
+
+        static const size_t MAX_WRITE_REQUESTS_PER_BATCH = 25;
+        static const size_t MAX_KEYS_PER_BATCH = 100;
+
+        typedef Aws::Map<Aws::String, AttributeValue> Key;
+
+        static void AddCapacity(Capacity& total, const Capacity& capacity)
+        {
+            total.SetCapacityUnits(total.GetCapacityUnits() + capacity.GetCapacityUnits());
+            total.SetReadCapacityUnits(total.GetReadCapacityUnits() + capacity.GetReadCapacityUnits());
+            total.SetWriteCapacityUnits(total.GetWriteCapacityUnits() + capacity.GetWriteCapacityUnits());
+        }
+
+        static void AddIndexCapacity(Aws::Map<Aws::String, Capacity>& total, const Aws::Map<Aws::String, Capacity>& capacity)
+        {
+            for (const auto& index : capacity)
+            {
+                AddCapacity(total[index.first], index.second);
+            }
+        }
+
+        static void AddConsumedCapacity(Aws::Map<Aws::String, ConsumedCapacity>& totals, const Aws::Vector<ConsumedCapacity>& consumedCapacity)
+        {
+            for (const auto& capacity : consumedCapacity)
+            {
+                ConsumedCapacity& total = totals[capacity.GetTableName()];
+                total.SetTableName(capacity.GetTableName());
+                total.SetCapacityUnits(total.GetCapacityUnits() + capacity.GetCapacityUnits());
+                total.SetReadCapacityUnits(total.GetReadCapacityUnits() + capacity.GetReadCapacityUnits());
+                total.SetWriteCapacityUnits(total.GetWriteCapacityUnits() + capacity.GetWriteCapacityUnits());
+                if (capacity.TableHasBeenSet())
+                {
+                    Capacity table = total.GetTable();
+                    AddCapacity(table, capacity.GetTable());
+                    total.SetTable(std::move(table));
+                }
+                if (capacity.LocalSecondaryIndexesHasBeenSet())
+                {
+                    Aws::Map<Aws::String, Capacity> indexes = total.GetLocalSecondaryIndexes();
+                    AddIndexCapacity(indexes, capacity.GetLocalSecondaryIndexes());
+                    total.SetLocalSecondaryIndexes(std::move(indexes));
+                }
+                if (capacity.GlobalSecondaryIndexesHasBeenSet())
+                {
+                    Aws::Map<Aws::String, Capacity> indexes = total.GetGlobalSecondaryIndexes();
+                    AddIndexCapacity(indexes, capacity.GetGlobalSecondaryIndexes());
+                    total.SetGlobalSecondaryIndexes(std::move(indexes));
+                }
+            }
+        }
+
+        namespace
+        {
+            /**
+             * Entries of one request, by table.
+             */
+            template<typename Entry>
+            struct Chunk
+            {
+                Chunk() : count(0), attempts(0) {}
+
+                Aws::Map<Aws::String, Aws::Vector<Entry>> entries;
+                size_t count;
+                unsigned attempts;
+            };
+
+            template<typename Entry>
+            struct SendResult
+            {
+                SendResult() : succeeded(false) {}
+
+                bool succeeded;
+                /** Entries the service left unprocessed, when the request succeeded. */
+                Aws::Map<Aws::String, Aws::Vector<Entry>> unprocessed;
+                Aws::Vector<ConsumedCapacity> consumedCapacity;
+                /** The error, when the request failed. */
+                DynamoDBError error;
+            };
+
+            /**
+             * Sends chunks of entries through a batch API with a bounded number of requests in flight, and sends unprocessed
+             * entries again with an adaptive backoff until they are processed or have used up their attempts.
+             */
+            template<typename Entry>
+            class ChunkRunner
+            {
+            public:
+                typedef std::chrono::steady_clock Clock;
+                typedef std::function<void(const Chunk<Entry>&, SendResult<Entry>&)> SendFunction;
+
+                ChunkRunner(const BatchOperationsConfiguration& config, Aws::Utils::Threading::Executor& executor, size_t maxChunkSize,
+                    const SendFunction& send) :
+                    m_config(config), m_executor(executor), m_maxChunkSize(maxChunkSize), m_send(send),
+                    m_inFlight(0), m_retryDelayMs(0), m_requestsSent(0)
+                {
+                }
+
+                void Run(const Aws::Map<Aws::String, Aws::Vector<Entry>>& input)
+                {
+                    Chunk<Entry> chunk;
+                    for (const auto& table : input)
+                    {
+                        for (const auto& entry : table.second)
+                        {
+                            chunk.entries[table.first].push_back(entry);
+                            if (++chunk.count == m_maxChunkSize)
+                            {
+                                m_chunks.push_back(std::move(chunk));
+                                chunk = Chunk<Entry>();
+                            }
+                        }
+                    }
+                    if (chunk.count > 0)
+                    {
+                        m_chunks.push_back(std::move(chunk));
+                    }
+
+                    std::unique_lock<std::mutex> locker(m_mutex);
+                    for (;;)
+                    {
+                        while (m_inFlight < m_config.maxInFlightRequests)
+                        {
+                            auto next = TakeChunk(Clock::now());
+                            if (!next)
+                            {
+                                break;
+                            }
+                            ++m_inFlight;
+                            ++m_requestsSent;
+                            locker.unlock();
+                            if (!m_executor.Submit([this, next]() { Send(next); }))
+                            {
+                                Send(next);
+                            }
+                            locker.lock();
+                        }
+
+                        if (m_inFlight == 0 && m_chunks.empty() && m_retries.empty())
+                        {
+                            return;
+                        }
+                        if (m_inFlight < m_config.maxInFlightRequests && !m_retries.empty())
+                        {
+                            m_signal.wait_until(locker, m_retries.begin()->first);
+                        }
+                        else
+                        {
+                            m_signal.wait(locker);
+                        }
+                    }
+                }
+
+                Aws::Map<Aws::String, Aws::Vector<Entry>>& GetUnprocessed() { return m_unprocessed; }
+                Aws::Vector<DynamoDBError>& GetErrors() { return m_errors; }
+                size_t GetRequestsSent() const { return m_requestsSent; }
+
+                Aws::Vector<ConsumedCapacity> GetConsumedCapacity() const
+                {
+                    Aws::Vector<ConsumedCapacity> consumedCapacity;
+                    for (const auto& capacity : m_capacity)
+                    {
+                        consumedCapacity.push_back(capacity.second);
+                    }
+                    return consumedCapacity;
+                }
+
+            private:
+                // Ready retries go first, packed together as far as they fit into one request; fresh chunks go next.
+                std::shared_ptr<Chunk<Entry>> TakeChunk(Clock::time_point now)
+                {
+                    if (!m_retries.empty() && m_retries.begin()->first <= now)
+                    {
+                        auto chunk = Aws::MakeShared<Chunk<Entry>>(CLASS_TAG, std::move(m_retries.begin()->second));
+                        m_retries.erase(m_retries.begin());
+                        while (!m_retries.empty() && m_retries.begin()->first <= now && chunk->count + m_retries.begin()->second.count <= m_maxChunkSize)
+                        {
+                            Chunk<Entry>& other = m_retries.begin()->second;
+                            for (auto& table : other.entries)
+                            {
+                                auto& entries = chunk->entries[table.first];
+                                std::move(table.second.begin(), table.second.end(), std::back_inserter(entries));
+                            }
+                            chunk->count += other.count;
+                            chunk->attempts = (std::max)(chunk->attempts, other.attempts);
+                            m_retries.erase(m_retries.begin());
+                        }
+                        return chunk;
+                    }
+                    if (!m_chunks.empty())
+                    {
+                        auto chunk = Aws::MakeShared<Chunk<Entry>>(CLASS_TAG, std::move(m_chunks.front()));
+                        m_chunks.pop_front();
+                        return chunk;
+                    }
+                    return nullptr;
+                }
+
+                void Send(const std::shared_ptr<Chunk<Entry>>& chunk)
+                {
+                    SendResult<Entry> result;
+                    m_send(*chunk, result);
+
+                    std::lock_guard<std::mutex> locker(m_mutex);
+                    AddConsumedCapacity(m_capacity, result.consumedCapacity);
+                    unsigned attempts = chunk->attempts + 1;
+                    if (!result.succeeded)
+                    {
+                        AWS_LOGSTREAM_WARN(CLASS_TAG, "Batch request of " << chunk->count << " entries failed on attempt " << attempts
+                                << ": " << result.error.GetMessage());
+                        if (result.error.ShouldRetry() && attempts < m_config.maxAttempts)
+                        {
+                            IncreaseRetryDelay();
+                            Retry(std::move(chunk->entries), chunk->count, attempts);
+                        }
+                        else
+                        {
+                            GiveUp(std::move(chunk->entries));
+                            m_errors.push_back(std::move(result.error));
+                        }
+                    }
+                    else if (!result.unprocessed.empty())
+                    {
+                        size_t count = 0;
+                        for (const auto& table : result.unprocessed)
+                        {
+                            count += table.second.size();
+                        }
+                        IncreaseRetryDelay();
+                        if (attempts < m_config.maxAttempts)
+                        {
+                            Retry(std::move(result.unprocessed), count, attempts);
+                        }
+                        else
+                        {
+                            AWS_LOGSTREAM_WARN(CLASS_TAG, "Giving up on " << count << " entries still unprocessed after " << attempts << " attempts.");
+                            GiveUp(std::move(result.unprocessed));
+                        }
+                    }
+                    else
+                    {
+                        m_retryDelayMs /= 2;
+                        if (m_retryDelayMs < m_config.retryBaseDelayMs)
+                        {
+                            m_retryDelayMs = 0;
+                        }
+                    }
+
+                    --m_inFlight;
+                    m_signal.notify_one();
+                }
+
+                void IncreaseRetryDelay()
+                {
+                    m_retryDelayMs = m_retryDelayMs == 0 ? m_config.retryBaseDelayMs : (std::min)(m_retryDelayMs * 2, m_config.retryMaxDelayMs);
+                }
+
+                void Retry(Aws::Map<Aws::String, Aws::Vector<Entry>>&& entries, size_t count, unsigned attempts)
+                {
+                    Chunk<Entry> chunk;
+                    chunk.entries = std::move(entries);
+                    chunk.count = count;
+                    chunk.attempts = attempts;
+                    m_retries.emplace(Clock::now() + std::chrono::milliseconds(m_retryDelayMs), std::move(chunk));
+                }
+
+                void GiveUp(Aws::Map<Aws::String, Aws::Vector<Entry>>&& entries)
+                {
+                    for (auto& table : entries)
+                    {
+                        auto& unprocessed = m_unprocessed[table.first];
+                        std::move(table.second.begin(), table.second.end(), std::back_inserter(unprocessed));
+                    }
+                }
+
+                const BatchOperationsConfiguration& m_config;
+                Aws::Utils::Threading::Executor& m_executor;
+                size_t m_maxChunkSize;
+                SendFunction m_send;
+
+                std::mutex m_mutex;
+                std::condition_variable m_signal;
+                Aws::Deque<Chunk<Entry>> m_chunks;
+                Aws::MultiMap<Clock::time_point, Chunk<Entry>> m_retries;
+                size_t m_inFlight;
+                long m_retryDelayMs;
+                size_t m_requestsSent;
+                Aws::Map<Aws::String, Aws::Vector<Entry>> m_unprocessed;
+                Aws::Map<Aws::String, ConsumedCapacity> m_capacity;
+                Aws::Vector<DynamoDBError> m_errors;
+            };
+        }
+
+        BatchOperations::BatchOperations(const BatchOperationsConfiguration& config) :
+            m_config(config), m_executor(config.executor)
+        {
+            assert(m_config.client);
+            m_config.maxInFlightRequests = (std::max)(m_config.maxInFlightRequests, static_cast<size_t>(1));
+            m_config.maxAttempts = (std::max)(m_config.maxAttempts, 1u);
+
+            if (!m_executor)
+            {
+                m_executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(CLASS_TAG, m_config.maxInFlightRequests);
+            }
+        }
+
+        BatchWriteAllResult BatchOperations::BatchWriteAll(const Aws::Map<Aws::String, Aws::Vector<WriteRequest>>& requestItems) const
+        {
+            ChunkRunner<WriteRequest> runner(m_config, *m_executor, MAX_WRITE_REQUESTS_PER_BATCH,
+                [this](const Chunk<WriteRequest>& chunk, SendResult<WriteRequest>& result)
+                {
+                    BatchWriteItemRequest request;
+                    request.SetRequestItems(chunk.entries);
+                    request.SetReturnConsumedCapacity(m_config.returnConsumedCapacity);
+
+                    auto outcome = m_config.client->BatchWriteItem(request);
+                    result.succeeded = outcome.IsSuccess();
+                    if (!result.succeeded)
+                    {
+                        result.error = outcome.GetError();
+                        return;
+                    }
+                    result.unprocessed = outcome.GetResult().GetUnprocessedItems();
+                    result.consumedCapacity = outcome.GetResult().GetConsumedCapacity();
+                });
+            runner.Run(requestItems);
+
+            BatchWriteAllResult result;
+            result.unprocessedItems = std::move(runner.GetUnprocessed());
+            result.consumedCapacity = runner.GetConsumedCapacity();
+            result.errors = std::move(runner.GetErrors());
+            result.requestsSent = runner.GetRequestsSent();
+            return result;
+        }
+
+        BatchGetAllResult BatchOperations::BatchGetAll(const Aws::Map<Aws::String, KeysAndAttributes>& requestItems) const
+        {
+            // Everything but the keys is repeated in every request for a table.
+            Aws::Map<Aws::String, KeysAndAttributes> templates;
+            Aws::Map<Aws::String, Aws::Vector<Key>> keys;
+            for (const auto& table : requestItems)
+            {
+                KeysAndAttributes keysAndAttributes = table.second;
+                keysAndAttributes.SetKeys(Aws::Vector<Key>());
+                templates.emplace(table.first, std::move(keysAndAttributes));
+                keys.emplace(table.first, table.second.GetKeys());
+            }
+
+            BatchGetAllResult result;
+            std::mutex responsesMutex;
+            ChunkRunner<Key> runner(m_config, *m_executor, MAX_KEYS_PER_BATCH,
+                [&](const Chunk<Key>& chunk, SendResult<Key>& sendResult)
+                {
+                    BatchGetItemRequest request;
+                    for (const auto& table : chunk.entries)
+                    {
+                        KeysAndAttributes keysAndAttributes = templates.at(table.first);
+                        keysAndAttributes.SetKeys(table.second);
+                        request.AddRequestItems(table.first, std::move(keysAndAttributes));
+                    }
+                    request.SetReturnConsumedCapacity(m_config.returnConsumedCapacity);
+
+                    auto outcome = m_config.client->BatchGetItem(request);
+                    sendResult.succeeded = outcome.IsSuccess();
+                    if (!sendResult.succeeded)
+                    {
+                        sendResult.error = outcome.GetError();
+                        return;
+                    }
+                    for (const auto& table : outcome.GetResult().GetUnprocessedKeys())
+                    {
+                        sendResult.unprocessed.emplace(table.first, table.second.GetKeys());
+                    }
+                    sendResult.consumedCapacity = outcome.GetResult().GetConsumedCapacity();
+
+                    std::lock_guard<std::mutex> locker(responsesMutex);
+                    for (const auto& table : outcome.GetResult().GetResponses())
+                    {
+                        auto& items = result.responses[table.first];
+                        items.insert(items.end(), table.second.begin(), table.second.end());
+                    }
+                });
+            runner.Run(keys);
+
+            for (auto& table : runner.GetUnprocessed())
+            {
+                KeysAndAttributes keysAndAttributes = templates.at(table.first);
+                keysAndAttributes.SetKeys(std::move(table.second));
+                result.unprocessedKeys.emplace(table.first, std::move(keysAndAttributes));
+            }
+            result.consumedCapacity = runner.GetConsumedCapacity();
+            result.errors = std::move(runner.GetErrors());
+            result.requestsSent = runner.GetRequestsSent();
+            return result;
+        }
+    }
+}
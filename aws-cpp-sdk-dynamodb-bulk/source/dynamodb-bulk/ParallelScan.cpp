@@ -0,0 +1,298 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/dynamodb-bulk/ParallelScan.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/ratelimiter/DefaultRateLimiter.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <aws/dynamodb/DynamoDBClient.h>
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+using namespace Aws::DynamoDB;
+using namespace Aws::DynamoDB::Model;
+using namespace Aws::Utils::RateLimits;
+
+namespace Aws
+{
+    namespace DynamoDBBulk
+    {
+        static const char CLASS_TAG[] = "ParallelScan";
+
+        // The rate limiter counts in whole units, so capacity is accounted for in thousandths of a read capacity unit.
+        static const double CAPACITY_UNITS_SCALE = 1000.0;
+
+        typedef Aws::Map<Aws::String, AttributeValue> Key;
+        typedef std::function<bool(const Key&, ScanPage&, Key&, DynamoDBError&)> PageFetcher;
+
+        static ScanOutcome SendRequest(const DynamoDBClient& client, const ScanRequest& request)
+        {
+            return client.Scan(request);
+        }
+
+        static QueryOutcome SendRequest(const DynamoDBClient& client, const QueryRequest& request)
+        {
+            return client.Query(request);
+        }
+
+        template<typename RequestType>
+        static PageFetcher MakePageFetcher(const std::shared_ptr<DynamoDBClient>& client, RequestType request)
+        {
+            if (!request.ReturnConsumedCapacityHasBeenSet())
+            {
+                request.SetReturnConsumedCapacity(ReturnConsumedCapacity::TOTAL);
+            }
+
+            return [client, request](const Key& startKey, ScanPage& page, Key& lastKey, DynamoDBError& error) mutable
+            {
+                if (!startKey.empty())
+                {
+                    request.SetExclusiveStartKey(startKey);
+                }
+
+                auto outcome = SendRequest(*client, request);
+                if (!outcome.IsSuccess())
+                {
+                    error = outcome.GetError();
+                    return false;
+                }
+
+                // The generated results only hand out const references; this one is ours, so its items are moved, not copied.
+                auto result = outcome.GetResultWithOwnership();
+                page.items = std::move(const_cast<decltype(page.items)&>(result.GetItems()));
+                page.consumedCapacityUnits = result.GetConsumedCapacity().GetCapacityUnits();
+                lastKey = std::move(const_cast<Key&>(result.GetLastEvaluatedKey()));
+                return true;
+            };
+        }
+
+        struct ParallelScan::Segment
+        {
+            Segment(size_t segmentIndex, const PageFetcher& pageFetcher) :
+                index(segmentIndex), fetch(pageFetcher), done(false), parked(false)
+            {
+            }
+
+            size_t index;
+            PageFetcher fetch;
+            Key startKey;
+            bool done;
+            /** Whether parkedPage holds a page that found the buffer full. */
+            bool parked;
+            ScanPage parkedPage;
+        };
+
+        ParallelScan::ParallelScan(const ParallelScanConfiguration& config, const ScanRequest& request) :
+            m_config(config), m_executor(config.executor), m_activeTasks(0), m_nextParked(0), m_cancelled(false), m_hasError(false)
+        {
+            assert(m_config.client);
+            m_config.totalSegments = (std::max)(m_config.totalSegments, 1);
+            for (int i = 0; i < m_config.totalSegments; ++i)
+            {
+                ScanRequest segmentRequest = request;
+                segmentRequest.SetSegment(i);
+                segmentRequest.SetTotalSegments(m_config.totalSegments);
+                m_segments.push_back(Aws::MakeShared<Segment>(CLASS_TAG, static_cast<size_t>(i), MakePageFetcher(m_config.client, std::move(segmentRequest))));
+            }
+            Start();
+        }
+
+        ParallelScan::ParallelScan(const ParallelScanConfiguration& config, const Aws::Vector<QueryRequest>& requests) :
+            m_config(config), m_executor(config.executor), m_activeTasks(0), m_nextParked(0), m_cancelled(false), m_hasError(false)
+        {
+            assert(m_config.client);
+            for (size_t i = 0; i < requests.size(); ++i)
+            {
+                m_segments.push_back(Aws::MakeShared<Segment>(CLASS_TAG, i, MakePageFetcher(m_config.client, requests[i])));
+            }
+            Start();
+        }
+
+        ParallelScan::~ParallelScan()
+        {
+            Cancel();
+            std::unique_lock<std::mutex> locker(m_mutex);
+            m_signal.wait(locker, [this]() { return m_activeTasks == 0; });
+        }
+
+        void ParallelScan::Start()
+        {
+            m_config.maxBufferedPages = (std::max)(m_config.maxBufferedPages, static_cast<size_t>(1));
+
+            if (!m_executor)
+            {
+                m_executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(CLASS_TAG, (std::max)(m_segments.size(), static_cast<size_t>(1)));
+            }
+
+            if (m_config.readCapacityUnitsPerSecond > 0)
+            {
+                m_readLimiter = Aws::MakeShared<DefaultRateLimiter<>>(CLASS_TAG,
+                        static_cast<int64_t>(m_config.readCapacityUnitsPerSecond * CAPACITY_UNITS_SCALE));
+            }
+
+            {
+                std::lock_guard<std::mutex> locker(m_mutex);
+                m_activeTasks = m_segments.size();
+            }
+            for (const auto& segment : m_segments)
+            {
+                Submit(segment);
+            }
+        }
+
+        void ParallelScan::Submit(const std::shared_ptr<Segment>& segment)
+        {
+            if (!m_executor->Submit([this, segment]() { Fetch(segment); }))
+            {
+                Fetch(segment);
+            }
+        }
+
+        void ParallelScan::Fetch(const std::shared_ptr<Segment>& segment)
+        {
+            bool stopped = false;
+            {
+                std::lock_guard<std::mutex> locker(m_mutex);
+                stopped = m_cancelled || m_hasError;
+            }
+
+            ScanPage page;
+            Key lastKey;
+            DynamoDBError error;
+            bool succeeded = false;
+            if (!stopped)
+            {
+                if (m_readLimiter)
+                {
+                    // Waits out the capacity the previous pages of all segments went over the rate by.
+                    m_readLimiter->ApplyAndPayForCost(0);
+                }
+                succeeded = segment->fetch(segment->startKey, page, lastKey, error);
+                if (succeeded && m_readLimiter)
+                {
+                    m_readLimiter->ApplyCost(static_cast<int64_t>(page.consumedCapacityUnits * CAPACITY_UNITS_SCALE));
+                }
+            }
+
+            bool fetchNext = false;
+            {
+                std::lock_guard<std::mutex> locker(m_mutex);
+                if (stopped || m_cancelled)
+                {
+                    // Nothing more to do for this segment.
+                }
+                else if (!succeeded)
+                {
+                    AWS_LOGSTREAM_ERROR(CLASS_TAG, "Segment " << segment->index << " failed: " << error.GetMessage());
+                    if (!m_hasError)
+                    {
+                        m_hasError = true;
+                        m_error = error;
+                    }
+                }
+                else
+                {
+                    page.segment = segment->index;
+                    segment->startKey = std::move(lastKey);
+                    segment->done = segment->startKey.empty();
+                    if (page.items.empty())
+                    {
+                        // A page can come back empty when a filter dropped every item on it.
+                        fetchNext = !segment->done && !m_hasError;
+                    }
+                    else if (m_pages.size() < m_config.maxBufferedPages)
+                    {
+                        m_pages.push_back(std::move(page));
+                        fetchNext = !segment->done && !m_hasError;
+                    }
+                    else
+                    {
+                        segment->parked = true;
+                        segment->parkedPage = std::move(page);
+                    }
+                }
+
+                if (!fetchNext)
+                {
+                    --m_activeTasks;
+                }
+                m_signal.notify_all();
+            }
+
+            if (fetchNext)
+            {
+                Submit(segment);
+            }
+        }
+
+        bool ParallelScan::NextPage(ScanPage& page)
+        {
+            std::shared_ptr<Segment> resumed;
+            {
+                std::unique_lock<std::mutex> locker(m_mutex);
+                m_signal.wait(locker, [this]() { return m_cancelled || !m_pages.empty() || m_activeTasks == 0; });
+                if (m_cancelled || m_pages.empty())
+                {
+                    return false;
+                }
+
+                page = std::move(m_pages.front());
+                m_pages.pop_front();
+
+                // Segments only park on a full buffer, so there is room for exactly one of them now. They take turns.
+                for (size_t i = 0; i < m_segments.size(); ++i)
+                {
+                    const auto& segment = m_segments[(m_nextParked + i) % m_segments.size()];
+                    if (segment->parked)
+                    {
+                        m_pages.push_back(std::move(segment->parkedPage));
+                        segment->parkedPage = ScanPage();
+                        segment->parked = false;
+                        m_nextParked = (segment->index + 1) % m_segments.size();
+                        if (!segment->done && !m_hasError)
+                        {
+                            ++m_activeTasks;
+                            resumed = segment;
+                        }
+                        break;
+                    }
+                }
+            }
+
+            if (resumed)
+            {
+                Submit(resumed);
+            }
+            return true;
+        }
+
+        void ParallelScan::Cancel()
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_cancelled = true;
+            m_pages.clear();
+            for (const auto& segment : m_segments)
+            {
+                segment->parked = false;
+                segment->parkedPage = ScanPage();
+            }
+            m_signal.notify_all();
+        }
+
+        bool ParallelScan::HasError() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_hasError;
+        }
+
+        DynamoDBError ParallelScan::GetError() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_error;
+        }
+    }
+}
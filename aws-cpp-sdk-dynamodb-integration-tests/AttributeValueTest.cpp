@@ -0,0 +1,278 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/dynamodb/model/AttributeValue.h>
+
+#include <functional>
+#include <utility>
+
+using namespace Aws::DynamoDB::Model;
+using namespace Aws::Utils;
+using namespace Aws::Utils::Json;
+
+static const char ALLOCATION_TAG[] = "AttributeValueTest";
+
+namespace
+{
+    // Strings longer than any small string buffer, so that a payload left behind by a type switch shows up as a leak.
+    const char LONG_STRING[] = "a string that is far too long to be stored inline in the string object";
+    const unsigned char BYTES[] = { 0x00, 0x01, 0xfe, 0xff };
+
+    /**
+     * Applies one setter per alternative, in ValueType order, to a value of any type.
+     */
+    Aws::Vector<std::function<void(AttributeValue&)>> MakeSetters()
+    {
+        Aws::Vector<std::function<void(AttributeValue&)>> setters;
+        setters.push_back([](AttributeValue& value) { value.SetS(LONG_STRING); });
+        setters.push_back([](AttributeValue& value) { value.SetN("12345678901234567890.123456789"); });
+        setters.push_back([](AttributeValue& value) { value.SetB(ByteBuffer(BYTES, sizeof(BYTES))); });
+        setters.push_back([](AttributeValue& value) { value.SetSS({ LONG_STRING, "b" }); });
+        setters.push_back([](AttributeValue& value) { value.SetNS({ "1", "2.5" }); });
+        setters.push_back([](AttributeValue& value) { value.SetBS({ ByteBuffer(BYTES, sizeof(BYTES)), ByteBuffer(BYTES, 1) }); });
+        setters.push_back([](AttributeValue& value)
+        {
+            Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>> map;
+            map.emplace("string", Aws::MakeShared<AttributeValue>(ALLOCATION_TAG, LONG_STRING));
+            map.emplace("number", Aws::MakeShared<AttributeValue>(ALLOCATION_TAG, AttributeValue().SetN(42)));
+            value.SetM(std::move(map));
+        });
+        setters.push_back([](AttributeValue& value)
+        {
+            auto nested = Aws::MakeShared<AttributeValue>(ALLOCATION_TAG);
+            nested->AddLItem(Aws::MakeShared<AttributeValue>(ALLOCATION_TAG, LONG_STRING));
+            value.SetL({ Aws::MakeShared<AttributeValue>(ALLOCATION_TAG, AttributeValue().SetBool(true)), nested });
+        });
+        setters.push_back([](AttributeValue& value) { value.SetBool(true); });
+        setters.push_back([](AttributeValue& value) { value.SetNull(true); });
+        return setters;
+    }
+
+    const ValueType TYPES[] = { ValueType::STRING, ValueType::NUMBER, ValueType::BYTEBUFFER, ValueType::STRING_SET,
+        ValueType::NUMBER_SET, ValueType::BYTEBUFFER_SET, ValueType::ATTRIBUTE_MAP, ValueType::ATTRIBUTE_LIST,
+        ValueType::BOOL, ValueType::NULLVALUE };
+
+    Aws::Vector<AttributeValue> MakeSamples()
+    {
+        Aws::Vector<AttributeValue> samples;
+        for (const auto& setter : MakeSetters())
+        {
+            AttributeValue value;
+            setter(value);
+            samples.push_back(value);
+        }
+        return samples;
+    }
+}
+
+TEST(AttributeValueTest, TestSamplesCoverEveryType)
+{
+    auto samples = MakeSamples();
+    ASSERT_EQ(sizeof(TYPES) / sizeof(TYPES[0]), samples.size());
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        ASSERT_EQ(TYPES[i], samples[i].GetType());
+        for (size_t j = 0; j < samples.size(); ++j)
+        {
+            ASSERT_EQ(i == j, samples[i] == samples[j]);
+        }
+    }
+}
+
+TEST(AttributeValueTest, TestCopyBetweenEveryType)
+{
+    auto samples = MakeSamples();
+    for (size_t from = 0; from < samples.size(); ++from)
+    {
+        for (size_t to = 0; to < samples.size(); ++to)
+        {
+            AttributeValue value(samples[from]);
+            ASSERT_EQ(samples[from], value);
+            value = samples[to];
+            ASSERT_EQ(TYPES[to], value.GetType());
+            ASSERT_EQ(samples[to], value);
+        }
+    }
+
+    // Copies are deep, so changing one doesn't change the other.
+    AttributeValue stringSet(samples[3]);
+    AttributeValue copy(stringSet);
+    copy.AddSItem("c");
+    ASSERT_EQ(2u, stringSet.GetSS().size());
+    ASSERT_EQ(3u, copy.GetSS().size());
+}
+
+TEST(AttributeValueTest, TestMoveBetweenEveryType)
+{
+    auto samples = MakeSamples();
+    for (size_t from = 0; from < samples.size(); ++from)
+    {
+        for (size_t to = 0; to < samples.size(); ++to)
+        {
+            AttributeValue source(samples[from]);
+            AttributeValue value(std::move(source));
+            ASSERT_EQ(samples[from], value);
+
+            AttributeValue other(samples[to]);
+            value = std::move(other);
+            ASSERT_EQ(TYPES[to], value.GetType());
+            ASSERT_EQ(samples[to], value);
+        }
+    }
+}
+
+TEST(AttributeValueTest, TestSelfAssignment)
+{
+    auto samples = MakeSamples();
+    for (const auto& sample : samples)
+    {
+        AttributeValue value(sample);
+        AttributeValue& alias = value;
+        value = alias;
+        ASSERT_EQ(sample, value);
+        value = std::move(alias);
+        ASSERT_EQ(sample, value);
+    }
+}
+
+TEST(AttributeValueTest, TestAssignFromOwnElement)
+{
+    auto samples = MakeSamples();
+
+    // The element is released along with the List it is assigned over.
+    AttributeValue list(samples[7]);
+    list = *list.GetL()[1];
+    ASSERT_EQ(ValueType::ATTRIBUTE_LIST, list.GetType());
+    ASSERT_EQ(1u, list.GetL().size());
+    ASSERT_EQ(LONG_STRING, list.GetL()[0]->GetS());
+
+    AttributeValue map(samples[6]);
+    map = std::move(*map.GetM().at("string"));
+    ASSERT_EQ(ValueType::STRING, map.GetType());
+    ASSERT_EQ(LONG_STRING, map.GetS());
+}
+
+TEST(AttributeValueTest, TestJsonRoundTripForEveryType)
+{
+    auto samples = MakeSamples();
+    for (const auto& sample : samples)
+    {
+        JsonValue json = sample.Jsonize();
+        AttributeValue parsed(json.View());
+        ASSERT_EQ(sample.GetType(), parsed.GetType());
+        ASSERT_EQ(sample, parsed);
+
+        JsonValue wire(sample.SerializeAttribute());
+        ASSERT_TRUE(wire.WasParseSuccessful());
+        AttributeValue received(wire.View());
+        ASSERT_EQ(sample.GetType(), received.GetType());
+        ASSERT_EQ(sample, received);
+        ASSERT_EQ(sample.SerializeAttribute(), received.SerializeAttribute());
+    }
+}
+
+TEST(AttributeValueTest, TestSetOnEveryOtherType)
+{
+    auto samples = MakeSamples();
+    auto setters = MakeSetters();
+    for (size_t from = 0; from < samples.size(); ++from)
+    {
+        for (size_t to = 0; to < setters.size(); ++to)
+        {
+            AttributeValue value(samples[from]);
+            setters[to](value);
+            ASSERT_EQ(TYPES[to], value.GetType());
+            ASSERT_EQ(samples[to], value);
+        }
+    }
+
+    // Getters of the other types read as empty once the type switched.
+    AttributeValue value(samples[3]);
+    value.SetN("7");
+    ASSERT_EQ("7", value.GetN());
+    ASSERT_TRUE(value.GetS().empty());
+    ASSERT_TRUE(value.GetSS().empty());
+}
+
+TEST(AttributeValueTest, TestAddOnMatchingOrUninitializedType)
+{
+    AttributeValue strings;
+    strings.AddSItem("a").AddSItem(LONG_STRING);
+    ASSERT_EQ(ValueType::STRING_SET, strings.GetType());
+    ASSERT_EQ(2u, strings.GetSS().size());
+
+    AttributeValue numbers;
+    numbers.SetNS({ "1" }).AddNItem("2");
+    ASSERT_EQ(ValueType::NUMBER_SET, numbers.GetType());
+    ASSERT_EQ(2u, numbers.GetNS().size());
+
+    AttributeValue buffers;
+    buffers.AddBItem(BYTES, sizeof(BYTES));
+    ASSERT_EQ(ValueType::BYTEBUFFER_SET, buffers.GetType());
+    ASSERT_EQ(ByteBuffer(BYTES, sizeof(BYTES)), buffers.GetBS()[0]);
+
+    AttributeValue map;
+    map.AddMEntry("key", Aws::MakeShared<AttributeValue>(ALLOCATION_TAG, LONG_STRING));
+    ASSERT_EQ(ValueType::ATTRIBUTE_MAP, map.GetType());
+    ASSERT_EQ(LONG_STRING, map.GetM().at("key")->GetS());
+
+    AttributeValue list;
+    list.AddLItem(Aws::MakeShared<AttributeValue>(ALLOCATION_TAG, LONG_STRING));
+    ASSERT_EQ(ValueType::ATTRIBUTE_LIST, list.GetType());
+    ASSERT_EQ(LONG_STRING, list.GetL()[0]->GetS());
+
+    // After a switch to a set type, items are added to the new set.
+    AttributeValue switched(LONG_STRING);
+    switched.SetSS({}).AddSItem("a");
+    ASSERT_EQ(1u, switched.GetSS().size());
+}
+
+#ifdef NDEBUG
+TEST(AttributeValueTest, TestAddOnDifferentTypeLeavesValueUnchanged)
+{
+    auto samples = MakeSamples();
+    AttributeValue value(samples[0]);
+    value.AddSItem("a").AddNItem("1").AddBItem(BYTES, sizeof(BYTES));
+    value.AddMEntry("key", Aws::MakeShared<AttributeValue>(ALLOCATION_TAG)).AddLItem(Aws::MakeShared<AttributeValue>(ALLOCATION_TAG));
+    ASSERT_EQ(samples[0], value);
+}
+#elif GTEST_HAS_DEATH_TEST
+TEST(AttributeValueTest, TestAddOnDifferentTypeAsserts)
+{
+    AttributeValue value(LONG_STRING);
+    ASSERT_DEATH(value.AddSItem("a"), "");
+    ASSERT_DEATH(value.AddNItem("1"), "");
+    ASSERT_DEATH(value.AddBItem(BYTES, sizeof(BYTES)), "");
+    ASSERT_DEATH(value.AddMEntry("key", Aws::MakeShared<AttributeValue>(ALLOCATION_TAG)), "");
+    ASSERT_DEATH(value.AddLItem(Aws::MakeShared<AttributeValue>(ALLOCATION_TAG)), "");
+}
+#endif
+
+TEST(AttributeValueTest, TestDestructionAfterTypeSwitches)
+{
+    auto setters = MakeSetters();
+    for (size_t first = 0; first < setters.size(); ++first)
+    {
+        AttributeValue value;
+        setters[first](value);
+        for (size_t next = 0; next < setters.size(); ++next)
+        {
+            setters[next](value);
+        }
+        setters[first](value);
+        ASSERT_EQ(TYPES[first], value.GetType());
+    }
+
+    Aws::Vector<AttributeValue> values;
+    for (size_t i = 0; i < 64; ++i)
+    {
+        values.emplace_back(LONG_STRING);
+        setters[i % setters.size()](values.back());
+    }
+    values.erase(values.begin(), values.begin() + 32);
+    ASSERT_EQ(32u, values.size());
+}
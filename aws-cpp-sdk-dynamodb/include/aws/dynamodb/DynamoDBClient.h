@@ -62,7 +62,7 @@
 #include <aws/core/NoResult.h>
 #include <aws/core/client/AsyncCallerContext.h>
 #include <aws/core/http/HttpTypes.h>
-#include <aws/core/utils/ConcurrentCache.h>
+#include <aws/core/utils/ShardedCache.h>
 #include <future>
 #include <functional>
 
@@ -3338,7 +3338,7 @@ namespace Model
         void UpdateTimeToLiveAsyncHelper(const Model::UpdateTimeToLiveRequest& request, const UpdateTimeToLiveResponseReceivedHandler& handler, const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context) const;
 
       Aws::String m_uri;
-      mutable Aws::Utils::ConcurrentCache<Aws::String, Aws::String> m_endpointsCache;
+      mutable Aws::Utils::ShardedCache<Aws::String, Aws::String> m_endpointsCache;
       bool m_enableEndpointDiscovery;
       Aws::String m_configScheme;
       std::shared_ptr<Aws::Utils::Threading::Executor> m_executor;
@@ -6,46 +6,61 @@
 #pragma once
 
 #include <aws/dynamodb/DynamoDB_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
 #include <aws/core/utils/memory/stl/AWSVector.h>
 #include <aws/core/utils/Array.h>
 #include <aws/core/utils/json/JsonSerializer.h>
 
+#include <memory>
+
 namespace Aws
 {
 namespace DynamoDB
 {
 namespace Model
 {
-class AttributeValueValue;
-
 enum class ValueType {STRING, NUMBER, BYTEBUFFER, STRING_SET, NUMBER_SET, BYTEBUFFER_SET, ATTRIBUTE_MAP, ATTRIBUTE_LIST, BOOL, NULLVALUE};
 
 /// http://docs.aws.amazon.com/amazondynamodb/latest/APIReference/API_AttributeValue.html
+/// The value is held inline, in a union tagged with its type, so scalars need no allocation beyond their own
+/// (short strings and numbers need none at all), and the getters return references into it.
+/// Copies are deep, except for the Map and List elements, which are shared.
 class AWS_DYNAMODB_API AttributeValue
 {
 public:
-    AttributeValue() {};
-    explicit AttributeValue(const Aws::String& s) { SetS(s); }
-    explicit AttributeValue(const Aws::Vector<Aws::String>& ss) { SetSS(ss); }
-    AttributeValue(Aws::Utils::Json::JsonView jsonValue) { *this = jsonValue; }
+    AttributeValue() : m_type(ValueType::NULLVALUE), m_hasValue(false) {}
+    explicit AttributeValue(const Aws::String& s) : AttributeValue() { SetS(s); }
+    explicit AttributeValue(Aws::String&& s) : AttributeValue() { SetS(std::move(s)); }
+    explicit AttributeValue(const Aws::Vector<Aws::String>& ss) : AttributeValue() { SetSS(ss); }
+    AttributeValue(Aws::Utils::Json::JsonView jsonValue) : AttributeValue() { *this = jsonValue; }
+
+    AttributeValue(const AttributeValue& other);
+    AttributeValue(AttributeValue&& other) noexcept;
+    AttributeValue& operator = (const AttributeValue& other);
+    AttributeValue& operator = (AttributeValue&& other) noexcept;
+    ~AttributeValue() { Reset(); }
 
     /// returns the String value if the value is specialized to this type, otherwise an empty String
-    const Aws::String GetS() const;
+    const Aws::String& GetS() const;
     /// if already specialized to a String, sets the value to this String
     /// if uninitialized, specializes the type to a String with specified value
     /// if already specialized to another type then the behavior is undefined
     AttributeValue& SetS(const Aws::String& s);
+    /// as above, but moves the String into the value instead of copying it
+    AttributeValue& SetS(Aws::String&& s);
     /// if uninitialized, specializes the type to a String with specified value
     /// if already specialized to another type then the behavior is undefined
     AttributeValue& SetS(const char* n) { return SetS(Aws::String(n)); }
 
     /// returns the Number value if the value is specialized to this type, otherwise an empty String
-    const Aws::String GetN() const;
+    const Aws::String& GetN() const;
     /// if already specialized to a Number, sets the value to this Number
     /// if uninitialized, specializes the type to a Number with specified value
     /// if already specialized to another type then the behavior is undefined
     AttributeValue& SetN(const Aws::String& n);
+    /// as above, but moves the Number into the value instead of copying it
+    AttributeValue& SetN(Aws::String&& n);
     /// if already specialized to a Number, sets the value to this Number
     /// if uninitialized, specializes the type to a Number with specified value
     /// if already specialized to another type then the behavior is undefined
@@ -64,18 +79,22 @@ public:
     AttributeValue& SetN(const double nItem) { return SetN(Aws::String(std::to_string(nItem).c_str())); }
 
     /// returns the ByteBuffer if the value is specialized to this type, otherwise an empty Buffer
-    const Aws::Utils::ByteBuffer GetB() const;
+    const Aws::Utils::ByteBuffer& GetB() const;
     /// if already specialized to a ByteBuffer, sets the value to this value
     /// if uninitialized, specializes the type to a ByteBuffer with the specified value
     /// if already specialized to another type then the behavior is undefined
     AttributeValue& SetB(const Aws::Utils::ByteBuffer& b);
+    /// as above, but moves the ByteBuffer into the value instead of copying it
+    AttributeValue& SetB(Aws::Utils::ByteBuffer&& b);
 
     /// returns the String Vector if the value is specialized to this type, otherwise an empty Vector
-    const Aws::Vector<Aws::String> GetSS() const;
+    const Aws::Vector<Aws::String>& GetSS() const;
     /// if already specialized to a String Set, sets to these values
     /// if uninitialized, specializes the type to a String Set with specified values
     /// if already specialized to another type then the behavior is undefined
     AttributeValue& SetSS(const Aws::Vector<Aws::String>& ss);
+    /// as above, but moves the String Set into the value instead of copying it
+    AttributeValue& SetSS(Aws::Vector<Aws::String>&& ss);
     /// if the value is already specialized to a String Set then this value is appended
     /// if uninitialized, specializes the type to a String Set with this initial value
     /// if already specialized to another type then the behavior is undefined
@@ -86,11 +105,13 @@ public:
     AttributeValue& AddSItem(const char* sItem) { return AddSItem(Aws::String(sItem)); }
 
     /// returns the Number Vector if the value is specialized to this type, otherwise an empty Vector
-    const Aws::Vector<Aws::String> GetNS() const;
+    const Aws::Vector<Aws::String>& GetNS() const;
     /// if already specialized to a Number Set, sets to these values
     /// if uninitialized, specializes the type to a Number Set with specified values
     /// if already specialized to another type then the behavior is undefined
     AttributeValue& SetNS(const Aws::Vector<Aws::String>& ns);
+    /// as above, but moves the Number Set into the value instead of copying it
+    AttributeValue& SetNS(Aws::Vector<Aws::String>&& ns);
     /// if the value is already specialized to a Number Set then this value is appended
     /// if uninitialized, specializes the type to a Number Set with this initial value
     /// if already specialized to another type then the behavior is undefined
@@ -101,11 +122,13 @@ public:
     AttributeValue& AddNItem(const char* nItem) { return AddNItem(Aws::String(nItem)); }
 
     /// returns the ByteBuffer Vector if the value is specialized to this type, otherwise an empty Vector
-    const Aws::Vector<Aws::Utils::ByteBuffer> GetBS() const;
+    const Aws::Vector<Aws::Utils::ByteBuffer>& GetBS() const;
     /// if already specialized to a ByteBuffer Set, sets to these values
     /// if uninitialized, specializes the type to a ByteBuffer Set with specified values
     /// if already specialized to another type then the behavior is undefined
     AttributeValue& SetBS(const Aws::Vector<Aws::Utils::ByteBuffer>& bs);
+    /// as above, but moves the ByteBuffer Set into the value instead of copying it
+    AttributeValue& SetBS(Aws::Vector<Aws::Utils::ByteBuffer>&& bs);
     /// if the value is already specialized to a ByteBuffer Set then this value is appended
     /// if uninitialized, specializes the type to a ByteBuffer Set with this initial value
     /// if already specialized to another type then the behavior is undefined
@@ -116,11 +139,13 @@ public:
     AttributeValue& AddBItem(const unsigned char* bItem, size_t size);
 
     /// returns the Attribute Map if the value is specialized to this type, otherwise an empty Map
-    const Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>> GetM() const;
+    const Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>>& GetM() const;
     /// if already specialized to an Attribute Map, sets to these values
     /// if uninitialized, specializes the type to an Attribute Map with specified values
     /// if already specialized to another type then the behavior is undefined
     AttributeValue& SetM(const Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>>& map);
+    /// as above, but moves the Attribute Map into the value instead of copying it
+    AttributeValue& SetM(Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>>&& map);
     /// if the value is already specialized to a Map then this value is inserted
     /// if uninitialized, specializes the type to a Map with these initial values
     /// if already specialized to another type then the behavior is undefined
@@ -131,11 +156,13 @@ public:
     AttributeValue& AddMEntry(const char* key, const std::shared_ptr<AttributeValue>& value) { return AddMEntry(Aws::String(key), value); }
 
     /// returns the Attribute List if the value is specialized to this type, otherwise an empty Vector
-    const Aws::Vector<std::shared_ptr<AttributeValue>> GetL() const;
+    const Aws::Vector<std::shared_ptr<AttributeValue>>& GetL() const;
     /// if already specialized to an Attribute List, sets to these values
     /// if uninitialized, specializes the type to an Attribute List with specified values
     /// if already specialized to another type then the behavior is undefined
     AttributeValue& SetL(const Aws::Vector<std::shared_ptr<AttributeValue>>& list);
+    /// as above, but moves the Attribute List into the value instead of copying it
+    AttributeValue& SetL(Aws::Vector<std::shared_ptr<AttributeValue>>&& list);
     /// if the value is already specialized to a List then this value is appended
     /// if uninitialized, specializes the type to a List with these initial values
     /// if already specialized to another type then the behavior is undefined
@@ -162,10 +189,34 @@ public:
 
     Aws::String SerializeAttribute() const;
     Aws::Utils::Json::JsonValue Jsonize() const;
-    ValueType GetType() const;
+    /// returns the type the value is specialized to; an uninitialized value reports NULLVALUE
+    ValueType GetType() const { return m_type; }
 
 private:
-    std::shared_ptr<AttributeValueValue> m_value;
+    union Payload
+    {
+        Payload() {}
+        ~Payload() {}
+
+        Aws::String s;                                                  // STRING, NUMBER
+        Aws::Utils::ByteBuffer b;                                       // BYTEBUFFER
+        Aws::Vector<Aws::String> ss;                                    // STRING_SET, NUMBER_SET
+        Aws::Vector<Aws::Utils::ByteBuffer> bs;                         // BYTEBUFFER_SET
+        Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>> m; // ATTRIBUTE_MAP
+        Aws::Vector<std::shared_ptr<AttributeValue>> l;                 // ATTRIBUTE_LIST
+        bool flag;                                                      // BOOL, NULLVALUE
+    };
+
+    bool Is(ValueType type) const { return m_hasValue && m_type == type; }
+    bool IsDefault() const;
+    void Reset();
+    void MoveFrom(AttributeValue&& other);
+    template<typename T>
+    AttributeValue& Emplace(ValueType type, T& member, T&& value);
+
+    Payload m_payload;
+    ValueType m_type;
+    bool m_hasValue;
 };
 
 } // namespace Model
@@ -4,163 +4,334 @@
  */
 
 #include <aws/dynamodb/model/AttributeValue.h>
-#include <aws/dynamodb/model/AttributeValueValue.h>
+#include <aws/core/utils/HashingUtils.h>
 
+#include <cassert>
+#include <new>
 #include <utility>
 
 using namespace Aws::DynamoDB::Model;
 using namespace Aws::Utils;
 using namespace Aws::Utils::Json;
 
-const Aws::String AttributeValue::GetS() const
+namespace
 {
-    if (m_value)
+    template<typename T>
+    void Destroy(T& value)
     {
-        return m_value->GetS();
+        value.~T();
     }
-    else
+
+    // Returned by the getters when the value is not specialized to the requested type.
+    const Aws::String& EmptyString()
+    {
+        static const Aws::String empty;
+        return empty;
+    }
+
+    const ByteBuffer& EmptyByteBuffer()
+    {
+        static const ByteBuffer empty;
+        return empty;
+    }
+
+    const Aws::Vector<Aws::String>& EmptyStringVector()
+    {
+        static const Aws::Vector<Aws::String> empty;
+        return empty;
+    }
+
+    const Aws::Vector<ByteBuffer>& EmptyByteBufferVector()
+    {
+        static const Aws::Vector<ByteBuffer> empty;
+        return empty;
+    }
+
+    const Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>>& EmptyMap()
+    {
+        static const Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>> empty;
+        return empty;
+    }
+
+    const Aws::Vector<std::shared_ptr<AttributeValue>>& EmptyList()
     {
-        return {};
+        static const Aws::Vector<std::shared_ptr<AttributeValue>> empty;
+        return empty;
     }
 }
 
-AttributeValue& AttributeValue::SetS(const Aws::String& s)
+template<typename T>
+AttributeValue& AttributeValue::Emplace(ValueType type, T& member, T&& value)
 {
-    m_value = Aws::MakeShared<AttributeValueString>("AttributeValue", s);
+    // value may live inside the current payload (e.g. an element of its List), so take it before releasing that payload.
+    T taken(std::move(value));
+    Reset();
+    new (&member) T(std::move(taken));
+    m_type = type;
+    m_hasValue = true;
     return *this;
 }
 
-const Aws::String AttributeValue::GetN() const
+AttributeValue::AttributeValue(const AttributeValue& other) : AttributeValue()
+{
+    *this = other;
+}
+
+AttributeValue::AttributeValue(AttributeValue&& other) noexcept : AttributeValue()
+{
+    MoveFrom(std::move(other));
+}
+
+AttributeValue& AttributeValue::operator =(const AttributeValue& other)
 {
-    if (m_value)
+    if (this == &other)
     {
-        return m_value->GetN();
+        return *this;
     }
-    else
+    if (!other.m_hasValue)
     {
-        return {};
+        Reset();
+        m_type = other.m_type;
+        return *this;
     }
-}
 
-AttributeValue& AttributeValue::SetN(const Aws::String& n)
-{
-    m_value = Aws::MakeShared<AttributeValueNumeric>("AttributeValue", n);
+    switch (other.m_type)
+    {
+    case ValueType::STRING:
+    case ValueType::NUMBER:
+        return Emplace(other.m_type, m_payload.s, Aws::String(other.m_payload.s));
+    case ValueType::BYTEBUFFER:
+        return Emplace(other.m_type, m_payload.b, ByteBuffer(other.m_payload.b));
+    case ValueType::STRING_SET:
+    case ValueType::NUMBER_SET:
+        return Emplace(other.m_type, m_payload.ss, Aws::Vector<Aws::String>(other.m_payload.ss));
+    case ValueType::BYTEBUFFER_SET:
+        return Emplace(other.m_type, m_payload.bs, Aws::Vector<ByteBuffer>(other.m_payload.bs));
+    case ValueType::ATTRIBUTE_MAP:
+        return Emplace(other.m_type, m_payload.m, Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>>(other.m_payload.m));
+    case ValueType::ATTRIBUTE_LIST:
+        return Emplace(other.m_type, m_payload.l, Aws::Vector<std::shared_ptr<AttributeValue>>(other.m_payload.l));
+    case ValueType::BOOL:
+    case ValueType::NULLVALUE:
+        return Emplace(other.m_type, m_payload.flag, bool(other.m_payload.flag));
+    }
     return *this;
 }
 
-const ByteBuffer AttributeValue::GetB() const
+AttributeValue& AttributeValue::operator =(AttributeValue&& other) noexcept
 {
-    if (m_value)
+    if (this != &other)
     {
-        return m_value->GetB();
+        MoveFrom(std::move(other));
     }
-    else
-    {
-        return {};
+    return *this;
+}
+
+// Leaves other holding its moved-from payload rather than resetting it: other may be an element of this value's
+// Map or List, in which case it no longer exists once Emplace has released the old payload.
+void AttributeValue::MoveFrom(AttributeValue&& other)
+{
+    if (!other.m_hasValue)
+    {
+        ValueType type = other.m_type;
+        Reset();
+        m_type = type;
+        return;
+    }
+
+    switch (other.m_type)
+    {
+    case ValueType::STRING:
+    case ValueType::NUMBER:
+        Emplace(other.m_type, m_payload.s, std::move(other.m_payload.s));
+        break;
+    case ValueType::BYTEBUFFER:
+        Emplace(other.m_type, m_payload.b, std::move(other.m_payload.b));
+        break;
+    case ValueType::STRING_SET:
+    case ValueType::NUMBER_SET:
+        Emplace(other.m_type, m_payload.ss, std::move(other.m_payload.ss));
+        break;
+    case ValueType::BYTEBUFFER_SET:
+        Emplace(other.m_type, m_payload.bs, std::move(other.m_payload.bs));
+        break;
+    case ValueType::ATTRIBUTE_MAP:
+        Emplace(other.m_type, m_payload.m, std::move(other.m_payload.m));
+        break;
+    case ValueType::ATTRIBUTE_LIST:
+        Emplace(other.m_type, m_payload.l, std::move(other.m_payload.l));
+        break;
+    case ValueType::BOOL:
+    case ValueType::NULLVALUE:
+        Emplace(other.m_type, m_payload.flag, bool(other.m_payload.flag));
+        break;
     }
 }
 
+void AttributeValue::Reset()
+{
+    if (!m_hasValue)
+    {
+        return;
+    }
+
+    switch (m_type)
+    {
+    case ValueType::STRING:
+    case ValueType::NUMBER:
+        Destroy(m_payload.s);
+        break;
+    case ValueType::BYTEBUFFER:
+        Destroy(m_payload.b);
+        break;
+    case ValueType::STRING_SET:
+    case ValueType::NUMBER_SET:
+        Destroy(m_payload.ss);
+        break;
+    case ValueType::BYTEBUFFER_SET:
+        Destroy(m_payload.bs);
+        break;
+    case ValueType::ATTRIBUTE_MAP:
+        Destroy(m_payload.m);
+        break;
+    case ValueType::ATTRIBUTE_LIST:
+        Destroy(m_payload.l);
+        break;
+    case ValueType::BOOL:
+    case ValueType::NULLVALUE:
+        break;
+    }
+    m_hasValue = false;
+}
+
+const Aws::String& AttributeValue::GetS() const
+{
+    return Is(ValueType::STRING) ? m_payload.s : EmptyString();
+}
+
+AttributeValue& AttributeValue::SetS(const Aws::String& s)
+{
+    return SetS(Aws::String(s));
+}
+
+AttributeValue& AttributeValue::SetS(Aws::String&& s)
+{
+    return Emplace(ValueType::STRING, m_payload.s, std::move(s));
+}
+
+const Aws::String& AttributeValue::GetN() const
+{
+    return Is(ValueType::NUMBER) ? m_payload.s : EmptyString();
+}
+
+AttributeValue& AttributeValue::SetN(const Aws::String& n)
+{
+    return SetN(Aws::String(n));
+}
+
+AttributeValue& AttributeValue::SetN(Aws::String&& n)
+{
+    return Emplace(ValueType::NUMBER, m_payload.s, std::move(n));
+}
+
+const ByteBuffer& AttributeValue::GetB() const
+{
+    return Is(ValueType::BYTEBUFFER) ? m_payload.b : EmptyByteBuffer();
+}
+
 AttributeValue& AttributeValue::SetB(const ByteBuffer& b)
 {
-    m_value = Aws::MakeShared<AttributeValueByteBuffer>("AttributeValue", b);
-    return *this;
+    return SetB(ByteBuffer(b));
 }
 
-const Aws::Vector<Aws::String> AttributeValue::GetSS() const
+AttributeValue& AttributeValue::SetB(ByteBuffer&& b)
 {
-    if (m_value)
-    {
-        return m_value->GetSS();
-    }
-    else
-    {
-        return {};
-    }
+    return Emplace(ValueType::BYTEBUFFER, m_payload.b, std::move(b));
+}
+
+const Aws::Vector<Aws::String>& AttributeValue::GetSS() const
+{
+    return Is(ValueType::STRING_SET) ? m_payload.ss : EmptyStringVector();
 }
 
 AttributeValue& AttributeValue::SetSS(const Aws::Vector<Aws::String>& ss)
 {
-    m_value = Aws::MakeShared<AttributeValueStringSet>("AttributeValue", ss);
-    return *this;
+    return SetSS(Aws::Vector<Aws::String>(ss));
+}
+
+AttributeValue& AttributeValue::SetSS(Aws::Vector<Aws::String>&& ss)
+{
+    return Emplace(ValueType::STRING_SET, m_payload.ss, std::move(ss));
 }
 
 AttributeValue& AttributeValue::AddSItem(const Aws::String& sItem)
 {
-    if (!m_value)
+    if (!m_hasValue)
     {
-        Aws::Vector<Aws::String> ss;
-        ss.push_back(sItem);
-        m_value = Aws::MakeShared<AttributeValueStringSet>("AttributeValue", ss);
+        Emplace(ValueType::STRING_SET, m_payload.ss, Aws::Vector<Aws::String>());
     }
-    else
+    assert(m_type == ValueType::STRING_SET);
+    if (m_type == ValueType::STRING_SET)
     {
-        m_value->AddSItem(sItem);
+        m_payload.ss.push_back(sItem);
     }
     return *this;
 }
 
-const Aws::Vector<Aws::String> AttributeValue::GetNS() const
+const Aws::Vector<Aws::String>& AttributeValue::GetNS() const
 {
-    if (m_value)
-    {
-        return m_value->GetNS();
-    }
-    else
-    {
-        return {};
-    }
+    return Is(ValueType::NUMBER_SET) ? m_payload.ss : EmptyStringVector();
 }
 
 AttributeValue& AttributeValue::SetNS(const Aws::Vector<Aws::String>& ns)
 {
-    m_value = Aws::MakeShared<AttributeValueNumberSet>("AttributeValue", ns);
-    return *this;
+    return SetNS(Aws::Vector<Aws::String>(ns));
+}
+
+AttributeValue& AttributeValue::SetNS(Aws::Vector<Aws::String>&& ns)
+{
+    return Emplace(ValueType::NUMBER_SET, m_payload.ss, std::move(ns));
 }
 
 AttributeValue& AttributeValue::AddNItem(const Aws::String& nItem)
 {
-    if (!m_value)
+    if (!m_hasValue)
     {
-        Aws::Vector<Aws::String> ns;
-        ns.push_back(nItem);
-        m_value = Aws::MakeShared<AttributeValueNumberSet>("AttributeValue", ns);
+        Emplace(ValueType::NUMBER_SET, m_payload.ss, Aws::Vector<Aws::String>());
     }
-    else
+    assert(m_type == ValueType::NUMBER_SET);
+    if (m_type == ValueType::NUMBER_SET)
     {
-        m_value->AddNItem(nItem);
+        m_payload.ss.push_back(nItem);
     }
     return *this;
 }
 
-const Aws::Vector<ByteBuffer> AttributeValue::GetBS() const
+const Aws::Vector<ByteBuffer>& AttributeValue::GetBS() const
 {
-    if (m_value)
-    {
-        return m_value->GetBS();
-    }
-    else
-    {
-        return {};
-    }
+    return Is(ValueType::BYTEBUFFER_SET) ? m_payload.bs : EmptyByteBufferVector();
 }
 
 AttributeValue& AttributeValue::SetBS(const Aws::Vector<ByteBuffer>& bs)
 {
-    m_value = Aws::MakeShared<AttributeValueByteBufferSet>("AttributeValue", bs);
-    return *this;
+    return SetBS(Aws::Vector<ByteBuffer>(bs));
+}
+
+AttributeValue& AttributeValue::SetBS(Aws::Vector<ByteBuffer>&& bs)
+{
+    return Emplace(ValueType::BYTEBUFFER_SET, m_payload.bs, std::move(bs));
 }
 
 AttributeValue& AttributeValue::AddBItem(const ByteBuffer& bItem)
 {
-    if (!m_value)
+    if (!m_hasValue)
     {
-        Aws::Vector<ByteBuffer> bs;
-        bs.push_back(bItem);
-        m_value = Aws::MakeShared<AttributeValueByteBufferSet>("AttributeValue", bs);
+        Emplace(ValueType::BYTEBUFFER_SET, m_payload.bs, Aws::Vector<ByteBuffer>());
     }
-    else
+    assert(m_type == ValueType::BYTEBUFFER_SET);
+    if (m_type == ValueType::BYTEBUFFER_SET)
     {
-        m_value->AddBItem(bItem);
+        m_payload.bs.push_back(bItem);
     }
     return *this;
 }
@@ -170,210 +341,327 @@ AttributeValue& AttributeValue::AddBItem(const unsigned char* bItem, size_t size
     return AddBItem(ByteBuffer(bItem, size));
 }
 
-const Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>> AttributeValue::GetM() const
+const Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>>& AttributeValue::GetM() const
 {
-    if (m_value)
-    {
-        return m_value->GetM();
-    }
-    else
-    {
-        return {};
-    }
+    return Is(ValueType::ATTRIBUTE_MAP) ? m_payload.m : EmptyMap();
 }
 
 AttributeValue& AttributeValue::SetM(const Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>>& map)
 {
-    m_value = Aws::MakeShared<AttributeValueMap>("AttributeValue", map);
-    return *this;
+    return SetM(Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>>(map));
+}
+
+AttributeValue& AttributeValue::SetM(Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>>&& map)
+{
+    return Emplace(ValueType::ATTRIBUTE_MAP, m_payload.m, std::move(map));
 }
 
 AttributeValue& AttributeValue::AddMEntry(const Aws::String& key, const std::shared_ptr<AttributeValue>& value)
 {
-    if (!m_value)
+    if (!m_hasValue)
     {
-        Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>> map;
-        auto kvp = std::pair<Aws::String, const std::shared_ptr<AttributeValue>>(key, value);
-        map.insert(map.begin(), kvp);
-        m_value = Aws::MakeShared<AttributeValueMap>("AttributeValue", map);
+        Emplace(ValueType::ATTRIBUTE_MAP, m_payload.m, Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>>());
     }
-    else
+    assert(m_type == ValueType::ATTRIBUTE_MAP);
+    if (m_type == ValueType::ATTRIBUTE_MAP)
     {
-        m_value->AddMEntry(key, value);
+        m_payload.m.emplace(key, value);
     }
-
     return *this;
 }
 
-const Aws::Vector<std::shared_ptr<AttributeValue>> AttributeValue::GetL() const
+const Aws::Vector<std::shared_ptr<AttributeValue>>& AttributeValue::GetL() const
 {
-    if (m_value)
-    {
-        return m_value->GetL();
-    }
-    else
-    {
-        return {};
-    }
+    return Is(ValueType::ATTRIBUTE_LIST) ? m_payload.l : EmptyList();
 }
 
 AttributeValue& AttributeValue::SetL(const Aws::Vector<std::shared_ptr<AttributeValue>>& list)
 {
-    m_value = Aws::MakeShared<AttributeValueList>("AttributeValue", list);
-    return *this;
+    return SetL(Aws::Vector<std::shared_ptr<AttributeValue>>(list));
+}
+
+AttributeValue& AttributeValue::SetL(Aws::Vector<std::shared_ptr<AttributeValue>>&& list)
+{
+    return Emplace(ValueType::ATTRIBUTE_LIST, m_payload.l, std::move(list));
 }
 
 AttributeValue& AttributeValue::AddLItem(const std::shared_ptr<AttributeValue>& listItem)
 {
-    if (!m_value)
+    if (!m_hasValue)
     {
-        Aws::Vector<std::shared_ptr<AttributeValue>> list;
-        list.push_back(listItem);
-        m_value = Aws::MakeShared<AttributeValueList>("AttributeValue", list);
+        Emplace(ValueType::ATTRIBUTE_LIST, m_payload.l, Aws::Vector<std::shared_ptr<AttributeValue>>());
     }
-    else
+    assert(m_type == ValueType::ATTRIBUTE_LIST);
+    if (m_type == ValueType::ATTRIBUTE_LIST)
     {
-        m_value->AddLItem(listItem);
+        m_payload.l.push_back(listItem);
     }
-
     return *this;
 }
 
 bool AttributeValue::GetBool() const
 {
-    if (m_value)
-    {
-        return m_value->GetBool();
-    }
-    else
-    {
-        return false;
-    }
+    return Is(ValueType::BOOL) && m_payload.flag;
 }
 
 AttributeValue& AttributeValue::SetBool(bool value)
 {
-    m_value = Aws::MakeShared<AttributeValueBool>("AttributeValue", value);
-    return *this;
+    return Emplace(ValueType::BOOL, m_payload.flag, std::move(value));
 }
 
 bool AttributeValue::GetNull() const
 {
-    if (m_value)
-    {
-        return m_value->GetNull();
-    }
-    else
-    {
-        return false;
-    }
+    return Is(ValueType::NULLVALUE) && m_payload.flag;
 }
 
 AttributeValue& AttributeValue::SetNull(bool value)
 {
-    m_value = Aws::MakeShared<AttributeValueNull>("AttributeValue", value);
-    return *this;
+    return Emplace(ValueType::NULLVALUE, m_payload.flag, std::move(value));
 }
 
 AttributeValue& AttributeValue::operator =(JsonView jsonValue)
 {
     if (jsonValue.ValueExists("S"))
     {
-        m_value = Aws::MakeShared<AttributeValueString>("AttributeValue", jsonValue);
-        return *this;
+        return SetS(jsonValue.GetString("S"));
     }
 
     if (jsonValue.ValueExists("N"))
     {
-        m_value = Aws::MakeShared<AttributeValueNumeric>("AttributeValue", jsonValue);
-        return *this;
+        return SetN(jsonValue.GetString("N"));
     }
 
     if (jsonValue.ValueExists("B"))
     {
-        m_value = Aws::MakeShared<AttributeValueByteBuffer>("AttributeValue", jsonValue);
-        return *this;
+        return SetB(HashingUtils::Base64Decode(jsonValue.GetString("B")));
     }
 
     if (jsonValue.ValueExists("SS"))
     {
-        m_value = Aws::MakeShared<AttributeValueStringSet>("AttributeValue", jsonValue);
-        return *this;
+        Array<JsonView> array = jsonValue.GetArray("SS");
+        Aws::Vector<Aws::String> ss;
+        ss.reserve(array.GetLength());
+        for (unsigned i = 0; i < array.GetLength(); ++i)
+        {
+            ss.push_back(array[i].AsString());
+        }
+        return SetSS(std::move(ss));
     }
 
     if (jsonValue.ValueExists("NS"))
     {
-        m_value = Aws::MakeShared<AttributeValueNumberSet>("AttributeValue", jsonValue);
-        return *this;
+        Array<JsonView> array = jsonValue.GetArray("NS");
+        Aws::Vector<Aws::String> ns;
+        ns.reserve(array.GetLength());
+        for (unsigned i = 0; i < array.GetLength(); ++i)
+        {
+            ns.push_back(array[i].AsString());
+        }
+        return SetNS(std::move(ns));
     }
 
     if (jsonValue.ValueExists("BS"))
     {
-        m_value = Aws::MakeShared<AttributeValueByteBufferSet>("AttributeValue", jsonValue);
-        return *this;
+        Array<JsonView> array = jsonValue.GetArray("BS");
+        Aws::Vector<ByteBuffer> bs;
+        bs.reserve(array.GetLength());
+        for (unsigned i = 0; i < array.GetLength(); ++i)
+        {
+            bs.push_back(HashingUtils::Base64Decode(array[i].AsString()));
+        }
+        return SetBS(std::move(bs));
     }
 
     if (jsonValue.ValueExists("M"))
     {
-        m_value = Aws::MakeShared<AttributeValueMap>("AttributeValue", jsonValue);
-        return *this;
+        Aws::Map<Aws::String, const std::shared_ptr<AttributeValue>> map;
+        for (auto& item : jsonValue.GetObject("M").GetAllObjects())
+        {
+            map.emplace(item.first, Aws::MakeShared<AttributeValue>("AttributeValue", item.second));
+        }
+        return SetM(std::move(map));
     }
 
     if (jsonValue.ValueExists("L"))
     {
-        m_value = Aws::MakeShared<AttributeValueList>("AttributeValue", jsonValue);
-        return *this;
+        Array<JsonView> array = jsonValue.GetArray("L");
+        Aws::Vector<std::shared_ptr<AttributeValue>> list;
+        list.reserve(array.GetLength());
+        for (unsigned i = 0; i < array.GetLength(); ++i)
+        {
+            list.push_back(Aws::MakeShared<AttributeValue>("AttributeValue", array[i]));
+        }
+        return SetL(std::move(list));
     }
 
     if (jsonValue.ValueExists("BOOL"))
     {
-        m_value = Aws::MakeShared<AttributeValueBool>("AttributeValue", jsonValue);
-        return *this;
+        return SetBool(jsonValue.GetBool("BOOL"));
     }
 
     if (jsonValue.ValueExists("NULL"))
     {
-        m_value = Aws::MakeShared<AttributeValueNull>("AttributeValue", jsonValue);
-        return *this;
+        return SetNull(jsonValue.GetBool("NULL"));
     }
 
     return *this;
 }
 
+bool AttributeValue::IsDefault() const
+{
+    if (!m_hasValue)
+    {
+        return true;
+    }
+
+    switch (m_type)
+    {
+    case ValueType::STRING:
+    case ValueType::NUMBER:
+        return m_payload.s.empty();
+    case ValueType::BYTEBUFFER:
+        return m_payload.b.GetLength() == 0;
+    case ValueType::STRING_SET:
+    case ValueType::NUMBER_SET:
+        return m_payload.ss.empty();
+    case ValueType::BYTEBUFFER_SET:
+        return m_payload.bs.empty();
+    case ValueType::ATTRIBUTE_MAP:
+        return m_payload.m.empty();
+    case ValueType::ATTRIBUTE_LIST:
+        return m_payload.l.empty();
+    case ValueType::BOOL:
+    case ValueType::NULLVALUE:
+        return !m_payload.flag;
+    }
+    return true;
+}
+
 bool AttributeValue::operator ==(const AttributeValue& other) const
 {
     if (this == &other)
         return true;
 
-    if (m_value)
+    // an uninitialized value equals any value holding its type's default
+    if (!m_hasValue || !other.m_hasValue)
     {
-        if (other.m_value)
+        return IsDefault() && other.IsDefault();
+    }
+
+    if (m_type != other.m_type)
+        return false;
+
+    switch (m_type)
+    {
+    case ValueType::STRING:
+    case ValueType::NUMBER:
+        return m_payload.s == other.m_payload.s;
+    case ValueType::BYTEBUFFER:
+        return m_payload.b == other.m_payload.b;
+    case ValueType::STRING_SET:
+    case ValueType::NUMBER_SET:
+        return m_payload.ss == other.m_payload.ss;
+    case ValueType::BYTEBUFFER_SET:
+        return m_payload.bs == other.m_payload.bs;
+    case ValueType::ATTRIBUTE_MAP:
+        if (m_payload.m.size() != other.m_payload.m.size())
+            return false;
+        for (auto& mapItem : m_payload.m)
         {
-            return *m_value == *other.m_value;
+            auto foundItem = other.m_payload.m.find(mapItem.first);
+            if (foundItem == other.m_payload.m.end() || *foundItem->second != *mapItem.second)
+                return false;
         }
-        else
+        return true;
+    case ValueType::ATTRIBUTE_LIST:
+        if (m_payload.l.size() != other.m_payload.l.size())
+            return false;
+        for (size_t i = 0; i < m_payload.l.size(); ++i)
         {
-            return m_value->IsDefault();
+            if (*m_payload.l[i] != *other.m_payload.l[i])
+                return false;
         }
+        return true;
+    case ValueType::BOOL:
+    case ValueType::NULLVALUE:
+        return m_payload.flag == other.m_payload.flag;
     }
-    else if (other.m_value)
-    {
-        return other.m_value->IsDefault();
-    }
-
-    return true;
+    return false;
 }
 
 JsonValue AttributeValue::Jsonize() const
 {
-    if (m_value)
+    JsonValue value;
+    if (!m_hasValue)
     {
-        return m_value->Jsonize();
+        return value;
     }
-    else
+
+    switch (m_type)
     {
-        return JsonValue();
+    case ValueType::STRING:
+        value.WithString("S", m_payload.s);
+        break;
+    case ValueType::NUMBER:
+        if (!m_payload.s.empty())
+        {
+            value.WithString("N", m_payload.s);
+        }
+        break;
+    case ValueType::BYTEBUFFER:
+        value.WithString("B", HashingUtils::Base64Encode(m_payload.b));
+        break;
+    case ValueType::STRING_SET:
+    case ValueType::NUMBER_SET:
+        if (m_payload.ss.size() > 0)
+        {
+            Array<JsonValue> array(m_payload.ss.size());
+            for (unsigned i = 0; i < m_payload.ss.size(); ++i)
+            {
+                array[i].AsString(m_payload.ss[i]);
+            }
+            value.WithArray(m_type == ValueType::STRING_SET ? "SS" : "NS", std::move(array));
+        }
+        break;
+    case ValueType::BYTEBUFFER_SET:
+        if (m_payload.bs.size() > 0)
+        {
+            Array<JsonValue> array(m_payload.bs.size());
+            for (unsigned i = 0; i < m_payload.bs.size(); ++i)
+            {
+                array[i].AsString(HashingUtils::Base64Encode(m_payload.bs[i]));
+            }
+            value.WithArray("BS", std::move(array));
+        }
+        break;
+    case ValueType::ATTRIBUTE_MAP:
+    {
+        JsonValue mapValue;
+        for (auto& mapItem : m_payload.m)
+        {
+            mapValue.WithObject(mapItem.first, mapItem.second->Jsonize());
+        }
+        value.WithObject("M", std::move(mapValue));
+        break;
     }
+    case ValueType::ATTRIBUTE_LIST:
+    {
+        Array<JsonValue> list(m_payload.l.size());
+        for (unsigned i = 0; i < m_payload.l.size(); ++i)
+        {
+            list[i] = m_payload.l[i]->Jsonize();
+        }
+        value.WithArray("L", std::move(list));
+        break;
+    }
+    case ValueType::BOOL:
+        value.WithBool("BOOL", m_payload.flag);
+        break;
+    case ValueType::NULLVALUE:
+        value.WithBool("NULL", m_payload.flag);
+        break;
+    }
+    return value;
 }
 
 Aws::String AttributeValue::SerializeAttribute() const
@@ -381,8 +669,3 @@ Aws::String AttributeValue::SerializeAttribute() const
     JsonValue value = Jsonize();
     return value.View().WriteReadable();
 }
-
-Aws::DynamoDB::Model::ValueType AttributeValue::GetType() const
-{
-    return m_value->GetType();
-}
@@ -0,0 +1,418 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/firehose-producer/RecordProducer.h>
+#include <aws/core/auth/AWSCredentials.h>
+#include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/firehose/FirehoseClient.h>
+#include <aws/firehose/model/PutRecordBatchRequest.h>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+using namespace Aws::FirehoseProducer;
+using namespace Aws::Firehose;
+using namespace Aws::Firehose::Model;
+using namespace Aws::Client;
+
+static const char ALLOCATION_TAG[] = "RecordProducerTest";
+static const char DELIVERY_STREAM[] = "test-delivery-stream";
+
+namespace
+{
+    /**
+     * Local stand-in for Kinesis Data Firehose: records every call and answers through an optional handler,
+     * after an optional simulated round trip.
+     */
+    class MockFirehoseClient : public FirehoseClient
+    {
+    public:
+        typedef std::function<PutRecordBatchOutcome(const PutRecordBatchRequest&, size_t)> Handler;
+
+        MockFirehoseClient() : FirehoseClient(Aws::Auth::AWSCredentials("", ""), ClientConfiguration()),
+            m_latencyMs(0), m_inFlight(0), m_maxInFlight(0), m_recordsReceived(0), m_calls(0)
+        {
+        }
+
+        PutRecordBatchOutcome PutRecordBatch(const PutRecordBatchRequest& request) const override
+        {
+            size_t callIndex = 0;
+            {
+                std::lock_guard<std::mutex> locker(m_mutex);
+                callIndex = m_calls++;
+                m_recordsPerCall.push_back(request.GetRecords().size());
+                size_t bytes = 0;
+                for (const auto& record : request.GetRecords())
+                {
+                    bytes += record.GetData().GetLength();
+                }
+                m_bytesPerCall.push_back(bytes);
+                m_maxInFlight = (std::max)(m_maxInFlight, ++m_inFlight);
+            }
+
+            if (m_latencyMs > 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(m_latencyMs));
+            }
+
+            PutRecordBatchOutcome outcome = m_handler ? m_handler(request, callIndex) : Succeed(request);
+
+            std::lock_guard<std::mutex> locker(m_mutex);
+            --m_inFlight;
+            if (outcome.IsSuccess())
+            {
+                m_recordsReceived += request.GetRecords().size() - outcome.GetResult().GetFailedPutCount();
+            }
+            return outcome;
+        }
+
+        static PutRecordBatchOutcome Succeed(const PutRecordBatchRequest& request)
+        {
+            PutRecordBatchResult result;
+            for (size_t i = 0; i < request.GetRecords().size(); ++i)
+            {
+                result.AddRequestResponses(PutRecordBatchResponseEntry().WithRecordId("id"));
+            }
+            return result;
+        }
+
+        void SetHandler(const Handler& handler) { m_handler = handler; }
+        void SetLatencyMs(long latencyMs) { m_latencyMs = latencyMs; }
+
+        Aws::Vector<size_t> GetRecordsPerCall() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_recordsPerCall;
+        }
+
+        Aws::Vector<size_t> GetBytesPerCall() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_bytesPerCall;
+        }
+
+        size_t GetMaxInFlight() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_maxInFlight;
+        }
+
+        size_t GetRecordsReceived() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_recordsReceived;
+        }
+
+    private:
+        Handler m_handler;
+        long m_latencyMs;
+        mutable std::mutex m_mutex;
+        mutable Aws::Vector<size_t> m_recordsPerCall;
+        mutable Aws::Vector<size_t> m_bytesPerCall;
+        mutable size_t m_inFlight;
+        mutable size_t m_maxInFlight;
+        mutable size_t m_recordsReceived;
+        mutable size_t m_calls;
+    };
+
+    RecordProducerConfiguration MakeConfiguration(const std::shared_ptr<MockFirehoseClient>& client)
+    {
+        RecordProducerConfiguration config;
+        config.client = client;
+        // Tests send partial batches explicitly through Flush.
+        config.lingerMs = 60000;
+        config.retryBaseDelayMs = 1;
+        config.retryMaxDelayMs = 10;
+        return config;
+    }
+
+    Aws::Utils::ByteBuffer MakeRecord(size_t length, unsigned char fill = 'x')
+    {
+        Aws::Utils::ByteBuffer data(length);
+        for (size_t i = 0; i < length; ++i)
+        {
+            data[i] = fill;
+        }
+        return data;
+    }
+}
+
+TEST(RecordProducerTest, TestRecordsArePackedByCount)
+{
+    auto client = Aws::MakeShared<MockFirehoseClient>(ALLOCATION_TAG);
+    auto config = MakeConfiguration(client);
+    config.maxInFlightBatchesPerStream = 1;
+    RecordProducer producer(config);
+
+    for (int i = 0; i < 1200; ++i)
+    {
+        ASSERT_TRUE(producer.Put(DELIVERY_STREAM, MakeRecord(10)));
+    }
+    producer.Flush();
+
+    auto recordsPerCall = client->GetRecordsPerCall();
+    ASSERT_EQ(3u, recordsPerCall.size());
+    ASSERT_EQ(500u, recordsPerCall[0]);
+    ASSERT_EQ(500u, recordsPerCall[1]);
+    ASSERT_EQ(200u, recordsPerCall[2]);
+
+    auto statistics = producer.GetStatistics();
+    ASSERT_EQ(1200u, statistics.recordsPut);
+    ASSERT_EQ(1200u, statistics.recordsDelivered);
+    ASSERT_EQ(3u, statistics.batchesSent);
+}
+
+TEST(RecordProducerTest, TestRecordsArePackedBySize)
+{
+    auto client = Aws::MakeShared<MockFirehoseClient>(ALLOCATION_TAG);
+    auto config = MakeConfiguration(client);
+    config.maxInFlightBatchesPerStream = 1;
+    RecordProducer producer(config);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(producer.Put(DELIVERY_STREAM, MakeRecord(900 * 1024)));
+    }
+    producer.Flush();
+
+    auto recordsPerCall = client->GetRecordsPerCall();
+    ASSERT_EQ(Aws::Vector<size_t>({4, 4, 2}), recordsPerCall);
+    for (size_t bytes : client->GetBytesPerCall())
+    {
+        ASSERT_GE(4u * 1024 * 1024, bytes);
+    }
+}
+
+TEST(RecordProducerTest, TestOversizedRecordsAreRejected)
+{
+    auto client = Aws::MakeShared<MockFirehoseClient>(ALLOCATION_TAG);
+    RecordProducer producer(MakeConfiguration(client));
+
+    ASSERT_FALSE(producer.Put(DELIVERY_STREAM, MakeRecord(1000 * 1024 + 1)));
+    ASSERT_TRUE(producer.Put(DELIVERY_STREAM, MakeRecord(1000 * 1024)));
+    producer.Flush();
+
+    auto statistics = producer.GetStatistics();
+    ASSERT_EQ(1u, statistics.recordsRejected);
+    ASSERT_EQ(1u, statistics.recordsDelivered);
+}
+
+TEST(RecordProducerTest, TestOnlyFailedRecordsAreRetried)
+{
+    auto client = Aws::MakeShared<MockFirehoseClient>(ALLOCATION_TAG);
+    client->SetHandler([](const PutRecordBatchRequest& request, size_t callIndex) -> PutRecordBatchOutcome
+    {
+        if (callIndex > 0)
+        {
+            return MockFirehoseClient::Succeed(request);
+        }
+
+        // Fail every record whose data starts with 'b'.
+        PutRecordBatchResult result;
+        int failed = 0;
+        for (const auto& record : request.GetRecords())
+        {
+            if (record.GetData()[0] == 'b')
+            {
+                ++failed;
+                result.AddRequestResponses(PutRecordBatchResponseEntry().WithErrorCode("ServiceUnavailableException"));
+            }
+            else
+            {
+                result.AddRequestResponses(PutRecordBatchResponseEntry().WithRecordId("id"));
+            }
+        }
+        result.SetFailedPutCount(failed);
+        return result;
+    });
+    RecordProducer producer(MakeConfiguration(client));
+
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(producer.Put(DELIVERY_STREAM, MakeRecord(16, i % 2 ? 'b' : 'a')));
+    }
+    producer.Flush();
+
+    ASSERT_EQ(Aws::Vector<size_t>({10, 5}), client->GetRecordsPerCall());
+    ASSERT_EQ(10u, client->GetRecordsReceived());
+
+    auto statistics = producer.GetStatistics();
+    ASSERT_EQ(10u, statistics.recordsDelivered);
+    ASSERT_EQ(5u, statistics.recordsRetried);
+    ASSERT_EQ(0u, statistics.recordsFailed);
+}
+
+TEST(RecordProducerTest, TestRetriesStopAfterMaxAttempts)
+{
+    auto client = Aws::MakeShared<MockFirehoseClient>(ALLOCATION_TAG);
+    client->SetHandler([](const PutRecordBatchRequest&, size_t) -> PutRecordBatchOutcome
+    {
+        return FirehoseError(AWSError<FirehoseErrors>(FirehoseErrors::SERVICE_UNAVAILABLE, "ServiceUnavailableException", "slow down", true));
+    });
+    auto config = MakeConfiguration(client);
+    config.maxAttempts = 3;
+    RecordProducer producer(config);
+
+    ASSERT_TRUE(producer.Put(DELIVERY_STREAM, MakeRecord(16)));
+    ASSERT_TRUE(producer.Put(DELIVERY_STREAM, MakeRecord(16)));
+    producer.Flush();
+
+    ASSERT_EQ(Aws::Vector<size_t>({2, 2, 2}), client->GetRecordsPerCall());
+    auto statistics = producer.GetStatistics();
+    ASSERT_EQ(0u, statistics.recordsDelivered);
+    ASSERT_EQ(4u, statistics.recordsRetried);
+    ASSERT_EQ(2u, statistics.recordsFailed);
+}
+
+TEST(RecordProducerTest, TestNonRetryableErrorDiscardsBatch)
+{
+    auto client = Aws::MakeShared<MockFirehoseClient>(ALLOCATION_TAG);
+    client->SetHandler([](const PutRecordBatchRequest&, size_t) -> PutRecordBatchOutcome
+    {
+        return FirehoseError(AWSError<FirehoseErrors>(FirehoseErrors::RESOURCE_NOT_FOUND, "ResourceNotFoundException", "no such stream", false));
+    });
+    RecordProducer producer(MakeConfiguration(client));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(producer.Put(DELIVERY_STREAM, MakeRecord(16)));
+    }
+    producer.Flush();
+
+    ASSERT_EQ(1u, client->GetRecordsPerCall().size());
+    auto statistics = producer.GetStatistics();
+    ASSERT_EQ(3u, statistics.recordsFailed);
+    ASSERT_EQ(0u, statistics.recordsRetried);
+}
+
+TEST(RecordProducerTest, TestBufferAppliesBackPressure)
+{
+    std::mutex gateMutex;
+    std::condition_variable gateSignal;
+    bool gateOpen = false;
+
+    auto client = Aws::MakeShared<MockFirehoseClient>(ALLOCATION_TAG);
+    client->SetHandler([&](const PutRecordBatchRequest& request, size_t) -> PutRecordBatchOutcome
+    {
+        std::unique_lock<std::mutex> locker(gateMutex);
+        gateSignal.wait(locker, [&]() { return gateOpen; });
+        return MockFirehoseClient::Succeed(request);
+    });
+    auto config = MakeConfiguration(client);
+    config.maxBufferedBytes = 1000;
+    config.lingerMs = 0;
+    RecordProducer producer(config);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(producer.TryPut(DELIVERY_STREAM, MakeRecord(100)));
+    }
+    ASSERT_FALSE(producer.TryPut(DELIVERY_STREAM, MakeRecord(100)));
+
+    std::thread opener([&]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::lock_guard<std::mutex> locker(gateMutex);
+        gateOpen = true;
+        gateSignal.notify_all();
+    });
+    // Blocks until the gate opens and delivered records make room.
+    ASSERT_TRUE(producer.Put(DELIVERY_STREAM, MakeRecord(100)));
+    opener.join();
+    producer.Flush();
+
+    ASSERT_EQ(11u, client->GetRecordsReceived());
+    ASSERT_EQ(11u, producer.GetStatistics().recordsDelivered);
+}
+
+TEST(RecordProducerTest, TestBatchesAreSentConcurrently)
+{
+    auto client = Aws::MakeShared<MockFirehoseClient>(ALLOCATION_TAG);
+    client->SetLatencyMs(20);
+    auto config = MakeConfiguration(client);
+    config.maxBatchRecords = 10;
+    config.maxInFlightBatchesPerStream = 4;
+    RecordProducer producer(config);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        ASSERT_TRUE(producer.Put(DELIVERY_STREAM, MakeRecord(16)));
+    }
+    producer.Flush();
+
+    ASSERT_EQ(200u, client->GetRecordsReceived());
+    ASSERT_LT(1u, client->GetMaxInFlight());
+    ASSERT_GE(4u, client->GetMaxInFlight());
+}
+
+TEST(RecordProducerTest, TestThroughputAgainstLocalStandIn)
+{
+    // Simulates a 5ms PutRecordBatch round trip where every 50th record is throttled.
+    auto client = Aws::MakeShared<MockFirehoseClient>(ALLOCATION_TAG);
+    client->SetLatencyMs(5);
+    client->SetHandler([](const PutRecordBatchRequest& request, size_t callIndex) -> PutRecordBatchOutcome
+    {
+        PutRecordBatchResult result;
+        int failed = 0;
+        for (size_t i = 0; i < request.GetRecords().size(); ++i)
+        {
+            if ((callIndex + i) % 50 == 0)
+            {
+                ++failed;
+                result.AddRequestResponses(PutRecordBatchResponseEntry().WithErrorCode("ServiceUnavailableException"));
+            }
+            else
+            {
+                result.AddRequestResponses(PutRecordBatchResponseEntry().WithRecordId("id"));
+            }
+        }
+        result.SetFailedPutCount(failed);
+        return result;
+    });
+
+    auto config = MakeConfiguration(client);
+    config.lingerMs = 10;
+    config.maxInFlightBatchesPerStream = 8;
+    config.maxBufferedBytes = 8 * 1024 * 1024;
+    config.maxAttempts = 100;
+    RecordProducer producer(config);
+
+    const size_t producerThreads = 4;
+    const size_t recordsPerThread = 25000;
+    const size_t recordBytes = 512;
+
+    auto start = std::chrono::steady_clock::now();
+    Aws::Vector<std::thread> threads;
+    for (size_t t = 0; t < producerThreads; ++t)
+    {
+        threads.emplace_back([&]()
+        {
+            for (size_t i = 0; i < recordsPerThread; ++i)
+            {
+                producer.Put(DELIVERY_STREAM, MakeRecord(recordBytes));
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    producer.Flush();
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    auto statistics = producer.GetStatistics();
+    ASSERT_EQ(producerThreads * recordsPerThread, statistics.recordsDelivered);
+    ASSERT_EQ(producerThreads * recordsPerThread, client->GetRecordsReceived());
+    ASSERT_EQ(0u, statistics.recordsFailed);
+
+    double seconds = (std::max)(static_cast<double>(elapsedMs), 1.0) / 1000;
+    std::cout << "Delivered " << statistics.recordsDelivered << " records in " << statistics.batchesSent << " batches ("
+        << statistics.recordsRetried << " retried) in " << elapsedMs << " ms: "
+        << static_cast<uint64_t>(statistics.recordsDelivered / seconds) << " records/s, "
+        << static_cast<uint64_t>(statistics.recordsDelivered * recordBytes / seconds / (1024 * 1024)) << " MiB/s" << std::endl;
+}
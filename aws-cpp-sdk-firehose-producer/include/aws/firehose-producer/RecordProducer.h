@@ -0,0 +1,214 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/firehose-producer/FirehoseProducer_EXPORTS.h>
+#include <aws/core/utils/Array.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <aws/core/utils/memory/stl/AWSDeque.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Threading
+        {
+            class Executor;
+        }
+    }
+
+    namespace Firehose
+    {
+        class FirehoseClient;
+    }
+
+    namespace FirehoseProducer
+    {
+        /**
+         * Configuration for use with RecordProducer. The data here will be copied directly to RecordProducer.
+         */
+        struct RecordProducerConfiguration
+        {
+            RecordProducerConfiguration() :
+                maxBufferedBytes(64 * 1024 * 1024), maxBatchRecords(500), maxBatchBytes(4 * 1024 * 1024),
+                maxInFlightBatchesPerStream(4), lingerMs(100), maxAttempts(10), retryBaseDelayMs(100), retryMaxDelayMs(10000)
+            {
+            }
+
+            /**
+             * Client used to call PutRecordBatch. You are responsible for setting this.
+             */
+            std::shared_ptr<Aws::Firehose::FirehoseClient> client;
+            /**
+             * Executor PutRecordBatch calls are run on. It must not run tasks on the submitting thread.
+             * If not set, the producer creates a PooledThreadExecutor with maxInFlightBatchesPerStream threads.
+             */
+            std::shared_ptr<Aws::Utils::Threading::Executor> executor;
+            /**
+             * Upper bound on the record data held by the producer, including records being sent or waiting to be retried.
+             * Put blocks and TryPut fails while the buffer is full.
+             */
+            size_t maxBufferedBytes;
+            /**
+             * Maximum number of records per PutRecordBatch call. The service maximum is 500.
+             */
+            size_t maxBatchRecords;
+            /**
+             * Maximum record data per PutRecordBatch call. The service maximum is 4 MiB.
+             */
+            size_t maxBatchBytes;
+            /**
+             * Number of PutRecordBatch calls that may be outstanding for the same delivery stream at any time.
+             */
+            size_t maxInFlightBatchesPerStream;
+            /**
+             * How long a record may wait for a batch to fill up before a partial batch is sent.
+             */
+            long lingerMs;
+            /**
+             * Number of times a record is sent before it is given up on.
+             */
+            unsigned maxAttempts;
+            /**
+             * Delay before the first retry of a failed record. It doubles with every attempt, up to retryMaxDelayMs.
+             */
+            long retryBaseDelayMs;
+            long retryMaxDelayMs;
+        };
+
+        /**
+         * Point in time counters of a RecordProducer.
+         */
+        struct RecordProducerStatistics
+        {
+            RecordProducerStatistics() :
+                recordsPut(0), recordsDelivered(0), recordsRetried(0), recordsFailed(0), recordsRejected(0), batchesSent(0)
+            {
+            }
+
+            /** Records accepted by Put or TryPut. */
+            uint64_t recordsPut;
+            /** Records accepted by Kinesis Data Firehose. */
+            uint64_t recordsDelivered;
+            /** Record attempts that failed and were scheduled again. */
+            uint64_t recordsRetried;
+            /** Records given up on, either after maxAttempts or after a non retryable error. */
+            uint64_t recordsFailed;
+            /** Records refused by Put or TryPut because they exceed the service's record size limit. */
+            uint64_t recordsRejected;
+            /** PutRecordBatch calls made. */
+            uint64_t batchesSent;
+        };
+
+        /**
+         * Buffers records and delivers them to Kinesis Data Firehose with PutRecordBatch.
+         *
+         * Records are queued per delivery stream and packed into batches of up to maxBatchRecords records and maxBatchBytes of
+         * data. A batch is sent as soon as it is full, or once its oldest record has waited lingerMs. Up to
+         * maxInFlightBatchesPerStream batches per delivery stream are sent concurrently on the executor.
+         *
+         * PutRecordBatch reports failures per record; only the records that failed are sent again, after an exponential
+         * backoff, together with new records. A call failing as a whole is retried the same way if the error is retryable.
+         */
+        class AWS_FIREHOSE_PRODUCER_API RecordProducer
+        {
+        public:
+            RecordProducer(const RecordProducerConfiguration& config);
+
+            /**
+             * Delivers whatever is still buffered, then stops the background thread.
+             */
+            ~RecordProducer();
+
+            RecordProducer(const RecordProducer&) = delete;
+            RecordProducer& operator=(const RecordProducer&) = delete;
+
+            /**
+             * Queues data for deliveryStreamName, blocking while the buffer is full.
+             * Returns false if data exceeds the service's record size limit or the producer is shutting down.
+             */
+            bool Put(const Aws::String& deliveryStreamName, Aws::Utils::ByteBuffer&& data);
+
+            /**
+             * Queues data for deliveryStreamName if there is room in the buffer. Returns false otherwise.
+             */
+            bool TryPut(const Aws::String& deliveryStreamName, Aws::Utils::ByteBuffer&& data);
+
+            /**
+             * Sends partial batches right away and blocks until every buffered record has been delivered or given up on.
+             * Records put while Flush is waiting extend the wait.
+             */
+            void Flush();
+
+            RecordProducerStatistics GetStatistics() const;
+
+            inline const RecordProducerConfiguration& GetConfiguration() const { return m_config; }
+
+        private:
+            typedef std::chrono::steady_clock Clock;
+
+            struct PendingRecord
+            {
+                Aws::Utils::ByteBuffer data;
+                Clock::time_point readyAt;
+                unsigned attempts;
+            };
+
+            struct StreamQueue
+            {
+                StreamQueue() : queuedBytes(0), inFlightBatches(0) {}
+
+                Aws::Deque<PendingRecord> records;
+                Aws::Deque<PendingRecord> retries;
+                size_t queuedBytes;
+                size_t inFlightBatches;
+            };
+
+            struct Batch
+            {
+                Aws::String deliveryStreamName;
+                Aws::Vector<PendingRecord> records;
+            };
+
+            bool Enqueue(const Aws::String& deliveryStreamName, Aws::Utils::ByteBuffer&& data, bool wait);
+            void Run();
+            bool TakeBatch(const Aws::String& deliveryStreamName, StreamQueue& queue, Clock::time_point now,
+                Clock::time_point& nextWakeUp, Batch& batch);
+            void SendBatch(const std::shared_ptr<Batch>& batch);
+            Clock::duration GetRetryDelay(unsigned attempts) const;
+
+            RecordProducerConfiguration m_config;
+            std::shared_ptr<Aws::Utils::Threading::Executor> m_executor;
+
+            mutable std::mutex m_mutex;
+            std::condition_variable m_signal;
+            std::condition_variable m_spaceAvailable;
+            std::condition_variable m_drained;
+            Aws::Map<Aws::String, StreamQueue> m_streams;
+            size_t m_bufferedBytes;
+            size_t m_bufferedRecords;
+            size_t m_flushWaiters;
+            bool m_stopping;
+
+            std::atomic<uint64_t> m_recordsPut;
+            std::atomic<uint64_t> m_recordsDelivered;
+            std::atomic<uint64_t> m_recordsRetried;
+            std::atomic<uint64_t> m_recordsFailed;
+            std::atomic<uint64_t> m_recordsRejected;
+            std::atomic<uint64_t> m_batchesSent;
+
+            std::thread m_thread;
+        };
+    }
+}
@@ -0,0 +1,367 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/firehose-producer/RecordProducer.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <aws/firehose/FirehoseClient.h>
+#include <aws/firehose/model/PutRecordBatchRequest.h>
+#include <algorithm>
+#include <cassert>
+
+using namespace Aws::Firehose;
+using namespace Aws::Firehose::Model;
+
+namespace Aws
+{
+    namespace FirehoseProducer
+    {
+        static const char CLASS_TAG[] = "RecordProducer";
+
+        static const size_t MAX_RECORD_BYTES = 1000 * 1024;
+        static const size_t MAX_BATCH_RECORDS = 500;
+        static const size_t MAX_BATCH_BYTES = 4 * 1024 * 1024;
+
+        RecordProducer::RecordProducer(const RecordProducerConfiguration& config) :
+            m_config(config), m_executor(config.executor),
+            m_bufferedBytes(0), m_bufferedRecords(0), m_flushWaiters(0), m_stopping(false),
+            m_recordsPut(0), m_recordsDelivered(0), m_recordsRetried(0), m_recordsFailed(0), m_recordsRejected(0), m_batchesSent(0)
+        {
+            assert(m_config.client);
+            m_config.maxBatchRecords = (std::max)((std::min)(m_config.maxBatchRecords, MAX_BATCH_RECORDS), static_cast<size_t>(1));
+            m_config.maxBatchBytes = (std::min)(m_config.maxBatchBytes, MAX_BATCH_BYTES);
+            m_config.maxInFlightBatchesPerStream = (std::max)(m_config.maxInFlightBatchesPerStream, static_cast<size_t>(1));
+            m_config.maxAttempts = (std::max)(m_config.maxAttempts, 1u);
+
+            if (!m_executor)
+            {
+                m_executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(CLASS_TAG, m_config.maxInFlightBatchesPerStream);
+            }
+
+            m_thread = std::thread(&RecordProducer::Run, this);
+        }
+
+        RecordProducer::~RecordProducer()
+        {
+            {
+                std::lock_guard<std::mutex> locker(m_mutex);
+                m_stopping = true;
+                m_signal.notify_one();
+                m_spaceAvailable.notify_all();
+            }
+            if (m_thread.joinable())
+            {
+                m_thread.join();
+            }
+        }
+
+        bool RecordProducer::Put(const Aws::String& deliveryStreamName, Aws::Utils::ByteBuffer&& data)
+        {
+            return Enqueue(deliveryStreamName, std::move(data), true);
+        }
+
+        bool RecordProducer::TryPut(const Aws::String& deliveryStreamName, Aws::Utils::ByteBuffer&& data)
+        {
+            return Enqueue(deliveryStreamName, std::move(data), false);
+        }
+
+        bool RecordProducer::Enqueue(const Aws::String& deliveryStreamName, Aws::Utils::ByteBuffer&& data, bool wait)
+        {
+            size_t length = data.GetLength();
+            if (length > MAX_RECORD_BYTES)
+            {
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Rejecting a " << length << " byte record for delivery stream " << deliveryStreamName
+                        << ": records are limited to " << MAX_RECORD_BYTES << " bytes.");
+                ++m_recordsRejected;
+                return false;
+            }
+
+            std::unique_lock<std::mutex> locker(m_mutex);
+            // A record larger than the whole buffer is still let through once the buffer is empty.
+            auto hasRoom = [&]() { return m_bufferedBytes == 0 || m_bufferedBytes + length <= m_config.maxBufferedBytes; };
+            if (wait)
+            {
+                m_spaceAvailable.wait(locker, [&]() { return m_stopping || hasRoom(); });
+            }
+            if (m_stopping || !hasRoom())
+            {
+                return false;
+            }
+
+            StreamQueue& queue = m_streams[deliveryStreamName];
+            PendingRecord record;
+            record.data = std::move(data);
+            record.readyAt = Clock::now();
+            record.attempts = 0;
+            queue.records.push_back(std::move(record));
+            queue.queuedBytes += length;
+            m_bufferedBytes += length;
+            ++m_bufferedRecords;
+            ++m_recordsPut;
+
+            // Don't let a full batch wait for the linger time.
+            if (queue.records.size() >= m_config.maxBatchRecords || queue.queuedBytes >= m_config.maxBatchBytes)
+            {
+                m_signal.notify_one();
+            }
+            return true;
+        }
+
+        void RecordProducer::Flush()
+        {
+            std::unique_lock<std::mutex> locker(m_mutex);
+            ++m_flushWaiters;
+            m_signal.notify_one();
+            m_drained.wait(locker, [this]() { return m_bufferedRecords == 0; });
+            --m_flushWaiters;
+        }
+
+        RecordProducerStatistics RecordProducer::GetStatistics() const
+        {
+            RecordProducerStatistics statistics;
+            statistics.recordsPut = m_recordsPut.load();
+            statistics.recordsDelivered = m_recordsDelivered.load();
+            statistics.recordsRetried = m_recordsRetried.load();
+            statistics.recordsFailed = m_recordsFailed.load();
+            statistics.recordsRejected = m_recordsRejected.load();
+            statistics.batchesSent = m_batchesSent.load();
+            return statistics;
+        }
+
+        void RecordProducer::Run()
+        {
+            std::unique_lock<std::mutex> locker(m_mutex);
+            for (;;)
+            {
+                Clock::time_point now = Clock::now();
+                Clock::time_point nextWakeUp = now + std::chrono::milliseconds(m_config.lingerMs);
+
+                Aws::Vector<std::shared_ptr<Batch>> batches;
+                for (auto& stream : m_streams)
+                {
+                    while (stream.second.inFlightBatches < m_config.maxInFlightBatchesPerStream)
+                    {
+                        auto batch = Aws::MakeShared<Batch>(CLASS_TAG);
+                        if (!TakeBatch(stream.first, stream.second, now, nextWakeUp, *batch))
+                        {
+                            break;
+                        }
+                        ++stream.second.inFlightBatches;
+                        batches.push_back(batch);
+                    }
+                }
+
+                if (!batches.empty())
+                {
+                    locker.unlock();
+                    for (const auto& batch : batches)
+                    {
+                        if (!m_executor->Submit([this, batch]() { SendBatch(batch); }))
+                        {
+                            SendBatch(batch);
+                        }
+                    }
+                    locker.lock();
+                    continue;
+                }
+
+                // Every record still buffered is accounted for by m_bufferedRecords until its batch has completed,
+                // so no send task can be left running once it drops to zero.
+                if (m_stopping && m_bufferedRecords == 0)
+                {
+                    return;
+                }
+                m_signal.wait_until(locker, nextWakeUp);
+            }
+        }
+
+        bool RecordProducer::TakeBatch(const Aws::String& deliveryStreamName, StreamQueue& queue, Clock::time_point now,
+            Clock::time_point& nextWakeUp, Batch& batch)
+        {
+            bool retriesReady = false;
+            for (const auto& record : queue.retries)
+            {
+                if (record.readyAt <= now)
+                {
+                    retriesReady = true;
+                }
+                else
+                {
+                    nextWakeUp = (std::min)(nextWakeUp, record.readyAt);
+                }
+            }
+
+            bool recordsReady = false;
+            if (!queue.records.empty())
+            {
+                Clock::time_point lingerDeadline = queue.records.front().readyAt + std::chrono::milliseconds(m_config.lingerMs);
+                recordsReady = m_stopping || m_flushWaiters > 0 || lingerDeadline <= now ||
+                    queue.records.size() >= m_config.maxBatchRecords || queue.queuedBytes >= m_config.maxBatchBytes;
+                if (!recordsReady)
+                {
+                    nextWakeUp = (std::min)(nextWakeUp, lingerDeadline);
+                }
+            }
+
+            if (!retriesReady && !recordsReady)
+            {
+                return false;
+            }
+
+            batch.deliveryStreamName = deliveryStreamName;
+            size_t batchBytes = 0;
+            auto fits = [&](const PendingRecord& record)
+            {
+                return batch.records.size() < m_config.maxBatchRecords &&
+                    (batch.records.empty() || batchBytes + record.data.GetLength() <= m_config.maxBatchBytes);
+            };
+
+            // Records being retried go first; new records top the batch up.
+            for (auto record = queue.retries.begin(); record != queue.retries.end() && batch.records.size() < m_config.maxBatchRecords;)
+            {
+                if (record->readyAt <= now && fits(*record))
+                {
+                    batchBytes += record->data.GetLength();
+                    batch.records.push_back(std::move(*record));
+                    record = queue.retries.erase(record);
+                }
+                else
+                {
+                    ++record;
+                }
+            }
+
+            while (!queue.records.empty() && fits(queue.records.front()))
+            {
+                size_t length = queue.records.front().data.GetLength();
+                batchBytes += length;
+                queue.queuedBytes -= length;
+                batch.records.push_back(std::move(queue.records.front()));
+                queue.records.pop_front();
+            }
+            return true;
+        }
+
+        void RecordProducer::SendBatch(const std::shared_ptr<Batch>& batch)
+        {
+            PutRecordBatchRequest request;
+            request.SetDeliveryStreamName(batch->deliveryStreamName);
+            Aws::Vector<Record> records;
+            records.reserve(batch->records.size());
+            for (auto& pending : batch->records)
+            {
+                Record record;
+                record.SetData(std::move(pending.data));
+                records.push_back(std::move(record));
+            }
+            request.SetRecords(std::move(records));
+
+            ++m_batchesSent;
+            auto outcome = m_config.client->PutRecordBatch(request);
+
+            Clock::time_point now = Clock::now();
+            size_t delivered = 0;
+            size_t failed = 0;
+            size_t releasedBytes = 0;
+            Aws::Vector<PendingRecord> retries;
+
+            // The data was moved into the request; only records that are sent again need a copy of it back.
+            auto retryOrFail = [&](size_t index)
+            {
+                PendingRecord& record = batch->records[index];
+                const Aws::Utils::ByteBuffer& data = request.GetRecords()[index].GetData();
+                if (++record.attempts >= m_config.maxAttempts)
+                {
+                    ++failed;
+                    releasedBytes += data.GetLength();
+                    return;
+                }
+                record.data = data;
+                record.readyAt = now + GetRetryDelay(record.attempts);
+                retries.push_back(std::move(record));
+            };
+
+            if (outcome.IsSuccess())
+            {
+                const auto& responses = outcome.GetResult().GetRequestResponses();
+                bool anyFailed = outcome.GetResult().GetFailedPutCount() > 0;
+                for (size_t i = 0; i < batch->records.size(); ++i)
+                {
+                    if (anyFailed && i < responses.size() && !responses[i].GetErrorCode().empty())
+                    {
+                        retryOrFail(i);
+                    }
+                    else
+                    {
+                        ++delivered;
+                        releasedBytes += request.GetRecords()[i].GetData().GetLength();
+                    }
+                }
+                if (anyFailed)
+                {
+                    AWS_LOGSTREAM_DEBUG(CLASS_TAG, outcome.GetResult().GetFailedPutCount() << " of " << batch->records.size()
+                            << " records sent to delivery stream " << batch->deliveryStreamName << " failed.");
+                }
+            }
+            else if (outcome.GetError().ShouldRetry())
+            {
+                AWS_LOGSTREAM_WARN(CLASS_TAG, "PutRecordBatch to delivery stream " << batch->deliveryStreamName
+                        << " failed, retrying: " << outcome.GetError().GetMessage());
+                for (size_t i = 0; i < batch->records.size(); ++i)
+                {
+                    retryOrFail(i);
+                }
+            }
+            else
+            {
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Discarding " << batch->records.size() << " records for delivery stream "
+                        << batch->deliveryStreamName << ": " << outcome.GetError().GetMessage());
+                failed = batch->records.size();
+                for (const auto& record : request.GetRecords())
+                {
+                    releasedBytes += record.GetData().GetLength();
+                }
+            }
+
+            if (failed > 0 && outcome.IsSuccess())
+            {
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Discarding " << failed << " records for delivery stream "
+                        << batch->deliveryStreamName << " after " << m_config.maxAttempts << " attempts.");
+            }
+
+            m_recordsDelivered += delivered;
+            m_recordsFailed += failed;
+            m_recordsRetried += retries.size();
+
+            // Notify while holding the lock: once the last record is released the producer may be destroyed.
+            std::lock_guard<std::mutex> locker(m_mutex);
+            StreamQueue& queue = m_streams[batch->deliveryStreamName];
+            --queue.inFlightBatches;
+            for (auto& record : retries)
+            {
+                queue.retries.push_back(std::move(record));
+            }
+            m_bufferedBytes -= releasedBytes;
+            m_bufferedRecords -= delivered + failed;
+            m_signal.notify_one();
+            m_spaceAvailable.notify_all();
+            if (m_bufferedRecords == 0)
+            {
+                m_drained.notify_all();
+            }
+        }
+
+        RecordProducer::Clock::duration RecordProducer::GetRetryDelay(unsigned attempts) const
+        {
+            long delayMs = m_config.retryBaseDelayMs;
+            for (unsigned i = 1; i < attempts && delayMs < m_config.retryMaxDelayMs; ++i)
+            {
+                delayMs *= 2;
+            }
+            return std::chrono::milliseconds((std::min)(delayMs, m_config.retryMaxDelayMs));
+        }
+    }
+}
@@ -0,0 +1,366 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/glacier-transfer/GlacierTransferManager.h>
+#include <aws/core/auth/AWSCredentials.h>
+#include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/StringUtils.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <aws/glacier/GlacierClient.h>
+#include <aws/glacier/model/UploadArchiveRequest.h>
+#include <aws/glacier/model/InitiateMultipartUploadRequest.h>
+#include <aws/glacier/model/UploadMultipartPartRequest.h>
+#include <aws/glacier/model/CompleteMultipartUploadRequest.h>
+#include <aws/glacier/model/AbortMultipartUploadRequest.h>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+using namespace Aws::GlacierTransfer;
+using namespace Aws::Glacier;
+using namespace Aws::Glacier::Model;
+using namespace Aws::Client;
+using namespace Aws::Utils;
+
+static const char ALLOCATION_TAG[] = "GlacierTransferManagerTest";
+static const char VAULT_NAME[] = "test-vault";
+static const char UPLOAD_ID[] = "test-upload-id";
+
+namespace
+{
+    Aws::String ReadBody(const std::shared_ptr<Aws::IOStream>& body)
+    {
+        Aws::StringStream ss;
+        ss << body->rdbuf();
+        return ss.str();
+    }
+
+    /**
+     * Local stand-in for Glacier: keeps what was uploaded and checks every checksum it is sent the way the service does.
+     */
+    class MockGlacierClient : public GlacierClient
+    {
+    public:
+        MockGlacierClient() : GlacierClient(Aws::Auth::AWSCredentials("", ""), ClientConfiguration()),
+            m_latencyMs(0), m_failPartIndex(-1), m_inFlight(0), m_maxInFlight(0), m_singleUploads(0), m_aborts(0), m_checksumMismatches(0)
+        {
+        }
+
+        UploadArchiveOutcome UploadArchive(const UploadArchiveRequest& request) const override
+        {
+            Aws::String body = ReadBody(request.GetBody());
+            std::lock_guard<std::mutex> locker(m_mutex);
+            ++m_singleUploads;
+            m_archive = body;
+            if (request.GetChecksum() != HashingUtils::HexEncode(HashingUtils::CalculateSHA256TreeHash(body)))
+            {
+                ++m_checksumMismatches;
+            }
+            UploadArchiveResult result;
+            result.SetArchiveId("single-archive-id");
+            result.SetChecksum(request.GetChecksum());
+            return result;
+        }
+
+        InitiateMultipartUploadOutcome InitiateMultipartUpload(const InitiateMultipartUploadRequest& request) const override
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_partSize = request.GetPartSize();
+            InitiateMultipartUploadResult result;
+            result.SetUploadId(UPLOAD_ID);
+            return result;
+        }
+
+        UploadMultipartPartOutcome UploadMultipartPart(const UploadMultipartPartRequest& request) const override
+        {
+            Aws::String body = ReadBody(request.GetBody());
+            {
+                std::lock_guard<std::mutex> locker(m_mutex);
+                m_maxInFlight = (std::max)(m_maxInFlight, ++m_inFlight);
+            }
+
+            if (m_latencyMs > 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(m_latencyMs));
+            }
+
+            std::lock_guard<std::mutex> locker(m_mutex);
+            --m_inFlight;
+            size_t start = static_cast<size_t>(std::stoull(request.GetRange().substr(strlen("bytes "))));
+            if (m_failPartIndex >= 0 && start == static_cast<size_t>(m_failPartIndex) * body.size())
+            {
+                return GlacierError(AWSError<CoreErrors>(CoreErrors::SERVICE_UNAVAILABLE, "ServiceUnavailable", "Injected failure", true));
+            }
+            if (request.GetChecksum() != HashingUtils::HexEncode(HashingUtils::CalculateSHA256TreeHash(body)))
+            {
+                ++m_checksumMismatches;
+            }
+            m_ranges[start] = request.GetRange();
+            m_parts[start] = body;
+            UploadMultipartPartResult result;
+            result.SetChecksum(request.GetChecksum());
+            return result;
+        }
+
+        CompleteMultipartUploadOutcome CompleteMultipartUpload(const CompleteMultipartUploadRequest& request) const override
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_archive.clear();
+            for (const auto& part : m_parts)
+            {
+                m_archive += part.second;
+            }
+            m_completedArchiveSize = request.GetArchiveSize();
+            if (request.GetChecksum() != HashingUtils::HexEncode(HashingUtils::CalculateSHA256TreeHash(m_archive)))
+            {
+                ++m_checksumMismatches;
+            }
+            CompleteMultipartUploadResult result;
+            result.SetArchiveId("multipart-archive-id");
+            result.SetChecksum(request.GetChecksum());
+            return result;
+        }
+
+        AbortMultipartUploadOutcome AbortMultipartUpload(const AbortMultipartUploadRequest&) const override
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            ++m_aborts;
+            return AbortMultipartUploadOutcome(Aws::NoResult());
+        }
+
+        size_t m_latencyMs;
+        int m_failPartIndex;
+
+        mutable std::mutex m_mutex;
+        mutable size_t m_inFlight;
+        mutable size_t m_maxInFlight;
+        mutable size_t m_singleUploads;
+        mutable size_t m_aborts;
+        mutable size_t m_checksumMismatches;
+        mutable Aws::String m_partSize;
+        mutable Aws::String m_completedArchiveSize;
+        mutable Aws::String m_archive;
+        mutable Aws::Map<size_t, Aws::String> m_parts;
+        mutable Aws::Map<size_t, Aws::String> m_ranges;
+    };
+
+    Aws::String MakeArchive(size_t length)
+    {
+        Aws::String archive(length, '\0');
+        for (size_t i = 0; i < length; ++i)
+        {
+            archive[i] = static_cast<char>((i * 31 + i / 4093) & 0xFF);
+        }
+        return archive;
+    }
+
+    /**
+     * Empty stream that reports a size of its own when measured, standing in for archives too large to build in memory.
+     */
+    class SizedStreamBuf : public std::streambuf
+    {
+    public:
+        SizedStreamBuf(uint64_t size) : m_size(static_cast<std::streamoff>(size)), m_position(0) {}
+
+    protected:
+        std::streampos seekoff(std::streamoff off, std::ios_base::seekdir dir, std::ios_base::openmode) override
+        {
+            m_position = off + (dir == std::ios_base::end ? m_size : dir == std::ios_base::cur ? m_position : 0);
+            return m_position;
+        }
+
+        std::streampos seekpos(std::streampos pos, std::ios_base::openmode) override
+        {
+            m_position = pos;
+            return m_position;
+        }
+
+    private:
+        std::streamoff m_size;
+        std::streamoff m_position;
+    };
+
+    class GlacierTransferManagerTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_executor = Aws::MakeShared<Threading::PooledThreadExecutor>(ALLOCATION_TAG, 4);
+            m_client = Aws::MakeShared<MockGlacierClient>(ALLOCATION_TAG);
+        }
+
+        GlacierTransferManagerConfiguration MakeConfig(uint64_t partSize, uint64_t heapSize)
+        {
+            GlacierTransferManagerConfiguration config(m_executor.get());
+            config.glacierClient = m_client;
+            config.partSize = partSize;
+            config.transferBufferMaxHeapSize = heapSize;
+            return config;
+        }
+
+        ArchiveUploadOutcome Upload(GlacierTransferManager& manager, const Aws::String& archive)
+        {
+            auto stream = Aws::MakeShared<Aws::StringStream>(ALLOCATION_TAG, archive);
+            return manager.UploadArchive(VAULT_NAME, stream);
+        }
+
+        std::shared_ptr<Threading::PooledThreadExecutor> m_executor;
+        std::shared_ptr<MockGlacierClient> m_client;
+    };
+}
+
+TEST_F(GlacierTransferManagerTest, TestSmallArchiveUsesSingleUpload)
+{
+    GlacierTransferManager manager(MakeConfig(MB1, 4 * MB1));
+    Aws::String archive = MakeArchive(static_cast<size_t>(MB1 / 2 + 17));
+
+    auto outcome = Upload(manager, archive);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(0u, outcome.GetResult().partCount);
+    ASSERT_EQ(archive.size(), outcome.GetResult().archiveSize);
+    ASSERT_EQ("single-archive-id", outcome.GetResult().archiveId);
+    ASSERT_EQ(HashingUtils::HexEncode(HashingUtils::CalculateSHA256TreeHash(archive)), outcome.GetResult().checksum);
+    ASSERT_EQ(1u, m_client->m_singleUploads);
+    ASSERT_EQ(0u, m_client->m_checksumMismatches);
+    ASSERT_EQ(archive, m_client->m_archive);
+}
+
+TEST_F(GlacierTransferManagerTest, TestArchiveOfExactlyOnePartUsesSingleUpload)
+{
+    GlacierTransferManager manager(MakeConfig(MB1, 4 * MB1));
+    Aws::String archive = MakeArchive(static_cast<size_t>(MB1));
+
+    auto outcome = Upload(manager, archive);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(0u, outcome.GetResult().partCount);
+    ASSERT_EQ(1u, m_client->m_singleUploads);
+    ASSERT_EQ(archive, m_client->m_archive);
+}
+
+TEST_F(GlacierTransferManagerTest, TestEmptyArchive)
+{
+    GlacierTransferManager manager(MakeConfig(MB1, 4 * MB1));
+
+    auto outcome = Upload(manager, "");
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(0u, outcome.GetResult().archiveSize);
+    ASSERT_EQ(HashingUtils::HexEncode(HashingUtils::CalculateSHA256("")), outcome.GetResult().checksum);
+    ASSERT_EQ(0u, m_client->m_checksumMismatches);
+}
+
+TEST_F(GlacierTransferManagerTest, TestMultipartUploadRangesAndTreeHash)
+{
+    GlacierTransferManager manager(MakeConfig(2 * MB1, 8 * MB1));
+    Aws::String archive = MakeArchive(static_cast<size_t>(7 * MB1 + MB1 / 2 + 3));
+
+    auto outcome = Upload(manager, archive);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(4u, outcome.GetResult().partCount);
+    ASSERT_EQ(archive.size(), outcome.GetResult().archiveSize);
+    ASSERT_EQ("multipart-archive-id", outcome.GetResult().archiveId);
+    ASSERT_EQ(HashingUtils::HexEncode(HashingUtils::CalculateSHA256TreeHash(archive)), outcome.GetResult().checksum);
+
+    ASSERT_EQ(0u, m_client->m_singleUploads);
+    ASSERT_EQ(0u, m_client->m_aborts);
+    ASSERT_EQ(0u, m_client->m_checksumMismatches);
+    ASSERT_EQ("2097152", m_client->m_partSize);
+    ASSERT_EQ(Aws::Utils::StringUtils::to_string(archive.size()), m_client->m_completedArchiveSize);
+    ASSERT_EQ(archive, m_client->m_archive);
+
+    ASSERT_EQ(4u, m_client->m_ranges.size());
+    ASSERT_EQ("bytes 0-2097151/*", m_client->m_ranges[0]);
+    ASSERT_EQ("bytes 2097152-4194303/*", m_client->m_ranges[2097152]);
+    ASSERT_EQ("bytes 4194304-6291455/*", m_client->m_ranges[4194304]);
+    ASSERT_EQ("bytes 6291456-7864322/*", m_client->m_ranges[6291456]);
+}
+
+TEST_F(GlacierTransferManagerTest, TestArchiveOfWholePartsHasNoEmptyTrailingPart)
+{
+    GlacierTransferManager manager(MakeConfig(MB1, 4 * MB1));
+    Aws::String archive = MakeArchive(static_cast<size_t>(3 * MB1));
+
+    auto outcome = Upload(manager, archive);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(3u, outcome.GetResult().partCount);
+    ASSERT_EQ(3u, m_client->m_parts.size());
+    ASSERT_EQ(0u, m_client->m_checksumMismatches);
+    ASSERT_EQ(archive, m_client->m_archive);
+}
+
+TEST_F(GlacierTransferManagerTest, TestPartSizeIsRoundedDownToPowerOfTwoMegabytes)
+{
+    GlacierTransferManager manager(MakeConfig(3 * MB1, 8 * MB1));
+    ASSERT_EQ(2 * MB1, manager.GetConfiguration().partSize);
+
+    GlacierTransferManager tooSmall(MakeConfig(1000, 8 * MB1));
+    ASSERT_EQ(MB1, tooSmall.GetConfiguration().partSize);
+}
+
+TEST_F(GlacierTransferManagerTest, TestPartsUploadConcurrently)
+{
+    m_client->m_latencyMs = 50;
+    GlacierTransferManager manager(MakeConfig(MB1, 4 * MB1));
+    Aws::String archive = MakeArchive(static_cast<size_t>(8 * MB1));
+
+    auto outcome = Upload(manager, archive);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(8u, outcome.GetResult().partCount);
+    ASSERT_GT(m_client->m_maxInFlight, 1u);
+    ASSERT_EQ(archive, m_client->m_archive);
+}
+
+TEST_F(GlacierTransferManagerTest, TestPartsInFlightAreBoundedByBuffers)
+{
+    m_client->m_latencyMs = 20;
+    GlacierTransferManager manager(MakeConfig(MB1, 2 * MB1));
+    Aws::String archive = MakeArchive(static_cast<size_t>(8 * MB1));
+
+    auto outcome = Upload(manager, archive);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_LE(m_client->m_maxInFlight, 2u);
+    ASSERT_EQ(0u, m_client->m_checksumMismatches);
+    ASSERT_EQ(archive, m_client->m_archive);
+}
+
+TEST_F(GlacierTransferManagerTest, TestPartFailureAbortsUpload)
+{
+    m_client->m_failPartIndex = 1;
+    GlacierTransferManager manager(MakeConfig(MB1, 4 * MB1));
+    Aws::String archive = MakeArchive(static_cast<size_t>(6 * MB1));
+
+    auto outcome = Upload(manager, archive);
+    ASSERT_FALSE(outcome.IsSuccess());
+    ASSERT_EQ(GlacierErrors::SERVICE_UNAVAILABLE, outcome.GetError().GetErrorType());
+    ASSERT_EQ(1u, m_client->m_aborts);
+    ASSERT_TRUE(m_client->m_completedArchiveSize.empty());
+
+    // The manager is still usable once its buffers are back.
+    m_client->m_failPartIndex = -1;
+    outcome = Upload(manager, archive);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(archive, m_client->m_archive);
+}
+
+TEST_F(GlacierTransferManagerTest, TestArchiveNeedingTooManyPartsIsRejected)
+{
+    GlacierTransferManager manager(MakeConfig(MB1, 4 * MB1));
+
+    SizedStreamBuf streamBuf(10000 * MB1 + 1);
+    auto outcome = manager.UploadArchive(VAULT_NAME, Aws::MakeShared<Aws::IOStream>(ALLOCATION_TAG, &streamBuf));
+    ASSERT_FALSE(outcome.IsSuccess());
+    ASSERT_EQ("ArchiveTooLarge", outcome.GetError().GetExceptionName());
+    ASSERT_TRUE(m_client->m_partSize.empty());
+    ASSERT_EQ(0u, m_client->m_singleUploads);
+
+    // Exactly 10,000 parts is within the limit; nothing is read from this stream, which uploads as an empty archive.
+    SizedStreamBuf largestBuf(10000 * MB1);
+    outcome = manager.UploadArchive(VAULT_NAME, Aws::MakeShared<Aws::IOStream>(ALLOCATION_TAG, &largestBuf));
+    ASSERT_TRUE(outcome.IsSuccess());
+}
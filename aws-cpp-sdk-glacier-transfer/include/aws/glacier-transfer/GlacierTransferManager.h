@@ -0,0 +1,137 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/glacier-transfer/GlacierTransfer_EXPORTS.h>
+#include <aws/glacier/GlacierErrors.h>
+#include <aws/core/utils/Outcome.h>
+#include <aws/core/utils/ResourceManager.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <memory>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Threading
+        {
+            class Executor;
+        }
+    }
+
+    namespace Glacier
+    {
+        class GlacierClient;
+    }
+
+    namespace GlacierTransfer
+    {
+        const uint64_t MB1 = 1024 * 1024;
+
+        /**
+         * Configuration for use with GlacierTransferManager. The data here will be copied directly to GlacierTransferManager.
+         */
+        struct GlacierTransferManagerConfiguration
+        {
+            GlacierTransferManagerConfiguration(Aws::Utils::Threading::Executor* executor) :
+                glacierClient(nullptr), transferExecutor(executor), accountId("-"), partSize(8 * MB1), transferBufferMaxHeapSize(64 * MB1)
+            {
+            }
+
+            /**
+             * Glacier Client to use for transfers. You are responsible for setting this.
+             */
+            std::shared_ptr<Aws::Glacier::GlacierClient> glacierClient;
+            /**
+             * Executor parts are hashed and uploaded on. Its pool size bounds the number of parts in flight.
+             * It must not run tasks on the submitting thread.
+             */
+            Aws::Utils::Threading::Executor* transferExecutor;
+            /**
+             * Account owning the vaults, or "-" for the account of the client's credentials.
+             */
+            Aws::String accountId;
+            /**
+             * Size of each part of a multipart upload. Glacier requires a power of two number of megabytes between 1 MB and 4 GB;
+             * other values are rounded down to the nearest valid size. Archives no larger than partSize are uploaded with a
+             * single UploadArchive call. A multipart upload takes at most 10,000 parts, so larger archives need a larger partSize.
+             */
+            uint64_t partSize;
+            /**
+             * Maximum memory used for part buffers. Each buffer holds one part, and at least one buffer is always allocated.
+             * It should be at least partSize times the number of parts you want uploaded concurrently.
+             */
+            uint64_t transferBufferMaxHeapSize;
+        };
+
+        /**
+         * Result of a successful GlacierTransferManager::UploadArchive.
+         */
+        struct ArchiveUploadResult
+        {
+            ArchiveUploadResult() : archiveSize(0), partCount(0) {}
+
+            Aws::String archiveId;
+            Aws::String location;
+            /** Hex encoded SHA256 tree hash of the whole archive. */
+            Aws::String checksum;
+            uint64_t archiveSize;
+            /** Number of parts uploaded, or 0 if the archive was uploaded with a single UploadArchive call. */
+            size_t partCount;
+        };
+
+        typedef Aws::Utils::Outcome<ArchiveUploadResult, Aws::Glacier::GlacierError> ArchiveUploadOutcome;
+
+        /**
+         * Uploads archives to Amazon S3 Glacier, using multipart uploads for archives larger than one part.
+         *
+         * The archive stream is read once, sequentially, on the calling thread, one part at a time into buffers taken from a
+         * fixed pool. Each part is then handed to the executor, which computes its SHA256 tree hash from the buffer and uploads
+         * it from the same buffer; parts are hashed and uploaded concurrently. Because parts are a power of two number of
+         * megabytes, the tree hash of the whole archive is combined from the part tree hashes without reading the data again.
+         */
+        class AWS_GLACIER_TRANSFER_API GlacierTransferManager
+        {
+        public:
+            GlacierTransferManager(const GlacierTransferManagerConfiguration& config);
+
+            /**
+             * Waits for all buffers to be returned and frees them.
+             */
+            ~GlacierTransferManager();
+
+            GlacierTransferManager(const GlacierTransferManager&) = delete;
+            GlacierTransferManager& operator=(const GlacierTransferManager&) = delete;
+
+            /**
+             * Uploads archiveStream, from its current position to its end, to vaultName. Blocks until the archive has been
+             * uploaded or the upload failed; a failed multipart upload is aborted.
+             * An archive that needs more than 10,000 parts fails with an "ArchiveTooLarge" error: right away if archiveStream
+             * is seekable, otherwise once the 10,000 parts have been read, aborting the upload.
+             */
+            ArchiveUploadOutcome UploadArchive(const Aws::String& vaultName, const std::shared_ptr<Aws::IOStream>& archiveStream,
+                const Aws::String& archiveDescription = "");
+
+            inline const GlacierTransferManagerConfiguration& GetConfiguration() const { return m_transferConfig; }
+
+        private:
+            struct MultipartUploadState;
+
+            ArchiveUploadOutcome DoSinglePartUpload(const Aws::String& vaultName, const Aws::String& archiveDescription,
+                unsigned char* buffer, uint64_t length);
+            ArchiveUploadOutcome DoMultipartUpload(const Aws::String& vaultName, Aws::IOStream& archiveStream,
+                const Aws::String& archiveDescription, unsigned char* firstBuffer, uint64_t firstLength);
+            void UploadPart(const std::shared_ptr<MultipartUploadState>& state, size_t partIndex, unsigned char* buffer,
+                uint64_t offset, uint64_t length);
+            uint64_t ReadPart(Aws::IOStream& archiveStream, unsigned char* buffer);
+
+            GlacierTransferManagerConfiguration m_transferConfig;
+            Aws::Utils::ExclusiveOwnershipResourceManager<unsigned char*> m_bufferManager;
+            size_t m_bufferCount;
+        };
+    }
+}
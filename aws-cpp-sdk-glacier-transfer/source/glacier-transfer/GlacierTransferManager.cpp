@@ -0,0 +1,353 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/glacier-transfer/GlacierTransferManager.h>
+#include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/StringUtils.h>
+#include <aws/core/utils/crypto/Sha256.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <aws/core/utils/stream/PreallocatedStreamBuf.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <aws/glacier/GlacierClient.h>
+#include <aws/glacier/model/UploadArchiveRequest.h>
+#include <aws/glacier/model/InitiateMultipartUploadRequest.h>
+#include <aws/glacier/model/UploadMultipartPartRequest.h>
+#include <aws/glacier/model/CompleteMultipartUploadRequest.h>
+#include <aws/glacier/model/AbortMultipartUploadRequest.h>
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
+
+using namespace Aws::Glacier;
+using namespace Aws::Glacier::Model;
+using namespace Aws::Utils;
+
+namespace Aws
+{
+    namespace GlacierTransfer
+    {
+        static const char CLASS_TAG[] = "GlacierTransferManager";
+        static const uint64_t MAX_PART_SIZE = 4096 * MB1;
+        static const size_t MAX_PARTS = 10000;
+
+        struct GlacierTransferManager::MultipartUploadState
+        {
+            MultipartUploadState() : pendingParts(0), failed(false) {}
+
+            Aws::String vaultName;
+            Aws::String uploadId;
+            std::mutex mutex;
+            std::condition_variable partCompleted;
+            Aws::Vector<ByteBuffer> partTreeHashes;
+            size_t pendingParts;
+            bool failed;
+            GlacierError error;
+        };
+
+        // Glacier tree hashes are built from the SHA256 of every megabyte; hash each one straight from the part buffer.
+        static ByteBuffer CalculatePartTreeHash(unsigned char* buffer, uint64_t length)
+        {
+            Crypto::Sha256 hash;
+            Aws::Vector<ByteBuffer> hashes;
+            hashes.reserve(static_cast<size_t>((length + MB1 - 1) / MB1));
+            for (uint64_t offset = 0; offset < length; offset += MB1)
+            {
+                Stream::PreallocatedStreamBuf streamBuf(buffer + offset, (std::min)(MB1, length - offset));
+                Aws::IOStream chunk(&streamBuf);
+                hashes.push_back(hash.Calculate(chunk).GetResult());
+            }
+            return HashingUtils::CombineSHA256TreeHashes(hashes);
+        }
+
+        static GlacierError MakeStreamReadError()
+        {
+            return GlacierError(Aws::Client::AWSError<Aws::Client::CoreErrors>(Aws::Client::CoreErrors::INTERNAL_FAILURE,
+                "ArchiveStreamReadError", "Failed to read the archive stream.", false));
+        }
+
+        static GlacierError MakeTooManyPartsError(uint64_t partSize)
+        {
+            return GlacierError(Aws::Client::AWSError<Aws::Client::CoreErrors>(Aws::Client::CoreErrors::VALIDATION, "ArchiveTooLarge",
+                "The archive needs more than " + StringUtils::to_string(MAX_PARTS) + " parts of " + StringUtils::to_string(partSize) +
+                " bytes, the most a multipart upload takes. Use a larger partSize.", false));
+        }
+
+        GlacierTransferManager::GlacierTransferManager(const GlacierTransferManagerConfiguration& config) :
+            m_transferConfig(config), m_bufferCount(0)
+        {
+            assert(m_transferConfig.glacierClient);
+            assert(m_transferConfig.transferExecutor);
+
+            uint64_t partSize = MB1;
+            while (partSize * 2 <= (std::min)(m_transferConfig.partSize, MAX_PART_SIZE))
+            {
+                partSize *= 2;
+            }
+            m_transferConfig.partSize = partSize;
+
+            m_bufferCount = static_cast<size_t>((std::max)(m_transferConfig.transferBufferMaxHeapSize / partSize, static_cast<uint64_t>(1)));
+            for (size_t i = 0; i < m_bufferCount; ++i)
+            {
+                m_bufferManager.PutResource(Aws::NewArray<unsigned char>(static_cast<size_t>(partSize), CLASS_TAG));
+            }
+        }
+
+        GlacierTransferManager::~GlacierTransferManager()
+        {
+            for (auto buffer : m_bufferManager.ShutdownAndWait(m_bufferCount))
+            {
+                Aws::DeleteArray(buffer);
+            }
+        }
+
+        ArchiveUploadOutcome GlacierTransferManager::UploadArchive(const Aws::String& vaultName, const std::shared_ptr<Aws::IOStream>& archiveStream,
+            const Aws::String& archiveDescription)
+        {
+            assert(archiveStream);
+
+            // Measure seekable streams, so that an archive needing too many parts is rejected before anything is uploaded.
+            const std::streampos start = archiveStream->tellg();
+            if (start != std::streampos(-1))
+            {
+                archiveStream->seekg(0, std::ios_base::end);
+                const std::streampos end = archiveStream->tellg();
+                archiveStream->clear();
+                archiveStream->seekg(start);
+                if (end != std::streampos(-1) && static_cast<uint64_t>(end - start) > MAX_PARTS * m_transferConfig.partSize)
+                {
+                    return MakeTooManyPartsError(m_transferConfig.partSize);
+                }
+            }
+
+            auto buffer = m_bufferManager.Acquire();
+            uint64_t length = ReadPart(*archiveStream, buffer);
+            if (archiveStream->bad())
+            {
+                m_bufferManager.Release(buffer);
+                return MakeStreamReadError();
+            }
+
+            if (length < m_transferConfig.partSize || archiveStream->peek() == std::char_traits<char>::eof())
+            {
+                auto outcome = DoSinglePartUpload(vaultName, archiveDescription, buffer, length);
+                m_bufferManager.Release(buffer);
+                return outcome;
+            }
+
+            return DoMultipartUpload(vaultName, *archiveStream, archiveDescription, buffer, length);
+        }
+
+        ArchiveUploadOutcome GlacierTransferManager::DoSinglePartUpload(const Aws::String& vaultName, const Aws::String& archiveDescription,
+            unsigned char* buffer, uint64_t length)
+        {
+            Aws::String checksum = HashingUtils::HexEncode(CalculatePartTreeHash(buffer, length));
+
+            Stream::PreallocatedStreamBuf streamBuf(buffer, length);
+            UploadArchiveRequest request;
+            request.SetAccountId(m_transferConfig.accountId);
+            request.SetVaultName(vaultName);
+            if (!archiveDescription.empty())
+            {
+                request.SetArchiveDescription(archiveDescription);
+            }
+            request.SetChecksum(checksum);
+            request.SetBody(Aws::MakeShared<Aws::IOStream>(CLASS_TAG, &streamBuf));
+
+            auto outcome = m_transferConfig.glacierClient->UploadArchive(request);
+            if (!outcome.IsSuccess())
+            {
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "UploadArchive to vault " << vaultName << " failed: " << outcome.GetError().GetMessage());
+                return outcome.GetError();
+            }
+
+            ArchiveUploadResult result;
+            result.archiveId = outcome.GetResult().GetArchiveId();
+            result.location = outcome.GetResult().GetLocation();
+            result.checksum = checksum;
+            result.archiveSize = length;
+            return result;
+        }
+
+        ArchiveUploadOutcome GlacierTransferManager::DoMultipartUpload(const Aws::String& vaultName, Aws::IOStream& archiveStream,
+            const Aws::String& archiveDescription, unsigned char* firstBuffer, uint64_t firstLength)
+        {
+            InitiateMultipartUploadRequest initiateRequest;
+            initiateRequest.SetAccountId(m_transferConfig.accountId);
+            initiateRequest.SetVaultName(vaultName);
+            if (!archiveDescription.empty())
+            {
+                initiateRequest.SetArchiveDescription(archiveDescription);
+            }
+            initiateRequest.SetPartSize(StringUtils::to_string(m_transferConfig.partSize));
+
+            auto initiateOutcome = m_transferConfig.glacierClient->InitiateMultipartUpload(initiateRequest);
+            if (!initiateOutcome.IsSuccess())
+            {
+                m_bufferManager.Release(firstBuffer);
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "InitiateMultipartUpload on vault " << vaultName << " failed: " << initiateOutcome.GetError().GetMessage());
+                return initiateOutcome.GetError();
+            }
+
+            auto state = Aws::MakeShared<MultipartUploadState>(CLASS_TAG);
+            state->vaultName = vaultName;
+            state->uploadId = initiateOutcome.GetResult().GetUploadId();
+
+            // Parts are read here, in order, and hashed and uploaded on the executor. Acquire blocks once every buffer is taken,
+            // which bounds memory and keeps reading from getting ahead of the uploads.
+            unsigned char* buffer = firstBuffer;
+            uint64_t length = firstLength;
+            uint64_t offset = 0;
+            size_t partIndex = 0;
+            bool readFailed = false;
+            bool tooManyParts = false;
+            for (;;)
+            {
+                {
+                    std::lock_guard<std::mutex> locker(state->mutex);
+                    state->partTreeHashes.emplace_back();
+                    ++state->pendingParts;
+                }
+
+                uint64_t partOffset = offset;
+                if (!m_transferConfig.transferExecutor->Submit([this, state, partIndex, buffer, partOffset, length]()
+                    {
+                        UploadPart(state, partIndex, buffer, partOffset, length);
+                    }))
+                {
+                    UploadPart(state, partIndex, buffer, partOffset, length);
+                }
+                offset += length;
+                ++partIndex;
+
+                if (length < m_transferConfig.partSize)
+                {
+                    break;
+                }
+                {
+                    std::lock_guard<std::mutex> locker(state->mutex);
+                    if (state->failed)
+                    {
+                        break;
+                    }
+                }
+                // Streams that couldn't be measured are only found to be too large here.
+                if (partIndex == MAX_PARTS)
+                {
+                    tooManyParts = archiveStream.peek() != std::char_traits<char>::eof();
+                    readFailed = archiveStream.bad();
+                    break;
+                }
+
+                buffer = m_bufferManager.Acquire();
+                length = ReadPart(archiveStream, buffer);
+                if (archiveStream.bad() || length == 0)
+                {
+                    readFailed = archiveStream.bad();
+                    m_bufferManager.Release(buffer);
+                    break;
+                }
+            }
+
+            std::unique_lock<std::mutex> locker(state->mutex);
+            state->partCompleted.wait(locker, [&]() { return state->pendingParts == 0; });
+
+            GlacierError error;
+            bool failed = readFailed || tooManyParts || state->failed;
+            if (failed)
+            {
+                error = readFailed ? MakeStreamReadError() : tooManyParts ? MakeTooManyPartsError(m_transferConfig.partSize) : state->error;
+            }
+            else
+            {
+                Aws::String checksum = HashingUtils::HexEncode(HashingUtils::CombineSHA256TreeHashes(state->partTreeHashes));
+
+                CompleteMultipartUploadRequest completeRequest;
+                completeRequest.SetAccountId(m_transferConfig.accountId);
+                completeRequest.SetVaultName(vaultName);
+                completeRequest.SetUploadId(state->uploadId);
+                completeRequest.SetArchiveSize(StringUtils::to_string(offset));
+                completeRequest.SetChecksum(checksum);
+
+                auto completeOutcome = m_transferConfig.glacierClient->CompleteMultipartUpload(completeRequest);
+                if (completeOutcome.IsSuccess())
+                {
+                    ArchiveUploadResult result;
+                    result.archiveId = completeOutcome.GetResult().GetArchiveId();
+                    result.location = completeOutcome.GetResult().GetLocation();
+                    result.checksum = checksum;
+                    result.archiveSize = offset;
+                    result.partCount = partIndex;
+                    return result;
+                }
+                error = completeOutcome.GetError();
+            }
+
+            AWS_LOGSTREAM_ERROR(CLASS_TAG, "Multipart upload " << state->uploadId << " to vault " << vaultName
+                    << " failed, aborting it: " << error.GetMessage());
+            AbortMultipartUploadRequest abortRequest;
+            abortRequest.SetAccountId(m_transferConfig.accountId);
+            abortRequest.SetVaultName(vaultName);
+            abortRequest.SetUploadId(state->uploadId);
+            auto abortOutcome = m_transferConfig.glacierClient->AbortMultipartUpload(abortRequest);
+            if (!abortOutcome.IsSuccess())
+            {
+                AWS_LOGSTREAM_WARN(CLASS_TAG, "Failed to abort multipart upload " << state->uploadId << ": " << abortOutcome.GetError().GetMessage());
+            }
+            return error;
+        }
+
+        void GlacierTransferManager::UploadPart(const std::shared_ptr<MultipartUploadState>& state, size_t partIndex, unsigned char* buffer,
+            uint64_t offset, uint64_t length)
+        {
+            bool skip = false;
+            {
+                std::lock_guard<std::mutex> locker(state->mutex);
+                skip = state->failed;
+            }
+
+            ByteBuffer treeHash;
+            UploadMultipartPartOutcome outcome;
+            if (!skip)
+            {
+                treeHash = CalculatePartTreeHash(buffer, length);
+
+                Stream::PreallocatedStreamBuf streamBuf(buffer, length);
+                UploadMultipartPartRequest request;
+                request.SetAccountId(m_transferConfig.accountId);
+                request.SetVaultName(state->vaultName);
+                request.SetUploadId(state->uploadId);
+                request.SetChecksum(HashingUtils::HexEncode(treeHash));
+                request.SetRange("bytes " + StringUtils::to_string(offset) + "-" + StringUtils::to_string(offset + length - 1) + "/*");
+                request.SetBody(Aws::MakeShared<Aws::IOStream>(CLASS_TAG, &streamBuf));
+                outcome = m_transferConfig.glacierClient->UploadMultipartPart(request);
+            }
+            m_bufferManager.Release(buffer);
+
+            std::lock_guard<std::mutex> locker(state->mutex);
+            if (outcome.IsSuccess())
+            {
+                state->partTreeHashes[partIndex] = std::move(treeHash);
+            }
+            else if (!state->failed && !skip)
+            {
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Uploading part " << partIndex << " of multipart upload " << state->uploadId
+                        << " failed: " << outcome.GetError().GetMessage());
+                state->failed = true;
+                state->error = outcome.GetError();
+            }
+            --state->pendingParts;
+            state->partCompleted.notify_all();
+        }
+
+        uint64_t GlacierTransferManager::ReadPart(Aws::IOStream& archiveStream, unsigned char* buffer)
+        {
+            archiveStream.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(m_transferConfig.partSize));
+            return static_cast<uint64_t>(archiveStream.gcount());
+        }
+    }
+}
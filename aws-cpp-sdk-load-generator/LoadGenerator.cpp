@@ -0,0 +1,405 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/load-generator/MockServer.h>
+#include <aws/load-generator/Workload.h>
+#include <aws/core/Aws.h>
+#include <aws/core/Version.h>
+#include <aws/core/platform/OSVersionInfo.h>
+#include <aws/core/utils/DateTime.h>
+#include <aws/core/utils/json/JsonSerializer.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <time.h>
+
+using namespace Aws::LoadGenerator;
+using namespace Aws::Utils;
+using namespace Aws::Utils::Json;
+
+struct LoadOptions
+{
+    LoadOptions() : service("s3"), operation("read"), concurrency(16), durationS(10), warmupS(1), payloadBytes(1024),
+        latencyMs(0), errorRate(0.0), port(0), serveOnly(false) {}
+
+    std::string service;
+    std::string operation;
+    long concurrency;
+    long durationS;
+    long warmupS;
+    long payloadBytes;
+    long latencyMs;
+    double errorRate;
+    std::string endpoint;
+    long port;
+    bool serveOnly;
+    std::string jsonPath;
+    std::string label;
+};
+
+struct WorkerResult
+{
+    WorkerResult() : successes(0), failures(0), cpuNanos(0) {}
+
+    std::vector<int64_t> latenciesNanos;
+    uint64_t successes;
+    uint64_t failures;
+    int64_t cpuNanos;
+};
+
+struct LoadResult
+{
+    LoadResult() : requests(0), failures(0), seconds(0), cpuNanos(0) {}
+
+    std::vector<int64_t> latenciesNanos;
+    uint64_t requests;
+    uint64_t failures;
+    double seconds;
+    int64_t cpuNanos;
+};
+
+static void PrintUsage(const char* program)
+{
+    printf("Usage: %s [options]\n"
+           "  --service=<name>        s3, dynamodb or sqs. Defaults to s3.\n"
+           "  --operation=<name>      read, write or mixed (half of each). Defaults to read.\n"
+           "  --concurrency=<n>       Threads calling the client concurrently. Defaults to 16.\n"
+           "  --duration-s=<s>        Measured duration. Defaults to 10.\n"
+           "  --warmup-s=<s>          Unmeasured duration before the measurement. Defaults to 1.\n"
+           "  --payload-bytes=<n>     Size of the payloads read and written. Defaults to 1024.\n"
+           "  --latency-ms=<ms>       Server-side latency of every response. Defaults to 0.\n"
+           "  --error-rate=<ratio>    Fraction of responses, between 0 and 1, that are retryable errors. Defaults to 0.\n"
+           "  --port=<port>           Port of the mock server. Defaults to a free port.\n"
+           "  --endpoint=<host:port>  Send to an already running mock server instead of starting one.\n"
+           "  --serve-only            Only run the mock server, until stdin is closed, e.g. to drive it from another process.\n"
+           "  --json=<path>           Also write the results as JSON to path, for comparison across commits.\n"
+           "  --label=<text>          Free-form label recorded in the JSON output, e.g. a commit id.\n", program);
+}
+
+static bool ParseOptions(int argc, char** argv, LoadOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const size_t equals = arg.find('=');
+        const std::string name = arg.substr(0, equals);
+        const std::string value = equals == std::string::npos ? std::string() : arg.substr(equals + 1);
+        if (name == "--service")
+        {
+            options.service = value;
+        }
+        else if (name == "--operation")
+        {
+            options.operation = value;
+        }
+        else if (name == "--concurrency")
+        {
+            options.concurrency = std::strtol(value.c_str(), nullptr, 10);
+        }
+        else if (name == "--duration-s")
+        {
+            options.durationS = std::strtol(value.c_str(), nullptr, 10);
+        }
+        else if (name == "--warmup-s")
+        {
+            options.warmupS = std::strtol(value.c_str(), nullptr, 10);
+        }
+        else if (name == "--payload-bytes")
+        {
+            options.payloadBytes = std::strtol(value.c_str(), nullptr, 10);
+        }
+        else if (name == "--latency-ms")
+        {
+            options.latencyMs = std::strtol(value.c_str(), nullptr, 10);
+        }
+        else if (name == "--error-rate")
+        {
+            options.errorRate = std::strtod(value.c_str(), nullptr);
+        }
+        else if (name == "--port")
+        {
+            options.port = std::strtol(value.c_str(), nullptr, 10);
+        }
+        else if (name == "--endpoint")
+        {
+            options.endpoint = value;
+        }
+        else if (name == "--serve-only")
+        {
+            options.serveOnly = true;
+        }
+        else if (name == "--json")
+        {
+            options.jsonPath = value;
+        }
+        else if (name == "--label")
+        {
+            options.label = value;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return (options.operation == "read" || options.operation == "write" || options.operation == "mixed") &&
+        options.concurrency > 0 && options.durationS > 0 && options.warmupS >= 0 && options.payloadBytes >= 0 &&
+        options.latencyMs >= 0 && options.errorRate >= 0.0 && options.errorRate <= 1.0 &&
+        options.port >= 0 && options.port <= 65535;
+}
+
+// Clients are synchronous, so the CPU time of the calling thread covers signing, serialization, the http client and
+// response parsing of its calls. Time spent in the mock server, on other threads, is not counted.
+static int64_t GetThreadCpuNanos()
+{
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+static void RunWorker(const Workload& workload, const LoadOptions& options, size_t workerIndex,
+    const std::chrono::steady_clock::time_point& measureStart, const std::chrono::steady_clock::time_point& end,
+    WorkerResult& result)
+{
+    // Alternate reads and writes, starting half of the workers on each, so that mixed load is split evenly at any time.
+    bool read = options.operation == "read" || (options.operation == "mixed" && workerIndex % 2 == 0);
+    bool measuring = false;
+    int64_t cpuStart = 0;
+    for (;;)
+    {
+        auto start = std::chrono::steady_clock::now();
+        if (start >= end)
+        {
+            break;
+        }
+        if (!measuring && start >= measureStart)
+        {
+            measuring = true;
+            cpuStart = GetThreadCpuNanos();
+        }
+
+        bool success = read ? workload.Read() : workload.Write();
+        if (options.operation == "mixed")
+        {
+            read = !read;
+        }
+
+        if (measuring)
+        {
+            result.latenciesNanos.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count());
+            if (success)
+            {
+                ++result.successes;
+            }
+            else
+            {
+                ++result.failures;
+            }
+        }
+    }
+    if (measuring)
+    {
+        result.cpuNanos = GetThreadCpuNanos() - cpuStart;
+    }
+}
+
+static LoadResult RunLoad(const Workload& workload, const LoadOptions& options)
+{
+    const auto measureStart = std::chrono::steady_clock::now() + std::chrono::seconds(options.warmupS);
+    const auto end = measureStart + std::chrono::seconds(options.durationS);
+
+    std::vector<WorkerResult> workerResults(static_cast<size_t>(options.concurrency));
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < workerResults.size(); ++i)
+    {
+        workers.emplace_back(RunWorker, std::cref(workload), std::cref(options), i, std::cref(measureStart),
+            std::cref(end), std::ref(workerResults[i]));
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    // Calls in flight at the end finish after it; measure up to the last of them rather than to the deadline.
+    const auto finished = std::chrono::steady_clock::now();
+
+    LoadResult result;
+    result.seconds = std::chrono::duration<double>(finished - measureStart).count();
+    for (const auto& workerResult : workerResults)
+    {
+        result.latenciesNanos.insert(result.latenciesNanos.end(), workerResult.latenciesNanos.begin(),
+            workerResult.latenciesNanos.end());
+        result.requests += workerResult.successes + workerResult.failures;
+        result.failures += workerResult.failures;
+        result.cpuNanos += workerResult.cpuNanos;
+    }
+    std::sort(result.latenciesNanos.begin(), result.latenciesNanos.end());
+    return result;
+}
+
+static double PercentileMs(const std::vector<int64_t>& sorted, double percentile)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(percentile / 100 * static_cast<double>(sorted.size()));
+    return static_cast<double>(sorted[(std::min)(index, sorted.size() - 1)]) / 1e6;
+}
+
+static double MeanMs(const std::vector<int64_t>& latencies)
+{
+    if (latencies.empty())
+    {
+        return 0;
+    }
+    double total = 0;
+    for (auto latency : latencies)
+    {
+        total += static_cast<double>(latency);
+    }
+    return total / static_cast<double>(latencies.size()) / 1e6;
+}
+
+static double CpuMicrosPerRequest(const LoadResult& result)
+{
+    return result.requests ? static_cast<double>(result.cpuNanos) / 1e3 / static_cast<double>(result.requests) : 0;
+}
+
+static void WriteJson(const LoadResult& result, const LoadOptions& options, const MockServer* server)
+{
+    JsonValue context;
+    context.WithString("sdkVersion", Aws::Version::GetVersionString())
+           .WithString("compiler", Aws::Version::GetCompilerVersionString())
+           .WithString("os", Aws::OSVersionInfo::ComputeOSVersionString())
+           .WithInteger("hardwareConcurrency", static_cast<int>(std::thread::hardware_concurrency()))
+#ifdef NDEBUG
+           .WithString("buildType", "Release")
+#else
+           .WithString("buildType", "Debug")
+#endif
+           .WithString("date", DateTime::Now().ToGmtString(DateFormat::ISO_8601))
+           .WithString("label", options.label.c_str())
+           .WithString("service", options.service.c_str())
+           .WithString("operation", options.operation.c_str())
+           .WithInt64("concurrency", options.concurrency)
+           .WithInt64("durationS", options.durationS)
+           .WithInt64("payloadBytes", options.payloadBytes)
+           .WithInt64("latencyMs", options.latencyMs)
+           .WithDouble("errorRate", options.errorRate);
+
+    JsonValue results;
+    results.WithInt64("requests", static_cast<long long>(result.requests))
+           .WithInt64("failures", static_cast<long long>(result.failures))
+           .WithDouble("requestsPerSecond", static_cast<double>(result.requests) / result.seconds)
+           .WithDouble("latencyMeanMs", MeanMs(result.latenciesNanos))
+           .WithDouble("latencyP50Ms", PercentileMs(result.latenciesNanos, 50))
+           .WithDouble("latencyP90Ms", PercentileMs(result.latenciesNanos, 90))
+           .WithDouble("latencyP99Ms", PercentileMs(result.latenciesNanos, 99))
+           .WithDouble("latencyP999Ms", PercentileMs(result.latenciesNanos, 99.9))
+           .WithDouble("latencyMaxMs", PercentileMs(result.latenciesNanos, 100))
+           .WithDouble("cpuUsPerRequest", CpuMicrosPerRequest(result));
+    if (server)
+    {
+        results.WithInt64("serverRequests", static_cast<long long>(server->GetRequestCount()))
+               .WithInt64("serverInjectedErrors", static_cast<long long>(server->GetInjectedErrorCount()));
+    }
+
+    JsonValue report;
+    report.WithObject("context", std::move(context)).WithObject("results", std::move(results));
+
+    std::ofstream output(options.jsonPath.c_str(), std::ios::out | std::ios::trunc);
+    output << report.View().WriteReadable() << std::endl;
+}
+
+static void PrintResult(const LoadResult& result, const LoadOptions& options, const MockServer* server)
+{
+    printf("%s %s, concurrency %ld, payload %ld bytes, server latency %ld ms, error rate %.3f\n",
+           options.service.c_str(), options.operation.c_str(), options.concurrency, options.payloadBytes,
+           options.latencyMs, options.errorRate);
+    printf("  requests       %12llu (%llu failed)\n", static_cast<unsigned long long>(result.requests),
+           static_cast<unsigned long long>(result.failures));
+    printf("  throughput     %12.1f req/s\n", static_cast<double>(result.requests) / result.seconds);
+    printf("  latency ms     mean %.3f  p50 %.3f  p90 %.3f  p99 %.3f  p99.9 %.3f  max %.3f\n",
+           MeanMs(result.latenciesNanos), PercentileMs(result.latenciesNanos, 50),
+           PercentileMs(result.latenciesNanos, 90), PercentileMs(result.latenciesNanos, 99),
+           PercentileMs(result.latenciesNanos, 99.9), PercentileMs(result.latenciesNanos, 100));
+    printf("  client cpu     %12.1f us/req\n", CpuMicrosPerRequest(result));
+    if (server)
+    {
+        // Includes warm-up and retries, so it can exceed the number of requests above.
+        printf("  server         %12llu requests, %llu injected errors\n",
+               static_cast<unsigned long long>(server->GetRequestCount()),
+               static_cast<unsigned long long>(server->GetInjectedErrorCount()));
+    }
+}
+
+static int RunLoadGenerator(const LoadOptions& options)
+{
+    std::unique_ptr<MockServer> server;
+    Aws::String endpoint = options.endpoint.c_str();
+    if (endpoint.empty())
+    {
+        MockServerConfiguration serverConfig;
+        serverConfig.port = static_cast<unsigned short>(options.port);
+        serverConfig.latency = std::chrono::milliseconds(options.latencyMs);
+        serverConfig.payloadBytes = static_cast<size_t>(options.payloadBytes);
+        serverConfig.errorRate = options.errorRate;
+        server.reset(new MockServer(serverConfig));
+        if (!server->Start())
+        {
+            fprintf(stderr, "Failed to start the mock server on port %ld\n", options.port);
+            return 1;
+        }
+        endpoint = "127.0.0.1:" + Aws::String(std::to_string(server->GetPort()).c_str());
+    }
+
+    if (options.serveOnly)
+    {
+        printf("Mock server listening on %s\n", endpoint.c_str());
+        fflush(stdout);
+        while (std::getchar() != EOF)
+        {
+        }
+        return 0;
+    }
+
+    Aws::Client::ClientConfiguration clientConfig;
+    clientConfig.maxConnections = static_cast<unsigned>(options.concurrency);
+    auto workload = CreateWorkload(options.service.c_str(), endpoint, clientConfig, static_cast<size_t>(options.payloadBytes));
+    if (!workload)
+    {
+        fprintf(stderr, "Unknown service %s\n", options.service.c_str());
+        return 1;
+    }
+
+    LoadResult result = RunLoad(*workload, options);
+    PrintResult(result, options, server.get());
+    if (!options.jsonPath.empty())
+    {
+        WriteJson(result, options, server.get());
+    }
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    LoadOptions loadOptions;
+    if (!ParseOptions(argc, argv, loadOptions))
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    Aws::SDKOptions options;
+    Aws::InitAPI(options);
+    int exitCode = RunLoadGenerator(loadOptions);
+    Aws::ShutdownAPI(options);
+    return exitCode;
+}
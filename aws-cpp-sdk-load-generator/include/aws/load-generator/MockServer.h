@@ -0,0 +1,128 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSSet.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace Aws
+{
+    namespace LoadGenerator
+    {
+        struct MockServerConfiguration
+        {
+            MockServerConfiguration() : port(0), latency(0), payloadBytes(1024), errorRate(0.0) {}
+
+            /**
+             * Port to listen on, on 127.0.0.1. 0 picks a free port; see MockServer::GetPort.
+             */
+            unsigned short port;
+
+            /**
+             * Time the server waits before answering each request, emulating service-side processing.
+             */
+            std::chrono::milliseconds latency;
+
+            /**
+             * Size of the payload returned by read operations (S3 object body, DynamoDB item attribute, SQS message body).
+             */
+            size_t payloadBytes;
+
+            /**
+             * Fraction of requests, between 0 and 1, answered with the service's retryable throttling or unavailable error.
+             */
+            double errorRate;
+        };
+
+        /**
+         * A request as received by MockServer. Header names are lower case.
+         */
+        struct MockRequest
+        {
+            Aws::String method;
+            Aws::String path;
+            Aws::String query;
+            Aws::Map<Aws::String, Aws::String> headers;
+            Aws::String body;
+
+            Aws::String GetHeader(const Aws::String& name) const;
+        };
+
+        struct MockResponse
+        {
+            MockResponse() : status(200) {}
+
+            int status;
+            Aws::Map<Aws::String, Aws::String> headers;
+            Aws::String body;
+        };
+
+        /**
+         * Minimal HTTP/1.1 server on the loopback interface that answers the requests of S3, DynamoDB and SQS clients
+         * with well-formed responses of those services, so that generated clients can be driven end to end through
+         * their real http stack without network access.
+         *
+         * Connections are kept alive and served by one thread each. Requests must carry a Content-Length when they have
+         * a body; "Expect: 100-continue" is honored.
+         */
+        class MockServer
+        {
+        public:
+            explicit MockServer(const MockServerConfiguration& configuration);
+            ~MockServer();
+
+            MockServer(const MockServer&) = delete;
+            MockServer& operator=(const MockServer&) = delete;
+
+            /**
+             * Binds and starts accepting connections. Returns false if the port can't be bound.
+             */
+            bool Start();
+
+            /**
+             * Closes the listening socket and every open connection, and waits for their threads.
+             */
+            void Stop();
+
+            unsigned short GetPort() const { return m_port; }
+
+            uint64_t GetRequestCount() const { return m_requestCount.load(); }
+            uint64_t GetInjectedErrorCount() const { return m_injectedErrorCount.load(); }
+
+            /**
+             * Builds the response to request, as the emulated service would. Exposed for testing the emulation.
+             */
+            MockResponse HandleRequest(const MockRequest& request, bool injectError) const;
+
+        private:
+            void AcceptConnections();
+            void ServeConnection(int socket);
+            bool ShouldInjectError();
+
+            MockResponse HandleS3Request(const MockRequest& request, bool injectError) const;
+            MockResponse HandleDynamoDBRequest(const MockRequest& request, bool injectError) const;
+            MockResponse HandleSQSRequest(const MockRequest& request, bool injectError) const;
+
+            MockServerConfiguration m_configuration;
+            Aws::String m_payload;
+            unsigned short m_port;
+            int m_listenSocket;
+            std::atomic<bool> m_running;
+            std::thread m_acceptThread;
+            std::mutex m_connectionsLock;
+            Aws::Vector<std::thread> m_connectionThreads;
+            Aws::Set<int> m_openSockets;
+            std::atomic<uint64_t> m_requestCount;
+            std::atomic<uint64_t> m_injectedErrorCount;
+        };
+    } // namespace LoadGenerator
+} // namespace Aws
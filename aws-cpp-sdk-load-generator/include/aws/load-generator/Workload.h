@@ -0,0 +1,42 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <memory>
+
+namespace Aws
+{
+    namespace LoadGenerator
+    {
+        /**
+         * Calls of one service made by the load generator through a generated client. Thread safe.
+         */
+        class Workload
+        {
+        public:
+            virtual ~Workload() = default;
+
+            /**
+             * Reads a payload: S3 GetObject, DynamoDB GetItem or SQS ReceiveMessage. Returns whether the call succeeded.
+             */
+            virtual bool Read() const = 0;
+
+            /**
+             * Writes a payload: S3 PutObject, DynamoDB PutItem or SQS SendMessage. Returns whether the call succeeded.
+             */
+            virtual bool Write() const = 0;
+        };
+
+        /**
+         * Creates the workload of service ("s3", "dynamodb" or "sqs") sending to endpoint ("host:port") over http, with
+         * clientConfig for everything else. Writes carry payloadBytes bytes. Returns nullptr for an unknown service.
+         */
+        std::shared_ptr<Workload> CreateWorkload(const Aws::String& service, const Aws::String& endpoint,
+            const Aws::Client::ClientConfiguration& clientConfig, size_t payloadBytes);
+    } // namespace LoadGenerator
+} // namespace Aws
@@ -0,0 +1,465 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/load-generator/MockServer.h>
+#include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/StringUtils.h>
+#include <aws/core/utils/UUID.h>
+#include <aws/core/utils/crypto/CRC32.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+
+using namespace Aws::LoadGenerator;
+using namespace Aws::Utils;
+
+static const char MOCK_SERVER_TAG[] = "MockServer";
+static const size_t READ_BUFFER_SIZE = 16 * 1024;
+static const size_t MAX_HEADER_BYTES = 64 * 1024;
+
+#if defined(MSG_NOSIGNAL)
+static const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+static const int SEND_FLAGS = 0;
+#endif
+
+Aws::String MockRequest::GetHeader(const Aws::String& name) const
+{
+    auto it = headers.find(name);
+    return it == headers.end() ? Aws::String() : it->second;
+}
+
+static const char* GetReasonPhrase(int status)
+{
+    switch (status)
+    {
+        case 100: return "Continue";
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 411: return "Length Required";
+        case 503: return "Service Unavailable";
+        default: return "Unknown";
+    }
+}
+
+static bool SendAll(int socket, const char* data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t sent = send(socket, data, length, SEND_FLAGS);
+        if (sent <= 0)
+        {
+            return false;
+        }
+        data += sent;
+        length -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+static Aws::String GetQueryParameter(const Aws::String& query, const Aws::String& name)
+{
+    for (const auto& parameter : StringUtils::Split(query, '&'))
+    {
+        const size_t equals = parameter.find('=');
+        if (parameter.substr(0, equals) == name)
+        {
+            return equals == Aws::String::npos ? Aws::String() : StringUtils::URLDecode(parameter.substr(equals + 1).c_str());
+        }
+    }
+    return {};
+}
+
+static Aws::String NewRequestId()
+{
+    return Aws::String(UUID::RandomUUID());
+}
+
+MockServer::MockServer(const MockServerConfiguration& configuration) :
+    m_configuration(configuration),
+    m_payload(configuration.payloadBytes, 'x'),
+    m_port(configuration.port),
+    m_listenSocket(-1),
+    m_running(false),
+    m_requestCount(0),
+    m_injectedErrorCount(0)
+{
+}
+
+MockServer::~MockServer()
+{
+    Stop();
+}
+
+bool MockServer::Start()
+{
+    m_listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (m_listenSocket < 0)
+    {
+        AWS_LOGSTREAM_ERROR(MOCK_SERVER_TAG, "Failed to create socket, errno: " << errno);
+        return false;
+    }
+    int enable = 1;
+    setsockopt(m_listenSocket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(m_port);
+    socklen_t addressLength = sizeof(address);
+    if (bind(m_listenSocket, reinterpret_cast<sockaddr*>(&address), addressLength) != 0 ||
+        listen(m_listenSocket, SOMAXCONN) != 0 ||
+        getsockname(m_listenSocket, reinterpret_cast<sockaddr*>(&address), &addressLength) != 0)
+    {
+        AWS_LOGSTREAM_ERROR(MOCK_SERVER_TAG, "Failed to listen on port " << m_port << ", errno: " << errno);
+        close(m_listenSocket);
+        m_listenSocket = -1;
+        return false;
+    }
+    m_port = ntohs(address.sin_port);
+
+    m_running = true;
+    m_acceptThread = std::thread(&MockServer::AcceptConnections, this);
+    AWS_LOGSTREAM_INFO(MOCK_SERVER_TAG, "Listening on 127.0.0.1:" << m_port);
+    return true;
+}
+
+void MockServer::Stop()
+{
+    if (!m_running.exchange(false))
+    {
+        return;
+    }
+
+    shutdown(m_listenSocket, SHUT_RDWR);
+    close(m_listenSocket);
+    m_acceptThread.join();
+
+    Aws::Vector<std::thread> connectionThreads;
+    {
+        std::lock_guard<std::mutex> locker(m_connectionsLock);
+        for (int socket : m_openSockets)
+        {
+            shutdown(socket, SHUT_RDWR);
+        }
+        connectionThreads.swap(m_connectionThreads);
+    }
+    for (auto& thread : connectionThreads)
+    {
+        thread.join();
+    }
+}
+
+void MockServer::AcceptConnections()
+{
+    while (m_running)
+    {
+        int socket = accept(m_listenSocket, nullptr, nullptr);
+        if (socket < 0)
+        {
+            continue;
+        }
+        int enable = 1;
+        setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+#if defined(SO_NOSIGPIPE)
+        setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+
+        std::lock_guard<std::mutex> locker(m_connectionsLock);
+        if (!m_running)
+        {
+            close(socket);
+            break;
+        }
+        m_openSockets.insert(socket);
+        m_connectionThreads.emplace_back(&MockServer::ServeConnection, this, socket);
+    }
+}
+
+bool MockServer::ShouldInjectError()
+{
+    const uint64_t count = m_requestCount.fetch_add(1);
+    if (m_configuration.errorRate <= 0)
+    {
+        return false;
+    }
+    // Spread errors evenly: fail request n whenever n * errorRate crosses an integer. Deterministic across runs.
+    const bool inject = std::floor((count + 1) * m_configuration.errorRate) > std::floor(count * m_configuration.errorRate);
+    if (inject)
+    {
+        ++m_injectedErrorCount;
+    }
+    return inject;
+}
+
+void MockServer::ServeConnection(int socket)
+{
+    Aws::String buffer;
+    char readBuffer[READ_BUFFER_SIZE];
+    bool keepAlive = true;
+
+    while (keepAlive && m_running)
+    {
+        size_t headerEnd;
+        while ((headerEnd = buffer.find("\r\n\r\n")) == Aws::String::npos && buffer.size() < MAX_HEADER_BYTES)
+        {
+            ssize_t received = recv(socket, readBuffer, sizeof(readBuffer), 0);
+            if (received <= 0)
+            {
+                keepAlive = false;
+                break;
+            }
+            buffer.append(readBuffer, static_cast<size_t>(received));
+        }
+        if (!keepAlive || headerEnd == Aws::String::npos)
+        {
+            break;
+        }
+
+        MockRequest request;
+        const auto lines = StringUtils::SplitOnLine(buffer.substr(0, headerEnd));
+        const auto requestLine = StringUtils::Split(lines.empty() ? Aws::String() : lines[0], ' ');
+        if (requestLine.size() < 2)
+        {
+            break;
+        }
+        request.method = requestLine[0];
+        const size_t question = requestLine[1].find('?');
+        request.path = requestLine[1].substr(0, question);
+        request.query = question == Aws::String::npos ? Aws::String() : requestLine[1].substr(question + 1);
+        for (size_t i = 1; i < lines.size(); ++i)
+        {
+            const size_t colon = lines[i].find(':');
+            if (colon != Aws::String::npos)
+            {
+                request.headers[StringUtils::ToLower(lines[i].substr(0, colon).c_str())] = StringUtils::Trim(lines[i].substr(colon + 1).c_str());
+            }
+        }
+        buffer.erase(0, headerEnd + 4);
+
+        MockResponse response;
+        if (!request.GetHeader("transfer-encoding").empty())
+        {
+            response.status = 411;
+            keepAlive = false;
+        }
+        else
+        {
+            const size_t contentLength = static_cast<size_t>(std::strtoull(request.GetHeader("content-length").c_str(), nullptr, 10));
+            if (contentLength > buffer.size() && StringUtils::ToLower(request.GetHeader("expect").c_str()) == "100-continue")
+            {
+                static const char CONTINUE[] = "HTTP/1.1 100 Continue\r\n\r\n";
+                SendAll(socket, CONTINUE, sizeof(CONTINUE) - 1);
+            }
+            while (buffer.size() < contentLength)
+            {
+                ssize_t received = recv(socket, readBuffer, sizeof(readBuffer), 0);
+                if (received <= 0)
+                {
+                    keepAlive = false;
+                    break;
+                }
+                buffer.append(readBuffer, static_cast<size_t>(received));
+            }
+            if (!keepAlive)
+            {
+                break;
+            }
+            request.body = buffer.substr(0, contentLength);
+            buffer.erase(0, contentLength);
+
+            response = HandleRequest(request, ShouldInjectError());
+            if (m_configuration.latency.count() > 0)
+            {
+                std::this_thread::sleep_for(m_configuration.latency);
+            }
+            keepAlive = StringUtils::ToLower(request.GetHeader("connection").c_str()) != "close";
+        }
+
+        Aws::StringStream ss;
+        ss << "HTTP/1.1 " << response.status << " " << GetReasonPhrase(response.status) << "\r\n";
+        for (const auto& header : response.headers)
+        {
+            ss << header.first << ": " << header.second << "\r\n";
+        }
+        // Responses to HEAD describe the body they would have, but carry none.
+        if (response.headers.find("Content-Length") == response.headers.end())
+        {
+            ss << "Content-Length: " << response.body.size() << "\r\n";
+        }
+        ss << "Connection: " << (keepAlive ? "keep-alive" : "close") << "\r\n\r\n";
+        Aws::String head = ss.str();
+        if (!SendAll(socket, head.data(), head.size()) ||
+            (request.method != "HEAD" && !SendAll(socket, response.body.data(), response.body.size())))
+        {
+            break;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> locker(m_connectionsLock);
+        m_openSockets.erase(socket);
+    }
+    close(socket);
+}
+
+MockResponse MockServer::HandleRequest(const MockRequest& request, bool injectError) const
+{
+    if (request.GetHeader("x-amz-target").find("DynamoDB_") == 0)
+    {
+        return HandleDynamoDBRequest(request, injectError);
+    }
+    if (request.GetHeader("content-type").find("application/x-www-form-urlencoded") == 0 && !GetQueryParameter(request.body, "Action").empty())
+    {
+        return HandleSQSRequest(request, injectError);
+    }
+    return HandleS3Request(request, injectError);
+}
+
+MockResponse MockServer::HandleS3Request(const MockRequest& request, bool injectError) const
+{
+    MockResponse response;
+    const Aws::String requestId = NewRequestId();
+    response.headers["x-amz-request-id"] = requestId;
+    response.headers["x-amz-id-2"] = requestId;
+
+    if (injectError)
+    {
+        response.status = 503;
+        response.headers["Content-Type"] = "application/xml";
+        if (request.method == "HEAD")
+        {
+            response.headers["Content-Length"] = "0";
+            return response;
+        }
+        response.body = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<Error><Code>SlowDown</Code><Message>Please reduce your request rate.</Message>"
+                        "<RequestId>" + requestId + "</RequestId></Error>";
+        return response;
+    }
+
+    static const char ETAG[] = "\"5d41402abc4b2a76b9719d911017c592\"";
+    if (request.method == "PUT")
+    {
+        response.headers["ETag"] = ETAG;
+    }
+    else if (request.method == "DELETE")
+    {
+        response.status = 204;
+    }
+    else if (request.method == "GET" && GetQueryParameter(request.query, "list-type") == "2")
+    {
+        Aws::StringStream ss;
+        ss << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+           << "<Name>" << request.path.substr(1, request.path.find('/', 1) - 1) << "</Name><KeyCount>10</KeyCount><MaxKeys>1000</MaxKeys><IsTruncated>false</IsTruncated>";
+        for (int i = 0; i < 10; ++i)
+        {
+            ss << "<Contents><Key>key-" << i << "</Key><LastModified>2021-03-04T05:06:07.000Z</LastModified><ETag>&quot;5d41402abc4b2a76b9719d911017c592&quot;</ETag>"
+               << "<Size>" << m_payload.size() << "</Size><StorageClass>STANDARD</StorageClass></Contents>";
+        }
+        ss << "</ListBucketResult>";
+        response.headers["Content-Type"] = "application/xml";
+        response.body = ss.str();
+    }
+    else if (request.method == "GET" || request.method == "HEAD")
+    {
+        response.headers["ETag"] = ETAG;
+        response.headers["Content-Type"] = "application/octet-stream";
+        response.headers["Last-Modified"] = "Thu, 04 Mar 2021 05:06:07 GMT";
+        if (request.method == "HEAD")
+        {
+            response.headers["Content-Length"] = StringUtils::to_string(m_payload.size());
+        }
+        else
+        {
+            response.body = m_payload;
+        }
+    }
+    else
+    {
+        response.status = 400;
+        response.headers["Content-Type"] = "application/xml";
+        response.body = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<Error><Code>InvalidRequest</Code><Message>Unsupported operation.</Message></Error>";
+    }
+    return response;
+}
+
+MockResponse MockServer::HandleDynamoDBRequest(const MockRequest& request, bool injectError) const
+{
+    MockResponse response;
+    response.headers["x-amzn-RequestId"] = NewRequestId();
+    response.headers["Content-Type"] = "application/x-amz-json-1.0";
+
+    if (injectError)
+    {
+        response.status = 400;
+        response.body = "{\"__type\":\"com.amazonaws.dynamodb.v20120810#ProvisionedThroughputExceededException\","
+                        "\"message\":\"The level of configured provisioned throughput for the table was exceeded.\"}";
+        return response;
+    }
+
+    const Aws::String target = request.GetHeader("x-amz-target");
+    const Aws::String operation = target.substr(target.find('.') + 1);
+    if (operation == "GetItem")
+    {
+        response.body = "{\"Item\":{\"pk\":{\"S\":\"key\"},\"payload\":{\"S\":\"" + m_payload + "\"}}}";
+    }
+    else if (operation == "Query" || operation == "Scan")
+    {
+        response.body = "{\"Count\":1,\"ScannedCount\":1,\"Items\":[{\"pk\":{\"S\":\"key\"},\"payload\":{\"S\":\"" + m_payload + "\"}}]}";
+    }
+    else
+    {
+        response.body = "{}";
+    }
+    response.headers["x-amz-crc32"] = StringUtils::to_string(Crypto::CRC32::Checksum(reinterpret_cast<const unsigned char*>(response.body.data()), response.body.size()));
+    return response;
+}
+
+MockResponse MockServer::HandleSQSRequest(const MockRequest& request, bool injectError) const
+{
+    MockResponse response;
+    const Aws::String requestId = NewRequestId();
+    response.headers["x-amzn-RequestId"] = requestId;
+    response.headers["Content-Type"] = "text/xml";
+
+    if (injectError)
+    {
+        response.status = 503;
+        response.body = "<?xml version=\"1.0\"?><ErrorResponse xmlns=\"http://queue.amazonaws.com/doc/2012-11-05/\"><Error><Type>Receiver</Type>"
+                        "<Code>ServiceUnavailable</Code><Message>The request has failed due to a temporary failure of the server.</Message>"
+                        "<Detail/></Error><RequestId>" + requestId + "</RequestId></ErrorResponse>";
+        return response;
+    }
+
+    const Aws::String action = GetQueryParameter(request.body, "Action");
+    Aws::StringStream ss;
+    ss << "<?xml version=\"1.0\"?><" << action << "Response xmlns=\"http://queue.amazonaws.com/doc/2012-11-05/\">";
+    if (action == "SendMessage")
+    {
+        const Aws::String messageBody = GetQueryParameter(request.body, "MessageBody");
+        ss << "<SendMessageResult><MessageId>" << NewRequestId() << "</MessageId>"
+           << "<MD5OfMessageBody>" << HashingUtils::HexEncode(HashingUtils::CalculateMD5(messageBody)) << "</MD5OfMessageBody></SendMessageResult>";
+    }
+    else if (action == "ReceiveMessage")
+    {
+        ss << "<ReceiveMessageResult><Message><MessageId>" << NewRequestId() << "</MessageId>"
+           << "<ReceiptHandle>" << NewRequestId() << "</ReceiptHandle>"
+           << "<MD5OfBody>" << HashingUtils::HexEncode(HashingUtils::CalculateMD5(m_payload)) << "</MD5OfBody>"
+           << "<Body>" << m_payload << "</Body></Message></ReceiveMessageResult>";
+    }
+    ss << "<ResponseMetadata><RequestId>" << requestId << "</RequestId></ResponseMetadata></" << action << "Response>";
+    response.body = ss.str();
+    return response;
+}
@@ -0,0 +1,149 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/load-generator/Workload.h>
+#include <aws/core/auth/AWSCredentials.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/dynamodb/DynamoDBClient.h>
+#include <aws/dynamodb/model/GetItemRequest.h>
+#include <aws/dynamodb/model/PutItemRequest.h>
+#include <aws/s3/S3Client.h>
+#include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/PutObjectRequest.h>
+#include <aws/sqs/SQSClient.h>
+#include <aws/sqs/model/ReceiveMessageRequest.h>
+#include <aws/sqs/model/SendMessageRequest.h>
+
+using namespace Aws::LoadGenerator;
+using namespace Aws::Client;
+
+static const char WORKLOAD_TAG[] = "LoadGeneratorWorkload";
+static const char BUCKET[] = "load-generator-bucket";
+static const char KEY[] = "load-generator-key";
+static const char TABLE[] = "load-generator-table";
+
+// The mock server doesn't check signatures, but clients still sign every request, as they would against the service.
+static Aws::Auth::AWSCredentials GetCredentials()
+{
+    return Aws::Auth::AWSCredentials("AKIDEXAMPLE", "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY");
+}
+
+namespace
+{
+    class S3Workload : public Workload
+    {
+    public:
+        S3Workload(const ClientConfiguration& clientConfig, size_t payloadBytes) :
+            m_client(GetCredentials(), clientConfig, AWSAuthV4Signer::PayloadSigningPolicy::Never, false),
+            m_payload(payloadBytes, 'x')
+        {
+        }
+
+        bool Read() const override
+        {
+            Aws::S3::Model::GetObjectRequest request;
+            request.SetBucket(BUCKET);
+            request.SetKey(KEY);
+            return m_client.GetObject(request).IsSuccess();
+        }
+
+        bool Write() const override
+        {
+            Aws::S3::Model::PutObjectRequest request;
+            request.SetBucket(BUCKET);
+            request.SetKey(KEY);
+            auto body = Aws::MakeShared<Aws::StringStream>(WORKLOAD_TAG);
+            body->write(m_payload.data(), static_cast<std::streamsize>(m_payload.size()));
+            request.SetBody(body);
+            return m_client.PutObject(request).IsSuccess();
+        }
+
+    private:
+        Aws::S3::S3Client m_client;
+        Aws::String m_payload;
+    };
+
+    class DynamoDBWorkload : public Workload
+    {
+    public:
+        DynamoDBWorkload(const ClientConfiguration& clientConfig, size_t payloadBytes) :
+            m_client(GetCredentials(), clientConfig)
+        {
+            m_getItemRequest.SetTableName(TABLE);
+            m_getItemRequest.AddKey("pk", Aws::DynamoDB::Model::AttributeValue().SetS("key"));
+
+            m_putItemRequest.SetTableName(TABLE);
+            m_putItemRequest.AddItem("pk", Aws::DynamoDB::Model::AttributeValue().SetS("key"));
+            m_putItemRequest.AddItem("payload", Aws::DynamoDB::Model::AttributeValue().SetS(Aws::String(payloadBytes, 'x')));
+        }
+
+        bool Read() const override
+        {
+            return m_client.GetItem(m_getItemRequest).IsSuccess();
+        }
+
+        bool Write() const override
+        {
+            return m_client.PutItem(m_putItemRequest).IsSuccess();
+        }
+
+    private:
+        Aws::DynamoDB::DynamoDBClient m_client;
+        Aws::DynamoDB::Model::GetItemRequest m_getItemRequest;
+        Aws::DynamoDB::Model::PutItemRequest m_putItemRequest;
+    };
+
+    class SQSWorkload : public Workload
+    {
+    public:
+        SQSWorkload(const Aws::String& endpoint, const ClientConfiguration& clientConfig, size_t payloadBytes) :
+            m_client(GetCredentials(), clientConfig)
+        {
+            const Aws::String queueUrl = "http://" + endpoint + "/123456789012/load-generator-queue";
+            m_receiveMessageRequest.SetQueueUrl(queueUrl);
+            m_receiveMessageRequest.SetMaxNumberOfMessages(1);
+
+            m_sendMessageRequest.SetQueueUrl(queueUrl);
+            m_sendMessageRequest.SetMessageBody(Aws::String(payloadBytes, 'x'));
+        }
+
+        bool Read() const override
+        {
+            return m_client.ReceiveMessage(m_receiveMessageRequest).IsSuccess();
+        }
+
+        bool Write() const override
+        {
+            return m_client.SendMessage(m_sendMessageRequest).IsSuccess();
+        }
+
+    private:
+        Aws::SQS::SQSClient m_client;
+        Aws::SQS::Model::ReceiveMessageRequest m_receiveMessageRequest;
+        Aws::SQS::Model::SendMessageRequest m_sendMessageRequest;
+    };
+} // namespace
+
+std::shared_ptr<Workload> Aws::LoadGenerator::CreateWorkload(const Aws::String& service, const Aws::String& endpoint,
+    const ClientConfiguration& clientConfig, size_t payloadBytes)
+{
+    ClientConfiguration config(clientConfig);
+    config.scheme = Aws::Http::Scheme::HTTP;
+    config.endpointOverride = endpoint;
+
+    if (service == "s3")
+    {
+        return Aws::MakeShared<S3Workload>(WORKLOAD_TAG, config, payloadBytes);
+    }
+    if (service == "dynamodb")
+    {
+        return Aws::MakeShared<DynamoDBWorkload>(WORKLOAD_TAG, config, payloadBytes);
+    }
+    if (service == "sqs")
+    {
+        return Aws::MakeShared<SQSWorkload>(WORKLOAD_TAG, endpoint, config, payloadBytes);
+    }
+    return nullptr;
+}
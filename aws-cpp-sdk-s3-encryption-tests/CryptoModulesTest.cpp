@@ -253,6 +253,96 @@ namespace
         mutable size_t m_requestContentLength;
     };
 
+    /*
+    * Extends the mock S3 client with multipart uploads. Parts are kept by part number until the upload is completed, then
+    * joined into the body that GetObject serves. Operations may be called from several threads at once.
+    */
+    class MockMultipartS3Client : public MockS3Client
+    {
+    public:
+        MockMultipartS3Client() : m_uploadPartCalled(0), m_completeCalled(0), m_abortCalled(0), m_failingPartNumber(0)
+        {
+        }
+
+        Aws::S3::Model::CreateMultipartUploadOutcome CreateMultipartUpload(const Aws::S3::Model::CreateMultipartUploadRequest& request) const override
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_metadata = request.GetMetadata();
+            m_parts.clear();
+            Aws::S3::Model::CreateMultipartUploadResult result;
+            result.SetUploadId("uploadId");
+            return result;
+        }
+
+        Aws::S3::Model::UploadPartOutcome UploadPart(const Aws::S3::Model::UploadPartRequest& request) const override
+        {
+            Aws::String part((Aws::IStreamBufIterator(*request.GetBody())), Aws::IStreamBufIterator());
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_uploadPartCalled++;
+            if (request.GetPartNumber() == m_failingPartNumber)
+            {
+                return Aws::S3::S3Error(Aws::Client::AWSError<Aws::Client::CoreErrors>(Aws::Client::CoreErrors::NETWORK_CONNECTION, "NetworkError", "Part failed", false));
+            }
+            EXPECT_EQ(static_cast<size_t>(request.GetContentLength()), part.size());
+            m_parts[request.GetPartNumber()] = part;
+            Aws::S3::Model::UploadPartResult result;
+            result.SetETag("etag-" + Aws::Utils::StringUtils::to_string(request.GetPartNumber()));
+            return result;
+        }
+
+        Aws::S3::Model::CompleteMultipartUploadOutcome CompleteMultipartUpload(const Aws::S3::Model::CompleteMultipartUploadRequest& request) const override
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_completeCalled++;
+            bodyString.clear();
+            int expectedPartNumber = 1;
+            for (const auto& part : request.GetMultipartUpload().GetParts())
+            {
+                EXPECT_EQ(expectedPartNumber, part.GetPartNumber());
+                EXPECT_EQ("etag-" + Aws::Utils::StringUtils::to_string(expectedPartNumber), part.GetETag());
+                bodyString += m_parts[part.GetPartNumber()];
+                expectedPartNumber++;
+            }
+            m_requestContentLength = bodyString.size();
+            Aws::S3::Model::CompleteMultipartUploadResult result;
+            result.SetETag("etag");
+            return result;
+        }
+
+        Aws::S3::Model::AbortMultipartUploadOutcome AbortMultipartUpload(const Aws::S3::Model::AbortMultipartUploadRequest&) const override
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_abortCalled++;
+            return Aws::S3::Model::AbortMultipartUploadResult();
+        }
+
+        Aws::S3::Model::GetObjectOutcome GetObject(const Aws::S3::Model::GetObjectRequest& request) const override
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return MockS3Client::GetObject(request);
+        }
+
+        MultipartUploadFunctions GetMultipartUploadFunctions()
+        {
+            MultipartUploadFunctions functions;
+            functions.putObject = [this](const PutObjectRequest& request) { return PutObject(request); };
+            functions.createMultipartUpload = [this](const CreateMultipartUploadRequest& request) { return CreateMultipartUpload(request); };
+            functions.uploadPart = [this](const UploadPartRequest& request) { return UploadPart(request); };
+            functions.completeMultipartUpload = [this](const CompleteMultipartUploadRequest& request) { return CompleteMultipartUpload(request); };
+            functions.abortMultipartUpload = [this](const AbortMultipartUploadRequest& request) { return AbortMultipartUpload(request); };
+            return functions;
+        }
+
+        mutable size_t m_uploadPartCalled;
+        mutable size_t m_completeCalled;
+        mutable size_t m_abortCalled;
+        mutable Aws::Map<int, Aws::String> m_parts;
+        int m_failingPartNumber;
+
+    private:
+        mutable std::mutex m_mutex;
+    };
+
     class CryptoModulesTest : public ::testing::Test
     {
     protected:
@@ -1356,6 +1446,184 @@ namespace
             ASSERT_EQ(pair, std::make_pair(static_cast<int64_t>(0), static_cast<int64_t>(0)));
         }
     }
+
+    /*
+    * Function to build a body of the given size out of varying bytes.
+    */
+    static Aws::String MakeMultipartBody(size_t size)
+    {
+        Aws::String body(size, '\0');
+        for (size_t i = 0; i < size; ++i)
+        {
+            body[i] = static_cast<char>((i * 31 + i / 251) & 0xFF);
+        }
+        return body;
+    }
+
+    static PutObjectRequest MakeMultipartPutRequest(const Aws::String& body)
+    {
+        PutObjectRequest putRequest;
+        putRequest.SetBucket(BUCKET_TEST_NAME);
+        putRequest.SetKey(KEY_TEST_NAME);
+        std::shared_ptr<Aws::IOStream> objectStream = Aws::MakeShared<Aws::StringStream>(ALLOCATION_TAG);
+        objectStream->write(body.c_str(), body.size());
+        objectStream->flush();
+        putRequest.SetBody(objectStream);
+        return putRequest;
+    }
+
+    static S3EncryptionGetObjectOutcome GetObjectInParts(MockS3Client& s3Client, const std::shared_ptr<CryptoModule>& module, const S3EncryptionTransferConfiguration& transferConfig)
+    {
+        GetObjectRequest getRequest;
+        getRequest.SetBucket(BUCKET_TEST_NAME);
+        getRequest.SetKey(KEY_TEST_NAME);
+
+        HeadObjectRequest headObject;
+        headObject.WithBucket(BUCKET_TEST_NAME);
+        headObject.WithKey(KEY_TEST_NAME);
+        HeadObjectOutcome headOutcome = s3Client.HeadObject(headObject);
+
+        Aws::S3Encryption::Handlers::MetadataHandler handler;
+        ContentCryptoMaterial contentCryptoMaterial = handler.ReadContentCryptoMaterial(headOutcome.GetResult());
+        auto getObjectFunction = [&s3Client](Aws::S3::Model::GetObjectRequest getRequest) -> Aws::S3::Model::GetObjectOutcome { return s3Client.GetObject(getRequest); };
+        return module->GetObjectSecurelyInParts(getRequest, headOutcome.GetResult(), contentCryptoMaterial, getObjectFunction, transferConfig);
+    }
+
+    static Aws::String ReadBody(S3EncryptionGetObjectOutcome& outcome)
+    {
+        Aws::OStringStream ss;
+        ss << outcome.GetResult().GetBody().rdbuf();
+        return ss.str();
+    }
+
+    TEST_F(CryptoModulesTest, AEMultipartUploadAndParallelGet)
+    {
+        SimpleEncryptionMaterials materials(Aws::Utils::Crypto::SymmetricCipher::GenerateKey());
+        CryptoConfiguration cryptoConfig(StorageMethod::METADATA, CryptoMode::AUTHENTICATED_ENCRYPTION);
+        MockMultipartS3Client s3Client;
+        CryptoModuleFactory factory;
+        auto module = factory.FetchCryptoModule(Aws::MakeShared<SimpleEncryptionMaterials>(ALLOCATION_TAG, materials), cryptoConfig);
+
+        const size_t partSize = 5 * 1024 * 1024;
+        Aws::String body = MakeMultipartBody(2 * partSize + 1000);
+        S3EncryptionTransferConfiguration transferConfig;
+        transferConfig.partSize = partSize;
+        transferConfig.maxConcurrentParts = 2;
+        auto putOutcome = module->PutObjectSecurelyInParts(MakeMultipartPutRequest(body), s3Client.GetMultipartUploadFunctions(), transferConfig);
+        ASSERT_TRUE(putOutcome.IsSuccess());
+        ASSERT_EQ("etag", putOutcome.GetResult().GetETag());
+
+        MetadataFilled(s3Client.GetMetadata());
+        ASSERT_EQ(3u, s3Client.m_uploadPartCalled);
+        ASSERT_EQ(1u, s3Client.m_completeCalled);
+        ASSERT_EQ(partSize, s3Client.m_parts[1].size());
+        ASSERT_EQ(partSize, s3Client.m_parts[2].size());
+        //the tag is appended to the last part
+        ASSERT_EQ(1000u + GCM_TAG_LENGTH / 8, s3Client.m_parts[3].size());
+
+        //objects uploaded in parts decrypt like any other object
+        auto decryptionModule = factory.FetchCryptoModule(Aws::MakeShared<SimpleEncryptionMaterials>(ALLOCATION_TAG, materials), cryptoConfig);
+        GetObjectRequest getRequest;
+        getRequest.SetBucket(BUCKET_TEST_NAME);
+        getRequest.SetKey(KEY_TEST_NAME);
+        HeadObjectOutcome headOutcome = s3Client.HeadObject(HeadObjectRequest());
+        Aws::S3Encryption::Handlers::MetadataHandler handler;
+        auto getObjectFunction = [&s3Client](Aws::S3::Model::GetObjectRequest getRequest) -> Aws::S3::Model::GetObjectOutcome { return s3Client.GetObject(getRequest); };
+        auto getOutcome = decryptionModule->GetObjectSecurely(getRequest, headOutcome.GetResult(), handler.ReadContentCryptoMaterial(headOutcome.GetResult()), getObjectFunction);
+        ASSERT_TRUE(getOutcome.IsSuccess());
+        ASSERT_TRUE(body == ReadBody(getOutcome));
+
+        s3Client.m_getObjectCalled = 0;
+        transferConfig.partSize = 1024 * 1024;
+        transferConfig.maxConcurrentParts = 3;
+        decryptionModule = factory.FetchCryptoModule(Aws::MakeShared<SimpleEncryptionMaterials>(ALLOCATION_TAG, materials), cryptoConfig);
+        auto partsOutcome = GetObjectInParts(s3Client, decryptionModule, transferConfig);
+        ASSERT_TRUE(partsOutcome.IsSuccess());
+        ASSERT_EQ(static_cast<long long>(body.size()), partsOutcome.GetResult().GetContentLength());
+        ASSERT_EQ(s3Client.GetMetadata(), partsOutcome.GetResult().GetMetadata());
+        ASSERT_TRUE(body == ReadBody(partsOutcome));
+        //one get for the tag and eleven for the parts
+        ASSERT_EQ(12u, s3Client.m_getObjectCalled);
+    }
+
+    TEST_F(CryptoModulesTest, StrictAEParallelGetOfSinglePartObject)
+    {
+        SimpleEncryptionMaterials materials(Aws::Utils::Crypto::SymmetricCipher::GenerateKey());
+        CryptoConfiguration cryptoConfig(StorageMethod::METADATA, CryptoMode::STRICT_AUTHENTICATED_ENCRYPTION);
+        MockMultipartS3Client s3Client;
+        CryptoModuleFactory factory;
+        auto module = factory.FetchCryptoModule(Aws::MakeShared<SimpleEncryptionMaterials>(ALLOCATION_TAG, materials), cryptoConfig);
+
+        auto putObjectFunction = [&s3Client](Aws::S3::Model::PutObjectRequest putRequest) -> Aws::S3::Model::PutObjectOutcome { return s3Client.PutObject(putRequest); };
+        ASSERT_TRUE(module->PutObjectSecurely(MakeMultipartPutRequest(BODY_STREAM_TEST), putObjectFunction).IsSuccess());
+
+        S3EncryptionTransferConfiguration transferConfig;
+        transferConfig.partSize = 16;
+        transferConfig.maxConcurrentParts = 2;
+        auto decryptionModule = factory.FetchCryptoModule(Aws::MakeShared<SimpleEncryptionMaterials>(ALLOCATION_TAG, materials), cryptoConfig);
+        auto getOutcome = GetObjectInParts(s3Client, decryptionModule, transferConfig);
+        ASSERT_TRUE(getOutcome.IsSuccess());
+        ASSERT_STREQ(BODY_STREAM_TEST, ReadBody(getOutcome).c_str());
+        //one get for the tag and four for the parts
+        ASSERT_EQ(5u, s3Client.m_getObjectCalled);
+    }
+
+    TEST_F(CryptoModulesTest, ParallelGetFailsOnTamperedPart)
+    {
+        SimpleEncryptionMaterials materials(Aws::Utils::Crypto::SymmetricCipher::GenerateKey());
+        CryptoConfiguration cryptoConfig(StorageMethod::METADATA, CryptoMode::STRICT_AUTHENTICATED_ENCRYPTION);
+        MockMultipartS3Client s3Client;
+        CryptoModuleFactory factory;
+        auto module = factory.FetchCryptoModule(Aws::MakeShared<SimpleEncryptionMaterials>(ALLOCATION_TAG, materials), cryptoConfig);
+
+        S3EncryptionTransferConfiguration transferConfig;
+        transferConfig.partSize = 5 * 1024 * 1024;
+        auto putOutcome = module->PutObjectSecurelyInParts(MakeMultipartPutRequest(MakeMultipartBody(6 * 1024 * 1024)), s3Client.GetMultipartUploadFunctions(), transferConfig);
+        ASSERT_TRUE(putOutcome.IsSuccess());
+        ASSERT_EQ(2u, s3Client.m_uploadPartCalled);
+
+        s3Client.bodyString[3 * 1024 * 1024] ^= 0x01;
+        transferConfig.partSize = 1024 * 1024;
+        auto decryptionModule = factory.FetchCryptoModule(Aws::MakeShared<SimpleEncryptionMaterials>(ALLOCATION_TAG, materials), cryptoConfig);
+        auto getOutcome = GetObjectInParts(s3Client, decryptionModule, transferConfig);
+        ASSERT_FALSE(getOutcome.IsSuccess());
+        ASSERT_EQ("FailedToDecryptContent", getOutcome.GetError().GetExceptionName());
+    }
+
+    TEST_F(CryptoModulesTest, MultipartUploadIsAbortedWhenAPartFails)
+    {
+        SimpleEncryptionMaterials materials(Aws::Utils::Crypto::SymmetricCipher::GenerateKey());
+        CryptoConfiguration cryptoConfig(StorageMethod::METADATA, CryptoMode::AUTHENTICATED_ENCRYPTION);
+        MockMultipartS3Client s3Client;
+        s3Client.m_failingPartNumber = 2;
+        CryptoModuleFactory factory;
+        auto module = factory.FetchCryptoModule(Aws::MakeShared<SimpleEncryptionMaterials>(ALLOCATION_TAG, materials), cryptoConfig);
+
+        S3EncryptionTransferConfiguration transferConfig;
+        transferConfig.partSize = 5 * 1024 * 1024;
+        transferConfig.maxConcurrentParts = 1;
+        auto putOutcome = module->PutObjectSecurelyInParts(MakeMultipartPutRequest(MakeMultipartBody(16 * 1024 * 1024)), s3Client.GetMultipartUploadFunctions(), transferConfig);
+        ASSERT_FALSE(putOutcome.IsSuccess());
+        ASSERT_EQ("Part failed", putOutcome.GetError().GetMessage());
+        //no more parts are uploaded after the failure
+        ASSERT_EQ(2u, s3Client.m_uploadPartCalled);
+        ASSERT_EQ(0u, s3Client.m_completeCalled);
+        ASSERT_EQ(1u, s3Client.m_abortCalled);
+    }
+
+    TEST_F(CryptoModulesTest, EncryptionOnlyMultipartUploadNotSupported)
+    {
+        SimpleEncryptionMaterials materials(Aws::Utils::Crypto::SymmetricCipher::GenerateKey());
+        CryptoConfiguration cryptoConfig(StorageMethod::METADATA, CryptoMode::ENCRYPTION_ONLY);
+        MockMultipartS3Client s3Client;
+        CryptoModuleFactory factory;
+        auto module = factory.FetchCryptoModule(Aws::MakeShared<SimpleEncryptionMaterials>(ALLOCATION_TAG, materials), cryptoConfig);
+
+        auto putOutcome = module->PutObjectSecurelyInParts(MakeMultipartPutRequest(BODY_STREAM_TEST), s3Client.GetMultipartUploadFunctions(), S3EncryptionTransferConfiguration());
+        ASSERT_FALSE(putOutcome.IsSuccess());
+        ASSERT_EQ("MultipartUploadNotSupported", putOutcome.GetError().GetExceptionName());
+        ASSERT_EQ(0u, s3Client.m_uploadPartCalled);
+    }
 }
 
 #endif
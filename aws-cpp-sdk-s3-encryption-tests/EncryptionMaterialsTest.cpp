@@ -19,6 +19,8 @@
 #include <aws/core/auth/AWSCredentialsProvider.h>
 #include <aws/core/utils/Outcome.h>
 #include <aws/core/client/ClientConfiguration.h>
+#include <mutex>
+#include <thread>
 
 using namespace Aws::Client;
 using namespace Aws::Utils::Crypto;
@@ -554,6 +556,124 @@ namespace
         ASSERT_EQ(myClient->m_decryptCalledCount, 0u);
         ASSERT_EQ(myClient->m_genDataKeyCalledCount, 0u);
     }
+
+    //Mock KMS client whose decrypt calls take a while, so that concurrent calls overlap.
+    class SlowDecryptMockKMSClient : public MockKMSClient
+    {
+    public:
+        DecryptOutcome Decrypt(const DecryptRequest& request) const override
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return MockKMSClient::Decrypt(request);
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+    };
+
+    static ContentCryptoMaterial MakeEncryptedContentCryptoMaterial(const ContentCryptoMaterial& contentCryptoMaterial)
+    {
+        ContentCryptoMaterial encryptedContentCryptoMaterial(ContentCryptoScheme::GCM);
+        encryptedContentCryptoMaterial.SetMaterialsDescription(contentCryptoMaterial.GetMaterialsDescription());
+        encryptedContentCryptoMaterial.SetKeyWrapAlgorithm(KeyWrapAlgorithm::KMS_CONTEXT);
+        encryptedContentCryptoMaterial.SetEncryptedContentEncryptionKey(contentCryptoMaterial.GetEncryptedContentEncryptionKey());
+        return encryptedContentCryptoMaterial;
+    }
+
+    //This tests that a data key is reused for the configured number of objects before a new one is generated.
+    TEST_F(KMSWithContextEncryptionMaterialsTest, TestKeyCacheReusesDataKey)
+    {
+        auto myClient = Aws::MakeShared<MockKMSClient>(AllocationTag, ClientConfiguration());
+        InitMockKMSClient(myClient);
+
+        KMSKeyCacheConfiguration cacheConfig;
+        cacheConfig.maxEncryptionsPerDataKey = 3;
+        KMSWithContextEncryptionMaterials encryptionMaterials(TEST_CMK_ID, myClient);
+        encryptionMaterials.SetKeyCache(Aws::MakeShared<KMSKeyCache>(AllocationTag, cacheConfig));
+
+        for (size_t i = 0; i < 7; ++i)
+        {
+            ContentCryptoMaterial contentCryptoMaterial(ContentCryptoScheme::GCM);
+            ASSERT_TRUE(encryptionMaterials.EncryptCEK(contentCryptoMaterial).IsSuccess());
+            ASSERT_EQ(contentCryptoMaterial.GetContentEncryptionKey(), myClient->m_decryptedKey);
+            ASSERT_EQ(myClient->m_encryptedKey, contentCryptoMaterial.GetEncryptedContentEncryptionKey());
+            ASSERT_EQ(myClient->m_genDataKeyCalledCount, i / 3 + 1);
+        }
+
+        //A different encryption context does not share the data key.
+        ContentCryptoMaterial contentCryptoMaterial(ContentCryptoScheme::GCM);
+        contentCryptoMaterial.AddMaterialsDescription("purpose", "test");
+        ASSERT_TRUE(encryptionMaterials.EncryptCEK(contentCryptoMaterial).IsSuccess());
+        ASSERT_EQ(myClient->m_genDataKeyCalledCount, 4u);
+    }
+
+    //This tests that decrypted keys are cached by encrypted key, and expire.
+    TEST_F(KMSWithContextEncryptionMaterialsTest, TestKeyCacheDecryptsOnce)
+    {
+        auto myClient = Aws::MakeShared<MockKMSClient>(AllocationTag, ClientConfiguration());
+        InitMockKMSClient(myClient);
+
+        KMSKeyCacheConfiguration cacheConfig;
+        cacheConfig.timeToLive = std::chrono::milliseconds(500);
+        KMSWithContextEncryptionMaterials encryptionMaterials(TEST_CMK_ID, myClient);
+        encryptionMaterials.SetKeyCache(Aws::MakeShared<KMSKeyCache>(AllocationTag, cacheConfig));
+
+        ContentCryptoMaterial contentCryptoMaterial(ContentCryptoScheme::GCM);
+        ASSERT_TRUE(encryptionMaterials.EncryptCEK(contentCryptoMaterial).IsSuccess());
+
+        for (size_t i = 0; i < 3; ++i)
+        {
+            ContentCryptoMaterial encryptedContentCryptoMaterial = MakeEncryptedContentCryptoMaterial(contentCryptoMaterial);
+            ASSERT_TRUE(encryptionMaterials.DecryptCEK(encryptedContentCryptoMaterial).IsSuccess());
+            ASSERT_EQ(myClient->m_decryptedKey, encryptedContentCryptoMaterial.GetContentEncryptionKey());
+        }
+        ASSERT_EQ(myClient->m_decryptCalledCount, 1u);
+
+        //Another encrypted key is a cache miss.
+        ContentCryptoMaterial otherContentCryptoMaterial = MakeEncryptedContentCryptoMaterial(contentCryptoMaterial);
+        otherContentCryptoMaterial.SetEncryptedContentEncryptionKey(SymmetricCipher::GenerateKey());
+        ASSERT_TRUE(encryptionMaterials.DecryptCEK(otherContentCryptoMaterial).IsSuccess());
+        ASSERT_EQ(myClient->m_decryptCalledCount, 2u);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(600));
+        ContentCryptoMaterial encryptedContentCryptoMaterial = MakeEncryptedContentCryptoMaterial(contentCryptoMaterial);
+        ASSERT_TRUE(encryptionMaterials.DecryptCEK(encryptedContentCryptoMaterial).IsSuccess());
+        ASSERT_EQ(myClient->m_decryptCalledCount, 3u);
+    }
+
+    //This tests that threads decrypting the same key at the same time share one KMS call.
+    TEST_F(KMSWithContextEncryptionMaterialsTest, TestKeyCacheDeduplicatesConcurrentDecrypts)
+    {
+        auto myClient = Aws::MakeShared<SlowDecryptMockKMSClient>(AllocationTag);
+        myClient->PopulateFields(TEST_CMK_ID, SymmetricCipher::GenerateKey(), SymmetricCipher::GenerateKey());
+
+        KMSWithContextEncryptionMaterials encryptionMaterials(TEST_CMK_ID, myClient);
+        encryptionMaterials.SetKeyCache(Aws::MakeShared<KMSKeyCache>(AllocationTag));
+
+        ContentCryptoMaterial contentCryptoMaterial(ContentCryptoScheme::GCM);
+        ASSERT_TRUE(encryptionMaterials.EncryptCEK(contentCryptoMaterial).IsSuccess());
+
+        const size_t threadCount = 8;
+        Aws::Vector<ContentCryptoMaterial> materials(threadCount, MakeEncryptedContentCryptoMaterial(contentCryptoMaterial));
+        Aws::Vector<int> succeeded(threadCount, 0);
+        Aws::Vector<std::thread> threads;
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([&, i]() { succeeded[i] = encryptionMaterials.DecryptCEK(materials[i]).IsSuccess(); });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            ASSERT_EQ(succeeded[i], 1);
+            ASSERT_EQ(myClient->m_decryptedKey, materials[i].GetContentEncryptionKey());
+        }
+        ASSERT_EQ(myClient->m_decryptCalledCount, 1u);
+    }
 }
 
 #endif
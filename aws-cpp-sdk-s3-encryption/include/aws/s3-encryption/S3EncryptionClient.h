@@ -8,6 +8,7 @@
 #include <aws/s3/S3Client.h>
 #include <aws/s3-encryption/modules/CryptoModuleFactory.h>
 #include <aws/core/client/AWSError.h>
+#include <aws/core/utils/threading/Executor.h>
 
 namespace Aws
 {
@@ -42,6 +43,31 @@ namespace Aws
         typedef Aws::Utils::Outcome<Aws::S3::Model::PutObjectResult, Aws::Client::AWSError<S3EncryptionErrors>> S3EncryptionPutObjectOutcome;
         typedef Aws::Utils::Outcome<Aws::S3::Model::GetObjectResult, Aws::Client::AWSError<S3EncryptionErrors>> S3EncryptionGetObjectOutcome;
 
+        /*
+        * Settings for the multipart put and the parallel get of encrypted objects.
+        */
+        struct AWS_S3ENCRYPTION_API S3EncryptionTransferConfiguration
+        {
+            S3EncryptionTransferConfiguration() : partSize(8 * 1024 * 1024), maxConcurrentParts(4)
+            {
+            }
+
+            /*
+            * Executor the parts are uploaded or downloaded on. It can be shared with a TransferManager, but only the threads are shared:
+            * part tracking, retries and progress are handled by these calls, not by the TransferManager.
+            * If not set, each call creates a thread pool of maxConcurrentParts threads.
+            */
+            std::shared_ptr<Aws::Utils::Threading::Executor> executor;
+            /*
+            * Size of each part. Uploads raise it to 5MB, the smallest part S3 accepts.
+            */
+            uint64_t partSize;
+            /*
+            * Number of parts transferred at once. Each of them holds a buffer of partSize bytes.
+            */
+            size_t maxConcurrentParts;
+        };
+
         class AWS_S3ENCRYPTION_API S3EncryptionClientBase
         {
         public:
@@ -84,7 +110,24 @@ namespace Aws
             */
             S3EncryptionGetObjectOutcome GetObject(const Aws::S3::Model::GetObjectRequest& request) const;
 
-            inline bool MultipartUploadSupported() const { return false; }
+            /*
+            * Function to put an object encrypted to S3 as a multipart upload. The body is encrypted one part at a time while up to
+            * transferConfig.maxConcurrentParts parts are uploaded concurrently. The upload is aborted if any part fails.
+            * Only Authenticated Encryption and Strict Authenticated Encryption support multipart uploads.
+            * The context map is used the same way as in PutObject.
+            */
+            S3EncryptionPutObjectOutcome PutObjectMultipart(const Aws::S3::Model::PutObjectRequest& request, const Aws::Map<Aws::String, Aws::String>& contextMap,
+                const S3EncryptionTransferConfiguration& transferConfig = S3EncryptionTransferConfiguration()) const;
+
+            /*
+            * Function to get an object decrypted from S3 with concurrent range gets of transferConfig.partSize bytes.
+            * Parts are decrypted in order as they arrive, so GCM encrypted objects are still authenticated as a whole.
+            * Requests that specify a range are passed on to GetObject.
+            */
+            S3EncryptionGetObjectOutcome GetObjectInParts(const Aws::S3::Model::GetObjectRequest& request,
+                const S3EncryptionTransferConfiguration& transferConfig = S3EncryptionTransferConfiguration()) const;
+
+            inline bool MultipartUploadSupported() const { return true; }
 
         protected:
             /*
@@ -92,6 +135,15 @@ namespace Aws
             */
             Aws::S3::Model::GetObjectOutcome GetInstructionFileObject(const Aws::S3::Model::GetObjectRequest& originalGetRequest) const;
 
+            typedef std::function<S3EncryptionGetObjectOutcome(Aws::S3Encryption::Modules::CryptoModule&, const Aws::S3::Model::HeadObjectResult&,
+                const Aws::Utils::Crypto::ContentCryptoMaterial&)> DecryptObjectFunction;
+
+            /*
+            * Function to read the content crypto material of an object, check it against the crypto configuration and pass it,
+            * with the crypto module to decrypt the object with, to decryptObjectFunction.
+            */
+            S3EncryptionGetObjectOutcome DecryptObject(const Aws::S3::Model::GetObjectRequest& request, const DecryptObjectFunction& decryptObjectFunction) const;
+
             Aws::UniquePtr<Aws::S3::S3Client> m_s3Client;
             Aws::S3Encryption::Modules::CryptoModuleFactory m_cryptoModuleFactory;
             std::shared_ptr<Aws::Utils::Crypto::EncryptionMaterials> m_encryptionMaterials;
@@ -8,6 +8,7 @@
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/kms/KMSClient.h>
 #include <aws/s3-encryption/s3Encryption_EXPORTS.h>
+#include <aws/s3-encryption/materials/KMSKeyCache.h>
 
 #if defined(_MSC_VER) && (_MSC_VER <= 1900 )
 #pragma warning (disable : 4996)
@@ -62,12 +63,25 @@ namespace Aws
                 void SetKMSDecryptWithAnyCMK(bool allow) { m_allowDecryptWithAnyCMK = allow; }
                 bool IsKMSDecryptWithAnyCMKAllowed() const { return m_allowDecryptWithAnyCMK; }
 
+                /*
+                * Sets a cache of content encryption keys to save KMS calls, see KMSKeyCache. No cache is set by default, in which case
+                * every content encryption key is encrypted or decrypted by KMS.
+                */
+                void SetKeyCache(const std::shared_ptr<KMSKeyCache>& keyCache) { m_keyCache = keyCache; }
+                const std::shared_ptr<KMSKeyCache>& GetKeyCache() const { return m_keyCache; }
+
             protected:
                 virtual bool ValidateDecryptCEKMaterials(const Aws::Utils::Crypto::ContentCryptoMaterial& contentCryptoMaterial) const;
 
+                /*
+                * Key of contentCryptoMaterial's content encryption key in m_keyCache. The encrypted key is left out for data keys.
+                */
+                Aws::String BuildKeyCacheKey(const Aws::Utils::Crypto::ContentCryptoMaterial& contentCryptoMaterial, bool includeEncryptedKey) const;
+
                 Aws::String m_customerMasterKeyID;
                 std::shared_ptr<Aws::KMS::KMSClient> m_kmsClient;
                 bool m_allowDecryptWithAnyCMK;
+                std::shared_ptr<KMSKeyCache> m_keyCache;
             };
             /**
              * @deprecated This class is in the maintenance mode, no new updates will be released, use KMSWithContextEncryptionMaterials.
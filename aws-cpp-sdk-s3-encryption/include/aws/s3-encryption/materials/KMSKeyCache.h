@@ -0,0 +1,98 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#pragma once
+#include <aws/s3-encryption/s3Encryption_EXPORTS.h>
+#include <aws/core/utils/Array.h>
+#include <aws/core/utils/ShardedCache.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace Aws
+{
+    namespace S3Encryption
+    {
+        namespace Materials
+        {
+            /*
+            * Settings of a KMSKeyCache.
+            */
+            struct AWS_S3ENCRYPTION_API KMSKeyCacheConfiguration
+            {
+                KMSKeyCacheConfiguration() : maxEntries(1000), timeToLive(std::chrono::minutes(5)), maxEncryptionsPerDataKey(100)
+                {
+                }
+
+                /*
+                * Largest number of data keys, and of decrypted keys, held at once.
+                */
+                size_t maxEntries;
+                /*
+                * How long a key is kept after it was received from KMS.
+                */
+                std::chrono::milliseconds timeToLive;
+                /*
+                * Number of objects a data key encrypts before KMS is asked for a new one. Every object still gets its own IV.
+                * Set it to 1 to only cache decrypted keys.
+                */
+                size_t maxEncryptionsPerDataKey;
+            };
+
+            /*
+            * Cache of content encryption keys for the KMS encryption materials, so that most objects can be encrypted and
+            * decrypted without a KMS call. Data keys are reused for up to maxEncryptionsPerDataKey objects encrypted under the
+            * same encryption context. Decrypted keys are cached by encrypted key and encryption context, and threads decrypting
+            * the same key at the same time share one KMS call. Keys are zeroed when they are evicted.
+            *
+            * Until an entry expires, KMS does not check again whether the caller may use its key. Do not share a cache between
+            * encryption materials of different principals.
+            */
+            class AWS_S3ENCRYPTION_API KMSKeyCache
+            {
+            public:
+                typedef std::function<bool(Aws::Utils::CryptoBuffer& plaintextKey, Aws::Utils::CryptoBuffer& encryptedKey)> GenerateKeyFunction;
+                typedef std::function<bool(Aws::Utils::CryptoBuffer& plaintextKey)> DecryptKeyFunction;
+
+                KMSKeyCache(const KMSKeyCacheConfiguration& config = KMSKeyCacheConfiguration());
+
+                /*
+                * Gets a data key to encrypt one more object under the given encryption context. generateKeyFunction is called when
+                * no key is cached for the context, or the cached one is used up. Returns false if generateKeyFunction failed.
+                */
+                bool GetDataKey(const Aws::String& context, const GenerateKeyFunction& generateKeyFunction,
+                    Aws::Utils::CryptoBuffer& plaintextKey, Aws::Utils::CryptoBuffer& encryptedKey);
+
+                /*
+                * Gets the decrypted key for cacheKey. decryptKeyFunction is called when the key is not cached, unless another thread
+                * is already decrypting it, in which case this waits for that thread's result. Returns false if decryption failed.
+                */
+                bool GetDecryptedKey(const Aws::String& cacheKey, const DecryptKeyFunction& decryptKeyFunction, Aws::Utils::CryptoBuffer& plaintextKey);
+
+                /*
+                * Drops every cached key.
+                */
+                void Clear();
+
+                Aws::Utils::CacheStatistics GetDataKeyStatistics() const { return m_dataKeys.GetStatistics(); }
+                Aws::Utils::CacheStatistics GetDecryptedKeyStatistics() const { return m_decryptedKeys.GetStatistics(); }
+
+            private:
+                struct DataKey;
+                struct PendingDecryption;
+
+                KMSKeyCacheConfiguration m_config;
+                Aws::Utils::ShardedCache<Aws::String, std::shared_ptr<DataKey>> m_dataKeys;
+                Aws::Utils::ShardedCache<Aws::String, Aws::Utils::CryptoBuffer> m_decryptedKeys;
+                std::mutex m_pendingMutex;
+                std::condition_variable m_pendingSignal;
+                Aws::Map<Aws::String, std::shared_ptr<PendingDecryption>> m_pendingDecryptions;
+            };
+        }//namespace Materials
+    }//namespace S3Encryption
+}//namespace Aws
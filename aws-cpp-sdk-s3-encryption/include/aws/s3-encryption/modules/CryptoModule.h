@@ -20,6 +20,10 @@
 #include <aws/s3/model/GetObjectResult.h>
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/HeadObjectRequest.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
 
 namespace Aws
 {
@@ -29,6 +33,23 @@ namespace Aws
         {
             typedef std::function <Aws::S3::Model::PutObjectOutcome(const Aws::S3::Model::PutObjectRequest&)> PutObjectFunction;
             typedef std::function <Aws::S3::Model::GetObjectOutcome(const Aws::S3::Model::GetObjectRequest&)> GetObjectFunction;
+            typedef std::function <Aws::S3::Model::CreateMultipartUploadOutcome(const Aws::S3::Model::CreateMultipartUploadRequest&)> CreateMultipartUploadFunction;
+            typedef std::function <Aws::S3::Model::UploadPartOutcome(const Aws::S3::Model::UploadPartRequest&)> UploadPartFunction;
+            typedef std::function <Aws::S3::Model::CompleteMultipartUploadOutcome(const Aws::S3::Model::CompleteMultipartUploadRequest&)> CompleteMultipartUploadFunction;
+            typedef std::function <Aws::S3::Model::AbortMultipartUploadOutcome(const Aws::S3::Model::AbortMultipartUploadRequest&)> AbortMultipartUploadFunction;
+
+            /*
+             * The S3 operations a multipart upload is made of. putObject is only used to put the instruction file.
+             * uploadPart is called from the executor's threads.
+             */
+            struct AWS_S3ENCRYPTION_API MultipartUploadFunctions
+            {
+                PutObjectFunction putObject;
+                CreateMultipartUploadFunction createMultipartUpload;
+                UploadPartFunction uploadPart;
+                CompleteMultipartUploadFunction completeMultipartUpload;
+                AbortMultipartUploadFunction abortMultipartUpload;
+            };
 
             class AWS_S3ENCRYPTION_API CryptoModule
             {
@@ -55,6 +76,20 @@ namespace Aws
                 S3EncryptionGetObjectOutcome GetObjectSecurely(const Aws::S3::Model::GetObjectRequest& request, const Aws::S3::Model::HeadObjectResult& headObjectResult,
                     const Aws::Utils::Crypto::ContentCryptoMaterial& contentCryptoMaterial, const GetObjectFunction& getObjectFunction);
 
+                /*
+                * Function to put an encrypted object to S3 as a multipart upload. The body is encrypted in order, one part at a time, while up to
+                * transferConfig.maxConcurrentParts encrypted parts are uploaded at once. Only supported by the modules that encrypt with AES-GCM.
+                */
+                S3EncryptionPutObjectOutcome PutObjectSecurelyInParts(const Aws::S3::Model::PutObjectRequest& request, const MultipartUploadFunctions& functions,
+                    const S3EncryptionTransferConfiguration& transferConfig, const Aws::Map<Aws::String, Aws::String>& contextMap = {});
+
+                /*
+                * Function to get an encrypted object from S3 with concurrent range gets of transferConfig.partSize bytes. The parts are decrypted in order
+                * as they arrive, so the tag of a GCM encrypted object is still verified. The request must not specify a range.
+                */
+                S3EncryptionGetObjectOutcome GetObjectSecurelyInParts(const Aws::S3::Model::GetObjectRequest& request, const Aws::S3::Model::HeadObjectResult& headObjectResult,
+                    const Aws::Utils::Crypto::ContentCryptoMaterial& contentCryptoMaterial, const GetObjectFunction& getObjectFunction, const S3EncryptionTransferConfiguration& transferConfig);
+
                 /*
                 * Function to parse range of a get object request and return a pair containing the lower and upper bounds.
                 */
@@ -71,6 +106,11 @@ namespace Aws
                 */
                 S3EncryptionGetObjectOutcome UnwrapAndMakeRequestWithCipher(Aws::S3::Model::GetObjectRequest& request, const GetObjectFunction& getObjectFunction, int16_t firstBlockOffset = 0);
 
+                /*
+                * This function puts the content crypto material in an instruction file, or in the metadata of the given request, depending on the storage method.
+                */
+                S3EncryptionPutObjectOutcome StoreContentCryptoMaterial(Aws::S3::Model::PutObjectRequest& request, const PutObjectFunction& putObjectFunction);
+
             protected:
                 /*
                 * This function sets the content length of the put object request, accounting for any additional content appended after encryption.
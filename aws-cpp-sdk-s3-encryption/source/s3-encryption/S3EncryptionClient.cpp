@@ -47,7 +47,43 @@ namespace Aws
             return module->PutObjectSecurely(request, putObjectFunction, contextMap);
         }
 
+        S3EncryptionPutObjectOutcome S3EncryptionClientBase::PutObjectMultipart(const Aws::S3::Model::PutObjectRequest& request, const Aws::Map<Aws::String, Aws::String>& contextMap,
+            const S3EncryptionTransferConfiguration& transferConfig) const
+        {
+            auto module = m_cryptoModuleFactory.FetchCryptoModule(m_encryptionMaterials, m_cryptoConfig);
+            Modules::MultipartUploadFunctions functions;
+            functions.putObject = [this](const PutObjectRequest& putRequest) { return m_s3Client->PutObject(putRequest); };
+            functions.createMultipartUpload = [this](const CreateMultipartUploadRequest& createRequest) { return m_s3Client->CreateMultipartUpload(createRequest); };
+            functions.uploadPart = [this](const UploadPartRequest& uploadRequest) { return m_s3Client->UploadPart(uploadRequest); };
+            functions.completeMultipartUpload = [this](const CompleteMultipartUploadRequest& completeRequest) { return m_s3Client->CompleteMultipartUpload(completeRequest); };
+            functions.abortMultipartUpload = [this](const AbortMultipartUploadRequest& abortRequest) { return m_s3Client->AbortMultipartUpload(abortRequest); };
+            return module->PutObjectSecurelyInParts(request, functions, transferConfig, contextMap);
+        }
+
         S3EncryptionGetObjectOutcome S3EncryptionClientBase::GetObject(const Aws::S3::Model::GetObjectRequest & request) const
+        {
+            auto getObjectFunction = [this](const Aws::S3::Model::GetObjectRequest& getRequest) { return m_s3Client->GetObject(getRequest); };
+            return DecryptObject(request, [&](Modules::CryptoModule& module, const HeadObjectResult& headObjectResult, const ContentCryptoMaterial& contentCryptoMaterial)
+                {
+                    return module.GetObjectSecurely(request, headObjectResult, contentCryptoMaterial, getObjectFunction);
+                });
+        }
+
+        S3EncryptionGetObjectOutcome S3EncryptionClientBase::GetObjectInParts(const Aws::S3::Model::GetObjectRequest& request, const S3EncryptionTransferConfiguration& transferConfig) const
+        {
+            if (request.RangeHasBeenSet())
+            {
+                return GetObject(request);
+            }
+
+            auto getObjectFunction = [this](const Aws::S3::Model::GetObjectRequest& getRequest) { return m_s3Client->GetObject(getRequest); };
+            return DecryptObject(request, [&](Modules::CryptoModule& module, const HeadObjectResult& headObjectResult, const ContentCryptoMaterial& contentCryptoMaterial)
+                {
+                    return module.GetObjectSecurelyInParts(request, headObjectResult, contentCryptoMaterial, getObjectFunction, transferConfig);
+                });
+        }
+
+        S3EncryptionGetObjectOutcome S3EncryptionClientBase::DecryptObject(const Aws::S3::Model::GetObjectRequest& request, const DecryptObjectFunction& decryptObjectFunction) const
         {
             Aws::S3::Model::HeadObjectRequest headRequest;
             headRequest.WithBucket(request.GetBucket());
@@ -127,8 +163,7 @@ namespace Aws
             }
 
             auto module = m_cryptoModuleFactory.FetchCryptoModule(m_encryptionMaterials, decryptionCryptoConfig);
-            auto getObjectFunction = [this](const Aws::S3::Model::GetObjectRequest& getRequest) { return m_s3Client->GetObject(getRequest); };
-            return module->GetObjectSecurely(request, headOutcome.GetResult(), contentCryptoMaterial, getObjectFunction);
+            return decryptObjectFunction(*module, headOutcome.GetResult(), contentCryptoMaterial);
         }
 
         Aws::S3::Model::GetObjectOutcome S3EncryptionClientBase::GetInstructionFileObject(const Aws::S3::Model::GetObjectRequest & originalGetRequest) const
@@ -9,6 +9,7 @@
 #include <aws/core/utils/Outcome.h>
 #include <aws/core/utils/HashingUtils.h>
 #include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
 
 using namespace Aws;
 using namespace Aws::Utils;
@@ -55,19 +56,35 @@ namespace Aws
 
                 request.SetPlaintext(contentCryptoMaterial.GetContentEncryptionKey());
 
-                EncryptOutcome outcome = m_kmsClient->Encrypt(request);
-                if (!outcome.IsSuccess())
+                auto encryptKey = [&](CryptoBuffer& plaintextKey, CryptoBuffer& encryptedKey) -> bool
+                {
+                    EncryptOutcome outcome = m_kmsClient->Encrypt(request);
+                    if (!outcome.IsSuccess())
+                    {
+                        AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "KMS encryption call not successful: "
+                            << outcome.GetError().GetExceptionName() << " : " << outcome.GetError().GetMessage());
+                        return false;
+                    }
+                    plaintextKey = contentCryptoMaterial.GetContentEncryptionKey();
+                    encryptedKey = outcome.GetResult().GetCiphertextBlob();
+                    return true;
+                };
+
+                contentCryptoMaterial.SetKeyWrapAlgorithm(KeyWrapAlgorithm::KMS);
+                CryptoBuffer plaintextKey;
+                CryptoBuffer encryptedKey;
+                bool encrypted = m_keyCache ? m_keyCache->GetDataKey(BuildKeyCacheKey(contentCryptoMaterial, false), encryptKey, plaintextKey, encryptedKey)
+                    : encryptKey(plaintextKey, encryptedKey);
+                if (!encrypted)
                 {
-                    AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "KMS encryption call not successful: "
-                        << outcome.GetError().GetExceptionName() << " : " << outcome.GetError().GetMessage());
                     //return without changing the encrypted content encryption key
                     return CryptoOutcome(AWSError<CryptoErrors>(CryptoErrors::ENCRYPT_CONTENT_ENCRYPTION_KEY_FAILED, "EncryptContentEncryptionKeyFailed", "Failed to encrypt content encryption key(CEK)", false/*not retryable*/));
                 }
 
-                EncryptResult result = outcome.GetResult();
-                contentCryptoMaterial.SetKeyWrapAlgorithm(KeyWrapAlgorithm::KMS);
-                contentCryptoMaterial.SetEncryptedContentEncryptionKey(result.GetCiphertextBlob());
-                contentCryptoMaterial.SetFinalCEK(result.GetCiphertextBlob());
+                // A data key reused from the cache replaces the content encryption key generated for this object.
+                contentCryptoMaterial.SetContentEncryptionKey(plaintextKey);
+                contentCryptoMaterial.SetEncryptedContentEncryptionKey(encryptedKey);
+                contentCryptoMaterial.SetFinalCEK(encryptedKey);
                 return CryptoOutcome(Aws::NoResult());
             }
 
@@ -103,21 +120,32 @@ namespace Aws
                 request.SetEncryptionContext(contentCryptoMaterial.GetMaterialsDescription());
                 request.SetCiphertextBlob(encryptedContentEncryptionKey);
 
-                DecryptOutcome outcome = m_kmsClient->Decrypt(request);
-                if (!outcome.IsSuccess())
+                auto decryptKey = [&](CryptoBuffer& plaintextKey) -> bool
                 {
-                    AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "KMS decryption not successful: "
-                        << outcome.GetError().GetExceptionName() << outcome.GetError().GetMessage());
-                    return errorOutcome;
-                }
+                    DecryptOutcome outcome = m_kmsClient->Decrypt(request);
+                    if (!outcome.IsSuccess())
+                    {
+                        AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "KMS decryption not successful: "
+                            << outcome.GetError().GetExceptionName() << outcome.GetError().GetMessage());
+                        return false;
+                    }
+                    plaintextKey = CryptoBuffer(outcome.GetResult().GetPlaintext());
+                    if (plaintextKey.GetLength() == 0u)
+                    {
+                        AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "Content Encryption Key could not be decrypted.");
+                        return false;
+                    }
+                    return true;
+                };
 
-                DecryptResult result = outcome.GetResult();
-                contentCryptoMaterial.SetContentEncryptionKey(CryptoBuffer(result.GetPlaintext()));
-                if (contentCryptoMaterial.GetContentEncryptionKey().GetLength() == 0u)
+                CryptoBuffer plaintextKey;
+                bool decrypted = m_keyCache ? m_keyCache->GetDecryptedKey(BuildKeyCacheKey(contentCryptoMaterial, true), decryptKey, plaintextKey)
+                    : decryptKey(plaintextKey);
+                if (!decrypted)
                 {
-                    AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "Content Encryption Key could not be decrypted.");
                     return errorOutcome;
                 }
+                contentCryptoMaterial.SetContentEncryptionKey(plaintextKey);
                 return CryptoOutcome(Aws::NoResult());
             }
 
@@ -145,6 +173,24 @@ namespace Aws
                 }
             }
 
+            Aws::String KMSEncryptionMaterialsBase::BuildKeyCacheKey(const ContentCryptoMaterial& contentCryptoMaterial, bool includeEncryptedKey) const
+            {
+                // Every part is length prefixed, so that different materials cannot produce the same key.
+                Aws::StringStream ss;
+                ss << m_customerMasterKeyID.size() << ':' << m_customerMasterKeyID
+                   << static_cast<int>(contentCryptoMaterial.GetKeyWrapAlgorithm()) << ':';
+                if (includeEncryptedKey)
+                {
+                    Aws::String encryptedKey = HashingUtils::Base64Encode(contentCryptoMaterial.GetEncryptedContentEncryptionKey());
+                    ss << encryptedKey.size() << ':' << encryptedKey;
+                }
+                for (const auto& entry : contentCryptoMaterial.GetMaterialsDescription())
+                {
+                    ss << entry.first.size() << ':' << entry.first << entry.second.size() << ':' << entry.second;
+                }
+                return ss.str();
+            }
+
             CryptoOutcome KMSWithContextEncryptionMaterials::EncryptCEK(ContentCryptoMaterial& contentCryptoMaterial)
             {
                 if (contentCryptoMaterial.GetMaterialsDescription().count(kmsEncryptionContextKey))
@@ -161,20 +207,34 @@ namespace Aws
                 contentCryptoMaterial.AddMaterialsDescription(kmsEncryptionContextKey, cekAlg);
                 request.SetEncryptionContext(contentCryptoMaterial.GetMaterialsDescription());
                 request.SetKeySpec(DataKeySpec::AES_256);
-                GenerateDataKeyOutcome outcome = m_kmsClient->GenerateDataKey(request);
-                if (!outcome.IsSuccess())
+                auto generateKey = [&](CryptoBuffer& plaintextKey, CryptoBuffer& encryptedKey) -> bool
+                {
+                    GenerateDataKeyOutcome outcome = m_kmsClient->GenerateDataKey(request);
+                    if (!outcome.IsSuccess())
+                    {
+                        AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "Failed to call KMS GenerateDataKey API with error: "
+                            << outcome.GetError().GetExceptionName() << " : " << outcome.GetError().GetMessage());
+                        return false;
+                    }
+                    plaintextKey = outcome.GetResult().GetPlaintext();
+                    encryptedKey = outcome.GetResult().GetCiphertextBlob();
+                    return true;
+                };
+
+                contentCryptoMaterial.SetKeyWrapAlgorithm(KeyWrapAlgorithm::KMS_CONTEXT);
+                CryptoBuffer plaintextKey;
+                CryptoBuffer encryptedKey;
+                bool generated = m_keyCache ? m_keyCache->GetDataKey(BuildKeyCacheKey(contentCryptoMaterial, false), generateKey, plaintextKey, encryptedKey)
+                    : generateKey(plaintextKey, encryptedKey);
+                if (!generated)
                 {
-                    AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "Failed to call KMS GenerateDataKey API with error: "
-                        << outcome.GetError().GetExceptionName() << " : " << outcome.GetError().GetMessage());
                     //return without changing the encrypted content encryption key
                     return CryptoOutcome(AWSError<CryptoErrors>(CryptoErrors::GENERATE_CONTENT_ENCRYPTION_KEY_FAILED, "GenerateContentEncryptionKeyFailed", "Failed to generate content encryption key(CEK)", false/*not retryable*/));
                 }
 
-                GenerateDataKeyResult result = outcome.GetResult();
-                contentCryptoMaterial.SetKeyWrapAlgorithm(KeyWrapAlgorithm::KMS_CONTEXT);
-                contentCryptoMaterial.SetContentEncryptionKey(result.GetPlaintext());
-                contentCryptoMaterial.SetEncryptedContentEncryptionKey(result.GetCiphertextBlob());
-                contentCryptoMaterial.SetFinalCEK(result.GetCiphertextBlob());
+                contentCryptoMaterial.SetContentEncryptionKey(plaintextKey);
+                contentCryptoMaterial.SetEncryptedContentEncryptionKey(encryptedKey);
+                contentCryptoMaterial.SetFinalCEK(encryptedKey);
                 return CryptoOutcome(Aws::NoResult());
             }
         }//namespace Materials
@@ -0,0 +1,124 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/s3-encryption/materials/KMSKeyCache.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <atomic>
+
+using namespace Aws::Utils;
+
+namespace Aws
+{
+    namespace S3Encryption
+    {
+        namespace Materials
+        {
+            static const char* const ALLOCATION_TAG = "KMSKeyCache";
+
+            struct KMSKeyCache::DataKey
+            {
+                DataKey(const CryptoBuffer& plaintext, const CryptoBuffer& encrypted) : plaintextKey(plaintext), encryptedKey(encrypted), uses(1)
+                {
+                }
+
+                CryptoBuffer plaintextKey;
+                CryptoBuffer encryptedKey;
+                std::atomic<size_t> uses;
+            };
+
+            struct KMSKeyCache::PendingDecryption
+            {
+                PendingDecryption() : done(false), succeeded(false)
+                {
+                }
+
+                bool done;
+                bool succeeded;
+                CryptoBuffer plaintextKey;
+            };
+
+            KMSKeyCache::KMSKeyCache(const KMSKeyCacheConfiguration& config) :
+                m_config(config), m_dataKeys(config.maxEntries), m_decryptedKeys(config.maxEntries)
+            {
+            }
+
+            bool KMSKeyCache::GetDataKey(const Aws::String& context, const GenerateKeyFunction& generateKeyFunction, CryptoBuffer& plaintextKey, CryptoBuffer& encryptedKey)
+            {
+                const bool reuseDataKeys = m_config.maxEncryptionsPerDataKey > 1;
+                std::shared_ptr<DataKey> dataKey;
+                if (reuseDataKeys && m_dataKeys.Get(context, dataKey) && dataKey->uses.fetch_add(1) < m_config.maxEncryptionsPerDataKey)
+                {
+                    plaintextKey = dataKey->plaintextKey;
+                    encryptedKey = dataKey->encryptedKey;
+                    return true;
+                }
+
+                // Threads finding the key used up at the same time each generate a new one; the last one is kept.
+                if (!generateKeyFunction(plaintextKey, encryptedKey))
+                {
+                    return false;
+                }
+                if (reuseDataKeys)
+                {
+                    m_dataKeys.Put(context, Aws::MakeShared<DataKey>(ALLOCATION_TAG, plaintextKey, encryptedKey), m_config.timeToLive);
+                }
+                return true;
+            }
+
+            bool KMSKeyCache::GetDecryptedKey(const Aws::String& cacheKey, const DecryptKeyFunction& decryptKeyFunction, CryptoBuffer& plaintextKey)
+            {
+                if (m_decryptedKeys.Get(cacheKey, plaintextKey))
+                {
+                    return true;
+                }
+
+                std::shared_ptr<PendingDecryption> pending;
+                {
+                    std::unique_lock<std::mutex> locker(m_pendingMutex);
+                    auto iter = m_pendingDecryptions.find(cacheKey);
+                    if (iter != m_pendingDecryptions.end())
+                    {
+                        pending = iter->second;
+                        m_pendingSignal.wait(locker, [&]() { return pending->done; });
+                        plaintextKey = pending->plaintextKey;
+                        return pending->succeeded;
+                    }
+
+                    // The key may have been cached by a decryption that finished since the lookup above.
+                    if (m_decryptedKeys.Get(cacheKey, plaintextKey))
+                    {
+                        return true;
+                    }
+                    pending = Aws::MakeShared<PendingDecryption>(ALLOCATION_TAG);
+                    m_pendingDecryptions[cacheKey] = pending;
+                }
+
+                const bool succeeded = decryptKeyFunction(plaintextKey);
+                if (succeeded)
+                {
+                    m_decryptedKeys.Put(cacheKey, plaintextKey, m_config.timeToLive);
+                }
+
+                {
+                    std::lock_guard<std::mutex> locker(m_pendingMutex);
+                    pending->done = true;
+                    pending->succeeded = succeeded;
+                    if (succeeded)
+                    {
+                        pending->plaintextKey = plaintextKey;
+                    }
+                    m_pendingDecryptions.erase(cacheKey);
+                }
+                m_pendingSignal.notify_all();
+                return succeeded;
+            }
+
+            void KMSKeyCache::Clear()
+            {
+                m_dataKeys.Clear();
+                m_decryptedKeys.Clear();
+            }
+        }//namespace Materials
+    }//namespace S3Encryption
+}//namespace Aws
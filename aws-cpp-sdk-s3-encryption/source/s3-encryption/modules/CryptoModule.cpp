@@ -10,6 +10,13 @@
 #include <aws/core/client/AWSError.h>
 #include <aws/s3/S3Errors.h>
 #include <aws/s3-encryption/S3EncryptionClient.h>
+#include <aws/core/utils/memory/stl/AWSSet.h>
+#include <aws/core/utils/stream/PreallocatedStreamBuf.h>
+#include <aws/core/utils/stream/ResponseStream.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
 
 using namespace Aws::S3;
 using namespace Aws::S3::Model;
@@ -32,6 +39,199 @@ namespace Aws
             static const size_t AES_BLOCK_SIZE = 16u;
             static const size_t BITS_IN_BYTE = 8u;
 
+            static const uint64_t MIN_UPLOAD_PART_SIZE = 5 * 1024 * 1024;
+
+            struct UploadState
+            {
+                UploadState() : inFlight(0), failed(false) {}
+
+                std::mutex mutex;
+                std::condition_variable signal;
+                size_t inFlight;
+                bool failed;
+                AWSError<S3EncryptionErrors> error;
+                Aws::Map<int, CompletedPart> completedParts;
+            };
+
+            struct DownloadState
+            {
+                DownloadState() : inFlight(0), failed(false) {}
+
+                std::mutex mutex;
+                std::condition_variable signal;
+                size_t inFlight;
+                bool failed;
+                AWSError<S3EncryptionErrors> error;
+                Aws::Set<size_t> downloadedParts;
+                GetObjectResult firstPartResult;
+            };
+
+            static CreateMultipartUploadRequest BuildCreateMultipartUploadRequest(const PutObjectRequest& request)
+            {
+                CreateMultipartUploadRequest createRequest;
+                createRequest.SetBucket(request.GetBucket());
+                createRequest.SetKey(request.GetKey());
+                createRequest.SetContentType(request.GetContentType());
+                if (request.ACLHasBeenSet())
+                {
+                    createRequest.SetACL(request.GetACL());
+                }
+                if (request.CacheControlHasBeenSet())
+                {
+                    createRequest.SetCacheControl(request.GetCacheControl());
+                }
+                if (request.ContentDispositionHasBeenSet())
+                {
+                    createRequest.SetContentDisposition(request.GetContentDisposition());
+                }
+                if (request.ContentEncodingHasBeenSet())
+                {
+                    createRequest.SetContentEncoding(request.GetContentEncoding());
+                }
+                if (request.ContentLanguageHasBeenSet())
+                {
+                    createRequest.SetContentLanguage(request.GetContentLanguage());
+                }
+                if (request.ExpiresHasBeenSet())
+                {
+                    createRequest.SetExpires(request.GetExpires());
+                }
+                if (request.GrantFullControlHasBeenSet())
+                {
+                    createRequest.SetGrantFullControl(request.GetGrantFullControl());
+                }
+                if (request.GrantReadHasBeenSet())
+                {
+                    createRequest.SetGrantRead(request.GetGrantRead());
+                }
+                if (request.GrantReadACPHasBeenSet())
+                {
+                    createRequest.SetGrantReadACP(request.GetGrantReadACP());
+                }
+                if (request.GrantWriteACPHasBeenSet())
+                {
+                    createRequest.SetGrantWriteACP(request.GetGrantWriteACP());
+                }
+                if (request.MetadataHasBeenSet())
+                {
+                    createRequest.SetMetadata(request.GetMetadata());
+                }
+                if (request.ServerSideEncryptionHasBeenSet())
+                {
+                    createRequest.SetServerSideEncryption(request.GetServerSideEncryption());
+                }
+                if (request.StorageClassHasBeenSet())
+                {
+                    createRequest.SetStorageClass(request.GetStorageClass());
+                }
+                if (request.WebsiteRedirectLocationHasBeenSet())
+                {
+                    createRequest.SetWebsiteRedirectLocation(request.GetWebsiteRedirectLocation());
+                }
+                if (request.SSECustomerAlgorithmHasBeenSet())
+                {
+                    createRequest.SetSSECustomerAlgorithm(request.GetSSECustomerAlgorithm());
+                }
+                if (request.SSECustomerKeyHasBeenSet())
+                {
+                    createRequest.SetSSECustomerKey(request.GetSSECustomerKey());
+                }
+                if (request.SSECustomerKeyMD5HasBeenSet())
+                {
+                    createRequest.SetSSECustomerKeyMD5(request.GetSSECustomerKeyMD5());
+                }
+                if (request.SSEKMSKeyIdHasBeenSet())
+                {
+                    createRequest.SetSSEKMSKeyId(request.GetSSEKMSKeyId());
+                }
+                if (request.SSEKMSEncryptionContextHasBeenSet())
+                {
+                    createRequest.SetSSEKMSEncryptionContext(request.GetSSEKMSEncryptionContext());
+                }
+                if (request.BucketKeyEnabledHasBeenSet())
+                {
+                    createRequest.SetBucketKeyEnabled(request.GetBucketKeyEnabled());
+                }
+                if (request.RequestPayerHasBeenSet())
+                {
+                    createRequest.SetRequestPayer(request.GetRequestPayer());
+                }
+                if (request.TaggingHasBeenSet())
+                {
+                    createRequest.SetTagging(request.GetTagging());
+                }
+                if (request.ObjectLockModeHasBeenSet())
+                {
+                    createRequest.SetObjectLockMode(request.GetObjectLockMode());
+                }
+                if (request.ObjectLockRetainUntilDateHasBeenSet())
+                {
+                    createRequest.SetObjectLockRetainUntilDate(request.GetObjectLockRetainUntilDate());
+                }
+                if (request.ObjectLockLegalHoldStatusHasBeenSet())
+                {
+                    createRequest.SetObjectLockLegalHoldStatus(request.GetObjectLockLegalHoldStatus());
+                }
+                if (request.ExpectedBucketOwnerHasBeenSet())
+                {
+                    createRequest.SetExpectedBucketOwner(request.GetExpectedBucketOwner());
+                }
+                return createRequest;
+            }
+
+            static UploadPartRequest BuildUploadPartRequest(const PutObjectRequest& request, const Aws::String& uploadId, int partNumber)
+            {
+                UploadPartRequest uploadPartRequest;
+                uploadPartRequest.SetBucket(request.GetBucket());
+                uploadPartRequest.SetKey(request.GetKey());
+                uploadPartRequest.SetUploadId(uploadId);
+                uploadPartRequest.SetPartNumber(partNumber);
+                if (request.SSECustomerAlgorithmHasBeenSet())
+                {
+                    uploadPartRequest.SetSSECustomerAlgorithm(request.GetSSECustomerAlgorithm());
+                }
+                if (request.SSECustomerKeyHasBeenSet())
+                {
+                    uploadPartRequest.SetSSECustomerKey(request.GetSSECustomerKey());
+                }
+                if (request.SSECustomerKeyMD5HasBeenSet())
+                {
+                    uploadPartRequest.SetSSECustomerKeyMD5(request.GetSSECustomerKeyMD5());
+                }
+                if (request.RequestPayerHasBeenSet())
+                {
+                    uploadPartRequest.SetRequestPayer(request.GetRequestPayer());
+                }
+                if (request.ExpectedBucketOwnerHasBeenSet())
+                {
+                    uploadPartRequest.SetExpectedBucketOwner(request.GetExpectedBucketOwner());
+                }
+                return uploadPartRequest;
+            }
+
+            static void AbortMultipartUpload(const PutObjectRequest& request, const Aws::String& uploadId, const AbortMultipartUploadFunction& abortMultipartUploadFunction)
+            {
+                AbortMultipartUploadRequest abortRequest;
+                abortRequest.SetBucket(request.GetBucket());
+                abortRequest.SetKey(request.GetKey());
+                abortRequest.SetUploadId(uploadId);
+                if (request.RequestPayerHasBeenSet())
+                {
+                    abortRequest.SetRequestPayer(request.GetRequestPayer());
+                }
+                if (request.ExpectedBucketOwnerHasBeenSet())
+                {
+                    abortRequest.SetExpectedBucketOwner(request.GetExpectedBucketOwner());
+                }
+                AbortMultipartUploadOutcome abortOutcome = abortMultipartUploadFunction(abortRequest);
+                if (!abortOutcome.IsSuccess())
+                {
+                    AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "S3 abort multipart upload operation not successful for upload " << uploadId << ": "
+                        << abortOutcome.GetError().GetExceptionName() << " : "
+                        << abortOutcome.GetError().GetMessage());
+                }
+            }
+
             CryptoModule::CryptoModule(const std::shared_ptr<EncryptionMaterials>& encryptionMaterials, const CryptoConfiguration & cryptoConfig) :
                 m_encryptionMaterials(encryptionMaterials), m_contentCryptoMaterial(ContentCryptoMaterial()), m_cryptoConfig(cryptoConfig), m_cipher(nullptr)
             {
@@ -51,28 +251,190 @@ namespace Aws
 
                 InitEncryptionCipher();
 
-                if (m_cryptoConfig.GetStorageMethod() == StorageMethod::INSTRUCTION_FILE)
+                auto storeOutcome = StoreContentCryptoMaterial(copyRequest, putObjectFunction);
+                if (!storeOutcome.IsSuccess())
                 {
-                    Handlers::InstructionFileHandler handler;
-                    PutObjectRequest instructionFileRequest;
-                    instructionFileRequest.WithBucket(copyRequest.GetBucket());
-                    instructionFileRequest.WithKey(copyRequest.GetKey());
-                    handler.PopulateRequest(instructionFileRequest, m_contentCryptoMaterial);
-                    PutObjectOutcome instructionOutcome = putObjectFunction(instructionFileRequest);
-                    if (!instructionOutcome.IsSuccess())
+                    return storeOutcome;
+                }
+                return WrapAndMakeRequestWithCipher(copyRequest, putObjectFunction);
+            }
+
+            S3EncryptionPutObjectOutcome CryptoModule::PutObjectSecurelyInParts(const Aws::S3::Model::PutObjectRequest& request, const MultipartUploadFunctions& functions,
+                const S3EncryptionTransferConfiguration& transferConfig, const Aws::Map<Aws::String, Aws::String>& contextMap)
+            {
+                PopulateCryptoContentMaterial();
+                if (m_contentCryptoMaterial.GetContentCryptoScheme() != ContentCryptoScheme::GCM)
+                {
+                    AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "Multipart uploads are only supported with Authenticated Encryption or Strict Authenticated Encryption.");
+                    return S3EncryptionPutObjectOutcome(BuildS3EncryptionError(AWSError<S3Errors>(S3Errors::INVALID_ACTION, "MultipartUploadNotSupported",
+                            "Multipart uploads are only supported with Authenticated Encryption or Strict Authenticated Encryption", false/*not retryable*/)));
+                }
+                m_contentCryptoMaterial.SetMaterialsDescription(contextMap);
+                auto encryptOutcome = m_encryptionMaterials->EncryptCEK(m_contentCryptoMaterial);
+                if (!encryptOutcome.IsSuccess())
+                {
+                    return S3EncryptionPutObjectOutcome(BuildS3EncryptionError(encryptOutcome.GetError()));
+                }
+
+                InitEncryptionCipher();
+
+                PutObjectRequest metadataRequest(request);
+                auto storeOutcome = StoreContentCryptoMaterial(metadataRequest, functions.putObject);
+                if (!storeOutcome.IsSuccess())
+                {
+                    return storeOutcome;
+                }
+
+                CreateMultipartUploadOutcome createOutcome = functions.createMultipartUpload(BuildCreateMultipartUploadRequest(metadataRequest));
+                if (!createOutcome.IsSuccess())
+                {
+                    AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "S3 create multipart upload operation not successful: "
+                        << createOutcome.GetError().GetExceptionName() << " : "
+                        << createOutcome.GetError().GetMessage());
+                    return S3EncryptionPutObjectOutcome(BuildS3EncryptionError(createOutcome.GetError()));
+                }
+                const Aws::String uploadId = createOutcome.GetResult().GetUploadId();
+
+                const uint64_t partSize = (std::max)(transferConfig.partSize, MIN_UPLOAD_PART_SIZE);
+                const size_t maxConcurrentParts = (std::max)(transferConfig.maxConcurrentParts, static_cast<size_t>(1));
+                std::shared_ptr<Aws::Utils::Threading::Executor> executor = transferConfig.executor;
+                if (!executor)
+                {
+                    executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(ALLOCATION_TAG, maxConcurrentParts);
+                }
+
+                auto state = Aws::MakeShared<UploadState>(ALLOCATION_TAG);
+                UploadPartFunction uploadPartFunction = functions.uploadPart;
+                std::shared_ptr<Aws::IOStream> body = request.GetBody();
+                body->clear();
+                body->seekg(0, std::ios_base::beg);
+
+                // Encrypting is far faster than uploading, so the cipher runs on this thread, in order, and only the uploads are concurrent.
+                CryptoBuffer plainText(static_cast<size_t>(partSize));
+                bool lastPart = false;
+                bool cipherFailed = false;
+                for (int partNumber = 1; !lastPart; ++partNumber)
+                {
+                    body->read(reinterpret_cast<char*>(plainText.GetUnderlyingData()), static_cast<std::streamsize>(partSize));
+                    size_t bytesRead = static_cast<size_t>(body->gcount());
+                    lastPart = bytesRead < partSize || body->peek() == std::char_traits<char>::eof();
+
+                    auto cipherText = Aws::MakeShared<CryptoBuffer>(ALLOCATION_TAG);
+                    if (bytesRead == partSize)
                     {
-                        AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "Instruction file put operation not successful: "
-                            << instructionOutcome.GetError().GetExceptionName() << " : "
-                            << instructionOutcome.GetError().GetMessage());
-                        return S3EncryptionPutObjectOutcome(BuildS3EncryptionError(instructionOutcome.GetError()));
+                        *cipherText = m_cipher->EncryptBuffer(plainText);
+                    }
+                    else if (bytesRead > 0)
+                    {
+                        *cipherText = m_cipher->EncryptBuffer(CryptoBuffer(plainText.GetUnderlyingData(), bytesRead));
+                    }
+                    if (lastPart)
+                    {
+                        CryptoBuffer finalBuffer = m_cipher->FinalizeEncryption();
+                        *cipherText = CryptoBuffer({ (ByteBuffer*)cipherText.get(), (ByteBuffer*)&finalBuffer });
+                    }
+                    if (!(*m_cipher))
+                    {
+                        cipherFailed = true;
+                        break;
+                    }
+
+                    {
+                        std::unique_lock<std::mutex> locker(state->mutex);
+                        state->signal.wait(locker, [&]() { return state->failed || state->inFlight < maxConcurrentParts; });
+                        if (state->failed)
+                        {
+                            break;
+                        }
+                        ++state->inFlight;
+                    }
+
+                    UploadPartRequest uploadPartRequest = BuildUploadPartRequest(request, uploadId, partNumber);
+                    uploadPartRequest.SetContentLength(static_cast<long long>(cipherText->GetLength()));
+                    uploadPartRequest.SetBody(Aws::MakeShared<Aws::Utils::Stream::DefaultUnderlyingStream>(ALLOCATION_TAG,
+                            Aws::MakeUnique<Aws::Utils::Stream::PreallocatedStreamBuf>(ALLOCATION_TAG, cipherText->GetUnderlyingData(), cipherText->GetLength())));
+
+                    auto uploadTask = [state, uploadPartFunction, uploadPartRequest, cipherText, partNumber]()
+                    {
+                        UploadPartOutcome outcome = uploadPartFunction(uploadPartRequest);
+                        std::lock_guard<std::mutex> locker(state->mutex);
+                        if (outcome.IsSuccess())
+                        {
+                            state->completedParts[partNumber] = CompletedPart().WithPartNumber(partNumber).WithETag(outcome.GetResult().GetETag());
+                        }
+                        else if (!state->failed)
+                        {
+                            AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "S3 upload part operation not successful for part " << partNumber << ": "
+                                << outcome.GetError().GetExceptionName() << " : "
+                                << outcome.GetError().GetMessage());
+                            state->failed = true;
+                            state->error = BuildS3EncryptionError(outcome.GetError());
+                        }
+                        --state->inFlight;
+                        state->signal.notify_all();
+                    };
+                    if (!executor->Submit(uploadTask))
+                    {
+                        uploadTask();
                     }
                 }
-                else
+
                 {
-                    Handlers::MetadataHandler handler;
-                    handler.PopulateRequest(copyRequest, m_contentCryptoMaterial);
+                    std::unique_lock<std::mutex> locker(state->mutex);
+                    state->signal.wait(locker, [&]() { return state->inFlight == 0; });
                 }
-                return WrapAndMakeRequestWithCipher(copyRequest, putObjectFunction);
+
+                if (cipherFailed || state->failed)
+                {
+                    AbortMultipartUpload(request, uploadId, functions.abortMultipartUpload);
+                    if (cipherFailed)
+                    {
+                        AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "S3 Encryption Client failed to encrypt the object.");
+                        return S3EncryptionPutObjectOutcome(BuildS3EncryptionError(AWSError<S3Errors>(S3Errors::INTERNAL_FAILURE, "FailedToEncryptContent",
+                                "S3 Encryption Client failed to encrypt the object", false/*not retryable*/)));
+                    }
+                    return S3EncryptionPutObjectOutcome(state->error);
+                }
+
+                CompleteMultipartUploadRequest completeRequest;
+                completeRequest.SetBucket(request.GetBucket());
+                completeRequest.SetKey(request.GetKey());
+                completeRequest.SetUploadId(uploadId);
+                if (request.RequestPayerHasBeenSet())
+                {
+                    completeRequest.SetRequestPayer(request.GetRequestPayer());
+                }
+                if (request.ExpectedBucketOwnerHasBeenSet())
+                {
+                    completeRequest.SetExpectedBucketOwner(request.GetExpectedBucketOwner());
+                }
+                CompletedMultipartUpload completedUpload;
+                for (const auto& completedPart : state->completedParts)
+                {
+                    completedUpload.AddParts(completedPart.second);
+                }
+                completeRequest.SetMultipartUpload(completedUpload);
+
+                CompleteMultipartUploadOutcome completeOutcome = functions.completeMultipartUpload(completeRequest);
+                if (!completeOutcome.IsSuccess())
+                {
+                    AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "S3 complete multipart upload operation not successful: "
+                        << completeOutcome.GetError().GetExceptionName() << " : "
+                        << completeOutcome.GetError().GetMessage());
+                    AbortMultipartUpload(request, uploadId, functions.abortMultipartUpload);
+                    return S3EncryptionPutObjectOutcome(BuildS3EncryptionError(completeOutcome.GetError()));
+                }
+
+                const CompleteMultipartUploadResult& completeResult = completeOutcome.GetResult();
+                PutObjectResult result;
+                result.SetETag(completeResult.GetETag());
+                result.SetVersionId(completeResult.GetVersionId());
+                result.SetExpiration(completeResult.GetExpiration());
+                result.SetServerSideEncryption(completeResult.GetServerSideEncryption());
+                result.SetSSEKMSKeyId(completeResult.GetSSEKMSKeyId());
+                result.SetBucketKeyEnabled(completeResult.GetBucketKeyEnabled());
+                result.SetRequestCharged(completeResult.GetRequestCharged());
+                return S3EncryptionPutObjectOutcome(std::move(result));
             }
 
             S3EncryptionGetObjectOutcome CryptoModule::GetObjectSecurely(const Aws::S3::Model::GetObjectRequest& request,
@@ -122,6 +484,211 @@ namespace Aws
                 return UnwrapAndMakeRequestWithCipher(copyRequest, getObjectFunction, firstBlockAdjustment);
             }
 
+            S3EncryptionGetObjectOutcome CryptoModule::GetObjectSecurelyInParts(const Aws::S3::Model::GetObjectRequest& request, const Aws::S3::Model::HeadObjectResult& headObjectResult,
+                const ContentCryptoMaterial& contentCryptoMaterial, const GetObjectFunction& getObjectFunction, const S3EncryptionTransferConfiguration& transferConfig)
+            {
+                m_contentCryptoMaterial = contentCryptoMaterial;
+                if (!request.GetRange().empty())
+                {
+                    AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "Range gets can not be split into parts.");
+                    return S3EncryptionGetObjectOutcome(BuildS3EncryptionError(AWSError<S3Errors>(S3Errors::VALIDATION, "InvalidRangeGet",
+                            "S3 Encryption Client can not split a range get into parts", false/*not retryable*/)));
+                }
+                if (!DecryptionConditionCheck(request.GetRange()))
+                {
+                    return S3EncryptionGetObjectOutcome(BuildS3EncryptionError(AWSError<S3Errors>(S3Errors::VALIDATION, "DecryptionConditionCheckFailed",
+                            "S3 Encryption Client failed to validate the decryption condition", false/*not retryable*/)));
+                }
+                auto decryptOutcome = m_encryptionMaterials->DecryptCEK(m_contentCryptoMaterial);
+                if (!decryptOutcome.IsSuccess())
+                {
+                    return S3EncryptionGetObjectOutcome(BuildS3EncryptionError(decryptOutcome.GetError()));
+                }
+
+                CryptoBuffer tagFromBody = GetTag(request, getObjectFunction);
+                InitDecryptionCipher(0, 0, tagFromBody);
+
+                const int64_t bodyLength = headObjectResult.GetContentLength() - static_cast<int64_t>(m_contentCryptoMaterial.GetCryptoTagLength() / BITS_IN_BYTE);
+                if (bodyLength < 0)
+                {
+                    return S3EncryptionGetObjectOutcome(BuildS3EncryptionError(AWSError<S3Errors>(S3Errors::VALIDATION, "InvalidContentLength",
+                            "S3 Encryption Client received an object shorter than its crypto tag", false/*not retryable*/)));
+                }
+
+                const uint64_t partSize = (std::max)(transferConfig.partSize, static_cast<uint64_t>(AES_BLOCK_SIZE));
+                const size_t partCount = static_cast<size_t>((static_cast<uint64_t>(bodyLength) + partSize - 1) / partSize);
+                const size_t maxConcurrentParts = (std::max)((std::min)(transferConfig.maxConcurrentParts, partCount), static_cast<size_t>(1));
+                std::shared_ptr<Aws::Utils::Threading::Executor> executor = transferConfig.executor;
+                if (!executor && partCount > 0)
+                {
+                    executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(ALLOCATION_TAG, maxConcurrentParts);
+                }
+
+                // Part n is downloaded into buffer n % maxConcurrentParts, which part n - maxConcurrentParts has been decrypted from by then.
+                Aws::Vector<std::shared_ptr<CryptoBuffer>> partBuffers;
+                for (size_t i = 0; i < (std::min)(maxConcurrentParts, partCount); ++i)
+                {
+                    partBuffers.push_back(Aws::MakeShared<CryptoBuffer>(ALLOCATION_TAG, static_cast<size_t>((std::min)(partSize, static_cast<uint64_t>(bodyLength)))));
+                }
+
+                auto state = Aws::MakeShared<DownloadState>(ALLOCATION_TAG);
+                auto partLength = [&](size_t part) { return static_cast<size_t>((std::min)(partSize, static_cast<uint64_t>(bodyLength) - part * partSize)); };
+                auto downloadPart = [&](size_t part)
+                {
+                    auto buffer = partBuffers[part % maxConcurrentParts];
+                    const uint64_t rangeStart = part * partSize;
+                    const size_t length = partLength(part);
+                    Aws::StringStream ss;
+                    ss << "bytes=" << rangeStart << "-" << rangeStart + length - 1;
+
+                    GetObjectRequest partRequest(request);
+                    partRequest.SetRange(ss.str());
+                    if (!partRequest.IfMatchHasBeenSet() && !headObjectResult.GetETag().empty())
+                    {
+                        // Makes sure every part comes from the same object, even if it is overwritten during the download.
+                        partRequest.SetIfMatch(headObjectResult.GetETag());
+                    }
+                    partRequest.SetResponseStreamFactory([buffer, length]()
+                        {
+                            return Aws::New<Aws::Utils::Stream::DefaultUnderlyingStream>(ALLOCATION_TAG,
+                                Aws::MakeUnique<Aws::Utils::Stream::PreallocatedStreamBuf>(ALLOCATION_TAG, buffer->GetUnderlyingData(), length));
+                        });
+
+                    {
+                        std::lock_guard<std::mutex> locker(state->mutex);
+                        ++state->inFlight;
+                    }
+                    auto downloadTask = [state, getObjectFunction, partRequest, buffer, part]()
+                    {
+                        GetObjectOutcome outcome = getObjectFunction(partRequest);
+                        std::lock_guard<std::mutex> locker(state->mutex);
+                        if (outcome.IsSuccess())
+                        {
+                            if (part == 0)
+                            {
+                                state->firstPartResult = outcome.GetResultWithOwnership();
+                            }
+                            state->downloadedParts.insert(part);
+                        }
+                        else if (!state->failed)
+                        {
+                            AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "S3 get operation not successful for part " << part << ": "
+                                << outcome.GetError().GetExceptionName() << " : "
+                                << outcome.GetError().GetMessage());
+                            state->failed = true;
+                            state->error = BuildS3EncryptionError(outcome.GetError());
+                        }
+                        --state->inFlight;
+                        state->signal.notify_all();
+                    };
+                    if (!executor->Submit(downloadTask))
+                    {
+                        downloadTask();
+                    }
+                };
+
+                auto userSuppliedStream = request.GetResponseStreamFactory()();
+                size_t nextPart = 0;
+                for (; nextPart < partBuffers.size(); ++nextPart)
+                {
+                    downloadPart(nextPart);
+                }
+
+                // GCM is decrypted in order, as parts arrive, so the tag covers the whole object.
+                bool cipherFailed = false;
+                for (size_t part = 0; part < partCount; ++part)
+                {
+                    {
+                        std::unique_lock<std::mutex> locker(state->mutex);
+                        state->signal.wait(locker, [&]() { return state->failed || state->downloadedParts.count(part) > 0; });
+                        if (state->failed)
+                        {
+                            break;
+                        }
+                    }
+
+                    const CryptoBuffer& buffer = *partBuffers[part % maxConcurrentParts];
+                    const size_t length = partLength(part);
+                    CryptoBuffer plainText = length == buffer.GetLength() ? m_cipher->DecryptBuffer(buffer) : m_cipher->DecryptBuffer(CryptoBuffer(buffer.GetUnderlyingData(), length));
+                    if (!(*m_cipher))
+                    {
+                        cipherFailed = true;
+                        break;
+                    }
+                    userSuppliedStream->write(reinterpret_cast<const char*>(plainText.GetUnderlyingData()), plainText.GetLength());
+
+                    if (nextPart < partCount)
+                    {
+                        downloadPart(nextPart++);
+                    }
+                }
+
+                {
+                    std::unique_lock<std::mutex> locker(state->mutex);
+                    state->signal.wait(locker, [&]() { return state->inFlight == 0; });
+                }
+
+                if (state->failed && !cipherFailed)
+                {
+                    Aws::Delete(userSuppliedStream);
+                    return S3EncryptionGetObjectOutcome(state->error);
+                }
+
+                if (!cipherFailed)
+                {
+                    CryptoBuffer finalBuffer = m_cipher->FinalizeDecryption();
+                    userSuppliedStream->write(reinterpret_cast<const char*>(finalBuffer.GetUnderlyingData()), finalBuffer.GetLength());
+                }
+                if (cipherFailed || !(*m_cipher))
+                {
+                    Aws::Delete(userSuppliedStream);
+                    AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "S3 Encryption Client failed to decrypt the encrypted object.");
+                    return S3EncryptionGetObjectOutcome(BuildS3EncryptionError(AWSError<S3Errors>(S3Errors::VALIDATION, "FailedToDecryptContent",
+                            "S3 Encryption Client failed to decrypt the encrypted object", false/*not retryable*/)));
+                }
+
+                GetObjectResult result(std::move(state->firstPartResult));
+                if (partCount == 0)
+                {
+                    result.SetMetadata(headObjectResult.GetMetadata());
+                    result.SetETag(headObjectResult.GetETag());
+                    result.SetVersionId(headObjectResult.GetVersionId());
+                    result.SetLastModified(headObjectResult.GetLastModified());
+                    result.SetContentType(headObjectResult.GetContentType());
+                }
+                userSuppliedStream->clear();
+                userSuppliedStream->seekg(0, std::ios_base::beg);
+                result.ReplaceBody(userSuppliedStream);
+                result.SetContentLength(bodyLength);
+                result.SetContentRange("");
+                return S3EncryptionGetObjectOutcome(std::move(result));
+            }
+
+            S3EncryptionPutObjectOutcome CryptoModule::StoreContentCryptoMaterial(Aws::S3::Model::PutObjectRequest& request, const PutObjectFunction& putObjectFunction)
+            {
+                if (m_cryptoConfig.GetStorageMethod() == StorageMethod::INSTRUCTION_FILE)
+                {
+                    Handlers::InstructionFileHandler handler;
+                    PutObjectRequest instructionFileRequest;
+                    instructionFileRequest.WithBucket(request.GetBucket());
+                    instructionFileRequest.WithKey(request.GetKey());
+                    handler.PopulateRequest(instructionFileRequest, m_contentCryptoMaterial);
+                    PutObjectOutcome instructionOutcome = putObjectFunction(instructionFileRequest);
+                    if (!instructionOutcome.IsSuccess())
+                    {
+                        AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "Instruction file put operation not successful: "
+                            << instructionOutcome.GetError().GetExceptionName() << " : "
+                            << instructionOutcome.GetError().GetMessage());
+                        return S3EncryptionPutObjectOutcome(BuildS3EncryptionError(instructionOutcome.GetError()));
+                    }
+                    return S3EncryptionPutObjectOutcome(instructionOutcome.GetResultWithOwnership());
+                }
+
+                Handlers::MetadataHandler handler;
+                handler.PopulateRequest(request, m_contentCryptoMaterial);
+                return S3EncryptionPutObjectOutcome(PutObjectResult());
+            }
+
             S3EncryptionPutObjectOutcome CryptoModule::WrapAndMakeRequestWithCipher(Aws::S3::Model::PutObjectRequest & request, const PutObjectFunction& putObjectFunction)
             {
                 std::shared_ptr<Aws::IOStream> iostream = request.GetBody();
@@ -0,0 +1,214 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/secrets-cache/ParameterCache.h>
+#include <aws/core/auth/AWSCredentials.h>
+#include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/StringUtils.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <aws/ssm/SSMClient.h>
+#include <aws/ssm/model/GetParameterRequest.h>
+#include <aws/ssm/model/GetParametersRequest.h>
+#include <aws/ssm/model/GetParametersByPathRequest.h>
+#include <mutex>
+
+using namespace Aws::SecretsCache;
+using namespace Aws::SSM;
+using namespace Aws::SSM::Model;
+using namespace Aws::Client;
+using namespace Aws::Utils::Threading;
+
+static const char ALLOCATION_TAG[] = "ParameterCacheTest";
+
+namespace
+{
+    /**
+     * Local stand-in for Parameter Store, serving a fixed set of parameters. GetParametersByPath returns pages of 2.
+     * Values read with decryption are prefixed with "decrypted-".
+     */
+    class MockSSMClient : public SSMClient
+    {
+    public:
+        MockSSMClient() : SSMClient(Aws::Auth::AWSCredentials("", ""), ClientConfiguration()),
+            m_getParameterCalls(0), m_getParametersCalls(0), m_getParametersByPathCalls(0)
+        {
+        }
+
+        void AddParameter(const Aws::String& name, const Aws::String& value)
+        {
+            m_parameters[name] = value;
+        }
+
+        GetParameterOutcome GetParameter(const GetParameterRequest& request) const override
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            ++m_getParameterCalls;
+            auto iter = m_parameters.find(request.GetName());
+            if (iter == m_parameters.end())
+            {
+                return GetParameterOutcome(AWSError<SSMErrors>(SSMErrors::PARAMETER_NOT_FOUND, "ParameterNotFound", request.GetName(), false));
+            }
+            GetParameterResult result;
+            result.SetParameter(MakeParameter(iter->first, iter->second, request.GetWithDecryption()));
+            return GetParameterOutcome(result);
+        }
+
+        GetParametersOutcome GetParameters(const GetParametersRequest& request) const override
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            ++m_getParametersCalls;
+            EXPECT_LE(request.GetNames().size(), 10u);
+            GetParametersResult result;
+            for (const auto& name : request.GetNames())
+            {
+                auto iter = m_parameters.find(name);
+                if (iter == m_parameters.end())
+                {
+                    result.AddInvalidParameters(name);
+                }
+                else
+                {
+                    result.AddParameters(MakeParameter(iter->first, iter->second, request.GetWithDecryption()));
+                }
+            }
+            return GetParametersOutcome(result);
+        }
+
+        GetParametersByPathOutcome GetParametersByPath(const GetParametersByPathRequest& request) const override
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            ++m_getParametersByPathCalls;
+            const Aws::String prefix = request.GetPath() + "/";
+            auto iter = request.GetNextToken().empty() ? m_parameters.lower_bound(prefix) : m_parameters.find(request.GetNextToken());
+
+            GetParametersByPathResult result;
+            for (; iter != m_parameters.end() && iter->first.compare(0, prefix.size(), prefix) == 0; ++iter)
+            {
+                if (result.GetParameters().size() == 2)
+                {
+                    result.SetNextToken(iter->first);
+                    break;
+                }
+                result.AddParameters(MakeParameter(iter->first, iter->second, request.GetWithDecryption()));
+            }
+            return GetParametersByPathOutcome(result);
+        }
+
+        mutable size_t m_getParameterCalls;
+        mutable size_t m_getParametersCalls;
+        mutable size_t m_getParametersByPathCalls;
+
+    private:
+        static Parameter MakeParameter(const Aws::String& name, const Aws::String& value, bool withDecryption)
+        {
+            Parameter parameter;
+            parameter.SetName(name);
+            parameter.SetValue(withDecryption ? "decrypted-" + value : value);
+            return parameter;
+        }
+
+        mutable std::mutex m_mutex;
+        Aws::Map<Aws::String, Aws::String> m_parameters;
+    };
+
+    class ParameterCacheTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_client = Aws::MakeShared<MockSSMClient>(ALLOCATION_TAG);
+            m_config.executor = Aws::MakeShared<PooledThreadExecutor>(ALLOCATION_TAG, 1);
+        }
+
+        std::shared_ptr<MockSSMClient> m_client;
+        CacheConfiguration m_config;
+    };
+
+    TEST_F(ParameterCacheTest, CachesParameter)
+    {
+        m_client->AddParameter("/app/key", "value");
+        ParameterCache cache(m_client, m_config);
+
+        auto first = cache.GetParameter("/app/key");
+        ASSERT_TRUE(first.IsSuccess());
+        ASSERT_EQ("decrypted-value", first.GetResult()->GetValue());
+        auto second = cache.GetParameter("/app/key");
+        ASSERT_EQ(first.GetResult(), second.GetResult());
+        ASSERT_EQ(1u, m_client->m_getParameterCalls);
+
+        // Encrypted reads are cached separately.
+        auto encrypted = cache.GetParameter("/app/key", false);
+        ASSERT_EQ("value", encrypted.GetResult()->GetValue());
+        ASSERT_EQ(2u, m_client->m_getParameterCalls);
+
+        cache.Invalidate("/app/key");
+        ASSERT_TRUE(cache.GetParameter("/app/key").IsSuccess());
+        ASSERT_TRUE(cache.GetParameter("/app/key", false).IsSuccess());
+        ASSERT_EQ(4u, m_client->m_getParameterCalls);
+    }
+
+    TEST_F(ParameterCacheTest, ReturnsErrorForMissingParameter)
+    {
+        ParameterCache cache(m_client, m_config);
+        auto outcome = cache.GetParameter("/app/missing");
+        ASSERT_FALSE(outcome.IsSuccess());
+        ASSERT_EQ(SSMErrors::PARAMETER_NOT_FOUND, outcome.GetError().GetErrorType());
+    }
+
+    TEST_F(ParameterCacheTest, WarmUpCachesEveryParameterUnderPath)
+    {
+        for (int i = 0; i < 5; ++i)
+        {
+            m_client->AddParameter("/app/key" + Aws::Utils::StringUtils::to_string(i), "value");
+        }
+        m_client->AddParameter("/other/key", "value");
+        ParameterCache cache(m_client, m_config);
+
+        auto outcome = cache.WarmUp("/app");
+        ASSERT_TRUE(outcome.IsSuccess());
+        ASSERT_EQ(5u, outcome.GetResult());
+        ASSERT_EQ(3u, m_client->m_getParametersByPathCalls);
+
+        for (int i = 0; i < 5; ++i)
+        {
+            auto parameter = cache.GetParameter("/app/key" + Aws::Utils::StringUtils::to_string(i));
+            ASSERT_TRUE(parameter.IsSuccess());
+            ASSERT_EQ("decrypted-value", parameter.GetResult()->GetValue());
+        }
+        ASSERT_EQ(0u, m_client->m_getParameterCalls);
+
+        ASSERT_TRUE(cache.GetParameter("/other/key").IsSuccess());
+        ASSERT_EQ(1u, m_client->m_getParameterCalls);
+    }
+
+    TEST_F(ParameterCacheTest, GetParametersReadsMissesInBatches)
+    {
+        Aws::Vector<Aws::String> names;
+        for (int i = 0; i < 25; ++i)
+        {
+            names.push_back("/app/key" + Aws::Utils::StringUtils::to_string(i));
+            m_client->AddParameter(names.back(), "value");
+        }
+        ParameterCache cache(m_client, m_config);
+        ASSERT_TRUE(cache.GetParameter(names[0]).IsSuccess());
+
+        names.push_back("/app/missing");
+        auto outcome = cache.GetParameters(names);
+        ASSERT_TRUE(outcome.IsSuccess());
+        ASSERT_EQ(25u, outcome.GetResult().size());
+        ASSERT_EQ(0u, outcome.GetResult().count("/app/missing"));
+        ASSERT_EQ(3u, m_client->m_getParametersCalls);
+
+        auto cached = cache.GetParameters(names);
+        ASSERT_TRUE(cached.IsSuccess());
+        ASSERT_EQ(25u, cached.GetResult().size());
+        ASSERT_EQ(outcome.GetResult().at(names[10]), cached.GetResult().at(names[10]));
+        // Only the name that does not exist is read again.
+        ASSERT_EQ(4u, m_client->m_getParametersCalls);
+        ASSERT_EQ(1u, m_client->m_getParameterCalls);
+    }
+}
@@ -0,0 +1,272 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/secrets-cache/SecretCache.h>
+#include <aws/core/auth/AWSCredentials.h>
+#include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <aws/secretsmanager/SecretsManagerClient.h>
+#include <aws/secretsmanager/model/GetSecretValueRequest.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+using namespace Aws::SecretsCache;
+using namespace Aws::SecretsManager;
+using namespace Aws::SecretsManager::Model;
+using namespace Aws::Client;
+using namespace Aws::Utils::Threading;
+
+static const char ALLOCATION_TAG[] = "SecretCacheTest";
+static const char SECRET_ID[] = "test-secret";
+
+namespace
+{
+    /**
+     * Local stand-in for Secrets Manager: answers every GetSecretValue with the current value, after an optional simulated
+     * round trip, and records the requests.
+     */
+    class MockSecretsManagerClient : public SecretsManagerClient
+    {
+    public:
+        MockSecretsManagerClient() : SecretsManagerClient(Aws::Auth::AWSCredentials("", ""), ClientConfiguration()),
+            m_latencyMs(0), m_value("value-1"), m_fail(false), m_calls(0)
+        {
+        }
+
+        GetSecretValueOutcome GetSecretValue(const GetSecretValueRequest& request) const override
+        {
+            if (m_latencyMs > 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(m_latencyMs));
+            }
+            ++m_calls;
+
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_requests.push_back(request);
+            if (m_fail)
+            {
+                return GetSecretValueOutcome(AWSError<SecretsManagerErrors>(SecretsManagerErrors::THROTTLING, "ThrottlingException", "Rate exceeded", true));
+            }
+            GetSecretValueResult result;
+            result.SetName(request.GetSecretId());
+            result.SetSecretString(m_value);
+            result.SetVersionId(request.VersionIdHasBeenSet() ? request.GetVersionId() : "version-of-" + request.GetVersionStage());
+            return GetSecretValueOutcome(result);
+        }
+
+        void SetValue(const Aws::String& value)
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_value = value;
+        }
+
+        void SetFail(bool fail)
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_fail = fail;
+        }
+
+        Aws::Vector<GetSecretValueRequest> GetRequests() const
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_requests;
+        }
+
+        size_t GetCalls() const { return m_calls.load(); }
+
+        long m_latencyMs;
+
+    private:
+        mutable std::mutex m_mutex;
+        Aws::String m_value;
+        bool m_fail;
+        mutable std::atomic<size_t> m_calls;
+        mutable Aws::Vector<GetSecretValueRequest> m_requests;
+    };
+
+    static bool WaitFor(const std::function<bool()>& condition)
+    {
+        for (int i = 0; i < 500; ++i)
+        {
+            if (condition())
+            {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return condition();
+    }
+
+    class SecretCacheTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_client = Aws::MakeShared<MockSecretsManagerClient>(ALLOCATION_TAG);
+            m_config.executor = Aws::MakeShared<PooledThreadExecutor>(ALLOCATION_TAG, 1);
+        }
+
+        std::shared_ptr<MockSecretsManagerClient> m_client;
+        CacheConfiguration m_config;
+    };
+
+    TEST_F(SecretCacheTest, CachesSecretUntilItIsDueForRefresh)
+    {
+        SecretCache cache(m_client, m_config);
+
+        auto first = cache.GetSecretValue(SECRET_ID);
+        ASSERT_TRUE(first.IsSuccess());
+        ASSERT_EQ("value-1", first.GetResult()->GetSecretString());
+
+        auto second = cache.GetSecretValue(SECRET_ID);
+        ASSERT_TRUE(second.IsSuccess());
+        ASSERT_EQ(first.GetResult(), second.GetResult());
+        ASSERT_EQ(1u, m_client->GetCalls());
+        ASSERT_EQ(SECRET_ID, m_client->GetRequests()[0].GetSecretId());
+        ASSERT_EQ("AWSCURRENT", m_client->GetRequests()[0].GetVersionStage());
+    }
+
+    TEST_F(SecretCacheTest, ReturnsStaleSecretWhileRefreshingInBackground)
+    {
+        m_config.refreshInterval = std::chrono::milliseconds(50);
+        SecretCache cache(m_client, m_config);
+        auto first = cache.GetSecretValue(SECRET_ID);
+        ASSERT_TRUE(first.IsSuccess());
+
+        m_client->SetValue("value-2");
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        auto stale = cache.GetSecretValue(SECRET_ID);
+        ASSERT_TRUE(stale.IsSuccess());
+        ASSERT_EQ("value-1", stale.GetResult()->GetSecretString());
+
+        ASSERT_TRUE(WaitFor([&]() { return cache.GetSecretValue(SECRET_ID).GetResult()->GetSecretString() == "value-2"; }));
+        ASSERT_EQ(2u, m_client->GetCalls());
+        // Snapshots handed out are never modified.
+        ASSERT_EQ("value-1", first.GetResult()->GetSecretString());
+    }
+
+    TEST_F(SecretCacheTest, FetchesSecretPastMaxStaleness)
+    {
+        m_config.refreshInterval = std::chrono::milliseconds(20);
+        m_config.maxStaleness = std::chrono::milliseconds(20);
+        SecretCache cache(m_client, m_config);
+        ASSERT_TRUE(cache.GetSecretValue(SECRET_ID).IsSuccess());
+
+        m_client->SetValue("value-2");
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        auto outcome = cache.GetSecretValue(SECRET_ID);
+        ASSERT_TRUE(outcome.IsSuccess());
+        ASSERT_EQ("value-2", outcome.GetResult()->GetSecretString());
+        ASSERT_EQ(2u, m_client->GetCalls());
+    }
+
+    TEST_F(SecretCacheTest, KeepsSecretWhenRefreshFails)
+    {
+        m_config.refreshInterval = std::chrono::milliseconds(20);
+        m_config.refreshRetryInterval = std::chrono::hours(1);
+        SecretCache cache(m_client, m_config);
+        ASSERT_TRUE(cache.GetSecretValue(SECRET_ID).IsSuccess());
+
+        m_client->SetFail(true);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        for (int i = 0; i < 5; ++i)
+        {
+            auto outcome = cache.GetSecretValue(SECRET_ID);
+            ASSERT_TRUE(outcome.IsSuccess());
+            ASSERT_EQ("value-1", outcome.GetResult()->GetSecretString());
+            ASSERT_TRUE(WaitFor([&]() { return m_client->GetCalls() == 2u; }));
+        }
+        // The failed refresh is not retried before refreshRetryInterval.
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ASSERT_EQ(2u, m_client->GetCalls());
+    }
+
+    TEST_F(SecretCacheTest, DoesNotCacheErrors)
+    {
+        SecretCache cache(m_client, m_config);
+        m_client->SetFail(true);
+        auto failed = cache.GetSecretValue(SECRET_ID);
+        ASSERT_FALSE(failed.IsSuccess());
+        ASSERT_EQ(SecretsManagerErrors::THROTTLING, failed.GetError().GetErrorType());
+
+        m_client->SetFail(false);
+        ASSERT_TRUE(cache.GetSecretValue(SECRET_ID).IsSuccess());
+        ASSERT_EQ(2u, m_client->GetCalls());
+    }
+
+    TEST_F(SecretCacheTest, ConcurrentMissesShareOneCall)
+    {
+        m_client->m_latencyMs = 100;
+        SecretCache cache(m_client, m_config);
+
+        const size_t threadCount = 8;
+        Aws::Vector<SecretCache::SecretValuePtr> values(threadCount);
+        Aws::Vector<std::thread> threads;
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([&, i]() { values[i] = cache.GetSecretValue(SECRET_ID).GetResult(); });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        ASSERT_EQ(1u, m_client->GetCalls());
+        for (const auto& value : values)
+        {
+            ASSERT_TRUE(value);
+            ASSERT_EQ(values[0], value);
+        }
+    }
+
+    TEST_F(SecretCacheTest, CachesStagesAndVersionsSeparately)
+    {
+        m_config.refreshInterval = std::chrono::milliseconds(1);
+        m_config.maxStaleness = std::chrono::milliseconds(1);
+        SecretCache cache(m_client, m_config);
+
+        ASSERT_EQ("version-of-AWSCURRENT", cache.GetSecretValue(SECRET_ID).GetResult()->GetVersionId());
+        ASSERT_EQ("version-of-AWSPREVIOUS", cache.GetSecretValue(SECRET_ID, "AWSPREVIOUS").GetResult()->GetVersionId());
+        ASSERT_EQ("v1", cache.GetSecretValueByVersionId(SECRET_ID, "v1").GetResult()->GetVersionId());
+        ASSERT_EQ(3u, m_client->GetCalls());
+        auto requests = m_client->GetRequests();
+        ASSERT_FALSE(requests[2].VersionStageHasBeenSet());
+        ASSERT_EQ("v1", requests[2].GetVersionId());
+
+        // Versions never change, so only the value read by stage is fetched again once stale.
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ASSERT_TRUE(cache.GetSecretValueByVersionId(SECRET_ID, "v1").IsSuccess());
+        ASSERT_EQ(3u, m_client->GetCalls());
+        ASSERT_TRUE(cache.GetSecretValue(SECRET_ID).IsSuccess());
+        ASSERT_EQ(4u, m_client->GetCalls());
+    }
+
+    TEST_F(SecretCacheTest, InvalidateDropsEveryVersionOfSecret)
+    {
+        SecretCache cache(m_client, m_config);
+        ASSERT_TRUE(cache.GetSecretValue(SECRET_ID).IsSuccess());
+        ASSERT_TRUE(cache.GetSecretValueByVersionId(SECRET_ID, "v1").IsSuccess());
+        ASSERT_TRUE(cache.GetSecretValue("other-secret").IsSuccess());
+        ASSERT_EQ(3u, m_client->GetCalls());
+
+        cache.Invalidate(SECRET_ID);
+        ASSERT_TRUE(cache.GetSecretValue("other-secret").IsSuccess());
+        ASSERT_EQ(3u, m_client->GetCalls());
+        ASSERT_TRUE(cache.GetSecretValue(SECRET_ID).IsSuccess());
+        ASSERT_TRUE(cache.GetSecretValueByVersionId(SECRET_ID, "v1").IsSuccess());
+        ASSERT_EQ(5u, m_client->GetCalls());
+
+        cache.Clear();
+        ASSERT_TRUE(cache.GetSecretValue("other-secret").IsSuccess());
+        ASSERT_EQ(6u, m_client->GetCalls());
+    }
+}
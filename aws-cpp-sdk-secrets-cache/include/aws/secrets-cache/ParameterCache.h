@@ -0,0 +1,73 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/secrets-cache/SecretsCache_EXPORTS.h>
+#include <aws/secrets-cache/RefreshingCache.h>
+#include <aws/ssm/SSMErrors.h>
+#include <aws/ssm/model/Parameter.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <memory>
+
+namespace Aws
+{
+    namespace SSM
+    {
+        class SSMClient;
+    }
+
+    namespace SecretsCache
+    {
+        /**
+         * Caches SSM Parameter Store parameters, see RefreshingCache for how they are kept up to date.
+         *
+         * Parameters are cached by name, separately for decrypted and encrypted reads of the same name.
+         */
+        class AWS_SECRETS_CACHE_API ParameterCache
+        {
+        public:
+            typedef RefreshingCache<Aws::SSM::Model::Parameter, Aws::SSM::SSMError> Cache;
+            typedef Cache::ValuePtr ParameterPtr;
+            typedef Cache::GetOutcome GetCachedParameterOutcome;
+            typedef Aws::Utils::Outcome<Aws::Map<Aws::String, ParameterPtr>, Aws::SSM::SSMError> GetCachedParametersOutcome;
+            typedef Aws::Utils::Outcome<size_t, Aws::SSM::SSMError> WarmUpOutcome;
+
+            ParameterCache(const std::shared_ptr<Aws::SSM::SSMClient>& client, const CacheConfiguration& config = CacheConfiguration());
+
+            /**
+             * Returns the parameter called name. name may carry a version or label selector, such as "/app/key:3".
+             */
+            GetCachedParameterOutcome GetParameter(const Aws::String& name, bool withDecryption = true);
+
+            /**
+             * Returns the parameters called names, by name as given. Names that are not cached are read with GetParameters,
+             * 10 at a time, and cached. Names of parameters that do not exist are left out of the result.
+             */
+            GetCachedParametersOutcome GetParameters(const Aws::Vector<Aws::String>& names, bool withDecryption = true);
+
+            /**
+             * Reads every parameter under path with GetParametersByPath and caches it, so that later reads of those parameters
+             * do not call SSM. Returns the number of parameters cached.
+             */
+            WarmUpOutcome WarmUp(const Aws::String& path, bool recursive = true, bool withDecryption = true);
+
+            /**
+             * Drops the cached values of name, decrypted or not.
+             */
+            void Invalidate(const Aws::String& name);
+
+            void Clear();
+
+        private:
+            Cache::FetchFunction MakeFetchFunction(const Aws::String& name, bool withDecryption) const;
+
+            std::shared_ptr<Aws::SSM::SSMClient> m_client;
+            Cache m_cache;
+        };
+    }
+}
@@ -0,0 +1,347 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/secrets-cache/SecretsCache_EXPORTS.h>
+#include <aws/core/utils/CoarseClock.h>
+#include <aws/core/utils/Outcome.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+namespace Aws
+{
+    namespace SecretsCache
+    {
+        /**
+         * Configuration for use with SecretCache and ParameterCache. The data here will be copied directly to the cache.
+         */
+        struct CacheConfiguration
+        {
+            CacheConfiguration() :
+                refreshInterval(std::chrono::minutes(5)), maxStaleness(std::chrono::hours(1)), refreshRetryInterval(std::chrono::seconds(10))
+            {
+            }
+
+            /**
+             * Executor values are refreshed on in the background. If not set, a PooledThreadExecutor with two threads is created.
+             */
+            std::shared_ptr<Aws::Utils::Threading::Executor> executor;
+            /**
+             * Age after which a value is refreshed. The first read past it starts a refresh in the background and is still
+             * answered with the cached value.
+             */
+            std::chrono::milliseconds refreshInterval;
+            /**
+             * How long past refreshInterval a value is still returned while it cannot be refreshed. Past that, reads fetch the
+             * value themselves, and fail if that fails.
+             */
+            std::chrono::milliseconds maxStaleness;
+            /**
+             * Delay before a failed background refresh is tried again.
+             */
+            std::chrono::milliseconds refreshRetryInterval;
+        };
+
+        /**
+         * Cache of immutable values fetched from a service, refreshed in the background. Used by SecretCache and ParameterCache.
+         *
+         * Each key has one fetch function, given when the key is first read or put. Values are handed out as shared snapshots
+         * that are never modified: a refresh swaps in a new snapshot and readers holding the old one keep it alive.
+         *
+         * Reads of cached values take no lock. The map of entries is copied on write and swapped atomically, so adding and
+         * removing keys costs a copy of the map; this suits the few hundred secrets and parameters a service typically reads.
+         * Fetches are single-flight: concurrent reads of a missing key share one call, and at most one refresh per key is in
+         * flight.
+         */
+        template<typename TValue, typename TError>
+        class RefreshingCache
+        {
+        public:
+            typedef std::shared_ptr<const TValue> ValuePtr;
+            typedef Aws::Utils::Outcome<ValuePtr, TError> GetOutcome;
+            typedef Aws::Utils::Outcome<TValue, TError> FetchOutcome;
+            typedef std::function<FetchOutcome()> FetchFunction;
+
+            RefreshingCache(const CacheConfiguration& config, const std::shared_ptr<Aws::Utils::Threading::Executor>& executor) :
+                m_timing(config), m_executor(executor), m_entries(Aws::MakeShared<EntryMap>("RefreshingCache"))
+            {
+            }
+
+            RefreshingCache(const RefreshingCache&) = delete;
+            RefreshingCache& operator=(const RefreshingCache&) = delete;
+
+            /**
+             * Returns the value of key, calling fetch if it is not cached yet or too stale to be returned.
+             * fetch is kept for later refreshes of key, unless key was already known, in which case its fetch function is used.
+             * Values of keys added with refreshes false are never refreshed; use it for values that cannot change.
+             */
+            GetOutcome Get(const Aws::String& key, const FetchFunction& fetch, bool refreshes = true)
+            {
+                std::shared_ptr<Entry> entry = FindEntry(key);
+                if (entry)
+                {
+                    std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&entry->snapshot);
+                    const int64_t now = Aws::Utils::CoarseClock::NowMillis();
+                    if (snapshot && now < snapshot->expiresAt)
+                    {
+                        if (now >= snapshot->refreshAt)
+                        {
+                            StartRefresh(key, entry);
+                        }
+                        return GetOutcome(snapshot->value);
+                    }
+                }
+                else
+                {
+                    entry = InsertEntry(key, fetch, refreshes);
+                }
+                return Fetch(entry);
+            }
+
+            /**
+             * Returns the value of key if it is cached and not too stale, without fetching it. Starts a refresh if it is due.
+             */
+            ValuePtr GetIfPresent(const Aws::String& key)
+            {
+                std::shared_ptr<Entry> entry = FindEntry(key);
+                if (!entry)
+                {
+                    return nullptr;
+                }
+                std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&entry->snapshot);
+                const int64_t now = Aws::Utils::CoarseClock::NowMillis();
+                if (!snapshot || now >= snapshot->expiresAt)
+                {
+                    return nullptr;
+                }
+                if (now >= snapshot->refreshAt)
+                {
+                    StartRefresh(key, entry);
+                }
+                return snapshot->value;
+            }
+
+            /**
+             * Caches value for key as if it had just been fetched. Used to warm the cache with the results of bulk reads.
+             */
+            ValuePtr Put(const Aws::String& key, TValue&& value, const FetchFunction& fetch, bool refreshes = true)
+            {
+                std::shared_ptr<Entry> entry = InsertEntry(key, fetch, refreshes);
+                std::shared_ptr<const Snapshot> snapshot = MakeSnapshot(*entry, std::move(value), m_timing);
+                std::atomic_store(&entry->snapshot, snapshot);
+                return snapshot->value;
+            }
+
+            /**
+             * Removes the keys matching predicate. Snapshots already handed out stay valid.
+             */
+            void EraseIf(const std::function<bool(const Aws::String&)>& predicate)
+            {
+                std::lock_guard<std::mutex> locker(m_writeMutex);
+                std::shared_ptr<EntryMap> entries = Aws::MakeShared<EntryMap>("RefreshingCache", *std::atomic_load(&m_entries));
+                for (auto iter = entries->begin(); iter != entries->end();)
+                {
+                    if (predicate(iter->first))
+                    {
+                        iter = entries->erase(iter);
+                    }
+                    else
+                    {
+                        ++iter;
+                    }
+                }
+                std::atomic_store(&m_entries, std::shared_ptr<const EntryMap>(entries));
+            }
+
+            void Clear()
+            {
+                std::lock_guard<std::mutex> locker(m_writeMutex);
+                std::atomic_store(&m_entries, std::shared_ptr<const EntryMap>(Aws::MakeShared<EntryMap>("RefreshingCache")));
+            }
+
+            size_t GetSize() const
+            {
+                return std::atomic_load(&m_entries)->size();
+            }
+
+        private:
+            struct Timing
+            {
+                Timing(const CacheConfiguration& config) :
+                    refreshIntervalMs(static_cast<int64_t>(config.refreshInterval.count())),
+                    maxStalenessMs(static_cast<int64_t>(config.maxStaleness.count())),
+                    refreshRetryIntervalMs(static_cast<int64_t>(config.refreshRetryInterval.count()))
+                {
+                }
+
+                int64_t refreshIntervalMs;
+                int64_t maxStalenessMs;
+                int64_t refreshRetryIntervalMs;
+            };
+
+            struct Snapshot
+            {
+                ValuePtr value;
+                int64_t refreshAt;
+                int64_t expiresAt;
+            };
+
+            struct Entry
+            {
+                Entry(const FetchFunction& f, bool r) : fetch(f), refreshes(r), fetching(false)
+                {
+                }
+
+                const FetchFunction fetch;
+                const bool refreshes;
+                // Only accessed through std::atomic_load and std::atomic_store.
+                std::shared_ptr<const Snapshot> snapshot;
+
+                std::mutex mutex;
+                std::condition_variable signal;
+                bool fetching;
+                TError lastError;
+            };
+
+            typedef Aws::Map<Aws::String, std::shared_ptr<Entry>> EntryMap;
+
+            static std::shared_ptr<const Snapshot> MakeSnapshot(const Entry& entry, TValue&& value, const Timing& timing)
+            {
+                std::shared_ptr<Snapshot> snapshot = Aws::MakeShared<Snapshot>("RefreshingCache");
+                snapshot->value = Aws::MakeShared<TValue>("RefreshingCache", std::move(value));
+                if (entry.refreshes)
+                {
+                    snapshot->refreshAt = Aws::Utils::CoarseClock::NowMillis() + timing.refreshIntervalMs;
+                    snapshot->expiresAt = snapshot->refreshAt + timing.maxStalenessMs;
+                }
+                else
+                {
+                    snapshot->refreshAt = (std::numeric_limits<int64_t>::max)();
+                    snapshot->expiresAt = (std::numeric_limits<int64_t>::max)();
+                }
+                return snapshot;
+            }
+
+            /**
+             * Calls the entry's fetch function and publishes the result. The caller must have set fetching.
+             */
+            static GetOutcome FetchAndStore(const std::shared_ptr<Entry>& entry, const Timing& timing)
+            {
+                FetchOutcome outcome = entry->fetch();
+
+                std::lock_guard<std::mutex> locker(entry->mutex);
+                entry->fetching = false;
+                entry->signal.notify_all();
+                if (!outcome.IsSuccess())
+                {
+                    entry->lastError = outcome.GetError();
+                    // Keep serving a stale value, but do not try again on every read.
+                    std::shared_ptr<const Snapshot> stale = std::atomic_load(&entry->snapshot);
+                    if (stale)
+                    {
+                        std::shared_ptr<Snapshot> retry = Aws::MakeShared<Snapshot>("RefreshingCache", *stale);
+                        retry->refreshAt = (std::min)(Aws::Utils::CoarseClock::NowMillis() + timing.refreshRetryIntervalMs, stale->expiresAt);
+                        std::atomic_store(&entry->snapshot, std::shared_ptr<const Snapshot>(retry));
+                    }
+                    return GetOutcome(outcome.GetError());
+                }
+
+                std::shared_ptr<const Snapshot> snapshot = MakeSnapshot(*entry, outcome.GetResultWithOwnership(), timing);
+                std::atomic_store(&entry->snapshot, snapshot);
+                return GetOutcome(snapshot->value);
+            }
+
+            GetOutcome Fetch(const std::shared_ptr<Entry>& entry)
+            {
+                std::unique_lock<std::mutex> locker(entry->mutex);
+                if (entry->fetching)
+                {
+                    entry->signal.wait(locker, [&]() { return !entry->fetching; });
+                    std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&entry->snapshot);
+                    if (snapshot && Aws::Utils::CoarseClock::NowMillis() < snapshot->expiresAt)
+                    {
+                        return GetOutcome(snapshot->value);
+                    }
+                    return GetOutcome(entry->lastError);
+                }
+                entry->fetching = true;
+                locker.unlock();
+                return FetchAndStore(entry, m_timing);
+            }
+
+            void StartRefresh(const Aws::String& key, const std::shared_ptr<Entry>& entry)
+            {
+                {
+                    std::lock_guard<std::mutex> locker(entry->mutex);
+                    // Another read may have refreshed the value since this one looked at it.
+                    std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&entry->snapshot);
+                    if (entry->fetching || (snapshot && Aws::Utils::CoarseClock::NowMillis() < snapshot->refreshAt))
+                    {
+                        return;
+                    }
+                    entry->fetching = true;
+                }
+
+                const Timing timing = m_timing;
+                bool submitted = m_executor->Submit([key, entry, timing]()
+                {
+                    GetOutcome outcome = FetchAndStore(entry, timing);
+                    if (!outcome.IsSuccess())
+                    {
+                        AWS_LOGSTREAM_WARN("RefreshingCache", "Failed to refresh cached value of " << key << ", keeping the current value: "
+                            << outcome.GetError().GetExceptionName() << " : " << outcome.GetError().GetMessage());
+                    }
+                });
+                if (!submitted)
+                {
+                    std::lock_guard<std::mutex> locker(entry->mutex);
+                    entry->fetching = false;
+                    entry->signal.notify_all();
+                }
+            }
+
+            std::shared_ptr<Entry> FindEntry(const Aws::String& key) const
+            {
+                std::shared_ptr<const EntryMap> entries = std::atomic_load(&m_entries);
+                auto iter = entries->find(key);
+                return iter == entries->end() ? nullptr : iter->second;
+            }
+
+            std::shared_ptr<Entry> InsertEntry(const Aws::String& key, const FetchFunction& fetch, bool refreshes)
+            {
+                std::lock_guard<std::mutex> locker(m_writeMutex);
+                std::shared_ptr<const EntryMap> current = std::atomic_load(&m_entries);
+                auto iter = current->find(key);
+                if (iter != current->end())
+                {
+                    return iter->second;
+                }
+
+                std::shared_ptr<EntryMap> entries = Aws::MakeShared<EntryMap>("RefreshingCache", *current);
+                std::shared_ptr<Entry> entry = Aws::MakeShared<Entry>("RefreshingCache", fetch, refreshes);
+                entries->emplace(key, entry);
+                std::atomic_store(&m_entries, std::shared_ptr<const EntryMap>(entries));
+                return entry;
+            }
+
+            const Timing m_timing;
+            std::shared_ptr<Aws::Utils::Threading::Executor> m_executor;
+            std::mutex m_writeMutex;
+            // Only accessed through std::atomic_load and std::atomic_store.
+            std::shared_ptr<const EntryMap> m_entries;
+        };
+    }
+}
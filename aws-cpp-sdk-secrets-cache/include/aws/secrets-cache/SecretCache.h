@@ -0,0 +1,63 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/secrets-cache/SecretsCache_EXPORTS.h>
+#include <aws/secrets-cache/RefreshingCache.h>
+#include <aws/secretsmanager/SecretsManagerErrors.h>
+#include <aws/secretsmanager/model/GetSecretValueResult.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <memory>
+
+namespace Aws
+{
+    namespace SecretsManager
+    {
+        class SecretsManagerClient;
+    }
+
+    namespace SecretsCache
+    {
+        /**
+         * Caches GetSecretValue results, see RefreshingCache for how they are kept up to date.
+         *
+         * Values are cached per secret and version stage, or per secret and version ID. A stage can move to another version,
+         * so values read by stage are refreshed; a version never changes, so values read by version ID are not.
+         */
+        class AWS_SECRETS_CACHE_API SecretCache
+        {
+        public:
+            typedef RefreshingCache<Aws::SecretsManager::Model::GetSecretValueResult, Aws::SecretsManager::SecretsManagerError> Cache;
+            typedef Cache::ValuePtr SecretValuePtr;
+            typedef Cache::GetOutcome GetCachedSecretValueOutcome;
+
+            SecretCache(const std::shared_ptr<Aws::SecretsManager::SecretsManagerClient>& client, const CacheConfiguration& config = CacheConfiguration());
+
+            /**
+             * Returns the version of secretId labelled with versionStage, AWSCURRENT by default.
+             */
+            GetCachedSecretValueOutcome GetSecretValue(const Aws::String& secretId, const Aws::String& versionStage = "AWSCURRENT");
+
+            /**
+             * Returns the version versionId of secretId.
+             */
+            GetCachedSecretValueOutcome GetSecretValueByVersionId(const Aws::String& secretId, const Aws::String& versionId);
+
+            /**
+             * Drops every cached version of secretId, for instance after rotating it. secretId must be spelled the way it was read.
+             */
+            void Invalidate(const Aws::String& secretId);
+
+            void Clear();
+
+        private:
+            Cache::FetchFunction MakeFetchFunction(const Aws::String& secretId, const Aws::String& versionId, const Aws::String& versionStage) const;
+
+            std::shared_ptr<Aws::SecretsManager::SecretsManagerClient> m_client;
+            Cache m_cache;
+        };
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/secrets-cache/ParameterCache.h>
+#include <aws/ssm/SSMClient.h>
+#include <aws/ssm/model/GetParameterRequest.h>
+#include <aws/ssm/model/GetParametersRequest.h>
+#include <aws/ssm/model/GetParametersByPathRequest.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <algorithm>
+
+using namespace Aws::SecretsCache;
+using namespace Aws::SSM;
+using namespace Aws::SSM::Model;
+using namespace Aws::Utils::Threading;
+
+static const char CLASS_TAG[] = "ParameterCache";
+// Most names GetParameters accepts in one request.
+static const size_t MAX_NAMES_PER_REQUEST = 10;
+
+static Aws::String MakeKey(const Aws::String& name, bool withDecryption)
+{
+    return (withDecryption ? "decrypted:" : "encrypted:") + name;
+}
+
+ParameterCache::ParameterCache(const std::shared_ptr<SSMClient>& client, const CacheConfiguration& config) :
+    m_client(client),
+    m_cache(config, config.executor ? config.executor : Aws::MakeShared<PooledThreadExecutor>(CLASS_TAG, 2))
+{
+}
+
+ParameterCache::GetCachedParameterOutcome ParameterCache::GetParameter(const Aws::String& name, bool withDecryption)
+{
+    return m_cache.Get(MakeKey(name, withDecryption), MakeFetchFunction(name, withDecryption));
+}
+
+ParameterCache::GetCachedParametersOutcome ParameterCache::GetParameters(const Aws::Vector<Aws::String>& names, bool withDecryption)
+{
+    Aws::Map<Aws::String, ParameterPtr> parameters;
+    Aws::Vector<Aws::String> missing;
+    for (const auto& name : names)
+    {
+        ParameterPtr parameter = m_cache.GetIfPresent(MakeKey(name, withDecryption));
+        if (parameter)
+        {
+            parameters[name] = parameter;
+        }
+        else if (std::find(missing.begin(), missing.end(), name) == missing.end())
+        {
+            missing.push_back(name);
+        }
+    }
+
+    for (size_t begin = 0; begin < missing.size(); begin += MAX_NAMES_PER_REQUEST)
+    {
+        const size_t end = (std::min)(begin + MAX_NAMES_PER_REQUEST, missing.size());
+        GetParametersRequest request;
+        request.SetNames(Aws::Vector<Aws::String>(missing.begin() + begin, missing.begin() + end));
+        request.SetWithDecryption(withDecryption);
+        GetParametersOutcome outcome = m_client->GetParameters(request);
+        if (!outcome.IsSuccess())
+        {
+            return GetCachedParametersOutcome(outcome.GetError());
+        }
+
+        GetParametersResult result = outcome.GetResultWithOwnership();
+        for (auto& parameter : result.GetParameters())
+        {
+            Aws::String name = parameter.GetName();
+            Parameter value = parameter;
+            parameters[name] = m_cache.Put(MakeKey(name, withDecryption), std::move(value), MakeFetchFunction(name, withDecryption));
+        }
+
+        // Names with a selector come back under the parameter's plain name; read those one at a time.
+        const Aws::Vector<Aws::String>& invalidNames = result.GetInvalidParameters();
+        for (size_t i = begin; i < end; ++i)
+        {
+            const Aws::String& name = missing[i];
+            if (parameters.count(name) || std::find(invalidNames.begin(), invalidNames.end(), name) != invalidNames.end())
+            {
+                continue;
+            }
+            GetCachedParameterOutcome parameterOutcome = GetParameter(name, withDecryption);
+            if (!parameterOutcome.IsSuccess())
+            {
+                return GetCachedParametersOutcome(parameterOutcome.GetError());
+            }
+            parameters[name] = parameterOutcome.GetResult();
+        }
+    }
+    return GetCachedParametersOutcome(std::move(parameters));
+}
+
+ParameterCache::WarmUpOutcome ParameterCache::WarmUp(const Aws::String& path, bool recursive, bool withDecryption)
+{
+    GetParametersByPathRequest request;
+    request.SetPath(path);
+    request.SetRecursive(recursive);
+    request.SetWithDecryption(withDecryption);
+
+    size_t cached = 0;
+    do
+    {
+        GetParametersByPathOutcome outcome = m_client->GetParametersByPath(request);
+        if (!outcome.IsSuccess())
+        {
+            return WarmUpOutcome(outcome.GetError());
+        }
+
+        GetParametersByPathResult result = outcome.GetResultWithOwnership();
+        for (const auto& parameter : result.GetParameters())
+        {
+            Parameter value = parameter;
+            m_cache.Put(MakeKey(parameter.GetName(), withDecryption), std::move(value), MakeFetchFunction(parameter.GetName(), withDecryption));
+            ++cached;
+        }
+        request.SetNextToken(result.GetNextToken());
+    } while (!request.GetNextToken().empty());
+
+    return WarmUpOutcome(cached);
+}
+
+void ParameterCache::Invalidate(const Aws::String& name)
+{
+    const Aws::String decryptedKey = MakeKey(name, true);
+    const Aws::String encryptedKey = MakeKey(name, false);
+    m_cache.EraseIf([&](const Aws::String& key) { return key == decryptedKey || key == encryptedKey; });
+}
+
+void ParameterCache::Clear()
+{
+    m_cache.Clear();
+}
+
+ParameterCache::Cache::FetchFunction ParameterCache::MakeFetchFunction(const Aws::String& name, bool withDecryption) const
+{
+    GetParameterRequest request;
+    request.SetName(name);
+    request.SetWithDecryption(withDecryption);
+
+    std::shared_ptr<SSMClient> client = m_client;
+    return [client, request]() -> Cache::FetchOutcome
+    {
+        GetParameterOutcome outcome = client->GetParameter(request);
+        if (!outcome.IsSuccess())
+        {
+            return Cache::FetchOutcome(outcome.GetError());
+        }
+        return Cache::FetchOutcome(outcome.GetResult().GetParameter());
+    };
+}
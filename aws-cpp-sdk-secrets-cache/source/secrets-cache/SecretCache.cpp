@@ -0,0 +1,74 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/secrets-cache/SecretCache.h>
+#include <aws/secretsmanager/SecretsManagerClient.h>
+#include <aws/secretsmanager/model/GetSecretValueRequest.h>
+#include <aws/core/utils/threading/Executor.h>
+
+using namespace Aws::SecretsCache;
+using namespace Aws::SecretsManager;
+using namespace Aws::SecretsManager::Model;
+using namespace Aws::Utils::Threading;
+
+static const char CLASS_TAG[] = "SecretCache";
+
+// Secret IDs cannot contain a newline, so the prefix of a key is unambiguous.
+static Aws::String MakeKeyPrefix(const Aws::String& secretId)
+{
+    return secretId + "\n";
+}
+
+SecretCache::SecretCache(const std::shared_ptr<SecretsManagerClient>& client, const CacheConfiguration& config) :
+    m_client(client),
+    m_cache(config, config.executor ? config.executor : Aws::MakeShared<PooledThreadExecutor>(CLASS_TAG, 2))
+{
+}
+
+SecretCache::GetCachedSecretValueOutcome SecretCache::GetSecretValue(const Aws::String& secretId, const Aws::String& versionStage)
+{
+    return m_cache.Get(MakeKeyPrefix(secretId) + "stage:" + versionStage, MakeFetchFunction(secretId, "", versionStage));
+}
+
+SecretCache::GetCachedSecretValueOutcome SecretCache::GetSecretValueByVersionId(const Aws::String& secretId, const Aws::String& versionId)
+{
+    return m_cache.Get(MakeKeyPrefix(secretId) + "version:" + versionId, MakeFetchFunction(secretId, versionId, ""), false/*versions never change*/);
+}
+
+void SecretCache::Invalidate(const Aws::String& secretId)
+{
+    const Aws::String prefix = MakeKeyPrefix(secretId);
+    m_cache.EraseIf([&prefix](const Aws::String& key) { return key.compare(0, prefix.size(), prefix) == 0; });
+}
+
+void SecretCache::Clear()
+{
+    m_cache.Clear();
+}
+
+SecretCache::Cache::FetchFunction SecretCache::MakeFetchFunction(const Aws::String& secretId, const Aws::String& versionId, const Aws::String& versionStage) const
+{
+    GetSecretValueRequest request;
+    request.SetSecretId(secretId);
+    if (!versionId.empty())
+    {
+        request.SetVersionId(versionId);
+    }
+    if (!versionStage.empty())
+    {
+        request.SetVersionStage(versionStage);
+    }
+
+    std::shared_ptr<SecretsManagerClient> client = m_client;
+    return [client, request]() -> Cache::FetchOutcome
+    {
+        GetSecretValueOutcome outcome = client->GetSecretValue(request);
+        if (!outcome.IsSuccess())
+        {
+            return Cache::FetchOutcome(outcome.GetError());
+        }
+        return Cache::FetchOutcome(outcome.GetResultWithOwnership());
+    };
+}
@@ -0,0 +1,49 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/stream-consumer/CheckpointStore.h>
+#include <aws/core/platform/FileSystem.h>
+
+using namespace Aws::StreamConsumer;
+
+TEST(CheckpointStoreTest, TestInMemoryCheckpoints)
+{
+    InMemoryCheckpointStore store;
+    Aws::String sequenceNumber;
+    ASSERT_FALSE(store.GetCheckpoint("shardId-000000000000", sequenceNumber));
+
+    ASSERT_TRUE(store.SetCheckpoint("shardId-000000000000", "49590338271490256608559692538361571095921575989136588898"));
+    ASSERT_TRUE(store.GetCheckpoint("shardId-000000000000", sequenceNumber));
+    ASSERT_EQ("49590338271490256608559692538361571095921575989136588898", sequenceNumber);
+
+    ASSERT_TRUE(store.SetCheckpoint("shardId-000000000000", SHARD_END_CHECKPOINT));
+    ASSERT_TRUE(store.GetCheckpoint("shardId-000000000000", sequenceNumber));
+    ASSERT_STREQ(SHARD_END_CHECKPOINT, sequenceNumber.c_str());
+}
+
+TEST(CheckpointStoreTest, TestFileCheckpointsSurviveReload)
+{
+    Aws::String fileName = Aws::FileSystem::CreateTempFilePath();
+    {
+        FileCheckpointStore store(fileName);
+        Aws::String sequenceNumber;
+        ASSERT_FALSE(store.GetCheckpoint("shardId-000000000001", sequenceNumber));
+        ASSERT_TRUE(store.SetCheckpoint("shardId-000000000001", "100"));
+        ASSERT_TRUE(store.SetCheckpoint("shardId-000000000002", "200"));
+        ASSERT_TRUE(store.SetCheckpoint("shardId-000000000001", SHARD_END_CHECKPOINT));
+    }
+
+    {
+        FileCheckpointStore store(fileName);
+        Aws::String sequenceNumber;
+        ASSERT_TRUE(store.GetCheckpoint("shardId-000000000001", sequenceNumber));
+        ASSERT_STREQ(SHARD_END_CHECKPOINT, sequenceNumber.c_str());
+        ASSERT_TRUE(store.GetCheckpoint("shardId-000000000002", sequenceNumber));
+        ASSERT_EQ("200", sequenceNumber);
+    }
+
+    Aws::FileSystem::RemoveFileIfExists(fileName.c_str());
+}
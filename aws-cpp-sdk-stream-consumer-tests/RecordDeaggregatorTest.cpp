@@ -0,0 +1,157 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/stream-consumer/RecordDeaggregator.h>
+#include <aws/core/utils/HashingUtils.h>
+
+using namespace Aws::StreamConsumer;
+using namespace Aws::Utils;
+
+namespace
+{
+    void AppendVarint(Aws::String& out, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    void AppendLengthDelimited(Aws::String& out, unsigned field, const Aws::String& value)
+    {
+        AppendVarint(out, (field << 3) | 2);
+        AppendVarint(out, value.size());
+        out.append(value);
+    }
+
+    void AppendVarintField(Aws::String& out, unsigned field, uint64_t value)
+    {
+        AppendVarint(out, field << 3);
+        AppendVarint(out, value);
+    }
+
+    Aws::String BuildSubRecord(uint64_t partitionKeyIndex, const Aws::String& data)
+    {
+        Aws::String record;
+        AppendVarintField(record, 1, partitionKeyIndex);
+        AppendLengthDelimited(record, 3, data);
+        return record;
+    }
+
+    ByteBuffer Frame(const Aws::String& message, bool corruptDigest = false)
+    {
+        static const unsigned char magic[] = { 0xF3, 0x89, 0x9A, 0xC2 };
+        ByteBuffer digest = HashingUtils::CalculateMD5(message);
+        if (corruptDigest)
+        {
+            digest[0] ^= 0xFF;
+        }
+
+        Aws::String framed(reinterpret_cast<const char*>(magic), sizeof(magic));
+        framed.append(message);
+        framed.append(reinterpret_cast<const char*>(digest.GetUnderlyingData()), digest.GetLength());
+        return ByteBuffer(reinterpret_cast<const unsigned char*>(framed.c_str()), framed.size());
+    }
+
+    Aws::String BuildAggregatedMessage()
+    {
+        Aws::String message;
+        AppendLengthDelimited(message, 1, "keyA");
+        AppendLengthDelimited(message, 1, "keyB");
+        AppendLengthDelimited(message, 3, BuildSubRecord(0, "first"));
+        AppendLengthDelimited(message, 3, BuildSubRecord(1, "second"));
+        AppendLengthDelimited(message, 3, BuildSubRecord(0, "third"));
+        return message;
+    }
+
+    ConsumerRecord MakeRecord(const Aws::String& sequenceNumber, const ByteBuffer& data)
+    {
+        ConsumerRecord record;
+        record.sequenceNumber = sequenceNumber;
+        record.partitionKey = "outer";
+        record.data = data;
+        return record;
+    }
+
+    Aws::String ToString(const ByteBuffer& buffer)
+    {
+        return Aws::String(reinterpret_cast<const char*>(buffer.GetUnderlyingData()), buffer.GetLength());
+    }
+}
+
+TEST(RecordDeaggregatorTest, TestPlainRecordsPassThrough)
+{
+    Aws::String payload = "plain payload that is long enough to hold a digest";
+    Aws::Vector<ConsumerRecord> records;
+    records.push_back(MakeRecord("1", ByteBuffer(reinterpret_cast<const unsigned char*>(payload.c_str()), payload.size())));
+
+    ASSERT_FALSE(RecordDeaggregator::IsAggregated(records[0].data));
+    RecordDeaggregator::Deaggregate(records);
+
+    ASSERT_EQ(1u, records.size());
+    ASSERT_FALSE(records[0].aggregated);
+    ASSERT_EQ(payload, ToString(records[0].data));
+    ASSERT_EQ("outer", records[0].partitionKey);
+}
+
+TEST(RecordDeaggregatorTest, TestAggregatedRecordIsExpandedInOrder)
+{
+    Aws::Vector<ConsumerRecord> records;
+    records.push_back(MakeRecord("1", ByteBuffer(reinterpret_cast<const unsigned char*>("before-before-before-before"), 27)));
+    records.push_back(MakeRecord("2", Frame(BuildAggregatedMessage())));
+    records.push_back(MakeRecord("3", ByteBuffer(reinterpret_cast<const unsigned char*>("after-after-after-after-after"), 29)));
+
+    ASSERT_TRUE(RecordDeaggregator::IsAggregated(records[1].data));
+    RecordDeaggregator::Deaggregate(records);
+
+    ASSERT_EQ(5u, records.size());
+    ASSERT_EQ("1", records[0].sequenceNumber);
+    ASSERT_FALSE(records[0].aggregated);
+
+    ASSERT_EQ("2", records[1].sequenceNumber);
+    ASSERT_TRUE(records[1].aggregated);
+    ASSERT_EQ(0, records[1].subSequenceNumber);
+    ASSERT_EQ("keyA", records[1].partitionKey);
+    ASSERT_EQ("first", ToString(records[1].data));
+
+    ASSERT_EQ("2", records[2].sequenceNumber);
+    ASSERT_EQ(1, records[2].subSequenceNumber);
+    ASSERT_EQ("keyB", records[2].partitionKey);
+    ASSERT_EQ("second", ToString(records[2].data));
+
+    ASSERT_EQ(2, records[3].subSequenceNumber);
+    ASSERT_EQ("keyA", records[3].partitionKey);
+    ASSERT_EQ("third", ToString(records[3].data));
+
+    ASSERT_EQ("3", records[4].sequenceNumber);
+    ASSERT_FALSE(records[4].aggregated);
+}
+
+TEST(RecordDeaggregatorTest, TestDigestMismatchPassesRecordThrough)
+{
+    ByteBuffer framed = Frame(BuildAggregatedMessage(), true /*corruptDigest*/);
+    Aws::Vector<ConsumerRecord> out;
+    RecordDeaggregator::Deaggregate(MakeRecord("1", framed), out);
+
+    ASSERT_EQ(1u, out.size());
+    ASSERT_FALSE(out[0].aggregated);
+    ASSERT_EQ(framed.GetLength(), out[0].data.GetLength());
+}
+
+TEST(RecordDeaggregatorTest, TestOutOfRangePartitionKeyIndexPassesRecordThrough)
+{
+    Aws::String message;
+    AppendLengthDelimited(message, 1, "onlyKey");
+    AppendLengthDelimited(message, 3, BuildSubRecord(5, "orphan"));
+
+    Aws::Vector<ConsumerRecord> out;
+    RecordDeaggregator::Deaggregate(MakeRecord("1", Frame(message)), out);
+
+    ASSERT_EQ(1u, out.size());
+    ASSERT_FALSE(out[0].aggregated);
+}
@@ -0,0 +1,468 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/stream-consumer/Scheduler.h>
+#include <aws/core/utils/StringUtils.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <algorithm>
+
+using namespace Aws::StreamConsumer;
+using namespace Aws::Utils::Threading;
+
+static const char ALLOCATION_TAG[] = "SchedulerTest";
+
+namespace
+{
+    struct FakeShard
+    {
+        ShardInfo info;
+        Aws::Vector<Aws::String> payloads;
+        bool closed;
+    };
+
+    /**
+     * In memory stream. Shard iterators are "shardId#offset" and sequence numbers "shardId#offset" as well,
+     * so that both can be decoded without extra state.
+     */
+    class FakeStreamAdapter : public StreamAdapter
+    {
+    public:
+        FakeStreamAdapter() : m_getRecordsCalls(0), m_expireOnCall(-1), m_blockOnCall(-1), m_blocked(false), m_released(false) {}
+
+        void AddShard(const Aws::String& shardId, const Aws::String& parentShardId, size_t recordCount, bool closed)
+        {
+            FakeShard shard;
+            shard.info.shardId = shardId;
+            shard.info.parentShardId = parentShardId;
+            for (size_t i = 0; i < recordCount; ++i)
+            {
+                shard.payloads.push_back(shardId + "-payload-" + Aws::Utils::StringUtils::to_string(i));
+            }
+            shard.closed = closed;
+            m_shards.push_back(shard);
+        }
+
+        void ExpireIteratorOnCall(int call) { m_expireOnCall = call; }
+
+        // Holds the given GetRecords call in flight until Release is called.
+        void BlockOnCall(int call) { m_blockOnCall = call; }
+
+        bool WaitUntilBlocked()
+        {
+            std::unique_lock<std::mutex> locker(m_mutex);
+            return m_signal.wait_for(locker, std::chrono::seconds(10), [this]() { return m_blocked; });
+        }
+
+        void Release()
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_released = true;
+            m_signal.notify_all();
+        }
+
+        ListShardsOutcome ListShards() override
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            Aws::Vector<ShardInfo> shards;
+            for (const auto& shard : m_shards)
+            {
+                shards.push_back(shard.info);
+            }
+            return shards;
+        }
+
+        GetShardIteratorOutcome GetShardIterator(const Aws::String& shardId, IteratorPosition position, const Aws::String& sequenceNumber) override
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            const FakeShard* shard = FindShard(shardId);
+            if (!shard)
+            {
+                return StreamAdapterError(Aws::Client::CoreErrors::RESOURCE_NOT_FOUND, "ResourceNotFoundException", "No such shard", false);
+            }
+
+            size_t offset = 0;
+            switch (position)
+            {
+                case IteratorPosition::TRIM_HORIZON:
+                    offset = 0;
+                    break;
+                case IteratorPosition::LATEST:
+                    offset = shard->payloads.size();
+                    break;
+                case IteratorPosition::AT_SEQUENCE_NUMBER:
+                    offset = DecodeOffset(sequenceNumber);
+                    break;
+                case IteratorPosition::AFTER_SEQUENCE_NUMBER:
+                    offset = DecodeOffset(sequenceNumber) + 1;
+                    break;
+            }
+            m_iteratorRequests.push_back(sequenceNumber);
+            return Encode(shardId, offset);
+        }
+
+        GetRecordsOutcome GetRecords(const Aws::String& shardIterator, int limit) override
+        {
+            std::unique_lock<std::mutex> locker(m_mutex);
+            const int call = m_getRecordsCalls++;
+            m_recordsRequests.push_back(shardIterator);
+            if (call == m_blockOnCall)
+            {
+                m_blocked = true;
+                m_signal.notify_all();
+                m_signal.wait(locker, [this]() { return m_released; });
+            }
+            if (call == m_expireOnCall)
+            {
+                return StreamAdapterError(Aws::Client::CoreErrors::VALIDATION, EXPIRED_ITERATOR_EXCEPTION, "Iterator expired", false);
+            }
+
+            Aws::String shardId = shardIterator.substr(0, shardIterator.find('#'));
+            const FakeShard* shard = FindShard(shardId);
+            size_t offset = DecodeOffset(shardIterator);
+
+            RecordBatch batch;
+            size_t end = (std::min)(shard->payloads.size(), offset + static_cast<size_t>(limit));
+            for (size_t i = offset; i < end; ++i)
+            {
+                ConsumerRecord record;
+                record.sequenceNumber = Encode(shardId, i);
+                record.partitionKey = "key";
+                record.data = Aws::Utils::ByteBuffer(reinterpret_cast<const unsigned char*>(shard->payloads[i].c_str()), shard->payloads[i].size());
+                batch.records.push_back(record);
+            }
+            batch.millisBehindLatest = end < shard->payloads.size() ? 1000 : 0;
+            if (!(shard->closed && end == shard->payloads.size()))
+            {
+                batch.nextShardIterator = Encode(shardId, end);
+            }
+            return batch;
+        }
+
+        Aws::Vector<Aws::String> GetIteratorRequests()
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_iteratorRequests;
+        }
+
+        size_t CountRecordsRequests(const Aws::String& shardIterator)
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return static_cast<size_t>(std::count(m_recordsRequests.begin(), m_recordsRequests.end(), shardIterator));
+        }
+
+    private:
+        static Aws::String Encode(const Aws::String& shardId, size_t offset)
+        {
+            return shardId + "#" + Aws::Utils::StringUtils::to_string(offset);
+        }
+
+        static size_t DecodeOffset(const Aws::String& value)
+        {
+            return static_cast<size_t>(Aws::Utils::StringUtils::ConvertToInt64(value.substr(value.find('#') + 1).c_str()));
+        }
+
+        const FakeShard* FindShard(const Aws::String& shardId) const
+        {
+            for (const auto& shard : m_shards)
+            {
+                if (shard.info.shardId == shardId)
+                {
+                    return &shard;
+                }
+            }
+            return nullptr;
+        }
+
+        std::mutex m_mutex;
+        Aws::Vector<FakeShard> m_shards;
+        Aws::Vector<Aws::String> m_iteratorRequests;
+        Aws::Vector<Aws::String> m_recordsRequests;
+        int m_getRecordsCalls;
+        int m_expireOnCall;
+        int m_blockOnCall;
+        std::condition_variable m_signal;
+        bool m_blocked;
+        bool m_released;
+    };
+
+    /**
+     * Collects what the scheduler delivers and lets the test block until enough records arrived.
+     */
+    class RecordCollector
+    {
+    public:
+        void Attach(SchedulerConfiguration& config)
+        {
+            config.recordsReceivedCallback = [this](const Scheduler*, const ShardInfo& shard, const Aws::Vector<ConsumerRecord>& records)
+            {
+                std::lock_guard<std::mutex> locker(m_mutex);
+                if (!shard.parentShardId.empty() && m_endedShards.find(shard.parentShardId) == m_endedShards.end())
+                {
+                    m_childBeforeParent = true;
+                }
+                for (const auto& record : records)
+                {
+                    m_records[shard.shardId].push_back(Aws::String(reinterpret_cast<const char*>(record.data.GetUnderlyingData()), record.data.GetLength()));
+                    ++m_recordCount;
+                }
+                m_signal.notify_all();
+            };
+            config.shardEndedCallback = [this](const Scheduler*, const ShardInfo& shard)
+            {
+                std::lock_guard<std::mutex> locker(m_mutex);
+                m_endedShards.insert(shard.shardId);
+                m_signal.notify_all();
+            };
+        }
+
+        bool WaitFor(size_t recordCount, size_t endedShardCount)
+        {
+            std::unique_lock<std::mutex> locker(m_mutex);
+            return m_signal.wait_for(locker, std::chrono::seconds(10), [&]()
+            {
+                return m_recordCount >= recordCount && m_endedShards.size() >= endedShardCount;
+            });
+        }
+
+        Aws::Vector<Aws::String> GetRecords(const Aws::String& shardId)
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_records[shardId];
+        }
+
+        bool ChildBeforeParent()
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            return m_childBeforeParent;
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_signal;
+        Aws::Map<Aws::String, Aws::Vector<Aws::String>> m_records;
+        Aws::Set<Aws::String> m_endedShards;
+        size_t m_recordCount = 0;
+        bool m_childBeforeParent = false;
+    };
+
+    SchedulerConfiguration MakeConfiguration(Executor* executor, const std::shared_ptr<StreamAdapter>& adapter)
+    {
+        SchedulerConfiguration config(executor);
+        config.streamAdapter = adapter;
+        config.maxRecordsPerRead = 3;
+        config.idleTimeBetweenReadsMs = 20;
+        config.minTimeBetweenReadsMs = 1;
+        config.shardSyncIntervalMs = 50;
+        config.failureBackoffMs = 5;
+        config.maxPrefetchedBatches = 2;
+        return config;
+    }
+
+    Aws::Vector<Aws::String> ExpectedPayloads(const Aws::String& shardId, size_t from, size_t to)
+    {
+        Aws::Vector<Aws::String> payloads;
+        for (size_t i = from; i < to; ++i)
+        {
+            payloads.push_back(shardId + "-payload-" + Aws::Utils::StringUtils::to_string(i));
+        }
+        return payloads;
+    }
+}
+
+TEST(SchedulerTest, TestChildShardsStartAfterParentCompletes)
+{
+    PooledThreadExecutor executor(4);
+    auto adapter = Aws::MakeShared<FakeStreamAdapter>(ALLOCATION_TAG);
+    adapter->AddShard("shard-0", "", 7, true);
+    adapter->AddShard("shard-1", "shard-0", 4, false);
+    adapter->AddShard("shard-2", "shard-0", 5, true);
+    auto checkpoints = Aws::MakeShared<InMemoryCheckpointStore>(ALLOCATION_TAG);
+
+    RecordCollector collector;
+    SchedulerConfiguration config = MakeConfiguration(&executor, adapter);
+    config.checkpointStore = checkpoints;
+    collector.Attach(config);
+
+    Scheduler scheduler(config);
+    scheduler.Start();
+    ASSERT_TRUE(collector.WaitFor(16, 2));
+    scheduler.Shutdown();
+
+    ASSERT_FALSE(collector.ChildBeforeParent());
+    ASSERT_EQ(ExpectedPayloads("shard-0", 0, 7), collector.GetRecords("shard-0"));
+    ASSERT_EQ(ExpectedPayloads("shard-1", 0, 4), collector.GetRecords("shard-1"));
+    ASSERT_EQ(ExpectedPayloads("shard-2", 0, 5), collector.GetRecords("shard-2"));
+
+    Aws::String checkpoint;
+    ASSERT_TRUE(checkpoints->GetCheckpoint("shard-0", checkpoint));
+    ASSERT_STREQ(SHARD_END_CHECKPOINT, checkpoint.c_str());
+    ASSERT_TRUE(checkpoints->GetCheckpoint("shard-1", checkpoint));
+    ASSERT_EQ("shard-1#3", checkpoint);
+    ASSERT_TRUE(checkpoints->GetCheckpoint("shard-2", checkpoint));
+    ASSERT_STREQ(SHARD_END_CHECKPOINT, checkpoint.c_str());
+
+    auto completed = scheduler.GetCompletedShards();
+    ASSERT_EQ(2u, completed.size());
+    ASSERT_NE(completed.end(), std::find(completed.begin(), completed.end(), "shard-0"));
+    ASSERT_NE(completed.end(), std::find(completed.begin(), completed.end(), "shard-2"));
+}
+
+TEST(SchedulerTest, TestResumesAfterCheckpoint)
+{
+    PooledThreadExecutor executor(2);
+    auto adapter = Aws::MakeShared<FakeStreamAdapter>(ALLOCATION_TAG);
+    adapter->AddShard("shard-0", "", 8, false);
+    auto checkpoints = Aws::MakeShared<InMemoryCheckpointStore>(ALLOCATION_TAG);
+    checkpoints->SetCheckpoint("shard-0", "shard-0#4");
+
+    RecordCollector collector;
+    SchedulerConfiguration config = MakeConfiguration(&executor, adapter);
+    config.checkpointStore = checkpoints;
+    collector.Attach(config);
+
+    Scheduler scheduler(config);
+    scheduler.Start();
+    ASSERT_TRUE(collector.WaitFor(3, 0));
+    scheduler.Shutdown();
+
+    ASSERT_EQ(ExpectedPayloads("shard-0", 5, 8), collector.GetRecords("shard-0"));
+}
+
+TEST(SchedulerTest, TestShardsWithCompletedCheckpointAreSkipped)
+{
+    PooledThreadExecutor executor(2);
+    auto adapter = Aws::MakeShared<FakeStreamAdapter>(ALLOCATION_TAG);
+    adapter->AddShard("shard-0", "", 3, true);
+    adapter->AddShard("shard-1", "shard-0", 2, false);
+    auto checkpoints = Aws::MakeShared<InMemoryCheckpointStore>(ALLOCATION_TAG);
+    checkpoints->SetCheckpoint("shard-0", SHARD_END_CHECKPOINT);
+
+    RecordCollector collector;
+    SchedulerConfiguration config = MakeConfiguration(&executor, adapter);
+    config.checkpointStore = checkpoints;
+    collector.Attach(config);
+
+    Scheduler scheduler(config);
+    scheduler.Start();
+    ASSERT_TRUE(collector.WaitFor(2, 0));
+    scheduler.Shutdown();
+
+    ASSERT_TRUE(collector.GetRecords("shard-0").empty());
+    ASSERT_EQ(ExpectedPayloads("shard-1", 0, 2), collector.GetRecords("shard-1"));
+}
+
+TEST(SchedulerTest, TestExpiredIteratorResumesAfterLastFetchedRecord)
+{
+    PooledThreadExecutor executor(2);
+    auto adapter = Aws::MakeShared<FakeStreamAdapter>(ALLOCATION_TAG);
+    adapter->AddShard("shard-0", "", 9, true);
+    adapter->ExpireIteratorOnCall(1);
+
+    RecordCollector collector;
+    SchedulerConfiguration config = MakeConfiguration(&executor, adapter);
+    collector.Attach(config);
+
+    Scheduler scheduler(config);
+    scheduler.Start();
+    ASSERT_TRUE(collector.WaitFor(9, 1));
+    scheduler.Shutdown();
+
+    ASSERT_EQ(ExpectedPayloads("shard-0", 0, 9), collector.GetRecords("shard-0"));
+    auto iteratorRequests = adapter->GetIteratorRequests();
+    ASSERT_EQ(2u, iteratorRequests.size());
+    ASSERT_EQ("", iteratorRequests[0]);
+    ASSERT_EQ("shard-0#2", iteratorRequests[1]);
+}
+
+TEST(SchedulerTest, TestRestartReadsShardsFromCheckpoints)
+{
+    PooledThreadExecutor executor(2);
+    auto adapter = Aws::MakeShared<FakeStreamAdapter>(ALLOCATION_TAG);
+    adapter->AddShard("shard-0", "", 3, false);
+
+    RecordCollector collector;
+    SchedulerConfiguration config = MakeConfiguration(&executor, adapter);
+    collector.Attach(config);
+
+    Scheduler scheduler(config);
+    scheduler.Start();
+    ASSERT_TRUE(collector.WaitFor(3, 0));
+    scheduler.Shutdown();
+    ASSERT_TRUE(scheduler.GetActiveShards().empty());
+
+    scheduler.Start();
+    for (int i = 0; i < 500 && adapter->GetIteratorRequests().size() < 2; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    scheduler.Shutdown();
+
+    auto iteratorRequests = adapter->GetIteratorRequests();
+    ASSERT_EQ(2u, iteratorRequests.size());
+    ASSERT_EQ("shard-0#2", iteratorRequests[1]);
+}
+
+TEST(SchedulerTest, TestRestartDuringFetchReadsWithNewReadersOnly)
+{
+    PooledThreadExecutor executor(2);
+    auto adapter = Aws::MakeShared<FakeStreamAdapter>(ALLOCATION_TAG);
+    adapter->AddShard("shard-0", "", 9, false);
+    adapter->BlockOnCall(1);
+
+    RecordCollector collector;
+    SchedulerConfiguration config = MakeConfiguration(&executor, adapter);
+    collector.Attach(config);
+
+    Scheduler scheduler(config);
+    scheduler.Start();
+    ASSERT_TRUE(collector.WaitFor(3, 0));
+    ASSERT_TRUE(adapter->WaitUntilBlocked());
+
+    // The fetch completes while Shutdown waits for it, and would schedule the next read of the old reader.
+    std::thread stopper([&scheduler]() { scheduler.Shutdown(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    adapter->Release();
+    stopper.join();
+
+    scheduler.Start();
+    ASSERT_TRUE(collector.WaitFor(9, 0));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    scheduler.Shutdown();
+
+    ASSERT_EQ(ExpectedPayloads("shard-0", 0, 9), collector.GetRecords("shard-0"));
+    // The new reader resumes from the checkpoint; the old one, whose read ended at "shard-0#6", doesn't read again.
+    ASSERT_EQ(2u, adapter->CountRecordsRequests("shard-0#3"));
+    ASSERT_EQ(1u, adapter->CountRecordsRequests("shard-0#6"));
+}
+
+TEST(SchedulerTest, TestShutdownFromRecordsCallback)
+{
+    PooledThreadExecutor executor(2);
+    auto adapter = Aws::MakeShared<FakeStreamAdapter>(ALLOCATION_TAG);
+    adapter->AddShard("shard-0", "", 9, false);
+
+    std::mutex mutex;
+    std::condition_variable signal;
+    bool shutDown = false;
+    Scheduler* schedulerToStop = nullptr;
+
+    SchedulerConfiguration config = MakeConfiguration(&executor, adapter);
+    config.recordsReceivedCallback = [&](const Scheduler*, const ShardInfo&, const Aws::Vector<ConsumerRecord>&)
+    {
+        schedulerToStop->Shutdown();
+        std::lock_guard<std::mutex> locker(mutex);
+        shutDown = true;
+        signal.notify_all();
+    };
+
+    Scheduler scheduler(config);
+    schedulerToStop = &scheduler;
+    scheduler.Start();
+
+    std::unique_lock<std::mutex> locker(mutex);
+    ASSERT_TRUE(signal.wait_for(locker, std::chrono::seconds(10), [&]() { return shutDown; }));
+}
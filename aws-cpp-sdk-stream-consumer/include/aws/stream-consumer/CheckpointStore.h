@@ -0,0 +1,78 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/stream-consumer/StreamConsumer_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <mutex>
+
+namespace Aws
+{
+    namespace StreamConsumer
+    {
+        /**
+         * Checkpoint value stored for a shard that has been read to its end. Children of such a shard may be started.
+         */
+        static const char SHARD_END_CHECKPOINT[] = "SHARD_END";
+
+        /**
+         * Persists the last processed sequence number per shard so that a restarted consumer resumes where it stopped.
+         * Implementations must be thread safe; different shards are checkpointed concurrently.
+         */
+        class AWS_STREAM_CONSUMER_API CheckpointStore
+        {
+        public:
+            virtual ~CheckpointStore() = default;
+
+            /**
+             * Returns true and fills sequenceNumber if a checkpoint exists for shardId.
+             */
+            virtual bool GetCheckpoint(const Aws::String& shardId, Aws::String& sequenceNumber) = 0;
+
+            /**
+             * Records sequenceNumber (or SHARD_END_CHECKPOINT) as the checkpoint for shardId.
+             */
+            virtual bool SetCheckpoint(const Aws::String& shardId, const Aws::String& sequenceNumber) = 0;
+        };
+
+        /**
+         * Keeps checkpoints in memory only. Useful for tests and for consumers that always start from LATEST.
+         */
+        class AWS_STREAM_CONSUMER_API InMemoryCheckpointStore : public CheckpointStore
+        {
+        public:
+            bool GetCheckpoint(const Aws::String& shardId, Aws::String& sequenceNumber) override;
+            bool SetCheckpoint(const Aws::String& shardId, const Aws::String& sequenceNumber) override;
+
+        protected:
+            std::mutex m_checkpointsMutex;
+            Aws::Map<Aws::String, Aws::String> m_checkpoints;
+        };
+
+        /**
+         * Keeps checkpoints in memory and writes the whole table to a local file on every update.
+         * The file holds one "shardId sequenceNumber" pair per line and is replaced atomically by writing a temporary
+         * file next to it and renaming it over the previous one.
+         */
+        class AWS_STREAM_CONSUMER_API FileCheckpointStore : public InMemoryCheckpointStore
+        {
+        public:
+            /**
+             * Loads any existing checkpoints from fileName.
+             */
+            FileCheckpointStore(const Aws::String& fileName);
+
+            bool SetCheckpoint(const Aws::String& shardId, const Aws::String& sequenceNumber) override;
+
+        private:
+            bool Load();
+            bool Persist();
+
+            Aws::String m_fileName;
+        };
+    }
+}
@@ -0,0 +1,41 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/stream-consumer/StreamConsumer_EXPORTS.h>
+#include <aws/stream-consumer/StreamAdapter.h>
+
+namespace Aws
+{
+    namespace StreamConsumer
+    {
+        /**
+         * Expands records written by the Kinesis Producer Library (KPL) in its aggregated format.
+         *
+         * An aggregated record is the 4 byte magic 0xF3 0x89 0x9A 0xC2, followed by a protobuf encoded AggregatedRecord
+         * message, followed by the MD5 digest of that message. Records that do not carry the magic, fail to parse or fail
+         * the digest check are passed through unchanged, which matches the behaviour of the KPL consumer libraries.
+         */
+        class AWS_STREAM_CONSUMER_API RecordDeaggregator
+        {
+        public:
+            /**
+             * Returns true if data starts with the KPL aggregation magic and is long enough to hold a digest.
+             */
+            static bool IsAggregated(const Aws::Utils::ByteBuffer& data);
+
+            /**
+             * Appends the user records contained in record to out. Non aggregated records are appended as is.
+             */
+            static void Deaggregate(ConsumerRecord&& record, Aws::Vector<ConsumerRecord>& out);
+
+            /**
+             * De-aggregates every record of records in place, preserving order.
+             */
+            static void Deaggregate(Aws::Vector<ConsumerRecord>& records);
+        };
+    }
+}
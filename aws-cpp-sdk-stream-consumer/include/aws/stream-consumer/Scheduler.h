@@ -0,0 +1,183 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/stream-consumer/StreamConsumer_EXPORTS.h>
+#include <aws/stream-consumer/StreamAdapter.h>
+#include <aws/stream-consumer/CheckpointStore.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSSet.h>
+#include <aws/core/utils/memory/stl/AWSMultiMap.h>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Aws
+{
+    namespace StreamConsumer
+    {
+        class Scheduler;
+        class ShardReader;
+
+        typedef std::function<void(const Scheduler*, const ShardInfo&, const Aws::Vector<ConsumerRecord>&)> RecordsReceivedCallback;
+        typedef std::function<void(const Scheduler*, const ShardInfo&)> ShardEndedCallback;
+        typedef std::function<void(const Scheduler*, const ShardInfo&, const StreamAdapterError&)> ConsumerErrorCallback;
+
+        /**
+         * Configuration for use with Scheduler. The data here will be copied directly to Scheduler.
+         */
+        struct SchedulerConfiguration
+        {
+            SchedulerConfiguration(Aws::Utils::Threading::Executor* executor) :
+                consumerExecutor(executor), initialPosition(IteratorPosition::TRIM_HORIZON), maxRecordsPerRead(10000),
+                idleTimeBetweenReadsMs(1000), minTimeBetweenReadsMs(200), shardSyncIntervalMs(60000),
+                failureBackoffMs(1000), maxPrefetchedBatches(1), deaggregateRecords(true)
+            {
+            }
+
+            /**
+             * Stream to consume. You are responsible for setting this.
+             */
+            std::shared_ptr<StreamAdapter> streamAdapter;
+            /**
+             * Where checkpoints are read from and written to. An InMemoryCheckpointStore is used when left empty.
+             */
+            std::shared_ptr<CheckpointStore> checkpointStore;
+            /**
+             * Executor all shard reads and record callbacks run on. Shards never get a dedicated thread, so this executor
+             * bounds the consumer's concurrency. A PooledThreadExecutor sized to the number of shards you expect to read
+             * concurrently is a good default.
+             */
+            Aws::Utils::Threading::Executor* consumerExecutor;
+            /**
+             * Position used for shards without a checkpoint. Shards that were created by a split or a merge always start at
+             * TRIM_HORIZON so that no record written after the reshard is skipped.
+             */
+            IteratorPosition initialPosition;
+            /**
+             * Limit passed to every GetRecords call. Adapters clamp this to the service maximum.
+             */
+            int maxRecordsPerRead;
+            /**
+             * Delay before the next read of a shard when the last read returned nothing or reported that the consumer is
+             * caught up (MillisBehindLatest == 0).
+             */
+            long idleTimeBetweenReadsMs;
+            /**
+             * Delay between reads of a shard while the consumer is behind the tip of the stream. Kinesis allows 5 reads per
+             * second per shard, hence the 200ms default.
+             */
+            long minTimeBetweenReadsMs;
+            /**
+             * How often the shard list is refreshed to discover new shards. Shard ends also trigger an immediate refresh.
+             */
+            long shardSyncIntervalMs;
+            /**
+             * Delay before retrying a failed or throttled call.
+             */
+            long failureBackoffMs;
+            /**
+             * Number of fetched batches that may wait per shard while the application processes the current one.
+             * Reads are paused while this many batches are queued.
+             */
+            size_t maxPrefetchedBatches;
+            /**
+             * When true, records written by the KPL in its aggregated format are expanded before delivery.
+             */
+            bool deaggregateRecords;
+
+            /**
+             * Callback receiving records, in order, per shard. Callbacks for a given shard never overlap; a checkpoint for
+             * the last record of the batch is written once the callback returns.
+             */
+            RecordsReceivedCallback recordsReceivedCallback;
+            /**
+             * Callback invoked once a closed shard has been fully processed.
+             */
+            ShardEndedCallback shardEndedCallback;
+            /**
+             * Callback receiving every error returned by the stream adapter. The shard id is empty for shard listing errors.
+             */
+            ConsumerErrorCallback errorCallback;
+        };
+
+        /**
+         * Reads every shard of a stream on a shared executor.
+         *
+         * The scheduler periodically lists shards and starts a reader for every shard whose parents have been fully
+         * processed, so records of a key are delivered in order across splits and merges. Each reader issues the next
+         * GetRecords call as soon as a batch arrives, so fetching overlaps with the application processing the previous
+         * batch, and spaces its reads based on MillisBehindLatest. A single timer thread is used to delay reads; all I/O and
+         * callbacks run on the configured executor.
+         */
+        class AWS_STREAM_CONSUMER_API Scheduler
+        {
+        public:
+            Scheduler(const SchedulerConfiguration& config);
+            ~Scheduler();
+
+            Scheduler(const Scheduler&) = delete;
+            Scheduler& operator=(const Scheduler&) = delete;
+
+            /**
+             * Starts shard discovery and reading. Calling Start on a running scheduler does nothing.
+             */
+            void Start();
+
+            /**
+             * Stops scheduling new reads and blocks until every in flight read and callback has completed. A callback may
+             * call Shutdown; it then waits for every other task, and its own task completes after it returns.
+             * Shards are read again from their checkpoints by a later Start. Called by the destructor.
+             */
+            void Shutdown();
+
+            /**
+             * Returns the ids of the shards currently being read.
+             */
+            Aws::Vector<Aws::String> GetActiveShards() const;
+
+            /**
+             * Returns the ids of the shards that have been read to their end.
+             */
+            Aws::Vector<Aws::String> GetCompletedShards() const;
+
+            inline const SchedulerConfiguration& GetConfiguration() const { return m_config; }
+
+        private:
+            typedef std::chrono::steady_clock Clock;
+
+            void SyncShards(bool reschedule);
+            void OnShardCompleted(const Aws::String& shardId);
+            void SubmitTask(std::function<void()>&& task);
+            void ScheduleTask(long delayMs, std::function<void()>&& task);
+            void TimerLoop();
+            void ReportError(const ShardInfo& shard, const StreamAdapterError& error) const;
+
+            SchedulerConfiguration m_config;
+            bool m_running;
+
+            mutable std::mutex m_shardsMutex;
+            Aws::Map<Aws::String, std::shared_ptr<ShardReader>> m_shardReaders;
+            Aws::Set<Aws::String> m_completedShards;
+
+            std::mutex m_timerMutex;
+            std::condition_variable m_timerSignal;
+            Aws::MultiMap<Clock::time_point, std::function<void()>> m_timers;
+            std::thread m_timerThread;
+
+            std::mutex m_tasksMutex;
+            std::condition_variable m_tasksSignal;
+            size_t m_pendingTasks;
+            Aws::Map<std::thread::id, size_t> m_taskThreads;
+
+            friend class ShardReader;
+        };
+    }
+}
@@ -0,0 +1,111 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/stream-consumer/StreamConsumer_EXPORTS.h>
+#include <aws/core/client/AWSError.h>
+#include <aws/core/client/CoreErrors.h>
+#include <aws/core/utils/Array.h>
+#include <aws/core/utils/DateTime.h>
+#include <aws/core/utils/Outcome.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+
+namespace Aws
+{
+    namespace StreamConsumer
+    {
+        /**
+         * Service neutral description of a shard. Parent ids are empty for shards that were not created by a split or a merge.
+         */
+        struct ShardInfo
+        {
+            Aws::String shardId;
+            Aws::String parentShardId;
+            Aws::String adjacentParentShardId;
+            Aws::String startingSequenceNumber;
+            Aws::String endingSequenceNumber;
+        };
+
+        /**
+         * Service neutral record delivered to the application.
+         * For records de-aggregated from a KPL aggregated record, every sub record shares the sequence number of the
+         * enclosing record and is told apart by subSequenceNumber.
+         */
+        struct ConsumerRecord
+        {
+            ConsumerRecord() : subSequenceNumber(0), aggregated(false) {}
+
+            Aws::String sequenceNumber;
+            long long subSequenceNumber;
+            bool aggregated;
+            Aws::String partitionKey;
+            Aws::String explicitHashKey;
+            Aws::Utils::ByteBuffer data;
+            Aws::Utils::DateTime approximateArrivalTimestamp;
+        };
+
+        /**
+         * One GetRecords response. An empty nextShardIterator means the shard has been closed and fully read.
+         * millisBehindLatest is negative when the service does not report it.
+         */
+        struct RecordBatch
+        {
+            RecordBatch() : millisBehindLatest(-1) {}
+
+            Aws::Vector<ConsumerRecord> records;
+            Aws::String nextShardIterator;
+            long long millisBehindLatest;
+        };
+
+        /**
+         * Where to start reading a shard.
+         */
+        enum class IteratorPosition
+        {
+            TRIM_HORIZON,
+            LATEST,
+            AT_SEQUENCE_NUMBER,
+            AFTER_SEQUENCE_NUMBER
+        };
+
+        typedef Aws::Client::AWSError<Aws::Client::CoreErrors> StreamAdapterError;
+        typedef Aws::Utils::Outcome<Aws::Vector<ShardInfo>, StreamAdapterError> ListShardsOutcome;
+        typedef Aws::Utils::Outcome<Aws::String, StreamAdapterError> GetShardIteratorOutcome;
+        typedef Aws::Utils::Outcome<RecordBatch, StreamAdapterError> GetRecordsOutcome;
+
+        /**
+         * Exception name returned by both Kinesis and DynamoDB Streams when a shard iterator is older than 5 minutes.
+         */
+        static const char EXPIRED_ITERATOR_EXCEPTION[] = "ExpiredIteratorException";
+
+        /**
+         * Thin layer between the Scheduler and a streaming service. Implementations translate the service specific
+         * shard listing, iterator and record calls into the neutral types above. All methods are called from executor
+         * threads and must be thread safe.
+         */
+        class AWS_STREAM_CONSUMER_API StreamAdapter
+        {
+        public:
+            virtual ~StreamAdapter() = default;
+
+            /**
+             * Returns every shard currently known to the stream, following pagination until exhausted.
+             */
+            virtual ListShardsOutcome ListShards() = 0;
+
+            /**
+             * Returns a shard iterator for shardId. sequenceNumber is ignored for TRIM_HORIZON and LATEST.
+             */
+            virtual GetShardIteratorOutcome GetShardIterator(const Aws::String& shardId, IteratorPosition position, const Aws::String& sequenceNumber) = 0;
+
+            /**
+             * Reads up to limit records from shardIterator. Implementations are free to clamp limit to the service maximum.
+             */
+            virtual GetRecordsOutcome GetRecords(const Aws::String& shardIterator, int limit) = 0;
+        };
+    }
+}
@@ -0,0 +1,43 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/stream-consumer/StreamConsumer_EXPORTS.h>
+#include <aws/stream-consumer/StreamAdapter.h>
+#include <memory>
+
+namespace Aws
+{
+    namespace DynamoDBStreams
+    {
+        class DynamoDBStreamsClient;
+    }
+
+    namespace StreamConsumer
+    {
+        namespace DynamoDBStreams
+        {
+            /**
+             * StreamAdapter over a DynamoDB stream, using DescribeStream, GetShardIterator and GetRecords.
+             * Each stream record is delivered as the compact JSON form of the DynamoDB Streams Record, keyed by the
+             * sequence number of its StreamRecord. DynamoDB Streams does not report MillisBehindLatest.
+             */
+            class AWS_STREAM_CONSUMER_API DynamoDBStreamsAdapter : public StreamAdapter
+            {
+            public:
+                DynamoDBStreamsAdapter(const std::shared_ptr<Aws::DynamoDBStreams::DynamoDBStreamsClient>& client, const Aws::String& streamArn);
+
+                ListShardsOutcome ListShards() override;
+                GetShardIteratorOutcome GetShardIterator(const Aws::String& shardId, IteratorPosition position, const Aws::String& sequenceNumber) override;
+                GetRecordsOutcome GetRecords(const Aws::String& shardIterator, int limit) override;
+
+            private:
+                std::shared_ptr<Aws::DynamoDBStreams::DynamoDBStreamsClient> m_client;
+                Aws::String m_streamArn;
+            };
+        }
+    }
+}
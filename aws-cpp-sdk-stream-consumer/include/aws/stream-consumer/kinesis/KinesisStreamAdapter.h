@@ -0,0 +1,41 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/stream-consumer/StreamConsumer_EXPORTS.h>
+#include <aws/stream-consumer/StreamAdapter.h>
+#include <memory>
+
+namespace Aws
+{
+    namespace Kinesis
+    {
+        class KinesisClient;
+    }
+
+    namespace StreamConsumer
+    {
+        namespace Kinesis
+        {
+            /**
+             * StreamAdapter over a Kinesis data stream, using ListShards, GetShardIterator and GetRecords.
+             */
+            class AWS_STREAM_CONSUMER_API KinesisStreamAdapter : public StreamAdapter
+            {
+            public:
+                KinesisStreamAdapter(const std::shared_ptr<Aws::Kinesis::KinesisClient>& client, const Aws::String& streamName);
+
+                ListShardsOutcome ListShards() override;
+                GetShardIteratorOutcome GetShardIterator(const Aws::String& shardId, IteratorPosition position, const Aws::String& sequenceNumber) override;
+                GetRecordsOutcome GetRecords(const Aws::String& shardIterator, int limit) override;
+
+            private:
+                std::shared_ptr<Aws::Kinesis::KinesisClient> m_client;
+                Aws::String m_streamName;
+            };
+        }
+    }
+}
@@ -0,0 +1,96 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/stream-consumer/CheckpointStore.h>
+#include <aws/core/platform/FileSystem.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <fstream>
+
+namespace Aws
+{
+    namespace StreamConsumer
+    {
+        static const char CLASS_TAG[] = "CheckpointStore";
+
+        bool InMemoryCheckpointStore::GetCheckpoint(const Aws::String& shardId, Aws::String& sequenceNumber)
+        {
+            std::lock_guard<std::mutex> locker(m_checkpointsMutex);
+            auto iter = m_checkpoints.find(shardId);
+            if (iter == m_checkpoints.end())
+            {
+                return false;
+            }
+            sequenceNumber = iter->second;
+            return true;
+        }
+
+        bool InMemoryCheckpointStore::SetCheckpoint(const Aws::String& shardId, const Aws::String& sequenceNumber)
+        {
+            std::lock_guard<std::mutex> locker(m_checkpointsMutex);
+            m_checkpoints[shardId] = sequenceNumber;
+            return true;
+        }
+
+        FileCheckpointStore::FileCheckpointStore(const Aws::String& fileName) : m_fileName(fileName)
+        {
+            Load();
+        }
+
+        bool FileCheckpointStore::SetCheckpoint(const Aws::String& shardId, const Aws::String& sequenceNumber)
+        {
+            std::lock_guard<std::mutex> locker(m_checkpointsMutex);
+            m_checkpoints[shardId] = sequenceNumber;
+            return Persist();
+        }
+
+        bool FileCheckpointStore::Load()
+        {
+            std::lock_guard<std::mutex> locker(m_checkpointsMutex);
+            Aws::IFStream file(m_fileName.c_str());
+            if (!file.good())
+            {
+                AWS_LOGSTREAM_DEBUG(CLASS_TAG, "No checkpoint file found at " << m_fileName);
+                return false;
+            }
+
+            Aws::String shardId;
+            Aws::String sequenceNumber;
+            while (file >> shardId >> sequenceNumber)
+            {
+                m_checkpoints[shardId] = sequenceNumber;
+            }
+            AWS_LOGSTREAM_INFO(CLASS_TAG, "Loaded " << m_checkpoints.size() << " checkpoints from " << m_fileName);
+            return true;
+        }
+
+        bool FileCheckpointStore::Persist()
+        {
+            // Caller holds m_checkpointsMutex.
+            Aws::String tempFileName = m_fileName + ".tmp";
+            {
+                Aws::OFStream file(tempFileName.c_str(), std::ios_base::out | std::ios_base::trunc);
+                for (const auto& checkpoint : m_checkpoints)
+                {
+                    file << checkpoint.first << ' ' << checkpoint.second << '\n';
+                }
+                file.flush();
+                if (!file.good())
+                {
+                    AWS_LOGSTREAM_ERROR(CLASS_TAG, "Failed to write checkpoints to " << tempFileName);
+                    return false;
+                }
+            }
+
+            if (!Aws::FileSystem::RelocateFileOrDirectory(tempFileName.c_str(), m_fileName.c_str()))
+            {
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Failed to move " << tempFileName << " to " << m_fileName);
+                Aws::FileSystem::RemoveFileIfExists(tempFileName.c_str());
+                return false;
+            }
+            return true;
+        }
+    }
+}
@@ -0,0 +1,292 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/stream-consumer/RecordDeaggregator.h>
+#include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <cstring>
+
+using namespace Aws::Utils;
+
+namespace Aws
+{
+    namespace StreamConsumer
+    {
+        static const char CLASS_TAG[] = "RecordDeaggregator";
+        static const unsigned char KPL_AGGREGATED_RECORD_MAGIC[] = { 0xF3, 0x89, 0x9A, 0xC2 };
+        static const size_t KPL_MAGIC_LENGTH = sizeof(KPL_AGGREGATED_RECORD_MAGIC);
+        static const size_t KPL_DIGEST_LENGTH = 16;
+
+        // Protobuf wire types used by the KPL messages.
+        static const unsigned WIRE_TYPE_VARINT = 0;
+        static const unsigned WIRE_TYPE_FIXED64 = 1;
+        static const unsigned WIRE_TYPE_LENGTH_DELIMITED = 2;
+        static const unsigned WIRE_TYPE_FIXED32 = 5;
+
+        /**
+         * Minimal protobuf reader; just enough to walk the AggregatedRecord and Record messages without
+         * pulling a protobuf runtime into the SDK.
+         */
+        class ProtobufReader
+        {
+        public:
+            ProtobufReader(const unsigned char* data, size_t length) : m_cursor(data), m_end(data + length) {}
+
+            bool AtEnd() const { return m_cursor == m_end; }
+
+            bool ReadVarint(uint64_t& value)
+            {
+                value = 0;
+                for (unsigned shift = 0; shift < 64 && m_cursor < m_end; shift += 7)
+                {
+                    unsigned char byte = *m_cursor++;
+                    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                    if (!(byte & 0x80))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            bool ReadTag(unsigned& fieldNumber, unsigned& wireType)
+            {
+                uint64_t tag = 0;
+                if (!ReadVarint(tag))
+                {
+                    return false;
+                }
+                fieldNumber = static_cast<unsigned>(tag >> 3);
+                wireType = static_cast<unsigned>(tag & 0x07);
+                return true;
+            }
+
+            bool ReadLengthDelimited(const unsigned char*& data, size_t& length)
+            {
+                uint64_t fieldLength = 0;
+                if (!ReadVarint(fieldLength) || fieldLength > static_cast<uint64_t>(m_end - m_cursor))
+                {
+                    return false;
+                }
+                data = m_cursor;
+                length = static_cast<size_t>(fieldLength);
+                m_cursor += length;
+                return true;
+            }
+
+            bool Skip(unsigned wireType)
+            {
+                uint64_t ignored = 0;
+                const unsigned char* data = nullptr;
+                size_t length = 0;
+                switch (wireType)
+                {
+                    case WIRE_TYPE_VARINT:
+                        return ReadVarint(ignored);
+                    case WIRE_TYPE_FIXED64:
+                        return Advance(8);
+                    case WIRE_TYPE_LENGTH_DELIMITED:
+                        return ReadLengthDelimited(data, length);
+                    case WIRE_TYPE_FIXED32:
+                        return Advance(4);
+                    default:
+                        return false;
+                }
+            }
+
+        private:
+            bool Advance(size_t count)
+            {
+                if (count > static_cast<size_t>(m_end - m_cursor))
+                {
+                    return false;
+                }
+                m_cursor += count;
+                return true;
+            }
+
+            const unsigned char* m_cursor;
+            const unsigned char* m_end;
+        };
+
+        struct AggregatedSubRecord
+        {
+            AggregatedSubRecord() : partitionKeyIndex(0), explicitHashKeyIndex(0), hasExplicitHashKey(false), data(nullptr), dataLength(0) {}
+
+            uint64_t partitionKeyIndex;
+            uint64_t explicitHashKeyIndex;
+            bool hasExplicitHashKey;
+            const unsigned char* data;
+            size_t dataLength;
+        };
+
+        static bool ParseSubRecord(const unsigned char* data, size_t length, AggregatedSubRecord& subRecord)
+        {
+            ProtobufReader reader(data, length);
+            bool hasPartitionKey = false;
+            while (!reader.AtEnd())
+            {
+                unsigned field = 0;
+                unsigned wireType = 0;
+                if (!reader.ReadTag(field, wireType))
+                {
+                    return false;
+                }
+
+                if (field == 1 && wireType == WIRE_TYPE_VARINT)
+                {
+                    hasPartitionKey = reader.ReadVarint(subRecord.partitionKeyIndex);
+                    if (!hasPartitionKey)
+                    {
+                        return false;
+                    }
+                }
+                else if (field == 2 && wireType == WIRE_TYPE_VARINT)
+                {
+                    subRecord.hasExplicitHashKey = reader.ReadVarint(subRecord.explicitHashKeyIndex);
+                    if (!subRecord.hasExplicitHashKey)
+                    {
+                        return false;
+                    }
+                }
+                else if (field == 3 && wireType == WIRE_TYPE_LENGTH_DELIMITED)
+                {
+                    if (!reader.ReadLengthDelimited(subRecord.data, subRecord.dataLength))
+                    {
+                        return false;
+                    }
+                }
+                else if (!reader.Skip(wireType))
+                {
+                    return false;
+                }
+            }
+            return hasPartitionKey;
+        }
+
+        bool RecordDeaggregator::IsAggregated(const ByteBuffer& data)
+        {
+            return data.GetLength() > KPL_MAGIC_LENGTH + KPL_DIGEST_LENGTH &&
+                memcmp(data.GetUnderlyingData(), KPL_AGGREGATED_RECORD_MAGIC, KPL_MAGIC_LENGTH) == 0;
+        }
+
+        void RecordDeaggregator::Deaggregate(ConsumerRecord&& record, Aws::Vector<ConsumerRecord>& out)
+        {
+            if (!IsAggregated(record.data))
+            {
+                out.push_back(std::move(record));
+                return;
+            }
+
+            const unsigned char* message = record.data.GetUnderlyingData() + KPL_MAGIC_LENGTH;
+            size_t messageLength = record.data.GetLength() - KPL_MAGIC_LENGTH - KPL_DIGEST_LENGTH;
+            ByteBuffer digest = HashingUtils::CalculateMD5(Aws::String(reinterpret_cast<const char*>(message), messageLength));
+            if (memcmp(digest.GetUnderlyingData(), message + messageLength, KPL_DIGEST_LENGTH) != 0)
+            {
+                AWS_LOGSTREAM_WARN(CLASS_TAG, "Digest mismatch for record " << record.sequenceNumber << ", delivering it as is.");
+                out.push_back(std::move(record));
+                return;
+            }
+
+            Aws::Vector<Aws::String> partitionKeys;
+            Aws::Vector<Aws::String> explicitHashKeys;
+            Aws::Vector<AggregatedSubRecord> subRecords;
+            ProtobufReader reader(message, messageLength);
+            bool valid = true;
+            while (valid && !reader.AtEnd())
+            {
+                unsigned field = 0;
+                unsigned wireType = 0;
+                const unsigned char* fieldData = nullptr;
+                size_t fieldLength = 0;
+                if (!reader.ReadTag(field, wireType))
+                {
+                    valid = false;
+                }
+                else if (wireType != WIRE_TYPE_LENGTH_DELIMITED || field < 1 || field > 3)
+                {
+                    valid = reader.Skip(wireType);
+                }
+                else if (!reader.ReadLengthDelimited(fieldData, fieldLength))
+                {
+                    valid = false;
+                }
+                else if (field == 1)
+                {
+                    partitionKeys.emplace_back(reinterpret_cast<const char*>(fieldData), fieldLength);
+                }
+                else if (field == 2)
+                {
+                    explicitHashKeys.emplace_back(reinterpret_cast<const char*>(fieldData), fieldLength);
+                }
+                else
+                {
+                    AggregatedSubRecord subRecord;
+                    valid = ParseSubRecord(fieldData, fieldLength, subRecord);
+                    subRecords.push_back(subRecord);
+                }
+            }
+
+            for (const auto& subRecord : subRecords)
+            {
+                if (!valid)
+                {
+                    break;
+                }
+                valid = subRecord.partitionKeyIndex < partitionKeys.size() &&
+                    (!subRecord.hasExplicitHashKey || subRecord.explicitHashKeyIndex < explicitHashKeys.size());
+            }
+
+            if (!valid)
+            {
+                AWS_LOGSTREAM_WARN(CLASS_TAG, "Failed to parse aggregated record " << record.sequenceNumber << ", delivering it as is.");
+                out.push_back(std::move(record));
+                return;
+            }
+
+            long long subSequenceNumber = 0;
+            for (const auto& subRecord : subRecords)
+            {
+                ConsumerRecord userRecord;
+                userRecord.sequenceNumber = record.sequenceNumber;
+                userRecord.subSequenceNumber = subSequenceNumber++;
+                userRecord.aggregated = true;
+                userRecord.partitionKey = partitionKeys[static_cast<size_t>(subRecord.partitionKeyIndex)];
+                if (subRecord.hasExplicitHashKey)
+                {
+                    userRecord.explicitHashKey = explicitHashKeys[static_cast<size_t>(subRecord.explicitHashKeyIndex)];
+                }
+                userRecord.data = ByteBuffer(subRecord.data, subRecord.dataLength);
+                userRecord.approximateArrivalTimestamp = record.approximateArrivalTimestamp;
+                out.push_back(std::move(userRecord));
+            }
+        }
+
+        void RecordDeaggregator::Deaggregate(Aws::Vector<ConsumerRecord>& records)
+        {
+            bool anyAggregated = false;
+            for (const auto& record : records)
+            {
+                if (IsAggregated(record.data))
+                {
+                    anyAggregated = true;
+                    break;
+                }
+            }
+            if (!anyAggregated)
+            {
+                return;
+            }
+
+            Aws::Vector<ConsumerRecord> expanded;
+            expanded.reserve(records.size());
+            for (auto& record : records)
+            {
+                Deaggregate(std::move(record), expanded);
+            }
+            records.swap(expanded);
+        }
+    }
+}
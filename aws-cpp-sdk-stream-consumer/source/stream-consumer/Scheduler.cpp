@@ -0,0 +1,526 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/stream-consumer/Scheduler.h>
+#include <aws/stream-consumer/RecordDeaggregator.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSDeque.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <algorithm>
+#include <cassert>
+
+namespace Aws
+{
+    namespace StreamConsumer
+    {
+        static const char CLASS_TAG[] = "StreamConsumerScheduler";
+
+        /**
+         * Reads a single shard. Every step runs as a task on the scheduler's executor:
+         * Initialize acquires an iterator, Fetch issues one GetRecords call and queues its records, Process hands one
+         * queued batch to the application and checkpoints it. Fetch and Process run concurrently so the next read is in
+         * flight while the application works on the current batch; Process tasks never overlap, which keeps delivery
+         * ordered within the shard.
+         */
+        class ShardReader : public std::enable_shared_from_this<ShardReader>
+        {
+        public:
+            ShardReader(Scheduler* scheduler, const ShardInfo& shard) :
+                m_scheduler(scheduler), m_shard(shard), m_processing(false), m_waitingForCapacity(false), m_shardEnded(false)
+            {
+            }
+
+            const ShardInfo& GetShard() const { return m_shard; }
+
+            void Initialize()
+            {
+                const SchedulerConfiguration& config = m_scheduler->m_config;
+
+                IteratorPosition position = config.initialPosition;
+                Aws::String sequenceNumber;
+                Aws::String checkpoint;
+                if (!m_lastFetchedSequenceNumber.empty())
+                {
+                    // The previous iterator expired; pick up right after the last record handed to the queue.
+                    position = IteratorPosition::AFTER_SEQUENCE_NUMBER;
+                    sequenceNumber = m_lastFetchedSequenceNumber;
+                }
+                else if (config.checkpointStore->GetCheckpoint(m_shard.shardId, checkpoint))
+                {
+                    position = IteratorPosition::AFTER_SEQUENCE_NUMBER;
+                    sequenceNumber = checkpoint;
+                }
+                else if (!m_shard.parentShardId.empty() || !m_shard.adjacentParentShardId.empty())
+                {
+                    position = IteratorPosition::TRIM_HORIZON;
+                }
+
+                auto outcome = config.streamAdapter->GetShardIterator(m_shard.shardId, position, sequenceNumber);
+                if (!outcome.IsSuccess())
+                {
+                    AWS_LOGSTREAM_WARN(CLASS_TAG, "Failed to get an iterator for shard " << m_shard.shardId << ": "
+                            << outcome.GetError().GetExceptionName() << " " << outcome.GetError().GetMessage());
+                    m_scheduler->ReportError(m_shard, outcome.GetError());
+                    auto self = shared_from_this();
+                    m_scheduler->ScheduleTask(config.failureBackoffMs, [self]() { self->Initialize(); });
+                    return;
+                }
+
+                AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Acquired iterator for shard " << m_shard.shardId);
+                {
+                    std::lock_guard<std::mutex> locker(m_readerMutex);
+                    m_iterator = outcome.GetResult();
+                }
+                Fetch();
+            }
+
+            void Fetch()
+            {
+                const SchedulerConfiguration& config = m_scheduler->m_config;
+
+                Aws::String iterator;
+                {
+                    std::lock_guard<std::mutex> locker(m_readerMutex);
+                    iterator = m_iterator;
+                }
+
+                auto outcome = config.streamAdapter->GetRecords(iterator, config.maxRecordsPerRead);
+                auto self = shared_from_this();
+                if (!outcome.IsSuccess())
+                {
+                    const auto& error = outcome.GetError();
+                    if (error.GetExceptionName() == EXPIRED_ITERATOR_EXCEPTION)
+                    {
+                        AWS_LOGSTREAM_INFO(CLASS_TAG, "Iterator expired for shard " << m_shard.shardId << ", acquiring a new one.");
+                        m_scheduler->SubmitTask([self]() { self->Initialize(); });
+                        return;
+                    }
+
+                    AWS_LOGSTREAM_WARN(CLASS_TAG, "GetRecords failed for shard " << m_shard.shardId << ": "
+                            << error.GetExceptionName() << " " << error.GetMessage());
+                    m_scheduler->ReportError(m_shard, error);
+                    m_scheduler->ScheduleTask(config.failureBackoffMs, [self]() { self->Fetch(); });
+                    return;
+                }
+
+                RecordBatch batch = outcome.GetResultWithOwnership();
+                if (config.deaggregateRecords)
+                {
+                    RecordDeaggregator::Deaggregate(batch.records);
+                }
+
+                const bool caughtUp = batch.records.empty() || batch.millisBehindLatest == 0;
+                bool startProcessing = false;
+                bool scheduleFetch = false;
+                bool completed = false;
+                {
+                    std::lock_guard<std::mutex> locker(m_readerMutex);
+                    m_iterator = batch.nextShardIterator;
+                    if (!batch.records.empty())
+                    {
+                        m_lastFetchedSequenceNumber = batch.records.back().sequenceNumber;
+                        m_readyBatches.push_back(std::move(batch.records));
+                    }
+                    m_shardEnded = m_iterator.empty();
+
+                    if (!m_processing && !m_readyBatches.empty())
+                    {
+                        m_processing = true;
+                        startProcessing = true;
+                    }
+
+                    if (m_shardEnded)
+                    {
+                        completed = !m_processing;
+                    }
+                    else if (m_readyBatches.size() < (std::max)(config.maxPrefetchedBatches, static_cast<size_t>(1)))
+                    {
+                        scheduleFetch = true;
+                    }
+                    else
+                    {
+                        m_waitingForCapacity = true;
+                    }
+                }
+
+                if (startProcessing)
+                {
+                    m_scheduler->SubmitTask([self]() { self->Process(); });
+                }
+                if (scheduleFetch)
+                {
+                    m_scheduler->ScheduleTask(caughtUp ? config.idleTimeBetweenReadsMs : config.minTimeBetweenReadsMs,
+                            [self]() { self->Fetch(); });
+                }
+                if (completed)
+                {
+                    Complete();
+                }
+            }
+
+            void Process()
+            {
+                const SchedulerConfiguration& config = m_scheduler->m_config;
+
+                Aws::Vector<ConsumerRecord>* records = nullptr;
+                {
+                    std::lock_guard<std::mutex> locker(m_readerMutex);
+                    assert(!m_readyBatches.empty());
+                    // Only this task pops from the queue, and push_back on a deque does not invalidate references.
+                    records = &m_readyBatches.front();
+                }
+
+                if (config.recordsReceivedCallback)
+                {
+                    config.recordsReceivedCallback(m_scheduler, m_shard, *records);
+                }
+                config.checkpointStore->SetCheckpoint(m_shard.shardId, records->back().sequenceNumber);
+
+                auto self = shared_from_this();
+                bool processNext = false;
+                bool resumeFetch = false;
+                bool completed = false;
+                {
+                    std::lock_guard<std::mutex> locker(m_readerMutex);
+                    m_readyBatches.pop_front();
+                    if (m_waitingForCapacity)
+                    {
+                        m_waitingForCapacity = false;
+                        resumeFetch = true;
+                    }
+
+                    if (!m_readyBatches.empty())
+                    {
+                        processNext = true;
+                    }
+                    else
+                    {
+                        m_processing = false;
+                        completed = m_shardEnded;
+                    }
+                }
+
+                if (resumeFetch)
+                {
+                    m_scheduler->ScheduleTask(config.minTimeBetweenReadsMs, [self]() { self->Fetch(); });
+                }
+                if (processNext)
+                {
+                    // Resubmit rather than loop so that other shards get a turn on a busy executor.
+                    m_scheduler->SubmitTask([self]() { self->Process(); });
+                }
+                if (completed)
+                {
+                    Complete();
+                }
+            }
+
+        private:
+            void Complete()
+            {
+                const SchedulerConfiguration& config = m_scheduler->m_config;
+
+                AWS_LOGSTREAM_INFO(CLASS_TAG, "Reached the end of shard " << m_shard.shardId);
+                config.checkpointStore->SetCheckpoint(m_shard.shardId, SHARD_END_CHECKPOINT);
+                if (config.shardEndedCallback)
+                {
+                    config.shardEndedCallback(m_scheduler, m_shard);
+                }
+                m_scheduler->OnShardCompleted(m_shard.shardId);
+            }
+
+            Scheduler* m_scheduler;
+            ShardInfo m_shard;
+
+            std::mutex m_readerMutex;
+            Aws::String m_iterator;
+            Aws::String m_lastFetchedSequenceNumber;
+            Aws::Deque<Aws::Vector<ConsumerRecord>> m_readyBatches;
+            bool m_processing;
+            bool m_waitingForCapacity;
+            bool m_shardEnded;
+        };
+
+        Scheduler::Scheduler(const SchedulerConfiguration& config) : m_config(config), m_running(false), m_pendingTasks(0)
+        {
+            assert(m_config.streamAdapter);
+            assert(m_config.consumerExecutor);
+            if (!m_config.checkpointStore)
+            {
+                m_config.checkpointStore = Aws::MakeShared<InMemoryCheckpointStore>(CLASS_TAG);
+            }
+        }
+
+        Scheduler::~Scheduler()
+        {
+            Shutdown();
+        }
+
+        void Scheduler::Start()
+        {
+            {
+                std::lock_guard<std::mutex> locker(m_tasksMutex);
+                if (m_running)
+                {
+                    return;
+                }
+                m_running = true;
+            }
+
+            m_timerThread = std::thread(&Scheduler::TimerLoop, this);
+            SubmitTask([this]() { SyncShards(true); });
+        }
+
+        void Scheduler::Shutdown()
+        {
+            {
+                std::lock_guard<std::mutex> locker(m_tasksMutex);
+                m_running = false;
+            }
+
+            {
+                std::lock_guard<std::mutex> locker(m_timerMutex);
+                m_timerSignal.notify_all();
+            }
+            if (m_timerThread.joinable())
+            {
+                m_timerThread.join();
+            }
+
+            {
+                // A callback calling Shutdown runs as one of the pending tasks, which can't complete before Shutdown returns.
+                std::unique_lock<std::mutex> locker(m_tasksMutex);
+                auto callerTasks = m_taskThreads.find(std::this_thread::get_id());
+                const size_t ownTasks = callerTasks == m_taskThreads.end() ? 0 : callerTasks->second;
+                m_tasksSignal.wait(locker, [this, ownTasks]() { return m_pendingTasks == ownTasks; });
+            }
+
+            {
+                // Only once no task is left to schedule more: a later Start must not run reads of the old readers.
+                std::lock_guard<std::mutex> locker(m_timerMutex);
+                m_timers.clear();
+            }
+
+            // The readers' pending reads were dropped; a later Start recreates them from their checkpoints.
+            std::lock_guard<std::mutex> locker(m_shardsMutex);
+            m_shardReaders.clear();
+        }
+
+        Aws::Vector<Aws::String> Scheduler::GetActiveShards() const
+        {
+            std::lock_guard<std::mutex> locker(m_shardsMutex);
+            Aws::Vector<Aws::String> shards;
+            shards.reserve(m_shardReaders.size());
+            for (const auto& reader : m_shardReaders)
+            {
+                shards.push_back(reader.first);
+            }
+            return shards;
+        }
+
+        Aws::Vector<Aws::String> Scheduler::GetCompletedShards() const
+        {
+            std::lock_guard<std::mutex> locker(m_shardsMutex);
+            return Aws::Vector<Aws::String>(m_completedShards.begin(), m_completedShards.end());
+        }
+
+        void Scheduler::SyncShards(bool reschedule)
+        {
+            auto outcome = m_config.streamAdapter->ListShards();
+            if (!outcome.IsSuccess())
+            {
+                AWS_LOGSTREAM_WARN(CLASS_TAG, "Failed to list shards: " << outcome.GetError().GetExceptionName()
+                        << " " << outcome.GetError().GetMessage());
+                ReportError(ShardInfo(), outcome.GetError());
+                if (reschedule)
+                {
+                    ScheduleTask(m_config.failureBackoffMs, [this]() { SyncShards(true); });
+                }
+                return;
+            }
+
+            const auto& shards = outcome.GetResult();
+            Aws::Set<Aws::String> listedShards;
+            for (const auto& shard : shards)
+            {
+                listedShards.insert(shard.shardId);
+            }
+
+            Aws::Vector<std::shared_ptr<ShardReader>> newReaders;
+            {
+                std::lock_guard<std::mutex> locker(m_shardsMutex);
+
+                // Shards finished by a previous run must be known before deciding whether their children can start.
+                for (const auto& shard : shards)
+                {
+                    Aws::String checkpoint;
+                    if (m_completedShards.find(shard.shardId) == m_completedShards.end() &&
+                        m_config.checkpointStore->GetCheckpoint(shard.shardId, checkpoint) && checkpoint == SHARD_END_CHECKPOINT)
+                    {
+                        m_completedShards.insert(shard.shardId);
+                    }
+                }
+
+                // A parent that is no longer listed has aged out of the stream's retention period and cannot block its children.
+                auto parentDone = [&](const Aws::String& parentId)
+                {
+                    return parentId.empty() || m_completedShards.find(parentId) != m_completedShards.end() ||
+                        listedShards.find(parentId) == listedShards.end();
+                };
+
+                for (const auto& shard : shards)
+                {
+                    if (m_completedShards.find(shard.shardId) != m_completedShards.end() ||
+                        m_shardReaders.find(shard.shardId) != m_shardReaders.end())
+                    {
+                        continue;
+                    }
+
+                    if (!parentDone(shard.parentShardId) || !parentDone(shard.adjacentParentShardId))
+                    {
+                        AWS_LOGSTREAM_TRACE(CLASS_TAG, "Shard " << shard.shardId << " is waiting for its parents to complete.");
+                        continue;
+                    }
+
+                    AWS_LOGSTREAM_INFO(CLASS_TAG, "Starting reader for shard " << shard.shardId);
+                    auto reader = Aws::MakeShared<ShardReader>(CLASS_TAG, this, shard);
+                    m_shardReaders[shard.shardId] = reader;
+                    newReaders.push_back(reader);
+                }
+            }
+
+            for (const auto& reader : newReaders)
+            {
+                SubmitTask([reader]() { reader->Initialize(); });
+            }
+
+            if (reschedule)
+            {
+                ScheduleTask(m_config.shardSyncIntervalMs, [this]() { SyncShards(true); });
+            }
+        }
+
+        void Scheduler::OnShardCompleted(const Aws::String& shardId)
+        {
+            {
+                std::lock_guard<std::mutex> locker(m_shardsMutex);
+                m_shardReaders.erase(shardId);
+                m_completedShards.insert(shardId);
+            }
+
+            // Children of the finished shard may now be started; don't wait for the next periodic sync.
+            SubmitTask([this]() { SyncShards(false); });
+        }
+
+        void Scheduler::SubmitTask(std::function<void()>&& task)
+        {
+            {
+                std::lock_guard<std::mutex> locker(m_tasksMutex);
+                if (!m_running)
+                {
+                    return;
+                }
+                ++m_pendingTasks;
+            }
+
+            auto wrapped = [this, task]()
+            {
+                const std::thread::id threadId = std::this_thread::get_id();
+                {
+                    std::lock_guard<std::mutex> locker(m_tasksMutex);
+                    ++m_taskThreads[threadId];
+                }
+                task();
+                std::lock_guard<std::mutex> locker(m_tasksMutex);
+                auto taskThread = m_taskThreads.find(threadId);
+                if (--taskThread->second == 0)
+                {
+                    m_taskThreads.erase(taskThread);
+                }
+                --m_pendingTasks;
+                m_tasksSignal.notify_all();
+            };
+
+            if (!m_config.consumerExecutor->Submit(wrapped))
+            {
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Executor rejected a consumer task.");
+                std::lock_guard<std::mutex> locker(m_tasksMutex);
+                --m_pendingTasks;
+                m_tasksSignal.notify_all();
+            }
+        }
+
+        void Scheduler::ScheduleTask(long delayMs, std::function<void()>&& task)
+        {
+            if (delayMs <= 0)
+            {
+                SubmitTask(std::move(task));
+                return;
+            }
+
+            std::lock_guard<std::mutex> locker(m_timerMutex);
+            {
+                // Tasks still running during Shutdown keep scheduling reads; those are dropped, as SubmitTask does.
+                std::lock_guard<std::mutex> tasksLocker(m_tasksMutex);
+                if (!m_running)
+                {
+                    return;
+                }
+            }
+            m_timers.emplace(Clock::now() + std::chrono::milliseconds(delayMs), std::move(task));
+            m_timerSignal.notify_one();
+        }
+
+        void Scheduler::TimerLoop()
+        {
+            std::unique_lock<std::mutex> locker(m_timerMutex);
+            for (;;)
+            {
+                {
+                    std::lock_guard<std::mutex> tasksLocker(m_tasksMutex);
+                    if (!m_running)
+                    {
+                        return;
+                    }
+                }
+
+                if (m_timers.empty())
+                {
+                    m_timerSignal.wait(locker);
+                    continue;
+                }
+
+                auto now = Clock::now();
+                if (m_timers.begin()->first > now)
+                {
+                    m_timerSignal.wait_until(locker, m_timers.begin()->first);
+                    continue;
+                }
+
+                Aws::Vector<std::function<void()>> dueTasks;
+                while (!m_timers.empty() && m_timers.begin()->first <= now)
+                {
+                    dueTasks.push_back(std::move(m_timers.begin()->second));
+                    m_timers.erase(m_timers.begin());
+                }
+
+                locker.unlock();
+                for (auto& task : dueTasks)
+                {
+                    SubmitTask(std::move(task));
+                }
+                locker.lock();
+            }
+        }
+
+        void Scheduler::ReportError(const ShardInfo& shard, const StreamAdapterError& error) const
+        {
+            if (m_config.errorCallback)
+            {
+                m_config.errorCallback(this, shard, error);
+            }
+        }
+    }
+}
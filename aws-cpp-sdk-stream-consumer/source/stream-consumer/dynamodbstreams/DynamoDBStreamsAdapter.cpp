@@ -0,0 +1,129 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/stream-consumer/dynamodbstreams/DynamoDBStreamsAdapter.h>
+#include <aws/dynamodbstreams/DynamoDBStreamsClient.h>
+#include <aws/dynamodbstreams/model/DescribeStreamRequest.h>
+#include <aws/dynamodbstreams/model/GetShardIteratorRequest.h>
+#include <aws/dynamodbstreams/model/GetRecordsRequest.h>
+#include <aws/core/utils/json/JsonSerializer.h>
+#include <algorithm>
+
+using namespace Aws::DynamoDBStreams::Model;
+
+namespace Aws
+{
+    namespace StreamConsumer
+    {
+        namespace DynamoDBStreams
+        {
+            // Service maximum for the Limit parameter of GetRecords.
+            static const int MAX_GET_RECORDS_LIMIT = 1000;
+
+            static ShardIteratorType ToShardIteratorType(IteratorPosition position)
+            {
+                switch (position)
+                {
+                    case IteratorPosition::LATEST:
+                        return ShardIteratorType::LATEST;
+                    case IteratorPosition::AT_SEQUENCE_NUMBER:
+                        return ShardIteratorType::AT_SEQUENCE_NUMBER;
+                    case IteratorPosition::AFTER_SEQUENCE_NUMBER:
+                        return ShardIteratorType::AFTER_SEQUENCE_NUMBER;
+                    case IteratorPosition::TRIM_HORIZON:
+                    default:
+                        return ShardIteratorType::TRIM_HORIZON;
+                }
+            }
+
+            DynamoDBStreamsAdapter::DynamoDBStreamsAdapter(const std::shared_ptr<Aws::DynamoDBStreams::DynamoDBStreamsClient>& client, const Aws::String& streamArn) :
+                m_client(client), m_streamArn(streamArn)
+            {
+            }
+
+            ListShardsOutcome DynamoDBStreamsAdapter::ListShards()
+            {
+                Aws::Vector<ShardInfo> shards;
+                Aws::String lastEvaluatedShardId;
+                do
+                {
+                    DescribeStreamRequest request;
+                    request.SetStreamArn(m_streamArn);
+                    if (!lastEvaluatedShardId.empty())
+                    {
+                        request.SetExclusiveStartShardId(lastEvaluatedShardId);
+                    }
+
+                    auto outcome = m_client->DescribeStream(request);
+                    if (!outcome.IsSuccess())
+                    {
+                        return StreamAdapterError(outcome.GetError());
+                    }
+
+                    const auto& description = outcome.GetResult().GetStreamDescription();
+                    for (const auto& shard : description.GetShards())
+                    {
+                        ShardInfo info;
+                        info.shardId = shard.GetShardId();
+                        info.parentShardId = shard.GetParentShardId();
+                        info.startingSequenceNumber = shard.GetSequenceNumberRange().GetStartingSequenceNumber();
+                        info.endingSequenceNumber = shard.GetSequenceNumberRange().GetEndingSequenceNumber();
+                        shards.push_back(std::move(info));
+                    }
+                    lastEvaluatedShardId = description.GetLastEvaluatedShardId();
+                } while (!lastEvaluatedShardId.empty());
+
+                return shards;
+            }
+
+            GetShardIteratorOutcome DynamoDBStreamsAdapter::GetShardIterator(const Aws::String& shardId, IteratorPosition position, const Aws::String& sequenceNumber)
+            {
+                GetShardIteratorRequest request;
+                request.SetStreamArn(m_streamArn);
+                request.SetShardId(shardId);
+                request.SetShardIteratorType(ToShardIteratorType(position));
+                if (position == IteratorPosition::AT_SEQUENCE_NUMBER || position == IteratorPosition::AFTER_SEQUENCE_NUMBER)
+                {
+                    request.SetSequenceNumber(sequenceNumber);
+                }
+
+                auto outcome = m_client->GetShardIterator(request);
+                if (!outcome.IsSuccess())
+                {
+                    return StreamAdapterError(outcome.GetError());
+                }
+                return outcome.GetResult().GetShardIterator();
+            }
+
+            GetRecordsOutcome DynamoDBStreamsAdapter::GetRecords(const Aws::String& shardIterator, int limit)
+            {
+                GetRecordsRequest request;
+                request.SetShardIterator(shardIterator);
+                request.SetLimit((std::min)((std::max)(limit, 1), MAX_GET_RECORDS_LIMIT));
+
+                auto outcome = m_client->GetRecords(request);
+                if (!outcome.IsSuccess())
+                {
+                    return StreamAdapterError(outcome.GetError());
+                }
+
+                const auto& result = outcome.GetResult();
+                RecordBatch batch;
+                batch.nextShardIterator = result.GetNextShardIterator();
+                batch.records.reserve(result.GetRecords().size());
+                for (const auto& record : result.GetRecords())
+                {
+                    ConsumerRecord consumerRecord;
+                    consumerRecord.sequenceNumber = record.GetDynamodb().GetSequenceNumber();
+                    consumerRecord.approximateArrivalTimestamp = record.GetDynamodb().GetApproximateCreationDateTime();
+                    Aws::String json = record.Jsonize().View().WriteCompact();
+                    consumerRecord.data = Aws::Utils::ByteBuffer(reinterpret_cast<const unsigned char*>(json.c_str()), json.size());
+                    batch.records.push_back(std::move(consumerRecord));
+                }
+                return batch;
+            }
+        }
+    }
+}
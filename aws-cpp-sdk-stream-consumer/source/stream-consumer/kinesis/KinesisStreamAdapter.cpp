@@ -0,0 +1,133 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/stream-consumer/kinesis/KinesisStreamAdapter.h>
+#include <aws/kinesis/KinesisClient.h>
+#include <aws/kinesis/model/ListShardsRequest.h>
+#include <aws/kinesis/model/GetShardIteratorRequest.h>
+#include <aws/kinesis/model/GetRecordsRequest.h>
+#include <algorithm>
+
+using namespace Aws::Kinesis::Model;
+
+namespace Aws
+{
+    namespace StreamConsumer
+    {
+        namespace Kinesis
+        {
+            // Service maximum for the Limit parameter of GetRecords.
+            static const int MAX_GET_RECORDS_LIMIT = 10000;
+
+            static ShardIteratorType ToShardIteratorType(IteratorPosition position)
+            {
+                switch (position)
+                {
+                    case IteratorPosition::LATEST:
+                        return ShardIteratorType::LATEST;
+                    case IteratorPosition::AT_SEQUENCE_NUMBER:
+                        return ShardIteratorType::AT_SEQUENCE_NUMBER;
+                    case IteratorPosition::AFTER_SEQUENCE_NUMBER:
+                        return ShardIteratorType::AFTER_SEQUENCE_NUMBER;
+                    case IteratorPosition::TRIM_HORIZON:
+                    default:
+                        return ShardIteratorType::TRIM_HORIZON;
+                }
+            }
+
+            KinesisStreamAdapter::KinesisStreamAdapter(const std::shared_ptr<Aws::Kinesis::KinesisClient>& client, const Aws::String& streamName) :
+                m_client(client), m_streamName(streamName)
+            {
+            }
+
+            ListShardsOutcome KinesisStreamAdapter::ListShards()
+            {
+                Aws::Vector<ShardInfo> shards;
+                Aws::String nextToken;
+                do
+                {
+                    ListShardsRequest request;
+                    // StreamName and NextToken are mutually exclusive.
+                    if (nextToken.empty())
+                    {
+                        request.SetStreamName(m_streamName);
+                    }
+                    else
+                    {
+                        request.SetNextToken(nextToken);
+                    }
+
+                    auto outcome = m_client->ListShards(request);
+                    if (!outcome.IsSuccess())
+                    {
+                        return StreamAdapterError(outcome.GetError());
+                    }
+
+                    for (const auto& shard : outcome.GetResult().GetShards())
+                    {
+                        ShardInfo info;
+                        info.shardId = shard.GetShardId();
+                        info.parentShardId = shard.GetParentShardId();
+                        info.adjacentParentShardId = shard.GetAdjacentParentShardId();
+                        info.startingSequenceNumber = shard.GetSequenceNumberRange().GetStartingSequenceNumber();
+                        info.endingSequenceNumber = shard.GetSequenceNumberRange().GetEndingSequenceNumber();
+                        shards.push_back(std::move(info));
+                    }
+                    nextToken = outcome.GetResult().GetNextToken();
+                } while (!nextToken.empty());
+
+                return shards;
+            }
+
+            GetShardIteratorOutcome KinesisStreamAdapter::GetShardIterator(const Aws::String& shardId, IteratorPosition position, const Aws::String& sequenceNumber)
+            {
+                GetShardIteratorRequest request;
+                request.SetStreamName(m_streamName);
+                request.SetShardId(shardId);
+                request.SetShardIteratorType(ToShardIteratorType(position));
+                if (position == IteratorPosition::AT_SEQUENCE_NUMBER || position == IteratorPosition::AFTER_SEQUENCE_NUMBER)
+                {
+                    request.SetStartingSequenceNumber(sequenceNumber);
+                }
+
+                auto outcome = m_client->GetShardIterator(request);
+                if (!outcome.IsSuccess())
+                {
+                    return StreamAdapterError(outcome.GetError());
+                }
+                return outcome.GetResult().GetShardIterator();
+            }
+
+            GetRecordsOutcome KinesisStreamAdapter::GetRecords(const Aws::String& shardIterator, int limit)
+            {
+                GetRecordsRequest request;
+                request.SetShardIterator(shardIterator);
+                request.SetLimit((std::min)((std::max)(limit, 1), MAX_GET_RECORDS_LIMIT));
+
+                auto outcome = m_client->GetRecords(request);
+                if (!outcome.IsSuccess())
+                {
+                    return StreamAdapterError(outcome.GetError());
+                }
+
+                GetRecordsResult result = outcome.GetResultWithOwnership();
+                RecordBatch batch;
+                batch.nextShardIterator = result.GetNextShardIterator();
+                batch.millisBehindLatest = result.GetMillisBehindLatest();
+                batch.records.reserve(result.GetRecords().size());
+                for (const auto& record : result.GetRecords())
+                {
+                    ConsumerRecord consumerRecord;
+                    consumerRecord.sequenceNumber = record.GetSequenceNumber();
+                    consumerRecord.partitionKey = record.GetPartitionKey();
+                    consumerRecord.data = record.GetData();
+                    consumerRecord.approximateArrivalTimestamp = record.GetApproximateArrivalTimestamp();
+                    batch.records.push_back(std::move(consumerRecord));
+                }
+                return batch;
+            }
+        }
+    }
+}
@@ -65,6 +65,9 @@ namespace Aws
                 void SetETag(const Aws::String& eTag) { m_eTag = eTag; }
                 const Aws::String& GetETag() const { return m_eTag; }
 
+                void SetChecksum(uint32_t checksum) { m_checksum = checksum; }
+                uint32_t GetChecksum() const { return m_checksum; }
+
                 Aws::IOStream *GetDownloadPartStream() const { return m_downloadPartStream; }
                 void SetDownloadPartStream(Aws::IOStream *downloadPartStream) { m_downloadPartStream = downloadPartStream; }
 
@@ -82,6 +85,7 @@ namespace Aws
                 int m_partId;
 
                 Aws::String m_eTag;
+                uint32_t m_checksum;
                 uint64_t m_currentProgressInBytes;
                 uint64_t m_bestProgressInBytes;
                 uint64_t m_sizeInBytes;
@@ -342,6 +346,12 @@ namespace Aws
              * in the TransferConfiguration.
              */
             inline void SetError(const Aws::Client::AWSError<Aws::S3::S3Errors>& error) { std::lock_guard<std::mutex> locker(m_getterSetterLock); m_lastError = error; }
+            /**
+             * (Upload only) CRC32C checksum of the whole object, combined from the checksums of its parts.
+             * Only set once the upload completes, and only if computeContentCRC32C is enabled in the TransferManagerConfiguration.
+             */
+            inline uint32_t GetContentCRC32C() const { std::lock_guard<std::mutex> locker(m_getterSetterLock); return m_contentCRC32C; }
+            inline void SetContentCRC32C(uint32_t value) { std::lock_guard<std::mutex> locker(m_getterSetterLock); m_contentCRC32C = value; }
             /**
              * Blocks the calling thread until the operation has finished. This function does not busy wait. It is safe for your CPU.
              */
@@ -387,6 +397,7 @@ namespace Aws
             Aws::Map<Aws::String, Aws::String> m_metadata;
             TransferStatus m_status;
             Aws::Client::AWSError<Aws::S3::S3Errors> m_lastError;
+            uint32_t m_contentCRC32C;
             std::atomic<bool> m_cancel;
             std::shared_ptr<const Aws::Client::AsyncCallerContext> m_context;
             const Utils::UUID m_handleId;
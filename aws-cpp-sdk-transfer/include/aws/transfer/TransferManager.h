@@ -37,7 +37,7 @@ namespace Aws
          */
         struct TransferManagerConfiguration
         {
-            TransferManagerConfiguration(Aws::Utils::Threading::Executor* executor) : s3Client(nullptr), transferExecutor(executor), computeContentMD5(false), transferBufferMaxHeapSize(10 * MB5), bufferSize(MB5)
+            TransferManagerConfiguration(Aws::Utils::Threading::Executor* executor) : s3Client(nullptr), transferExecutor(executor), computeContentMD5(false), computeContentCRC32C(false), transferBufferMaxHeapSize(10 * MB5), bufferSize(MB5)
             {
             }
 
@@ -57,6 +57,13 @@ namespace Aws
              * This option is disabled by default.
              */
             bool computeContentMD5;
+            /**
+             * When true, TransferManager will calculate the CRC32C checksum of each part it uploads, from the part buffer already in memory,
+             * and combine them into the checksum of the whole object without reading it again. The result is available from
+             * TransferHandle::GetContentCRC32C() once the upload completes. S3 does not receive or verify it.
+             * This option is disabled by default.
+             */
+            bool computeContentCRC32C;
             /**
              * If you have special arguments you want passed to our put object calls, put them here. We will copy the template for each put object call
              * overriding the body stream, bucket, and key. If object metadata is passed through, we will override that as well.
@@ -16,6 +16,7 @@ namespace Aws
         PartState::PartState() :
             m_partId(0),
             m_eTag(""),
+            m_checksum(0),
             m_currentProgressInBytes(0),
             m_bestProgressInBytes(0),
             m_sizeInBytes(0),
@@ -28,6 +29,7 @@ namespace Aws
         PartState::PartState(int partId, uint64_t bestProgressInBytes, uint64_t sizeInBytes, bool lastPart) :
             m_partId(partId),
             m_eTag(""),
+            m_checksum(0),
             m_currentProgressInBytes(0),
             m_bestProgressInBytes(bestProgressInBytes),
             m_sizeInBytes(sizeInBytes),
@@ -73,6 +75,7 @@ namespace Aws
             m_fileName(targetFilePath),
             m_versionId(""),
             m_status(TransferStatus::NOT_STARTED),
+            m_contentCRC32C(0),
             m_cancel(false),
             m_handleId(Utils::UUID::RandomUUID()),
             m_createDownloadStreamFn(),
@@ -91,6 +94,7 @@ namespace Aws
             m_fileName(targetFilePath),
             m_versionId(""),
             m_status(TransferStatus::NOT_STARTED),
+            m_contentCRC32C(0),
             m_cancel(false),
             m_handleId(Utils::UUID::RandomUUID()),
             m_createDownloadStreamFn(),
@@ -109,6 +113,7 @@ namespace Aws
             m_fileName(targetFilePath),
             m_versionId(""),
             m_status(TransferStatus::NOT_STARTED),
+            m_contentCRC32C(0),
             m_cancel(false),
             m_handleId(Utils::UUID::RandomUUID()),
             m_createDownloadStreamFn(createDownloadStreamFn),
@@ -130,6 +135,7 @@ namespace Aws
             m_fileName(targetFilePath),
             m_versionId(""),
             m_status(TransferStatus::NOT_STARTED),
+            m_contentCRC32C(0),
             m_cancel(false),
             m_handleId(Utils::UUID::RandomUUID()),
             m_createDownloadStreamFn(createDownloadStreamFn),
@@ -9,6 +9,7 @@
 #include <aws/core/utils/stream/PreallocatedStreamBuf.h>
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
 #include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/crypto/CRC32.h>
 #include <aws/core/utils/FileSystemUtils.h>
 #include <aws/core/platform/FileSystem.h>
 #include <aws/s3/S3Client.h>
@@ -352,6 +353,10 @@ namespace Aws
                     auto lengthToWrite = partsIter->second->GetSizeInBytes();
                     streamToPut->seekg((partsIter->first - 1) * m_transferConfig.bufferSize);
                     streamToPut->read(reinterpret_cast<char*>(buffer), lengthToWrite);
+                    if (m_transferConfig.computeContentCRC32C)
+                    {
+                        partsIter->second->SetChecksum(Aws::Utils::Crypto::CRC32C::Checksum(buffer, static_cast<size_t>(lengthToWrite)));
+                    }
 
                     auto streamBuf = Aws::New<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, buffer, static_cast<size_t>(lengthToWrite));
                     auto preallocatedStreamReader = Aws::MakeShared<Aws::IOStream>(CLASS_TAG, streamBuf);
@@ -445,6 +450,10 @@ namespace Aws
 
             auto lengthToWrite = (std::min)(m_transferConfig.bufferSize, handle->GetBytesTotalSize());
             streamToPut->read((char*)buffer, lengthToWrite);
+            if (m_transferConfig.computeContentCRC32C)
+            {
+                partState->SetChecksum(Aws::Utils::Crypto::CRC32C::Checksum(buffer, static_cast<size_t>(lengthToWrite)));
+            }
             auto streamBuf = Aws::New<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, buffer, static_cast<size_t>(lengthToWrite));
             auto preallocatedStreamReader = Aws::MakeShared<Aws::IOStream>(CLASS_TAG, streamBuf);
 
@@ -540,6 +549,7 @@ namespace Aws
                 if (failedParts.size() == 0 && handle->GetBytesTransferred() == handle->GetBytesTotalSize())
                 {
                     Aws::S3::Model::CompletedMultipartUpload completedUpload;
+                    uint32_t contentChecksum = 0;
 
                     for (auto& part : handle->GetCompletedParts())
                     {
@@ -547,6 +557,7 @@ namespace Aws
                         completedPart.WithPartNumber(part.first)
                             .WithETag(part.second->GetETag());
                         completedUpload.AddParts(completedPart);
+                        contentChecksum = Aws::Utils::Crypto::CRC32C::Combine(contentChecksum, part.second->GetChecksum(), part.second->GetSizeInBytes());
                     }
 
                     Aws::S3::Model::CompleteMultipartUploadRequest completeMultipartUploadRequest;
@@ -565,6 +576,10 @@ namespace Aws
                                 << "] Multi-part upload completed successfully to Bucket: ["
                                 << handle->GetBucketName() << "] with Key: [" << handle->GetKey()
                                 << "] with Upload ID: [" << handle->GetMultiPartId() << "].");
+                        if (m_transferConfig.computeContentCRC32C)
+                        {
+                            handle->SetContentCRC32C(contentChecksum);
+                        }
                         handle->UpdateStatus(TransferStatus::COMPLETED);
                     }
                     else
@@ -610,6 +625,10 @@ namespace Aws
                         << handle->GetBucketName() << "] with Key: [" << handle->GetKey()
                         << "].");
                 handle->ChangePartToCompleted(partState, outcome.GetResult().GetETag());
+                if (m_transferConfig.computeContentCRC32C)
+                {
+                    handle->SetContentCRC32C(partState->GetChecksum());
+                }
                 handle->UpdateStatus(TransferStatus::COMPLETED);
             }
             else
@@ -234,6 +234,22 @@ function(add_sdks)
         endif()
     endif()
 
+    if(ENABLE_BENCHMARKS)
+        add_subdirectory(aws-cpp-sdk-core-benchmarks)
+
+        # The load generator drives real service clients against its own mock server, which uses POSIX sockets.
+        if(NOT PLATFORM_WINDOWS)
+            list(FIND SDK_BUILD_LIST "s3" S3_INDEX)
+            list(FIND SDK_BUILD_LIST "dynamodb" DYNAMODB_INDEX)
+            list(FIND SDK_BUILD_LIST "sqs" SQS_INDEX)
+            if(S3_INDEX GREATER -1 AND DYNAMODB_INDEX GREATER -1 AND SQS_INDEX GREATER -1)
+                add_subdirectory(aws-cpp-sdk-load-generator)
+            else()
+                message(STATUS "s3, dynamodb and sqs are not all built, skipping aws-cpp-sdk-load-generator")
+            endif()
+        endif()
+    endif()
+
     # the catch-all config needs to list all the targets in a dependency-sorted order
     include(dependencies)
     sort_links(EXPORTS)
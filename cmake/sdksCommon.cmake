@@ -127,8 +127,21 @@ list(APPEND HIGH_LEVEL_SDK_LIST "queues")
 list(APPEND HIGH_LEVEL_SDK_LIST "transfer")
 list(APPEND HIGH_LEVEL_SDK_LIST "s3-encryption")
 list(APPEND HIGH_LEVEL_SDK_LIST "text-to-speech")
+list(APPEND HIGH_LEVEL_SDK_LIST "stream-consumer")
+list(APPEND HIGH_LEVEL_SDK_LIST "cloudwatch-logging")
+list(APPEND HIGH_LEVEL_SDK_LIST "cloudwatch-metrics")
+list(APPEND HIGH_LEVEL_SDK_LIST "firehose-producer")
+list(APPEND HIGH_LEVEL_SDK_LIST "glacier-transfer")
+list(APPEND HIGH_LEVEL_SDK_LIST "dynamodb-bulk")
+list(APPEND HIGH_LEVEL_SDK_LIST "secrets-cache")
 
 set(SDK_TEST_PROJECT_LIST "")
+list(APPEND SDK_TEST_PROJECT_LIST "cloudwatch-logging:aws-cpp-sdk-cloudwatch-logging-tests")
+list(APPEND SDK_TEST_PROJECT_LIST "cloudwatch-metrics:aws-cpp-sdk-cloudwatch-metrics-tests")
+list(APPEND SDK_TEST_PROJECT_LIST "firehose-producer:aws-cpp-sdk-firehose-producer-tests")
+list(APPEND SDK_TEST_PROJECT_LIST "glacier-transfer:aws-cpp-sdk-glacier-transfer-tests")
+list(APPEND SDK_TEST_PROJECT_LIST "dynamodb-bulk:aws-cpp-sdk-dynamodb-bulk-tests")
+list(APPEND SDK_TEST_PROJECT_LIST "secrets-cache:aws-cpp-sdk-secrets-cache-tests")
 list(APPEND SDK_TEST_PROJECT_LIST "cognito-identity:aws-cpp-sdk-cognitoidentity-integration-tests")
 list(APPEND SDK_TEST_PROJECT_LIST "core:aws-cpp-sdk-core-tests")
 list(APPEND SDK_TEST_PROJECT_LIST "dynamodb:aws-cpp-sdk-dynamodb-integration-tests")
@@ -145,25 +158,40 @@ list(APPEND SDK_TEST_PROJECT_LIST "s3:aws-cpp-sdk-s3-integration-tests")
 list(APPEND SDK_TEST_PROJECT_LIST "s3-encryption:aws-cpp-sdk-s3-encryption-tests,aws-cpp-sdk-s3-encryption-integration-tests")
 list(APPEND SDK_TEST_PROJECT_LIST "s3control:aws-cpp-sdk-s3control-integration-tests")
 list(APPEND SDK_TEST_PROJECT_LIST "sqs:aws-cpp-sdk-sqs-integration-tests")
+list(APPEND SDK_TEST_PROJECT_LIST "stream-consumer:aws-cpp-sdk-stream-consumer-tests")
 list(APPEND SDK_TEST_PROJECT_LIST "transfer:aws-cpp-sdk-transfer-tests")
 list(APPEND SDK_TEST_PROJECT_LIST "text-to-speech:aws-cpp-sdk-text-to-speech-tests,aws-cpp-sdk-polly-sample")
 list(APPEND SDK_TEST_PROJECT_LIST "transcribestreaming:aws-cpp-sdk-transcribestreaming-integration-tests")
 
 set(SDK_DEPENDENCY_LIST "")
 list(APPEND SDK_DEPENDENCY_LIST "access-management:iam,cognito-identity,core")
+list(APPEND SDK_DEPENDENCY_LIST "cloudwatch-logging:logs,core")
+list(APPEND SDK_DEPENDENCY_LIST "cloudwatch-metrics:monitoring,core")
+list(APPEND SDK_DEPENDENCY_LIST "firehose-producer:firehose,core")
+list(APPEND SDK_DEPENDENCY_LIST "glacier-transfer:glacier,core")
+list(APPEND SDK_DEPENDENCY_LIST "dynamodb-bulk:dynamodb,core")
+list(APPEND SDK_DEPENDENCY_LIST "secrets-cache:secretsmanager,ssm,core")
 list(APPEND SDK_DEPENDENCY_LIST "identity-management:cognito-identity,sts,core")
 list(APPEND SDK_DEPENDENCY_LIST "queues:sqs,core")
 list(APPEND SDK_DEPENDENCY_LIST "s3-encryption:s3,kms,core")
+list(APPEND SDK_DEPENDENCY_LIST "stream-consumer:kinesis,dynamodbstreams,core")
 list(APPEND SDK_DEPENDENCY_LIST "text-to-speech:polly,core")
 list(APPEND SDK_DEPENDENCY_LIST "transfer:s3,core")
 
 set(TEST_DEPENDENCY_LIST "")
+list(APPEND TEST_DEPENDENCY_LIST "cloudwatch-logging:logs,core")
+list(APPEND TEST_DEPENDENCY_LIST "cloudwatch-metrics:monitoring,core")
+list(APPEND TEST_DEPENDENCY_LIST "firehose-producer:firehose,core")
+list(APPEND TEST_DEPENDENCY_LIST "glacier-transfer:glacier,core")
+list(APPEND TEST_DEPENDENCY_LIST "dynamodb-bulk:dynamodb,core")
+list(APPEND TEST_DEPENDENCY_LIST "secrets-cache:secretsmanager,ssm,core")
 list(APPEND TEST_DEPENDENCY_LIST "cognito-identity:access-management,iam,core")
 list(APPEND TEST_DEPENDENCY_LIST "identity-management:cognito-identity,sts,core")
 list(APPEND TEST_DEPENDENCY_LIST "lambda:access-management,cognito-identity,iam,kinesis,core")
 list(APPEND TEST_DEPENDENCY_LIST "s3-encryption:s3,kms,core")
 list(APPEND TEST_DEPENDENCY_LIST "s3control:s3,access-management,cognito-identity,iam,core")
 list(APPEND TEST_DEPENDENCY_LIST "sqs:access-management,cognito-identity,iam,core")
+list(APPEND TEST_DEPENDENCY_LIST "stream-consumer:kinesis,dynamodbstreams,core")
 list(APPEND TEST_DEPENDENCY_LIST "text-to-speech:polly,core")
 list(APPEND TEST_DEPENDENCY_LIST "transfer:s3,core")
 
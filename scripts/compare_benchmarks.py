@@ -0,0 +1,49 @@
+# Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+# SPDX-License-Identifier: Apache-2.0.
+#
+
+# Compares two result files written by "aws-cpp-sdk-core-benchmarks --json=<path>", e.g. from two commits.
+# Exits with 1 if a benchmark got slower than the threshold.
+
+import argparse
+import json
+import sys
+
+def LoadResults(path):
+    with open(path) as resultFile:
+        report = json.load(resultFile)
+    return report["context"], { benchmark["name"] : benchmark for benchmark in report["benchmarks"] }
+
+def Main():
+    parser = argparse.ArgumentParser(description="Compares two aws-cpp-sdk-core-benchmarks JSON result files.")
+    parser.add_argument("base", help="results of the baseline")
+    parser.add_argument("new", help="results to compare against the baseline")
+    parser.add_argument("--threshold", type=float, default=5.0, help="percentage of slowdown reported as a regression (default 5)")
+    args = parser.parse_args()
+
+    baseContext, base = LoadResults(args.base)
+    newContext, new = LoadResults(args.new)
+    print("base: {} {}".format(baseContext.get("label", ""), baseContext.get("date", "")))
+    print("new:  {} {}".format(newContext.get("label", ""), newContext.get("date", "")))
+    print("{:<48} {:>12} {:>12} {:>9}".format("Benchmark", "base ns/op", "new ns/op", "change"))
+
+    regressions = 0
+    for name in sorted(set(base) | set(new)):
+        if name not in base or name not in new:
+            print("{:<48} {}".format(name, "only in base" if name in base else "only in new"))
+            continue
+        baseNs = base[name]["nsPerOp"]
+        newNs = new[name]["nsPerOp"]
+        change = (newNs - baseNs) * 100.0 / baseNs if baseNs else 0.0
+        marker = ""
+        if change > args.threshold:
+            marker = " slower"
+            regressions += 1
+        elif change < -args.threshold:
+            marker = " faster"
+        print("{:<48} {:>12.1f} {:>12.1f} {:>+8.1f}%{}".format(name, baseNs, newNs, change, marker))
+
+    return 1 if regressions else 0
+
+if __name__ == "__main__":
+    sys.exit(Main())
@@ -18,6 +18,13 @@ highLevelServices = ["aws-cpp-sdk-access-management",
                 "aws-cpp-sdk-transfer",
                 "aws-cpp-sdk-s3-encryption",
                 "aws-cpp-sdk-text-to-speech",
+                "aws-cpp-sdk-stream-consumer",
+                "aws-cpp-sdk-cloudwatch-logging",
+                "aws-cpp-sdk-cloudwatch-metrics",
+                "aws-cpp-sdk-firehose-producer",
+                "aws-cpp-sdk-glacier-transfer",
+                "aws-cpp-sdk-dynamodb-bulk",
+                "aws-cpp-sdk-secrets-cache",
                 "aws-cpp-sdk-core",
                 "aws-cpp-sdk-polly-sample"
                 ]
@@ -115,6 +115,8 @@ public:
 
     inline const char* GetServiceClientName() const override { return "MockAWSClient"; }
 
+    using Aws::Client::AWSClient::WarmUpConnections;
+
 protected:
     std::shared_ptr<CountedRetryStrategy> m_countedRetryStrategy;
     Aws::Client::AWSError<Aws::Client::CoreErrors> BuildAWSError(const std::shared_ptr<Aws::Http::HttpResponse>& response) const override